@@ -30,6 +30,7 @@ SUBDIRS += hoot-rnd
 
 SUBDIRS += \
     hoot-cmd \
+    hoot-benchmark \
 
 cppunit {
 SUBDIRS += \
@@ -0,0 +1,41 @@
+# -------------------------------------------------
+# Microbenchmark suite for the hot paths in hoot-core. See README.txt.
+# -------------------------------------------------
+
+QT += testlib \
+    xml \
+
+TARGET = HootBenchmark.bin
+TEMPLATE = app
+DEPENDPATH += \
+    ../tgs/src/main/cpp/ \
+    ../tgs/src/main/cpp/tgs/ \
+    ../hoot-core/src/main/cpp/hoot/core \
+    ../hoot-core/src/main/cpp/ \
+
+INCLUDEPATH += \
+    $${DEPENDPATH}
+
+CONFIG += rtti \
+    qtestlib \
+    debug
+
+include(../Configure.pri)
+
+LIBS += -L../tgs/ -lTgs -L../lib/ -lHootCore -ltbs
+
+UI_DIR = tmp/ui
+MOC_DIR = tmp/moc
+release:OBJECTS_DIR = tmp/release
+else:OBJECTS_DIR = tmp/debug
+DESTDIR = ../bin/
+
+SOURCES += src/main/cpp/hoot/benchmark/main.cpp \
+    src/main/cpp/hoot/benchmark/BenchmarkRunner.cpp \
+    src/main/cpp/hoot/benchmark/CoreBenchmarks.cpp
+
+HEADERS += src/main/cpp/hoot/benchmark/Benchmark.h \
+    src/main/cpp/hoot/benchmark/BenchmarkRunner.h \
+    src/main/cpp/hoot/benchmark/CoreBenchmarks.h
+
+FORMS +=
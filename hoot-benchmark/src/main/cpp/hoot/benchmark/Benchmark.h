@@ -0,0 +1,65 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Qt
+#include <QString>
+
+namespace hoot
+{
+
+/**
+ * A single microbenchmark.
+ *
+ * run() should execute enough work to take at least a few milliseconds -- the runner times whole
+ * run() calls and reports the best of several repetitions, so a run() that finishes in
+ * microseconds measures mostly timer noise. Load data and build any indexes in setUp() so only
+ * the operation of interest is timed.
+ */
+class Benchmark
+{
+public:
+
+  virtual ~Benchmark() {}
+
+  virtual QString getName() const = 0;
+
+  /**
+   * Called once before the timed repetitions start. Untimed.
+   */
+  virtual void setUp() {}
+
+  /**
+   * Runs one timed iteration of the measured operation.
+   */
+  virtual void run() = 0;
+};
+
+}
+
+#endif // BENCHMARK_H
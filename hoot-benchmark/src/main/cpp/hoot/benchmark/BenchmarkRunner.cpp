@@ -0,0 +1,166 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "BenchmarkRunner.h"
+
+// Hoot
+#include <hoot/core/Version.h>
+#include <hoot/core/util/HootException.h>
+
+// Qt
+#include <QFile>
+#include <QRegExp>
+#include <QTextStream>
+
+// Standard
+#include <iostream>
+#include <limits>
+
+// Tgs
+#include <tgs/System/Time.h>
+
+using namespace std;
+
+namespace hoot
+{
+
+BenchmarkRunner::BenchmarkRunner()
+{
+  _iterations = 5;
+}
+
+void BenchmarkRunner::addBenchmark(const boost::shared_ptr<Benchmark>& b)
+{
+  _benchmarks.push_back(b);
+}
+
+int BenchmarkRunner::compareToBaseline(QString baselinePath, double thresholdPercent) const
+{
+  QMap<QString, double> baseline = _readResults(baselinePath);
+
+  int regressions = 0;
+  for (QMap<QString, double>::const_iterator it = _results.begin(); it != _results.end(); ++it)
+  {
+    if (baseline.contains(it.key()) == false)
+    {
+      cout << it.key().toStdString() << ": no baseline entry." << endl;
+      continue;
+    }
+    const double base = baseline[it.key()];
+    const double percent = (it.value() - base) / base * 100.0;
+    QString line = QString("%1: %2ms vs. %3ms baseline (%4%5%)")
+        .arg(it.key())
+        .arg(it.value() * 1000.0, 0, 'f', 2)
+        .arg(base * 1000.0, 0, 'f', 2)
+        .arg(percent >= 0 ? "+" : "")
+        .arg(percent, 0, 'f', 1);
+    if (percent > thresholdPercent)
+    {
+      regressions++;
+      line += " REGRESSION";
+    }
+    else if (percent < -thresholdPercent)
+    {
+      line += " improvement";
+    }
+    cout << line.toStdString() << endl;
+  }
+
+  return regressions;
+}
+
+void BenchmarkRunner::run(QString nameFilter)
+{
+  _results.clear();
+  for (size_t i = 0; i < _benchmarks.size(); i++)
+  {
+    Benchmark& b = *_benchmarks[i];
+    if (nameFilter.isEmpty() == false && b.getName().contains(nameFilter) == false)
+    {
+      continue;
+    }
+
+    b.setUp();
+    double best = numeric_limits<double>::max();
+    for (int j = 0; j < _iterations; j++)
+    {
+      const double start = Tgs::Time::getTime();
+      b.run();
+      best = min(best, Tgs::Time::getTime() - start);
+    }
+    _results[b.getName()] = best;
+    cout << b.getName().toStdString() << ": "
+         << QString("%1ms").arg(best * 1000.0, 0, 'f', 2).toStdString() << endl;
+  }
+}
+
+void BenchmarkRunner::writeResults(QString path) const
+{
+  QFile f(path);
+  if (f.open(QFile::WriteOnly | QFile::Truncate) == false)
+  {
+    throw HootException("Error opening file for writing: " + path);
+  }
+  QTextStream ts(&f);
+
+  ts << "{" << endl;
+  ts << "  \"hootVersion\": \"" << Version::getFullVersion() << "\"," << endl;
+  ts << "  \"results\": {" << endl;
+  QList<QString> keys = _results.keys();
+  for (int i = 0; i < keys.size(); i++)
+  {
+    ts << "    \"" << keys[i] << "\": " << QString::number(_results[keys[i]], 'g', 9);
+    ts << (i == keys.size() - 1 ? "" : ",") << endl;
+  }
+  ts << "  }" << endl;
+  ts << "}" << endl;
+}
+
+QMap<QString, double> BenchmarkRunner::_readResults(QString path)
+{
+  QFile f(path);
+  if (f.open(QFile::ReadOnly) == false)
+  {
+    throw HootException("Error opening file for reading: " + path);
+  }
+  QTextStream ts(&f);
+
+  // the results format is a fixed shape (see writeResults); one name/number pair per line is all
+  // the parsing that is needed.
+  QMap<QString, double> result;
+  QRegExp entry("\\s*\"([^\"]+)\"\\s*:\\s*([0-9][0-9.eE+-]*)\\s*,?\\s*");
+  while (ts.atEnd() == false)
+  {
+    QString line = ts.readLine();
+    if (entry.exactMatch(line))
+    {
+      result[entry.cap(1)] = entry.cap(2).toDouble();
+    }
+  }
+  return result;
+}
+
+}
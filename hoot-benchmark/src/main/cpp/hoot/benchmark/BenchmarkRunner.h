@@ -0,0 +1,94 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// Qt
+#include <QMap>
+#include <QString>
+
+// Standard
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace hoot
+{
+
+/**
+ * Runs a set of benchmarks, reports per-benchmark wall times, writes the results as JSON and
+ * compares a run against a stored baseline so performance regressions fail loudly instead of
+ * landing silently.
+ */
+class BenchmarkRunner
+{
+public:
+
+  BenchmarkRunner();
+
+  void addBenchmark(const boost::shared_ptr<Benchmark>& b);
+
+  /**
+   * Compares this run's results against a baseline written by writeResults() and prints a line
+   * per benchmark. A benchmark regressed if it got slower than the baseline by more than
+   * thresholdPercent percent.
+   *
+   * @return The number of benchmarks that regressed.
+   */
+  int compareToBaseline(QString baselinePath, double thresholdPercent) const;
+
+  /**
+   * Runs each benchmark whose name contains nameFilter (all of them when the filter is empty).
+   * Each benchmark is set up once and then timed over several repetitions; the best repetition
+   * is recorded, since the minimum is the least disturbed by other load on the machine.
+   */
+  void run(QString nameFilter = QString());
+
+  void setIterations(int iterations) { _iterations = iterations; }
+
+  /**
+   * Writes this run's results as JSON. The file doubles as the baseline for a later
+   * compareToBaseline() call.
+   */
+  void writeResults(QString path) const;
+
+private:
+
+  std::vector< boost::shared_ptr<Benchmark> > _benchmarks;
+  int _iterations;
+  /// benchmark name to best wall time in seconds.
+  QMap<QString, double> _results;
+
+  static QMap<QString, double> _readResults(QString path);
+};
+
+}
+
+#endif // BENCHMARKRUNNER_H
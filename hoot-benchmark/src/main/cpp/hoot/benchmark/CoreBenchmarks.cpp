@@ -0,0 +1,298 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "CoreBenchmarks.h"
+
+// GEOS
+#include <geos/geom/Envelope.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/algorithms/LevenshteinDistance.h>
+#include <hoot/core/algorithms/MaximalSubline.h>
+#include <hoot/core/algorithms/linearreference/WayLocation.h>
+#include <hoot/core/io/OsmPbfReader.h>
+#include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/schema/TagMergerFactory.h>
+#include <hoot/core/util/MapProjector.h>
+#include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+
+// Qt
+#include <QStringList>
+
+// Standard
+#include <memory>
+#include <vector>
+
+// Tgs
+#include <tgs/RStarTree/Box.h>
+#include <tgs/RStarTree/HilbertRTree.h>
+#include <tgs/RStarTree/IntersectionIterator.h>
+#include <tgs/RStarTree/MemoryPageStore.h>
+
+using namespace std;
+
+namespace hoot
+{
+
+/**
+ * Each benchmark accumulates a throwaway result into _sink so the compiler can't elide the
+ * measured work.
+ */
+
+class LevenshteinDistanceBenchmark : public Benchmark
+{
+public:
+
+  LevenshteinDistanceBenchmark() : _sink(0) {}
+
+  virtual QString getName() const { return "LevenshteinDistance"; }
+
+  virtual void setUp()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/DcGisRoads.osm", map);
+
+    const WayMap& ways = map->getWays();
+    for (WayMap::const_iterator it = ways.begin(); it != ways.end() && _names.size() < 150; ++it)
+    {
+      QStringList names = it->second->getTags().getNames();
+      for (int i = 0; i < names.size(); i++)
+      {
+        if (names[i].isEmpty() == false)
+        {
+          _names.append(names[i]);
+        }
+      }
+    }
+  }
+
+  virtual void run()
+  {
+    // all pairs keeps the iteration long enough to time reliably.
+    for (int i = 0; i < _names.size(); i++)
+    {
+      for (int j = 0; j < _names.size(); j++)
+      {
+        _sink += LevenshteinDistance::distance(_names[i], _names[j]);
+      }
+    }
+  }
+
+private:
+
+  QStringList _names;
+  long _sink;
+};
+
+class TagMergeBenchmark : public Benchmark
+{
+public:
+
+  TagMergeBenchmark() : _sink(0) {}
+
+  virtual QString getName() const { return "TagMergerFactoryMergeTags"; }
+
+  virtual void setUp()
+  {
+    _loadWayTags("test-files/DcGisRoads.osm", _tags1);
+    _loadWayTags("test-files/DcTigerRoads.osm", _tags2);
+  }
+
+  virtual void run()
+  {
+    for (size_t i = 0; i < _tags1.size(); i++)
+    {
+      Tags merged = TagMergerFactory::mergeTags(_tags1[i], _tags2[i % _tags2.size()],
+        ElementType::Way);
+      _sink += merged.size();
+    }
+  }
+
+private:
+
+  vector<Tags> _tags1;
+  vector<Tags> _tags2;
+  long _sink;
+
+  void _loadWayTags(QString path, vector<Tags>& tags)
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.read(path, map);
+
+    const WayMap& ways = map->getWays();
+    for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+    {
+      tags.push_back(it->second->getTags());
+    }
+  }
+};
+
+class MaximalSublineBenchmark : public Benchmark
+{
+public:
+
+  MaximalSublineBenchmark() : _sink(0) {}
+
+  virtual QString getName() const { return "MaximalSubline"; }
+
+  virtual void setUp()
+  {
+    _map.reset(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/DcGisRoads.osm", _map);
+    MapProjector::projectToPlanar(_map);
+
+    const WayMap& ways = _map->getWays();
+    for (WayMap::const_iterator it = ways.begin(); it != ways.end() && _ways.size() < 60; ++it)
+    {
+      _ways.push_back(it->second);
+    }
+  }
+
+  virtual void run()
+  {
+    MaximalSubline uut(new MaximalSubline::ThresholdMatchCriteria(10.0, M_PI / 2.0), 10.0);
+    for (size_t i = 0; i + 1 < _ways.size(); i++)
+    {
+      vector<WayLocation> wl1, wl2;
+      _sink += uut.findMaximalSubline(_map, _ways[i], _ways[i + 1], wl1, wl2);
+    }
+  }
+
+private:
+
+  OsmMapPtr _map;
+  vector<WayPtr> _ways;
+  double _sink;
+};
+
+class OsmPbfReaderBenchmark : public Benchmark
+{
+public:
+
+  OsmPbfReaderBenchmark() : _sink(0) {}
+
+  virtual QString getName() const { return "OsmPbfReader"; }
+
+  virtual void run()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmPbfReader reader(true);
+    reader.read("test-files/DcGisRoads.pbf", map);
+    _sink += map->getNodes().size();
+  }
+
+private:
+
+  long _sink;
+};
+
+class RTreeQueryBenchmark : public Benchmark
+{
+public:
+
+  RTreeQueryBenchmark() : _sink(0) {}
+
+  virtual QString getName() const { return "HilbertRTreeQuery"; }
+
+  virtual void setUp()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/DcGisRoads.osm", map);
+    MapProjector::projectToPlanar(map);
+
+    _envelope = CalculateMapBoundsVisitor::getGeosBounds(map);
+
+    // 10 children - 368
+    boost::shared_ptr<Tgs::MemoryPageStore> mps(new Tgs::MemoryPageStore(728));
+    _index.reset(new Tgs::HilbertRTree(mps, 2));
+
+    vector<Tgs::Box> boxes;
+    vector<int> ids;
+    const WayMap& ways = map->getWays();
+    for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+    {
+      auto_ptr<geos::geom::Envelope> env(it->second->getEnvelope(map));
+      Tgs::Box b(2);
+      b.setBounds(0, env->getMinX(), env->getMaxX());
+      b.setBounds(1, env->getMinY(), env->getMaxY());
+      boxes.push_back(b);
+      ids.push_back((int)it->first);
+    }
+    _index->bulkInsert(boxes, ids);
+  }
+
+  virtual void run()
+  {
+    // query a regular grid of boxes over the map so the whole tree gets exercised.
+    const int n = 32;
+    const double w = _envelope.getWidth() / n;
+    const double h = _envelope.getHeight() / n;
+    vector<double> min(2), max(2);
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        min[0] = _envelope.getMinX() + i * w;
+        min[1] = _envelope.getMinY() + j * h;
+        max[0] = min[0] + w;
+        max[1] = min[1] + h;
+        Tgs::IntersectionIterator it(_index.get(), min, max);
+        while (it.next())
+        {
+          _sink += it.getId();
+        }
+      }
+    }
+  }
+
+private:
+
+  geos::geom::Envelope _envelope;
+  boost::shared_ptr<Tgs::HilbertRTree> _index;
+  long _sink;
+};
+
+vector< boost::shared_ptr<Benchmark> > createCoreBenchmarks()
+{
+  vector< boost::shared_ptr<Benchmark> > result;
+  result.push_back(boost::shared_ptr<Benchmark>(new LevenshteinDistanceBenchmark()));
+  result.push_back(boost::shared_ptr<Benchmark>(new TagMergeBenchmark()));
+  result.push_back(boost::shared_ptr<Benchmark>(new MaximalSublineBenchmark()));
+  result.push_back(boost::shared_ptr<Benchmark>(new OsmPbfReaderBenchmark()));
+  result.push_back(boost::shared_ptr<Benchmark>(new RTreeQueryBenchmark()));
+  return result;
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef COREBENCHMARKS_H
+#define COREBENCHMARKS_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// Standard
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace hoot
+{
+
+/**
+ * Returns the tracked hot-path benchmarks for hoot-core. The inputs come from the standard
+ * datasets under test-files, so the suite must run from $HOOT_HOME like the unit tests do.
+ */
+std::vector< boost::shared_ptr<Benchmark> > createCoreBenchmarks();
+
+}
+
+#endif // COREBENCHMARKS_H
@@ -0,0 +1,138 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/Hoot.h>
+#include <hoot/core/util/Log.h>
+using namespace hoot;
+
+// Qt
+#include <QCoreApplication>
+#include <QString>
+
+// Standard
+#include <exception>
+#include <iostream>
+
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+
+using namespace std;
+
+void usage()
+{
+  cout << "Usage: HootBenchmark.bin [options] [name filter]" << endl;
+  cout << endl;
+  cout << "Runs the tracked hot-path microbenchmarks. Must be run from $HOOT_HOME so the" << endl;
+  cout << "standard datasets under test-files are available." << endl;
+  cout << endl;
+  cout << "Options:" << endl;
+  cout << "  --iterations <n>     Repetitions per benchmark; the best is reported. [5]" << endl;
+  cout << "  --output <path>      Write the results as JSON. The file can later serve as" << endl;
+  cout << "                       the baseline." << endl;
+  cout << "  --baseline <path>    Compare against a previous --output file. Exits non-zero" << endl;
+  cout << "                       if any benchmark regressed." << endl;
+  cout << "  --threshold <pct>    Percent slowdown that counts as a regression. [10]" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  Hoot::getInstance().init();
+
+  QCoreApplication app(argc, argv);
+
+  QString output;
+  QString baseline;
+  QString nameFilter;
+  double threshold = 10.0;
+  int iterations = 5;
+
+  for (int i = 1; i < argc; i++)
+  {
+    QString arg = argv[i];
+    if (arg == "--iterations" && i + 1 < argc)
+    {
+      iterations = QString(argv[++i]).toInt();
+    }
+    else if (arg == "--output" && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else if (arg == "--baseline" && i + 1 < argc)
+    {
+      baseline = argv[++i];
+    }
+    else if (arg == "--threshold" && i + 1 < argc)
+    {
+      threshold = QString(argv[++i]).toDouble();
+    }
+    else if (arg == "--help" || arg.startsWith("--"))
+    {
+      usage();
+      return arg == "--help" ? 0 : -1;
+    }
+    else
+    {
+      nameFilter = arg;
+    }
+  }
+
+  try
+  {
+    BenchmarkRunner runner;
+    runner.setIterations(iterations);
+    vector< boost::shared_ptr<Benchmark> > benchmarks = createCoreBenchmarks();
+    for (size_t i = 0; i < benchmarks.size(); i++)
+    {
+      runner.addBenchmark(benchmarks[i]);
+    }
+
+    runner.run(nameFilter);
+
+    if (output.isEmpty() == false)
+    {
+      runner.writeResults(output);
+    }
+    if (baseline.isEmpty() == false)
+    {
+      const int regressions = runner.compareToBaseline(baseline, threshold);
+      if (regressions > 0)
+      {
+        cout << regressions << " benchmark(s) regressed." << endl;
+        return 1;
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    cerr << "Error running benchmarks:" << endl;
+    cerr << e.what() << endl;
+    return -1;
+  }
+
+  return 0;
+}
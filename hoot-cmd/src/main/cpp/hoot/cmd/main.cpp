@@ -38,6 +38,7 @@ using namespace geos::geom;
 #include <hoot/core/HootConfig.h>
 #include <hoot/core/cmd/Command.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/util/Profiler.h>
 using namespace hoot;
 
 // Qt
@@ -77,7 +78,10 @@ int main(int argc, char *argv[])
   {
     try
     {
-      return c->run(argv, argc);
+      int result = c->run(argv, argc);
+      // no-op unless profiler.enabled is set.
+      Profiler::getInstance().report();
+      return result;
     }
     catch (const std::exception& e)
     {
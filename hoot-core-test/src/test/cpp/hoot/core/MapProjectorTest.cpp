@@ -61,6 +61,7 @@ class MapProjectorTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(MapProjectorTest);
   CPPUNIT_TEST(runErrorTest);
   CPPUNIT_TEST(runCreatePlanarProjectionTest);
+  CPPUNIT_TEST(runParallelReprojectTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -249,6 +250,39 @@ public:
 //    fs.close();
   }
 
+  /**
+   * A sharded reprojection must move every node to exactly the same place as the serial one.
+   */
+  void runParallelReprojectTest()
+  {
+    boost::minstd_rand prng(1);
+    boost::uniform_real<> uni(0.0, 1.0);
+
+    OsmMapPtr serialMap(new OsmMap());
+    OsmMapPtr parallelMap(new OsmMap());
+    for (int i = 0; i < 1000; i++)
+    {
+      double x = uni(prng) * 0.5 - 77.0;
+      double y = uni(prng) * 0.5 + 38.5;
+      serialMap->addNode(NodePtr(new Node(Status::Unknown1, i + 1, x, y, 10)));
+      parallelMap->addNode(NodePtr(new Node(Status::Unknown1, i + 1, x, y, 10)));
+    }
+
+    MapProjector::projectToPlanar(serialMap);
+
+    conf().set(ConfigOptions::getMapProjectorThreadsKey(), 4);
+    MapProjector::projectToPlanar(parallelMap);
+    conf().set(ConfigOptions::getMapProjectorThreadsKey(), 1);
+
+    const NodeMap& nodes = serialMap->getNodes();
+    for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+      NodePtr n2 = parallelMap->getNode(it->first);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(it->second->getX(), n2->getX(), 0.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(it->second->getY(), n2->getY(), 0.0);
+    }
+  }
+
   /**
    * Test a number of bounds for the best projections.
    */
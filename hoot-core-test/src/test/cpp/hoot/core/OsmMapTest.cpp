@@ -45,6 +45,7 @@
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/ops/RemoveWayOp.h>
+#include <hoot/core/visitors/ElementCountVisitor.h>
 #include <hoot/core/visitors/FindWaysVisitor.h>
 
 #include <hoot/core/visitors/RemoveInvalidMultilineStringMembersVisitor.h>
@@ -69,10 +70,29 @@ using namespace std;
 namespace hoot
 {
 
+namespace
+{
+  //a visitor with only the typed visit overloads; used to exercise the templated traversals
+  class TypedCountVisitor
+  {
+  public:
+    TypedCountVisitor() : nodes(0), ways(0), relations(0) {}
+    virtual ~TypedCountVisitor() {}
+    void visit(const ConstNodePtr&) { nodes++; }
+    void visit(const ConstWayPtr&) { ways++; }
+    void visit(const ConstRelationPtr&) { relations++; }
+    int nodes;
+    int ways;
+    int relations;
+  };
+}
+
 class OsmMapTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(OsmMapTest);
+  CPPUNIT_TEST(runGetNodeCoordinatesTest);
   CPPUNIT_TEST(runCopyTest);
+  CPPUNIT_TEST(runCowSnapshotTest);
   CPPUNIT_TEST(runFindWayNeighbors);
   CPPUNIT_TEST(runNnTest);
   CPPUNIT_TEST(runAppendTest);
@@ -82,10 +102,12 @@ class OsmMapTest : public CppUnit::TestFixture
   CPPUNIT_TEST(runAppendSameMapTest);
   CPPUNIT_TEST(runAppendDifferentCoordinateSystemsTest);
   CPPUNIT_TEST(runRemoveTest);
+  CPPUNIT_TEST(runCommitRemovalsTest);
   CPPUNIT_TEST(runReplaceListTest1);
   CPPUNIT_TEST(runReplaceListTest2);
   CPPUNIT_TEST(runReplaceListTest3);
   CPPUNIT_TEST(runReplaceNodeTest);
+  CPPUNIT_TEST(runVisitRoTemplatedTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -142,6 +164,32 @@ public:
     return map;
   }
 
+  void runGetNodeCoordinatesTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 5);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, -5);
+
+    vector<long> ids;
+    ids.push_back(n2->getId());
+    ids.push_back(n1->getId());
+    ids.push_back(n3->getId());
+
+    vector<Coordinate> coords;
+    map->getNodeCoordinates(ids, coords);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)3, coords.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, coords[0].x, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, coords[0].y, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, coords[1].x, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-5.0, coords[2].y, 1e-9);
+
+    // an unknown id throws rather than handing back garbage.
+    ids.push_back(-99999);
+    CPPUNIT_ASSERT_THROW(map->getNodeCoordinates(ids, coords), HootException);
+  }
+
   /**
    * OsmMap does some fanciness to do copy on write rather than always copying. Handy, but it was
    * a bit buggy. This tests for those bugs.
@@ -172,6 +220,29 @@ public:
     HOOT_STR_EQUALS(relationPreChange, map->getRelation(-1)->toString());
   }
 
+  /**
+   * Takes a copy-on-write snapshot, changes the original through its accessors and verifies that
+   * the snapshot keeps seeing the pre-snapshot state while untouched elements stay shared.
+   */
+  void runCowSnapshotTest()
+  {
+    OsmMapPtr map = createMapForCopyTest();
+
+    QString nodePreChange = map->getNode(-1669793)->toString();
+    QString wayPreChange = map->getWay(-1669801)->toString();
+    QString relationPreChange = map->getRelation(-1)->toString();
+
+    ConstOsmMapPtr snap = map->takeCowSnapshot();
+    changeMapForCopyTest(map);
+
+    HOOT_STR_EQUALS(nodePreChange, snap->getNode(-1669793)->toString());
+    HOOT_STR_EQUALS(wayPreChange, snap->getWay(-1669801)->toString());
+    HOOT_STR_EQUALS(relationPreChange, snap->getRelation(-1)->toString());
+
+    // elements the original never touched are shared with the snapshot, not copied.
+    CPPUNIT_ASSERT(snap->getNode(-1669723) == map->getNodes().find(-1669723)->second);
+  }
+
   void runAppendTest()
   {
     OsmXmlReader reader;
@@ -455,6 +526,61 @@ public:
     _checkKnnWayIterator(map);
   }
 
+  void runCommitRemovalsTest()
+  {
+    TestUtils::resetEnvironment();
+
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, 0);
+    NodePtr n4 = TestUtils::createNode(map, Status::Unknown1, 30, 0);
+
+    QList<NodePtr> w1Nodes;
+    w1Nodes.append(n1);
+    w1Nodes.append(n2);
+    w1Nodes.append(n3);
+    WayPtr w1 = TestUtils::createWay(map, w1Nodes);
+
+    QList<NodePtr> w2Nodes;
+    w2Nodes.append(n3);
+    w2Nodes.append(n4);
+    WayPtr w2 = TestUtils::createWay(map, w2Nodes);
+
+    RelationPtr r1(new Relation(Status::Unknown1, map->createNextRelationId(), 15));
+    r1->addElement("", w1->getElementId());
+    r1->addElement("", w2->getElementId());
+    map->addRelation(r1);
+
+    RelationPtr r2(new Relation(Status::Unknown1, map->createNextRelationId(), 15));
+    r2->addElement("", r1->getElementId());
+    map->addRelation(r2);
+
+    map->scheduleRemoval(n2->getElementId());
+    map->scheduleRemoval(w2->getElementId());
+    map->scheduleRemoval(r1->getElementId());
+    map->commitRemovals();
+
+    // the scheduled elements are gone.
+    CPPUNIT_ASSERT_EQUAL(false, map->containsNode(n2->getId()));
+    CPPUNIT_ASSERT_EQUAL(false, map->containsWay(w2->getId()));
+    CPPUNIT_ASSERT_EQUAL(false, map->containsRelation(r1->getId()));
+
+    // the surviving way dropped its reference to the removed node.
+    CPPUNIT_ASSERT_EQUAL((size_t)2, map->getWay(w1->getId())->getNodeCount());
+
+    // the surviving relation dropped its membership to the removed relation.
+    CPPUNIT_ASSERT_EQUAL((size_t)0, map->getRelation(r2->getId())->getMembers().size());
+
+    // w2's nodes survive the removal of the way itself.
+    CPPUNIT_ASSERT_EQUAL(true, map->containsNode(n3->getId()));
+    CPPUNIT_ASSERT_EQUAL(true, map->containsNode(n4->getId()));
+
+    CPPUNIT_ASSERT_EQUAL(true, map->validate(false));
+  }
+
   /**
    * Test to verify ways get replaced in a relation properly and the replaced way (w1) is removed.
    */
@@ -732,6 +858,36 @@ public:
       i++;
     }
   }
+
+  void runVisitRoTemplatedTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    TestUtils::createNode(map, Status::Unknown1, 0.0, 0.0);
+    TestUtils::createNode(map, Status::Unknown1, 10.0, 10.0);
+    TestUtils::createNode(map, Status::Unknown1, 20.0, 20.0);
+    Coordinate c[] = { Coordinate(0.0, 0.0), Coordinate(100.0, 0.0), Coordinate::getNull() };
+    WayPtr way = TestUtils::createWay(map, Status::Unknown1, c);
+    RelationPtr relation(new Relation(Status::Unknown1, map->createNextRelationId(), 15.0));
+    relation->addElement("outer", way->getElementId());
+    map->addRelation(relation);
+
+    //a visitor with only typed visit overloads never goes through a virtual call
+    TypedCountVisitor typedVisitor;
+    map->visitNodesRo(typedVisitor);
+    map->visitWaysRo(typedVisitor);
+    map->visitRelationsRo(typedVisitor);
+    //createWay creates a node for each coordinate
+    CPPUNIT_ASSERT_EQUAL(5, typedVisitor.nodes);
+    CPPUNIT_ASSERT_EQUAL(1, typedVisitor.ways);
+    CPPUNIT_ASSERT_EQUAL(1, typedVisitor.relations);
+
+    //a visitor with both interfaces produces the same counts through the templated traversal
+    ElementCountVisitor countVisitor;
+    map->visitNodesRo(countVisitor);
+    map->visitWaysRo(countVisitor);
+    map->visitRelationsRo(countVisitor);
+    CPPUNIT_ASSERT_EQUAL(7, countVisitor.getCount());
+  }
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(OsmMapTest, "quick");
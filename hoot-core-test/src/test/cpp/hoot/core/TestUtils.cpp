@@ -32,6 +32,9 @@
 #include <hoot/core/conflate/MatchFactory.h>
 #include <hoot/core/conflate/MergerFactory.h>
 #include <hoot/core/filters/TagCriterion.h>
+#include <hoot/core/io/HootMapFileReader.h>
+#include <hoot/core/io/HootMapFileWriter.h>
+#include <hoot/core/io/OsmMapReaderFactory.h>
 #include <hoot/core/io/OsmXmlReader.h>
 #include <hoot/core/schema/TagMergerFactory.h>
 #include <hoot/core/scoring/MapComparator.h>
@@ -47,7 +50,12 @@
 #include <tgs/Statistics/Random.h>
 
 // Qt
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 using namespace geos::geom;
 using namespace std;
@@ -80,6 +88,56 @@ bool TestUtils::compareMaps(OsmMapPtr ref, OsmMapPtr test)
   return MapComparator().isMatch(ref, test);
 }
 
+OsmMapPtr TestUtils::loadFixtureMap(QString path, bool useFileId, Status defaultStatus)
+{
+  // the source's modification time and the load options are part of the key, so a stale or
+  // differently configured entry can't be served.
+  QCryptographicHash keyHash(QCryptographicHash::Sha1);
+  keyHash.addData(path.toUtf8());
+  keyHash.addData(
+    QFileInfo(path).lastModified().toString(Qt::ISODate).toUtf8());
+  keyHash.addData(useFileId ? "1" : "0", 1);
+  keyHash.addData(QByteArray::number(defaultStatus.getEnum()));
+  const QString cacheDir = "test-output/fixture-cache";
+  const QString cachePath =
+    cacheDir + "/" + QString::fromUtf8(keyHash.result().toHex()) + ".hmf";
+
+  OsmMapPtr map(new OsmMap());
+  if (QFile::exists(cachePath))
+  {
+    HootMapFileReader reader;
+    reader.open(cachePath);
+    reader.read(map);
+    return map;
+  }
+
+  OsmMapReaderFactory::read(map, path, useFileId, defaultStatus);
+
+  QDir().mkpath(cacheDir);
+  // write to a process private temp name and rename into place so parallel test shards racing
+  // on the same fixture can't see a half written entry.
+  const QString tmpPath = cachePath + QString(".%1.tmp").arg(QCoreApplication::applicationPid());
+  try
+  {
+    HootMapFileWriter writer;
+    writer.open(tmpPath);
+    writer.write(map);
+    writer.close();
+    if (!QFile::rename(tmpPath, cachePath))
+    {
+      // another shard beat us to it; our parse is still good.
+      QFile::remove(tmpPath);
+    }
+  }
+  catch (const HootException& e)
+  {
+    LOG_WARN("Failed caching fixture " << path << ": " << e.getWhat());
+    QFile::remove(tmpPath);
+  }
+
+  return map;
+}
+
 NodePtr TestUtils::createNode(OsmMapPtr map, Status status, double x, double y,
                               double circularError, Tags tags)
 {
@@ -109,6 +109,17 @@ public:
 
   static bool compareMaps(const QString& map1, const QString map2);
 
+  /**
+   * Loads a test input through a shared read-only fixture cache. The first load parses the source
+   * normally and stores the result as a pre-parsed map file under test-output/fixture-cache;
+   * later loads of the same input (including by parallel test shards in other processes)
+   * deserialize the cached copy instead of re-parsing. The returned map is a private copy the
+   * test may mutate freely. The cache key covers the source's modification time, so editing a
+   * test file invalidates its cached entry.
+   */
+  static OsmMapPtr loadFixtureMap(QString path, bool useFileId,
+    Status defaultStatus = Status::Invalid);
+
   static NodePtr createNode(OsmMapPtr map, Status status, double x, double y,
     double circularError = 15.0, Tags tags = Tags());
 
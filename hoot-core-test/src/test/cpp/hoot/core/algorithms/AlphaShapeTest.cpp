@@ -35,6 +35,7 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/algorithms/AlphaShape.h>
 #include <hoot/core/io/OsmXmlWriter.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 
 // Qt
@@ -57,6 +58,7 @@ class AlphaShapeTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(AlphaShapeTest);
   CPPUNIT_TEST(runTest);
   CPPUNIT_TEST(runRandomTest);
+  CPPUNIT_TEST(runParallelUnionTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -110,6 +112,30 @@ public:
     CPPUNIT_ASSERT_DOUBLES_EQUAL(3241.5, g->getArea(), 0.1);
   }
 
+  void runParallelUnionTest()
+  {
+    vector< pair<double, double> > points;
+    Tgs::Random::instance()->seed(0);
+    createDonut(points, 0, 35, 10, 0, 250);
+
+    Tgs::Random::instance()->seed(0);
+    AlphaShape serial(16.0);
+    serial.insert(points);
+    boost::shared_ptr<Geometry> g1 = serial.toGeometry();
+
+    Tgs::Random::instance()->seed(0);
+    conf().set(ConfigOptions::getGeometryMergerThreadsKey(), 4);
+    AlphaShape parallel(16.0);
+    parallel.insert(points);
+    boost::shared_ptr<Geometry> g2 = parallel.toGeometry();
+    conf().set(ConfigOptions::getGeometryMergerThreadsKey(), 1);
+
+    // the pairing in each merge round is fixed by the hilbert sort, so the sharded union gives
+    // exactly the serial result.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g1->getArea(), g2->getArea(), 0.0);
+    CPPUNIT_ASSERT(g1->equals(g2.get()));
+  }
+
   void runTest()
   {
     vector< pair<double, double> > points;
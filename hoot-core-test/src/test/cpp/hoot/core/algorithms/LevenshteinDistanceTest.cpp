@@ -42,6 +42,7 @@ using namespace hoot;
 
 // Qt
 #include <QString>
+#include <QStringList>
 
 // Standard
 #include <string>
@@ -53,6 +54,7 @@ class LevenshteinDistanceTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(LevenshteinDistanceTest);
   CPPUNIT_TEST(runTest);
+  CPPUNIT_TEST(runBoundedTest);
   CPPUNIT_TEST(scriptTest);
   CPPUNIT_TEST_SUITE_END();
 
@@ -99,6 +101,29 @@ public:
                                  0.001);
   }
 
+  void runBoundedTest()
+  {
+    // the bit-parallel kernel must agree with the classic dynamic programming implementation.
+    QStringList words;
+    words << "" << "a" << "cat" << "car" << "banana" << "bandana" << "apple"
+          << "jalan tol jakarta-cikampek" << "jakarta cikampek tollroad" << "trikora";
+    for (int i = 0; i < words.size(); i++)
+    {
+      for (int j = 0; j < words.size(); j++)
+      {
+        CPPUNIT_ASSERT_EQUAL(
+          LevenshteinDistance::distance<QString>(words[i], words[j]),
+          LevenshteinDistance::distanceMyers(words[i], words[j]));
+      }
+    }
+
+    // within the bound the exact distance is returned; beyond it any value > maxD is fine.
+    CPPUNIT_ASSERT_EQUAL(1u, LevenshteinDistance::distanceWithin("cat", "car", 2));
+    CPPUNIT_ASSERT_EQUAL(1u, LevenshteinDistance::distanceWithin("banana", "bandana", 2));
+    CPPUNIT_ASSERT(LevenshteinDistance::distanceWithin("cat", "banana", 1) > 1u);
+    CPPUNIT_ASSERT(LevenshteinDistance::distanceWithin("abcdef", "ghijkl", 2) > 2u);
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(LevenshteinDistanceTest);
@@ -0,0 +1,93 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/algorithms/string/MappedWordWeightDictionary.h>
+#include <hoot/core/io/WordCount.h>
+#include <hoot/core/io/WordCountWriter.h>
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QDir>
+
+#include "../../TestUtils.h"
+
+namespace hoot
+{
+
+class MappedWordWeightDictionaryTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MappedWordWeightDictionaryTest);
+  CPPUNIT_TEST(runTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runTest()
+  {
+    QDir().mkpath("test-output/algorithms/string");
+    QString indexPath = "test-output/algorithms/string/MappedWordWeight.mwi";
+    QFile::remove(indexPath);
+
+    // same corpus as test-files/algorithms/string/WordWeight.tsv, total count 181.
+    QVector<WordCount> words;
+    words.append(WordCount("street", 100));
+    words.append(WordCount("road", 50));
+    words.append(WordCount("lane", 25));
+    words.append(WordCount("bar", 3));
+    words.append(WordCount("foo", 1));
+    words.append(WordCount("fou", 1));
+    words.append(WordCount("baar", 1));
+
+    WordCountWriter writer(-1);
+    writer.writeIndex(indexPath, words);
+
+    MappedWordWeightDictionary uut(indexPath);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0055, uut.getWeight("foo"), 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0166, uut.getWeight("bar"), 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 / 181.0, uut.getWeight("street"), 0.0001);
+    // unknown words return 0 and the normalization matches the other dictionaries.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, uut.getWeight("boulevard"), 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(uut.getWeight("foo"), uut.getWeight("Foo!"), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 / 181.0, uut.getMinWeight(), 1e-9);
+
+    // the batched lookup agrees with the one at a time lookup.
+    QStringList l;
+    l << "street" << "boulevard" << "bar" << "baar";
+    std::vector<double> weights;
+    uut.getWeights(l, weights);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, weights.size());
+    for (int i = 0; i < l.size(); i++)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(uut.getWeight(l[i]), weights[i], 1e-9);
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MappedWordWeightDictionaryTest, "quick");
+
+}
@@ -105,8 +105,8 @@ public:
   {
     QDir().mkdir("test-output/conflate");
     OsmMap::resetCounters();
-    OsmMapPtr map(new OsmMap());
-    OsmMapReaderFactory::read(map, "test-files/DcTigerRoads.osm", true, Status::Unknown1);
+    OsmMapPtr map =
+      TestUtils::loadFixtureMap("test-files/DcTigerRoads.osm", true, Status::Unknown1);
 
     //create a non matching text tag between two of the ways that will be examined
     map->getWay(
@@ -136,8 +136,8 @@ public:
   {
     QDir().mkdir("test-output/conflate");
     OsmMap::resetCounters();
-    OsmMapPtr map(new OsmMap());
-    OsmMapReaderFactory::read(map, "test-files/DcTigerRoads.osm", true, Status::Unknown1);
+    OsmMapPtr map =
+      TestUtils::loadFixtureMap("test-files/DcTigerRoads.osm", true, Status::Unknown1);
 
     //create a non matching text tag between two of the ways that will be examined
     map->getWay(
@@ -61,6 +61,7 @@ class MapCleanerTest : public CppUnit::TestFixture
 {
     CPPUNIT_TEST_SUITE(MapCleanerTest);
     CPPUNIT_TEST(runBasicTest);
+    CPPUNIT_TEST(runCacheTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -87,6 +88,40 @@ public:
                        "test-output/conflate/MapCleaner.osm");
     }
 
+    void runCacheTest()
+    {
+      Settings::getInstance().clear();
+      OsmSchema::getInstance().loadDefault();
+      QDir().mkpath("test-output/conflate");
+      conf().set("map.cleaner.cache.dir", "test-output/conflate/MapCleanerCache");
+
+      //first pass populates the cache.
+      OsmXmlReader reader;
+      OsmMap::resetCounters();
+      OsmMapPtr map(new OsmMap());
+      reader.setDefaultStatus(Status::Unknown1);
+      reader.read("test-files/DcTigerRoads.osm", map);
+      MapCleaner().apply(map);
+      MapProjector::projectToWgs84(map);
+      OsmXmlWriter writer;
+      writer.write(map, "test-output/conflate/MapCleanerCacheMiss.osm");
+      HOOT_FILE_EQUALS("test-files/conflate/MapCleaner.osm",
+                       "test-output/conflate/MapCleanerCacheMiss.osm");
+
+      //second pass on the same input loads the cached cleaned map instead of re-running the op
+      //chain and must produce the same result.
+      OsmMap::resetCounters();
+      OsmMapPtr map2(new OsmMap());
+      reader.read("test-files/DcTigerRoads.osm", map2);
+      MapCleaner().apply(map2);
+      MapProjector::projectToWgs84(map2);
+      writer.write(map2, "test-output/conflate/MapCleanerCacheHit.osm");
+      HOOT_FILE_EQUALS("test-files/conflate/MapCleaner.osm",
+                       "test-output/conflate/MapCleanerCacheHit.osm");
+
+      Settings::getInstance().clear();
+    }
+
 };
 
 //putting this in the quick test suite causes MatchComparatorTest to fail
@@ -42,6 +42,7 @@ namespace hoot
 class ReviewMarkerTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(ReviewMarkerTest);
+  CPPUNIT_TEST(runBuildReviewTableTest);
   CPPUNIT_TEST(runNeedsReviewTest);
   CPPUNIT_TEST(runSimpleTest);
   CPPUNIT_TEST(runMultipleScoresTest);
@@ -49,6 +50,46 @@ class ReviewMarkerTest : public CppUnit::TestFixture
 
 public:
 
+  void runBuildReviewTableTest()
+  {
+    TestUtils::resetEnvironment();
+
+    OsmMapPtr map(new OsmMap());
+    ElementPtr n1(new Node(Status::Unknown1, 1, 0, 0, 0));
+    ElementPtr n2(new Node(Status::Unknown2, 2, 0, 0, 0));
+    ElementPtr n3(new Node(Status::Unknown2, 3, 0, 0, 0));
+    map->addElement(n1);
+    map->addElement(n2);
+    map->addElement(n3);
+
+    ReviewMarker uut;
+
+    // two reviews over the same member set plus one over a different set
+    uut.mark(map, n1, n2, "a note", "test");
+    uut.mark(map, n1, n2, "another note", "test");
+    uut.mark(map, n2, n3, "a note", "test");
+
+    QHash<QString, QList<ReviewMarker::ReviewUid> > table = uut.buildReviewTable(map);
+
+    CPPUNIT_ASSERT_EQUAL(2, table.size());
+    int duplicateBuckets = 0;
+    for (QHash<QString, QList<ReviewMarker::ReviewUid> >::const_iterator it = table.begin();
+         it != table.end(); ++it)
+    {
+      // every review in a bucket must reference the same member set
+      std::set<ElementId> members = uut.getReviewElements(map, it.value()[0]);
+      for (int i = 1; i < it.value().size(); i++)
+      {
+        HOOT_STR_EQUALS(members, uut.getReviewElements(map, it.value()[i]));
+      }
+      if (it.value().size() > 1)
+      {
+        duplicateBuckets++;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(1, duplicateBuckets);
+  }
+
   void runNeedsReviewTest()
   {
     TestUtils::resetEnvironment();
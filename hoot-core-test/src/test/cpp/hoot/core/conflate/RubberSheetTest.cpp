@@ -32,6 +32,7 @@
 #include <hoot/core/io/OsmXmlReader.h>
 #include <hoot/core/io/OsmXmlWriter.h>
 #include <hoot/core/ops/MapCropper.h>
+#include <hoot/core/util/Settings.h>
 
 #include <tgs/Statistics/Random.h>
 
@@ -59,6 +60,7 @@ class RubberSheetTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(RubberSheetTest);
   CPPUNIT_TEST(runSimpleTest);
+  CPPUNIT_TEST(runParallelTest);
   CPPUNIT_TEST(runIoTest);
   CPPUNIT_TEST(runCalculateTiePointDistancesTest);
   CPPUNIT_TEST(runCalculateTiePointDistancesNotEnoughTiePointsTest);
@@ -162,6 +164,42 @@ public:
                      "test-output/conflate/RubberSheetSimple.osm");
   }
 
+  /**
+   * The threaded tie point search and warp application must produce exactly the same output as
+   * the serial code paths.
+   */
+  void runParallelTest()
+  {
+    TestUtils::resetEnvironment();
+    conf().set("rubber.sheet.threads", 4);
+
+    OsmXmlReader reader;
+    OsmMap::resetCounters();
+    OsmMapPtr map(new OsmMap());
+    reader.setDefaultStatus(Status::Unknown1);
+    reader.read("test-files/DcGisRoads.osm", map);
+    reader.setDefaultStatus(Status::Unknown2);
+    reader.read("test-files/DcTigerRoads.osm", map);
+
+    MapCropper(Envelope(-77.0554,-77.0441,38.8833,38.8933)).apply(map);
+
+    MapCleaner().apply(map);
+    RubberSheet uut;
+    uut.setReference(false);
+    uut.apply(map);
+
+    MapProjector::projectToWgs84(map);
+
+    QDir().mkdir("test-output/conflate/");
+    OsmXmlWriter writer;
+    writer.write(map, "test-output/conflate/RubberSheetParallel.osm");
+
+    conf().set("rubber.sheet.threads", 1);
+
+    HOOT_FILE_EQUALS("test-files/conflate/RubberSheetSimple.osm",
+                     "test-output/conflate/RubberSheetParallel.osm");
+  }
+
   void runCalculateTiePointDistancesTest()
   {
     RubberSheet rubberSheet;
@@ -0,0 +1,96 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/conflate/SearchRadiusGrid.h>
+
+#include "../TestUtils.h"
+
+// Std
+#include <math.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+class SearchRadiusGridTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SearchRadiusGridTest);
+  CPPUNIT_TEST(runDensityAdaptiveTest);
+  CPPUNIT_TEST(runNotEnoughSamplesTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runDensityAdaptiveTest()
+  {
+    //a tight cluster of well aligned ties near the origin and a sparser, sloppier set of ties
+    //10km away
+    vector<pair<Coordinate, double> > samples;
+    for (int i = 0; i < 10; i++)
+    {
+      samples.push_back(pair<Coordinate, double>(Coordinate(i * 50.0, i * 50.0), 2.0));
+    }
+    for (int i = 0; i < 10; i++)
+    {
+      samples.push_back(
+        pair<Coordinate, double>(Coordinate(10000.0 + i * 200.0, i * 200.0), 40.0));
+    }
+
+    SearchRadiusGrid grid;
+    grid.build(samples, 1000.0, 5, 30.0);
+    CPPUNIT_ASSERT(grid.isBuilt());
+
+    const double urbanRadius = grid.radiusAt(Coordinate(250.0, 250.0));
+    const double ruralRadius = grid.radiusAt(Coordinate(10500.0, 500.0));
+    //two sigma of constant distances is just twice the distance (within sample size bias)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2 * sqrt(10.0 * 4.0 / 9.0), urbanRadius, 1e-3);
+    //the queried rural cell holds the five ties with x in [10000, 11000) and y in [0, 1000)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2 * sqrt(5.0 * 1600.0 / 4.0), ruralRadius, 1e-3);
+    CPPUNIT_ASSERT(urbanRadius < ruralRadius);
+
+    //locations outside of the grid get the fallback radius
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, grid.radiusAt(Coordinate(-50000.0, -50000.0)), 1e-3);
+  }
+
+  void runNotEnoughSamplesTest()
+  {
+    vector<pair<Coordinate, double> > samples;
+    samples.push_back(pair<Coordinate, double>(Coordinate(0.0, 0.0), 5.0));
+
+    SearchRadiusGrid grid;
+    grid.build(samples, 1000.0, 5, 30.0);
+    CPPUNIT_ASSERT(!grid.isBuilt());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, grid.radiusAt(Coordinate(0.0, 0.0)), 1e-3);
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SearchRadiusGridTest, "quick");
+
+}
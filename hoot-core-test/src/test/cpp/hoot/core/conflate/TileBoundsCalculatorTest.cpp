@@ -57,6 +57,7 @@ class TileBoundsCalculatorTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TileBoundsCalculatorTest);
   CPPUNIT_TEST(runToyTest);
+  CPPUNIT_TEST(runCostTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -125,6 +126,48 @@ public:
                      "test-output/conflate/TileBounds.osm");
 
   }
+
+  void runCostTest()
+  {
+    OsmXmlReader reader;
+
+    OsmMap::resetCounters();
+    OsmMapPtr map(new OsmMap());
+    reader.setDefaultStatus(Status::Unknown1);
+    reader.read("test-files/DcGisRoads.osm", map);
+    reader.setDefaultStatus(Status::Unknown2);
+    reader.read("test-files/DcTigerRoads.osm", map);
+
+    TileBoundsCalculator uut(0.1 / 360.0);
+    uut.setSlop(0.10);
+    uut.renderImage(map);
+
+    // a bound no tile can exceed gives a single tile holding the total estimated cost.
+    uut.setMaxCostPerBox(1e12);
+    uut.calculateTiles();
+    double total = uut.getTileCosts()[0][0];
+    CPPUNIT_ASSERT(total > 0.0);
+
+    // now force at least a 2x2 split and verify the bound holds for every tile and that the
+    // tiles partition the total cost.
+    double maxCost = total / 4.0;
+    uut.setMaxCostPerBox(maxCost);
+    vector< vector<Envelope> > e = uut.calculateTiles();
+    const vector< vector<double> >& costs = uut.getTileCosts();
+    CPPUNIT_ASSERT(e.size() >= 2);
+
+    double sum = 0.0;
+    for (size_t tx = 0; tx < costs.size(); tx++)
+    {
+      CPPUNIT_ASSERT_EQUAL(e[tx].size(), costs[tx].size());
+      for (size_t ty = 0; ty < costs[tx].size(); ty++)
+      {
+        CPPUNIT_ASSERT(costs[tx][ty] <= maxCost);
+        sum += costs[tx][ty];
+      }
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(total, sum, total * 1e-9);
+  }
 };
 
 }
@@ -55,6 +55,7 @@ class WayCleanerTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(WayCleanerTest);
   CPPUNIT_TEST(runDuplicateNodesTest);
   CPPUNIT_TEST(runDuplicateCoordsTest);
+  CPPUNIT_TEST(runCleanRequiredTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -128,6 +129,33 @@ public:
     }
     CPPUNIT_ASSERT(exceptionMsg.toLower().contains("cannot clean zero length way"));
   }
+
+  void runCleanRequiredTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, 0);
+
+    //the node list mutators flag a way as it is built
+    WayPtr clean = TestUtils::createWay(map, QList<NodePtr>() << n1 << n2 << n3);
+    CPPUNIT_ASSERT(clean->getCleanRequired());
+    clean->setCleanRequired(false);
+
+    WayPtr duplicate = TestUtils::createWay(map, QList<NodePtr>() << n1 << n2 << n2 << n3);
+    WayPtr zeroLength = TestUtils::createWay(map, QList<NodePtr>() << n1 << n1);
+
+    WayCleaner::cleanWays(map);
+
+    //the unflagged way is skipped
+    CPPUNIT_ASSERT_EQUAL((size_t)3, clean->getNodeCount());
+    //the flagged way with a duplicate node is cleaned and unflagged
+    CPPUNIT_ASSERT(!WayCleaner::hasDuplicateNodes(duplicate));
+    CPPUNIT_ASSERT_EQUAL((size_t)3, duplicate->getNodeCount());
+    CPPUNIT_ASSERT(!duplicate->getCleanRequired());
+    //the flagged zero length way is removed
+    CPPUNIT_ASSERT(!map->containsWay(zeroLength->getId()));
+  }
 };
 
 }
@@ -37,6 +37,7 @@ class HistogramTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(HistogramTest);
   CPPUNIT_TEST(runTest);
+  CPPUNIT_TEST(runNormalizedDiffTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -52,6 +53,29 @@ public:
 
     HOOT_STR_EQUALS("11.25°: 0.0807461, 33.75°: 0.135935, 56.25°: 0.116651, 78.75°: 0.179311, 101.25°: 0.267439, 123.75°: 0.161358, 146.25°: 0.0359945, 168.75°: 0.00295457, 191.25°: 8.92202e-05, 213.75°: 9.91146e-07, 236.25°: 4.05363e-09, 258.75°: 2.03138e-09, 281.25°: 4.95573e-07, 303.75°: 4.46101e-05, 326.25°: 0.00147729, 348.75°: 0.017998", uut);
   }
+
+  void runNormalizedDiffTest()
+  {
+    Histogram h1(16);
+    h1.addAngle(toRadians(25.0), 10);
+    h1.addAngle(toRadians(100.0), 20);
+    // negative angles and angles past 360° land in the same bins as their wrapped equivalents
+    CPPUNIT_ASSERT_EQUAL(h1.getBin(toRadians(25.0)), h1.getBin(toRadians(25.0 - 360.0)));
+    CPPUNIT_ASSERT_EQUAL(h1.getBin(toRadians(25.0)), h1.getBin(toRadians(25.0 + 360.0)));
+
+    Histogram h2(16);
+    h2.addAngle(toRadians(95.0), 5);
+    h2.addAngle(toRadians(240.0), 15);
+
+    // normalizedDiff gives the same answer as normalizing both histograms and diffing them
+    const double normalizedDiff = h1.normalizedDiff(h2);
+    h1.normalize();
+    h2.normalize();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(h1.diff(h2), normalizedDiff, 0.0);
+
+    // identical histograms have no diff
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, h1.normalizedDiff(h1), 0.0);
+  }
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(HistogramTest, "quick");
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/PackedNodeCoordinates.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class PackedNodeCoordinatesTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PackedNodeCoordinatesTest);
+  CPPUNIT_TEST(runBoundsTest);
+  CPPUNIT_TEST(runApplyTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runBoundsTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    map->addNode(NodePtr(new Node(Status::Unknown1, 1, -1.5, 2.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, 2, 3.5, -4.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, 3, 0.0, 0.5, 10.0)));
+
+    PackedNodeCoordinates coords(*map);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, coords.size());
+
+    OGREnvelope e = coords.calculateBounds();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.5, e.MinX, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, e.MaxX, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-4.0, e.MinY, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, e.MaxY, 1e-9);
+
+    // an empty map produces an uninitialized envelope.
+    OsmMapPtr empty(new OsmMap());
+    CPPUNIT_ASSERT_EQUAL(0, (int)PackedNodeCoordinates(*empty).calculateBounds().IsInit());
+  }
+
+  void runApplyTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    map->addNode(NodePtr(new Node(Status::Unknown1, 1, 1.0, 2.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, 2, 3.0, 4.0, 10.0)));
+
+    PackedNodeCoordinates coords(*map);
+    for (size_t i = 0; i < coords.size(); ++i)
+    {
+      coords.getX()[i] += 10.0;
+      coords.getY()[i] -= 10.0;
+    }
+    coords.applyToMap(*map);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(11.0, map->getNode(1)->getX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-8.0, map->getNode(1)->getY(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(13.0, map->getNode(2)->getX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-6.0, map->getNode(2)->getY(), 1e-9);
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PackedNodeCoordinatesTest, "quick");
+
+}
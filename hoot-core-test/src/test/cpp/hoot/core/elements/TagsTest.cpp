@@ -52,6 +52,7 @@ class TagsTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(TagsTest);
   CPPUNIT_TEST(runSplitTest);
   CPPUNIT_TEST(runEqualsTest);
+  CPPUNIT_TEST(runGetRefTest);
   CPPUNIT_TEST(unitsTest);
   CPPUNIT_TEST_SUITE_END();
 
@@ -68,6 +69,25 @@ public:
     HOOT_STR_EQUALS(false, (t1 == t3));
   }
 
+  void runGetRefTest()
+  {
+    Tags t;
+    t.set("highway", "primary");
+    t.set("oneway", "YES");
+
+    HOOT_STR_EQUALS("primary", t.getRef("highway"));
+    // a missing key hands back a shared empty string rather than inserting or copying.
+    CPPUNIT_ASSERT(t.getRef("name").isEmpty());
+    CPPUNIT_ASSERT_EQUAL(2, t.size());
+
+    // the case insensitive true/false checks still accept mixed case values.
+    CPPUNIT_ASSERT(t.isTrue("oneway"));
+    t.set("bridge", "No");
+    CPPUNIT_ASSERT(t.isFalse("bridge"));
+    CPPUNIT_ASSERT(!t.isTrue("bridge"));
+    CPPUNIT_ASSERT(!t.isTrue("name"));
+  }
+
   void runSplitTest()
   {
     HOOT_STR_EQUALS("[4]{a;b, c, foo;bar, baz;qux}", Tags::split("a;;b;c;foo;;bar;baz;;qux"));
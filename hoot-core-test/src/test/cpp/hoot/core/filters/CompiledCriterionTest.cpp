@@ -0,0 +1,87 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/filters/ChainCriterion.h>
+#include <hoot/core/filters/CompiledCriterion.h>
+#include <hoot/core/filters/StatusCriterion.h>
+#include <hoot/core/filters/TagCriterion.h>
+
+#include "../TestUtils.h"
+
+using namespace geos::geom;
+
+namespace hoot
+{
+
+class CompiledCriterionTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CompiledCriterionTest);
+  CPPUNIT_TEST(runFlattenTest);
+  CPPUNIT_TEST(runReorderTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runFlattenTest()
+  {
+    // nested chains flatten into a single short-circuit list.
+    ElementCriterionPtr inner(
+      new ChainCriterion(
+        new TagCriterion("highway", "road"), new TagCriterion("surface", "paved")));
+    ElementCriterionPtr root(
+      new ChainCriterion(new StatusCriterion(Status::Unknown1), inner));
+    CompiledCriterion uut(root);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, uut.getStepCount());
+  }
+
+  void runReorderTest()
+  {
+    ElementCriterionPtr root(
+      new ChainCriterion(
+        new StatusCriterion(Status::Unknown1), new TagCriterion("highway", "road")));
+    CompiledCriterion uut(root);
+    ChainCriterion reference(
+      new StatusCriterion(Status::Unknown1), new TagCriterion("highway", "road"));
+
+    // run well past the reorder interval; results must match the plain chain throughout.
+    for (int i = 0; i < 5000; i++)
+    {
+      NodePtr node(new Node(i % 2 == 0 ? Status::Unknown1 : Status::Unknown2, -1 - i,
+        Coordinate(0.0, 0.0), 15.0));
+      if (i % 3 == 0)
+      {
+        node->getTags().set("highway", "road");
+      }
+      CPPUNIT_ASSERT_EQUAL(reference.isSatisfied(node), uut.isSatisfied(node));
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CompiledCriterionTest, "quick");
+
+}
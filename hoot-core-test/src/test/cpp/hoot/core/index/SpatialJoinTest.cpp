@@ -0,0 +1,131 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/index/SpatialJoin.h>
+#include <hoot/core/util/ConfigOptions.h>
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QList>
+
+// Standard
+#include <set>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class SpatialJoinTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SpatialJoinTest);
+  CPPUNIT_TEST(runSelfJoinTest);
+  CPPUNIT_TEST(runTwoSetJoinTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  virtual void tearDown()
+  {
+    TestUtils::resetEnvironment();
+  }
+
+  static pair<ElementId, ElementId> normalize(ElementId a, ElementId b)
+  {
+    return a < b ? pair<ElementId, ElementId>(a, b) : pair<ElementId, ElementId>(b, a);
+  }
+
+  void runSelfJoinTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown2, 5, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown2, 100, 0);
+    NodePtr w1 = TestUtils::createNode(map, Status::Unknown1, 0, 5);
+    NodePtr w2 = TestUtils::createNode(map, Status::Unknown1, 10, 5);
+    WayPtr w = TestUtils::createWay(map, QList<NodePtr>() << w1 << w2);
+
+    set<ElementId> candidates;
+    candidates.insert(n1->getElementId());
+    candidates.insert(n2->getElementId());
+    candidates.insert(n3->getElementId());
+    candidates.insert(w->getElementId());
+
+    SpatialJoin uut(map);
+    vector< pair<ElementId, ElementId> > pairs = uut.join(candidates, 10.0);
+
+    //n1/n2 are 5m apart and the way's envelope is within 5m of both; n3 is too far from
+    //everything. The way's own nodes aren't candidates, so they emit nothing.
+    set< pair<ElementId, ElementId> > pairSet(pairs.begin(), pairs.end());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, pairSet.size());
+    CPPUNIT_ASSERT(pairSet.count(normalize(n1->getElementId(), n2->getElementId())) == 1);
+    CPPUNIT_ASSERT(pairSet.count(normalize(n1->getElementId(), w->getElementId())) == 1);
+    CPPUNIT_ASSERT(pairSet.count(normalize(n2->getElementId(), w->getElementId())) == 1);
+
+    //the shards are concatenated in order, so the parallel result is identical.
+    conf().set(ConfigOptions::getSpatialJoinThreadsKey(), 4);
+    vector< pair<ElementId, ElementId> > parallel = uut.join(candidates, 10.0);
+    conf().set(ConfigOptions::getSpatialJoinThreadsKey(), 1);
+    CPPUNIT_ASSERT(pairs == parallel);
+  }
+
+  void runTwoSetJoinTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown2, 5, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown2, 100, 0);
+
+    set<ElementId> from;
+    from.insert(n1->getElementId());
+    set<ElementId> to;
+    to.insert(n2->getElementId());
+    to.insert(n3->getElementId());
+
+    SpatialJoin uut(map);
+    vector< pair<ElementId, ElementId> > pairs = uut.join(from, to, 10.0);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, pairs.size());
+    CPPUNIT_ASSERT(pairs[0].first == n1->getElementId());
+    CPPUNIT_ASSERT(pairs[0].second == n2->getElementId());
+  }
+};
+
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(hoot::SpatialJoinTest, "quick");
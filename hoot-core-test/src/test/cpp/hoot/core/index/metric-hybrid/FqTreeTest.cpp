@@ -228,6 +228,11 @@ public:
       LOG_TRACE("compare: " << s1 << " " << s2);
       return LevenshteinDistance::distance(s1, s2);
     }
+
+    int operator() (const QString& s1, const QString& s2, int /*maxD*/) const
+    {
+      return (*this)(s1, s2);
+    }
   };
 
   void runRandomQueryTest()
@@ -41,6 +41,7 @@
 #include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
 
 // Qt
+#include <QDataStream>
 #include <QStringList>
 
 // Standard
@@ -100,6 +101,25 @@ std::ostream& operator<<(std::ostream & o, const RFqHybridDummyData& dd)
   return o;
 }
 
+QDataStream& operator<<(QDataStream& os, const RFqHybridDummyData& dd)
+{
+  os << dd.getEnvelope().getMinX() << dd.getEnvelope().getMinY();
+  os << (qint32)dd.getElementId().getType().getEnum() << (qint64)dd.getElementId().getId();
+  os << dd.getMetricElement();
+  return os;
+}
+
+QDataStream& operator>>(QDataStream& is, RFqHybridDummyData& dd)
+{
+  double x, y;
+  qint32 type;
+  qint64 id;
+  QString name;
+  is >> x >> y >> type >> id >> name;
+  dd = RFqHybridDummyData(x, y, name, ElementId(ElementType((ElementType::Type)type), id));
+  return is;
+}
+
 class RFqHybridTreeTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(RFqHybridTreeTest);
@@ -107,6 +127,7 @@ class RFqHybridTreeTest : public CppUnit::TestFixture
   CPPUNIT_TEST(runBuildIndexTest);
   CPPUNIT_TEST(runQueryIndexTest);
   CPPUNIT_TEST(runRandomQueryTest);
+  CPPUNIT_TEST(runSerializationTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -571,6 +592,56 @@ public:
 
   }
 
+  void runSerializationTest()
+  {
+    vector<RFqHybridDummyData> keys;
+    vector<int> values;
+
+    int c = 0;
+    keys.push_back(RFqHybridDummyData(0, 0, "cat", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(1, 0, "car", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(0, 1, "banana", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(1, 1, "apple", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(2, 0, "bat", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(3, 0, "cap", ElementId::node(c++)));
+    keys.push_back(RFqHybridDummyData(4, 0, "bandana", ElementId::node(c++)));
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      values.push_back(i);
+    }
+
+    RFqHybridTree<RFqHybridDummyData, int, LevenshteinDistance> uut;
+    uut.buildIndex(keys, values);
+
+    QByteArray data;
+    {
+      QDataStream os(&data, QIODevice::WriteOnly);
+      uut.writeObject(os);
+    }
+
+    RFqHybridTree<RFqHybridDummyData, int, LevenshteinDistance> copy;
+    QDataStream is(&data, QIODevice::ReadOnly);
+    copy.readObject(is);
+
+    // the reloaded tree must be structurally identical and give the same answers.
+    HOOT_STR_EQUALS(uut.toString(), copy.toString());
+    HOOT_STR_EQUALS("[7]{0, 1, 2, 3, 4, 5, 6}",
+      copy.find(Coordinate(0, 0), 5, RFqHybridDummyData("cat"), 10));
+    HOOT_STR_EQUALS("[2]{0, 1}", copy.find(Coordinate(0, 0), 1.1, RFqHybridDummyData("cap"), 1));
+    HOOT_STR_EQUALS("[3]{1, 4, 5}",
+      copy.find(Coordinate(4, 0), 3.01, RFqHybridDummyData("pat"), 2));
+
+    // the bulk query API returns one result set per probe in probe order.
+    vector<Coordinate> points;
+    vector<RFqHybridDummyData> terms;
+    points.push_back(Coordinate(0, 0));
+    terms.push_back(RFqHybridDummyData("cap"));
+    points.push_back(Coordinate(1, 2));
+    terms.push_back(RFqHybridDummyData("apples"));
+    HOOT_STR_EQUALS("[2]{[2]{0, 1}, [1]{3}}", copy.find(points, terms, 1.1, 2));
+  }
+
   int rdelta(int delta)
   {
     return Tgs::Random::instance()->generateInt(delta * 2 + 1) - delta;
@@ -0,0 +1,80 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/io/ApiDb.h>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+/**
+ * Exercises the hstore tag decoding, which doesn't require a database connection.
+ */
+class ApiDbTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(ApiDbTest);
+    CPPUNIT_TEST(runUnescapeTagsTest);
+    CPPUNIT_TEST(runUnescapeTagsEscapesTest);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runUnescapeTagsTest()
+  {
+    Tags tags = ApiDb::unescapeTags(QVariant("\"highway\"=>\"road\", \"name\"=>\"Main St\""));
+    CPPUNIT_ASSERT_EQUAL(2, tags.size());
+    HOOT_STR_EQUALS("road", tags["highway"]);
+    HOOT_STR_EQUALS("Main St", tags["name"]);
+
+    //empty and single pair inputs
+    CPPUNIT_ASSERT_EQUAL(0, ApiDb::unescapeTags(QVariant("")).size());
+    tags = ApiDb::unescapeTags(QVariant("\"building\"=>\"yes\""));
+    CPPUNIT_ASSERT_EQUAL(1, tags.size());
+    HOOT_STR_EQUALS("yes", tags["building"]);
+  }
+
+  void runUnescapeTagsEscapesTest()
+  {
+    //backslash escaped quotes and backslashes
+    Tags tags = ApiDb::unescapeTags(
+      QVariant("\"note\"=>\"say \\\"hi\\\"\", \"path\"=>\"c:\\\\temp\""));
+    CPPUNIT_ASSERT_EQUAL(2, tags.size());
+    HOOT_STR_EQUALS("say \"hi\"", tags["note"]);
+    HOOT_STR_EQUALS("c:\\temp", tags["path"]);
+
+    //the octal forms some hstore output uses for quote and backslash
+    tags = ApiDb::unescapeTags(QVariant("\"note\"=>\"\\042quoted\\042 and \\134slashed\\134\""));
+    CPPUNIT_ASSERT_EQUAL(1, tags.size());
+    HOOT_STR_EQUALS("\"quoted\" and \\slashed\\", tags["note"]);
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ApiDbTest, "quick");
+
+}
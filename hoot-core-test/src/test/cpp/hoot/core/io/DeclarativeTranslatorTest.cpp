@@ -0,0 +1,117 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/elements/Tags.h>
+#include <hoot/core/io/DeclarativeTranslator.h>
+#include <hoot/core/io/ScriptTranslatorFactory.h>
+
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class DeclarativeTranslatorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DeclarativeTranslatorTest);
+  CPPUNIT_TEST(runTranslateTest);
+  CPPUNIT_TEST(runFactoryTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  QString _writeRules()
+  {
+    QDir().mkpath("test-output/io");
+    QString path = "test-output/io/DeclarativeTranslatorTest.rules";
+    QFile f(path);
+    CPPUNIT_ASSERT(f.open(QFile::WriteOnly | QFile::Truncate));
+    QTextStream ts(&f);
+    ts << "# test rules" << endl;
+    ts << "copy NAM name" << endl;
+    ts << "match FCODE AP030 highway=road;surface=paved" << endl;
+    ts << "match FCODE AP050 highway=track" << endl;
+    ts << "always source=test" << endl;
+    return path;
+  }
+
+  void runTranslateTest()
+  {
+    DeclarativeTranslator uut;
+    uut.setScript(_writeRules());
+    CPPUNIT_ASSERT(uut.isValidScript());
+
+    Tags t;
+    t.set("NAM", "Main St");
+    t.set("FCODE", "AP030");
+    t.set("IGNORED", "x");
+    uut.translateToOsm(t, "LAP030", "Line");
+
+    CPPUNIT_ASSERT_EQUAL(QString("Main St"), t.get("name"));
+    CPPUNIT_ASSERT_EQUAL(QString("road"), t.get("highway"));
+    CPPUNIT_ASSERT_EQUAL(QString("paved"), t.get("surface"));
+    CPPUNIT_ASSERT_EQUAL(QString("test"), t.get("source"));
+    // unmapped columns are dropped.
+    CPPUNIT_ASSERT_EQUAL(QString(""), t.get("IGNORED"));
+
+    // empty column values don't produce tags.
+    Tags t2;
+    t2.set("NAM", "");
+    t2.set("FCODE", "AP050");
+    uut.translateToOsm(t2, "LAP030", "Line");
+    CPPUNIT_ASSERT_EQUAL(false, t2.contains("name"));
+    CPPUNIT_ASSERT_EQUAL(QString("track"), t2.get("highway"));
+
+    uut.close();
+  }
+
+  void runFactoryTest()
+  {
+    // the factory should hand .rules files to this translator.
+    ScriptTranslatorPtr t(ScriptTranslatorFactory::getInstance().createTranslator(_writeRules()));
+    CPPUNIT_ASSERT(dynamic_cast<DeclarativeTranslator*>(t.get()) != 0);
+    t->close();
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(DeclarativeTranslatorTest, "quick");
+
+}
@@ -0,0 +1,214 @@
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+// Hoot
+#include <hoot/core/io/ElementCacheStripedLRU.h>
+#include <hoot/core/elements/Element.h>
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/elements/Relation.h>
+#include <hoot/core/elements/Status.h>
+
+// Qt
+#include <QThread>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+/**
+ * Writes a disjoint range of nodes into a shared cache and reads them back; used to exercise the
+ * cache from several threads at once.
+ */
+class StripedCacheWriterThread : public QThread
+{
+public:
+
+  StripedCacheWriterThread(ElementCacheStripedLRU& cache, long startId, long count) :
+    _cache(cache),
+    _startId(startId),
+    _count(count),
+    _failed(false)
+  {
+  }
+
+  virtual void run()
+  {
+    Status status;
+    Meters circularError(3.0);
+    for (long i = 0; i < _count; i++)
+    {
+      const long id = _startId + i;
+      ConstElementPtr newNode(new Node(status, id, 2.0, 3.0, circularError));
+      _cache.addElement(newNode);
+      if (!_cache.containsNode(id))
+      {
+        _failed = true;
+        return;
+      }
+    }
+  }
+
+  bool failed() const { return _failed; }
+
+private:
+
+  ElementCacheStripedLRU& _cache;
+  long _startId;
+  long _count;
+  bool _failed;
+};
+
+class ElementCacheStripedLruTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementCacheStripedLruTest);
+  CPPUNIT_TEST(runCacheSizeTest);
+  CPPUNIT_TEST(runAddAllTypesTest);
+  CPPUNIT_TEST(runDrainTest);
+  CPPUNIT_TEST(runCapacityBoundTest);
+  CPPUNIT_TEST(runConcurrentAddTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runCacheSizeTest()
+  {
+    ElementCacheStripedLRU myCache(8, 16, 24, 4);
+
+    CPPUNIT_ASSERT_EQUAL(myCache.getStripeCount(), static_cast<unsigned int>(4));
+    CPPUNIT_ASSERT_EQUAL(myCache.getNodeCacheSize(), static_cast<unsigned long>(8));
+    CPPUNIT_ASSERT_EQUAL(myCache.getWayCacheSize(), static_cast<unsigned long>(16));
+    CPPUNIT_ASSERT_EQUAL(myCache.getRelationCacheSize(), static_cast<unsigned long>(24));
+  }
+
+  void runAddAllTypesTest()
+  {
+    ElementCacheStripedLRU myCache(10, 10, 10, 4);
+
+    CPPUNIT_ASSERT_EQUAL( myCache.hasMoreElements(), false );
+    CPPUNIT_ASSERT_EQUAL( myCache.isEmpty(), true );
+
+    Status status;
+    Meters circularError(3.0);
+
+    // Negative IDs are just as common as positive ones (hoot assigns them to new elements), so
+    // exercise both
+    ConstElementPtr newNode(new Node(status, 1, 2.0, 3.0, circularError));
+    ConstElementPtr newNode2(new Node(status, -2, 4.0, 5.0, circularError));
+    myCache.addElement(newNode);
+    myCache.addElement(newNode2);
+    ConstElementPtr newWay(new Way(status, 10, circularError));
+    myCache.addElement(newWay);
+    ConstElementPtr newRelation(new Relation(status, -20, circularError));
+    myCache.addElement(newRelation);
+
+    CPPUNIT_ASSERT_EQUAL( myCache.isEmpty(), false );
+    CPPUNIT_ASSERT_EQUAL( myCache.size(), static_cast<unsigned long>(4) );
+    CPPUNIT_ASSERT_EQUAL( myCache.typeCount(ElementType::Node), static_cast<unsigned long>(2) );
+    CPPUNIT_ASSERT_EQUAL( myCache.typeCount(ElementType::Way), static_cast<unsigned long>(1) );
+    CPPUNIT_ASSERT_EQUAL(
+      myCache.typeCount(ElementType::Relation), static_cast<unsigned long>(1) );
+
+    CPPUNIT_ASSERT_EQUAL( myCache.containsNode(1), true );
+    CPPUNIT_ASSERT_EQUAL( myCache.containsNode(-2), true );
+    CPPUNIT_ASSERT_EQUAL( myCache.containsNode(3), false );
+    CPPUNIT_ASSERT_EQUAL( myCache.containsWay(10), true );
+    CPPUNIT_ASSERT_EQUAL( myCache.containsRelation(-20), true );
+    CPPUNIT_ASSERT_EQUAL( myCache.containsElement(ElementId::node(-2)), true );
+
+    CPPUNIT_ASSERT( myCache.getNode(1)->toString() == newNode->toString() );
+    CPPUNIT_ASSERT( myCache.getWay(10)->toString() == newWay->toString() );
+    CPPUNIT_ASSERT( myCache.getRelation(-20)->toString() == newRelation->toString() );
+
+    myCache.removeElement(ElementId::node(-2));
+    CPPUNIT_ASSERT_EQUAL( myCache.containsNode(-2), false );
+    CPPUNIT_ASSERT_EQUAL( myCache.size(), static_cast<unsigned long>(3) );
+
+    myCache.removeElements(ElementType::Way);
+    CPPUNIT_ASSERT_EQUAL( myCache.containsWay(10), false );
+    CPPUNIT_ASSERT_EQUAL( myCache.typeCount(ElementType::Way), static_cast<unsigned long>(0) );
+  }
+
+  void runDrainTest()
+  {
+    ElementCacheStripedLRU myCache(100, 100, 100, 4);
+
+    Status status;
+    Meters circularError(3.0);
+    const long nodeCount = 25;
+    for (long i = 1; i <= nodeCount; i++)
+    {
+      ConstElementPtr newNode(new Node(status, i, 2.0, 3.0, circularError));
+      myCache.addElement(newNode);
+    }
+    ConstElementPtr newWay(new Way(status, 10, circularError));
+    myCache.addElement(newWay);
+
+    // Unlike ElementCacheLRU, elements come back grouped by stripe rather than in global ID
+    // order, but every element must come back exactly once
+    myCache.resetElementIterators();
+    long nodesSeen = 0;
+    while (myCache.getNextNode().get())
+    {
+      nodesSeen++;
+    }
+    CPPUNIT_ASSERT_EQUAL( nodesSeen, nodeCount );
+    long waysSeen = 0;
+    while (myCache.getNextWay().get())
+    {
+      waysSeen++;
+    }
+    CPPUNIT_ASSERT_EQUAL( waysSeen, 1l );
+    CPPUNIT_ASSERT_EQUAL( myCache.hasMoreElements(), false );
+  }
+
+  void runCapacityBoundTest()
+  {
+    // 8 nodes across 4 stripes = 2 per stripe; no amount of inserts may grow past the total
+    ElementCacheStripedLRU myCache(8, 8, 8, 4);
+
+    Status status;
+    Meters circularError(3.0);
+    for (long i = 1; i <= 100; i++)
+    {
+      ConstElementPtr newNode(new Node(status, i, 2.0, 3.0, circularError));
+      myCache.addElement(newNode);
+    }
+
+    CPPUNIT_ASSERT( myCache.typeCount(ElementType::Node) > 0 );
+    CPPUNIT_ASSERT( myCache.typeCount(ElementType::Node) <= 8 );
+  }
+
+  void runConcurrentAddTest()
+  {
+    ElementCacheStripedLRU myCache(100000, 100, 100, 8);
+
+    const int threadCount = 4;
+    const long nodesPerThread = 1000;
+    std::vector<boost::shared_ptr<StripedCacheWriterThread> > threads;
+    for (int i = 0; i < threadCount; i++)
+    {
+      boost::shared_ptr<StripedCacheWriterThread> thread(
+        new StripedCacheWriterThread(myCache, i * nodesPerThread + 1, nodesPerThread));
+      thread->start();
+      threads.push_back(thread);
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+      threads[i]->wait();
+      CPPUNIT_ASSERT_EQUAL( threads[i]->failed(), false );
+    }
+
+    CPPUNIT_ASSERT_EQUAL(
+      myCache.typeCount(ElementType::Node),
+      static_cast<unsigned long>(threadCount * nodesPerThread) );
+  }
+};
+
+//CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementCacheStripedLruTest, "current");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementCacheStripedLruTest, "quick");
+
+}
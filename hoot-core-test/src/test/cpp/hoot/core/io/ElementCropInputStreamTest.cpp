@@ -0,0 +1,206 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// GEOS
+#include <geos/geom/GeometryFactory.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/io/ElementCropInputStream.h>
+#include <hoot/core/io/ElementSorter.h>
+using namespace hoot;
+
+// Qt
+#include <QList>
+
+#include "../TestUtils.h"
+
+using namespace geos::geom;
+
+namespace hoot
+{
+
+class ElementCropInputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementCropInputStreamTest);
+  CPPUNIT_TEST(runEnvelopeTest);
+  CPPUNIT_TEST(runGeometryTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  OsmMapPtr _createTestMap()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+
+    // two nodes inside the (0,10,0,10) box, two outside.
+    NodePtr in1 = TestUtils::createNode(map, Status::Unknown1, 1, 1);
+    NodePtr in2 = TestUtils::createNode(map, Status::Unknown1, 5, 5);
+    NodePtr out1 = TestUtils::createNode(map, Status::Unknown1, 20, 20);
+    NodePtr out2 = TestUtils::createNode(map, Status::Unknown1, -5, 5);
+
+    // a way fully inside, a way crossing the boundary and a way fully outside.
+    QList<NodePtr> insideNodes;
+    insideNodes.append(in1);
+    insideNodes.append(in2);
+    WayPtr insideWay = TestUtils::createWay(map, insideNodes);
+
+    QList<NodePtr> crossingNodes;
+    crossingNodes.append(in2);
+    crossingNodes.append(out1);
+    _crossingWayId = TestUtils::createWay(map, crossingNodes)->getId();
+
+    QList<NodePtr> outsideNodes;
+    outsideNodes.append(out1);
+    outsideNodes.append(out2);
+    WayPtr outsideWay = TestUtils::createWay(map, outsideNodes);
+
+    // a relation referencing a kept way and a dropped way.
+    RelationPtr r(new Relation(Status::Unknown1, map->createNextRelationId(), 15));
+    r->addElement("", insideWay->getElementId());
+    r->addElement("", outsideWay->getElementId());
+    map->addRelation(r);
+
+    return map;
+  }
+
+  void _readAll(ElementInputStream& is, int& nodes, int& ways, int& relations)
+  {
+    nodes = 0;
+    ways = 0;
+    relations = 0;
+    while (is.hasMoreElements())
+    {
+      ElementPtr e = is.readNextElement();
+      if (e.get() == 0)
+      {
+        break;
+      }
+      switch (e->getElementType().getEnum())
+      {
+      case ElementType::Node:
+        nodes++;
+        break;
+      case ElementType::Way:
+        ways++;
+        if (e->getId() == _crossingWayId)
+        {
+          // the boundary crossing way is truncated to its kept nodes, not cut exactly.
+          CPPUNIT_ASSERT_EQUAL((size_t)1,
+            boost::dynamic_pointer_cast<Way>(e)->getNodeCount());
+        }
+        break;
+      default:
+        relations++;
+        // the member referencing the dropped way is removed.
+        CPPUNIT_ASSERT_EQUAL((size_t)1,
+          boost::dynamic_pointer_cast<Relation>(e)->getMembers().size());
+        break;
+      }
+    }
+  }
+
+  void runEnvelopeTest()
+  {
+    TestUtils::resetEnvironment();
+    OsmMapPtr map = _createTestMap();
+
+    ElementInputStreamPtr source(new ElementSorter(map));
+    ElementCropInputStream uut(source, Envelope(0, 10, 0, 10));
+
+    int nodes, ways, relations;
+    _readAll(uut, nodes, ways, relations);
+    CPPUNIT_ASSERT_EQUAL(2, nodes);
+    CPPUNIT_ASSERT_EQUAL(2, ways);
+    CPPUNIT_ASSERT_EQUAL(1, relations);
+  }
+
+  void runGeometryTest()
+  {
+    TestUtils::resetEnvironment();
+    OsmMapPtr map = _createTestMap();
+
+    Envelope e(0, 10, 0, 10);
+    boost::shared_ptr<const Geometry> g(GeometryFactory::getDefaultInstance()->toGeometry(&e));
+
+    {
+      ElementInputStreamPtr source(new ElementSorter(map));
+      ElementCropInputStream uut(source, g);
+
+      int nodes, ways, relations;
+      _readAll(uut, nodes, ways, relations);
+      CPPUNIT_ASSERT_EQUAL(2, nodes);
+      CPPUNIT_ASSERT_EQUAL(2, ways);
+      CPPUNIT_ASSERT_EQUAL(1, relations);
+    }
+
+    // inverting keeps only the elements outside the polygon.
+    {
+      OsmMapPtr map2 = _createTestMap();
+      ElementInputStreamPtr source(new ElementSorter(map2));
+      ElementCropInputStream uut(source, g, true);
+
+      int nodes = 0;
+      int ways = 0;
+      int relations = 0;
+      while (uut.hasMoreElements())
+      {
+        ElementPtr el = uut.readNextElement();
+        if (el.get() == 0)
+        {
+          break;
+        }
+        switch (el->getElementType().getEnum())
+        {
+        case ElementType::Node:
+          nodes++;
+          break;
+        case ElementType::Way:
+          ways++;
+          break;
+        default:
+          relations++;
+          break;
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(2, nodes);
+      CPPUNIT_ASSERT_EQUAL(2, ways);
+      // the relation still references the way that fell outside the polygon.
+      CPPUNIT_ASSERT_EQUAL(1, relations);
+    }
+  }
+
+private:
+
+  long _crossingWayId;
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementCropInputStreamTest, "quick");
+
+}
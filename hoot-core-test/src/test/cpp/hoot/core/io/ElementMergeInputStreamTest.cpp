@@ -0,0 +1,143 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Relation.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/io/ElementMergeInputStream.h>
+#include <hoot/core/io/ElementSorter.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ElementMergeInputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementMergeInputStreamTest);
+  CPPUNIT_TEST(runConflictRemapTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  NodePtr _addNode(OsmMapPtr map, long id, double x, double y)
+  {
+    NodePtr n(new Node(Status::Unknown1, id, x, y, 15.0));
+    map->addNode(n);
+    return n;
+  }
+
+  void runConflictRemapTest()
+  {
+    OsmMap::resetCounters();
+
+    OsmMapPtr mapA(new OsmMap());
+    _addNode(mapA, 1, 0.0, 0.0);
+    _addNode(mapA, 2, 1.0, 0.0);
+    _addNode(mapA, 3, 2.0, 0.0);
+    WayPtr wayA(new Way(Status::Unknown1, 10, 15.0));
+    wayA->addNode(1);
+    wayA->addNode(2);
+    mapA->addWay(wayA);
+    RelationPtr relA(new Relation(Status::Unknown1, 20, 15.0));
+    relA->addElement("outer", ElementId::way(10));
+    mapA->addRelation(relA);
+
+    // node 2 and way 10 conflict with map A; node 4 and relation 21 do not
+    OsmMapPtr mapB(new OsmMap());
+    _addNode(mapB, 2, 5.0, 5.0);
+    _addNode(mapB, 4, 6.0, 5.0);
+    WayPtr wayB(new Way(Status::Unknown1, 10, 15.0));
+    wayB->addNode(2);
+    wayB->addNode(4);
+    mapB->addWay(wayB);
+    RelationPtr relB(new Relation(Status::Unknown1, 21, 15.0));
+    relB->addElement("outer", ElementId::way(10));
+    relB->addElement("stop", ElementId::node(2));
+    mapB->addRelation(relB);
+
+    std::vector<ElementInputStreamPtr> inputs;
+    inputs.push_back(ElementInputStreamPtr(new ElementSorter(mapA)));
+    inputs.push_back(ElementInputStreamPtr(new ElementSorter(mapB)));
+    ElementMergeInputStream merged(inputs);
+
+    OsmMapPtr result(new OsmMap());
+    while (merged.hasMoreElements())
+    {
+      ElementPtr e = merged.readNextElement();
+      CPPUNIT_ASSERT(e.get() != 0);
+      CPPUNIT_ASSERT(result->containsElement(e->getElementId()) == false);
+      result->addElement(e);
+    }
+
+    CPPUNIT_ASSERT_EQUAL((size_t)5, result->getNodes().size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, result->getWays().size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, result->getRelations().size());
+
+    // map A kept its ids
+    HOOT_STR_EQUALS(1.0, result->getNode(2)->getX());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, result->getWay(10)->getNodeCount());
+    CPPUNIT_ASSERT_EQUAL(1l, result->getWay(10)->getNodeId(0));
+    CPPUNIT_ASSERT_EQUAL(2l, result->getWay(10)->getNodeId(1));
+    HOOT_STR_EQUALS(
+      ElementId::way(10), result->getRelation(20)->getMembers()[0].getElementId());
+
+    // map B's conflicting node and way were remapped, and B's references follow the remapping
+    long newWayId = 0;
+    for (WayMap::const_iterator it = result->getWays().begin(); it != result->getWays().end();
+         ++it)
+    {
+      if (it->first != 10)
+      {
+        newWayId = it->first;
+      }
+    }
+    CPPUNIT_ASSERT(newWayId < 0);
+    WayPtr newWay = result->getWay(newWayId);
+    long newNodeId = newWay->getNodeId(0);
+    CPPUNIT_ASSERT(newNodeId < 0);
+    HOOT_STR_EQUALS(5.0, result->getNode(newNodeId)->getX());
+    CPPUNIT_ASSERT_EQUAL(4l, newWay->getNodeId(1));
+
+    RelationPtr rel21 = result->getRelation(21);
+    HOOT_STR_EQUALS(ElementId::way(newWayId), rel21->getMembers()[0].getElementId());
+    HOOT_STR_EQUALS(ElementId::node(newNodeId), rel21->getMembers()[1].getElementId());
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementMergeInputStreamTest, "quick");
+
+}
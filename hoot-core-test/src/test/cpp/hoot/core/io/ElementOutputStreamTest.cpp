@@ -0,0 +1,107 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/io/ElementOutputStream.h>
+#include <hoot/core/io/OsmPbfReader.h>
+#include <hoot/core/io/OsmXmlWriter.h>
+#include <hoot/core/util/ConfigOptions.h>
+using namespace hoot;
+
+// Qt
+#include <QDir>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ElementOutputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementOutputStreamTest);
+  CPPUNIT_TEST(runAsyncStreamTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void _streamToyFile(const QString& output)
+  {
+    OsmMap::resetCounters();
+    OsmPbfReader reader(true);
+    reader.open("test-files/ToyTestA.osm.pbf");
+    reader.initializePartial();
+
+    OsmXmlWriter writer;
+    writer.open(output);
+
+    ElementOutputStream::writeAllElements(reader, writer);
+
+    reader.finalizePartial();
+    writer.finalizePartial();
+  }
+
+  void runAsyncStreamTest()
+  {
+    QDir().mkpath("test-output/io/");
+
+    _streamToyFile("test-output/io/ElementOutputStreamSync.osm");
+
+    // the async pipeline must write the same elements in the same order; use a small batch size
+    // so multiple batches cross the queue even on the toy file
+    conf().set(ConfigOptions::getElementStreamAsyncKey(), true);
+    conf().set(ConfigOptions::getElementStreamAsyncBatchSizeKey(), 7);
+    try
+    {
+      _streamToyFile("test-output/io/ElementOutputStreamAsync.osm");
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getElementStreamAsyncKey(),
+                 ConfigOptions::getElementStreamAsyncDefaultValue());
+      conf().set(ConfigOptions::getElementStreamAsyncBatchSizeKey(),
+                 ConfigOptions::getElementStreamAsyncBatchSizeDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getElementStreamAsyncKey(),
+               ConfigOptions::getElementStreamAsyncDefaultValue());
+    conf().set(ConfigOptions::getElementStreamAsyncBatchSizeKey(),
+               ConfigOptions::getElementStreamAsyncBatchSizeDefaultValue());
+
+    HOOT_FILE_EQUALS("test-output/io/ElementOutputStreamSync.osm",
+                     "test-output/io/ElementOutputStreamAsync.osm");
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementOutputStreamTest, "quick");
+
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/io/ElementReprojectInputStream.h>
+#include <hoot/core/io/ElementSorter.h>
+#include <hoot/core/util/MapProjector.h>
+using namespace hoot;
+
+// Qt
+#include <QList>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ElementReprojectInputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementReprojectInputStreamTest);
+  CPPUNIT_TEST(runReprojectTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runReprojectTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+
+    QList<NodePtr> nodes;
+    nodes.append(TestUtils::createNode(map, Status::Unknown1, -77.1, 38.9));
+    nodes.append(TestUtils::createNode(map, Status::Unknown1, -77.0, 38.8));
+    nodes.append(TestUtils::createNode(map, Status::Unknown1, -76.9, 38.7));
+    TestUtils::createWay(map, nodes);
+
+    OGREnvelope env;
+    env.MinX = -77.1;
+    env.MaxX = -76.9;
+    env.MinY = 38.7;
+    env.MaxY = 38.9;
+    boost::shared_ptr<OGRSpatialReference> srs = MapProjector::createOrthographic(env);
+
+    // project a copy of the map the conventional way for reference.
+    OsmMapPtr reference(new OsmMap(map));
+    MapProjector::project(reference, srs);
+
+    ElementInputStreamPtr source(new ElementSorter(map));
+    ElementReprojectInputStream uut(source, srs);
+
+    CPPUNIT_ASSERT(uut.getProjection()->IsSame(srs.get()));
+
+    int nodeCount = 0;
+    int wayCount = 0;
+    while (uut.hasMoreElements())
+    {
+      ElementPtr e = uut.readNextElement();
+      if (e.get() == 0)
+      {
+        break;
+      }
+      if (e->getElementType() == ElementType::Node)
+      {
+        // every streamed node lands exactly where the map based reprojection puts it.
+        NodePtr n = boost::dynamic_pointer_cast<Node>(e);
+        ConstNodePtr expected = reference->getNode(n->getId());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getX(), n->getX(), 0.0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getY(), n->getY(), 0.0);
+        nodeCount++;
+      }
+      else if (e->getElementType() == ElementType::Way)
+      {
+        wayCount++;
+      }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(3, nodeCount);
+    CPPUNIT_ASSERT_EQUAL(1, wayCount);
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementReprojectInputStreamTest, "quick");
+
+}
@@ -30,6 +30,7 @@
 #include <hoot/core/io/OsmMapReaderFactory.h>
 #include <hoot/core/io/OsmMapWriterFactory.h>
 #include <hoot/core/io/ElementSorter.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 
 // Boost
@@ -47,6 +48,7 @@ class ElementSorterTest : public CppUnit::TestFixture
 {
     CPPUNIT_TEST_SUITE(ElementSorterTest);
     CPPUNIT_TEST(runTest);
+    CPPUNIT_TEST(runExternalSortTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -81,6 +83,42 @@ public:
     }
     CPPUNIT_ASSERT_EQUAL(29, index);
   }
+
+  void runExternalSortTest()
+  {
+    OsmMapPtr inputMap(new OsmMap());
+    OsmMapReaderFactory::read(inputMap, "test-files/MultipolygonTest.osm", true);
+
+    //a tiny buffer forces multiple sorted runs to be spilled to disk and merged back on read
+    conf().set(ConfigOptions::getElementSorterBufferSizeKey(), 5);
+    try
+    {
+      ElementInputStreamPtr source(new ElementSorter(inputMap));
+      ElementSorter streamed(source);
+      ElementSorter expected(inputMap);
+
+      while (expected.hasMoreElements())
+      {
+        CPPUNIT_ASSERT(streamed.hasMoreElements());
+        ElementPtr e1 = expected.readNextElement();
+        ElementPtr e2 = streamed.readNextElement();
+        CPPUNIT_ASSERT(e2.get());
+        HOOT_STR_EQUALS(e1->getElementId(), e2->getElementId());
+      }
+      CPPUNIT_ASSERT(!streamed.hasMoreElements());
+      streamed.close();
+    }
+    catch (...)
+    {
+      conf().set(
+        ConfigOptions::getElementSorterBufferSizeKey(),
+        ConfigOptions::getElementSorterBufferSizeDefaultValue());
+      throw;
+    }
+    conf().set(
+      ConfigOptions::getElementSorterBufferSizeKey(),
+      ConfigOptions::getElementSorterBufferSizeDefaultValue());
+  }
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElementSorterTest, "quick");
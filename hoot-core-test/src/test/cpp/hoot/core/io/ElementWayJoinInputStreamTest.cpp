@@ -0,0 +1,111 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// GEOS
+#include <geos/geom/Envelope.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/io/ElementSorter.h>
+#include <hoot/core/io/ElementWayJoinInputStream.h>
+using namespace hoot;
+
+// Qt
+#include <QList>
+
+// Standard
+#include <map>
+
+#include "../TestUtils.h"
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+class ElementWayJoinInputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ElementWayJoinInputStreamTest);
+  CPPUNIT_TEST(runJoinTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runJoinTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 1, 1);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 5, 9);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, 20);
+
+    WayPtr w1 = TestUtils::createWay(map, QList<NodePtr>() << n1 << n2);
+    WayPtr w2 = TestUtils::createWay(map, QList<NodePtr>() << n2 << n3);
+
+    // the sorter streams nodes before ways, so the join sees every coordinate it needs.
+    ElementInputStreamPtr sorted(new ElementSorter(map));
+    ElementWayJoinInputStream uut(sorted);
+
+    std::map<long, WayPtr> ways;
+    while (uut.hasMoreElements())
+    {
+      ElementPtr e = uut.readNextElement();
+      if (e.get() == 0)
+      {
+        break;
+      }
+      if (e->getElementType() == ElementType::Way)
+      {
+        WayPtr w = boost::dynamic_pointer_cast<Way>(e);
+        ways[w->getId()] = w;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)2, ways.size());
+
+    // with no element provider the approximate envelope is the cached envelope the join attached.
+    const Envelope& e1 =
+      ways[w1->getId()]->getApproximateEnvelope(boost::shared_ptr<const ElementProvider>());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, e1.getMinX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, e1.getMaxX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, e1.getMinY(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(9.0, e1.getMaxY(), 1e-9);
+
+    const Envelope& e2 =
+      ways[w2->getId()]->getApproximateEnvelope(boost::shared_ptr<const ElementProvider>());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, e2.getMinX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, e2.getMaxX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(9.0, e2.getMinY(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, e2.getMaxY(), 1e-9);
+  }
+};
+
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(hoot::ElementWayJoinInputStreamTest, "quick");
@@ -0,0 +1,116 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Boost
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+// Hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/io/GeoNamesReader.h>
+
+// Qt
+#include <QDir>
+
+// Standard
+#include <fstream>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class GeoNamesReaderTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(GeoNamesReaderTest);
+  CPPUNIT_TEST(runBasicTest);
+  CPPUNIT_TEST(runGzipTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  QList<NodePtr> readFile(const QString& path)
+  {
+    GeoNamesReader uut;
+    uut.setUseDataSourceIds(true);
+    CPPUNIT_ASSERT(uut.isSupported(path));
+    uut.open(path);
+    uut.initializePartial();
+
+    QList<NodePtr> nodes;
+    while (uut.hasMoreElements())
+    {
+      nodes.append(boost::dynamic_pointer_cast<Node>(uut.readNextElement()));
+    }
+    uut.finalizePartial();
+    uut.close();
+    return nodes;
+  }
+
+  void runBasicTest()
+  {
+    QList<NodePtr> nodes = readFile("test-files/cmd/quick/ConvertGeoNames.geonames");
+
+    CPPUNIT_ASSERT_EQUAL(10, nodes.size());
+    HOOT_STR_EQUALS(293683, nodes[0]->getId());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(34.71745, nodes[0]->getX(), 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.12348, nodes[0]->getY(), 1e-5);
+    HOOT_STR_EQUALS("Wadi ar Rudayhi", nodes[0]->getTags()["asciiname"]);
+    HOOT_STR_EQUALS("2013-01-11", nodes[0]->getTags()["modification_date"].trimmed());
+    HOOT_STR_EQUALS("2012-01-19", nodes[9]->getTags()["modification_date"].trimmed());
+  }
+
+  void runGzipTest()
+  {
+    // compress the fixture and verify the gzipped file reads back identically
+    QDir().mkpath("test-output/io/GeoNamesReaderTest");
+    const QString gzPath = "test-output/io/GeoNamesReaderTest/ConvertGeoNames.geonames.gz";
+    {
+      std::ifstream in("test-files/cmd/quick/ConvertGeoNames.geonames",
+        std::ios_base::in | std::ios_base::binary);
+      std::ofstream out(gzPath.toUtf8().data(), std::ios_base::out | std::ios_base::binary);
+      boost::iostreams::filtering_ostream zout;
+      zout.push(boost::iostreams::gzip_compressor());
+      zout.push(out);
+      zout << in.rdbuf();
+    }
+
+    QList<NodePtr> expected = readFile("test-files/cmd/quick/ConvertGeoNames.geonames");
+    QList<NodePtr> nodes = readFile(gzPath);
+
+    CPPUNIT_ASSERT_EQUAL(expected.size(), nodes.size());
+    for (int i = 0; i < nodes.size(); i++)
+    {
+      HOOT_STR_EQUALS(expected[i]->getId(), nodes[i]->getId());
+      HOOT_STR_EQUALS(expected[i]->getTags(), nodes[i]->getTags());
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(GeoNamesReaderTest, "quick");
+
+}
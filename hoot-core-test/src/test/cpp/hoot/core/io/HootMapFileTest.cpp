@@ -0,0 +1,129 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/io/HootMapFileReader.h>
+#include <hoot/core/io/HootMapFileWriter.h>
+#include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/io/OsmXmlWriter.h>
+using namespace hoot;
+
+// Qt
+#include <QDir>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class HootMapFileTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(HootMapFileTest);
+  CPPUNIT_TEST(runRoundTripTest);
+  CPPUNIT_TEST(runLazyProviderTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  OsmMapPtr _loadToyMap()
+  {
+    OsmXmlReader reader;
+    OsmMapPtr map(new OsmMap());
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/ToyTestA.osm", map);
+    return map;
+  }
+
+  void runRoundTripTest()
+  {
+    OsmMapPtr map = _loadToyMap();
+
+    // add a relation so all three element types round trip
+    RelationPtr r(new Relation(Status::Unknown1, 1, 15.0, "multipolygon"));
+    r->addElement("outer", ElementType::Way, map->getWays().begin()->first);
+    r->getTags().set("name", "test relation");
+    map->addRelation(r);
+
+    QDir().mkpath("test-output/io/");
+    HootMapFileWriter writer;
+    writer.open("test-output/io/HootMapFileTest.hmf");
+    writer.write(map);
+
+    HootMapFileReader reader;
+    reader.open("test-output/io/HootMapFileTest.hmf");
+    OsmMapPtr map2(new OsmMap());
+    reader.read(map2);
+
+    HOOT_STR_EQUALS(OsmXmlWriter::toString(map), OsmXmlWriter::toString(map2));
+  }
+
+  void runLazyProviderTest()
+  {
+    OsmMapPtr map = _loadToyMap();
+
+    QDir().mkpath("test-output/io/");
+    HootMapFileWriter writer;
+    writer.open("test-output/io/HootMapFileLazyTest.hmf");
+    writer.write(map);
+
+    HootMapFileReader reader;
+    reader.open("test-output/io/HootMapFileLazyTest.hmf");
+
+    // materialize individual elements without a full read
+    long wayId = map->getWays().begin()->first;
+    CPPUNIT_ASSERT(reader.containsWay(wayId));
+    CPPUNIT_ASSERT(!reader.containsWay(-99999));
+    ConstWayPtr w = map->getWay(wayId);
+    ConstWayPtr w2 = reader.getWay(wayId);
+    HOOT_STR_EQUALS(w->getNodeIds(), w2->getNodeIds());
+    HOOT_STR_EQUALS(w->getTags(), w2->getTags());
+
+    long nodeId = w->getNodeIds()[0];
+    CPPUNIT_ASSERT(reader.containsNode(nodeId));
+    ConstNodePtr n = map->getNode(nodeId);
+    ConstNodePtr n2 = reader.getNode(nodeId);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(n->getX(), n2->getX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(n->getY(), n2->getY(), 1e-9);
+
+    // every way envelope intersects the map bounds
+    CPPUNIT_ASSERT_EQUAL(map->getWays().size(),
+                         reader.getWayIdsInEnvelope(reader.getBounds()).size());
+
+    reader.close();
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(HootMapFileTest, "quick");
+
+}
@@ -33,6 +33,7 @@
 
 // Hoot
 #include <hoot/core/io/ObjectInputStream.h>
+#include <hoot/core/io/ObjectOutputStream.h>
 #include <hoot/core/io/Serializable.h>
 #include <hoot/core/util/Factory.h>
 
@@ -60,8 +61,10 @@ public:
     stream >> b;
   }
 
-  virtual void writeObject(QDataStream& ) const
+  virtual void writeObject(QDataStream& stream) const
   {
+    stream << a;
+    stream << b;
   }
 
   int a;
@@ -70,10 +73,36 @@ public:
 
 HOOT_FACTORY_REGISTER_BASE(TestClass)
 
+class TestClassBig : public Serializable
+{
+public:
+  static std::string className() { return "TestClassBig"; }
+
+  virtual string getClassName() const { return className(); }
+
+  virtual void readObject(QDataStream& stream)
+  {
+    stream >> padding;
+  }
+
+  virtual void writeObject(QDataStream& stream) const
+  {
+    stream << padding;
+  }
+
+  QString padding;
+};
+
+HOOT_FACTORY_REGISTER_BASE(TestClassBig)
+
 class ObjectInputStreamTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(ObjectInputStreamTest);
   CPPUNIT_TEST(runToyTest);
+  CPPUNIT_TEST(runToyV2Test);
+  CPPUNIT_TEST(runRoundTripTest);
+  CPPUNIT_TEST(runBulkTest);
+  CPPUNIT_TEST(runCompressedTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -96,6 +125,110 @@ public:
 
     CPPUNIT_ASSERT_EQUAL(42, tc->a);
     CPPUNIT_ASSERT_EQUAL(-1, tc->b);
+    delete tc;
+  }
+
+  void runToyV2Test()
+  {
+    // the same record as runToyTest in the version 2 framing; see ObjectOutputStreamTest
+    const unsigned char data[] = {
+       72,  79,  79,  84,   2,   0,   9,  84, 101, 115, 116,  67, 108,  97, 115, 115,   0,   8,
+        0,   0,   0,  42, 255, 255, 255, 255};
+    size_t dataSize = 26;
+
+    string s;
+    s.resize(dataSize);
+    memcpy((char*)s.data(), data, dataSize);
+    stringstream ss(s, stringstream::in);
+
+    ObjectInputStream uut(ss);
+
+    TestClass* tc = uut.readObject<TestClass>();
+
+    CPPUNIT_ASSERT_EQUAL(42, tc->a);
+    CPPUNIT_ASSERT_EQUAL(-1, tc->b);
+    delete tc;
+  }
+
+  void runRoundTripTest()
+  {
+    stringstream ss;
+    ObjectOutputStream out(ss);
+
+    TestClass t1;
+    t1.a = 1;
+    t1.b = 2;
+    TestClass t2;
+    t2.a = -3;
+    t2.b = 4;
+    // the second record exercises the interned class id path
+    out.writeObject(t1);
+    out.writeObject(t2);
+    out.flush();
+
+    stringstream in(ss.str(), stringstream::in);
+    ObjectInputStream uut(in);
+    TestClass* r1 = uut.readObject<TestClass>();
+    TestClass* r2 = uut.readObject<TestClass>();
+
+    CPPUNIT_ASSERT_EQUAL(1, r1->a);
+    CPPUNIT_ASSERT_EQUAL(2, r1->b);
+    CPPUNIT_ASSERT_EQUAL(-3, r2->a);
+    CPPUNIT_ASSERT_EQUAL(4, r2->b);
+    delete r1;
+    delete r2;
+  }
+
+  void runBulkTest()
+  {
+    std::vector<TestClass*> objs;
+    for (int i = 0; i < 5; i++)
+    {
+      TestClass* t = new TestClass();
+      t->a = i;
+      t->b = -i;
+      objs.push_back(t);
+    }
+
+    stringstream ss;
+    ObjectOutputStream out(ss);
+    out.writeObjects(objs);
+
+    stringstream in(ss.str(), stringstream::in);
+    ObjectInputStream uut(in);
+    std::vector<TestClass*> read;
+    uut.readObjects(read);
+
+    CPPUNIT_ASSERT_EQUAL(objs.size(), read.size());
+    for (size_t i = 0; i < read.size(); i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(objs[i]->a, read[i]->a);
+      CPPUNIT_ASSERT_EQUAL(objs[i]->b, read[i]->b);
+      delete objs[i];
+      delete read[i];
+    }
+  }
+
+  void runCompressedTest()
+  {
+    TestClassBig t;
+    t.padding = QString("tile boundary ").repeated(500);
+
+    stringstream ss;
+    ObjectOutputStream out(ss);
+    out.writeObject(t);
+    out.flush();
+
+    // the repetitive payload is over the compression threshold, so the record must come out
+    // smaller than the raw field data
+    CPPUNIT_ASSERT(ss.str().size() < (size_t)(t.padding.size() * 2));
+
+    stringstream in(ss.str(), stringstream::in);
+    ObjectInputStream uut(in);
+    TestClassBig* r = uut.readObject<TestClassBig>();
+
+    CPPUNIT_ASSERT(t.padding == r->padding);
+    delete r;
   }
 };
 
@@ -33,6 +33,7 @@
 
 // Hoot
 #include <hoot/core/io/ObjectOutputStream.h>
+#include <hoot/core/util/ConfigOptions.h>
 
 using namespace hoot;
 
@@ -68,11 +69,50 @@ class ObjectOutputStreamTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(ObjectOutputStreamTest);
   CPPUNIT_TEST(runToyTest);
+  CPPUNIT_TEST(runToyV2Test);
   CPPUNIT_TEST_SUITE_END();
 
 public:
 
   void runToyTest()
+  {
+    // the legacy format must stay byte for byte stable for readers on older versions
+    conf().set(ConfigOptions::getObjectSerializationVersionKey(), 1);
+    stringstream ss;
+    try
+    {
+      ObjectOutputStream uut(ss);
+
+      TestClass2 t;
+      t.a = 42;
+      t.b = -1;
+      uut.writeObject(t);
+      uut.flush();
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getObjectSerializationVersionKey(),
+                 ConfigOptions::getObjectSerializationVersionDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getObjectSerializationVersionKey(),
+               ConfigOptions::getObjectSerializationVersionDefaultValue());
+
+    //TestUtils::dumpString(ss.str());
+
+    const unsigned char data[] = {
+        0,   0,   0,  18,   0,  84,   0, 101,   0, 115,   0, 116,   0,  67,   0, 108,   0,  97,
+        0, 115,   0, 115,   0,   0,   0,  42, 255, 255, 255, 255};
+    size_t dataSize = 30;
+
+    CPPUNIT_ASSERT_EQUAL(dataSize, ss.str().size());
+    for (size_t i = 0; i < dataSize; i++)
+    {
+      CPPUNIT_ASSERT_EQUAL((unsigned int)data[i], (unsigned int)(unsigned char)ss.str().at(i));
+    }
+  }
+
+  void runToyV2Test()
   {
     stringstream ss;
     ObjectOutputStream uut(ss);
@@ -83,12 +123,12 @@ public:
     uut.writeObject(t);
     uut.flush();
 
-    //TestUtils::dumpString(ss.str());
-
+    // "HOOT" magic, version, varint class id, interned class name, compression flag, varint
+    // payload length, payload
     const unsigned char data[] = {
-        0,   0,   0,  18,   0,  84,   0, 101,   0, 115,   0, 116,   0,  67,   0, 108,   0,  97,
-        0, 115,   0, 115,   0,   0,   0,  42, 255, 255, 255, 255};
-    size_t dataSize = 30;
+       72,  79,  79,  84,   2,   0,   9,  84, 101, 115, 116,  67, 108,  97, 115, 115,   0,   8,
+        0,   0,   0,  42, 255, 255, 255, 255};
+    size_t dataSize = 26;
 
     CPPUNIT_ASSERT_EQUAL(dataSize, ss.str().size());
     for (size_t i = 0; i < dataSize; i++)
@@ -34,6 +34,7 @@
 // Hoot
 #include <hoot/core/io/OgrWriter.h>
 #include <hoot/core/io/OsmMapWriterFactory.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/FileUtils.h>
 #include <hoot/core/util/Log.h>
 
@@ -50,6 +51,8 @@ class OgrWriterTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(OgrWriterTest);
   CPPUNIT_TEST(runGdbTest);
   CPPUNIT_TEST(runShpTest);
+  CPPUNIT_TEST(runTransactionBatchTest);
+  CPPUNIT_TEST(runAsyncWriteTest);
   CPPUNIT_TEST(runRelationContainingRelationTest);
   CPPUNIT_TEST_SUITE_END();
 
@@ -136,6 +139,67 @@ public:
                     QDir("test-output/io/OgrWriterTest").entryList(nameFilter));
   }
 
+  void runTransactionBatchTest()
+  {
+    // batched writes must produce the same layers as the per feature path
+    conf().set(ConfigOptions::getOgrWriterTransactionSizeKey(), 2);
+    try
+    {
+      OgrWriter uut;
+      uut.setScriptPath("test-files/io/SampleTranslation.js");
+      FileUtils::removeDir("test-output/io/OgrWriterBatchTest");
+      uut.open("test-output/io/OgrWriterBatchTest.shp");
+      uut.write(createTestMap());
+      uut.close();
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getOgrWriterTransactionSizeKey(),
+                 ConfigOptions::getOgrWriterTransactionSizeDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getOgrWriterTransactionSizeKey(),
+               ConfigOptions::getOgrWriterTransactionSizeDefaultValue());
+
+    QStringList nameFilter;
+    nameFilter << "*.shp";
+    HOOT_STR_EQUALS("[4]{AAL015.shp, LAP010.shp, LAP030.shp, PAL015.shp}",
+                    QDir("test-output/io/OgrWriterBatchTest").entryList(nameFilter));
+  }
+
+  void runAsyncWriteTest()
+  {
+    // the background flush thread must produce the same layers as the single threaded path
+    conf().set(ConfigOptions::getOgrWriterAsyncKey(), true);
+    conf().set(ConfigOptions::getOgrWriterAsyncBatchSizeKey(), 2);
+    try
+    {
+      OgrWriter uut;
+      uut.setScriptPath("test-files/io/SampleTranslation.js");
+      FileUtils::removeDir("test-output/io/OgrWriterAsyncTest");
+      uut.open("test-output/io/OgrWriterAsyncTest.shp");
+      uut.write(createTestMap());
+      uut.close();
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getOgrWriterAsyncKey(),
+                 ConfigOptions::getOgrWriterAsyncDefaultValue());
+      conf().set(ConfigOptions::getOgrWriterAsyncBatchSizeKey(),
+                 ConfigOptions::getOgrWriterAsyncBatchSizeDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getOgrWriterAsyncKey(),
+               ConfigOptions::getOgrWriterAsyncDefaultValue());
+    conf().set(ConfigOptions::getOgrWriterAsyncBatchSizeKey(),
+               ConfigOptions::getOgrWriterAsyncBatchSizeDefaultValue());
+
+    QStringList nameFilter;
+    nameFilter << "*.shp";
+    HOOT_STR_EQUALS("[4]{AAL015.shp, LAP010.shp, LAP030.shp, PAL015.shp}",
+                    QDir("test-output/io/OgrWriterAsyncTest").entryList(nameFilter));
+  }
+
   void runGdbTest()
   {
     OgrWriter uut;
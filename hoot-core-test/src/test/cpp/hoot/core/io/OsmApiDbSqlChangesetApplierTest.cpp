@@ -0,0 +1,91 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/io/OsmApiDbSqlChangesetApplier.h>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+/**
+ * Tests the changeset SQL rewrite done before the SQL is executed. The actual database write is
+ * covered by ServiceOsmApiDbSqlChangesetApplierTest.
+ */
+class OsmApiDbSqlChangesetApplierTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(OsmApiDbSqlChangesetApplierTest);
+  CPPUNIT_TEST(runBatchInsertsTest);
+  CPPUNIT_TEST(runBatchingDisabledTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runBatchInsertsTest()
+  {
+    const QString input =
+      "\n/* create node 1*/\n"
+      "INSERT INTO nodes (node_id, v) VALUES (1, 1);\n"
+      "INSERT INTO current_nodes (id, v) VALUES (1, 1);\n"
+      "/* create node 2*/\n"
+      "INSERT INTO nodes (node_id, v) VALUES (2, 1);\n"
+      "INSERT INTO current_nodes (id, v) VALUES (2, 1);\n"
+      "/* modify node 3*/\n"
+      "INSERT INTO nodes (node_id, v) VALUES (3, 2);\n"
+      "UPDATE current_nodes SET v=2 WHERE id=3;\n"
+      "DELETE FROM node_tags WHERE node_id = 3;\n";
+
+    //inserts are grouped by table, capped at the batch size, and flushed before the update so
+    //statement order relative to updates/deletes is preserved
+    const QString expected =
+      "/* create node 1*/\n"
+      "/* create node 2*/\n"
+      "/* modify node 3*/\n"
+      "INSERT INTO nodes (node_id, v) VALUES (1, 1), (2, 1);\n"
+      "INSERT INTO nodes (node_id, v) VALUES (3, 2);\n"
+      "INSERT INTO current_nodes (id, v) VALUES (1, 1), (2, 1);\n"
+      "UPDATE current_nodes SET v=2 WHERE id=3;\n"
+      "DELETE FROM node_tags WHERE node_id = 3;\n";
+
+    HOOT_STR_EQUALS(expected, OsmApiDbSqlChangesetApplier::batchElementSql(input, 2));
+  }
+
+  void runBatchingDisabledTest()
+  {
+    const QString input =
+      "INSERT INTO nodes (node_id, v) VALUES (1, 1);\n"
+      "INSERT INTO nodes (node_id, v) VALUES (2, 1);\n";
+
+    //a batch size of one or less must leave the SQL untouched
+    HOOT_STR_EQUALS(input, OsmApiDbSqlChangesetApplier::batchElementSql(input, 1));
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(OsmApiDbSqlChangesetApplierTest, "quick");
+
+}
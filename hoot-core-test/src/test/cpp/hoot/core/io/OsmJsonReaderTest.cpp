@@ -29,6 +29,7 @@
 #include <hoot/core/io/OsmJsonReader.h>
 #include <hoot/core/io/OsmXmlWriter.h>
 #include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
 #include <hoot-core-test/src/test/cpp/hoot/core/TestUtils.h>
@@ -41,6 +42,8 @@
 
 // Qt
 #include <QDir>
+#include <QFile>
+#include <QTextStream>
 
 namespace hoot
 {
@@ -54,6 +57,7 @@ class OsmJsonReaderTest : public CppUnit::TestFixture
   CPPUNIT_TEST(urlTest);
   CPPUNIT_TEST(scrubQuoteTest);
   CPPUNIT_TEST(scrubBigIntsTest);
+  CPPUNIT_TEST(streamParserTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -514,6 +518,103 @@ public:
     HOOT_STR_EQUALS(bigIntMultilineCorrect, bigIntMultiline);
   }
 
+  void streamParserTest()
+  {
+    // Exercise nodes, ways, relations, tags (including error:circular and an
+    // escaped apostrophe), and fields the parser should skip over
+    QString testJsonStr =
+      "{                                       \n"
+      " 'version': 0.6,                        \n"
+      " 'generator': 'Overpass API',           \n"
+      " 'osm3s': {                             \n"
+      "   'timestamp_osm_base': 'date',        \n"
+      "   'copyright': 'blah blah blah'        \n"
+      " },                                     \n"
+      " 'elements': [                          \n"
+      " {                                      \n"
+      "   'type': 'node',                      \n"
+      "   'id': -1,                            \n"
+      "   'lat': 2.0,                          \n"
+      "   'lon': -3.0,                         \n"
+      "   'timestamp': '2010-01-01T00:00:00Z', \n"
+      "   'uid': 6,                            \n"
+      "   'tags': {                            \n"
+      "     'name': 'Micah\\'s Street'         \n"
+      "   }                                    \n"
+      " },                                     \n"
+      " {                                      \n"
+      "   'type': 'node',                      \n"
+      "   'id': -2,                            \n"
+      "   'lat': 3.0,                          \n"
+      "   'lon': -3.0                          \n"
+      " },                                     \n"
+      " {                                      \n"
+      "   'type': 'way',                       \n"
+      "   'id': -1,                            \n"
+      "   'nodes': [-1,-2],                    \n"
+      "   'tags': {                            \n"
+      "     'highway': 'road',                 \n"
+      "     '" + MetadataTags::ErrorCircular() + "': '5'\n"
+      "   }                                    \n"
+      " },                                     \n"
+      " {                                      \n"
+      "   'type': 'relation',                  \n"
+      "   'id': -1,                            \n"
+      "   'members': [                         \n"
+      "     {                                  \n"
+      "       'type': 'way',                   \n"
+      "       'ref': -1,                       \n"
+      "       'role': 'outer'                  \n"
+      "     }                                  \n"
+      "   ]                                    \n"
+      " }                                      \n"
+      " ]                                      \n"
+      "}                                       \n";
+
+    // The stream parser reads incrementally off a file handle, so put the doc
+    // in a file
+    QDir().mkpath("test-output/io/");
+    QString path = "test-output/io/OsmJsonReaderStreamTest.json";
+    QFile outfile(path);
+    CPPUNIT_ASSERT(outfile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QTextStream outstream(&outfile);
+    outstream << testJsonStr;
+    outfile.close();
+
+    // Read it with the default property tree parser
+    OsmJsonReader defaultReader;
+    defaultReader.open(path);
+    OsmMapPtr pDefaultMap(new OsmMap());
+    defaultReader.read(pDefaultMap);
+    defaultReader.close();
+
+    // ...and again with the stream parser
+    conf().set(ConfigOptions::getJsonReaderUseStreamParserKey(), true);
+    OsmJsonReader streamReader;
+    OsmMapPtr pStreamMap(new OsmMap());
+    try
+    {
+      streamReader.open(path);
+      streamReader.read(pStreamMap);
+      streamReader.close();
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getJsonReaderUseStreamParserKey(),
+                 ConfigOptions::getJsonReaderUseStreamParserDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getJsonReaderUseStreamParserKey(),
+               ConfigOptions::getJsonReaderUseStreamParserDefaultValue());
+
+    // The two parsers must produce identical maps and metadata
+    HOOT_STR_EQUALS(OsmXmlWriter::toString(pDefaultMap), OsmXmlWriter::toString(pStreamMap));
+    HOOT_STR_EQUALS(defaultReader.getVersion(), streamReader.getVersion());
+    HOOT_STR_EQUALS(defaultReader.getGenerator(), streamReader.getGenerator());
+    HOOT_STR_EQUALS(defaultReader.getTimestampBase(), streamReader.getTimestampBase());
+    HOOT_STR_EQUALS(defaultReader.getCopyright(), streamReader.getCopyright());
+  }
+
 }; // class OsmJsonReaderTest
 } // namespace hoot
 
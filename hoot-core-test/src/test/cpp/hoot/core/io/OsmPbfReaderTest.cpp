@@ -31,6 +31,7 @@
 #include <hoot/core/io/OsmXmlWriter.h>
 #include <hoot/core/io/OsmPbfReader.h>
 #include <hoot/core/io/OsmMapReaderFactory.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
 
@@ -49,6 +50,7 @@ using namespace boost;
 // Qt
 #include <QDebug>
 #include <QDir>
+#include <QFile>
 
 #include <zlib.h>
 
@@ -68,6 +70,8 @@ class OsmPbfReaderTest : public CppUnit::TestFixture
   CPPUNIT_TEST(runReadRelationTest);
   CPPUNIT_TEST(runReadWayTest);
   CPPUNIT_TEST(runToyTest);
+  CPPUNIT_TEST(runToyParallelTest);
+  CPPUNIT_TEST(runBoundedReadTest);
   CPPUNIT_TEST(runToyRelationTest);
   CPPUNIT_TEST(runIsSupportedUrlExistsTest);
   CPPUNIT_TEST(runIsSupportedUrlDoesntExistTest);
@@ -306,6 +310,66 @@ public:
                      "test-output/io/OsmPbfReaderTest.osm");
   }
 
+  void runToyParallelTest()
+  {
+    OsmMap::resetCounters();
+
+    // parallel decode must produce output identical to the serial code path, ids included.
+    conf().set(ConfigOptions::getPbfReaderDecodeThreadsKey(), 4);
+    OsmPbfReader uut(false);
+    conf().set(ConfigOptions::getPbfReaderDecodeThreadsKey(),
+               ConfigOptions::getPbfReaderDecodeThreadsDefaultValue());
+
+    fstream input("test-files/ToyTestA.osm.pbf", ios::in | ios::binary);
+    OsmMapPtr map(new OsmMap());
+    uut.parse(&input, map);
+
+    QDir().mkpath("test-output/io/");
+
+    OsmXmlWriter writer;
+    writer.setIncludeHootInfo(false);
+    writer.write(map, "test-output/io/OsmPbfReaderParallelTest.osm");
+
+    HOOT_FILE_EQUALS("test-files/io/OsmPbfReaderTest.osm",
+                     "test-output/io/OsmPbfReaderParallelTest.osm");
+  }
+
+  void runBoundedReadTest()
+  {
+    OsmMap::resetCounters();
+
+    // work on a copy so the cached side index doesn't land in test-files
+    QDir().mkpath("test-output/io/");
+    QFile::remove("test-output/io/BoundedRead.osm.pbf");
+    QFile::remove("test-output/io/BoundedRead.osm.pbf.bbidx");
+    CPPUNIT_ASSERT(QFile::copy("test-files/ToyTestA.osm.pbf",
+                               "test-output/io/BoundedRead.osm.pbf"));
+
+    // a box covering the whole map reads everything
+    {
+      OsmPbfReader uut(true);
+      uut.setBounds(geos::geom::Envelope(-180, 180, -90, 90));
+      OsmMapPtr map(new OsmMap());
+      uut.read("test-output/io/BoundedRead.osm.pbf", map);
+      CPPUNIT_ASSERT_EQUAL((size_t)36, map->getNodes().size());
+      CPPUNIT_ASSERT_EQUAL((size_t)4, map->getWays().size());
+    }
+
+    // the side index gets cached next to the file on the first bounded read
+    CPPUNIT_ASSERT(QFile::exists("test-output/io/BoundedRead.osm.pbf.bbidx"));
+
+    // a box nowhere near the data skips the node bearing block; the toy file keeps its ways in
+    // the same block, so nothing loads (this read comes from the cached index)
+    {
+      OsmPbfReader uut(true);
+      uut.setBounds(geos::geom::Envelope(0, 1, 0, 1));
+      OsmMapPtr map(new OsmMap());
+      uut.read("test-output/io/BoundedRead.osm.pbf", map);
+      CPPUNIT_ASSERT_EQUAL((size_t)0, map->getNodes().size());
+      CPPUNIT_ASSERT_EQUAL((size_t)0, map->getWays().size());
+    }
+  }
+
   void runToyRelationTest()
   {
     OsmMap::resetCounters();
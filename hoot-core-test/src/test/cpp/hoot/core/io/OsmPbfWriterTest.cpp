@@ -35,6 +35,7 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/io/OsmXmlReader.h>
 #include <hoot/core/io/OsmPbfWriter.h>
+#include <hoot/core/util/ConfigOptions.h>
 
 // Tgs
 #include <tgs/Statistics/Random.h>
@@ -55,6 +56,7 @@ class OsmPbfWriterTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(OsmPbfWriterTest);
   CPPUNIT_TEST(runToyTest);
+  CPPUNIT_TEST(runToyParallelTest);
   CPPUNIT_TEST(runWriteNodeTest);
   CPPUNIT_TEST(runWriteRelationTest);
   CPPUNIT_TEST(runWriteWayTest);
@@ -78,6 +80,24 @@ public:
 
   }
 
+  void runToyParallelTest()
+  {
+    OsmXmlReader reader;
+
+    OsmMapPtr map(new OsmMap());
+    reader.read("test-files/ToyTestA.osm", map);
+
+    // the parallel encoder must produce output byte-identical to the serial code path.
+    conf().set(ConfigOptions::getPbfWriterWriteThreadsKey(), 4);
+    OsmPbfWriter writer;
+    conf().set(ConfigOptions::getPbfWriterWriteThreadsKey(),
+               ConfigOptions::getPbfWriterWriteThreadsDefaultValue());
+    writer.write(map, "test-output/io/OsmPbfWriterParallelTest.pbf");
+
+    HOOT_FILE_EQUALS("test-files/io/OsmPbfWriterTest.pbf",
+                     "test-output/io/OsmPbfWriterParallelTest.pbf");
+  }
+
   void runWriteNodeTest()
   {
     stringstream ss(stringstream::out);
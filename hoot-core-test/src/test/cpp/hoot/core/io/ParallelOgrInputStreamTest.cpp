@@ -0,0 +1,122 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/io/OgrReader.h>
+#include <hoot/core/io/ParallelOgrInputStream.h>
+
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ParallelOgrInputStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ParallelOgrInputStreamTest);
+  CPPUNIT_TEST(runMergeTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  QString _writeRules()
+  {
+    QDir().mkpath("test-output/io");
+    QString path = "test-output/io/ParallelOgrInputStreamTest.rules";
+    QFile f(path);
+    CPPUNIT_ASSERT(f.open(QFile::WriteOnly | QFile::Truncate));
+    QTextStream ts(&f);
+    ts << "always natural=coastline" << endl;
+    return path;
+  }
+
+  void runMergeTest()
+  {
+    QString rules = _writeRules();
+    QString shp = "test-files/jakarta_raya_coastline.shp";
+
+    // serial element count for reference.
+    long serialCount = 0;
+    {
+      OgrReader reader;
+      reader.setTranslationFile(rules);
+      reader.open(shp);
+      reader.initializePartial();
+      while (reader.hasMoreElements())
+      {
+        if (reader.readNextElement().get())
+        {
+          serialCount++;
+        }
+      }
+      reader.close();
+    }
+    CPPUNIT_ASSERT(serialCount > 0);
+
+    // reading the same layer as two jobs on two workers should produce exactly two copies of
+    // every element, merged into one stream.
+    std::vector<ParallelOgrInputStream::Layer> jobs;
+    jobs.push_back(ParallelOgrInputStream::Layer(shp, "jakarta_raya_coastline"));
+    jobs.push_back(ParallelOgrInputStream::Layer(shp, "jakarta_raya_coastline"));
+
+    ParallelOgrInputStream uut(jobs, rules, 2);
+    long parallelCount = 0;
+    long wayCount = 0;
+    while (uut.hasMoreElements())
+    {
+      ElementPtr e = uut.readNextElement();
+      CPPUNIT_ASSERT(e.get() != 0);
+      if (e->getElementType() == ElementType::Way)
+      {
+        CPPUNIT_ASSERT_EQUAL(QString("coastline"), e->getTags().get("natural"));
+        wayCount++;
+      }
+      parallelCount++;
+    }
+    uut.close();
+
+    CPPUNIT_ASSERT_EQUAL(serialCount * 2, parallelCount);
+    CPPUNIT_ASSERT_EQUAL((long)12, wayCount);
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ParallelOgrInputStreamTest, "quick");
+
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/io/PbfDeltaDecode.h>
+using namespace hoot;
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+class PbfDeltaDecodeTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PbfDeltaDecodeTest);
+  CPPUNIT_TEST(runCumulativeSumTest);
+  CPPUNIT_TEST(runToDegreesTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runCumulativeSumTest()
+  {
+    // odd count exercises the vectorized pairs plus the scalar tail
+    qint64 deltas[] = { 100, -3, 7, 0, -104, 9000000000ll, -9000000000ll };
+    size_t count = sizeof(deltas) / sizeof(deltas[0]);
+
+    std::vector<qint64> expected(count);
+    qint64 sum = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      sum += deltas[i];
+      expected[i] = sum;
+    }
+
+    PbfDeltaDecode::cumulativeSum(deltas, count);
+    for (size_t i = 0; i < count; i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected[i], deltas[i]);
+    }
+
+    // empty and single element inputs
+    PbfDeltaDecode::cumulativeSum(deltas, 0);
+    qint64 one[] = { -42 };
+    PbfDeltaDecode::cumulativeSum(one, 1);
+    CPPUNIT_ASSERT_EQUAL((qint64)-42, one[0]);
+  }
+
+  void runToDegreesTest()
+  {
+    // typical OSM values: granularity 100, nanodegree magnitudes up to +/-180 degrees
+    qint64 values[] = { 0, 1, -1, 384887570, -1045231963, 1800000000, -1800000000 };
+    size_t count = sizeof(values) / sizeof(values[0]);
+    qint64 offset = 1300;
+    qint64 granularity = 100;
+
+    std::vector<double> out(count);
+    PbfDeltaDecode::toDegrees(values, count, offset, granularity, &out[0]);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      // must match the scalar conversion expression bit for bit
+      double expected = .000000001 * (double)(offset + granularity * values[i]);
+      CPPUNIT_ASSERT_EQUAL(expected, out[i]);
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PbfDeltaDecodeTest, "quick");
+
+}
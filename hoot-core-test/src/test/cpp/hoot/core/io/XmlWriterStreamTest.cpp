@@ -0,0 +1,97 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/io/OsmXmlWriter.h>
+#include <hoot/core/util/ConfigOptions.h>
+using namespace hoot;
+
+// Qt
+#include <QDir>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class XmlWriterStreamTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(XmlWriterStreamTest);
+  CPPUNIT_TEST(runFastPathParityTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runFastPathParityTest()
+  {
+    OsmXmlReader reader;
+    OsmMapPtr map(new OsmMap());
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/ToyTestA.osm", map);
+
+    // throw some characters at the escaping code.
+    NodeMap::const_iterator it = map->getNodes().begin();
+    NodePtr n = it->second;
+    n->getTags().set("note", "a \"quoted\" <value> & a\nnewline\ttab");
+
+    QDir().mkpath("test-output/io/");
+
+    OsmXmlWriter defaultWriter;
+    defaultWriter.write(map, "test-output/io/XmlWriterStreamDefault.osm");
+
+    // the fast path must produce output identical to the QXmlStreamWriter default.
+    conf().set(ConfigOptions::getOsmMapWriterFastXmlKey(), true);
+    try
+    {
+      OsmXmlWriter fastWriter;
+      fastWriter.write(map, "test-output/io/XmlWriterStreamFast.osm");
+    }
+    catch (...)
+    {
+      conf().set(ConfigOptions::getOsmMapWriterFastXmlKey(),
+                 ConfigOptions::getOsmMapWriterFastXmlDefaultValue());
+      throw;
+    }
+    conf().set(ConfigOptions::getOsmMapWriterFastXmlKey(),
+               ConfigOptions::getOsmMapWriterFastXmlDefaultValue());
+
+    HOOT_FILE_EQUALS("test-output/io/XmlWriterStreamDefault.osm",
+                     "test-output/io/XmlWriterStreamFast.osm");
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(XmlWriterStreamTest, "quick");
+
+}
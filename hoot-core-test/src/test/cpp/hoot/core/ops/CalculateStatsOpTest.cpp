@@ -29,6 +29,8 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/io/OsmXmlReader.h>
 #include <hoot/core/ops/CalculateStatsOp.h>
+#include <hoot/core/ops/RemoveNodeOp.h>
+#include <hoot/core/ops/stats/StatsDeltaListener.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 
@@ -51,6 +53,8 @@ class CalculateStatsOpTest : public CppUnit::TestFixture
   CPPUNIT_TEST(runStatsNumTest);
   CPPUNIT_TEST(runStatsTest);
   CPPUNIT_TEST(runStatsTestWithReviews);
+  CPPUNIT_TEST(runIncrementalStatsTest);
+  CPPUNIT_TEST(runSampledStatsTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -380,6 +384,103 @@ public:
       0.513888, calcStatsOp->getSingleStat("Polygon Translated Populated Tag Percent"), 1e-1);
   }
 
+  void runIncrementalStatsTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+    StatsDeltaListenerPtr delta(new StatsDeltaListener());
+    map->registerListener(delta);
+
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, 0);
+    QList<NodePtr> wayNodes;
+    wayNodes.append(n1);
+    wayNodes.append(n3);
+    WayPtr w1 = TestUtils::createWay(map, wayNodes);
+    RelationPtr r1 = TestUtils::createRelation(map, QList<ElementPtr>() << w1);
+    //the map built so far is the baseline; forget the adds recorded while building it.
+    delta->clear();
+
+    CalculateStatsOp baselineOp;
+    baselineOp.setQuickSubset(true);
+    baselineOp.apply(map);
+
+    //n2 isn't an id extreme and isn't in the way, so the delta stays decomposable.
+    TestUtils::createNode(map, Status::Unknown1, 30, 0);
+    TestUtils::createNode(map, Status::Unknown1, 40, 0);
+    RemoveNodeOp::removeNode(map, n2->getId());
+
+    CalculateStatsOp incrementalOp;
+    incrementalOp.setQuickSubset(true);
+    incrementalOp.applyIncremental(map, baselineOp.getStats(), *delta);
+
+    CalculateStatsOp exactOp;
+    exactOp.setQuickSubset(true);
+    exactOp.apply(map);
+
+    const QString counts[] =
+      { "Node Count", "Way Count", "Relation Count", "Minimum Node ID", "Maximum Node ID",
+        "Minimum Way ID", "Maximum Way ID", "Minimum Relation ID", "Maximum Relation ID" };
+    for (size_t i = 0; i < 9; i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(exactOp.getSingleStat(counts[i]),
+                           incrementalOp.getSingleStat(counts[i]));
+    }
+    CPPUNIT_ASSERT(incrementalOp.getSingleStat("Total Map Memory (Bytes)") > 0.0);
+
+    //removing the minimum node id makes the delta non-decomposable, so this falls back to a full
+    //calculation and still agrees with an exact pass. The incremental stats become the new
+    //baseline, so the delta gets cleared to match.
+    delta->clear();
+    const double minNodeId = incrementalOp.getSingleStat("Minimum Node ID");
+    RemoveNodeOp::removeNode(map, (long)minNodeId);
+    CalculateStatsOp fallbackOp;
+    fallbackOp.setQuickSubset(true);
+    fallbackOp.applyIncremental(map, incrementalOp.getStats(), *delta);
+    CalculateStatsOp exactOp2;
+    exactOp2.setQuickSubset(true);
+    exactOp2.apply(map);
+    CPPUNIT_ASSERT_EQUAL(exactOp2.getSingleStat("Minimum Node ID"),
+                         fallbackOp.getSingleStat("Minimum Node ID"));
+    CPPUNIT_ASSERT_EQUAL(exactOp2.getSingleStat("Node Count"),
+                         fallbackOp.getSingleStat("Node Count"));
+  }
+
+  void runSampledStatsTest()
+  {
+    OsmXmlReader reader;
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+    reader.setDefaultStatus(Status::Unknown1);
+    reader.setUseStatusFromFile(true);
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/ops/CalculateStatsOp/all-data-types.osm", map);
+
+    //a sample at least as big as the map is a census: the extrapolation reproduces the exact
+    //values and the confidence intervals collapse to zero.
+    CalculateStatsOp censusOp;
+    censusOp.setSampleSize(100000);
+    censusOp.apply(map);
+    CPPUNIT_ASSERT_EQUAL(201.0, censusOp.getSingleStat("Node Count"));
+    CPPUNIT_ASSERT_EQUAL(22.0, censusOp.getSingleStat("Way Count"));
+    CPPUNIT_ASSERT_EQUAL(31.0, censusOp.getSingleStat("Total Feature Count"));
+    CPPUNIT_ASSERT_EQUAL(0.0, censusOp.getSingleStat("Total Feature Count 95% Confidence (+/-)"));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1267.47, censusOp.getSingleStat("Meters of Highway"), 1e-1);
+    CPPUNIT_ASSERT_EQUAL(0.0, censusOp.getSingleStat("Meters of Highway 95% Confidence (+/-)"));
+
+    //a genuine sample still gets the exact O(1) counts, and the approximate stats carry a
+    //non-degenerate error bound.
+    CalculateStatsOp sampledOp;
+    sampledOp.setSampleSize(150);
+    sampledOp.apply(map);
+    CPPUNIT_ASSERT_EQUAL(201.0, sampledOp.getSingleStat("Node Count"));
+    CPPUNIT_ASSERT_EQUAL(150.0, sampledOp.getSingleStat("Stats Sample Size"));
+    CPPUNIT_ASSERT(sampledOp.getSingleStat("Total Feature Count") >= 0.0);
+    CPPUNIT_ASSERT(
+      sampledOp.getSingleStat("Total Feature Count 95% Confidence (+/-)") > 0.0);
+  }
+
 private:
 
   boost::shared_ptr<CalculateStatsOp> _calcStats(const QString& inputFile)
@@ -0,0 +1,100 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/ops/CompactIdsOp.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class CompactIdsOpTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CompactIdsOpTest);
+  CPPUNIT_TEST(runBasicTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runBasicTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    map->addNode(NodePtr(new Node(Status::Unknown1, 1000000, 0.0, 0.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, -5000000000, 1.0, 1.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, 42, 2.0, 2.0, 10.0)));
+
+    WayPtr w(new Way(Status::Unknown1, 7777777, 15.0));
+    w->addNode(1000000);
+    w->addNode(-5000000000);
+    w->addNode(42);
+    map->addWay(w);
+
+    RelationPtr r(new Relation(Status::Unknown1, 99999, 15.0));
+    r->addElement("member", ElementId::way(7777777));
+    r->addElement("member", ElementId::node(42));
+    map->addRelation(r);
+
+    CompactIdsOp uut;
+    uut.apply(map);
+
+    // ids come out dense, negative and assigned in ascending old-id order.
+    CPPUNIT_ASSERT_EQUAL(3l, map->getNodeCount());
+    CPPUNIT_ASSERT_EQUAL(1l, map->getWayCount());
+    CPPUNIT_ASSERT_EQUAL(1l, map->getRelationCount());
+    CPPUNIT_ASSERT(map->containsNode(-1));
+    CPPUNIT_ASSERT(map->containsNode(-2));
+    CPPUNIT_ASSERT(map->containsNode(-3));
+    CPPUNIT_ASSERT(map->containsWay(-1));
+    CPPUNIT_ASSERT(map->containsRelation(-1));
+
+    // -5000000000 is the smallest old id so it maps to -1.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, map->getNode(-1)->getX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, map->getNode(-2)->getX(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, map->getNode(-3)->getX(), 1e-9);
+
+    // way-node and relation-member references are rewritten.
+    HOOT_STR_EQUALS("[3]{-3, -1, -2}", map->getWay(-1)->getNodeIds());
+    CPPUNIT_ASSERT_EQUAL(ElementId::way(-1), map->getRelation(-1)->getMembers()[0].getElementId());
+    CPPUNIT_ASSERT_EQUAL(ElementId::node(-2), map->getRelation(-1)->getMembers()[1].getElementId());
+
+    // the mapping table is exposed for external reference translation.
+    CPPUNIT_ASSERT_EQUAL(-3l, uut.getNodeIdMap().find(1000000)->second);
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CompactIdsOpTest, "quick");
+
+}
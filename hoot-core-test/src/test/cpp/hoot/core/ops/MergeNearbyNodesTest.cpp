@@ -22,7 +22,7 @@
  * This will properly maintain the copyright information. DigitalGlobe
  * copyrights will be updated automatically.
  *
- * @copyright Copyright (C) 2013, 2014, 2015 DigitalGlobe (http://www.digitalglobe.com/)
+ * @copyright Copyright (C) 2013, 2014, 2015, 2017 DigitalGlobe (http://www.digitalglobe.com/)
  */
 
 // Hoot
@@ -57,6 +57,7 @@ class MergeNearbyNodesTest : public CppUnit::TestFixture
 {
     CPPUNIT_TEST_SUITE(MergeNearbyNodesTest);
     CPPUNIT_TEST(runBasicTest);
+    CPPUNIT_TEST(runParallelTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -85,6 +86,32 @@ public:
 
     }
 
+    void runParallelTest()
+    {
+      TestUtils::resetEnvironment();
+      OsmMapPtr map(new OsmMap());
+      OsmMap::resetCounters();
+
+      // enough nodes to take the cell partitioned parallel path. each grid position is about
+      // 111m from its neighbors and gets a twin roughly a centimeter away.
+      for (int i = 0; i < 110; i++)
+      {
+        for (int j = 0; j < 110; j++)
+        {
+          const double x = i * 0.001;
+          const double y = j * 0.001;
+          TestUtils::createNode(map, Status::Unknown1, x, y);
+          TestUtils::createNode(map, Status::Unknown1, x + 1e-7, y);
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(24200, (int)map->getNodes().size());
+
+      // merge all nodes within a meter; each twin collapses into its grid position.
+      MergeNearbyNodes::mergeNodes(map, 1.0);
+
+      CPPUNIT_ASSERT_EQUAL(12100, (int)map->getNodes().size());
+    }
+
 };
 
 //CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MergeNearbyNodesTest, "current");
@@ -0,0 +1,79 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/ops/RemoveNodeOp.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class RemoveNodeOpTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(RemoveNodeOpTest);
+  CPPUNIT_TEST(runRemoveFullyTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runRemoveFullyTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    map->addNode(NodePtr(new Node(Status::Unknown1, 1, 0.0, 0.0, 10.0)));
+    map->addNode(NodePtr(new Node(Status::Unknown1, 2, 1.0, 1.0, 10.0)));
+
+    WayPtr w(new Way(Status::Unknown1, 10, 15.0));
+    w->addNode(1);
+    w->addNode(2);
+    map->addWay(w);
+
+    RelationPtr r(new Relation(Status::Unknown1, 20, 15.0));
+    r->addElement("member", ElementId::node(1));
+    map->addRelation(r);
+
+    RemoveNodeOp::removeNodeFully(map, 1);
+
+    // the node is gone and all the way and relation references to it are dropped.
+    CPPUNIT_ASSERT(map->containsNode(1) == false);
+    HOOT_STR_EQUALS("[1]{2}", map->getWay(10)->getNodeIds());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, map->getRelation(20)->getMembers().size());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, map->getRelationsByElement(ElementId::node(1)).size());
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(RemoveNodeOpTest, "quick");
+
+}
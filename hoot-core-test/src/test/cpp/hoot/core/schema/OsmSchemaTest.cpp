@@ -30,6 +30,7 @@
 #include <hoot/core/schema/OsmSchema.h>
 #include <hoot/core/util/ConfPath.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/util/Settings.h>
 
 using namespace hoot;
 
@@ -41,6 +42,7 @@ using namespace hoot;
 
 // Qt
 #include <QDebug>
+#include <QDir>
 #include <QFile>
 
 #include "../TestUtils.h"
@@ -57,6 +59,7 @@ class OsmSchemaTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(OsmSchemaTest);
   CPPUNIT_TEST(averageTest);
+  CPPUNIT_TEST(binaryCacheTest);
   CPPUNIT_TEST(categoryTest);
   CPPUNIT_TEST(loadTest);
   CPPUNIT_TEST(commonAncestorTest);
@@ -65,8 +68,10 @@ class OsmSchemaTest : public CppUnit::TestFixture
   CPPUNIT_TEST(getSimilarTagsTest);
   CPPUNIT_TEST(getTagTest);
   CPPUNIT_TEST(isAncestorTest);
+  CPPUNIT_TEST(precomputedScoresTest);
   CPPUNIT_TEST(isAreaTest);
   CPPUNIT_TEST(isMetaDataTest);
+  CPPUNIT_TEST(typeSignatureTest);
   CPPUNIT_TEST(religionTest);
   CPPUNIT_TEST(elementHasNameTest);
   CPPUNIT_TEST_SUITE_END();
@@ -127,6 +132,44 @@ public:
     HOOT_STR_EQUALS("leisure=badvalue1", avg.toStdString());
   }
 
+  /**
+   * Verifies that a schema loaded from the binary cache answers queries identically to one
+   * loaded from the schema files.
+   */
+  void binaryCacheTest()
+  {
+    QDir().mkpath("test-output/schema");
+    QString cachePath = "test-output/schema/OsmSchemaCache.bin";
+    QFile::remove(cachePath);
+    conf().set("schema.cache.path", cachePath);
+
+    // first load misses the cache, parses the schema files and writes the cache.
+    OsmSchema fresh;
+    fresh.loadDefault();
+    CPPUNIT_ASSERT(QFile::exists(cachePath));
+
+    // second load comes entirely from the cache.
+    OsmSchema cached;
+    cached.loadDefault();
+
+    conf().set("schema.cache.path", QString(""));
+
+    // the graphviz dump covers every vertex and edge including the percolated weights.
+    HOOT_STR_EQUALS(fresh.toGraphvizString(), cached.toGraphvizString());
+
+    CPPUNIT_ASSERT_EQUAL(fresh.getAllTagKeys().size(), cached.getAllTagKeys().size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(fresh.score("highway=primary", "highway=secondary"),
+      cached.score("highway=primary", "highway=secondary"), epsilon);
+    CPPUNIT_ASSERT_EQUAL(fresh.isAncestor("highway=primary", "highway=road"),
+      cached.isAncestor("highway=primary", "highway=road"));
+
+    const SchemaVertex& freshVertex = fresh.getTagVertex("highway=primary");
+    const SchemaVertex& cachedVertex = cached.getTagVertex("highway=primary");
+    HOOT_STR_EQUALS(freshVertex.name, cachedVertex.name);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(freshVertex.influence, cachedVertex.influence, epsilon);
+    CPPUNIT_ASSERT_EQUAL(freshVertex.geometries, cachedVertex.geometries);
+  }
+
   /**
    * Test calculating the average between two tags with weights.
    */
@@ -358,6 +401,27 @@ public:
   /**
    * Test calculating distance between two tags
    */
+  void typeSignatureTest()
+  {
+    OsmSchema& uut = OsmSchema::getInstance();
+
+    Tags highway;
+    highway.set("highway", "primary");
+    const uint64_t highwaySig = uut.getTypeSignature(highway);
+    CPPUNIT_ASSERT(highwaySig != 0);
+
+    // two tag sets whose kvps score above zero always share signature bits
+    Tags road;
+    road.set("highway", "road");
+    CPPUNIT_ASSERT(uut.score("highway=primary", "highway=road") > 0.0);
+    CPPUNIT_ASSERT((highwaySig & uut.getTypeSignature(road)) != 0);
+
+    // tags with no recognized kvps produce an empty signature
+    Tags nonsense;
+    nonsense.set("not a key", "not a value");
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0, uut.getTypeSignature(nonsense));
+  }
+
   void distanceTest()
   {
     OsmSchema uut;
@@ -408,6 +472,32 @@ public:
       "highway=road"));
   }
 
+  /**
+   * Precomputing the score rows up front must give exactly the same answers as calculating them
+   * on demand.
+   */
+  void precomputedScoresTest()
+  {
+    OsmSchema reference;
+    reference.createTestingGraph();
+
+    OsmSchema uut;
+    uut.createTestingGraph();
+    uut.precomputeScores();
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.score("highway=primary", "highway=secondary"),
+      uut.score("highway=primary", "highway=secondary"), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.score("highway=primary", "highway=service"),
+      uut.score("highway=primary", "highway=service"), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.score("highway=primary", "highway=primary"),
+      uut.score("highway=primary", "highway=primary"), 0.0);
+    // a pair with no similarity must still score exactly zero from the precomputed rows.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.score("highway=primary", "name"),
+      uut.score("highway=primary", "name"), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.scoreOneWay("highway=primary", "highway=road"),
+      uut.scoreOneWay("highway=primary", "highway=road"), 0.0);
+  }
+
   void isAreaTest()
   {
     OsmSchema uut;
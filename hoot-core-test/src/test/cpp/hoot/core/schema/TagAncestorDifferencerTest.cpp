@@ -38,6 +38,7 @@ class TagAncestorDifferencerTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TagAncestorDifferencerTest);
   CPPUNIT_TEST(compareRailwaysTest);
+  CPPUNIT_TEST(memoizationTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -85,6 +86,47 @@ public:
     // shared ancestor and exactly the same
     HOOT_STR_EQUALS(0, uut.diff(map, n2, n4));
   }
+
+  void memoizationTest()
+  {
+    TagAncestorDifferencer uut("public_transport=platform");
+
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1(new Node(Status::Unknown1, 1, 0, 0, 15.0));
+    Tags t1;
+    t1["public_transport"] = "platform";
+    t1["train"] = "yes";
+    t1["name"] = "North Station";
+    n1->setTags(t1);
+    map->addNode(n1);
+
+    NodePtr n2(new Node(Status::Unknown2, 2, 0, 0, 15.0));
+    Tags t2;
+    t2["public_transport"] = "platform";
+    t2["bus"] = "yes";
+    t2["highway"] = "secondary";
+    n2->setTags(t2);
+    map->addNode(n2);
+
+    // same signature as n1 aside from the irrelevant name tag.
+    NodePtr n3(new Node(Status::Unknown1, 3, 0, 0, 15.0));
+    Tags t3;
+    t3["public_transport"] = "platform";
+    t3["train"] = "yes";
+    t3["name"] = "South Station";
+    n3->setTags(t3);
+    map->addNode(n3);
+
+    double first = uut.diff(map, n1, n2);
+    CPPUNIT_ASSERT_EQUAL(0L, uut.getCacheHits());
+    CPPUNIT_ASSERT_EQUAL(1L, uut.getCacheRequests());
+
+    // the repeat and the same-signature element both come out of the cache with the same answer.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(first, uut.diff(map, n1, n2), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(first, uut.diff(map, n3, n2), 0.0);
+    CPPUNIT_ASSERT_EQUAL(2L, uut.getCacheHits());
+    CPPUNIT_ASSERT_EQUAL(3L, uut.getCacheRequests());
+  }
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(TagAncestorDifferencerTest, "quick");
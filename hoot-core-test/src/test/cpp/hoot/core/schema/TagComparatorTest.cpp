@@ -32,6 +32,9 @@
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
 
+// Tgs
+#include <tgs/System/Time.h>
+
 // CPP Unit
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
@@ -57,6 +60,8 @@ class TagComparatorTest : public CppUnit::TestFixture
   CPPUNIT_TEST(compareNamesTest);
   CPPUNIT_TEST(compareEnumTest);
   CPPUNIT_TEST(generalizeTest);
+  CPPUNIT_TEST(overwriteMergeTest);
+  CPPUNIT_TEST(overwriteMergeBenchmarkTest);
   CPPUNIT_TEST(generalizeCaseSensitiveTest);
   CPPUNIT_TEST(generalizeCaseInsensitiveTest);
   CPPUNIT_TEST(railwayBusStopTest);
@@ -356,6 +361,120 @@ public:
     }
   }
 
+  void overwriteMergeTest()
+  {
+    TagComparator& uut = TagComparator::getInstance();
+    uut.setCaseSensitive(true);
+
+    // no names and no shared text tags -- this takes the trivial overwrite path.
+    {
+      Tags t1;
+      t1["highway"] = "primary";
+      t1["lanes"] = "2";
+      t1["surface"] = "paved";
+
+      Tags t2;
+      t2["highway"] = "secondary";
+      t2["bridge"] = "yes";
+
+      Tags expected;
+      expected["highway"] = "primary";
+      expected["lanes"] = "2";
+      expected["surface"] = "paved";
+      expected["bridge"] = "yes";
+
+      compareTags(expected, uut.overwriteMerge(t1, t2));
+    }
+
+    // conflicting names force the general path; the losing name is kept as an alt_name.
+    {
+      Tags t1;
+      t1["highway"] = "primary";
+      t1["name"] = "Midland Expressway";
+
+      Tags t2;
+      t2["highway"] = "secondary";
+      t2["name"] = "Midland Expy";
+
+      Tags expected;
+      expected["highway"] = "primary";
+      expected["name"] = "Midland Expressway";
+      expected["alt_name"] = "Midland Expy";
+
+      compareTags(expected, uut.overwriteMerge(t1, t2));
+    }
+
+    // a text tag on both sides is concatenated into a list rather than overwritten.
+    {
+      Tags t1;
+      t1["building"] = "yes";
+      t1["note"] = "foo";
+
+      Tags t2;
+      t2["building"] = "yes";
+      t2["note"] = "bar";
+
+      Tags expected;
+      expected["building"] = "yes";
+      expected["note"] = "foo;bar";
+
+      compareTags(expected, uut.overwriteMerge(t1, t2));
+    }
+  }
+
+  /**
+   * Not a pass/fail benchmark -- merges representative tag distributions in a loop and reports
+   * the per-merge time so regressions in this hot path are visible when run with info logging.
+   */
+  void overwriteMergeBenchmarkTest()
+  {
+    TagComparator& uut = TagComparator::getInstance();
+    uut.setCaseSensitive(true);
+
+    // typical unnamed road pair -- takes the trivial path.
+    Tags road1, road2;
+    road1["highway"] = "primary";
+    road1["lanes"] = "2";
+    road1["oneway"] = "yes";
+    road1["surface"] = "paved";
+    road2["highway"] = "secondary";
+    road2["bridge"] = "yes";
+    road2["surface"] = "asphalt";
+
+    // named POI pair -- takes the general path through mergeNames.
+    Tags poi1, poi2;
+    poi1["amenity"] = "restaurant";
+    poi1["cuisine"] = "italian";
+    poi1["name"] = "Luigi's";
+    poi2["amenity"] = "restaurant";
+    poi2["name"] = "Luigis Restaurant";
+    poi2["phone"] = "555-1234";
+
+    // building pair with a shared text tag -- takes the general path through _mergeText.
+    Tags building1, building2;
+    building1["building"] = "yes";
+    building1["note"] = "digitized from imagery";
+    building2["building"] = "commercial";
+    building2["note"] = "field verified";
+
+    const int iterations = 5000;
+    double start = Tgs::Time::getTime();
+    int checksum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+      checksum += uut.overwriteMerge(road1, road2).size();
+      checksum += uut.overwriteMerge(poi1, poi2).size();
+      checksum += uut.overwriteMerge(building1, building2).size();
+    }
+    double elapsed = Tgs::Time::getTime() - start;
+
+    // keeps the loop meaningful and catches gross behavioral breakage.
+    CPPUNIT_ASSERT_EQUAL(iterations * (5 + 5 + 2), checksum);
+
+    LOG_INFO("overwriteMerge: " << iterations * 3 << " merges in " << elapsed << "s ("
+      << (elapsed / (iterations * 3) * 1e6) << "us per merge)");
+  }
+
   /**
    * Test calculating distance between two tags
    */
@@ -54,6 +54,7 @@ class RasterComparatorTest : public CppUnit::TestFixture
 {
     CPPUNIT_TEST_SUITE(RasterComparatorTest);
     CPPUNIT_TEST(runTest);
+    CPPUNIT_TEST(runStripTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -79,6 +80,29 @@ public:
         CPPUNIT_ASSERT_DOUBLES_EQUAL(0.894, uut.compareMaps(), 0.002);
     }
 
+    void runStripTest()
+    {
+        OsmXmlReader reader;
+
+        OsmMapPtr map(new OsmMap());
+        reader.read("test-files/ToyTestA.osm", map);
+
+        OsmMapPtr map2(new OsmMap());
+        reader.read("test-files/ToyTestB.osm", map2);
+
+        RasterComparator uut(map, map2);
+        uut.setPixelSize(3);
+        double full = uut.compareMaps();
+
+        // small enough that the toy maps get split into several strips.
+        uut.setMaxPixelsInMemory(2000);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(full, uut.compareMaps(), 1e-6);
+
+        // the coarse score is clearly past the threshold so the coarse pass result is returned.
+        uut.setEarlyExit(0.5, 0.1);
+        CPPUNIT_ASSERT(uut.compareMaps() > 0.7);
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(RasterComparatorTest, "quick");
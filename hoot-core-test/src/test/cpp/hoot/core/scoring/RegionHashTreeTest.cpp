@@ -0,0 +1,142 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/scoring/MapComparator.h>
+#include <hoot/core/scoring/RegionHashTree.h>
+#include <hoot/core/util/Log.h>
+
+using namespace hoot;
+
+// Boost
+using namespace boost;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QDir>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class RegionHashTreeTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(RegionHashTreeTest);
+  CPPUNIT_TEST(runCompareTest);
+  CPPUNIT_TEST(runIoTest);
+  CPPUNIT_TEST(runMapComparatorTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  OsmMapPtr _loadMap()
+  {
+    OsmMapPtr map(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.read("test-files/DcGisRoads.osm", map);
+    return map;
+  }
+
+  void runCompareTest()
+  {
+    OsmMapPtr map1 = _loadMap();
+    OsmMapPtr map2 = _loadMap();
+
+    RegionHashTree t1;
+    RegionHashTree t2;
+    t1.build(map1);
+    t2.build(map2);
+
+    // identical maps give identical trees.
+    CPPUNIT_ASSERT(t1.getRootHash().isEmpty() == false);
+    CPPUNIT_ASSERT(t1.getRootHash() == t2.getRootHash());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, RegionHashTree::compareTrees(t1, t2).size());
+
+    // a single local edit changes the root, but only a small number of regions.
+    NodePtr n = map2->getNodes().begin()->second;
+    n->getTags().set("name", "changed");
+    t2.build(map2);
+    CPPUNIT_ASSERT(t1.getRootHash() != t2.getRootHash());
+    const std::vector<int> changed = RegionHashTree::compareTrees(t1, t2);
+    CPPUNIT_ASSERT(changed.size() >= 1);
+    CPPUNIT_ASSERT((int)changed.size() < t1.getRegionCount() / 2);
+    // the changed region is the one the edited node falls in.
+    CPPUNIT_ASSERT_EQUAL(t2.calculateRegion(map2, n), changed[0]);
+  }
+
+  void runIoTest()
+  {
+    OsmMapPtr map = _loadMap();
+
+    RegionHashTree t1;
+    t1.build(map);
+
+    QDir().mkpath("test-output/scoring");
+    t1.write("test-output/scoring/RegionHashTree.tree");
+
+    RegionHashTree t2;
+    t2.read("test-output/scoring/RegionHashTree.tree");
+    CPPUNIT_ASSERT(t1.getRootHash() == t2.getRootHash());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, RegionHashTree::compareTrees(t1, t2).size());
+
+    // a stored fingerprint still detects a change in a freshly built tree. The grid must match,
+    // so build over the stored envelope.
+    NodePtr n = map->getNodes().begin()->second;
+    n->getTags().set("name", "changed");
+    RegionHashTree t3;
+    t3.build(map, t2.getEnvelope());
+    CPPUNIT_ASSERT(t2.getRootHash() != t3.getRootHash());
+  }
+
+  void runMapComparatorTest()
+  {
+    OsmMapPtr map1 = _loadMap();
+    OsmMapPtr map2 = _loadMap();
+
+    MapComparator uut;
+    CPPUNIT_ASSERT_EQUAL(true, uut.isMatch(map1, map2));
+
+    NodePtr n = map2->getNodes().begin()->second;
+    n->getTags().set("name", "changed");
+    DisableLog dl;
+    CPPUNIT_ASSERT_EQUAL(false, uut.isMatch(map1, map2));
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(RegionHashTreeTest, "quick");
+
+}
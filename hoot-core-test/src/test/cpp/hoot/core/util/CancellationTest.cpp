@@ -0,0 +1,104 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/util/Cancellation.h>
+#include <hoot/core/util/HootException.h>
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// tgs
+#include <tgs/System/Time.h>
+
+namespace hoot
+{
+
+class CancellationTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CancellationTest);
+  CPPUNIT_TEST(runCancelRequestTest);
+  CPPUNIT_TEST(runDeadlineTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  virtual void tearDown()
+  {
+    Cancellation::reset();
+  }
+
+  void runCancelRequestTest()
+  {
+    Cancellation::reset();
+    CPPUNIT_ASSERT(!Cancellation::isCancelled());
+    // a no-op until cancellation is requested.
+    Cancellation::checkIn();
+
+    Cancellation::requestCancel();
+    CPPUNIT_ASSERT(Cancellation::isCancelled());
+    CPPUNIT_ASSERT_THROW(Cancellation::checkIn(), OperationCancelledException);
+
+    Cancellation::reset();
+    CPPUNIT_ASSERT(!Cancellation::isCancelled());
+  }
+
+  void runDeadlineTest()
+  {
+    Cancellation::reset();
+    CPPUNIT_ASSERT(!Cancellation::isDeadlineArmed());
+
+    // a generous deadline shouldn't trip.
+    Cancellation::armDeadlineFromNow(100.0);
+    CPPUNIT_ASSERT(Cancellation::isDeadlineArmed());
+    CPPUNIT_ASSERT(!Cancellation::isCancelled());
+    Cancellation::checkIn();
+
+    // re-arm with a deadline that passes almost immediately and wait it out.
+    Cancellation::reset();
+    Cancellation::armDeadlineFromNow(0.001);
+    const double giveUp = Tgs::Time::getTime() + 10.0;
+    while (!Cancellation::isCancelled() && Tgs::Time::getTime() < giveUp)
+    {
+    }
+    CPPUNIT_ASSERT(Cancellation::isCancelled());
+    CPPUNIT_ASSERT_THROW(Cancellation::checkIn(), OperationCancelledException);
+
+    // non-positive values don't arm anything.
+    Cancellation::reset();
+    Cancellation::armDeadlineFromNow(-1.0);
+    CPPUNIT_ASSERT(!Cancellation::isDeadlineArmed());
+  }
+};
+
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(hoot::CancellationTest, "quick");
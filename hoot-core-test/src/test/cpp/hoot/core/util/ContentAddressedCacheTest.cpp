@@ -0,0 +1,143 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/util/ContentAddressedCache.h>
+#include <hoot/core/util/FileUtils.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/Settings.h>
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QDir>
+#include <QFile>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ContentAddressedCacheTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ContentAddressedCacheTest);
+  CPPUNIT_TEST(runKeyTest);
+  CPPUNIT_TEST(runRoundTripTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void _writeFile(QString path, QString content)
+  {
+    QFile f(path);
+    CPPUNIT_ASSERT(f.open(QFile::WriteOnly | QFile::Truncate));
+    f.write(content.toUtf8());
+    f.close();
+  }
+
+  void runKeyTest()
+  {
+    Settings::getInstance().clear();
+    QDir().mkpath("test-output/util");
+    _writeFile("test-output/util/CacheInput1.txt", "input one");
+    _writeFile("test-output/util/CacheInput2.txt", "input two");
+
+    ContentAddressedCache uut("test-output/util/ContentAddressedCache");
+
+    QStringList keys;
+    keys << "test.key.one";
+    conf().set("test.key.one", "a");
+
+    const QString k1 = uut.calculateKey("convert",
+      QStringList("test-output/util/CacheInput1.txt"), keys);
+    CPPUNIT_ASSERT(k1.isEmpty() == false);
+
+    // same stage, input and settings gives the same key.
+    CPPUNIT_ASSERT_EQUAL(k1, uut.calculateKey("convert",
+      QStringList("test-output/util/CacheInput1.txt"), keys));
+
+    // a different stage name, input content or relevant setting each gives a different key.
+    CPPUNIT_ASSERT(k1 != uut.calculateKey("cleanup",
+      QStringList("test-output/util/CacheInput1.txt"), keys));
+    CPPUNIT_ASSERT(k1 != uut.calculateKey("convert",
+      QStringList("test-output/util/CacheInput2.txt"), keys));
+    conf().set("test.key.one", "b");
+    CPPUNIT_ASSERT(k1 != uut.calculateKey("convert",
+      QStringList("test-output/util/CacheInput1.txt"), keys));
+
+    // an irrelevant setting doesn't change the key.
+    conf().set("test.key.one", "a");
+    conf().set("test.key.two", "c");
+    CPPUNIT_ASSERT_EQUAL(k1, uut.calculateKey("convert",
+      QStringList("test-output/util/CacheInput1.txt"), keys));
+
+    // inputs that aren't regular files can't be fingerprinted.
+    CPPUNIT_ASSERT(uut.calculateKey("convert",
+      QStringList("postgresql://user@host/db"), keys).isEmpty());
+
+    Settings::getInstance().clear();
+  }
+
+  void runRoundTripTest()
+  {
+    Settings::getInstance().clear();
+    QDir().mkpath("test-output/util");
+    FileUtils::removeDir("test-output/util/ContentAddressedCacheRt");
+
+    _writeFile("test-output/util/CacheRtInput.txt", "some input");
+
+    ContentAddressedCache uut("test-output/util/ContentAddressedCacheRt");
+    const QString key = uut.calculateKey("convert",
+      QStringList("test-output/util/CacheRtInput.txt"), QStringList());
+    CPPUNIT_ASSERT(key.isEmpty() == false);
+
+    // nothing stored yet.
+    CPPUNIT_ASSERT_EQUAL(false, uut.fetch(key, "test-output/util/CacheRtOutput.txt"));
+
+    _writeFile("test-output/util/CacheRtOutput.txt", "some result");
+    uut.store(key, "test-output/util/CacheRtOutput.txt");
+
+    // the next run gets the stored result back.
+    QFile::remove("test-output/util/CacheRtOutput.txt");
+    CPPUNIT_ASSERT_EQUAL(true, uut.fetch(key, "test-output/util/CacheRtOutput.txt"));
+    QFile f("test-output/util/CacheRtOutput.txt");
+    CPPUNIT_ASSERT(f.open(QFile::ReadOnly));
+    CPPUNIT_ASSERT_EQUAL(QString("some result"), QString::fromUtf8(f.readAll()));
+
+    Settings::getInstance().clear();
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ContentAddressedCacheTest, "quick");
+
+}
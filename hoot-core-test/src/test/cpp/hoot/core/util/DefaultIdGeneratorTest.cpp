@@ -0,0 +1,128 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/DefaultIdGenerator.h>
+using namespace hoot;
+
+// Qt
+#include <QSet>
+#include <QThread>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class DefaultIdGeneratorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DefaultIdGeneratorTest);
+  CPPUNIT_TEST(runSingleThreadSequenceTest);
+  CPPUNIT_TEST(runParallelUniquenessTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  class IdWorker : public QThread
+  {
+  public:
+    IdWorker(DefaultIdGenerator& gen, int count) : _gen(gen), _count(count) {}
+
+    virtual void run()
+    {
+      for (int i = 0; i < _count; i++)
+      {
+        ids.append(_gen.createNodeId());
+      }
+    }
+
+    QList<long> ids;
+
+  private:
+    DefaultIdGenerator& _gen;
+    int _count;
+  };
+
+  virtual void tearDown()
+  {
+    TestUtils::resetEnvironment();
+  }
+
+  void runSingleThreadSequenceTest()
+  {
+    // a single thread sees the same consecutive id sequence no matter the block size.
+    conf().set(ConfigOptions::getIdGeneratorBlockSizeKey(), 8);
+    DefaultIdGenerator blocked;
+    conf().set(ConfigOptions::getIdGeneratorBlockSizeKey(), 1);
+    DefaultIdGenerator plain;
+
+    for (int i = 0; i < 20; i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(plain.createNodeId(), blocked.createNodeId());
+      CPPUNIT_ASSERT_EQUAL(plain.createWayId(), blocked.createWayId());
+      CPPUNIT_ASSERT_EQUAL(plain.createRelationId(), blocked.createRelationId());
+    }
+    CPPUNIT_ASSERT_EQUAL(-20l, blocked.createNodeId() + 1);
+  }
+
+  void runParallelUniquenessTest()
+  {
+    conf().set(ConfigOptions::getIdGeneratorBlockSizeKey(), 16);
+    DefaultIdGenerator gen;
+
+    QList<IdWorker*> workers;
+    for (int i = 0; i < 4; i++)
+    {
+      workers.append(new IdWorker(gen, 500));
+    }
+    for (int i = 0; i < workers.size(); i++)
+    {
+      workers[i]->start();
+    }
+
+    QSet<long> seen;
+    for (int i = 0; i < workers.size(); i++)
+    {
+      workers[i]->wait();
+      for (int j = 0; j < workers[i]->ids.size(); j++)
+      {
+        // every id handed out is globally unique and below the starting point.
+        CPPUNIT_ASSERT(seen.contains(workers[i]->ids[j]) == false);
+        CPPUNIT_ASSERT(workers[i]->ids[j] < 0);
+        seen.insert(workers[i]->ids[j]);
+      }
+      delete workers[i];
+    }
+    CPPUNIT_ASSERT_EQUAL(2000, seen.size());
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(DefaultIdGeneratorTest, "quick");
+
+}
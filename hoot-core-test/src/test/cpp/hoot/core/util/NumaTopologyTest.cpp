@@ -0,0 +1,67 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// hoot
+#include <hoot/core/util/NumaTopology.h>
+
+namespace hoot
+{
+
+class NumaTopologyTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(NumaTopologyTest);
+  CPPUNIT_TEST(runBasicTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runBasicTest()
+  {
+    NumaTopology& topology = NumaTopology::getInstance();
+
+    // whatever the host looks like there is always at least one node, and pinning to any node
+    // (or to a node index past the end, which wraps) must be safe.
+    CPPUNIT_ASSERT(topology.getNodeCount() >= 1);
+    for (int node = 0; node < topology.getNodeCount() + 1; node++)
+    {
+      CPPUNIT_ASSERT(topology.getCpusForNode(node).size() >= 1 ||
+                     topology.getNodeCount() == 1);
+      topology.pinCurrentThreadToNode(node);
+      topology.unpinCurrentThread();
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(NumaTopologyTest, "quick");
+
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/util/Profiler.h>
+
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ProfilerTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ProfilerTest);
+  CPPUNIT_TEST(runScopeTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  /**
+   * The scopes in the production code paths stay inert while the tests run (profiler.enabled
+   * defaults to false), so driving the aggregation directly is safe even though the profiler is
+   * a process wide singleton.
+   */
+  void runScopeTest()
+  {
+    Profiler& uut = Profiler::getInstance();
+
+    uut.startScope("ProfilerTest outer");
+    uut.startScope("ProfilerTest inner");
+    uut.endScope();
+    uut.startScope("ProfilerTest inner");
+    uut.endScope();
+    uut.endScope();
+
+    QString report = uut.getReport();
+    CPPUNIT_ASSERT(report.contains("ProfilerTest outer"));
+    CPPUNIT_ASSERT(report.contains("ProfilerTest inner"));
+    // repeated entries into the same label aggregate rather than producing new lines.
+    CPPUNIT_ASSERT_EQUAL(1, report.count("ProfilerTest inner"));
+    CPPUNIT_ASSERT(report.contains("2 calls"));
+    // the nested label is indented below its parent.
+    int outerPos = report.indexOf("  ProfilerTest outer");
+    int innerPos = report.indexOf("    ProfilerTest inner");
+    CPPUNIT_ASSERT(outerPos >= 0);
+    CPPUNIT_ASSERT(innerPos > outerPos);
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ProfilerTest, "quick");
+
+}
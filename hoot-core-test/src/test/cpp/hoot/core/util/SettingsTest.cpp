@@ -48,12 +48,53 @@ class SettingsTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(SettingsTest);
   CPPUNIT_TEST(envTest);
+  CPPUNIT_TEST(listenerTest);
   CPPUNIT_TEST(replaceTest);
   CPPUNIT_TEST(storeTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
 
+  class CountingListener : public SettingsChangeListener
+  {
+  public:
+
+    CountingListener() : changeCount(0) {}
+
+    virtual void settingsChanged(const QString& key)
+    {
+      changeCount++;
+      lastKey = key;
+    }
+
+    int changeCount;
+    QString lastKey;
+  };
+
+  void listenerTest()
+  {
+    Settings uut;
+    CountingListener listener;
+    uut.registerChangeListener(&listener);
+
+    uut.set("some.key", "some value");
+    CPPUNIT_ASSERT_EQUAL(1, listener.changeCount);
+    CPPUNIT_ASSERT_EQUAL(QString("some.key"), listener.lastKey);
+
+    uut.set("another.key", 42);
+    CPPUNIT_ASSERT_EQUAL(2, listener.changeCount);
+    CPPUNIT_ASSERT_EQUAL(QString("another.key"), listener.lastKey);
+
+    // clearing notifies with an empty key since many values may have changed.
+    uut.clear();
+    CPPUNIT_ASSERT_EQUAL(3, listener.changeCount);
+    CPPUNIT_ASSERT_EQUAL(QString(), listener.lastKey);
+
+    uut.removeChangeListener(&listener);
+    uut.set("some.key", "another value");
+    CPPUNIT_ASSERT_EQUAL(3, listener.changeCount);
+  }
+
   void envTest()
   {
     Settings uut;
@@ -26,9 +26,14 @@
  */
 
 // hoot
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/visitors/CalculateHashVisitor.h>
 
+// Qt
+#include <QCryptographicHash>
+#include <QList>
+
 #include "../TestUtils.h"
 
 using namespace std;
@@ -41,6 +46,12 @@ class CalculateHashVisitorTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(CalculateHashVisitorTest);
   CPPUNIT_TEST(runBasicTest);
+  CPPUNIT_TEST(runWayTest);
+  CPPUNIT_TEST(runRelationTest);
+  CPPUNIT_TEST(runCachedHashTest);
+  CPPUNIT_TEST(runCalculateHashesTest);
+  CPPUNIT_TEST(runFastHashTest);
+  CPPUNIT_TEST(runFindDuplicatesTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -61,6 +72,148 @@ public:
       QString::fromUtf8(CalculateHashVisitor::toHash(n1).toHex().data()));
   }
 
+  void runWayTest()
+  {
+    WayPtr w1(new Way(Status::Unknown1, -1, 5));
+    w1->addNode(1);
+    w1->addNode(2);
+    w1->addNode(3);
+    w1->getTags()["highway"] = "residential";
+    w1->getTags()["name"] = "Main Street";
+    w1->getTags()["source"] = "imagery";
+
+    //ways hash the IDs of the nodes they reference rather than resolved coordinates
+    HOOT_STR_EQUALS("{\"type\":\"Feature\",\"properties\":{\"type\":\"way\",\"tags\":{\"error:circular\":\"5\",\"highway\":\"residential\",\"name\":\"Main Street\"}},\"nodes\":[1,2,3]}",
+      CalculateHashVisitor::toJsonString(w1));
+
+    HOOT_STR_EQUALS("29f526373daff374af5aed8492d8b1bf53993ca2",
+      QString::fromUtf8(CalculateHashVisitor::toHash(w1).toHex().data()));
+  }
+
+  void runRelationTest()
+  {
+    RelationPtr r1(new Relation(Status::Unknown1, -1, 5, "multipolygon"));
+    r1->addElement("outer", ElementId::way(1));
+    r1->addElement("inner", ElementId::way(2));
+    r1->getTags()["building"] = "yes";
+
+    HOOT_STR_EQUALS("{\"type\":\"Feature\",\"properties\":{\"type\":\"relation\",\"tags\":{\"building\":\"yes\",\"error:circular\":\"5\"},\"relation:type\":\"multipolygon\"},\"members\":[{\"type\":\"way\",\"id\":1,\"role\":\"outer\"},{\"type\":\"way\",\"id\":2,\"role\":\"inner\"}]}",
+      CalculateHashVisitor::toJsonString(r1));
+
+    HOOT_STR_EQUALS("5f8a7553bee6fc619a10170ef63b35732c48da02",
+      QString::fromUtf8(CalculateHashVisitor::toHash(r1).toHex().data()));
+  }
+
+  void runCachedHashTest()
+  {
+    NodePtr n1(new Node(Status::Unknown1, -1, -104.8852148123, 38.8467218123, 5));
+    n1->getTags()["highway"] = "bus_stop";
+
+    const QByteArray hash1 = CalculateHashVisitor::toHash(n1);
+    // the hash is now cached on the element and reused.
+    CPPUNIT_ASSERT(n1->getCachedHash() == hash1);
+    CPPUNIT_ASSERT(CalculateHashVisitor::toHash(n1) == hash1);
+
+    // mutating hashed content invalidates the cache and changes the hash.
+    n1->getTags()["name"] = "Bus Stop 1";
+    CPPUNIT_ASSERT(n1->getCachedHash().isEmpty());
+    const QByteArray hash2 = CalculateHashVisitor::toHash(n1);
+    CPPUNIT_ASSERT(hash2 != hash1);
+
+    // so does moving the node.
+    n1->setX(-104.0);
+    CPPUNIT_ASSERT(n1->getCachedHash().isEmpty());
+    CPPUNIT_ASSERT(CalculateHashVisitor::toHash(n1) != hash2);
+  }
+
+  void runCalculateHashesTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    QList<NodePtr> nodes;
+    for (int i = 0; i < 50; i++)
+    {
+      NodePtr n = TestUtils::createNode(map, Status::Unknown1, i * 0.001, -i * 0.001);
+      n->getTags()["name"] = QString("node %1").arg(i);
+      nodes.append(n);
+    }
+    TestUtils::createWay(map, nodes);
+
+    conf().set(ConfigOptions::getElementHashThreadsKey(), 4);
+    CalculateHashVisitor::calculateHashes(map);
+    conf().set(ConfigOptions::getElementHashThreadsKey(), 1);
+
+    // every element's cache holds the hash of its current serialized form.
+    int checked = 0;
+    const NodeMap& nm = map->getNodes();
+    for (NodeMap::const_iterator it = nm.begin(); it != nm.end(); ++it)
+    {
+      QCryptographicHash sha(QCryptographicHash::Sha1);
+      sha.addData(CalculateHashVisitor::toJsonString(it->second).toAscii().constData());
+      CPPUNIT_ASSERT(it->second->getCachedHash() == sha.result());
+      checked++;
+    }
+    CPPUNIT_ASSERT_EQUAL(50, checked);
+  }
+
+  void runFastHashTest()
+  {
+    NodePtr n1(new Node(Status::Unknown1, -1, -104.8852148123, 38.8467218123, 5));
+    n1->getTags()["highway"] = "bus_stop";
+    NodePtr n2(new Node(Status::Unknown1, -2, -104.8852148123, 38.8467218123, 5));
+    n2->getTags()["highway"] = "bus_stop";
+
+    // identical content hashes identically regardless of element id, and the packed
+    // representations agree.
+    CPPUNIT_ASSERT(CalculateHashVisitor::toFastHash(n1) == CalculateHashVisitor::toFastHash(n2));
+    CPPUNIT_ASSERT(
+      CalculateHashVisitor::toPackedString(n1) == CalculateHashVisitor::toPackedString(n2));
+
+    n2->getTags()["name"] = "Bus Stop 1";
+    CPPUNIT_ASSERT(CalculateHashVisitor::toFastHash(n1) != CalculateHashVisitor::toFastHash(n2));
+  }
+
+  void runFindDuplicatesTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    // two pairs of identical nodes, one unique node.
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    n3->getTags()["name"] = "a";
+    NodePtr n4 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    n4->getTags()["name"] = "a";
+    NodePtr n5 = TestUtils::createNode(map, Status::Unknown1, 20, 0);
+
+    // two ways over the same nodes are duplicates; reversing the node order isn't.
+    QList<NodePtr> nodes;
+    nodes.append(n1);
+    nodes.append(n3);
+    WayPtr w1 = TestUtils::createWay(map, nodes);
+    WayPtr w2 = TestUtils::createWay(map, nodes);
+    QList<NodePtr> reversed;
+    reversed.append(n3);
+    reversed.append(n1);
+    TestUtils::createWay(map, reversed);
+
+    conf().set(ConfigOptions::getElementHashThreadsKey(), 4);
+    const vector< vector<ElementId> > duplicates = CalculateHashVisitor::findDuplicates(map);
+    conf().set(ConfigOptions::getElementHashThreadsKey(), 1);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)3, duplicates.size());
+    for (size_t i = 0; i < duplicates.size(); i++)
+    {
+      CPPUNIT_ASSERT_EQUAL((size_t)2, duplicates[i].size());
+    }
+    // groups come back in element id order with each group's ids ascending; the generated ids
+    // are negative and descending, so the later elements sort first.
+    CPPUNIT_ASSERT(duplicates[0][0] == n4->getElementId());
+    CPPUNIT_ASSERT(duplicates[0][1] == n3->getElementId());
+    CPPUNIT_ASSERT(duplicates[1][0] == n2->getElementId());
+    CPPUNIT_ASSERT(duplicates[1][1] == n1->getElementId());
+    CPPUNIT_ASSERT(duplicates[2][0] == w2->getElementId());
+    CPPUNIT_ASSERT(duplicates[2][1] == w1->getElementId());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CalculateHashVisitorTest, "quick");
@@ -0,0 +1,82 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/visitors/AddGeometryTypeVisitor.h>
+#include <hoot/core/visitors/ElementCountVisitor.h>
+#include <hoot/core/visitors/FusedVisitor.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class FusedVisitorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FusedVisitorTest);
+  CPPUNIT_TEST(runTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runTest()
+  {
+    TestUtils::resetEnvironment();
+
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+    NodePtr n3 = TestUtils::createNode(map, Status::Unknown1, 20, 0);
+    n1->getTags()["name"] = "a";
+    n2->getTags()["name"] = "b";
+    n3->getTags()["name"] = "c";
+
+    boost::shared_ptr<ElementCountVisitor> counter(new ElementCountVisitor());
+    boost::shared_ptr<AddGeometryTypeVisitor> geometryType(new AddGeometryTypeVisitor());
+
+    FusedVisitor uut;
+    uut.addVisitor(counter, "hoot::ElementCountVisitor");
+    uut.addVisitor(geometryType, "hoot::AddGeometryTypeVisitor");
+    map->visitRw(uut);
+
+    // both children saw every element in the single traversal.
+    CPPUNIT_ASSERT_EQUAL(3, counter->getCount());
+    HOOT_STR_EQUALS("Point", map->getNode(n1->getId())->getTags()["geometry_type"]);
+    HOOT_STR_EQUALS("Point", map->getNode(n3->getId())->getTags()["geometry_type"]);
+
+    // one timing entry per child.
+    CPPUNIT_ASSERT(uut.getTimingString().contains("hoot::ElementCountVisitor"));
+    CPPUNIT_ASSERT(uut.getTimingString().contains("hoot::AddGeometryTypeVisitor"));
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FusedVisitorTest, "quick");
+
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/TagDictionary.h>
+#include <hoot/core/visitors/InternTagsVisitor.h>
+using namespace hoot;
+
+// CPP Unit
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class InternTagsVisitorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(InternTagsVisitorTest);
+  CPPUNIT_TEST(runInternTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  virtual void tearDown()
+  {
+    TagDictionary::getInstance().clear();
+  }
+
+  void runInternTest()
+  {
+    OsmMapPtr map(new OsmMap());
+    NodePtr n1 = TestUtils::createNode(map, Status::Unknown1, 0, 0);
+    NodePtr n2 = TestUtils::createNode(map, Status::Unknown1, 10, 0);
+
+    // build the duplicated strings from separate buffers so they don't share storage up front.
+    n1->getTags().set(QString::fromLatin1("amenity"), QString::fromLatin1("restaurant"));
+    n1->getTags().set(QString::fromLatin1("name"), QString::fromLatin1("Pho 88"));
+    n2->getTags().set(QString::fromLatin1("amenity"), QString::fromLatin1("restaurant"));
+    n2->getTags().set(QString::fromLatin1("name"), QString::fromLatin1("Burger Prince"));
+
+    TagDictionary::getInstance().clear();
+    InternTagsVisitor v;
+    map->visitRw(v);
+
+    // the tags read back unchanged.
+    HOOT_STR_EQUALS("restaurant", n1->getTags().get("amenity"));
+    HOOT_STR_EQUALS("Pho 88", n1->getTags().get("name"));
+    HOOT_STR_EQUALS("restaurant", n2->getTags().get("amenity"));
+    HOOT_STR_EQUALS("Burger Prince", n2->getTags().get("name"));
+
+    // the duplicated key and value now share one buffer across both elements.
+    CPPUNIT_ASSERT(n1->getTags().get("amenity").constData() ==
+                   n2->getTags().get("amenity").constData());
+    CPPUNIT_ASSERT(n1->getTags().get("name").constData() !=
+                   n2->getTags().get("name").constData());
+
+    // two keys and three distinct values.
+    CPPUNIT_ASSERT_EQUAL(5, TagDictionary::getInstance().size());
+  }
+};
+
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(hoot::InternTagsVisitorTest, "quick");
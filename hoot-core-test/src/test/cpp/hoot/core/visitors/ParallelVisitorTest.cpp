@@ -0,0 +1,71 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/visitors/ElementCountVisitor.h>
+using namespace hoot;
+
+#include "../TestUtils.h"
+
+namespace hoot
+{
+
+class ParallelVisitorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ParallelVisitorTest);
+  CPPUNIT_TEST(runTest);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void runTest()
+  {
+    TestUtils::resetEnvironment();
+
+    OsmMapPtr map(new OsmMap());
+    OsmMap::resetCounters();
+    // enough elements to get past the small map fallback in visitRoParallel.
+    const int nodeCount = 12000;
+    for (int i = 0; i < nodeCount; i++)
+    {
+      TestUtils::createNode(map, Status::Unknown1, i % 100, i / 100);
+    }
+
+    ElementCountVisitor serial;
+    map->visitRo(serial);
+    CPPUNIT_ASSERT_EQUAL(nodeCount, serial.getCount());
+
+    ElementCountVisitor parallel;
+    map->visitRoParallel(parallel);
+    CPPUNIT_ASSERT_EQUAL(serial.getCount(), parallel.getCount());
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ParallelVisitorTest, "quick");
+
+}
@@ -42,19 +42,26 @@ using namespace boost;
 #include <hoot/core/elements/Node.h>
 #include <hoot/core/filters/NodeFilter.h>
 #include <hoot/core/filters/WayFilter.h>
+#include <hoot/core/index/ElementToRelationMap.h>
 #include <hoot/core/index/OsmMapIndex.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/util/HootException.h>
+#include <hoot/core/util/NumaTopology.h>
 #include <hoot/core/util/SignalCatcher.h>
 #include <hoot/core/util/Validate.h>
 #include <hoot/core/ops/RemoveElementOp.h>
 #include <hoot/core/ops/RemoveNodeOp.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/elements/ElementId.h>
+#include <hoot/core/visitors/ParallelVisitor.h>
 using namespace hoot::elements;
 
 // Qt
 #include <QDebug>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
 
 using namespace std;
 
@@ -73,6 +80,7 @@ OsmMap::OsmMap()
   setIdGenerator(IdGenerator::getInstance());
   _index.reset(new OsmMapIndex(*this));
   _srs = _wgs84;
+  _hasCowSnapshot = false;
 }
 
 OsmMap::OsmMap(ConstOsmMapPtr map)
@@ -90,6 +98,7 @@ OsmMap::OsmMap(boost::shared_ptr<OGRSpatialReference> srs)
   setIdGenerator(IdGenerator::getInstance());
   _index.reset(new OsmMapIndex(*this));
   _srs = srs;
+  _hasCowSnapshot = false;
 }
 
 OsmMap::OsmMap(ConstOsmMapPtr map, boost::shared_ptr<OGRSpatialReference> srs)
@@ -122,7 +131,9 @@ void OsmMap::append(ConstOsmMapPtr appendFromMap)
   }
   _srs = appendFromMap->getProjection();
 
-  const RelationMap& allRelations = appendFromMap->getRelations();
+  //read the members directly; this is read only, so it shouldn't trigger the source map's
+  //copy-on-write detach
+  const RelationMap& allRelations = appendFromMap->_relations;
   for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
   {
     RelationPtr relation = it->second;
@@ -191,6 +202,7 @@ void OsmMap::addNode(const NodePtr& n)
   _nodes[n->getId()] = n;
   n->registerListener(_index.get());
   _index->addNode(n);
+  _notifyElementAdded(n);
   //_nodeCounter = std::min(n->getId() - 1, _nodeCounter);
 }
 
@@ -216,6 +228,7 @@ void OsmMap::addNodes(const std::vector<NodePtr>& nodes)
       _nodes[id] = nodes[i];
       nodes[i]->registerListener(_index.get());
       _index->addNode(nodes[i]);
+      _notifyElementAdded(nodes[i]);
       maxId = std::max(id, maxId);
       minId = std::min(id, minId);
     }
@@ -225,6 +238,34 @@ void OsmMap::addNodes(const std::vector<NodePtr>& nodes)
   }
 }
 
+void OsmMap::addRelations(const std::vector<RelationPtr>& relations)
+{
+  if (relations.size() > 0)
+  {
+    VALIDATE(validate());
+
+    long minId = relations[0]->getId();
+    long maxId = minId;
+
+    for (size_t i = 0; i < relations.size(); ++i)
+    {
+      long id = relations[i]->getId();
+      _relations[id] = relations[i];
+      relations[i]->registerListener(_index.get());
+      _index->addRelation(relations[i]);
+      _notifyElementAdded(relations[i]);
+      maxId = std::max(id, maxId);
+      minId = std::min(id, minId);
+    }
+
+    // unlike addRelation, the id generator bounds are only updated once for the whole batch.
+    _idGen->ensureRelationBounds(maxId);
+    _idGen->ensureRelationBounds(minId);
+
+    VALIDATE(validate());
+  }
+}
+
 void OsmMap::addRelation(const RelationPtr& r)
 {
   VALIDATE(validate());
@@ -232,15 +273,41 @@ void OsmMap::addRelation(const RelationPtr& r)
   _relations[r->getId()] = r;
   r->registerListener(_index.get());
   _index->addRelation(r);
+  _notifyElementAdded(r);
   VALIDATE(validate());
 }
 
+void OsmMap::addWays(const std::vector<WayPtr>& ways)
+{
+  if (ways.size() > 0)
+  {
+    long minId = ways[0]->getId();
+    long maxId = minId;
+
+    for (size_t i = 0; i < ways.size(); ++i)
+    {
+      long id = ways[i]->getId();
+      _ways[id] = ways[i];
+      ways[i]->registerListener(_index.get());
+      _index->addWay(ways[i]);
+      _notifyElementAdded(ways[i]);
+      maxId = std::max(id, maxId);
+      minId = std::min(id, minId);
+    }
+
+    // unlike addWay, the id generator bounds are only updated once for the whole batch.
+    _idGen->ensureWayBounds(maxId);
+    _idGen->ensureWayBounds(minId);
+  }
+}
+
 void OsmMap::addWay(const WayPtr& w)
 {
   _idGen->ensureWayBounds(w->getId());
   _ways[w->getId()] = w;
   w->registerListener(_index.get());
   _index->addWay(w);
+  _notifyElementAdded(w);
   //_wayCounter = std::min(w->getId() - 1, _wayCounter);
 
   // this is a bit too strict, especially when dealing with MapReduce
@@ -262,6 +329,199 @@ void OsmMap::clear()
 
   _index->reset();
   _listeners.clear();
+
+  _hasCowSnapshot = false;
+  _cowSharedNodes.clear();
+  _cowSharedWays.clear();
+  _cowSharedRelations.clear();
+  _pendingRemovals.clear();
+}
+
+void OsmMap::scheduleRemoval(const ElementId& eid)
+{
+  _pendingRemovals.insert(eid);
+}
+
+void OsmMap::commitRemovals()
+{
+  if (_pendingRemovals.empty())
+  {
+    return;
+  }
+
+  // split the scheduled ids by type for the membership scans below.
+  HashSet<long> removedNodes;
+  HashSet<long> removedWays;
+  HashSet<long> removedRelations;
+  for (set<ElementId>::const_iterator it = _pendingRemovals.begin();
+    it != _pendingRemovals.end(); ++it)
+  {
+    switch (it->getType().getEnum())
+    {
+    case ElementType::Node:
+      removedNodes.insert(it->getId());
+      break;
+    case ElementType::Way:
+      removedWays.insert(it->getId());
+      break;
+    default:
+      removedRelations.insert(it->getId());
+      break;
+    }
+  }
+
+  // drop memberships referencing removed elements from the surviving relations in one pass.
+  for (RelationMap::const_iterator it = _relations.begin(); it != _relations.end(); ++it)
+  {
+    if (removedRelations.find(it->first) != removedRelations.end())
+    {
+      continue;
+    }
+    RelationPtr r = it->second;
+    // copy the member list since removeElement modifies it.
+    const vector<RelationData::Entry> members = r->getMembers();
+    for (size_t i = 0; i < members.size(); i++)
+    {
+      const ElementId eid = members[i].getElementId();
+      if (_pendingRemovals.find(eid) != _pendingRemovals.end())
+      {
+        if (_hasCowSnapshot)
+        {
+          // don't modify a relation still shared with a snapshot.
+          r = _detachSharedRelation(it->first);
+        }
+        r->removeElement(eid);
+      }
+    }
+  }
+
+  // drop references to removed nodes from the surviving ways in one pass.
+  if (removedNodes.empty() == false)
+  {
+    for (WayMap::const_iterator it = _ways.begin(); it != _ways.end(); ++it)
+    {
+      if (removedWays.find(it->first) != removedWays.end())
+      {
+        continue;
+      }
+      WayPtr w = it->second;
+      const vector<long>& nids = w->getNodeIds();
+      bool hit = false;
+      for (size_t i = 0; i < nids.size() && !hit; i++)
+      {
+        hit = removedNodes.find(nids[i]) != removedNodes.end();
+      }
+      if (hit)
+      {
+        if (_hasCowSnapshot)
+        {
+          // don't modify a way still shared with a snapshot. The original stays alive in the
+          // snapshot, so nids remains valid below.
+          w = _detachSharedWay(it->first);
+        }
+        vector<long> kept;
+        kept.reserve(nids.size());
+        for (size_t i = 0; i < nids.size(); i++)
+        {
+          if (removedNodes.find(nids[i]) == removedNodes.end())
+          {
+            kept.push_back(nids[i]);
+          }
+        }
+        w->setNodesViaSwap(kept);
+      }
+    }
+  }
+
+  // when a large fraction of the map goes away it is cheaper to drop the indexes and let them
+  // lazily rebuild than to remove the entries one at a time.
+  const size_t elementCount = _nodes.size() + _ways.size() + _relations.size();
+  const bool resetIndex = _pendingRemovals.size() > elementCount / 4;
+
+  for (set<ElementId>::const_iterator it = _pendingRemovals.begin();
+    it != _pendingRemovals.end(); ++it)
+  {
+    const long id = it->getId();
+    switch (it->getType().getEnum())
+    {
+    case ElementType::Node:
+      {
+        NodeMap::iterator nit = _nodes.find(id);
+        if (nit != _nodes.end())
+        {
+          if (!resetIndex)
+          {
+            _index->removeNode(nit->second);
+          }
+          _notifyElementRemoved(nit->second);
+          _nodes.erase(nit);
+        }
+        _cowSharedNodes.erase(id);
+      }
+      break;
+    case ElementType::Way:
+      {
+        WayMap::iterator wit = _ways.find(id);
+        if (wit != _ways.end())
+        {
+          if (!resetIndex)
+          {
+            _index->removeWay(wit->second);
+          }
+          _notifyElementRemoved(wit->second);
+          _ways.erase(wit);
+        }
+        _cowSharedWays.erase(id);
+      }
+      break;
+    default:
+      {
+        RelationMap::iterator rit = _relations.find(id);
+        if (rit != _relations.end())
+        {
+          if (!resetIndex)
+          {
+            _index->removeRelation(rit->second);
+          }
+          _notifyElementRemoved(rit->second);
+          _relations.erase(rit);
+        }
+        _cowSharedRelations.erase(id);
+      }
+      break;
+    }
+  }
+
+  if (resetIndex)
+  {
+    _index->reset();
+  }
+
+  if (_hasCowSnapshot && _cowSharedNodes.empty() && _cowSharedWays.empty() &&
+      _cowSharedRelations.empty())
+  {
+    _hasCowSnapshot = false;
+  }
+
+  _pendingRemovals.clear();
+
+  VALIDATE(validate());
+}
+
+void OsmMap::_notifyElementAdded(const ConstElementPtr& e) const
+{
+  for (size_t i = 0; i < _listeners.size(); i++)
+  {
+    _listeners[i]->elementAdded(e);
+  }
+}
+
+void OsmMap::_notifyElementRemoved(const ConstElementPtr& e) const
+{
+  for (size_t i = 0; i < _listeners.size(); i++)
+  {
+    _listeners[i]->elementRemoved(e);
+  }
 }
 
 bool OsmMap::containsElement(const ElementId& eid) const
@@ -291,13 +551,14 @@ bool OsmMap::containsElement(const boost::shared_ptr<const Element>& e) const
 
 void OsmMap::_copy(ConstOsmMapPtr from)
 {
+  _hasCowSnapshot = false;
   _idGen = from->_idGen;
   _idGenSp = from->_idGenSp;
   _index.reset(new OsmMapIndex(*this));
   _srs = from->getProjection();
 
   int i = 0;
-  const RelationMap& allRelations = from->getRelations();
+  const RelationMap& allRelations = from->_relations;
   for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
   {
     RelationPtr r = RelationPtr(new Relation(*(it->second)));
@@ -332,6 +593,159 @@ void OsmMap::_copy(ConstOsmMapPtr from)
   }
 }
 
+ConstOsmMapPtr OsmMap::takeCowSnapshot()
+{
+  OsmMapPtr snap(new OsmMap());
+  snap->_idGen = _idGen;
+  snap->_idGenSp = _idGenSp;
+  snap->_srs = _srs;
+  // Share the element objects rather than deep copying them. The shared elements are protected
+  // from changes on this map by the detach-on-first-write logic below, and the snapshot itself is
+  // handed out const.
+  snap->_nodes = _nodes;
+  snap->_ways = _ways;
+  snap->_relations = _relations;
+  for (size_t i = 0; i < _listeners.size(); i++)
+  {
+    snap->_listeners.push_back(_listeners[i]->clone());
+  }
+
+  // Record every element as shared so the first writable access through this map clones it.
+  _cowSharedNodes.clear();
+  for (NodeMap::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it)
+  {
+    _cowSharedNodes.insert(it->first);
+  }
+  _cowSharedWays.clear();
+  for (WayMap::const_iterator it = _ways.begin(); it != _ways.end(); ++it)
+  {
+    _cowSharedWays.insert(it->first);
+  }
+  _cowSharedRelations.clear();
+  for (RelationMap::const_iterator it = _relations.begin(); it != _relations.end(); ++it)
+  {
+    _cowSharedRelations.insert(it->first);
+  }
+  _hasCowSnapshot = true;
+
+  return snap;
+}
+
+NodePtr OsmMap::_detachSharedNode(long id)
+{
+  NodeMap::const_iterator it = _nodes.find(id);
+  HashSet<long>::iterator sharedIt = _cowSharedNodes.find(id);
+  if (it == _nodes.end())
+  {
+    // the element was removed from this map after the snapshot was taken; there is nothing left
+    // to detach, so just drop the stale bookkeeping entry.
+    if (sharedIt != _cowSharedNodes.end())
+    {
+      _cowSharedNodes.erase(sharedIt);
+      if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+      {
+        _hasCowSnapshot = false;
+      }
+    }
+    return NodePtr();
+  }
+  if (sharedIt == _cowSharedNodes.end())
+  {
+    return it->second;
+  }
+  NodePtr n(new Node(*it->second));
+  _nodes[id] = n;
+  _cowSharedNodes.erase(sharedIt);
+  if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+  {
+    _hasCowSnapshot = false;
+  }
+  return n;
+}
+
+WayPtr OsmMap::_detachSharedWay(long id)
+{
+  WayMap::const_iterator it = _ways.find(id);
+  HashSet<long>::iterator sharedIt = _cowSharedWays.find(id);
+  if (it == _ways.end())
+  {
+    if (sharedIt != _cowSharedWays.end())
+    {
+      _cowSharedWays.erase(sharedIt);
+      if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+      {
+        _hasCowSnapshot = false;
+      }
+    }
+    return WayPtr();
+  }
+  if (sharedIt == _cowSharedWays.end())
+  {
+    return it->second;
+  }
+  WayPtr w(new Way(*it->second));
+  w->registerListener(_index.get());
+  _ways[id] = w;
+  _cowSharedWays.erase(sharedIt);
+  if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+  {
+    _hasCowSnapshot = false;
+  }
+  return w;
+}
+
+RelationPtr OsmMap::_detachSharedRelation(long id)
+{
+  RelationMap::const_iterator it = _relations.find(id);
+  HashSet<long>::iterator sharedIt = _cowSharedRelations.find(id);
+  if (it == _relations.end())
+  {
+    if (sharedIt != _cowSharedRelations.end())
+    {
+      _cowSharedRelations.erase(sharedIt);
+      if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+      {
+        _hasCowSnapshot = false;
+      }
+    }
+    return RelationPtr();
+  }
+  if (sharedIt == _cowSharedRelations.end())
+  {
+    return it->second;
+  }
+  RelationPtr r(new Relation(*it->second));
+  r->registerListener(_index.get());
+  _relations[id] = r;
+  _cowSharedRelations.erase(sharedIt);
+  if (_cowSharedNodes.empty() && _cowSharedWays.empty() && _cowSharedRelations.empty())
+  {
+    _hasCowSnapshot = false;
+  }
+  return r;
+}
+
+void OsmMap::_detachAllShared()
+{
+  // copy the id sets b/c the detach methods modify them as we go.
+  const vector<long> nodeIds(_cowSharedNodes.begin(), _cowSharedNodes.end());
+  for (size_t i = 0; i < nodeIds.size(); i++)
+  {
+    _detachSharedNode(nodeIds[i]);
+  }
+  const vector<long> wayIds(_cowSharedWays.begin(), _cowSharedWays.end());
+  for (size_t i = 0; i < wayIds.size(); i++)
+  {
+    _detachSharedWay(wayIds[i]);
+  }
+  const vector<long> relationIds(_cowSharedRelations.begin(), _cowSharedRelations.end());
+  for (size_t i = 0; i < relationIds.size(); i++)
+  {
+    _detachSharedRelation(relationIds[i]);
+  }
+  _hasCowSnapshot = false;
+}
+
 ConstElementPtr OsmMap::getElement(const ElementId& eid) const
 {
   return getElement(eid.getType(), eid.getId());
@@ -374,7 +788,7 @@ ElementPtr OsmMap::getElement(ElementType type, long id)
 
 size_t OsmMap::getElementCount() const
 {
-  return getNodes().size() + getWays().size() + getRelations().size();
+  return _nodes.size() + _ways.size() + _relations.size();
 }
 
 set<ElementId> OsmMap::getParents(ElementId eid) const
@@ -382,6 +796,11 @@ set<ElementId> OsmMap::getParents(ElementId eid) const
   return getIndex().getParents(eid);
 }
 
+const set<long>& OsmMap::getRelationsByElement(ElementId eid) const
+{
+  return getIndex().getElementToRelationMap()->getRelationByElement(eid);
+}
+
 bool OsmMap::_listContainsNode(const QList<ElementPtr> l) const
 {
   for (int i = 0; i < l.size(); ++i)
@@ -531,7 +950,7 @@ bool OsmMap::validate(bool strict) const
   bool result = true;
   result &= getIndex().getNodeToWayMap()->validate(*this);
 
-  const WayMap& allWays = (*this).getWays();
+  const WayMap& allWays = _ways;
   for (WayMap::const_iterator it = allWays.begin(); it != allWays.end(); ++it)
   {
     const ConstWayPtr& way = it->second;
@@ -556,7 +975,7 @@ bool OsmMap::validate(bool strict) const
     }
   }
 
-  const RelationMap& allRelations = getRelations();
+  const RelationMap& allRelations = _relations;
   for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
   {
     const ConstRelationPtr& relation = it->second;
@@ -606,6 +1025,109 @@ void OsmMap::visitRo(ConstElementVisitor& visitor) const
   visitRelationsRo(visitor);
 }
 
+namespace
+{
+  void runVisitorOnShard(ConstElementVisitor* visitor,
+    const std::vector<ConstElementPtr>* elements, int numaNode)
+  {
+    if (numaNode >= 0)
+    {
+      NumaTopology::getInstance().pinCurrentThreadToNode(numaNode);
+    }
+    for (size_t i = 0; i < elements->size(); i++)
+    {
+      visitor->visit((*elements)[i]);
+    }
+    if (numaNode >= 0)
+    {
+      // the Qt pool reuses its threads, so restore the default affinity before handing the
+      // thread back.
+      NumaTopology::getInstance().unpinCurrentThread();
+    }
+  }
+}
+
+void OsmMap::visitRoParallel(ConstElementVisitor& visitor) const
+{
+  ParallelVisitor* pv = dynamic_cast<ParallelVisitor*>(&visitor);
+  const int threadCount = QThread::idealThreadCount();
+  const size_t elementCount = _nodes.size() + _ways.size() + _relations.size();
+  // for small maps the thread startup costs more than the traversal.
+  if (pv == 0 || threadCount <= 1 || elementCount < 10000)
+  {
+    visitRo(visitor);
+    return;
+  }
+
+  ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(&visitor);
+  if (consumer != 0)
+  {
+    consumer->setOsmMap(this);
+  }
+
+  // deal the elements round robin into one shard per thread.
+  vector< vector<ConstElementPtr> > shards(threadCount);
+  for (int i = 0; i < threadCount; i++)
+  {
+    shards[i].reserve(elementCount / threadCount + 1);
+  }
+  size_t e = 0;
+  const NodeMap& allNodes = _nodes;
+  for (NodeMap::const_iterator it = allNodes.begin(); it != allNodes.end(); ++it)
+  {
+    shards[e++ % threadCount].push_back(it->second);
+  }
+  const WayMap& allWays = _ways;
+  for (WayMap::const_iterator it = allWays.begin(); it != allWays.end(); ++it)
+  {
+    shards[e++ % threadCount].push_back(it->second);
+  }
+  const RelationMap& allRelations = _relations;
+  for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
+  {
+    shards[e++ % threadCount].push_back(it->second);
+  }
+
+  // each worker accumulates into its own clone of the visitor.
+  vector<ConstElementVisitorPtr> workers;
+  for (int i = 0; i < threadCount; i++)
+  {
+    ConstElementVisitorPtr worker = pv->cloneForThread();
+    ConstOsmMapConsumer* workerConsumer = dynamic_cast<ConstOsmMapConsumer*>(worker.get());
+    if (workerConsumer != 0)
+    {
+      workerConsumer->setOsmMap(this);
+    }
+    workers.push_back(worker);
+  }
+
+  // on multi socket hosts each shard can be bound to one NUMA node so its traversal and the
+  // worker's accumulation state stay local to one socket.
+  int numaNodeCount = 0;
+  if (ConfigOptions().getParallelNumaPinning() &&
+      NumaTopology::getInstance().getNodeCount() > 1)
+  {
+    numaNodeCount = NumaTopology::getInstance().getNodeCount();
+  }
+
+  QList< QFuture<void> > futures;
+  for (int i = 0; i < threadCount; i++)
+  {
+    const int numaNode = numaNodeCount > 0 ? i % numaNodeCount : -1;
+    futures.append(QtConcurrent::run(&runVisitorOnShard, workers[i].get(), &shards[i], numaNode));
+  }
+  for (int i = 0; i < futures.size(); i++)
+  {
+    futures[i].waitForFinished();
+  }
+
+  // merge in shard order so any order sensitive results are deterministic.
+  for (int i = 0; i < threadCount; i++)
+  {
+    pv->merge(*workers[i]);
+  }
+}
+
 void OsmMap::visitNodesRo(ConstElementVisitor& visitor) const
 {
   ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(&visitor);
@@ -615,7 +1137,7 @@ void OsmMap::visitNodesRo(ConstElementVisitor& visitor) const
   }
 
   // make a copy so we can iterate through even if there are changes.
-  const NodeMap& allNodes = getNodes();
+  const NodeMap& allNodes = _nodes;
   for (NodeMap::const_iterator it = allNodes.begin(); it != allNodes.end(); ++it)
   {
     if (containsNode(it->first))
@@ -634,7 +1156,7 @@ void OsmMap::visitWaysRo(ConstElementVisitor& visitor) const
   }
 
   // make a copy so we can iterate through even if there are changes.
-  const WayMap& allWays = getWays();
+  const WayMap& allWays = _ways;
   for (WayMap::const_iterator it = allWays.begin(); it != allWays.end(); ++it)
   {
     if (containsWay(it->first))
@@ -653,7 +1175,7 @@ void OsmMap::visitRelationsRo(ConstElementVisitor& visitor) const
   }
 
   // make a copy so we can iterate through even if there are changes.
-  const RelationMap& allRelations = getRelations();
+  const RelationMap& allRelations = _relations;
   for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
   {
     if (containsRelation(it->first))
@@ -665,6 +1187,11 @@ void OsmMap::visitRelationsRo(ConstElementVisitor& visitor) const
 
 void OsmMap::visitRw(ConstElementVisitor& visitor)
 {
+  if (_hasCowSnapshot)
+  {
+    _detachAllShared();
+  }
+
   OsmMapConsumer* consumer = dynamic_cast<OsmMapConsumer*>(&visitor);
   if (consumer != 0)
   {
@@ -704,6 +1231,11 @@ void OsmMap::visitRw(ConstElementVisitor& visitor)
 
 void OsmMap::visitRw(ElementVisitor& visitor)
 {
+  if (_hasCowSnapshot)
+  {
+    _detachAllShared();
+  }
+
   OsmMapConsumer* consumer = dynamic_cast<OsmMapConsumer*>(&visitor);
   if (consumer != 0)
   {
@@ -743,6 +1275,11 @@ void OsmMap::visitRw(ElementVisitor& visitor)
 
 void OsmMap::visitWaysRw(ConstElementVisitor& visitor)
 {
+  if (_hasCowSnapshot)
+  {
+    _detachAllShared();
+  }
+
   OsmMapConsumer* consumer = dynamic_cast<OsmMapConsumer*>(&visitor);
   if (consumer != 0)
   {
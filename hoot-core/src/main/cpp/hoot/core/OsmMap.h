@@ -37,6 +37,7 @@
 #include <geos/geom/Envelope.h>
 
 // Hoot
+#include <hoot/core/ConstOsmMapConsumer.h>
 #include <hoot/core/elements/ElementProvider.h>
 #include <hoot/core/elements/ElementVisitor.h>
 #include <hoot/core/elements/Node.h>
@@ -56,6 +57,7 @@ namespace hoot
 }
 
 // Standard
+#include <set>
 #include <vector>
 
 namespace hoot
@@ -123,8 +125,20 @@ public:
 
   void addRelation(const RelationPtr& r);
 
+  /**
+   * Add all the relations in the provided vector. This can be faster than calling addRelation
+   * multiple times.
+   */
+  void addRelations(const std::vector<RelationPtr>& relations);
+
   void addWay(const WayPtr& w);
 
+  /**
+   * Add all the ways in the provided vector. This can be faster than calling addWay multiple
+   * times.
+   */
+  void addWays(const std::vector<WayPtr>& ways);
+
   void clear();
 
   /**
@@ -175,10 +189,27 @@ public:
 
   const NodePtr getNode(const ElementId& eid) { return getNode(eid.getId()); }
 
-  const NodeMap& getNodes() const { return _nodes; }
+  /**
+   * The values in the returned map are writable pointers, so if a copy-on-write snapshot exists
+   * every element still shared with it is detached before the container is handed out; callers
+   * routinely mutate elements obtained by iterating these containers and the snapshot must not
+   * see those changes.
+   */
+  const NodeMap& getNodes() const;
+
+  virtual void getNodeCoordinates(const std::vector<long>& ids,
+    std::vector<geos::geom::Coordinate>& coords) const;
 
   std::set<ElementId> getParents(ElementId eid) const;
 
+  /**
+   * Returns the ids of all relations that reference the given element, directly or through an
+   * ancestor relation. This is backed by the reverse membership index maintained by OsmMapIndex,
+   * so after the first call the lookup is O(membership degree) rather than a scan over all the
+   * relations in the map.
+   */
+  const std::set<long>& getRelationsByElement(ElementId eid) const;
+
   /**
    * Returns the SRS for this map. The SRS should never be changed and defaults to WGS84.
    */
@@ -188,7 +219,10 @@ public:
 
   virtual const RelationPtr getRelation(long id);
 
-  const RelationMap& getRelations() const { return _relations; }
+  /**
+   * See the copy-on-write note on getNodes().
+   */
+  const RelationMap& getRelations() const;
 
   /**
    * Return the way with the specified id or null if it doesn't exist.
@@ -206,12 +240,52 @@ public:
   const ConstWayPtr getWay(long id) const;
   const ConstWayPtr getWay(ElementId eid) const;
 
-  const WayMap& getWays() const { return _ways; }
+  /**
+   * See the copy-on-write note on getNodes().
+   */
+  const WayMap& getWays() const;
 
   bool isEmpty() const { return _nodes.size() == 0 && _ways.size() == 0 && _relations.size() == 0;}
 
   void registerListener(boost::shared_ptr<OsmMapListener> l) { _listeners.push_back(l); }
 
+  /**
+   * Marks an element for removal by the next commitRemovals() call. Unlike the RemoveElementOp
+   * family, nothing happens until the commit, so removal heavy cleanup ops can schedule all
+   * their removals and pay the reference fix up and index maintenance cost once rather than per
+   * element. The element stays in the map (and visible to criteria) until the commit.
+   */
+  void scheduleRemoval(const ElementId& eid);
+
+  /**
+   * Removes all the scheduled elements in one pass: surviving relations drop their memberships
+   * to removed elements, surviving ways drop their references to removed nodes, and the removed
+   * elements leave the containers and the index. Equivalent to calling the "fully" variant of
+   * the per type removal ops on each scheduled id, in unspecified order.
+   */
+  void commitRemovals();
+
+  /**
+   * Takes a copy-on-write snapshot of this map.
+   *
+   * The snapshot shares the current node/way/relation objects with this map rather than deep
+   * copying them, so taking one is cheap regardless of map size. After the snapshot is taken,
+   * the first writable access to each shared element through this map (getNode/getWay/
+   * getRelation/getElement or a visitRw variant) clones that element, so the snapshot keeps
+   * seeing the pre-snapshot state while this map only pays the copy cost for the elements it
+   * actually touches.
+   *
+   * Because the getNodes()/getWays()/getRelations() containers hand out writable pointers, the
+   * first such access detaches every element still shared with the snapshot, so a map that is
+   * iterated after a snapshot pays for one full deep copy at that point. The savings over an
+   * up front deep copy only materialize for maps that are touched through the per element
+   * accessors.
+   *
+   * Writable element pointers obtained from this map _before_ the snapshot was taken bypass the
+   * copy-on-write mechanism; mutate through the map's accessors after taking a snapshot.
+   */
+  boost::shared_ptr<const OsmMap> takeCowSnapshot();
+
   /**
    * Replace the all instances of from with instances of to. In some cases this may be an invalid
    * operation and an exception will be throw. E.g. replacing a node with a way where the node
@@ -269,6 +343,29 @@ public:
   void visitWaysRo(ConstElementVisitor& visitor) const;
   void visitRelationsRo(ConstElementVisitor& visitor) const;
 
+  /**
+   * Templated variants of the single type traversals above that visit through the concrete
+   * visitor type instead of the ConstElementVisitor interface. The visit calls are resolved at
+   * compile time, so a visitor declaring a non virtual typed overload (e.g.
+   * visit(const ConstNodePtr&)) is called directly in the traversal loop with no virtual dispatch
+   * and no element type branching. Visitors exposing only the virtual ConstElementPtr visit
+   * method produce the same results as the non template traversals. The visitor type must be
+   * polymorphic (any ConstElementVisitor is) and the map must not be modified while traversing.
+   */
+  template<class T> void visitNodesRo(T& visitor) const;
+  template<class T> void visitWaysRo(T& visitor) const;
+  template<class T> void visitRelationsRo(T& visitor) const;
+
+  /**
+   * Behaves like visitRo, but if the visitor implements ParallelVisitor the elements are
+   * visited over several worker threads, each accumulating into its own visitor clone, and the
+   * clones are merged back into the passed visitor in shard order. Falls back to visitRo for
+   * other visitors and for small maps where starting threads costs more than it saves.
+   *
+   * Note the elements are not visited in the nodes/ways/relations order visitRo guarantees.
+   */
+  void visitRoParallel(ConstElementVisitor& visitor) const;
+
   /**
    * Calls the visitRw method on all elements. See Element::visitRw for a more
    * thorough description.
@@ -313,10 +410,34 @@ protected:
   mutable WayMap::const_iterator _tmpWayIt;
   std::vector< boost::shared_ptr<OsmMapListener> > _listeners;
 
+  /// elements marked by scheduleRemoval and not yet committed
+  std::set<ElementId> _pendingRemovals;
+
   std::vector< boost::shared_ptr<Element> > _replaceTmpArray;
 
+  // True if a copy-on-write snapshot has been taken and one or more elements may still be shared
+  // with it. See takeCowSnapshot().
+  bool _hasCowSnapshot;
+  HashSet<long> _cowSharedNodes;
+  HashSet<long> _cowSharedWays;
+  HashSet<long> _cowSharedRelations;
+
   void _copy(boost::shared_ptr<const OsmMap> from);
 
+  /**
+   * If the element with the given id is still shared with a snapshot, replaces it with a private
+   * clone. Returns the (possibly cloned) element.
+   */
+  NodePtr _detachSharedNode(long id);
+  WayPtr _detachSharedWay(long id);
+  RelationPtr _detachSharedRelation(long id);
+
+  /**
+   * Detaches every element still shared with a snapshot. Used before whole-map writable
+   * traversals.
+   */
+  void _detachAllShared();
+
   /**
    * Returns true if there is a node in l.
    */
@@ -324,6 +445,10 @@ protected:
 
   void _replaceNodeInRelations(long oldId, long newId);
 
+  void _notifyElementAdded(const ConstElementPtr& e) const;
+
+  void _notifyElementRemoved(const ConstElementPtr& e) const;
+
 };
 
 typedef boost::shared_ptr<OsmMap> OsmMapPtr;
@@ -339,11 +464,93 @@ void addElements(T it, T end)
   }
 }
 
+template<class T>
+void OsmMap::visitNodesRo(T& visitor) const
+{
+  ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(&visitor);
+  if (consumer != 0)
+  {
+    consumer->setOsmMap(this);
+  }
+
+  for (NodeMap::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it)
+  {
+    //pass the typed pointer so a typed visit overload is an exact match and wins overload
+    //resolution over the ConstElementPtr one.
+    const ConstNodePtr node = it->second;
+    visitor.visit(node);
+  }
+}
+
+template<class T>
+void OsmMap::visitWaysRo(T& visitor) const
+{
+  ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(&visitor);
+  if (consumer != 0)
+  {
+    consumer->setOsmMap(this);
+  }
+
+  for (WayMap::const_iterator it = _ways.begin(); it != _ways.end(); ++it)
+  {
+    const ConstWayPtr way = it->second;
+    visitor.visit(way);
+  }
+}
+
+template<class T>
+void OsmMap::visitRelationsRo(T& visitor) const
+{
+  ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(&visitor);
+  if (consumer != 0)
+  {
+    consumer->setOsmMap(this);
+  }
+
+  for (RelationMap::const_iterator it = _relations.begin(); it != _relations.end(); ++it)
+  {
+    const ConstRelationPtr relation = it->second;
+    visitor.visit(relation);
+  }
+}
+
+inline const NodeMap& OsmMap::getNodes() const
+{
+  if (_hasCowSnapshot)
+  {
+    //the returned values are writable pointers; see the comment on the declaration.
+    const_cast<OsmMap*>(this)->_detachAllShared();
+  }
+  return _nodes;
+}
+
+inline const WayMap& OsmMap::getWays() const
+{
+  if (_hasCowSnapshot)
+  {
+    const_cast<OsmMap*>(this)->_detachAllShared();
+  }
+  return _ways;
+}
+
+inline const RelationMap& OsmMap::getRelations() const
+{
+  if (_hasCowSnapshot)
+  {
+    const_cast<OsmMap*>(this)->_detachAllShared();
+  }
+  return _relations;
+}
+
 inline const NodePtr OsmMap::getNode(long id)
 {
   _tmpNodeMapIt = _nodes.find(id);
   if (_tmpNodeMapIt != _nodes.end())
   {
+    if (_hasCowSnapshot)
+    {
+      return _detachSharedNode(id);
+    }
     return _tmpNodeMapIt->second;
   }
   else
@@ -354,10 +561,12 @@ inline const NodePtr OsmMap::getNode(long id)
 
 inline const ConstNodePtr OsmMap::getNode(long id) const
 {
-  _tmpNodeMapIt = _nodes.find(id);
-  if (_tmpNodeMapIt != _nodes.end())
+  // use a local iterator rather than the shared scratch iterator so concurrent const reads are
+  // safe (see OsmMapIndex::prepareForConcurrentReads)
+  NodeMap::const_iterator it = _nodes.find(id);
+  if (it != _nodes.end())
   {
-    return _tmpNodeMapIt->second;
+    return it->second;
   }
   else
   {
@@ -365,6 +574,25 @@ inline const ConstNodePtr OsmMap::getNode(long id) const
   }
 }
 
+inline void OsmMap::getNodeCoordinates(const std::vector<long>& ids,
+  std::vector<geos::geom::Coordinate>& coords) const
+{
+  coords.resize(ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    NodeMap::const_iterator it = _nodes.find(ids[i]);
+    if (it == _nodes.end())
+    {
+      throw HootException(QString("Unknown node id: %1").arg(ids[i]));
+    }
+    // read straight off the node rather than copying out the shared pointer; this runs once per
+    // way node in the matchers and writers.
+    const Node* n = it->second.get();
+    coords[i].x = n->getX();
+    coords[i].y = n->getY();
+  }
+}
+
 inline const ConstRelationPtr OsmMap::getRelation(long id) const
 {
   RelationMap::iterator it = _relations.find(id);
@@ -383,6 +611,10 @@ inline const RelationPtr OsmMap::getRelation(long id)
   _tmpRelationIt = _relations.find(id);
   if (_tmpRelationIt != _relations.end())
   {
+    if (_hasCowSnapshot)
+    {
+      return _detachSharedRelation(id);
+    }
     return _tmpRelationIt->second;
   }
   else
@@ -393,10 +625,11 @@ inline const RelationPtr OsmMap::getRelation(long id)
 
 inline const ConstWayPtr OsmMap::getWay(long id) const
 {
-  _tmpWayIt = _ways.find(id);
-  if (_tmpWayIt != _ways.end())
+  // see the note on the const getNode about concurrent reads
+  WayMap::const_iterator it = _ways.find(id);
+  if (it != _ways.end())
   {
-    return _tmpWayIt->second;
+    return it->second;
   }
   else
   {
@@ -415,6 +648,10 @@ inline const WayPtr OsmMap::getWay(long id)
   _tmpWayIt = _ways.find(id);
   if (_tmpWayIt != _ways.end())
   {
+    if (_hasCowSnapshot)
+    {
+      return _detachSharedWay(id);
+    }
     return _tmpWayIt->second;
   }
   else
@@ -28,6 +28,9 @@
 #ifndef OSMMAPLISTENER_H
 #define OSMMAPLISTENER_H
 
+// hoot
+#include <hoot/core/elements/Element.h>
+
 namespace hoot
 {
 
@@ -39,6 +42,17 @@ public:
 
   virtual boost::shared_ptr<OsmMapListener> clone() const = 0;
 
+  /**
+   * Gets called after an element is added to the map. The default implementation does nothing,
+   * so listeners that only care about node replacement don't need to change.
+   */
+  virtual void elementAdded(const ConstElementPtr& /*e*/) {}
+
+  /**
+   * Gets called just before an element is removed from the map.
+   */
+  virtual void elementRemoved(const ConstElementPtr& /*e*/) {}
+
   /**
    * Gets called before a node is replaced.
    */
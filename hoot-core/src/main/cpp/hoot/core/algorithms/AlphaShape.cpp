@@ -29,8 +29,10 @@
 
 // Hoot
 #include <hoot/core/OsmMap.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/GeometryConverter.h>
+#include <hoot/core/util/GeometryMerger.h>
 #include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/elements/Way.h>
 
@@ -53,7 +55,6 @@ using namespace std;
 // TGS
 #include <tgs/DelaunayTriangulation/DelaunayTriangulation.h>
 #include <tgs/DisjointSet/DisjointSet.h>
-#include <tgs/RStarTree/HilbertCurve.h>
 #include <tgs/Statistics/Random.h>
 using namespace Tgs;
 
@@ -85,64 +86,6 @@ private:
   set<int> _children;
 };
 
-class ComparePolygon
-{
-public:
-
-  ComparePolygon(Envelope e)
-  {
-    _curve.reset(new HilbertCurve(2, 8));
-    _e = e;
-    _size = (1 << 8) - 1;
-  }
-
-  ComparePolygon(const ComparePolygon& other)
-  {
-    _curve = other._curve;
-    _e = other._e;
-    _size = other._size;
-  }
-
-  bool operator()(const boost::shared_ptr<Geometry>& p1, const boost::shared_ptr<Geometry>& p2)
-  {
-    const Envelope* e1 = p1->getEnvelopeInternal();
-    const Envelope* e2 = p2->getEnvelopeInternal();
-    double x1 = (e1->getMinX() + e1->getMaxX()) / 2.0;
-    double x2 = (e2->getMinX() + e2->getMaxX()) / 2.0;
-    double y1 = (e1->getMinY() + e1->getMaxY()) / 2.0;
-    double y2 = (e2->getMinY() + e2->getMaxY()) / 2.0;
-
-    int i1[2], i2[2];
-    i1[0] = (int)((x1 - _e.getMinX()) / (_e.getWidth()) * _size);
-    i1[1] = (int)((y1 - _e.getMinY()) / (_e.getHeight()) * _size);
-    i2[0] = (int)((x2 - _e.getMinX()) / (_e.getWidth()) * _size);
-    i2[1] = (int)((y2 - _e.getMinY()) / (_e.getHeight()) * _size);
-
-    bool result;
-    int h1 = _curve->encode(i1);
-    int h2 = _curve->encode(i2);
-    if (h1 == h2)
-    {
-      result = p1 < p2;
-    }
-    else
-    {
-      result = h1 < h2;
-    }
-
-    return result;
-  }
-
-private:
-
-  ComparePolygon();
-  ComparePolygon& operator=(ComparePolygon& other);
-
-  Envelope _e;
-  boost::shared_ptr<HilbertCurve> _curve;
-  double _size;
-};
-
 inline double distance(double x1, double x2, double y1, double y2)
 {
   return sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
@@ -360,7 +303,7 @@ boost::shared_ptr<Geometry> AlphaShape::toGeometry()
 {
   LOG_DEBUG("Traversing faces");
   // create a vector of all faces
-  vector< boost::shared_ptr<Geometry> > tmp, tmp2;
+  vector< boost::shared_ptr<Geometry> > tmp;
   Envelope e;
   double preUnionArea = 0.0;
   int i = 0;
@@ -385,81 +328,9 @@ boost::shared_ptr<Geometry> AlphaShape::toGeometry()
   }
 
   LOG_DEBUG("Joining faces");
-  // while there is more than one geometry.
-  while (tmp.size() > 1)
-  {
-    LOG_TRACE("Sorting size: " << tmp.size());
-    // sort polygons using the hilbert value. This increases the chances that nearby polygons will
-    // be merged early and speed up the union process.
-    ComparePolygon compare(e);
-    sort(tmp.begin(), tmp.end(), compare);
-
-    LOG_TRACE("Remaining pieces: " << tmp.size());
-    tmp2.resize(0);
-    tmp2.reserve(tmp.size() / 2 + 1);
-    // merge pairs at a time. This makes the join faster.
-    for (size_t i = 0; i < tmp.size() - 1; i += 2)
-    {
-      boost::shared_ptr<Geometry> g;
-      // sometimes GEOS gives results that are incorrect. In those cases we try cleaning the
-      // geometries and attempting it again.
-      bool cleanAndRetry = false;
-      try
-      {
-        double area = tmp[i]->getArea() + tmp[i + 1]->getArea();
-        g.reset(tmp[i]->Union(tmp[i + 1].get()));
-        if (g->isEmpty() || fabs(g->getArea() - area) > 0.1)
-        {
-          cleanAndRetry = true;
-        }
-      }
-      catch (const geos::util::GEOSException& e)
-      {
-        LOG_TRACE("Topology error. Attempting to fix it: " << e.what());
-        cleanAndRetry = true;
-      }
-
-      if (cleanAndRetry)
-      {
-        tmp[i].reset(GeometryUtils::validateGeometry(tmp[i].get()));
-        tmp[i + 1].reset(GeometryUtils::validateGeometry(tmp[i + 1].get()));
-        try
-        {
-          g.reset(tmp[i]->Union(tmp[i + 1].get()));
-        }
-        // if the cleaning didn't fix the problem.
-        catch(const geos::util::GEOSException& e)
-        {
-          // report an error.
-          QString error = "Error unioning two geometries. " + QString(e.what()) + "\n" +
-              "geom1: " + QString::fromStdString(tmp[i]->toString()) + "\n" +
-              "geom2: " + QString::fromStdString(tmp[i + 1]->toString());
-          throw HootException(error);
-        }
-      }
-
-      tmp2.push_back(g);
-    }
-    // if there are an odd number of entries, just add the last one
-    if (tmp.size() % 2 == 1)
-    {
-      tmp2.push_back(tmp[tmp.size() - 1]);
-    }
-
-    tmp = tmp2;
-  }
-
-  boost::shared_ptr<Geometry> result;
+  boost::shared_ptr<Geometry> result = GeometryMerger().mergeGeometries(tmp, e);
 
   LOG_DEBUG("Converting geometry to map.");
-  if (tmp.size() == 1)
-  {
-    result = tmp[0];
-  }
-  else
-  {
-    result.reset(GeometryFactory::getDefaultInstance()->createEmptyGeometry());
-  }
 
   result.reset(GeometryUtils::validateGeometry(result.get()));
 
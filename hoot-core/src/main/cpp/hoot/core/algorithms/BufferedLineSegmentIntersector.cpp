@@ -280,4 +280,47 @@ bool BufferedLineSegmentIntersector::intersect(const LineSegment& a, Meters buff
   return lsr.isValid();
 }
 
+void BufferedLineSegmentIntersector::intersect(const LineSegment& a, Meters buffer,
+  const vector<LineSegment>& b, vector<LineSegment>& results, vector<bool>& intersects)
+{
+  const size_t n = b.size();
+  results.resize(n);
+  intersects.resize(n);
+
+  // the buffered capsule around a is contained in a's bounding box expanded by the buffer, so
+  // any segment whose box misses that box can't intersect.
+  const double minX = min(a.p0.x, a.p1.x) - buffer;
+  const double maxX = max(a.p0.x, a.p1.x) + buffer;
+  const double minY = min(a.p0.y, a.p1.y) - buffer;
+  const double maxY = max(a.p0.y, a.p1.y) + buffer;
+
+  // the rejection pass is straight line arithmetic over the packed segment array so the
+  // compiler is free to vectorize it; the expensive parallel line and circle tests below only
+  // run on the survivors.
+  vector<char> candidate(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    const LineSegment& s = b[i];
+    const double sMinX = min(s.p0.x, s.p1.x);
+    const double sMaxX = max(s.p0.x, s.p1.x);
+    const double sMinY = min(s.p0.y, s.p1.y);
+    const double sMaxY = max(s.p0.y, s.p1.y);
+    candidate[i] = sMinX <= maxX && sMaxX >= minX && sMinY <= maxY && sMaxY >= minY;
+  }
+
+  for (size_t i = 0; i < n; i++)
+  {
+    if (candidate[i])
+    {
+      intersects[i] = intersect(a, buffer, b[i], results[i]);
+    }
+    else
+    {
+      // same output as the full test when nothing falls within the buffer
+      results[i] = LineSegment();
+      intersects[i] = false;
+    }
+  }
+}
+
 }
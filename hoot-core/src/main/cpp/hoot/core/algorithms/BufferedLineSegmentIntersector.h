@@ -33,6 +33,9 @@
 // hoot
 #include <hoot/core/util/Units.h>
 
+// Standard
+#include <vector>
+
 namespace hoot
 {
 
@@ -50,6 +53,18 @@ public:
   bool intersect(const geos::geom::LineSegment& a, Meters buffer,
                  const geos::geom::LineSegment& b, geos::geom::LineSegment& result);
 
+  /**
+   * Buffers a and intersects it with every segment in b. results[i] and intersects[i] come out
+   * exactly as intersect(a, buffer, b[i], results[i]) would produce them. A branch-light
+   * bounding box rejection pass runs over the whole array first -- a segment whose box misses
+   * a's box expanded by the buffer can't touch the capsule -- and only the survivors get the
+   * full parallel line and circle tests. Callers evaluating many segments against one (e.g. a
+   * row of MaximalSubline's score matrix) should prefer this over per pair calls.
+   */
+  void intersect(const geos::geom::LineSegment& a, Meters buffer,
+    const std::vector<geos::geom::LineSegment>& b,
+    std::vector<geos::geom::LineSegment>& results, std::vector<bool>& intersects);
+
   /**
    * Determines if the coordinate c is within the endpoints of ls. It is assumed that c falls on
    * or approximately on the line formed by ls (as in the line that goes to inifite).
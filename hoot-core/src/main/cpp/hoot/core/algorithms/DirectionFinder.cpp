@@ -35,6 +35,7 @@ using namespace geos::geom;
 
 // Hoot
 #include <hoot/core/elements/Way.h>
+#include <hoot/core/index/OsmMapIndex.h>
 
 // Standard
 #include <iostream>
@@ -42,7 +43,6 @@ using namespace geos::geom;
 using namespace std;
 
 #include "Distance.h"
-#include "WayDiscretizer.h"
 
 // TGS
 #include <tgs/StreamUtils.h>
@@ -53,11 +53,13 @@ namespace hoot
 
 bool DirectionFinder::isSimilarDirection(const ConstOsmMapPtr& map, ConstWayPtr w1, ConstWayPtr w2)
 {
-  WayDiscretizer wd1(map, w1);
-  WayDiscretizer wd2(map, w2);
-  vector<Coordinate> cs1, cs2;
-  wd1.discretize(5, cs1);
-  wd2.discretize(5, cs2);
+  // the samples are cached on the map index and invalidated when a way's geometry changes, so
+  // the repeated direction checks during merge cascades (e.g. HighwaySnapMerger splitting and
+  // reversing ways) don't rediscretize the same ways over and over.
+  boost::shared_ptr<const vector<Coordinate> > css1 = map->getIndex().getDirectionSamples(w1);
+  boost::shared_ptr<const vector<Coordinate> > css2 = map->getIndex().getDirectionSamples(w2);
+  const vector<Coordinate>& cs1 = *css1;
+  const vector<Coordinate>& cs2 = *css2;
 
   double dSumSame = 0;
   double dSumReverse = 0;
@@ -33,9 +33,12 @@
 #include <hoot/core/util/Configurable.h>
 
 // Qt
+#include <QHash>
 #include <QString>
+#include <QStringList>
 
 // Standard
+#include <assert.h>
 #include <iostream>
 #include <vector>
 
@@ -67,6 +70,21 @@ public:
     return score<QString>(s1, s2);
   }
 
+  /**
+   * Scores s1 against every string in others. The pattern preprocessing for s1 is done once for
+   * the whole list; see Pattern.
+   */
+  static std::vector<double> score(const QString& s1, const QStringList& others)
+  {
+    Pattern p(s1);
+    std::vector<double> result(others.size());
+    for (int i = 0; i < others.size(); i++)
+    {
+      result[i] = p.score(others[i]);
+    }
+    return result;
+  }
+
   template<class T> static
   double score(const T& s1, const T& s2)
   {
@@ -77,7 +95,135 @@ public:
 
   static unsigned int distance(const QString& s1, const QString& s2)
   {
-    return distance<QString>(s1.toLower(), s2.toLower());
+    QString l1 = s1.toLower();
+    QString l2 = s2.toLower();
+    // the bit-parallel kernel keeps one bit per character of the first string.
+    if (l1.size() <= 64)
+    {
+      return distanceMyers(l1, l2);
+    }
+    return distance<QString>(l1, l2);
+  }
+
+  /**
+   * Computes the Levenshtein distance with Myers' bit-parallel algorithm. [1] s1 must be at most
+   * 64 characters long; s2 may be any length. Unlike distance() the inputs are compared as-is,
+   * without lower casing.
+   *
+   * 1. G. Myers, A fast bit-vector algorithm for approximate string matching based on dynamic
+   *    programming, Journal of the ACM 46(3):395-415, 1999.
+   */
+  static unsigned int distanceMyers(const QString& s1, const QString& s2)
+  {
+    const int m = s1.size();
+    if (m == 0)
+    {
+      return s2.size();
+    }
+    assert(m <= 64);
+
+    QHash<ushort, quint64> peq;
+    for (int i = 0; i < m; i++)
+    {
+      peq[s1[i].unicode()] |= (quint64)1 << i;
+    }
+
+    return _distanceMyers(peq, m, s2);
+  }
+
+  /**
+   * A preprocessed pattern for one-vs-many comparisons. The pattern's bit mask table (and lower
+   * casing) is built once in the constructor and reused for every candidate, which saves the per
+   * pair preprocessing when one name is scored against a whole candidate list.
+   */
+  class Pattern
+  {
+  public:
+
+    Pattern(const QString& s)
+    {
+      _s = s.toLower();
+      _m = _s.size();
+      if (_m <= 64)
+      {
+        for (int i = 0; i < _m; i++)
+        {
+          _peq[_s[i].unicode()] |= (quint64)1 << i;
+        }
+      }
+    }
+
+    unsigned int distance(const QString& other) const
+    {
+      QString l2 = other.toLower();
+      if (_m == 0)
+      {
+        return l2.size();
+      }
+      if (_m <= 64)
+      {
+        return _distanceMyers(_peq, _m, l2);
+      }
+      return LevenshteinDistance::distance<QString>(_s, l2);
+    }
+
+    double score(const QString& other) const
+    {
+      size_t size = std::max(_s.size(), other.size());
+      return 1.0 - (double)distance(other) / (double)size;
+    }
+
+  private:
+
+    QString _s;
+    int _m;
+    QHash<ushort, quint64> _peq;
+  };
+
+  /**
+   * Returns the distance between s1 and s2 if it is <= maxD, or maxD + 1 otherwise. Two cheap
+   * pre-filters (length difference and character counts) reject most far apart pairs without
+   * running the full algorithm, which matters when a caller like the FQ-tree checks many leaf
+   * candidates against a small bound.
+   */
+  static unsigned int distanceWithin(const QString& s1, const QString& s2, unsigned int maxD)
+  {
+    unsigned int lengthDiff =
+      s1.size() > s2.size() ? s1.size() - s2.size() : s2.size() - s1.size();
+    if (lengthDiff > maxD)
+    {
+      return maxD + 1;
+    }
+
+    QString l1 = s1.toLower();
+    QString l2 = s2.toLower();
+
+    // each edit operation changes at most two character counts, so half the sum of the count
+    // differences is a lower bound on the distance.
+    QHash<ushort, int> counts;
+    for (int i = 0; i < l1.size(); i++)
+    {
+      counts[l1[i].unicode()]++;
+    }
+    for (int i = 0; i < l2.size(); i++)
+    {
+      counts[l2[i].unicode()]--;
+    }
+    unsigned int diffSum = 0;
+    for (QHash<ushort, int>::const_iterator it = counts.begin(); it != counts.end(); ++it)
+    {
+      diffSum += it.value() < 0 ? -it.value() : it.value();
+    }
+    if ((diffSum + 1) / 2 > maxD)
+    {
+      return maxD + 1;
+    }
+
+    if (l1.size() <= 64)
+    {
+      return distanceMyers(l1, l2);
+    }
+    return distance<QString>(l1, l2);
   }
 
   static unsigned int distance(const char* s1, const char* s2)
@@ -112,6 +258,15 @@ public:
     return distance(s1, s2);
   }
 
+  /**
+   * Bounded variant used when the caller only cares whether the distance is within maxD. May
+   * return any value greater than maxD once the distance is known to exceed maxD.
+   */
+  int operator() (const QString& s1, const QString& s2, int maxD) const
+  {
+    return distanceWithin(s1, s2, maxD);
+  }
+
   void setAlpha(double alpha);
 
   virtual void setConfiguration(const Settings& conf);
@@ -122,6 +277,41 @@ public:
 
 private:
 
+  /**
+   * Myers' column scan against a prebuilt pattern bit mask table. Shared by distanceMyers and
+   * Pattern.
+   */
+  static unsigned int _distanceMyers(const QHash<ushort, quint64>& peq, int m, const QString& s2)
+  {
+    quint64 pv = ~(quint64)0;
+    quint64 mv = 0;
+    const quint64 last = (quint64)1 << (m - 1);
+    unsigned int score = m;
+
+    for (int j = 0; j < s2.size(); j++)
+    {
+      quint64 eq = peq.value(s2[j].unicode(), 0);
+      quint64 xv = eq | mv;
+      quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+      quint64 ph = mv | ~(xh | pv);
+      quint64 mh = pv & xh;
+      if (ph & last)
+      {
+        score++;
+      }
+      if (mh & last)
+      {
+        score--;
+      }
+      ph = (ph << 1) | 1;
+      mh = mh << 1;
+      pv = mh | ~(xv | ph);
+      mv = ph & xv;
+    }
+
+    return score;
+  }
+
   double _alpha;
 };
 
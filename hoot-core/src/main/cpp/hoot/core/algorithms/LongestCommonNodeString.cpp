@@ -30,6 +30,9 @@
 // Hoot
 #include <hoot/core/elements/Way.h>
 
+// Qt
+#include <QHash>
+
 // Standard
 #include <iostream>
 #include <vector>
@@ -57,43 +60,46 @@ int LongestCommonNodeString::apply()
   const vector<long>& str1 = _w1->getNodeIds();
   const vector<long>& str2 = _w2->getNodeIds();
 
-  int *curr = new int [_w2->getNodeCount()];
-  int *prev = new int [_w2->getNodeCount()];
-  int *swap = 0;
+  // The classic dynamic program walks every (i, j) cell, but only the cells where the node ids
+  // match can extend a common substring, and a given node id rarely occurs in a way more than a
+  // couple of times. Hashing the positions of each node id in str2 and visiting only the
+  // matching cells keeps the cost near linear in the way lengths, which is what matters when
+  // DuplicateWayRemover applies this across every way pair sharing a node in a dense grid.
+  QHash<long, vector<int> > positions;
+  for (size_t j = 0; j < str2.size(); j++)
+  {
+    positions[str2[j]].push_back((int)j);
+  }
+
   int maxSubstr = 0;
+  // the run lengths of the common substrings ending at (i - 1, j), keyed by j. Cells that would
+  // be zero in the full matrix are simply absent.
+  QHash<int, int> prevRuns;
+  QHash<int, int> currRuns;
 
-  for(size_t i = 0; i< str1.size(); ++i)
+  for (size_t i = 0; i < str1.size(); ++i)
   {
-    for(size_t j = 0; j< str2.size(); ++j)
+    currRuns.clear();
+    QHash<long, vector<int> >::const_iterator it = positions.find(str1[i]);
+    if (it != positions.end())
     {
-      if(str1[i] != str2[j])
-      {
-        curr[j] = 0;
-      }
-      else
+      const vector<int>& js = it.value();
+      // ascending j order preserves the original tie breaking on equal length runs.
+      for (size_t k = 0; k < js.size(); k++)
       {
-        if(i == 0 || j == 0)
-        {
-          curr[j] = 1;
-        }
-        else
-        {
-          curr[j] = 1 + prev[j-1];
-        }
-        if (curr[j] > maxSubstr)
+        const int j = js[k];
+        const int run = 1 + prevRuns.value(j - 1, 0);
+        currRuns.insert(j, run);
+        if (run > maxSubstr)
         {
-          _i1 = (int)i - curr[j] + 1;
-          _i2 = (int)j - curr[j] + 1;
-          maxSubstr = curr[j];
+          _i1 = (int)i - run + 1;
+          _i2 = j - run + 1;
+          maxSubstr = run;
         }
       }
     }
-    swap=curr;
-    curr=prev;
-    prev=swap;
+    qSwap(prevRuns, currRuns);
   }
-  delete [] curr;
-  delete [] prev;
 
   return maxSubstr;
 }
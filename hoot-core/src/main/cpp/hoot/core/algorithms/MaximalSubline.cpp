@@ -127,6 +127,128 @@ double MaximalSubline::ThresholdMatchCriteria::match(int index1, int index2) con
   return 1.0 * mns;
 }
 
+void MaximalSubline::ThresholdMatchCriteria::matchMatrix(Sparse2dMatrix& scores) const
+{
+  const int count1 = (int)_w1->getNodeCount() - 1;
+  const int count2 = (int)_w2->getNodeCount() - 1;
+  if (count1 <= 0 || count2 <= 0)
+  {
+    return;
+  }
+
+  // hoist the node lookups out of the O(count1 * count2) loop.
+  vector<Coordinate> c1;
+  _map->getNodeCoordinates(_w1->getNodeIds(), c1);
+  vector<Coordinate> c2;
+  _map->getNodeCoordinates(_w2->getNodeIds(), c2);
+
+  // the heading of a segment doesn't depend on the other way, so compute it once per segment
+  // rather than once per cell. The zero length fallback matches match() above.
+  vector<Radians> h1(count1);
+  for (int i = 0; i < count1; i++)
+  {
+    if (c1[i] == c1[i + 1])
+    {
+      h1[i] = WayHeading::calculateHeading(WayLocation(_map, _w1, i, 0));
+    }
+    else
+    {
+      h1[i] = LineSegment(c1[i], c1[i + 1]).angle();
+    }
+  }
+  vector<Radians> h2(count2);
+  for (int j = 0; j < count2; j++)
+  {
+    if (c2[j] == c2[j + 1])
+    {
+      h2[j] = WayHeading::calculateHeading(WayLocation(_map, _w2, j, 0));
+    }
+    else
+    {
+      h2[j] = LineSegment(c2[j], c2[j + 1]).angle();
+    }
+  }
+
+  // w2's segment envelopes, expanded by the distance threshold. If an expanded envelope doesn't
+  // intersect a w1 segment's envelope the segments are more than _maxDistance apart and match()
+  // would score the pair zero, so the cell can be skipped without evaluating it.
+  vector<double> minX2(count2), maxX2(count2), minY2(count2), maxY2(count2);
+  for (int j = 0; j < count2; j++)
+  {
+    minX2[j] = min(c2[j].x, c2[j + 1].x) - _maxDistance;
+    maxX2[j] = max(c2[j].x, c2[j + 1].x) + _maxDistance;
+    minY2[j] = min(c2[j].y, c2[j + 1].y) - _maxDistance;
+    maxY2[j] = max(c2[j].y, c2[j + 1].y) + _maxDistance;
+  }
+
+  // evaluate the matrix a row at a time: the envelope and heading tests gather a row's
+  // surviving cells, then one batched buffered intersection clips all of their segments against
+  // the row's segment. This hoists the intersector out of the inner loop and keeps the envelope
+  // scan a straight pass over the packed arrays. With mostly parallel ways the envelope test
+  // prunes the cells down to a band around the diagonal.
+  const double epsilon = 1e-6;
+  BufferedLineSegmentIntersector intersector;
+  vector<LineSegment> candidates;
+  vector<int> candidateJs;
+  vector<LineSegment> sublines2;
+  vector<bool> hits;
+  for (int i = 0; i < count1; i++)
+  {
+    const double minX1 = min(c1[i].x, c1[i + 1].x);
+    const double maxX1 = max(c1[i].x, c1[i + 1].x);
+    const double minY1 = min(c1[i].y, c1[i + 1].y);
+    const double maxY1 = max(c1[i].y, c1[i + 1].y);
+
+    candidates.clear();
+    candidateJs.clear();
+    for (int j = 0; j < count2; j++)
+    {
+      if (minX2[j] > maxX1 || maxX2[j] < minX1 || minY2[j] > maxY1 || maxY2[j] < minY1)
+      {
+        continue;
+      }
+      if (WayHeading::deltaMagnitude(h1[i], h2[j]) > _maxAngleDiff)
+      {
+        continue;
+      }
+      candidates.push_back(LineSegment(c2[j], c2[j + 1]));
+      candidateJs.push_back(j);
+    }
+    if (candidates.empty())
+    {
+      continue;
+    }
+
+    const LineSegment ls1(c1[i], c1[i + 1]);
+    // first half of matchingSubline for the whole row at once; sublines2[k] is what it leaves
+    // in its b argument.
+    intersector.intersect(ls1, _maxDistance, candidates, sublines2, hits);
+
+    for (size_t k = 0; k < candidates.size(); k++)
+    {
+      const int j = candidateJs[k];
+
+      // the reverse direction of matchingSubline: clip the row's segment to the buffer around
+      // the original (unclipped) candidate.
+      LineSegment subline1;
+      intersector.intersect(candidates[k], _maxDistance, ls1, subline1);
+
+      // same as the tail of match().
+      double maxD =
+        max(subline1.p0.distance(sublines2[k].p0), subline1.p1.distance(sublines2[k].p1));
+      double mns = min(subline1.getLength(), sublines2[k].getLength());
+      if (maxD > _maxDistance + epsilon)
+      {
+        continue;
+      }
+      if (mns > 0.0)
+      {
+        scores.set(i, j, mns);
+      }
+    }
+  }
+}
+
 void MaximalSubline::ThresholdMatchCriteria::matchingSubline(LineSegment &a, LineSegment &b) const
 {
   BufferedLineSegmentIntersector bi;
@@ -139,6 +261,22 @@ void MaximalSubline::ThresholdMatchCriteria::matchingSubline(LineSegment &a, Lin
   b = sublineB;
 }
 
+void MaximalSubline::MatchCriteria::matchMatrix(Sparse2dMatrix& scores) const
+{
+  for (int n1 = 0; n1 < (int)_w1->getNodeCount() - 1; n1++)
+  {
+    for (int n2 = 0; n2 < (int)_w2->getNodeCount() - 1; n2++)
+    {
+      double s = match(n1, n2);
+
+      if (s > 0.0)
+      {
+        scores.set(n1, n2, s);
+      }
+    }
+  }
+}
+
 void MaximalSubline::MatchCriteria::maximalNearestSubline(LineSegment& a,
   LineSegment& b) const
 {
@@ -198,19 +336,7 @@ void MaximalSubline::_calculateSublineScores(const ConstOsmMapPtr& map, const Co
   const ConstWayPtr& way2, Sparse2dMatrix& scores)
 {
   _criteria->setWays(map, way1, way2);
-
-  for (int n1 = 0; n1 < (int)way1->getNodeCount() - 1; n1++)
-  {
-    for (int n2 = 0; n2 < (int)way2->getNodeCount() - 1; n2++)
-    {
-      double s = _criteria->match(n1, n2);
-
-      if (s > 0.0)
-      {
-        scores.set(n1, n2, s);
-      }
-    }
-  }
+  _criteria->matchMatrix(scores);
 }
 
 vector< pair<WayLocation, WayLocation> > MaximalSubline::_discretizePointPairs(
@@ -84,6 +84,13 @@ public:
      */
     virtual double match(int index1, int index2) const = 0;
 
+    /**
+     * Fills @a scores with the match score of every segment pair that scores greater than zero.
+     * The default implementation simply calls match for every cell in the matrix; subclasses can
+     * override it with a kernel that hoists the per cell work out of the loop.
+     */
+    virtual void matchMatrix(Sparse2dMatrix& scores) const;
+
     /**
      * Crops the line segments a and b down to their maximal nearest sublines relative to each
      * other.
@@ -115,6 +122,16 @@ public:
 
     virtual double match(int index1, int index2) const;
 
+    /**
+     * Blocked version of the score matrix calculation. The node lookups, segment headings and
+     * segment envelopes are computed once per segment rather than once per cell, the matrix is
+     * evaluated in cache sized tiles and segment pairs whose envelopes are more than maxDistance
+     * apart are skipped. Those pairs always score zero (see match), so with mostly parallel ways
+     * this reduces the evaluated cells to a band around the matrix diagonal while producing the
+     * same scores as the cell by cell version.
+     */
+    virtual void matchMatrix(Sparse2dMatrix& scores) const;
+
     void matchingSubline(geos::geom::LineSegment& a, geos::geom::LineSegment& b) const;
 
   private:
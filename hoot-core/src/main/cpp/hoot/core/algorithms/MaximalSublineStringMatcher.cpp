@@ -110,9 +110,11 @@ WaySublineMatchString MaximalSublineStringMatcher::findMatch(const ConstOsmMapPt
 
   // Try with all combinations of forward and reversed ways. This is very expensive for
   // multilinestrings with lots of ways in them. Though those shouldn't be common.
+  // The context holds the one private map copy that every combination reverses ways in.
+  MatchContext context = _createMatchContext(map, ways1, ways2);
   vector<bool> reversed1(ways1.size(), false), reversed2(ways2.size(), false);
-  ScoredMatch scoredResult = _findBestMatch(map, maxRelevantDistance, ways1, ways2, reversed1,
-    reversed2);
+  ScoredMatch scoredResult = _findBestMatch(context, map, maxRelevantDistance, ways1, ways2,
+    reversed1, reversed2);
   LOG_VARD(scoredResult);
 
   // convert the best match into a WaySublineStringMatch and return.
@@ -130,26 +132,64 @@ WaySublineMatchString MaximalSublineStringMatcher::findMatch(const ConstOsmMapPt
   }
 }
 
-MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_evaluateMatch(
-  const ConstOsmMapPtr &map, Meters maxDistance, const vector<ConstWayPtr>& ways1,
-  const vector<ConstWayPtr> &ways2, const vector<bool>& reversed1,
-  const vector<bool> &reversed2) const
+MaximalSublineStringMatcher::MatchContext MaximalSublineStringMatcher::_createMatchContext(
+  const ConstOsmMapPtr& map, const vector<ConstWayPtr>& ways1,
+  const vector<ConstWayPtr>& ways2) const
 {
-  vector<WaySublineMatch> matches;
+  MatchContext result;
 
   // make a copy of the map and the ways we need so we can reverse the ways as needed.
   set<ElementId> eids;
   _insertElementIds(ways1, eids);
   _insertElementIds(ways2, eids);
-  OsmMapPtr copiedMap(new OsmMap(map->getProjection()));
-  CopySubsetOp(map, eids).apply(copiedMap);
+  result.copiedMap.reset(new OsmMap(map->getProjection()));
+  CopySubsetOp(map, eids).apply(result.copiedMap);
+
+  result.prep1 = _changeMap(ways1, result.copiedMap);
+  result.prep2 = _changeMap(ways2, result.copiedMap);
+  result.state1.assign(ways1.size(), false);
+  result.state2.assign(ways2.size(), false);
 
-  vector<WayPtr> prep1 = _changeMap(ways1, copiedMap);
-  vector<WayPtr> prep2 = _changeMap(ways2, copiedMap);
+  return result;
+}
+
+MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_evaluateMatch(
+  const ConstOsmMapPtr &map, Meters maxDistance, const vector<ConstWayPtr>& ways1,
+  const vector<ConstWayPtr> &ways2, const vector<bool>& reversed1,
+  const vector<bool> &reversed2) const
+{
+  MatchContext context = _createMatchContext(map, ways1, ways2);
+  return _evaluateMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2);
+}
 
-  // reversed ways as appropriate
-  _reverseWays(prep1, reversed1);
-  _reverseWays(prep2, reversed2);
+MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_evaluateMatch(
+  MatchContext& context, const ConstOsmMapPtr &map, Meters maxDistance,
+  const vector<ConstWayPtr>& /*ways1*/, const vector<ConstWayPtr>& /*ways2*/,
+  const vector<bool>& reversed1, const vector<bool> &reversed2) const
+{
+  vector<WaySublineMatch> matches;
+
+  // toggle the copied ways in place so they match the requested directions. Reversing a way
+  // twice restores it, so the context map never has to be copied again.
+  OsmMapPtr copiedMap = context.copiedMap;
+  vector<WayPtr>& prep1 = context.prep1;
+  vector<WayPtr>& prep2 = context.prep2;
+  for (size_t i = 0; i < prep1.size(); i++)
+  {
+    if (context.state1[i] != reversed1[i])
+    {
+      prep1[i]->reverseOrder();
+      context.state1[i] = reversed1[i];
+    }
+  }
+  for (size_t i = 0; i < prep2.size(); i++)
+  {
+    if (context.state2[i] != reversed2[i])
+    {
+      prep2[i]->reverseOrder();
+      context.state2[i] = reversed2[i];
+    }
+  }
 
   double scoreSum = 0;
 
@@ -222,7 +262,7 @@ MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_evaluateM
 }
 
 MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_findBestMatch(
-  const ConstOsmMapPtr& map, Meters maxDistance, vector<ConstWayPtr>& ways1,
+  MatchContext& context, const ConstOsmMapPtr& map, Meters maxDistance, vector<ConstWayPtr>& ways1,
   vector<ConstWayPtr> &ways2, vector<bool>& reversed1, vector<bool> &reversed2, size_t i, size_t j)
   const
 {
@@ -230,14 +270,16 @@ MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_findBestM
 
   if ((i == ways1.size() || ways1.size() == 1) && j == ways2.size())
   {
-    return _evaluateMatch(map, maxDistance, ways1, ways2, reversed1, reversed2);
+    return _evaluateMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2);
   }
   else if (j == ways2.size())
   {
     reversed1[i] = true;
-    ScoredMatch r1 = _findBestMatch(map, maxDistance, ways1, ways2, reversed1, reversed2, i + 1, j);
+    ScoredMatch r1 = _findBestMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2,
+      i + 1, j);
     reversed1[i] = false;
-    ScoredMatch r2 = _findBestMatch(map, maxDistance, ways1, ways2, reversed1, reversed2, i + 1, j);
+    ScoredMatch r2 = _findBestMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2,
+      i + 1, j);
 
     // only keep the reverse if it is significantly better
     if (r1.score - r2.score > epsilon)
@@ -252,9 +294,11 @@ MaximalSublineStringMatcher::ScoredMatch MaximalSublineStringMatcher::_findBestM
   else
   {
     reversed2[j] = true;
-    ScoredMatch r1 = _findBestMatch(map, maxDistance, ways1, ways2, reversed1, reversed2, i, j + 1);
+    ScoredMatch r1 = _findBestMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2,
+      i, j + 1);
     reversed2[j] = false;
-    ScoredMatch r2 = _findBestMatch(map, maxDistance, ways1, ways2, reversed1, reversed2, i, j + 1);
+    ScoredMatch r2 = _findBestMatch(context, map, maxDistance, ways1, ways2, reversed1, reversed2,
+      i, j + 1);
 
     // only keep the reverse if it is significantly better
     if (r1.score - r2.score > epsilon)
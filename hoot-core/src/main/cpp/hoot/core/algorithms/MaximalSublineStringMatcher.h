@@ -106,19 +106,44 @@ private:
     }
   };
 
+  /**
+   * Per findMatch scratch state: the private copy of the map whose candidate ways can be
+   * reversed freely and the current direction of each copied way. Building this once per element
+   * pair lets _evaluateMatch toggle way directions in place instead of copying the map again for
+   * each of the up to 2^n reversal combinations. It lives on the findMatch stack, so each thread
+   * gets its own.
+   */
+  struct MatchContext
+  {
+    OsmMapPtr copiedMap;
+    std::vector<WayPtr> prep1, prep2;
+    // the current reversal state of prep1/prep2 relative to the source map.
+    std::vector<bool> state1, state2;
+  };
+
   std::vector<WayPtr> _changeMap(const std::vector<ConstWayPtr>& ways, OsmMapPtr map) const;
 
   int _countReverses(const std::vector<bool>& r) const;
 
+  MatchContext _createMatchContext(const ConstOsmMapPtr& map,
+    const std::vector<ConstWayPtr>& ways1, const std::vector<ConstWayPtr>& ways2) const;
+
+  ScoredMatch _evaluateMatch(MatchContext& context, const ConstOsmMapPtr &map, Meters maxDistance,
+    const std::vector<ConstWayPtr>& ways1, const std::vector<ConstWayPtr>& ways2,
+    const std::vector<bool>& reversed1, const std::vector<bool>& reversed2) const;
+
+  /**
+   * Convenience overload that builds a context for a single evaluation.
+   */
   ScoredMatch _evaluateMatch(const ConstOsmMapPtr &map, Meters maxDistance,
     const std::vector<ConstWayPtr>& ways1, const std::vector<ConstWayPtr>& ways2,
     const std::vector<bool>& reversed1, const std::vector<bool>& reversed2) const;
 
   std::vector<ConstWayPtr> _extractWays(const ConstOsmMapPtr& map, const ConstElementPtr& e) const;
 
-  ScoredMatch _findBestMatch(const ConstOsmMapPtr &map, Meters maxDistance,
-    std::vector<ConstWayPtr>& ways1, std::vector<ConstWayPtr> &ways2, std::vector<bool>& reversed1,
-    std::vector<bool> &reversed2, size_t i = 0, size_t j = 0) const;
+  ScoredMatch _findBestMatch(MatchContext& context, const ConstOsmMapPtr &map,
+    Meters maxDistance, std::vector<ConstWayPtr>& ways1, std::vector<ConstWayPtr> &ways2,
+    std::vector<bool>& reversed1, std::vector<bool> &reversed2, size_t i = 0, size_t j = 0) const;
 
   void _insertElementIds(const std::vector<ConstWayPtr>& ways, std::set<ElementId>& elements) const;
 
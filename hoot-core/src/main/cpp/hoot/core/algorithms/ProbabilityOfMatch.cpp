@@ -174,6 +174,11 @@ double ProbabilityOfMatch::lengthScore(const ConstOsmMapPtr &map, const ConstWay
   Meters l1 = ElementConverter(map).convertToLineString(w1)->getLength();
   Meters l2 = ElementConverter(map).convertToLineString(w2)->getLength();
 
+  return lengthScore(l1, l2);
+}
+
+double ProbabilityOfMatch::lengthScore(Meters l1, Meters l2)
+{
   // longer matches get a higher score.
   Meters mean = (l1 + l2) / 2.0;
 
@@ -61,6 +61,12 @@ public:
   double lengthScore(const ConstOsmMapPtr& map, const ConstWayPtr& w1,
     const ConstWayPtr& w2);
 
+  /**
+   * Same as above, but operates on precomputed way lengths so callers that already derived them
+   * (e.g. through a FeatureExtractionContext) don't convert the ways again.
+   */
+  double lengthScore(Meters l1, Meters l2);
+
   double parallelScore(const ConstOsmMapPtr& map, const ConstWayPtr& w1,
     const ConstWayPtr& w2);
 
@@ -29,6 +29,7 @@
 
 // Standard
 #include <cmath>
+#include <utility>
 
 // Hoot
 #include <hoot/core/OsmMap.h>
@@ -38,6 +39,10 @@
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/OsmUtils.h>
 
+// Qt
+#include <QVector>
+#include <QtConcurrentMap>
+
 using namespace std;
 
 namespace hoot
@@ -64,37 +69,71 @@ void RdpWayGeneralizer::generalize(boost::shared_ptr<Way> way)
   LOG_VART(way->getNodeIds().size());
   LOG_VART(QVector<long>::fromStdVector(way->getNodeIds()).toList());
 
-  const QList<long> wayNodeIdsBeforeFiltering =
-    QVector<long>::fromStdVector(way->getNodeIds()).toList();
-  LOG_VART(wayNodeIdsBeforeFiltering.size());
-  LOG_VART(wayNodeIdsBeforeFiltering);
+  //replace the current nodes on the way with the reduced collection
+  way->setNodes(_getGeneralizedNodeIds(way));
+  LOG_VART(way->getNodeIds().size());
+  LOG_VART(QVector<long>::fromStdVector(way->getNodeIds()).toList());
+}
+
+void RdpWayGeneralizer::generalizeMap(boost::shared_ptr<OsmMap> map, double epsilon)
+{
+  RdpWayGeneralizer generalizer(map, epsilon);
+
+  QVector<GeneralizeTask> tasks;
+  const WayMap& ways = map->getWays();
+  tasks.reserve(ways.size());
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    GeneralizeTask task;
+    task.generalizer = &generalizer;
+    task.way = it->second;
+    tasks.append(task);
+  }
+
+  //computing the reduced node lists only reads the map, so it fans out across the thread pool
+  QtConcurrent::blockingMap(tasks, &RdpWayGeneralizer::_generalizeWay);
+
+  //apply the results serially; the map isn't safe to modify from worker threads
+  for (int i = 0; i < tasks.size(); i++)
+  {
+    tasks[i].way->setNodes(tasks[i].newNodeIds);
+  }
+}
+
+void RdpWayGeneralizer::_generalizeWay(GeneralizeTask& task)
+{
+  task.newNodeIds = task.generalizer->_getGeneralizedNodeIds(task.way);
+}
+
+std::vector<long> RdpWayGeneralizer::_getGeneralizedNodeIds(
+  const boost::shared_ptr<const Way>& way)
+{
+  //look the nodes up through the const node map; unlike OsmMap::getNode this doesn't touch the
+  //map's shared scratch iterator, so concurrent workers can read the same map
+  const NodeMap& nodes = _map->getNodes();
 
   //filter the nodes to be generalized to those in this way and those with no information tags;
   //tried using hoot filters here at first, but it didn't end up making sense
-  QList<long> wayNodeIdsAfterFiltering;
-  for (QList<long>::const_iterator it = wayNodeIdsBeforeFiltering.begin();
-       it != wayNodeIdsBeforeFiltering.end(); ++it)
+  QList<boost::shared_ptr<const Node> > wayPoints;
+  const vector<long>& wayNodeIds = way->getNodeIds();
+  for (size_t i = 0; i < wayNodeIds.size(); i++)
   {
-    if (_map->getNode(*it)->getTags().getInformationCount() == 0)
+    NodeMap::const_iterator it = nodes.find(wayNodeIds[i]);
+    const boost::shared_ptr<const Node> node = it->second;
+    if (node->getTags().getInformationCount() == 0)
     {
-      wayNodeIdsAfterFiltering.append(*it);
+      wayPoints.append(node);
     }
   }
-  LOG_VART(wayNodeIdsAfterFiltering.size());
-  LOG_VART(wayNodeIdsAfterFiltering);
+  LOG_VART(wayPoints.size());
 
   //get the generalized points
-  const QList<boost::shared_ptr<const Node> >& generalizedPoints =
-    getGeneralizedPoints(OsmUtils::nodeIdsToNodes(wayNodeIdsAfterFiltering, _map));
+  const QList<boost::shared_ptr<const Node> > generalizedPoints =
+    getGeneralizedPoints(wayPoints);
   LOG_VART(generalizedPoints.size());
   OsmUtils::printNodes("generalizedPoints", generalizedPoints);
 
-  //replace the current nodes on the way with the reduced collection
-  way->setNodes(OsmUtils::nodesToNodeIds(generalizedPoints).toVector().toStdVector());
-  LOG_VART(way->getNodeIds().size());
-  LOG_VART(QVector<long>::fromStdVector(way->getNodeIds()).toList());
-  LOG_VART(_map->getWay(way->getId())->getNodeIds().size());
-  LOG_VART(QVector<long>::fromStdVector(_map->getWay(way->getId())->getNodeIds()).toList());
+  return OsmUtils::nodesToNodeIds(generalizedPoints).toVector().toStdVector();
 }
 
 QList<boost::shared_ptr<const Node> > RdpWayGeneralizer::getGeneralizedPoints(
@@ -106,61 +145,71 @@ QList<boost::shared_ptr<const Node> > RdpWayGeneralizer::getGeneralizedPoints(
     return wayPoints;
   }
 
-  boost::shared_ptr<const Node> firstPoint = wayPoints.at(0);
-  LOG_VART(firstPoint->toString());
-  boost::shared_ptr<const Node> lastPoint = wayPoints.at(wayPoints.size() - 1);
-  LOG_VART(lastPoint->toString());
+  //iterative form of the classic recursion: pull the coordinates into flat arrays once, then
+  //process (start, end) ranges off an explicit stack and record the survivors in a keep mask.
+  //This avoids allocating shared_ptr wrapped sublists for every recursive call and produces
+  //exactly the same reduction.
+  const int pointCount = wayPoints.size();
+  vector<double> x(pointCount);
+  vector<double> y(pointCount);
+  for (int i = 0; i < pointCount; i++)
+  {
+    x[i] = wayPoints.at(i)->getX();
+    y[i] = wayPoints.at(i)->getY();
+  }
+
+  vector<bool> keep(pointCount, false);
+  keep[0] = true;
+  keep[pointCount - 1] = true;
 
-  int indexOfLargestPerpendicularDistance = -1;
-  double largestPerpendicularDistance = 0;
-  for (int i = 1; i < wayPoints.size() - 1; i++)
+  vector<pair<int, int> > ranges;
+  ranges.push_back(pair<int, int>(0, pointCount - 1));
+  while (ranges.empty() == false)
   {
-    const double perpendicularDistance =
-      _getPerpendicularDistanceBetweenSplitNodeAndImaginaryLine(
-        wayPoints.at(i), firstPoint, lastPoint);
-    if (perpendicularDistance > largestPerpendicularDistance)
+    const int start = ranges.back().first;
+    const int end = ranges.back().second;
+    ranges.pop_back();
+    if (end - start < 2)
     {
-      largestPerpendicularDistance = perpendicularDistance;
-      indexOfLargestPerpendicularDistance = i;
+      continue;
     }
-  }
-  LOG_VART(largestPerpendicularDistance);
-  LOG_VART(indexOfLargestPerpendicularDistance);
-  LOG_VART(_epsilon);
 
-  if (largestPerpendicularDistance > _epsilon)
-  {
-    //split the curve into two parts and recursively reduce the two lines
-    const QList<boost::shared_ptr<const Node> > splitLine1 =
-      wayPoints.mid(0, indexOfLargestPerpendicularDistance + 1);
-    OsmUtils::printNodes("splitLine1", splitLine1);
-    const QList<boost::shared_ptr<const Node> > splitLine2 =
-      wayPoints.mid(indexOfLargestPerpendicularDistance);
-    OsmUtils::printNodes("splitLine2", splitLine2);
-
-    const QList<boost::shared_ptr<const Node> > recursivelySplitLine1 =
-      getGeneralizedPoints(splitLine1);
-    OsmUtils::printNodes("recursivelySplitLine1", recursivelySplitLine1);
-    const QList<boost::shared_ptr<const Node> > recursivelySplitLine2 =
-      getGeneralizedPoints(splitLine2);
-    OsmUtils::printNodes("recursivelySplitLine2", recursivelySplitLine2);
-
-    //concat r2 to r1 minus the end/start point that will be the same
-    QList<boost::shared_ptr<const Node> > combinedReducedLines =
-      recursivelySplitLine1.mid(0, recursivelySplitLine1.size() - 1);
-    combinedReducedLines.append(recursivelySplitLine2);
-    OsmUtils::printNodes("combinedReducedLines", combinedReducedLines);
-    return combinedReducedLines;
+    int indexOfLargestPerpendicularDistance = -1;
+    double largestPerpendicularDistance = 0;
+    for (int i = start + 1; i < end; i++)
+    {
+      const double perpendicularDistance =
+        _getPerpendicularDistance(x[i], y[i], x[start], y[start], x[end], y[end]);
+      if (perpendicularDistance > largestPerpendicularDistance)
+      {
+        largestPerpendicularDistance = perpendicularDistance;
+        indexOfLargestPerpendicularDistance = i;
+      }
+    }
+    LOG_VART(largestPerpendicularDistance);
+    LOG_VART(indexOfLargestPerpendicularDistance);
+    LOG_VART(_epsilon);
+
+    if (largestPerpendicularDistance > _epsilon)
+    {
+      //split the curve at the outlier and reduce the two parts
+      keep[indexOfLargestPerpendicularDistance] = true;
+      ranges.push_back(pair<int, int>(start, indexOfLargestPerpendicularDistance));
+      ranges.push_back(pair<int, int>(indexOfLargestPerpendicularDistance, end));
+    }
+    //else every point between start and end is dropped
   }
-  else
+
+  QList<boost::shared_ptr<const Node> > reducedLine;
+  for (int i = 0; i < pointCount; i++)
   {
-    //reduce the line by remove all points between the first and last points
-    QList<boost::shared_ptr<const Node> > reducedLine;
-    reducedLine.append(firstPoint);
-    reducedLine.append(lastPoint);
-    OsmUtils::printNodes("reducedLine", reducedLine);
-    return reducedLine;
+    if (keep[i])
+    {
+      reducedLine.append(wayPoints.at(i));
+    }
   }
+  OsmUtils::printNodes("reducedLine", reducedLine);
+  return reducedLine;
 }
 
 void RdpWayGeneralizer::setEpsilon(double epsilon)
@@ -179,22 +228,26 @@ double RdpWayGeneralizer::_getPerpendicularDistanceBetweenSplitNodeAndImaginaryL
 {
   LOG_VART(lineToBeReducedStartPoint->getX());
   LOG_VART(lineToBeReducedEndPoint->getX());
+  return
+    _getPerpendicularDistance(
+      splitPoint->getX(), splitPoint->getY(), lineToBeReducedStartPoint->getX(),
+      lineToBeReducedStartPoint->getY(), lineToBeReducedEndPoint->getX(),
+      lineToBeReducedEndPoint->getY());
+}
+
+double RdpWayGeneralizer::_getPerpendicularDistance(double splitX, double splitY, double startX,
+  double startY, double endX, double endY)
+{
   double perpendicularDistance;
-  if (lineToBeReducedStartPoint->getX() == lineToBeReducedEndPoint->getX())
+  if (startX == endX)
   {
-    perpendicularDistance = abs(splitPoint->getX() - lineToBeReducedStartPoint->getX());
+    perpendicularDistance = abs(splitX - startX);
   }
   else
   {
-    const double slope =
-      (lineToBeReducedEndPoint->getY() - lineToBeReducedStartPoint->getY()) /
-      (lineToBeReducedEndPoint->getX() - lineToBeReducedStartPoint->getX());
-    LOG_VART(slope);
-    const double intercept =
-      lineToBeReducedStartPoint->getY() - (slope * lineToBeReducedStartPoint->getX());
-    LOG_VART(intercept);
-    perpendicularDistance =
-      abs(slope * splitPoint->getX() - splitPoint->getY() + intercept) / sqrt(pow(slope, 2) + 1);
+    const double slope = (endY - startY) / (endX - startX);
+    const double intercept = startY - (slope * startX);
+    perpendicularDistance = abs(slope * splitX - splitY + intercept) / sqrt(pow(slope, 2) + 1);
   }
   LOG_VART(perpendicularDistance);
   return perpendicularDistance;
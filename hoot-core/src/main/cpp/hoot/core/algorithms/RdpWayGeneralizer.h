@@ -34,6 +34,9 @@
 // Qt
 #include <QString>
 
+// Standard
+#include <vector>
+
 namespace hoot
 {
 
@@ -85,6 +88,16 @@ public:
     */
   void generalize(boost::shared_ptr<Way> way);
 
+  /**
+    Generalizes every way in the map. The reduced node lists are computed on the thread pool,
+    since the computation only reads the map, and the ways are then updated serially since maps
+    aren't safe to modify from worker threads.
+
+    @param map the map whose ways are to be generalized
+    @param epsilon see setEpsilon
+    */
+  static void generalizeMap(boost::shared_ptr<OsmMap> map, double epsilon);
+
   /**
     Generates a set of points that make up a generalized set of the input points
 
@@ -108,6 +121,25 @@ private:
 
   boost::shared_ptr<OsmMap> _map;
 
+  /*
+    One way's unit of work for generalizeMap. Computing the reduced node list only reads the map,
+    so the tasks run concurrently and the results are applied afterwards.
+    */
+  struct GeneralizeTask
+  {
+    RdpWayGeneralizer* generalizer;
+    boost::shared_ptr<Way> way;
+    std::vector<long> newNodeIds;
+  };
+
+  static void _generalizeWay(GeneralizeTask& task);
+
+  /*
+    Computes the reduced node id list for a way without modifying anything. Safe to call from
+    several threads against the same map.
+    */
+  std::vector<long> _getGeneralizedNodeIds(const boost::shared_ptr<const Way>& way);
+
   /*
     Finds the perpendicular distance between an imaginary line drawn from the first point on a line
     to the last point on a line and a split point
@@ -122,6 +154,13 @@ private:
     const boost::shared_ptr<const Node> splitPoint, const boost::shared_ptr<const Node> lineToBeReducedStartPoint,
     const boost::shared_ptr<const Node> lineToBeReducedEndPoint) const;
 
+  /*
+    The same calculation on raw coordinates; used by the iterative reduction so the inner loop
+    doesn't touch the nodes at all.
+    */
+  static double _getPerpendicularDistance(double splitX, double splitY, double startX,
+    double startY, double endX, double endY);
+
 };
 
 }
@@ -53,19 +53,16 @@ WayDiscretizer::WayDiscretizer(const ConstOsmMapPtr &map, ConstWayPtr way) :
 
   // Go through all the nodes
   double l = 0;
-  const std::vector<long>& nodeIds = _way->getNodeIds();
-  ConstNodePtr lastNode = _map->getNode(nodeIds[0]);
-  for (size_t i = 0; i < nodeIds.size(); i++)
+  _map->getNodeCoordinates(_way->getNodeIds(), _coords);
+  for (size_t i = 0; i < _coords.size(); i++)
   {
     // calculate the distance from the last node to this node.
-    ConstNodePtr n = _map->getNode(nodeIds[i]);
-    double d = Distance::euclidean(*lastNode, *n);
+    double d = Distance::euclidean(_coords[i == 0 ? 0 : i - 1], _coords[i]);
 
     // add the distance to a running total
     l += d;
     // keep track of the distance from the beginning of the way to this node.
     _lengthNodes.push_back(l);
-    lastNode = n;
   }
 }
 
@@ -102,19 +99,13 @@ geos::geom::Coordinate WayDiscretizer::interpolate(double d)
 {
   geos::geom::Coordinate result;
 
-  const std::vector<long>& nodeIds = _way->getNodeIds();
-
   if (d <= 0)
   {
-    ConstNodePtr n = _map->getNode(nodeIds[0]);
-    result.x = n->getX();
-    result.y = n->getY();
+    result = _coords[0];
   }
   else if (d >= _lengthNodes.back())
   {
-    ConstNodePtr n = _map->getNode(nodeIds.back());
-    result.x = n->getX();
-    result.y = n->getY();
+    result = _coords.back();
   }
   else
   {
@@ -124,13 +115,10 @@ geos::geom::Coordinate WayDiscretizer::interpolate(double d)
     double startD = _lengthNodes[i];
     double endD = _lengthNodes[i + 1];
 
-    ConstNodePtr startN = _map->getNode(nodeIds[i]);
-    ConstNodePtr endN = _map->getNode(nodeIds[i + 1]);
-
     double w = (d - startD) / (endD - startD);
 
-    result.x = startN->getX() * (1 - w) + endN->getX() * w;
-    result.y = startN->getY() * (1 - w) + endN->getY() * w;
+    result.x = _coords[i].x * (1 - w) + _coords[i + 1].x * w;
+    result.y = _coords[i].y * (1 - w) + _coords[i + 1].y * w;
   }
 
   return result;
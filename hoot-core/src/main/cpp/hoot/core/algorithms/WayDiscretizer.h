@@ -31,11 +31,7 @@
 #include <tgs/SharedPtr.h>
 
 // GEOS
-namespace geos {
-  namespace geom {
-    class Coordinate;
-  }
-}
+#include <geos/geom/Coordinate.h>
 
 // Hoot
 #include <hoot/core/OsmMap.h>
@@ -86,6 +82,9 @@ public:
 protected:
   ConstOsmMapPtr _map;
   boost::shared_ptr<const hoot::Way> _way;
+  // The coordinate of each node that makes up the way, gathered once up front so interpolation
+  // doesn't go back to the map per node.
+  std::vector<geos::geom::Coordinate> _coords;
   // The distance from the beginning of the way to each node that makes up the way.
   std::vector<double> _lengthNodes;
 };
@@ -0,0 +1,67 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "MappedWordWeightDictionary.h"
+
+// Standard
+#include <algorithm>
+
+namespace hoot
+{
+
+MappedWordWeightDictionary::MappedWordWeightDictionary(const QString& filePath) :
+  _index(filePath)
+{
+  _total = std::max(1L, _index.getTotalCount());
+  _nonWord.setPattern("[^\\w]");
+}
+
+QByteArray MappedWordWeightDictionary::_normalize(const QString& word) const
+{
+  // mirrors the normalization in the other word weight dictionaries.
+  QString normalized = word.toLower().normalized(QString::NormalizationForm_C);
+  normalized.replace(_nonWord, "");
+  return normalized.toUtf8();
+}
+
+double MappedWordWeightDictionary::getWeight(const QString& word) const
+{
+  return (double)_index.getCount(_normalize(word)) / (double)_total;
+}
+
+void MappedWordWeightDictionary::getWeights(const QStringList& words,
+  std::vector<double>& result) const
+{
+  result.resize(words.size());
+
+  const double total = (double)_total;
+  for (int i = 0; i < words.size(); i++)
+  {
+    result[i] = (double)_index.getCount(_normalize(words[i])) / total;
+  }
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef MAPPEDWORDWEIGHTDICTIONARY_H
+#define MAPPEDWORDWEIGHTDICTIONARY_H
+
+// hoot
+#include <hoot/core/algorithms/string/WordWeightDictionary.h>
+#include <hoot/core/io/MappedWordCountIndex.h>
+
+// Qt
+#include <QRegExp>
+
+namespace hoot
+{
+
+/**
+ * A word weight dictionary backed by a memory mapped word count index (MappedWordCountIndex).
+ *
+ * Unlike SqliteWordWeightDictionary and TextFileWordWeightDictionary there is no per process
+ * load step and no per process cache that grows over the run -- the index pages are shared
+ * read-only between all processes on the host. Weights follow the text file dictionary: the
+ * word's count over the total corpus count, or 0 for an unknown word.
+ */
+class MappedWordWeightDictionary : public WordWeightDictionary
+{
+public:
+
+  MappedWordWeightDictionary(const QString& filePath);
+
+  virtual double getMinWeight() const { return 1.0 / (double)_total; }
+
+  virtual double getWeight(const QString& word) const;
+
+  /**
+   * Batched lookup; normalizes every word up front then resolves the counts against the mapped
+   * index in one pass.
+   */
+  virtual void getWeights(const QStringList& words, std::vector<double>& result) const;
+
+private:
+
+  MappedWordCountIndex _index;
+  // clamped to at least 1 so an empty index can't divide by zero.
+  long _total;
+  QRegExp _nonWord;
+
+  QByteArray _normalize(const QString& word) const;
+};
+
+}
+
+#endif // MAPPEDWORDWEIGHTDICTIONARY_H
@@ -29,6 +29,7 @@
 // hoot
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/algorithms/LevenshteinDistance.h>
+#include <hoot/core/algorithms/string/MappedWordWeightDictionary.h>
 #include <hoot/core/algorithms/string/SqliteWordWeightDictionary.h>
 #include <hoot/core/algorithms/string/TextFileWordWeightDictionary.h>
 #include <hoot/core/schema/ScoreMatrix.h>
@@ -36,6 +37,7 @@
 #include <hoot/core/util/ConfigOptions.h>
 
 // Qt
+#include <QFile>
 #include <QStringList>
 
 // Standard
@@ -79,7 +81,22 @@ WeightedWordDistance::WeightedWordDistance()
       dictPath);
   }
 
-  _dictionary.reset(new SqliteWordWeightDictionary(dictPath));
+  // a memory mapped index loads with no startup cost and its pages are shared between all
+  // processes on the host, so prefer one when it is available. It can be named directly through
+  // the dictionary config option or dropped next to the sqlite dictionary.
+  if (dictPath.endsWith(".mwi"))
+  {
+    _dictionary.reset(new MappedWordWeightDictionary(dictPath));
+  }
+  else if (QFile::exists(dictPath + ".mwi"))
+  {
+    LOG_DEBUG("Using mapped word count index: " << dictPath << ".mwi");
+    _dictionary.reset(new MappedWordWeightDictionary(dictPath + ".mwi"));
+  }
+  else
+  {
+    _dictionary.reset(new SqliteWordWeightDictionary(dictPath));
+  }
   _d.reset(new LevenshteinDistance(1.5));
   setConfiguration(conf());
 }
@@ -87,11 +104,11 @@ WeightedWordDistance::WeightedWordDistance()
 vector<double> WeightedWordDistance::_calculateWeights(QStringList l) const
 {
   vector<double> result;
-  result.resize(l.size());
+  _dictionary->getWeights(l, result);
 
   for (int i = 0; i < l.size(); i++)
   {
-    double w = pow(_dictionary->getWeight(l[i]), _p);
+    double w = pow(result[i], _p);
     // if there is no evidence of the word then just set the value to the heighest weight.
     if (w == 0)
     {
@@ -30,6 +30,10 @@
 
 // Qt
 #include <QString>
+#include <QStringList>
+
+// Standard
+#include <vector>
 
 // Tgs
 #include <tgs/SharedPtr.h>
@@ -60,6 +64,20 @@ public:
    * @return The weight of a given word. If the word isn't found 0 is returned.
    */
   virtual double getWeight(const QString& word) const = 0;
+
+  /**
+   * Looks up the weights for a whole word list in one call; result is resized to match words.
+   * The default implementation loops over getWeight. Implementations can override this when a
+   * batch can be answered more cheaply than the individual lookups.
+   */
+  virtual void getWeights(const QStringList& words, std::vector<double>& result) const
+  {
+    result.resize(words.size());
+    for (int i = 0; i < words.size(); i++)
+    {
+      result[i] = getWeight(words[i]);
+    }
+  }
 };
 
 typedef boost::shared_ptr<WordWeightDictionary> WordWeightDictionaryPtr;
@@ -38,6 +38,8 @@
 #include <hoot/core/io/OsmPbfReader.h>
 #include <hoot/core/io/OsmPbfWriter.h>
 #include <hoot/core/util/ConfPath.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/ContentAddressedCache.h>
 #include <hoot/core/util/Progress.h>
 #include <hoot/core/util/Settings.h>
 #include <hoot/core/OsmMap.h>
@@ -108,6 +110,36 @@ Envelope BaseCommand::parseEnvelope(QString envStr) const
   return Envelope(left, right, bottom, top);
 }
 
+bool BaseCommand::_fetchCachedResult(QStringList inputs, QString output, QStringList settingsKeys)
+{
+  _cacheKey.clear();
+
+  ContentAddressedCache cache(ConfigOptions().getCommandCacheDir());
+  if (cache.isEnabled() == false)
+  {
+    return false;
+  }
+
+  const QString key = cache.calculateKey(getName(), inputs, settingsKeys);
+  if (key.isEmpty())
+  {
+    return false;
+  }
+  _cacheKey = key;
+
+  return cache.fetch(key, output);
+}
+
+void BaseCommand::_storeCachedResult(QString output)
+{
+  if (_cacheKey.isEmpty())
+  {
+    return;
+  }
+
+  ContentAddressedCache(ConfigOptions().getCommandCacheDir()).store(_cacheKey, output);
+}
+
 int BaseCommand::run(char* argv[], int argc)
 {
   QStringList args = toQStringList(argv, argc);
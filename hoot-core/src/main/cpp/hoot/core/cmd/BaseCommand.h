@@ -79,6 +79,30 @@ public:
 protected:
   virtual QString _getHelpPath() const;
 
+  /**
+   * If command.cache.dir is set and a cached result exists for the given inputs and
+   * configuration, copies it to output and returns true; the command should then return without
+   * doing any work. Commands opt in by bracketing their work with _fetchCachedResult and
+   * _storeCachedResult.
+   *
+   * @param inputs The input files the output is derived from. If any input isn't a regular file
+   *  (e.g. a database URL) caching is silently skipped.
+   * @param settingsKeys The configuration keys the output depends on. If empty the entire
+   *  configuration is hashed, which is always correct but invalidates entries on any
+   *  configuration change.
+   */
+  bool _fetchCachedResult(QStringList inputs, QString output,
+    QStringList settingsKeys = QStringList());
+
+  /**
+   * Stores the output written by this run under the key calculated by the preceding
+   * _fetchCachedResult call. A no-op if caching is disabled or was skipped.
+   */
+  void _storeCachedResult(QString output);
+
+private:
+  QString _cacheKey;
+
 };
 
 typedef boost::shared_ptr<BaseCommand> BaseCommandPtr;
@@ -30,14 +30,16 @@
 #include <hoot/core/util/MapProjector.h>
 #include <hoot/core/cmd/BaseCommand.h>
 #include <hoot/core/ops/MergeNearbyNodes.h>
-#include <hoot/core/io/PbfElementIterator.h>
+#include <hoot/core/io/ElementMergeInputStream.h>
+#include <hoot/core/io/ElementOutputStream.h>
+#include <hoot/core/io/OsmPbfReader.h>
 #include <hoot/core/io/OsmPbfWriter.h>
 #include <hoot/core/util/Settings.h>
 #include <hoot/core/util/Log.h>
 
 // Standard
-#include <fstream>
-#include <limits>
+#include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -69,110 +71,30 @@ public:
       throw HootException("The output must be .osm.pbf.");
     }
 
-    OsmPbfWriter writer;
-    ofstream fp;
-    fp.open(output.toUtf8().data(), ios::out | ios::binary);
-    if (fp.is_open() == false)
+    // a single k-way merge pass; the merge stream keeps the output sorted and remaps any id
+    // conflicts between inputs as it goes, so no pre-scan of the inputs is needed.
+    vector<ElementInputStreamPtr> inputs;
+    for (int i = 1; i < args.size(); i++)
     {
-      throw HootException("Error opening " + output + " for writing.");
+      boost::shared_ptr<OsmPbfReader> reader(new OsmPbfReader(true));
+      reader->open(args[i]);
+      reader->initializePartial();
+      inputs.push_back(reader);
     }
-    writer.initializePartial(&fp);
+    ElementMergeInputStream merged(inputs);
 
-    int nodeCount = 0;
-    int wayCount = 0;
-    int relationCount = 0;
+    OsmPbfWriter writer;
+    writer.open(output);
+    writer.initializePartial();
 
-    vector<long> minNode(args.size() - 1);
-    vector<long> maxNode(args.size() - 1);
-    vector<long> minWay(args.size() - 1);
-    vector<long> maxWay(args.size() - 1);
-    vector<long> minRelation(args.size() - 1);
-    vector<long> maxRelation(args.size() - 1);
+    ElementOutputStream::writeAllElements(merged, writer);
 
-    for (int i = 1; i < args.size(); i++)
+    for (size_t i = 0; i < inputs.size(); i++)
     {
-      QString input = args[i];
-
-      minNode[i - 1] = numeric_limits<long>::max();
-      maxNode[i - 1] = -numeric_limits<long>::max();
-      minWay[i - 1] = numeric_limits<long>::max();
-      maxWay[i - 1] = -numeric_limits<long>::max();
-      minRelation[i - 1] = numeric_limits<long>::max();
-      maxRelation[i - 1] = -numeric_limits<long>::max();
-
-      PbfElementIterator it(input);
-      while (it.hasNext())
-      {
-        boost::shared_ptr<Element> e = it.next();
-        WayPtr w = boost::dynamic_pointer_cast<Way>(e);
-        NodePtr n = boost::dynamic_pointer_cast<Node>(e);
-        RelationPtr r = boost::dynamic_pointer_cast<Relation>(e);
-        if (w != 0)
-        {
-          minWay[i - 1] = min(w->getId(), minWay[i - 1]);
-          maxWay[i - 1] = max(w->getId(), maxWay[i - 1]);
-        }
-        else if (n != 0)
-        {
-          minNode[i - 1] = min(n->getId(), minNode[i - 1]);
-          maxNode[i - 1] = max(n->getId(), maxNode[i - 1]);
-        }
-        else if (r != 0)
-        {
-          minRelation[i - 1] = min(r->getId(), minRelation[i - 1]);
-          maxRelation[i - 1] = max(r->getId(), maxRelation[i - 1]);
-        }
-        else
-        {
-          throw HootException("Unexpected element type.");
-        }
-      }
+      inputs[i]->close();
     }
-
-    int topNode = -1;
-    int topWay = -1;
-    int topRelation = -1;
-    for (int i = 1; i < args.size(); i++)
-    {
-      QString input = args[i];
-
-      writer.setIdDelta(topNode - maxNode[i - 1], topWay - maxWay[i - 1],
-                        topRelation - maxRelation[i - 1]);
-
-      topNode -= maxNode[i - 1] - minNode[i - 1] + 1;
-      topWay -= maxWay[i - 1] - minWay[i - 1] + 1;
-      topRelation -= maxRelation[i - 1] - minRelation[i - 1] + 1;
-
-      PbfElementIterator it(input);
-      while (it.hasNext())
-      {
-        boost::shared_ptr<Element> e = it.next();
-        WayPtr w = boost::dynamic_pointer_cast<Way>(e);
-        NodePtr n = boost::dynamic_pointer_cast<Node>(e);
-        RelationPtr r = boost::dynamic_pointer_cast<Relation>(e);
-        if (w != 0)
-        {
-          writer.writePartial(w);
-          wayCount++;
-        }
-        else if (n != 0)
-        {
-          writer.writePartial(n);
-          nodeCount++;
-        }
-        else if (r != 0)
-        {
-          writer.writePartial(r);
-          relationCount++;
-        }
-        else
-        {
-          throw HootException("Unexpected element type.");
-        }
-      }
-    }
-
     writer.finalizePartial();
+    writer.close();
 
     LOG_INFO("Done writing file.");
 
@@ -70,6 +70,11 @@ public:
       throw HootException(QString("%1 takes two parameters.").arg(getName()));
     }
 
+    if (_fetchCachedResult(QStringList(args[0]), args[1]))
+    {
+      return 0;
+    }
+
     OsmMapPtr map(new OsmMap());
     loadMap(map, args[0], true, Status::Unknown1);
 
@@ -79,6 +84,8 @@ public:
 
     saveMap(map, args[1]);
 
+    _storeCachedResult(args[1]);
+
     return 0;
   }
 };
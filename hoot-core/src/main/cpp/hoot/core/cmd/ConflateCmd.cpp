@@ -38,7 +38,11 @@
 #include <hoot/core/conflate/StatsComposer.h>
 #include <hoot/core/conflate/UnifyingConflator.h>
 #include <hoot/core/filters/StatusCriterion.h>
+#include <hoot/core/filters/TagKeyCriterion.h>
+#include <hoot/core/io/ChangesetDeriver.h>
+#include <hoot/core/io/ElementSorter.h>
 #include <hoot/core/io/MapStatsWriter.h>
+#include <hoot/core/io/OsmXmlChangesetFileWriter.h>
 #include <hoot/core/ops/BuildingOutlineUpdateOp.h>
 #include <hoot/core/ops/CalculateStatsOp.h>
 #include <hoot/core/ops/NamedOp.h>
@@ -46,7 +50,11 @@
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/io/OsmMapWriterFactory.h>
 #include <hoot/core/io/OsmXmlWriter.h>
+#include <hoot/core/visitors/CalculateHashVisitor2.h>
+#include <hoot/core/visitors/RemoveElementsVisitor.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/util/MetadataTags.h>
+#include <hoot/core/util/Profiler.h>
 
 // Standard
 #include <fstream>
@@ -74,6 +82,28 @@ void ConflateCmd::printStats(const QList<SingleStat>& stats)
   }
 }
 
+void ConflateCmd::_writeDifferential(ConstOsmMapPtr baseline, OsmMapPtr result, QString output)
+{
+  LOG_INFO("Writing changes relative to input 1 to " << output.right(50) << "...");
+
+  // review relations don't belong in a changeset (see DeriveChangesetCmd).
+  boost::shared_ptr<TagKeyCriterion> reviewCrit(
+    new TagKeyCriterion(MetadataTags::HootReviewNeeds()));
+  RemoveElementsVisitor removeReviewsVis(reviewCrit);
+  removeReviewsVis.setRecursive(false);
+  result->visitRw(removeReviewsVis);
+
+  // the baseline was hashed before conflation; hash the result side so unchanged elements
+  // compare equal by hash.
+  CalculateHashVisitor2 hashVis;
+  result->visitRw(hashVis);
+
+  ElementSorterPtr sorted1(new ElementSorter(baseline));
+  ElementSorterPtr sorted2(new ElementSorter(result));
+  ChangesetDeriverPtr delta(new ChangesetDeriver(sorted1, sorted2));
+  OsmXmlChangesetFileWriter().write(output, delta);
+}
+
 int ConflateCmd::runSimple(QStringList args)
 {
   Timer totalTime;
@@ -127,13 +157,32 @@ int ConflateCmd::runSimple(QStringList args)
   LOG_VART(bytesRead);
   QList< QList<SingleStat> > allStats;
 
+  // With a .osc output only the changes relative to input 1 are written, rather than the whole
+  // conflated map. Downstream consumers then apply a delta instead of re-ingesting data that
+  // didn't change.
+  const bool differentialOutput = output.endsWith(".osc");
+  ConstOsmMapPtr baseline;
+
   // read input 1
   OsmMapPtr map(new OsmMap());
-  loadMap(map, input1, ConfigOptions().getReaderConflateUseDataSourceIds1(), Status::Unknown1);
-  // read input 2
-  if (!input2.isEmpty())
   {
-    loadMap(map, input2, ConfigOptions().getReaderConflateUseDataSourceIds2(), Status::Unknown2);
+    ProfileScope profile("read inputs");
+    loadMap(map, input1, ConfigOptions().getReaderConflateUseDataSourceIds1(), Status::Unknown1);
+    if (differentialOutput)
+    {
+      // Hash the elements now so the unchanged ones compare by hash during changeset derivation,
+      // then deep copy input 1 before anything mutates it. A copy-on-write snapshot would be
+      // cheaper, but the cleaning ops mutate elements found by iterating the map containers,
+      // which forces a full detach anyway; take the deep copy up front instead.
+      CalculateHashVisitor2 hashVis;
+      map->visitRw(hashVis);
+      baseline = OsmMapPtr(new OsmMap(map));
+    }
+    // read input 2
+    if (!input2.isEmpty())
+    {
+      loadMap(map, input2, ConfigOptions().getReaderConflateUseDataSourceIds2(), Status::Unknown2);
+    }
   }
   double inputBytes = IoSingleStat(IoSingleStat::RChar).value - bytesRead;
   LOG_VART(inputBytes);
@@ -165,7 +214,10 @@ int ConflateCmd::runSimple(QStringList args)
   stats.append(SingleStat("Initial Element Count", initialElementCount));
 
   LOG_INFO("Applying pre-conflation operations...");
-  NamedOp(ConfigOptions().getConflatePreOps()).apply(map);
+  {
+    ProfileScope profile("pre conflate ops");
+    NamedOp(ConfigOptions().getConflatePreOps()).apply(map);
+  }
 
   stats.append(SingleStat("Apply Named Ops Time (sec)", t.getElapsedAndRestart()));
 
@@ -183,6 +235,7 @@ int ConflateCmd::runSimple(QStringList args)
 
   {
     // call new conflation routine
+    ProfileScope profile("conflate");
     UnifyingConflator conflator;
     conflator.apply(result);
     stats.append(conflator.getStats());
@@ -191,12 +244,25 @@ int ConflateCmd::runSimple(QStringList args)
 
   // Apply any user specified operations.
   LOG_INFO("Applying post-conflation operations...");
-  NamedOp(ConfigOptions().getConflatePostOps()).apply(result);
+  {
+    ProfileScope profile("post conflate ops");
+    NamedOp(ConfigOptions().getConflatePostOps()).apply(result);
+  }
 
   MapProjector::projectToWgs84(result);
   stats.append(SingleStat("Project to WGS84 Time (sec)", t.getElapsedAndRestart()));
 
-  saveMap(result, output);
+  {
+    ProfileScope profile("write output");
+    if (differentialOutput)
+    {
+      _writeDifferential(baseline, result, output);
+    }
+    else
+    {
+      saveMap(result, output);
+    }
+  }
   double timingOutput = t.getElapsedAndRestart();
 
   if (displayStats)
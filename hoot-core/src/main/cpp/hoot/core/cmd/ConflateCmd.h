@@ -29,6 +29,7 @@
 #define CONFLATECMD_H
 
 // Hoot
+#include <hoot/core/OsmMap.h>
 #include <hoot/core/cmd/BaseCommand.h>
 
 // Standard
@@ -53,6 +54,14 @@ public:
   void printStats(const QList<SingleStat>& stats);
 
   virtual int runSimple(QStringList args);
+
+private:
+
+  /**
+   * Derives a changeset between the pre-conflation baseline and the conflated result and writes
+   * it to output instead of the whole map. Used when the output path ends in .osc.
+   */
+  void _writeDifferential(ConstOsmMapPtr baseline, OsmMapPtr result, QString output);
 };
 
 }
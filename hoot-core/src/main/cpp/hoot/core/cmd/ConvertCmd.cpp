@@ -126,6 +126,13 @@ public:
     conf().set(ConfigOptions().getReaderUseFileStatusKey(), true);
     conf().set(ConfigOptions().getReaderKeepFileStatusKey(), true);
 
+    // If nothing about the input or the configuration changed since a previous run, reuse its
+    // output. The ops are free to read any configuration so the whole configuration is hashed.
+    if (_fetchCachedResult(QStringList(args[0]), args[1]))
+    {
+      return 0;
+    }
+
     QString writerName = ConfigOptions().getOsmMapWriterFactoryWriter();
     if (writerName.trimmed().isEmpty())
     {
@@ -153,6 +160,8 @@ public:
       saveMap(map, args[1]);
     }
 
+    _storeCachedResult(args[1]);
+
     LOG_DEBUG("Convert operation complete.");
     QString msg = "Convert operation took ";
     const qint64 timeElapsed = timer.elapsed();
@@ -0,0 +1,382 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/cmd/BaseCommand.h>
+#include <hoot/core/schema/OsmSchema.h>
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/Settings.h>
+
+// Qt
+#include <QFile>
+
+// Standard
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+
+volatile sig_atomic_t shutdownRequested = 0;
+
+void handleShutdownSignal(int)
+{
+  shutdownRequested = 1;
+}
+
+/**
+ * Resolves and runs a command the same way main() does, reusing the warm factory registrations
+ * and schema this process forked with.
+ */
+int dispatchJob(const QStringList& args)
+{
+  if (args.empty())
+  {
+    cerr << "Empty command received." << endl;
+    return -1;
+  }
+
+  vector<string> cmds = Factory::getInstance().getObjectNamesByBase(Command::className());
+  boost::shared_ptr<Command> c;
+  for (size_t i = 0; i < cmds.size(); i++)
+  {
+    c.reset(Factory::getInstance().constructObject<Command>(cmds[i]));
+    QString argName = c->getName();
+    if (args[0] == argName || args[0] == argName.prepend("--"))
+    {
+      break;
+    }
+    else
+    {
+      c.reset();
+    }
+  }
+
+  if (c == 0)
+  {
+    cerr << "Unknown command: " << args[0].toStdString() << endl;
+    return -1;
+  }
+
+  // synthesize the argv main() would have seen so run() applies the usual common argument
+  // handling (e.g. -D and --conf).
+  vector<QByteArray> storage;
+  storage.push_back(QByteArray("hoot"));
+  for (int i = 0; i < args.size(); i++)
+  {
+    storage.push_back(args[i].toUtf8());
+  }
+  vector<char*> argv;
+  for (size_t i = 0; i < storage.size(); i++)
+  {
+    argv.push_back(storage[i].data());
+  }
+
+  try
+  {
+    return c->run(&argv[0], (int)argv.size());
+  }
+  catch (const std::exception& e)
+  {
+    cerr << "Error running " << c->getName().toStdString() << ":" << endl;
+    cerr << e.what() << endl;
+    return -1;
+  }
+}
+
+/**
+ * Handles one accepted connection in a freshly forked job process. Reads the NUL separated
+ * argument list, redirects stdout/stderr to the socket, runs the command and reports the exit
+ * status on a trailing line. Never returns.
+ */
+void runJobChild(int conn)
+{
+  QByteArray data;
+  char buffer[4096];
+  bool terminated = false;
+  while (!terminated)
+  {
+    ssize_t n = read(conn, buffer, sizeof(buffer));
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      _exit(-1);
+    }
+    if (n == 0)
+    {
+      break;
+    }
+    data.append(buffer, n);
+    // an empty argument (double NUL) ends the request without requiring the client to shut down
+    // its write side.
+    if (data.size() >= 2 && data.at(data.size() - 1) == '\0' && data.at(data.size() - 2) == '\0')
+    {
+      terminated = true;
+    }
+  }
+
+  QStringList args;
+  foreach (const QByteArray& arg, data.split('\0'))
+  {
+    if (!arg.isEmpty())
+    {
+      args.append(QString::fromUtf8(arg));
+    }
+  }
+
+  // the client sees the job's output interleaved exactly as a direct run would print it.
+  dup2(conn, STDOUT_FILENO);
+  dup2(conn, STDERR_FILENO);
+
+  int status = dispatchJob(args);
+
+  cout.flush();
+  cerr.flush();
+  char trailer[64];
+  int len = snprintf(trailer, sizeof(trailer), "\nHOOT_DAEMON_EXIT: %d\n", status);
+  ssize_t ignored = write(conn, trailer, len);
+  (void)ignored;
+  close(conn);
+
+  // don't run the parent's exit handlers.
+  _exit(status);
+}
+
+/**
+ * The accept loop run by each pre-forked worker. One job at a time per worker keeps the pool
+ * size the concurrency cap; the per-job fork gives each job a private copy of the globals
+ * (Settings, caches) so jobs can't leak state into each other.
+ */
+void runWorker(int listenFd)
+{
+  while (shutdownRequested == 0)
+  {
+    int conn = accept(listenFd, 0, 0);
+    if (conn < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      runJobChild(conn);
+    }
+    else if (pid < 0)
+    {
+      const char* msg = "Fork failed; the daemon is out of resources.\nHOOT_DAEMON_EXIT: -1\n";
+      ssize_t ignored = write(conn, msg, strlen(msg));
+      (void)ignored;
+    }
+    close(conn);
+    if (pid > 0)
+    {
+      int status;
+      waitpid(pid, &status, 0);
+    }
+  }
+  _exit(0);
+}
+
+}
+
+/**
+ * @ingroup cmd
+ * @page DaemonCmd Daemon Command
+ * @code
+--daemon (socket path) [worker count]
+ * @endcode
+ *
+ * The daemon command starts a warm worker pool that runs hoot commands submitted over a local
+ * socket. The expensive per process startup (Qt/GDAL/GEOS initialization, schema load, factory
+ * registration) is paid once by the daemon; each job runs in a process forked from the warm
+ * pool, so small jobs start in tens of milliseconds instead of seconds while keeping full per
+ * job isolation.
+ *
+ * A request is the command name followed by its arguments, NUL separated and terminated by an
+ * empty argument (double NUL). The response is the job's stdout and stderr followed by a final
+ * line of the form "HOOT_DAEMON_EXIT: (status)". The daemon runs until it receives SIGTERM or
+ * SIGINT.
+ *
+ * @param socket path The unix domain socket to listen on. An existing socket file at this path
+ *  is replaced.
+ * @param worker count The number of pre-forked workers, which is also the maximum number of
+ *  concurrent jobs. Defaults to 4.
+ */
+class DaemonCmd : public BaseCommand
+{
+public:
+
+  static string className() { return "hoot::DaemonCmd"; }
+
+  DaemonCmd() { }
+
+  virtual QString getName() const { return "daemon"; }
+
+  virtual int runSimple(QStringList args)
+  {
+    if (args.size() < 1 || args.size() > 2)
+    {
+      cout << getHelp() << endl << endl;
+      throw HootException(QString("%1 takes one or two parameters.").arg(getName()));
+    }
+
+    const QString socketPath = args[0];
+    int workerCount = 4;
+    if (args.size() == 2)
+    {
+      bool ok;
+      workerCount = args[1].toInt(&ok);
+      if (!ok || workerCount < 1)
+      {
+        throw HootException("Expected a positive integer for the worker count, got: " + args[1]);
+      }
+    }
+
+    // touch the schema before forking so every worker inherits it already loaded, copy on write.
+    OsmSchema::getInstance();
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+    {
+      throw HootException(QString("Error creating socket: %1").arg(strerror(errno)));
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    QByteArray pathBytes = socketPath.toUtf8();
+    if (pathBytes.size() >= (int)sizeof(address.sun_path))
+    {
+      close(listenFd);
+      throw HootException("The socket path is too long: " + socketPath);
+    }
+    strncpy(address.sun_path, pathBytes.constData(), sizeof(address.sun_path) - 1);
+
+    QFile::remove(socketPath);
+    if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+        listen(listenFd, workerCount * 2) < 0)
+    {
+      close(listenFd);
+      throw HootException(
+        QString("Error listening on %1: %2").arg(socketPath).arg(strerror(errno)));
+    }
+
+    // install before forking so the workers inherit the handler and wind down on SIGTERM too.
+    signal(SIGTERM, handleShutdownSignal);
+    signal(SIGINT, handleShutdownSignal);
+    // a client disconnecting mid-job shouldn't take down the job's process.
+    signal(SIGPIPE, SIG_IGN);
+
+    std::set<pid_t> workers;
+    for (int i = 0; i < workerCount; i++)
+    {
+      workers.insert(_spawnWorker(listenFd));
+    }
+    LOG_INFO(
+      "Daemon listening on " << socketPath << " with " << workerCount << " warm workers.");
+
+    // keep the pool at full strength until shutdown is requested.
+    while (shutdownRequested == 0)
+    {
+      int status;
+      pid_t pid = waitpid(-1, &status, 0);
+      if (pid < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        break;
+      }
+      workers.erase(pid);
+      if (shutdownRequested == 0)
+      {
+        LOG_WARN("Worker " << pid << " exited unexpectedly; replacing it.");
+        workers.insert(_spawnWorker(listenFd));
+      }
+    }
+
+    LOG_INFO("Shutting down daemon...");
+    for (std::set<pid_t>::const_iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+      kill(*it, SIGTERM);
+    }
+    for (std::set<pid_t>::const_iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+      int status;
+      waitpid(*it, &status, 0);
+    }
+    close(listenFd);
+    QFile::remove(socketPath);
+
+    return 0;
+  }
+
+private:
+
+  pid_t _spawnWorker(int listenFd)
+  {
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      runWorker(listenFd);
+    }
+    else if (pid < 0)
+    {
+      throw HootException(QString("Error forking worker: %1").arg(strerror(errno)));
+    }
+    return pid;
+  }
+};
+
+HOOT_FACTORY_REGISTER(Command, DaemonCmd)
+
+}
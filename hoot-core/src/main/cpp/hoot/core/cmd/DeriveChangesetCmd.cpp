@@ -141,7 +141,8 @@ private:
     map1->visitRw(removeElementsVisitor);
     map2->visitRw(removeElementsVisitor);
 
-    //node comparisons require hashes be present on the elements
+    //node comparisons require hashes be present on the elements and ways/relations use them to
+    //skip the full comparison for unchanged elements
     CalculateHashVisitor2 hashVis;
     map1->visitRw(hashVis);
     map2->visitRw(hashVis);
@@ -30,7 +30,13 @@
 #include <hoot/core/util/MapProjector.h>
 #include <hoot/core/cmd/BaseCommand.h>
 #include <hoot/core/ops/NamedOp.h>
+#include <hoot/core/io/ElementOutputStream.h>
 #include <hoot/core/io/OgrReader.h>
+#include <hoot/core/io/OsmMapWriterFactory.h>
+#include <hoot/core/io/ParallelOgrInputStream.h>
+#include <hoot/core/io/PartialOsmMapWriter.h>
+#include <hoot/core/io/ScriptTranslator.h>
+#include <hoot/core/io/ScriptTranslatorFactory.h>
 #include <hoot/core/util/Settings.h>
 #include <hoot/core/util/Progress.h>
 #include <hoot/core/visitors/SplitLongLinearWaysVisitor.h>
@@ -81,6 +87,17 @@ public:
     QString translation = args[a++];
     QString output = args[a++];
 
+    // When the output format accepts a stream of elements and no ogr2osm.ops are configured
+    // (the ops run against a planar projection of the assembled map), stream each translated
+    // feature straight from the reader to the writer. Memory use is then bounded by the
+    // element queue rather than the input size, so arbitrarily large multi-layer sources
+    // import without pre-splitting.
+    if (ConfigOptions().getOgr2osmOps().join("").trimmed().isEmpty() &&
+        OsmMapWriterFactory::getInstance().hasElementOutputStream(output))
+    {
+      return _runStreaming(translation, output, limit, args.mid(a));
+    }
+
     OsmMapPtr map(new OsmMap());
     OgrReader reader;
     reader.setLimit(limit);
@@ -201,6 +218,117 @@ private:
   //this should be static, but there's no header file
   unsigned int _logWarnCount;
 
+  int _runStreaming(QString translation, QString output, long limit, QStringList inputs)
+  {
+    boost::shared_ptr<OsmMapWriter> writer =
+      OsmMapWriterFactory::getInstance().createWriter(output);
+    writer->open(output);
+    boost::shared_ptr<ElementOutputStream> streamWriter =
+      boost::dynamic_pointer_cast<ElementOutputStream>(writer);
+    boost::shared_ptr<PartialOsmMapWriter> partialWriter =
+      boost::dynamic_pointer_cast<PartialOsmMapWriter>(writer);
+    if (partialWriter.get())
+    {
+      partialWriter->initializePartial();
+    }
+
+    // used only to enumerate layers; each layer gets its own reader below.
+    OgrReader layerNameReader;
+
+    vector<ParallelOgrInputStream::Layer> jobs;
+    for (int i = 0; i < inputs.size(); i++)
+    {
+      QString input = inputs[i];
+
+      if (input == "")
+      {
+        LOG_WARN("Got an empty layer, skipping.");
+        continue;
+      }
+
+      QStringList layers;
+      if (input.contains(";"))
+      {
+        QStringList list = input.split(";");
+        input = list.at(0);
+        layers.append(list.at(1));
+      }
+      else
+      {
+        layers = layerNameReader.getFilteredLayerNames(input);
+        layers.sort();
+      }
+
+      if (layers.size() == 0)
+      {
+        if (_logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN("Could not find any valid layers to read from in " + input + ".");
+        }
+        else if (_logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN(typeid(this).name() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+        }
+        _logWarnCount++;
+      }
+
+      for (int j = 0; j < layers.size(); j++)
+      {
+        jobs.push_back(ParallelOgrInputStream::Layer(input, layers[j]));
+      }
+    }
+
+    int threads = ConfigOptions().getOgrReaderThreads();
+    if (threads > 1)
+    {
+      // the workers each run their own translator instance, so the translation must be safe to
+      // run concurrently. The script engines aren't; the .rules translator is.
+      ScriptTranslatorPtr translator(
+        ScriptTranslatorFactory::getInstance().createTranslator(translation));
+      if (translator->isThreadSafe() == false)
+      {
+        LOG_WARN("ogr.reader.threads is " << threads << ", but the translation isn't thread "
+          "safe. Reading layers serially.");
+        threads = 1;
+      }
+    }
+
+    if (threads > 1)
+    {
+      ParallelOgrInputStream stream(jobs, translation, threads);
+      stream.setLimit(limit);
+      ElementOutputStream::writeAllElements(stream, *streamWriter);
+      stream.close();
+    }
+    else
+    {
+      for (size_t j = 0; j < jobs.size(); j++)
+      {
+        LOG_INFO("Streaming: " + jobs[j].path + " " + jobs[j].name);
+
+        OgrReader reader;
+        reader.setLimit(limit);
+        reader.setTranslationFile(translation);
+        reader.open(jobs[j].path, jobs[j].name);
+        reader.initializePartial();
+
+        // with element.stream.async enabled this runs the reader on a producer thread with a
+        // bounded queue, so the writer applies backpressure rather than buffering.
+        ElementOutputStream::writeAllElements(reader, *streamWriter);
+
+        reader.finalizePartial();
+        reader.close();
+      }
+    }
+
+    if (partialWriter.get())
+    {
+      partialWriter->finalizePartial();
+    }
+
+    return 0;
+  }
+
 };
 
 HOOT_FACTORY_REGISTER(Command, Ogr2OsmCmd)
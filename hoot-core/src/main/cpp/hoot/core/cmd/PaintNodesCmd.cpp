@@ -31,6 +31,7 @@
 #include <hoot/core/io/EnvelopeProvider.h>
 #include <hoot/core/io/OsmMapReader.h>
 #include <hoot/core/io/OsmMapReaderFactory.h>
+#include <hoot/core/io/OsmPbfReader.h>
 #include <hoot/core/io/PartialOsmMapReader.h>
 #include <hoot/core/util/GeometryUtils.h>
 
@@ -41,7 +42,11 @@
 #include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
 
 // Qt
+#include <QFileInfo>
 #include <QImage>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 // Standard
 #include <fstream>
@@ -52,6 +57,81 @@ using namespace std;
 namespace hoot
 {
 
+/**
+ * Paints a range of PBF blocks into a private density tile. Each task opens its own stream and
+ * reader, so the tasks share nothing and reduce at the end is a simple sum of tiles.
+ */
+class PaintNodesTask : public QRunnable
+{
+public:
+
+  cv::Mat density;
+  long count;
+  QString error;
+
+  PaintNodesTask(QString path, const vector<OsmPbfReader::BlobLocation>& blobs,
+                 const Envelope& envelope, double pixelSize, int width, int height) :
+    _path(path),
+    _blobs(blobs),
+    _envelope(envelope),
+    _pixelSize(pixelSize),
+    _width(width),
+    _height(height)
+  {
+    density = cv::Mat(cvSize(width, height), CV_32SC1, 0.0);
+    count = 0;
+    // the tasks are owned by calculateDensityParallel.
+    setAutoDelete(false);
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      fstream in(_path.toUtf8().constData(), ios::in | ios::binary);
+      if (in.is_open() == false)
+      {
+        throw HootException("Error opening " + _path + " for reading.");
+      }
+      OsmPbfReader reader(true);
+      reader.setUseDataSourceIds(true);
+
+      OsmMapPtr map(new OsmMap());
+      for (size_t i = 0; i < _blobs.size(); i++)
+      {
+        map->clear();
+        reader.parseBlob(_blobs[i], &in, map);
+
+        const NodeMap& nm = map->getNodes();
+        for (NodeMap::const_iterator it = nm.begin(); it != nm.end(); ++it)
+        {
+          const ConstNodePtr& n = it->second;
+          int px = int((n->getX() - _envelope.getMinX()) / _pixelSize);
+          int py = int((n->getY() - _envelope.getMinY()) / _pixelSize);
+          px = std::min(_width - 1, std::max(0, px));
+          py = std::min(_height - 1, std::max(0, py));
+
+          density.ptr<int32_t>(py)[px] = density.ptr<int32_t>(py)[px] + 1;
+          count++;
+        }
+      }
+    }
+    catch (const std::exception& e)
+    {
+      error = e.what();
+    }
+  }
+
+private:
+
+  QString _path;
+  std::vector<OsmPbfReader::BlobLocation> _blobs;
+  Envelope _envelope;
+  double _pixelSize;
+  int _width;
+  int _height;
+};
+
 class PaintNodesCmd : public BaseCommand
 {
 
@@ -147,6 +227,72 @@ class PaintNodesCmd : public BaseCommand
       return c;
     }
 
+    /**
+     * Same result as calculateDensity, but decodes the PBF blocks with a pool of threads that
+     * each paint a private tile, then sums the tiles. The raster is a commutative sum of node
+     * counts, so the partitioning doesn't change the output.
+     */
+    cv::Mat calculateDensityParallel(Envelope envelope, double pixelSize, QString path)
+    {
+      int width = ceil(envelope.getWidth() / pixelSize);
+      int height = ceil(envelope.getHeight() / pixelSize);
+
+      fstream in(path.toUtf8().constData(), ios::in | ios::binary);
+      if (in.is_open() == false)
+      {
+        throw HootException("Error opening " + path + " for reading.");
+      }
+      OsmPbfReader reader(true);
+      vector<OsmPbfReader::BlobLocation> blobs = reader.loadOsmDataBlobOffsets(in);
+      in.close();
+
+      int threads = QThread::idealThreadCount();
+      LOG_INFO("Painting " << blobs.size() << " blocks with " << threads << " threads.");
+
+      vector< boost::shared_ptr<PaintNodesTask> > tasks;
+      QThreadPool pool;
+      pool.setMaxThreadCount(threads);
+      for (int t = 0; t < threads; t++)
+      {
+        size_t start = blobs.size() * t / threads;
+        size_t end = blobs.size() * (t + 1) / threads;
+        if (start == end)
+        {
+          continue;
+        }
+        vector<OsmPbfReader::BlobLocation> slice(blobs.begin() + start, blobs.begin() + end);
+        boost::shared_ptr<PaintNodesTask> task(
+          new PaintNodesTask(path, slice, envelope, pixelSize, width, height));
+        tasks.push_back(task);
+        pool.start(task.get());
+      }
+      pool.waitForDone();
+
+      cv::Mat c(cvSize(width, height), CV_32SC1, 0.0);
+      long count = 0;
+      for (size_t i = 0; i < tasks.size(); i++)
+      {
+        if (tasks[i]->error.isEmpty() == false)
+        {
+          throw HootException(tasks[i]->error);
+        }
+        for (int py = 0; py < height; py++)
+        {
+          int32_t* row = c.ptr<int32_t>(py);
+          const int32_t* taskRow = tasks[i]->density.ptr<int32_t>(py);
+          for (int px = 0; px < width; px++)
+          {
+            row[px] += taskRow[px];
+          }
+        }
+        count += tasks[i]->count;
+      }
+
+      LOG_VAR(count);
+
+      return c;
+    }
+
     int toColorBand(QString c)
     {
       bool ok;
@@ -228,9 +374,19 @@ class PaintNodesCmd : public BaseCommand
         pixelSize = e.getHeight() / maxSize;
       }
 
-      reader = OsmMapReaderFactory::getInstance().createReader(input, true);
-      reader->open(input);
-      cv::Mat mat = calculateDensity(e, pixelSize, reader);
+      cv::Mat mat;
+      OsmPbfReader pbfProbe;
+      if (pbfProbe.isSupported(input) && QFileInfo(input).isFile())
+      {
+        // PBF blocks decode independently, so paint the planet sized inputs with a thread pool.
+        mat = calculateDensityParallel(e, pixelSize, input);
+      }
+      else
+      {
+        reader = OsmMapReaderFactory::getInstance().createReader(input, true);
+        reader->open(input);
+        mat = calculateDensity(e, pixelSize, reader);
+      }
       Envelope imageEnvelope(e.getMinX(), e.getMinX() + pixelSize * mat.size().width,
                              e.getMinY(), e.getMinY() + pixelSize * mat.size().height);
 
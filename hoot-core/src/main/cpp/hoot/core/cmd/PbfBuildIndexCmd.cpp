@@ -0,0 +1,76 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Hoot
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/cmd/BaseCommand.h>
+#include <hoot/core/io/OsmPbfReader.h>
+
+// Qt
+#include <QFileInfo>
+
+namespace hoot
+{
+
+class PbfBuildIndexCmd : public BaseCommand
+{
+public:
+
+  static std::string className() { return "hoot::PbfBuildIndexCmd"; }
+
+  PbfBuildIndexCmd() {}
+
+  virtual QString getName() const { return "pbf-build-index"; }
+
+  int runSimple(QStringList args)
+  {
+    if (args.size() < 1)
+    {
+      std::cout << getHelp() << std::endl << std::endl;
+      throw HootException(QString("%1 takes at least one parameter.").arg(getName()));
+    }
+
+    for (int i = 0; i < args.size(); i++)
+    {
+      const QString input = args[i];
+      QFileInfo fileInfo(input);
+      if (!fileInfo.exists())
+      {
+        throw HootException("Specified input: " + input + " does not exist.");
+      }
+
+      OsmPbfReader().buildBoundsIndex(input);
+      std::cout << "Wrote " << (input + ".bbidx") << std::endl;
+    }
+
+    return 0;
+  }
+};
+
+HOOT_FACTORY_REGISTER(Command, PbfBuildIndexCmd)
+
+}
@@ -64,11 +64,13 @@ public:
     }
 
     const QString QUICK_SWITCH = "--brief";
+    const QString SAMPLED_SWITCH = "--sampled";
     const QString OUTPUT_SWITCH = "--output=";
 
     QStringList inputs(args);
 
     bool quick = false;
+    bool sampled = false;
     bool toFile = false;
     QString output_filename = "";
     //  Capture any flags and remove them before processing inputs
@@ -86,6 +88,11 @@ public:
         quick = true;
         inputs.removeOne(args[i]);
       }
+      else if (args[i] == SAMPLED_SWITCH)
+      {
+        sampled = true;
+        inputs.removeOne(args[i]);
+      }
     }
 
     QString sep = "\t";
@@ -103,6 +110,12 @@ public:
 
       boost::shared_ptr<CalculateStatsOp> cso(new CalculateStatsOp());
       cso->setQuickSubset(quick);
+      if (sampled)
+      {
+        // approximate stats extrapolated from a reservoir sample; the traversal cost is bounded
+        // by the sample size rather than the map size.
+        cso->setSampleSize(ConfigOptions().getStatsSampleSize());
+      }
       cso->apply(map);
       allStats.append(cso->getStats());
     }
@@ -26,8 +26,8 @@
  */
 
 // geos
+#include <geos/geom/Envelope.h>
 #include <geos/geom/Geometry.h>
-#include <geos/geom/GeometryFactory.h>
 
 // Hoot
 #include <hoot/core/cmd/BaseCommand.h>
@@ -36,6 +36,7 @@
 #include <hoot/core/util/ElementConverter.h>
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/GeometryConverter.h>
+#include <hoot/core/util/GeometryMerger.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MapProjector.h>
 #include <hoot/core/util/Settings.h>
@@ -74,21 +75,24 @@ public:
       loadMap(map, input, false);
     }
 
-    boost::shared_ptr<Geometry> g(GeometryFactory::getDefaultInstance()->createEmptyGeometry());
-    int count = 0;
+    vector< boost::shared_ptr<Geometry> > geometries;
+    Envelope envelope;
     const RelationMap& rm = map->getRelations();
     for (RelationMap::const_iterator it = rm.begin(); it != rm.end(); ++it)
     {
       const ConstRelationPtr r = it->second;
-      g.reset(g->Union(ElementConverter(map).convertToGeometry(r).get()));
-      count++;
+      boost::shared_ptr<Geometry> rg = ElementConverter(map).convertToGeometry(r);
+      envelope.expandToInclude(rg->getEnvelopeInternal());
+      geometries.push_back(rg);
     }
 
-    if (count == 0)
+    if (geometries.size() == 0)
     {
       LOG_INFO("No polygons were found in the input.");
     }
 
+    boost::shared_ptr<Geometry> g = GeometryMerger().mergeGeometries(geometries, envelope);
+
     OsmMapPtr result(new OsmMap());
     GeometryConverter(result).convertGeometryToElement(g.get(), Status::Unknown1, -1);
 
@@ -36,6 +36,7 @@ using namespace boost;
 #include <hoot/core/conflate/MapCleaner.h>
 #include <hoot/core/elements/ElementId.h>
 #include <hoot/core/conflate/SuperfluousWayRemover.h>
+#include <hoot/core/index/OsmMapIndex.h>
 #include <hoot/core/io/OsmXmlWriter.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/FileUtils.h>
@@ -49,6 +50,7 @@ using namespace hoot;
 #include <qdebug.h>
 #include <QDir>
 #include <QTime>
+#include <QtConcurrentMap>
 
 // Standard Includes
 #include <limits>
@@ -63,6 +65,25 @@ using namespace Tgs;
 namespace hoot
 {
 
+/**
+ * Calls updateEstimate against a shared read-only map. Used to refresh the estimates of every
+ * manipulation impacted by a batch concurrently; each manipulation only writes to itself.
+ */
+class EstimateUpdater
+{
+public:
+
+  typedef void result_type;
+
+  EstimateUpdater(ConstOsmMapPtr map) : _map(map) {}
+
+  void operator()(const boost::shared_ptr<Manipulation>& m) const { m->updateEstimate(_map); }
+
+private:
+
+  ConstOsmMapPtr _map;
+};
+
 Conflator::Conflator()
 {
   _debug = false;
@@ -80,6 +101,7 @@ Conflator::Conflator()
 
   _maxIterations = -1;
   _minValidScore = ConfigOptions().getConflatorMinValidScore();
+  _batchSize = ConfigOptions().getConflatorBatchSize();
 }
 
 void Conflator::_applyManipulations()
@@ -114,7 +136,13 @@ void Conflator::_applyManipulations()
 
   LOG_DEBUG("Manipulation heap " << _manipulationHeap.size());
 
-  // go through all the manipulators
+  if (_batchSize > 1)
+  {
+    map = _applyManipulationsBatched(start);
+  }
+
+  // go through all the manipulators; the batched path above has already drained the heap when
+  // conflator.batch.size is greater than one.
   while (_manipulationHeap.size() > 0)
   {
     if (Log::getInstance().isInfoEnabled() && Time::getTime() - lastPrint >= 1.0)
@@ -191,6 +219,125 @@ void Conflator::_applyManipulations()
   _bestMap.reset(new WorkingMap(tmp));
 }
 
+boost::shared_ptr<const WorkingMap> Conflator::_applyManipulationsBatched(
+  boost::shared_ptr<const WorkingMap> start)
+{
+  boost::shared_ptr<const WorkingMap> map = start;
+
+  int iteration = 0;
+  double lastPrint = Time::getTime();
+  QTime t;
+  t.start();
+
+  while (_manipulationHeap.size() > 0)
+  {
+    if (Log::getInstance().isInfoEnabled() && Time::getTime() - lastPrint >= 1.0)
+    {
+      lastPrint = Time::getTime();
+      cout << "Current Score: " << map->getScore() << " it: " << iteration << " remaining: " <<
+              _manipulationHeap.size() << " elapsed: " << t.elapsed() << "ms             \r";
+      cout.flush();
+    }
+
+    // Pop the top scoring valid manipulations whose impacted element ids don't overlap. The pop
+    // order matches the serial loop so the selection is deterministic. A manipulation that
+    // overlaps the batch goes back on the heap afterwards so it sees the updated estimates
+    // before it is applied.
+    vector< boost::shared_ptr<const Manipulation> > batch;
+    vector< boost::shared_ptr<const Manipulation> > bogus;
+    vector<ManipulationHolder> deferred;
+    set<ElementId> footprint;
+    while ((int)batch.size() < _batchSize && _manipulationHeap.size() > 0)
+    {
+      ManipulationHolder mh = _manipulationHeap.top();
+      boost::shared_ptr<const Manipulation> m = mh.m;
+      _manipulationHeap.pop();
+      if (m->getProbabilityEstimate() > _minValidScore &&
+          m->getProbabilityEstimate() == mh.score && m->isValid(map->getMap()))
+      {
+        const set<ElementId>& ids = m->getImpactedElementIds(map->getMap());
+        bool overlaps = false;
+        for (set<ElementId>::const_iterator it = ids.begin();
+             it != ids.end() && overlaps == false; ++it)
+        {
+          overlaps = footprint.count(*it) > 0;
+        }
+        if (overlaps)
+        {
+          deferred.push_back(mh);
+        }
+        else
+        {
+          footprint.insert(ids.begin(), ids.end());
+          batch.push_back(m);
+        }
+      }
+      else if (_createBogusReviewTags && m->getProbabilityEstimate() == mh.score &&
+               m->isValid(map->getMap()))
+      {
+        bogus.push_back(m);
+      }
+    }
+
+    if (batch.size() > 0 || bogus.size() > 0)
+    {
+      set<ElementId> impactedElements;
+      set<ElementId> newElements;
+      double scoreDelta = 0.0;
+
+      OsmMapPtr newMap = map->takeMap();
+      // the batch members touch disjoint sets of elements so the application order within the
+      // batch doesn't change the result.
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+        set<ElementId> impacted;
+        set<ElementId> created;
+        batch[i]->applyManipulation(newMap, impacted, created);
+        impactedElements.insert(impacted.begin(), impacted.end());
+        newElements.insert(created.begin(), created.end());
+        scoreDelta += batch[i]->getScoreEstimate();
+      }
+      for (size_t i = 0; i < bogus.size(); i++)
+      {
+        bogus[i]->addBogusReviewTags(newMap);
+      }
+
+      boost::shared_ptr<WorkingMap> newWm(new WorkingMap(newMap));
+      newWm->setScore(map->getScore() + scoreDelta);
+
+      // one estimate and creation pass covers the whole batch.
+      _updateManipulationEstimates(newMap, impactedElements);
+      _createManipulations(newMap, newElements);
+
+      if (newWm->getScore() > _bestScore)
+      {
+        _bestScore = newWm->getScore();
+        _bestMap = newWm;
+      }
+      else if (bogus.size() > 0)
+      {
+        _bestMap = newWm;
+      }
+
+      map = newWm;
+    }
+
+    for (size_t i = 0; i < deferred.size(); i++)
+    {
+      _manipulationHeap.push(deferred[i]);
+    }
+
+    if (_debug)
+    {
+      _saveMap(QString("/tmp/conflated/conf%1.osm").arg(iteration, 3, 10, QChar('0')));
+    }
+
+    iteration++;
+  }
+
+  return map;
+}
+
 /**
  * Load the source data up into memory for later conflation.
  */
@@ -341,17 +488,39 @@ void Conflator::_updateManipulationEstimates(ConstOsmMapPtr map,
     found.insert(s.begin(), s.end());
   }
 
+  vector< boost::shared_ptr<Manipulation> > valid;
+  vector<double> oldValues;
+  valid.reserve(found.size());
   for (set< boost::shared_ptr<Manipulation> >::iterator it = found.begin(); it != found.end(); ++it)
   {
     boost::shared_ptr<Manipulation> m = *it;
     if (m->isValid(map))
     {
-      double oldValue = m->getProbabilityEstimate();
-      m->updateEstimate(map);
-      if (oldValue != m->getProbabilityEstimate())
-      {
-        _manipulationHeap.push(ManipulationHolder(m, m->getProbabilityEstimate()));
-      }
+      valid.push_back(m);
+      oldValues.push_back(m->getProbabilityEstimate());
+    }
+  }
+
+  if (_batchSize > 1 && valid.size() > 1)
+  {
+    // the map is read-only here and each manipulation only writes to itself, so the estimates
+    // for a batch can be refreshed concurrently.
+    map->getIndex().prepareForConcurrentReads();
+    QtConcurrent::blockingMap(valid.begin(), valid.end(), EstimateUpdater(map));
+  }
+  else
+  {
+    for (size_t i = 0; i < valid.size(); i++)
+    {
+      valid[i]->updateEstimate(map);
+    }
+  }
+
+  for (size_t i = 0; i < valid.size(); i++)
+  {
+    if (oldValues[i] != valid[i]->getProbabilityEstimate())
+    {
+      _manipulationHeap.push(ManipulationHolder(valid[i], valid[i]->getProbabilityEstimate()));
     }
   }
 }
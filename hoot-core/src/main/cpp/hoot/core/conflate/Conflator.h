@@ -169,9 +169,19 @@ protected:
 
   double _minValidScore;
   bool _createBogusReviewTags;
+  int _batchSize;
 
   void _applyManipulations();
 
+  /**
+   * Batched variant of the greedy loop. Each iteration pops the top scoring valid manipulations
+   * whose impacted element ids don't overlap, applies them as one batch and updates the affected
+   * estimates once for the whole batch. Because the batch members touch disjoint elements the
+   * result is the same as applying them one at a time. See conflator.batch.size.
+   */
+  boost::shared_ptr<const WorkingMap> _applyManipulationsBatched(
+    boost::shared_ptr<const WorkingMap> start);
+
   void _createManipulations();
 
   /**
@@ -43,6 +43,7 @@
 #include <hoot/core/util/Log.h>
 
 // Standard
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -88,62 +89,66 @@ void DuplicateWayRemover::apply(OsmMapPtr& map)
       w->setNodes(newNodes);
   }
 
-  OsmSchema& schema = OsmSchema::getInstance();
-  // go through each way
-  for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
+  // Build the candidate pair run in a single pass over the node to way map: every node shared
+  // by k ways contributes its (wayId1, wayId2) pairs with the smaller id first. Sorting groups
+  // the repeats, so a pair's shared node count falls out of its run length and each pair is
+  // compared exactly once - the old per-way sweep revisited the same pairs from both sides and
+  // once per shared node, which went quadratic on imports with stacked duplicate geometry.
+  vector< pair<long, long> > sharedPairs;
+  for (NodeToWayMap::const_iterator nit = n2w.begin(); nit != n2w.end(); ++nit)
   {
-    long key = it->first;
-    const WayPtr& w = it->second;
-    // if the way isn't in the map anymore (deleted as part of this process) or the way is an
-    // area type (different treatment).
-    if (_map->containsWay(key) == false || !schema.isLinear(*w))
+    const set<long>& ways = nit->second;
+    if (ways.size() < 2)
       continue;
-
-    // create a map of all the ways that share nodes with this way and the number of nodes shared
-    std::map<long, int> nodesSharedCount;
-    const vector<long>& nodes = w->getNodeIds();
-    for (size_t i = 0; i < nodes.size(); i++)
+    // the set iterates in ascending id order, so the pairs come out normalized.
+    for (set<long>::const_iterator i = ways.begin(); i != ways.end(); ++i)
     {
-      const set<long>& ways = n2w[nodes[i]];
-      for (set<long>::iterator wit = ways.begin(); wit != ways.end(); ++wit)
-      {
-        if (*wit != w->getId() && _isCandidateWay(w))
-          nodesSharedCount[*wit]++;
-      }
+      set<long>::const_iterator j = i;
+      for (++j; j != ways.end(); ++j)
+        sharedPairs.push_back(pair<long, long>(*i, *j));
     }
+  }
+  sort(sharedPairs.begin(), sharedPairs.end());
+
+  for (size_t i = 0; i < sharedPairs.size(); )
+  {
+    size_t runEnd = i;
+    while (runEnd < sharedPairs.size() && sharedPairs[runEnd] == sharedPairs[i])
+      runEnd++;
+    const int sharedNodes = (int)(runEnd - i);
+    const long id1 = sharedPairs[i].first;
+    const long id2 = sharedPairs[i].second;
+    i = runEnd;
 
-    for (std::map<long, int>::iterator wit = nodesSharedCount.begin();
-      wit != nodesSharedCount.end(); ++wit)
+    // if a pair of ways shares 2 or more nodes. either way may have been removed or rewritten by
+    // an earlier pair.
+    if (sharedNodes >= 2 && _map->containsWay(id1) && _map->containsWay(id2))
     {
-      // if a way shares 2 or more nodes
-      if (wit->second >= 2 && _map->containsWay(wit->first) && _map->containsWay(w->getId()))
+      WayPtr w = _map->getWay(id1);
+      WayPtr w2 = _map->getWay(id2);
+
+      // if both are candidates for de-duping
+      if (_isCandidateWay(w) && _isCandidateWay(w2))
       {
-        // remove duplicates between the ways
-        WayPtr w2 = _map->getWay(wit->first);
+        LOG_TRACE("candidate way tags:");
+        LOG_VART(w->getTags());
+        LOG_VART(w2->getTags());
 
-        // if this is a candidate for de-duping
-        if (_isCandidateWay(w2))
+        bool nonNameTagsIdentical = false;
+        if (_strictTagMatching)
         {
-          LOG_TRACE("candidate way tags:");
-          LOG_VART(w->getTags());
-          LOG_VART(w2->getTags());
-
-          bool nonNameTagsIdentical = false;
-          if (_strictTagMatching)
-          {
-            nonNameTagsIdentical =
-              TagComparator::getInstance().nonNameTagsExactlyMatch(w->getTags(), w2->getTags());
-          }
+          nonNameTagsIdentical =
+            TagComparator::getInstance().nonNameTagsExactlyMatch(w->getTags(), w2->getTags());
+        }
 
-          if (nonNameTagsIdentical || !_strictTagMatching)
-          {
-            LOG_TRACE("Ways have exact non-name tag match or strict tag matching is disabled.");
+        if (nonNameTagsIdentical || !_strictTagMatching)
+        {
+          LOG_TRACE("Ways have exact non-name tag match or strict tag matching is disabled.");
 
-            if (w->getNodeCount() > w2->getNodeCount())
-              _splitDuplicateWays(w, w2);
-            else
-              _splitDuplicateWays(w2, w);
-          }
+          if (w->getNodeCount() > w2->getNodeCount())
+            _splitDuplicateWays(w, w2);
+          else
+            _splitDuplicateWays(w2, w);
         }
       }
     }
@@ -55,6 +55,10 @@
 
 #include "TileBoundsCalculator.h"
 
+// Qt
+#include <QVector>
+#include <QtConcurrentMap>
+
 using namespace geos::geom;
 using namespace std;
 
@@ -145,23 +149,51 @@ void LocalTileWorker::cleanup(QString mapIn, QString mapOut)
 void LocalTileWorker::conflate(const vector<Envelope>& tiles, QString mapIn, QString mapOut)
 {
   _mapPart = 0;
+
+  QVector<TileTask> tasks;
+  tasks.reserve(tiles.size());
   for (size_t i = 0; i < tiles.size(); i++)
   {
-    NodeReplacements replacements;
-    replacements.readDir(mapIn);
-    boost::shared_ptr<OsmMap> map = _readTile(mapIn, tiles[i]);
+    TileTask t;
+    t.worker = this;
+    t.index = (int)i;
+    t.tile = tiles[i];
+    t.mapIn = mapIn;
+    t.mapOut = mapOut;
+    tasks.append(t);
+  }
 
-    if (map->getNodes().size() > 0)
+  // TileConflator guarantees that no two tiles in a pass overlap and each task reads and writes
+  // its own files with preassigned part numbers, so the tasks are independent of each other.
+  if (ConfigOptions().getTileConflateThreads() > 1 && tasks.size() > 1)
+  {
+    QtConcurrent::blockingMap(tasks, &LocalTileWorker::_conflateTile);
+  }
+  else
+  {
+    for (int i = 0; i < tasks.size(); i++)
     {
-      map = _conflate(map, replacements.getReplacements());
-      _storeMapPart(map, mapOut);
-      _writeNodeReplacements(mapOut, i, replacements);
+      _conflateTile(tasks[i]);
     }
   }
 
   _writeTheRest(mapIn, mapOut, tiles);
 }
 
+void LocalTileWorker::_conflateTile(TileTask& task)
+{
+  NodeReplacements replacements;
+  replacements.readDir(task.mapIn);
+  boost::shared_ptr<OsmMap> map = task.worker->_readTile(task.mapIn, task.tile);
+
+  if (map->getNodes().size() > 0)
+  {
+    map = task.worker->_conflate(map, replacements.getReplacements());
+    task.worker->_storeMapPart(map, task.mapOut, task.index);
+    task.worker->_writeNodeReplacements(task.mapOut, task.index, replacements);
+  }
+}
+
 boost::shared_ptr<OsmMap> LocalTileWorker::_conflate(boost::shared_ptr<OsmMap> map,
   HashMap<long, long>& replacements)
 {
@@ -232,10 +264,34 @@ boost::shared_ptr<OsmMap> LocalTileWorker::_readAllParts(QString dir)
 
 boost::shared_ptr<OsmMap> LocalTileWorker::_readTile(QString input, const Envelope& e)
 {
-  boost::shared_ptr<OsmMap> map = _readAllParts(input);
+  // Reading every part into one map before cropping makes the peak footprint the size of the
+  // whole data set rather than the tile. Each part file is self-contained (ways are stored with
+  // their nodes), so cropping after every part keeps the map no larger than the tile plus one
+  // uncropped part.
+  boost::shared_ptr<OsmMap> map(new OsmMap());
+
+  OsmXmlReader reader;
+  reader.setUseDataSourceIds(true);
+  reader.setUseStatusFromFile(true);
+
+  // load the dregs first so the "bad" nodes get overwritten.
+  QString dregs = input + "/Dregs.osm";
+  if (QFileInfo(dregs).exists())
+  {
+    reader.read(dregs, map);
+    OutsideBoundsRemover::removeWays(map, e);
+    map = SuperfluousNodeRemover::removeNodes(map);
+  }
 
-  OutsideBoundsRemover::removeWays(map, e);
-  map = SuperfluousNodeRemover::removeNodes(map);
+  QStringList filters;
+  filters << "Part*.osm";
+  QDir d(input);
+  Q_FOREACH(QFileInfo info, d.entryList(filters, QDir::Files, QDir::Name))
+  {
+    reader.read(d.absoluteFilePath(info.filePath()), map);
+    OutsideBoundsRemover::removeWays(map, e);
+    map = SuperfluousNodeRemover::removeNodes(map);
+  }
 
   return map;
 }
@@ -262,7 +318,12 @@ void LocalTileWorker::rmdir(QString dir)
 
 void LocalTileWorker::_storeMapPart(boost::shared_ptr<OsmMap> map, QString dir)
 {
-  QString fn = dir + QString("/Part%1.osm").arg(_mapPart++, 4, 10, QChar('0'));
+  _storeMapPart(map, dir, _mapPart++);
+}
+
+void LocalTileWorker::_storeMapPart(boost::shared_ptr<OsmMap> map, QString dir, int part)
+{
+  QString fn = dir + QString("/Part%1.osm").arg(part, 4, 10, QChar('0'));
   OsmXmlWriter writer;
   writer.setIncludePointsInWays(true);
   writer.setIncludeHootInfo(true);
@@ -81,8 +81,27 @@ private:
   double _pixelSize;
   QString _in1, _in2;
 
+  /**
+   * One tile's worth of work. The part number is preassigned from the tile index so concurrent
+   * tiles never race on the output file names.
+   */
+  struct TileTask
+  {
+    LocalTileWorker* worker;
+    int index;
+    geos::geom::Envelope tile;
+    QString mapIn;
+    QString mapOut;
+  };
+
   boost::shared_ptr<OsmMap> _conflate(boost::shared_ptr<OsmMap> map, HashMap<long, long>& replacements);
 
+  /**
+   * Reads, conflates and stores a single tile. Safe to call from multiple threads for
+   * non-overlapping tiles. See tile.conflate.threads.
+   */
+  static void _conflateTile(TileTask& task);
+
   /**
    * Read all the part files from the specified directory into a single map.
    */
@@ -106,6 +125,11 @@ private:
    */
   void _storeMapPart(boost::shared_ptr<OsmMap> map, QString dir);
 
+  /**
+   * Stores the specified map under an explicit part number rather than the running counter.
+   */
+  void _storeMapPart(boost::shared_ptr<OsmMap> map, QString dir, int part);
+
   void _writeNodeReplacements(QString dir, size_t i,
     NodeReplacements& replacements);
 
@@ -30,9 +30,22 @@
 // Hoot
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/util/Factory.h>
+#include <hoot/core/io/OsmXmlReader.h>
+#include <hoot/core/io/OsmXmlWriter.h>
 #include <hoot/core/ops/NamedOp.h>
 #include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/MapProjector.h>
+#include <hoot/core/visitors/CalculateHashVisitor.h>
 
+// Qt
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+
+// Standard
+#include <algorithm>
+#include <vector>
 
 namespace hoot
 {
@@ -43,10 +56,87 @@ MapCleaner::MapCleaner()
 {
 }
 
+QString MapCleaner::_calculateCacheKey(const boost::shared_ptr<OsmMap>& map) const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+
+  // a different op chain must never hit an entry built by another chain.
+  hash.addData(ConfigOptions().getMapCleanerTransforms().join(";").toUtf8());
+
+  // element hashes don't include ids or statuses, but conflation depends on both, so they're
+  // mixed in alongside. Ids are sorted since the map containers don't iterate in a guaranteed
+  // order.
+  std::vector<long> ids;
+  for (int type = 0; type < ElementType::Unknown; type++)
+  {
+    const ElementType etype((ElementType::Type)type);
+    ids.clear();
+    switch (type)
+    {
+    case ElementType::Node:
+      for (NodeMap::const_iterator it = map->getNodes().begin(); it != map->getNodes().end();
+           ++it)
+        ids.push_back(it->first);
+      break;
+    case ElementType::Way:
+      for (WayMap::const_iterator it = map->getWays().begin(); it != map->getWays().end(); ++it)
+        ids.push_back(it->first);
+      break;
+    default:
+      for (RelationMap::const_iterator it = map->getRelations().begin();
+           it != map->getRelations().end(); ++it)
+        ids.push_back(it->first);
+      break;
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      ConstElementPtr e = map->getElement(ElementId(etype, ids[i]));
+      hash.addData(QString::number(ids[i]).toUtf8());
+      hash.addData(QString::number(e->getStatus().getEnum()).toUtf8());
+      hash.addData(CalculateHashVisitor::toHash(e));
+    }
+  }
+
+  return QString::fromUtf8(hash.result().toHex());
+}
+
 void MapCleaner::apply(boost::shared_ptr<OsmMap> &map)
 {
-  // Apply any user specified operations.
+  const QString cacheDir = ConfigOptions().getMapCleanerCacheDir();
+  if (cacheDir.isEmpty())
+  {
+    // Apply any user specified operations.
+    NamedOp(ConfigOptions().getMapCleanerTransforms()).apply(map);
+    return;
+  }
+
+  const QString cacheKey = _calculateCacheKey(map);
+  const QString cachePath = cacheDir + "/" + cacheKey + ".osm";
+
+  if (QFile::exists(cachePath))
+  {
+    LOG_INFO("Loading cleaned map from cache: " << cachePath);
+    boost::shared_ptr<OsmMap> cached(new OsmMap());
+    OsmXmlReader reader;
+    reader.setUseDataSourceIds(true);
+    reader.setUseStatusFromFile(true);
+    reader.read(cachePath, cached);
+    map = cached;
+    return;
+  }
+
   NamedOp(ConfigOptions().getMapCleanerTransforms()).apply(map);
+
+  // the cache is stored in WGS84; later stages reproject as they need to, same as they do for a
+  // freshly cleaned map.
+  MapProjector::projectToWgs84(map);
+  QDir().mkpath(cacheDir);
+  OsmXmlWriter writer;
+  writer.setIncludeHootInfo(true);
+  writer.write(map, cachePath);
+  LOG_INFO("Wrote cleaned map to cache: " << cachePath);
 }
 
 }
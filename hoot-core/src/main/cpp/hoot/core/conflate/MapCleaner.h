@@ -40,6 +40,10 @@ namespace hoot
 /**
  * A composite class for cleaning maps and prepping them for conflation. This performs operations
  * like splitting intersections, fixing some common errors, etc.
+ *
+ * When map.cleaner.cache.dir is set, the cleaned result is cached on disk keyed by a content hash
+ * of the input map and the configured transforms; cleaning the same input again loads the cached
+ * map instead of re-running the op chain.
  */
 class MapCleaner : public OsmMapOperation
 {
@@ -54,6 +58,14 @@ public:
   virtual ~MapCleaner() {}
 
   virtual void apply(boost::shared_ptr<OsmMap>& map);
+
+private:
+
+  /**
+   * Calculates a deterministic hash over the map's content (element hashes, ids and statuses)
+   * and the configured cleaning transforms.
+   */
+  QString _calculateCacheKey(const boost::shared_ptr<OsmMap>& map) const;
 };
 
 }
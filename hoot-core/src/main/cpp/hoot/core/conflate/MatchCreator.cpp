@@ -101,6 +101,20 @@ MatchCreator::FeatureCalcType MatchCreator::getFeatureCalcType (BaseFeatureType
   }
 }
 
+void MatchCreator::createMatchesFromPairs(const ConstOsmMapPtr& map,
+  const std::vector< std::pair<ElementId, ElementId> >& pairs,
+  std::vector<const Match*>& matches, ConstMatchThresholdPtr /*threshold*/)
+{
+  for (size_t i = 0; i < pairs.size(); i++)
+  {
+    Match* m = createMatch(map, pairs[i].first, pairs[i].second);
+    if (m)
+    {
+      matches.push_back(m);
+    }
+  }
+}
+
 ElementCriterion* MatchCreator::getElementCriterion (BaseFeatureType t, ConstOsmMapPtr map)
 {
   switch (t)
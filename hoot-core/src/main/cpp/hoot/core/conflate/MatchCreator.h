@@ -29,9 +29,11 @@
 
 // Hoot
 #include <hoot/core/conflate/MatchThreshold.h>
+#include <hoot/core/util/Units.h>
 
 // Standard
 #include <string>
+#include <utility>
 #include <vector>
 
 // QT
@@ -119,6 +121,23 @@ public:
   virtual void createMatches(const ConstOsmMapPtr& map, std::vector<const Match*>& matches,
     ConstMatchThresholdPtr threshold) = 0;
 
+  /**
+   * The search radius in meters used by the shared candidate pair generation stage in
+   * MatchFactory. Creators that return a value greater than zero get a pre-pruned candidate pair
+   * list through createMatchesFromPairs instead of scanning the index themselves; the default of
+   * -1 keeps the creator's own neighbor discovery.
+   */
+  virtual Meters getCandidateSearchRadius() const { return -1.0; }
+
+  /**
+   * Creates matches from a pre-pruned candidate pair list produced by the shared sweep in
+   * MatchFactory. Only called when getCandidateSearchRadius returns a value greater than zero.
+   * The default implementation evaluates each pair with createMatch.
+   */
+  virtual void createMatchesFromPairs(const ConstOsmMapPtr& map,
+    const std::vector< std::pair<ElementId, ElementId> >& pairs,
+    std::vector<const Match*>& matches, ConstMatchThresholdPtr threshold);
+
   /**
    * Generally this just returns the class name of this creator. However, creators that take
    * arguments to specify scripts such as the ScriptMatchCreator may return multiple results.
@@ -28,13 +28,26 @@
 
 // hoot
 #include <hoot/core/util/Factory.h>
+#include <hoot/core/index/OsmMapIndex.h>
+#include <hoot/core/index/SpatialJoin.h>
 #include <hoot/core/ops/Boundable.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/conflate/MatchThreshold.h>
 #include <hoot/core/util/Log.h>
 
 //Qt
+#include <QFuture>
+#include <QList>
 #include <QString>
+#include <QtConcurrentRun>
+
+// Standard
+#include <ctime>
+#include <memory>
+#include <set>
+
+// tgs
+#include <tgs/System/Time.h>
 
 using namespace geos::geom;
 using namespace std;
@@ -70,19 +83,170 @@ Match* MatchFactory::createMatch(const ConstOsmMapPtr& map, ElementId eid1, Elem
 void MatchFactory::createMatches(const ConstOsmMapPtr& map, vector<const Match*>& matches,
   const Envelope& bounds, boost::shared_ptr<const MatchThreshold> threshold) const
 {
+  for (size_t i = 0; i < _creators.size(); ++i)
+  {
+    _checkMatchCreatorBoundable(_creators[i], bounds);
+  }
+
+  _stats.clear();
+
+  // one sweep generates the candidate pairs for every creator that opts in; creators that don't
+  // advertise a radius keep their own neighbor discovery and get an empty list here.
+  vector< vector< pair<ElementId, ElementId> > > pairs = _createCandidatePairs(map);
+
+  if (ConfigOptions().getMatchCreatorThreads() > 1 && _creators.size() > 1)
+  {
+    _createMatchesParallel(map, matches, threshold, pairs);
+    return;
+  }
+
   for (size_t i = 0; i < _creators.size(); ++i)
   {
     boost::shared_ptr<MatchCreator> matchCreator = _creators[i];
-    _checkMatchCreatorBoundable(matchCreator, bounds);
-    if (threshold.get())
+    size_t before = matches.size();
+    double wallStart = Tgs::Time::getTime();
+    clock_t cpuStart = clock();
+    ConstMatchThresholdPtr mt = threshold;
+    if (mt.get() == 0)
+    {
+      mt = matchCreator->getMatchThreshold();
+    }
+    if (matchCreator->getCandidateSearchRadius() > 0)
     {
-      matchCreator->createMatches(map, matches, threshold);
+      matchCreator->createMatchesFromPairs(map, pairs[i], matches, mt);
     }
     else
     {
-      matchCreator->createMatches(map, matches, matchCreator->getMatchThreshold());
+      matchCreator->createMatches(map, matches, mt);
+    }
+    QString name = _creatorName(matchCreator);
+    _stats.append(SingleStat(QString("Find Matches Time (sec) - %1").arg(name),
+      Tgs::Time::getTime() - wallStart));
+    _stats.append(SingleStat(QString("Find Matches CPU Time (sec) - %1").arg(name),
+      double(clock() - cpuStart) / CLOCKS_PER_SEC));
+    _stats.append(SingleStat(QString("Matches Found - %1").arg(name),
+      (double)(matches.size() - before)));
+  }
+}
+
+vector< vector< pair<ElementId, ElementId> > > MatchFactory::_createCandidatePairs(
+  const ConstOsmMapPtr& map) const
+{
+  vector< vector< pair<ElementId, ElementId> > > result(_creators.size());
+
+  vector<size_t> opted;
+  for (size_t i = 0; i < _creators.size(); ++i)
+  {
+    if (_creators[i]->getCandidateSearchRadius() > 0)
+    {
+      opted.push_back(i);
+    }
+  }
+  if (opted.size() == 0)
+  {
+    return result;
+  }
+
+  // one pass over the map collects every opted in creator's candidates.
+  vector< set<ElementId> > candidates(_creators.size());
+  const NodeMap& nodes = map->getNodes();
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    for (size_t j = 0; j < opted.size(); ++j)
+    {
+      if (_creators[opted[j]]->isMatchCandidate(it->second, map))
+      {
+        candidates[opted[j]].insert(ElementId::node(it->first));
+      }
+    }
+  }
+  const WayMap& ways = map->getWays();
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    for (size_t j = 0; j < opted.size(); ++j)
+    {
+      if (_creators[opted[j]]->isMatchCandidate(it->second, map))
+      {
+        candidates[opted[j]].insert(ElementId::way(it->first));
+      }
     }
   }
+
+  // one spatial self join per opted in creator produces its neighbor pairs, normalized smaller
+  // id first so each unordered pair appears once.
+  SpatialJoin join(map);
+  for (size_t j = 0; j < opted.size(); ++j)
+  {
+    const size_t ci = opted[j];
+    result[ci] = join.join(candidates[ci], _creators[ci]->getCandidateSearchRadius());
+  }
+
+  return result;
+}
+
+QString MatchFactory::_creatorName(const boost::shared_ptr<MatchCreator>& creator)
+{
+  const QString description = creator->getDescription();
+  if (description.isEmpty())
+  {
+    return QString::fromStdString(creator->getAllCreators().at(0).className);
+  }
+  return description;
+}
+
+void MatchFactory::_runCreator(CreatorJob* job, ConstOsmMapPtr map,
+  boost::shared_ptr<const MatchThreshold> threshold)
+{
+  double start = Tgs::Time::getTime();
+  ConstMatchThresholdPtr mt = threshold;
+  if (mt.get() == 0)
+  {
+    mt = job->creator->getMatchThreshold();
+  }
+  if (job->pairs != 0)
+  {
+    job->creator->createMatchesFromPairs(map, *job->pairs, job->matches, mt);
+  }
+  else
+  {
+    job->creator->createMatches(map, job->matches, mt);
+  }
+  job->wallTime = Tgs::Time::getTime() - start;
+}
+
+void MatchFactory::_createMatchesParallel(const ConstOsmMapPtr& map, vector<const Match*>& matches,
+  boost::shared_ptr<const MatchThreshold> threshold,
+  const vector< vector< pair<ElementId, ElementId> > >& pairs) const
+{
+  // build the map's lazy indexes up front and pin the R-tree node cache so the creators can
+  // query them from multiple threads.
+  map->getIndex().prepareForConcurrentReads();
+
+  // each creator writes into its own job so no locking is needed on the output.
+  vector<CreatorJob> jobs(_creators.size());
+  QList< QFuture<void> > futures;
+  for (size_t i = 0; i < _creators.size(); ++i)
+  {
+    jobs[i].creator = _creators[i];
+    jobs[i].pairs = _creators[i]->getCandidateSearchRadius() > 0 ? &pairs[i] : 0;
+    jobs[i].wallTime = 0;
+    futures.append(QtConcurrent::run(&MatchFactory::_runCreator, &jobs[i], map, threshold));
+  }
+  for (int i = 0; i < futures.size(); ++i)
+  {
+    futures[i].waitForFinished();
+  }
+
+  // concatenate in registration order so the result is identical to a serial run.
+  for (size_t i = 0; i < jobs.size(); ++i)
+  {
+    matches.insert(matches.end(), jobs[i].matches.begin(), jobs[i].matches.end());
+    QString name = _creatorName(_creators[i]);
+    _stats.append(SingleStat(QString("Find Matches Time (sec) - %1").arg(name),
+      jobs[i].wallTime));
+    _stats.append(SingleStat(QString("Matches Found - %1").arg(name),
+      (double)jobs[i].matches.size()));
+  }
 }
 
 void MatchFactory::_checkMatchCreatorBoundable(boost::shared_ptr<MatchCreator> matchCreator,
@@ -30,6 +30,10 @@
 // hoot
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/conflate/MatchCreator.h>
+#include <hoot/core/ops/stats/SingleStat.h>
+
+// Qt
+#include <QList>
 
 // Standard
 #include <vector>
@@ -63,7 +67,9 @@ public:
 
   /**
    * Goes through all registered MatchCreators and calls createMatches in the order the creators
-   * were registered.
+   * were registered. When match.creator.threads is greater than one the creators run
+   * concurrently against the read-only map, but the resulting match order is the same as a
+   * serial run.
    */
   void createMatches(const ConstOsmMapPtr& map, std::vector<const Match *> &matches,
     const geos::geom::Envelope &bounds,
@@ -81,6 +87,13 @@ public:
    */
   std::vector< boost::shared_ptr<MatchCreator> > getCreators() const { return _creators; }
 
+  /**
+   * Returns the per creator instrumentation (wall/cpu time and matches found) collected by the
+   * most recent call to createMatches. UnifyingConflator folds these into its stat list, which
+   * flows into the JSON stats output.
+   */
+  QList<SingleStat> getStats() const { return _stats; }
+
   /**
    * Registers the specified creator with the MergeFactory and takes ownership of the creator.
    */
@@ -105,11 +118,51 @@ private:
 
   void _checkMatchCreatorBoundable(boost::shared_ptr<MatchCreator> matchCreator,
                                    const geos::geom::Envelope& bounds) const;
+
+  /**
+   * Per creator work unit for the parallel path.
+   */
+  struct CreatorJob
+  {
+    boost::shared_ptr<MatchCreator> creator;
+    std::vector<const Match*> matches;
+    // null when the creator does its own neighbor discovery.
+    const std::vector< std::pair<ElementId, ElementId> >* pairs;
+    double wallTime;
+  };
+
+  /**
+   * Builds the shared candidate pair lists for every creator that advertises a candidate search
+   * radius: one pass over the map collects each creator's candidates and one index sweep per
+   * candidate produces its neighbor pairs. Entries stay empty for creators that do their own
+   * neighbor discovery.
+   */
+  std::vector< std::vector< std::pair<ElementId, ElementId> > > _createCandidatePairs(
+    const ConstOsmMapPtr& map) const;
+
+  /**
+   * Runs each registered creator on its own thread against the read-only map and concatenates
+   * the per-creator match vectors in registration order. See match.creator.threads.
+   */
+  void _createMatchesParallel(const ConstOsmMapPtr& map, std::vector<const Match*>& matches,
+    boost::shared_ptr<const MatchThreshold> threshold,
+    const std::vector< std::vector< std::pair<ElementId, ElementId> > >& pairs) const;
+
+  static void _runCreator(CreatorJob* job, ConstOsmMapPtr map,
+    boost::shared_ptr<const MatchThreshold> threshold);
+
   static void _setMatchCreators(QStringList matchCreatorsList);
 
+  /**
+   * Returns the name used for a creator in the stats output; mirrors the naming used by
+   * MatchCandidateCountVisitor.
+   */
+  static QString _creatorName(const boost::shared_ptr<MatchCreator>& creator);
+
   static boost::shared_ptr<MatchFactory> _theInstance;
 
   std::vector< boost::shared_ptr<MatchCreator> > _creators;
+  mutable QList<SingleStat> _stats;
 
   friend class MatchCandidateCountVisitorTest;
   friend class MatchCandidateCountVisitorRndTest;
@@ -60,28 +60,32 @@ void MergerFactory::clear()
     delete _creators[i];
   }
   _creators.clear();
+  _creatorIndexCache.clear();
 }
 
 void MergerFactory::createMergers(const OsmMapPtr& map, const MatchSet& matches,
   vector<Merger*>& result) const
 {
-  for (size_t i = 0; i < _creators.size(); i++)
+  // match sets with the same combination of match types always land on the same creator, so
+  // jump straight to the creator that handled this combination before instead of probing every
+  // creator that will decline it again (e.g. review sets otherwise fall through every creator
+  // before reaching MarkForReviewMergerCreator at the end of the list).
+  const QString key = _matchTypeKey(matches);
+  QHash<QString, int>::const_iterator cachedIt = _creatorIndexCache.find(key);
+  if (cachedIt != _creatorIndexCache.end())
   {
-    OsmMapConsumer* omc = dynamic_cast<OsmMapConsumer*>(_creators[i]);
-
-    if (omc)
-    {
-      omc->setOsmMap(map.get());
-    }
-    if (_creators[i]->createMergers(matches, result))
+    if (_tryCreator(_creators[cachedIt.value()], map, matches, result))
     {
       return;
     }
+  }
 
-    // we don't want the creators to hold onto a map pointer that will go out of scope
-    if (omc)
+  for (size_t i = 0; i < _creators.size(); i++)
+  {
+    if (_tryCreator(_creators[i], map, matches, result))
     {
-      omc->setOsmMap((OsmMap*)0);
+      _creatorIndexCache.insert(key, (int)i);
+      return;
     }
   }
 
@@ -90,6 +94,37 @@ void MergerFactory::createMergers(const OsmMapPtr& map, const MatchSet& matches,
   throw HootException("Error creating a merger for the provided set of matches.");
 }
 
+bool MergerFactory::_tryCreator(MergerCreator* creator, const OsmMapPtr& map,
+  const MatchSet& matches, vector<Merger*>& result) const
+{
+  OsmMapConsumer* omc = dynamic_cast<OsmMapConsumer*>(creator);
+
+  if (omc)
+  {
+    omc->setOsmMap(map.get());
+  }
+  const bool created = creator->createMergers(matches, result);
+
+  // we don't want the creators to hold onto a map pointer that will go out of scope
+  if (!created && omc)
+  {
+    omc->setOsmMap((OsmMap*)0);
+  }
+  return created;
+}
+
+QString MergerFactory::_matchTypeKey(const MatchSet& matches) const
+{
+  QStringList names;
+  for (MatchSet::const_iterator it = matches.begin(); it != matches.end(); ++it)
+  {
+    names.append((*it)->getMatchName());
+  }
+  names.sort();
+  names.removeDuplicates();
+  return names.join(";");
+}
+
 vector<MergerCreator::Description> MergerFactory::getAllAvailableCreators() const
 {
   vector<MergerCreator::Description> result;
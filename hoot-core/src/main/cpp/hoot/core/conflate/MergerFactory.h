@@ -33,6 +33,7 @@
 #include <hoot/core/conflate/MatchSet.h>
 
 // Qt
+#include <QHash>
 #include <QString>
 
 // Standard
@@ -95,12 +96,30 @@ public:
 
   void registerDefaultCreators();
 
-  void reset() { _creators.clear(); }
+  void reset() { _creators.clear(); _creatorIndexCache.clear(); }
 
 private:
   static boost::shared_ptr<MergerFactory> _theInstance;
 
   std::vector<MergerCreator*> _creators;
+
+  // remembers which creator handled each combination of match types so later match sets with
+  // the same make up skip the creators that already declined it; see createMergers
+  mutable QHash<QString, int> _creatorIndexCache;
+
+  /**
+   * Returns a key describing the match types in the set (the sorted match names). Creators
+   * accept or decline a match set based on the concrete match types in it, so sets with the
+   * same key are handled by the same creator.
+   */
+  QString _matchTypeKey(const MatchSet& matches) const;
+
+  /**
+   * Hands the match set to the creator, managing the map consumer handshake. Returns true if
+   * the creator produced mergers.
+   */
+  bool _tryCreator(MergerCreator* creator, const OsmMapPtr& map, const MatchSet& matches,
+    std::vector<Merger*>& result) const;
 };
 
 }
@@ -57,7 +57,11 @@ void NoInformationElementRemover::apply(boost::shared_ptr<OsmMap>& map)
   boost::shared_ptr<ChainCriterion> pCrit(new ChainCriterion(pNoInfoCrit, pUselessCrit));
   RemoveElementsVisitor removeElementsVisitor(pCrit);
   removeElementsVisitor.setRecursive(false);
+  // everything this op removes is referenced by nothing and references nothing, so the
+  // removals can be batched and committed in one pass without changing what gets removed.
+  removeElementsVisitor.setBatchRemoval(true);
   _map->visitRw(removeElementsVisitor);
+  _map->commitRemovals();
 }
 
 }
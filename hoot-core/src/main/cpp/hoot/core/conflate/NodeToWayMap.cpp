@@ -42,6 +42,7 @@ unsigned int NodeToWayMap::logWarnCount = 0;
 
 NodeToWayMap::NodeToWayMap(const OsmMap& map)
 {
+  _bloom.reset(new BloomFilter());
   const WayMap& ways = map.getWays();
   for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
   {
@@ -55,12 +56,18 @@ void NodeToWayMap::addWay(boost::shared_ptr<const Way> w)
   const std::vector<long>& nodes = w->getNodeIds();
   for (size_t i = 0; i < nodes.size(); i++)
   {
+    _bloom->insert(nodes[i]);
     (*this)[nodes[i]].insert(w->getId());
   }
 }
 
 const set<long>& NodeToWayMap::getWaysByNode(long nid) const
 {
+  // check the least expensive operations first.
+  if (_bloom->probably_contains(nid) == false)
+  {
+    return _emptySet;
+  }
   NodeToWayMap::const_iterator it = this->find(nid);
   if (it == this->end())
   {
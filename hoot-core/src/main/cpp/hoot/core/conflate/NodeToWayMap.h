@@ -36,6 +36,9 @@
 #include <set>
 #include <string>
 
+// Tgs
+#include <tgs/BigContainers/BasicBloomFilter.h>
+
 namespace hoot
 {
 
@@ -73,7 +76,19 @@ public:
 
 private:
 
+  // scaled for ~10M way nodes and FPR of 0.05
+  // http://hur.st/bloomfilter?n=10000000&p=0.05
+  typedef boost::bloom_filters::basic_bloom_filter<long, 62353 * 1000, boost::mpl::vector<
+      boost::bloom_filters::boost_hash<size_t, 0x327B23C66B8B4567>,
+      boost::bloom_filters::boost_hash<size_t, 0x66334873643C9869>,
+      boost::bloom_filters::boost_hash<size_t, 0x19495CFF74B0DC51>,
+      boost::bloom_filters::boost_hash<size_t, 0x625558EC2AE8944A> > > BloomFilter;
+
   std::set<long> _emptySet;
+  // Strictly a negative cache in front of the map lookup. removeWay can't clear bits, so a stale
+  // positive just falls through to the normal find. Heap allocated - the bitset is far too large
+  // to hold by value.
+  boost::shared_ptr<BloomFilter> _bloom;
 };
 
 }
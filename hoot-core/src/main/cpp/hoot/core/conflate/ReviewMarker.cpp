@@ -30,6 +30,9 @@
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
 
+// Qt
+#include <QStringList>
+
 // Tgs
 #include <tgs/RStarTree/HilbertCurve.h>
 
@@ -107,6 +110,34 @@ set<ReviewMarker::ReviewUid> ReviewMarker::getReviewUids(const ConstOsmMapPtr &m
   return result;
 }
 
+QHash<QString, QList<ReviewMarker::ReviewUid> > ReviewMarker::buildReviewTable(
+  const ConstOsmMapPtr& map)
+{
+  QHash<QString, QList<ReviewUid> > result;
+
+  const RelationMap& relations = map->getRelations();
+  for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
+  {
+    ElementId eid = ElementId::relation(it->first);
+    if (isReviewUid(map, eid))
+    {
+      result[_hashReviewMembers(getReviewElements(map, eid))].append(eid);
+    }
+  }
+
+  return result;
+}
+
+QString ReviewMarker::_hashReviewMembers(const set<ElementId>& eids)
+{
+  QStringList l;
+  for (set<ElementId>::const_iterator it = eids.begin(); it != eids.end(); ++it)
+  {
+    l.append(it->toString());
+  }
+  return l.join(";");
+}
+
 set<ReviewMarker::ReviewUid> ReviewMarker::getReviewUids(const ConstOsmMapPtr &map,
   ConstElementPtr e1)
 {
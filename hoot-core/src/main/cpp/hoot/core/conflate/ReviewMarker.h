@@ -30,6 +30,10 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/elements/Element.h>
 
+// Qt
+#include <QHash>
+#include <QList>
+
 namespace hoot
 {
 
@@ -60,6 +64,14 @@ public:
 
   static std::set<ReviewUid> getReviewUids(const ConstOsmMapPtr &map);
 
+  /**
+   * Returns every review in the map indexed by a hash of its member element ids, so all the
+   * reviews over the same member set land in the same bucket. The table is built in a single pass
+   * over the relations; callers that need to find duplicate reviews should use this rather than
+   * comparing member sets pairwise.
+   */
+  static QHash<QString, QList<ReviewUid> > buildReviewTable(const ConstOsmMapPtr& map);
+
   /**
    * Returns true if the element is in at least one review.
    */
@@ -126,6 +138,12 @@ private:
 
   static std::set<ElementId> _getReviewRelations(const ConstOsmMapPtr &map, ElementId eid);
 
+  /**
+   * Returns a deterministic hash key for a review's member element ids. The ids are already
+   * sorted by virtue of coming out of a set.
+   */
+  static QString _hashReviewMembers(const std::set<ElementId>& eids);
+
   void _updateScore(Tags& t, double score);
 
   // for white box testing.
@@ -29,6 +29,7 @@
 // hoot
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/conflate/MatchType.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 #include <hoot/core/conflate/extractors/FeatureExtractor.h>
 #include <hoot/core/conflate/MatchClassification.h>
 
@@ -92,9 +93,12 @@ map<QString, double> RfExtractorClassifier::getFeatures(const ConstOsmMapPtr& m,
   const boost::shared_ptr<const Element> e2 = m->getElement(eid2);
 
   _getExtractors();
+  // one context for the whole extractor list, so intermediate products derived from this pair
+  // are computed once and shared across the extractors.
+  FeatureExtractionContext context(m);
   for (size_t i = 0; i < _extractors.size(); i++)
   {
-    double v = _extractors[i]->extract(*m, e1, e2);
+    double v = _extractors[i]->extract(*m, e1, e2, context);
     // if it isn't null then include it.
     if (!FeatureExtractor::isNull(v))
     {
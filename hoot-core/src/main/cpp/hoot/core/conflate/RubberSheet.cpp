@@ -39,6 +39,10 @@
 #include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/visitors/WorstCircularErrorVisitor.h>
 
+// Qt
+#include <QBuffer>
+#include <QThread>
+
 // Tgs
 #include <tgs/Statistics/Normal.h>
 #include <tgs/Interpolation/DelaunayInterpolator.h>
@@ -67,10 +71,115 @@ bool compareMatches(const RubberSheet::Match& m1, const RubberSheet::Match& m2)
   return m1.p > m2.p;
 }
 
+/**
+ * Scores the potential matches for a slice of the intersection candidates. The owning RubberSheet
+ * merges the per worker match lists after all the workers join.
+ */
+class RubberSheetTieWorker : public QThread
+{
+public:
+
+  RubberSheetTieWorker(const boost::shared_ptr<const OsmMap>& map, const vector<long>& nids,
+                       size_t begin, size_t end, double searchRadius) :
+    _map(map),
+    _nids(nids),
+    _begin(begin),
+    _end(end),
+    _searchRadius(searchRadius)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      NodeMatcher nm;
+      nm.setMap(_map);
+      for (size_t i = _begin; i < _end; i++)
+      {
+        RubberSheet::_findNodeMatches(_map, nm, _nids[i], _searchRadius, _matches[_nids[i]]);
+      }
+    }
+    catch (const HootException& e)
+    {
+      _error = e.getWhat();
+    }
+  }
+
+  map<long, list<RubberSheet::Match> >& getMatches() { return _matches; }
+
+  const QString& getError() const { return _error; }
+
+private:
+
+  boost::shared_ptr<const OsmMap> _map;
+  const vector<long>& _nids;
+  size_t _begin;
+  size_t _end;
+  double _searchRadius;
+  map<long, list<RubberSheet::Match> > _matches;
+  QString _error;
+};
+
+/**
+ * Interpolates new coordinates for a slice of the nodes to be moved. The coordinates are applied
+ * serially afterwards since moving a node notifies the map index, which is not thread safe.
+ */
+class RubberSheetApplyWorker : public QThread
+{
+public:
+
+  RubberSheetApplyWorker(const vector<NodePtr>& nodes, vector<Coordinate>& newCoords,
+                         size_t begin, size_t end,
+                         boost::shared_ptr<Interpolator> interpolator1to2,
+                         boost::shared_ptr<Interpolator> interpolator2to1) :
+    _nodes(nodes),
+    _newCoords(newCoords),
+    _begin(begin),
+    _end(end),
+    _interpolator1to2(interpolator1to2),
+    _interpolator2to1(interpolator2to1)
+  {
+  }
+
+  virtual void run()
+  {
+    vector<double> matchPoint(2);
+    for (size_t i = _begin; i < _end; i++)
+    {
+      Coordinate c = _nodes[i]->toCoordinate();
+      matchPoint[0] = c.x;
+      matchPoint[1] = c.y;
+
+      const vector<double>* delta;
+      if (_nodes[i]->getStatus() == Status::Unknown1)
+      {
+        delta = &_interpolator1to2->interpolate(matchPoint);
+      }
+      else
+      {
+        delta = &_interpolator2to1->interpolate(matchPoint);
+      }
+
+      _newCoords[i] = Coordinate(c.x + (*delta)[0], c.y + (*delta)[1]);
+    }
+  }
+
+private:
+
+  const vector<NodePtr>& _nodes;
+  vector<Coordinate>& _newCoords;
+  size_t _begin;
+  size_t _end;
+  boost::shared_ptr<Interpolator> _interpolator1to2;
+  boost::shared_ptr<Interpolator> _interpolator2to1;
+};
+
 RubberSheet::RubberSheet(bool logNotEnoughTiePointsAsWarning) :
 _ref(ConfigOptions().getRubberSheetRef()),
 _debug(ConfigOptions().getRubberSheetDebug()),
 _minimumTies(ConfigOptions().getRubberSheetMinimumTies()),
+_threadCount(ConfigOptions().getRubberSheetThreads()),
 _logNotEnoughTiePointsAsWarning(logNotEnoughTiePointsAsWarning)
 {
   _emptyMatch.score = 0.0;
@@ -79,7 +188,13 @@ _logNotEnoughTiePointsAsWarning(logNotEnoughTiePointsAsWarning)
 
 void RubberSheet::_addIntersection(long nid, const set<long>& /*wids*/)
 {
-  NodePtr from = _map->getNode(nid);
+  _findNodeMatches(_map, _nm, nid, _searchRadius, _matches[nid]);
+}
+
+void RubberSheet::_findNodeMatches(const boost::shared_ptr<const OsmMap>& map, NodeMatcher& nm,
+  long nid, double searchRadius, list<Match>& matches)
+{
+  ConstNodePtr from = map->getNode(nid);
   // the status type we're searching for.
   Status s;
   if (from->getStatus() == Status::Unknown1)
@@ -95,17 +210,16 @@ void RubberSheet::_addIntersection(long nid, const set<long>& /*wids*/)
     throw HootException("Expected either Unknown1 or Unknown2.");
   }
 
-  boost::shared_ptr<NodeToWayMap> n2w = _map->getIndex().getNodeToWayMap();
+  boost::shared_ptr<NodeToWayMap> n2w = map->getIndex().getNodeToWayMap();
   double sum = 0.0;
-  list<Match>& matches = _matches[nid];
-  vector<long> neighbors = _map->getIndex().findNodes(from->toCoordinate(), _searchRadius);
+  vector<long> neighbors = map->getIndex().findNodes(from->toCoordinate(), searchRadius);
   for (size_t i = 0; i < neighbors.size(); ++i)
   {
-    NodePtr aNeighbor = _map->getNode(neighbors[i]);
+    ConstNodePtr aNeighbor = map->getNode(neighbors[i]);
     NodeToWayMap::const_iterator it = n2w->find(neighbors[i]);
     if (aNeighbor->getStatus() == s && it != n2w->end() && it->second.size() >= 2)
     {
-      double score = _nm.scorePair(nid, neighbors[i]);
+      double score = nm.scorePair(nid, neighbors[i]);
 
       if (score > 0.0)
       {
@@ -129,6 +243,53 @@ void RubberSheet::_addIntersection(long nid, const set<long>& /*wids*/)
   }
 }
 
+void RubberSheet::_findMatchesParallel(const vector<long>& nids)
+{
+  // build the shared indexes up front; the workers only read them.
+  _map->getIndex().getNodeToWayMap();
+  _map->getIndex().prepareForConcurrentReads();
+  boost::shared_ptr<const OsmMap> constMap = _map;
+
+  int threadCount = max(1, min(_threadCount, (int)nids.size()));
+  size_t chunkSize = (nids.size() + threadCount - 1) / threadCount;
+
+  vector<boost::shared_ptr<RubberSheetTieWorker> > workers;
+  for (int i = 0; i < threadCount; i++)
+  {
+    size_t begin = min(nids.size(), (size_t)i * chunkSize);
+    size_t end = min(nids.size(), begin + chunkSize);
+    boost::shared_ptr<RubberSheetTieWorker> w(
+      new RubberSheetTieWorker(constMap, nids, begin, end, _searchRadius));
+    workers.push_back(w);
+    w->start();
+  }
+
+  QString error;
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i]->wait();
+    if (error.isEmpty())
+    {
+      error = workers[i]->getError();
+    }
+  }
+  if (error.isEmpty() == false)
+  {
+    throw HootException(error);
+  }
+
+  // each candidate is scored by exactly one worker, so the merged result is identical to the
+  // serial result.
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    map<long, list<Match> >& m = workers[i]->getMatches();
+    for (map<long, list<Match> >::iterator it = m.begin(); it != m.end(); ++it)
+    {
+      _matches[it->first].swap(it->second);
+    }
+  }
+}
+
 void RubberSheet::apply(boost::shared_ptr<OsmMap>& map)
 {
   LOG_INFO("Rubbersheeting the map...");
@@ -168,20 +329,61 @@ void RubberSheet::applyTransform(boost::shared_ptr<OsmMap>& map)
     MapProjector::projectToPlanar(_map);
   }
 
+  // gather the nodes to move, then interpolate all the new positions before applying any of
+  // them.
   const NodeMap& nm = map->getNodes();
+  vector<NodePtr> toMove;
+  toMove.reserve(nm.size());
   for (NodeMap::const_iterator it = nm.begin(); it != nm.end(); ++it)
   {
     const NodePtr& n = it->second;
 
     if (_ref == false || n->getStatus() == Status::Unknown2)
     {
-      Coordinate c = n->toCoordinate();
-      Coordinate newC = _translate(c, n->getStatus());
+      toMove.push_back(n);
+    }
+  }
 
-      n->setX(newC.x);
-      n->setY(newC.y);
+  vector<Coordinate> newCoords(toMove.size());
+  int threadCount = min(_threadCount, (int)toMove.size());
+  if (threadCount > 1)
+  {
+    size_t chunkSize = (toMove.size() + threadCount - 1) / threadCount;
+    vector<boost::shared_ptr<RubberSheetApplyWorker> > workers;
+    for (int i = 0; i < threadCount; i++)
+    {
+      size_t begin = min(toMove.size(), (size_t)i * chunkSize);
+      size_t end = min(toMove.size(), begin + chunkSize);
+      boost::shared_ptr<Interpolator> interpolator1to2;
+      if (_interpolator1to2)
+      {
+        interpolator1to2 = _cloneInterpolator(_interpolator1to2);
+      }
+      boost::shared_ptr<RubberSheetApplyWorker> w(
+        new RubberSheetApplyWorker(toMove, newCoords, begin, end, interpolator1to2,
+          _cloneInterpolator(_interpolator2to1)));
+      workers.push_back(w);
+      w->start();
+    }
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i]->wait();
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < toMove.size(); i++)
+    {
+      newCoords[i] = _translate(toMove[i]->toCoordinate(), toMove[i]->getStatus());
     }
   }
+
+  // apply serially; moving a node notifies the map index, which is not thread safe.
+  for (size_t i = 0; i < toMove.size(); i++)
+  {
+    toMove[i]->setX(newCoords[i].x);
+    toMove[i]->setY(newCoords[i].y);
+  }
 }
 
 boost::shared_ptr<DataFrame> RubberSheet::_buildDataFrame(Status s) const
@@ -299,16 +501,33 @@ void RubberSheet::_findTies()
   _searchRadius = WorstCircularErrorVisitor::getWorstCircularError(_map) * 2;
 
   boost::shared_ptr<NodeToWayMap> n2w = _map->getIndex().getNodeToWayMap();
-  // go through all the intersections w/ 2 or more roads intersecting
-  for (NodeToWayMap::const_iterator it = n2w->begin(); it != n2w->end(); ++it)
+  if (_threadCount > 1)
   {
-    long nid = it->first;
-    const set<long>& wids = it->second;
-    // find all the potential matches
-    if (wids.size() >= 3)
+    // the matcher only looks within the search radius of each intersection, so the candidates
+    // can be scored independently by a pool of workers.
+    vector<long> candidates;
+    for (NodeToWayMap::const_iterator it = n2w->begin(); it != n2w->end(); ++it)
     {
-      // calculate the probability of each match and add it to our list
-      _addIntersection(nid, wids);
+      if (it->second.size() >= 3)
+      {
+        candidates.push_back(it->first);
+      }
+    }
+    _findMatchesParallel(candidates);
+  }
+  else
+  {
+    // go through all the intersections w/ 2 or more roads intersecting
+    for (NodeToWayMap::const_iterator it = n2w->begin(); it != n2w->end(); ++it)
+    {
+      long nid = it->first;
+      const set<long>& wids = it->second;
+      // find all the potential matches
+      if (wids.size() >= 3)
+      {
+        // calculate the probability of each match and add it to our list
+        _addIntersection(nid, wids);
+      }
     }
   }
 
@@ -434,6 +653,20 @@ const RubberSheet::Match& RubberSheet::_findMatch(long nid1, long nid2)
   return _emptyMatch;
 }
 
+boost::shared_ptr<Interpolator> RubberSheet::_cloneInterpolator(
+  const boost::shared_ptr<Interpolator>& interpolator) const
+{
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  interpolator->writeInterpolator(buffer);
+  buffer.seek(0);
+
+  boost::shared_ptr<Interpolator> result(Factory::getInstance().constructObject<Interpolator>(
+    interpolator->getClassName()));
+  result->readInterpolator(buffer);
+  return result;
+}
+
 boost::shared_ptr<Interpolator> RubberSheet::_readInterpolator(QIODevice& is)
 {
   QDataStream ds(&is);
@@ -504,4 +737,23 @@ vector<double> RubberSheet::calculateTiePointDistances()
   return tiePointDistances;
 }
 
+vector<pair<Coordinate, double> > RubberSheet::calculateTiePointDistanceSamples()
+{
+  if (_ties.size() == 0)
+  {
+    throw HootException("No tie points have been generated.");
+  }
+
+  vector<pair<Coordinate, double> > samples;
+  samples.reserve(_ties.size());
+  for (vector<Tie>::const_iterator it = _ties.begin(); it != _ties.end(); ++it)
+  {
+    Tie tiePoint = *it;
+    const Coordinate midpoint(
+      (tiePoint.c1.x + tiePoint.c2.x) / 2.0, (tiePoint.c1.y + tiePoint.c2.y) / 2.0);
+    samples.push_back(pair<Coordinate, double>(midpoint, tiePoint.c1.distance(tiePoint.c2)));
+  }
+  return samples;
+}
+
 }
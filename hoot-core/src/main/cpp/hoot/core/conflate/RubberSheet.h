@@ -46,6 +46,7 @@ namespace hoot
 
 class SearchRadiusCalculatorTest;
 class RubberSheetTest;
+class RubberSheetTieWorker;
 class OsmMap;
 class Status;
 
@@ -129,6 +130,15 @@ public:
    */
    std::vector<double> calculateTiePointDistances();
 
+  /**
+   * Calculates the distance between each of the rubber sheet's tie points, paired with the
+   * location the distance was measured at (the midpoint of the tie, in planar units)
+   *
+   * @return a collection of location / distance pairs
+   * @throws HootException if the tie points have not been created
+   */
+   std::vector<std::pair<geos::geom::Coordinate, double> > calculateTiePointDistanceSamples();
+
 private:
 
   typedef std::map<long, std::list<Match> > MatchList;
@@ -154,6 +164,7 @@ private:
   bool _ref;
   bool _debug;
   int _minimumTies;
+  int _threadCount;
   std::vector<Tie> _ties;
   boost::shared_ptr<Tgs::Interpolator> _interpolator1to2, _interpolator2to1;
   // used as a temporary in interpolating.
@@ -173,6 +184,28 @@ private:
 
   void _addIntersection(long nid, const std::set<long>& wids);
 
+  /**
+   * Scores all the potential matches for a single intersection node and writes them to matches.
+   * Only reads from the map, so the tie point workers can call it concurrently once the map's
+   * indexes have been built.
+   */
+  static void _findNodeMatches(const boost::shared_ptr<const OsmMap>& map, NodeMatcher& nm,
+    long nid, double searchRadius, std::list<Match>& matches);
+
+  /**
+   * Divides the intersection candidates among a pool of workers and merges their match lists.
+   * The merged result is identical to the serial result since each candidate is scored
+   * independently.
+   */
+  void _findMatchesParallel(const std::vector<long>& nids);
+
+  /**
+   * Returns a deep copy of an interpolator by round tripping it through its serialized form.
+   * interpolate() reuses an internal result buffer, so each apply thread needs its own copy.
+   */
+  boost::shared_ptr<Tgs::Interpolator> _cloneInterpolator(
+    const boost::shared_ptr<Tgs::Interpolator>& interpolator) const;
+
   /**
    * Build a data frame for use with interpolators.
    */
@@ -191,6 +224,7 @@ private:
 
   friend class SearchRadiusCalculatorTest;
   friend class RubberSheetTest;
+  friend class RubberSheetTieWorker;
 };
 
 }
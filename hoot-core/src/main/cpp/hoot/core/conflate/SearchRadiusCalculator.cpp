@@ -38,6 +38,9 @@
 #include <hoot/core/util/MapProjector.h>
 #include <hoot/core/OsmMap.h>
 
+// Std
+#include <memory>
+
 using namespace std;
 
 //TODO: a lot of the logging levels in this class need changed, as they've revealed issues
@@ -63,6 +66,8 @@ void SearchRadiusCalculator::setConfiguration(const Settings& conf)
   setCircularError(config.getCircularErrorDefaultValue());
   setRubberSheetRef(config.getRubberSheetRef());
   setRubberSheetMinTies(config.getRubberSheetMinimumTies());
+  setAdaptive(config.getSearchRadiusCalculatorAdaptive());
+  setGridCellSize(config.getSearchRadiusCalculatorGridCellSize());
 }
 
 void SearchRadiusCalculator::apply(boost::shared_ptr<OsmMap> &map)
@@ -139,6 +144,64 @@ void SearchRadiusCalculator::apply(boost::shared_ptr<OsmMap> &map)
   }
 
   _calculateSearchRadius(tiePointDistances);
+
+  if (_adaptive && tiePointDistances.size() >= 2)
+  {
+    try
+    {
+      _applyAdaptiveRadii(map, mapWithOnlyUnknown1And2, rubberSheet->calculateTiePointDistanceSamples());
+    }
+    catch (const HootException& e)
+    {
+      //the global radius stands on its own
+      LOG_DEBUG("Unable to calculate adaptive search radii: " << e.getWhat());
+    }
+  }
+}
+
+void SearchRadiusCalculator::_applyAdaptiveRadii(
+  boost::shared_ptr<OsmMap>& map, const boost::shared_ptr<const OsmMap>& planarMap,
+  const vector<pair<geos::geom::Coordinate, double> >& samples)
+{
+  //require at least as many ties per cell neighborhood as the global calculation requires overall
+  _radiusGrid.build(samples, _gridCellSize, _minTies, _result);
+  if (!_radiusGrid.isBuilt())
+  {
+    return;
+  }
+
+  //the tie points are in the rubber sheeted copy's planar projection, so look each feature up by
+  //its location in that copy, then write the local radius into the original map's feature
+  long featuresUpdated = 0;
+  const NodeMap& nodes = planarMap->getNodes();
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    ConstNodePtr node = it->second;
+    if (map->containsElement(node->getElementId()))
+    {
+      map->getElement(node->getElementId())->setCircularError(
+        _radiusGrid.radiusAt(geos::geom::Coordinate(node->getX(), node->getY())));
+      featuresUpdated++;
+    }
+  }
+  const WayMap& ways = planarMap->getWays();
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    ConstWayPtr way = it->second;
+    auto_ptr<geos::geom::Envelope> env(way->getEnvelope(planarMap));
+    if (env.get() == 0 || env->isNull() || !map->containsElement(way->getElementId()))
+    {
+      continue;
+    }
+    map->getElement(way->getElementId())->setCircularError(
+      _radiusGrid.radiusAt(
+        geos::geom::Coordinate(
+          (env->getMinX() + env->getMaxX()) / 2.0, (env->getMinY() + env->getMaxY()) / 2.0)));
+    featuresUpdated++;
+  }
+  LOG_INFO(
+    "Calculated adaptive search radii for " << featuresUpdated <<
+    " features using grid cell size = " << QString::number(_gridCellSize));
 }
 
 void SearchRadiusCalculator::_calculateSearchRadius(const vector<double>& tiePointDistances)
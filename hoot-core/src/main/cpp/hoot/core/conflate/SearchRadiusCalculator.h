@@ -29,10 +29,12 @@
 #define SEARCH_RADIUS_CALCULATOR_H
 
 // Hoot
+#include <hoot/core/conflate/SearchRadiusGrid.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 #include <hoot/core/util/Configurable.h>
 
 // Std
+#include <utility>
 #include <vector>
 
 namespace hoot
@@ -42,7 +44,9 @@ class OsmMap;
 
 /**
  * Calculates a conflation search radius using tie points from rubbersheeting.  If there
- * are not enough tie points to perform the calculation
+ * are not enough tie points to perform the calculation, the default circular error is used
+ * instead.  Optionally also derives a density adaptive per grid cell radius from the same tie
+ * points and writes it into the features' circular error.
  */
 class SearchRadiusCalculator : public OsmMapOperation, public Configurable
 {
@@ -64,10 +68,27 @@ public:
 
   void setRubberSheetMinTies(int minTies) { _minTies = minTies; }
 
+  void setAdaptive(bool adaptive) { _adaptive = adaptive; }
+
+  void setGridCellSize(double cellSize) { _gridCellSize = cellSize; }
+
+  /**
+   * Returns the per cell radius grid built when the adaptive option is enabled; empty otherwise
+   */
+  const SearchRadiusGrid& getSearchRadiusGrid() const { return _radiusGrid; }
+
 private:
 
   void _calculateSearchRadius(const std::vector<double>& tiePointDistances);
   double _calculateStandardDeviation(const std::vector<double>& samples);
+  /*
+   * Builds the radius grid from the tie point samples and writes each feature's local radius into
+   * its circular error, which is what the matching routines without an explicitly configured
+   * search radius base their candidate search on.
+   */
+  void _applyAdaptiveRadii(
+    boost::shared_ptr<OsmMap>& map, const boost::shared_ptr<const OsmMap>& planarMap,
+    const std::vector<std::pair<geos::geom::Coordinate, double> >& samples);
 
   double _result;
 
@@ -76,6 +97,10 @@ private:
   bool _rubberSheetRef;
   int _minTies;
 
+  bool _adaptive;
+  double _gridCellSize;
+  SearchRadiusGrid _radiusGrid;
+
   friend class SearchRadiusCalculatorTest;
 };
 
@@ -0,0 +1,139 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#include "SearchRadiusGrid.h"
+
+// Standard
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+SearchRadiusGrid::SearchRadiusGrid() :
+_cellSize(0.0),
+_columns(0),
+_rows(0),
+_fallbackRadius(0.0)
+{
+}
+
+void SearchRadiusGrid::build(const vector<pair<Coordinate, double> >& samples, Meters cellSize,
+                             int minSamplesPerCell, Meters fallbackRadius)
+{
+  _cellRadii.clear();
+  _fallbackRadius = fallbackRadius;
+  _cellSize = cellSize;
+  if (samples.size() < 2 || cellSize <= 0.0)
+  {
+    return;
+  }
+
+  _bounds.setToNull();
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    _bounds.expandToInclude(samples[i].first);
+  }
+  _columns = max(1, (int)ceil(_bounds.getWidth() / _cellSize));
+  _rows = max(1, (int)ceil(_bounds.getHeight() / _cellSize));
+
+  //bucket the sample indexes by cell
+  vector<vector<size_t> > cellSamples(_columns * _rows);
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    const Coordinate& c = samples[i].first;
+    cellSamples[_cellRow(c.y) * _columns + _cellColumn(c.x)].push_back(i);
+  }
+
+  //each cell pools samples from progressively larger neighborhoods until it has enough of them
+  //for a stable estimate; this keeps sparsely tied cells from producing wild radii
+  const int maxRing = max(_columns, _rows);
+  _cellRadii.resize(_columns * _rows, _fallbackRadius);
+  for (int row = 0; row < _rows; row++)
+  {
+    for (int col = 0; col < _columns; col++)
+    {
+      double sumSquares = 0.0;
+      int sampleCount = 0;
+      for (int ring = 0; ring <= maxRing; ring++)
+      {
+        for (int r = max(0, row - ring); r <= min(_rows - 1, row + ring); r++)
+        {
+          for (int c = max(0, col - ring); c <= min(_columns - 1, col + ring); c++)
+          {
+            //only visit the cells added by this ring
+            if (ring > 0 && abs(r - row) != ring && abs(c - col) != ring)
+            {
+              continue;
+            }
+            const vector<size_t>& indexes = cellSamples[r * _columns + c];
+            for (size_t i = 0; i < indexes.size(); i++)
+            {
+              const double distance = samples[indexes[i]].second;
+              sumSquares += distance * distance;
+              sampleCount++;
+            }
+          }
+        }
+        if (sampleCount >= minSamplesPerCell)
+        {
+          break;
+        }
+      }
+      if (sampleCount >= max(2, minSamplesPerCell))
+      {
+        //the same two sigma estimate the global calculation uses
+        _cellRadii[row * _columns + col] = 2 * sqrt(sumSquares / (double)(sampleCount - 1));
+      }
+    }
+  }
+}
+
+Meters SearchRadiusGrid::radiusAt(const Coordinate& c) const
+{
+  if (_cellRadii.empty() || !_bounds.contains(c))
+  {
+    return _fallbackRadius;
+  }
+  return _cellRadii[_cellRow(c.y) * _columns + _cellColumn(c.x)];
+}
+
+int SearchRadiusGrid::_cellColumn(double x) const
+{
+  return min(_columns - 1, max(0, (int)((x - _bounds.getMinX()) / _cellSize)));
+}
+
+int SearchRadiusGrid::_cellRow(double y) const
+{
+  return min(_rows - 1, max(0, (int)((y - _bounds.getMinY()) / _cellSize)));
+}
+
+}
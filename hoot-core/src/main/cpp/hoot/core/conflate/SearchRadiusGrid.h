@@ -0,0 +1,92 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef SEARCH_RADIUS_GRID_H
+#define SEARCH_RADIUS_GRID_H
+
+// GEOS
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+
+// Hoot
+#include <hoot/core/util/Units.h>
+
+// Std
+#include <utility>
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * A grid of search radius values derived from rubber sheet tie point statistics, allowing the
+ * search radius to adapt to local feature density.  Each cell's radius is two standard deviations
+ * of the tie point distances measured in and around the cell; cells without enough tie points of
+ * their own borrow them from progressively larger neighborhoods and, failing that, fall back to
+ * the global radius.
+ */
+class SearchRadiusGrid
+{
+public:
+
+  SearchRadiusGrid();
+
+  /**
+   * Builds the grid from tie point distance samples
+   *
+   * @param samples a collection of sample location / distance pairs in planar units
+   * @param cellSize the width and height of each grid cell in planar units
+   * @param minSamplesPerCell the number of samples a cell's neighborhood must contain before its
+   * radius is calculated from them rather than falling back to the global radius
+   * @param fallbackRadius the radius returned for cells without enough samples and for locations
+   * outside the grid
+   */
+  void build(const std::vector<std::pair<geos::geom::Coordinate, double> >& samples,
+             Meters cellSize, int minSamplesPerCell, Meters fallbackRadius);
+
+  /**
+   * Returns the search radius for the given planar location
+   */
+  Meters radiusAt(const geos::geom::Coordinate& c) const;
+
+  bool isBuilt() const { return !_cellRadii.empty(); }
+
+private:
+
+  int _cellColumn(double x) const;
+  int _cellRow(double y) const;
+
+  geos::geom::Envelope _bounds;
+  double _cellSize;
+  int _columns;
+  int _rows;
+  Meters _fallbackRadius;
+  std::vector<Meters> _cellRadii;
+};
+
+}
+
+#endif // SEARCH_RADIUS_GRID_H
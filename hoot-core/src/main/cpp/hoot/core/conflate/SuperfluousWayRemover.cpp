@@ -31,7 +31,6 @@
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/index/OsmMapIndex.h>
-#include <hoot/core/ops/RemoveWayOp.h>
 
 using namespace std;
 
@@ -87,9 +86,12 @@ void SuperfluousWayRemover::removeWays()
     // if all the nodes in a way are the same or there are zero nodes
     if ((same || w->getTags().size() == 0) && !inRelation)
     {
-      RemoveWayOp::removeWayFully(_inputMap, w->getId());
+      _inputMap->scheduleRemoval(ElementId::way(w->getId()));
     }
   }
+
+  // apply all the removals in one pass rather than paying the fix up cost per way.
+  _inputMap->commitRemovals();
 }
 
 void SuperfluousWayRemover::apply(boost::shared_ptr<OsmMap> &map)
@@ -53,6 +53,7 @@ TileBoundsCalculator::TileBoundsCalculator(double pixelSize)
   _pixelSize = pixelSize;
   LOG_VARD(_pixelSize);
   _slop = 0.1;
+  _maxCostPerBox = 0.0;
   setMaxNodesPerBox(1000);
 }
 
@@ -69,16 +70,23 @@ void TileBoundsCalculator::_calculateMin()
   _min = cv::Mat(cvSize(w, h), CV_32SC1);
   LOG_VART(_min);
 
+  // estimated conflation cost per pixel. Every Unknown1 node in a pixel is a match candidate for
+  // every Unknown2 node in the same neighborhood, so the pair product tracks conflation time far
+  // better than the node count does.
+  _cost = cv::Mat(cvSize(w, h), CV_64FC1);
+
   _maxValue = 1.0;
   for (int py = 0; py < h; py++)
   {
     int32_t* row1 = _r1.ptr<int32_t>(py);
     int32_t* row2 = _r2.ptr<int32_t>(py);
     int32_t* rowM = _min.ptr<int32_t>(py);
+    double* rowC = _cost.ptr<double>(py);
 
     for (int px = 0; px < w; px++)
     {
       rowM[px] = std::min(row1[px], row2[px]);
+      rowC[px] = (double)row1[px] * (double)row2[px];
       _maxValue = std::max(_maxValue, std::max(row1[px], row2[px]));
     }
   }
@@ -132,16 +140,22 @@ vector< vector<Envelope> >  TileBoundsCalculator::calculateTiles()
 
   long maxNodeCount = 0;
   long minNodeCount = LONG_MAX;
+  double maxCost = 0.0;
   result.resize(width);
+  _tileCosts.clear();
+  _tileCosts.resize(width);
   for (size_t tx = 0; tx < width; tx++)
   {
     result[tx].resize(width);
+    _tileCosts[tx].resize(width);
     for (size_t ty = 0; ty < width; ty++)
     {
       PixelBox& pb = boxes[tx + ty * width];
       const long nodeCount = _sumPixels(pb);
       maxNodeCount = std::max(maxNodeCount, nodeCount);
       minNodeCount = std::min(minNodeCount, nodeCount);
+      _tileCosts[tx][ty] = _sumCost(pb);
+      maxCost = std::max(maxCost, _tileCosts[tx][ty]);
       if (pb.getWidth() < 3 || pb.getHeight() < 3)
       {
         throw HootException("PixelBox must be at least 3 pixels wide and tall.");
@@ -151,6 +165,7 @@ vector< vector<Envelope> >  TileBoundsCalculator::calculateTiles()
   }
   LOG_DEBUG("Max node count in one tile: " << maxNodeCount);
   LOG_DEBUG("Min node count in one tile: " << minNodeCount);
+  LOG_DEBUG("Max estimated cost in one tile: " << maxCost);
   _exportResult(boxes, "tmp/result.png");
 
   return result;
@@ -158,10 +173,10 @@ vector< vector<Envelope> >  TileBoundsCalculator::calculateTiles()
 
 int TileBoundsCalculator::_calculateSplitX(PixelBox& b)
 {
-  double total = _sumPixels(b);
+  double total = _boxWeight(b);
   LOG_VART(total);
 
-  double left = _sumPixels(b.getColumnBox(b.minX));
+  double left = _boxWeight(b.getColumnBox(b.minX));
   LOG_VART(left);
 
   int best = (b.maxX + b.minX) / 2;
@@ -178,7 +193,7 @@ int TileBoundsCalculator::_calculateSplitX(PixelBox& b)
 
   for (int c = b.minX + 2; c < b.maxX - 2; c++)
   {
-    double colSum = _sumPixels(b.getColumnBox(c));
+    double colSum = _boxWeight(b.getColumnBox(c));
     LOG_VART(colSum);
     double colSumMin =
       _sumPixels(b.getColumnBox(c), _min) + _sumPixels(b.getColumnBox(c + 1), _min);
@@ -215,10 +230,10 @@ int TileBoundsCalculator::_calculateSplitX(PixelBox& b)
 
 int TileBoundsCalculator::_calculateSplitY(const PixelBox& b)
 {
-  double total = _sumPixels(b);
+  double total = _boxWeight(b);
   LOG_VART(total);
 
-  double bottom = _sumPixels(b.getRowBox(b.minY));
+  double bottom = _boxWeight(b.getRowBox(b.minY));
   LOG_VART(bottom);
 
   int best = (b.maxY + b.minY) / 2;
@@ -234,7 +249,7 @@ int TileBoundsCalculator::_calculateSplitY(const PixelBox& b)
 
   for (int r = b.minY + 2; r < b.maxY - 2; r++)
   {
-    double rowSum = _sumPixels(b.getRowBox(r));
+    double rowSum = _boxWeight(b.getRowBox(r));
     LOG_VART(rowSum);
     double rowSumMin = _sumPixels(b.getRowBox(r), _min) + _sumPixels(b.getRowBox(r + 1), _min);
     LOG_VART(rowSumMin);
@@ -439,7 +454,14 @@ bool TileBoundsCalculator::_isDone(vector<PixelBox> &boxes)
       minSize = true;
     }
 
-    if (_sumPixels(b) > _maxNodesPerBox)
+    if (_maxCostPerBox > 0.0)
+    {
+      if (_sumCost(b) > _maxCostPerBox)
+      {
+        smallEnough = false;
+      }
+    }
+    else if (_sumPixels(b) > _maxNodesPerBox)
     {
       smallEnough = false;
     }
@@ -544,6 +566,33 @@ long TileBoundsCalculator::_sumPixels(const PixelBox& pb, cv::Mat& r)
   return sum;
 }
 
+double TileBoundsCalculator::_sumCost(const PixelBox& pb)
+{
+  double sum = 0.0;
+  for (int py = pb.minY; py <= pb.maxY; py++)
+  {
+    double* row = _cost.ptr<double>(py);
+
+    for (int px = pb.minX; px <= pb.maxX; px++)
+    {
+      sum += row[px];
+    }
+  }
+  return sum;
+}
+
+double TileBoundsCalculator::_boxWeight(const PixelBox& pb)
+{
+  if (_maxCostPerBox > 0.0)
+  {
+    return _sumCost(pb);
+  }
+  else
+  {
+    return (double)_sumPixels(pb);
+  }
+}
+
 Envelope TileBoundsCalculator::_toEnvelope(const PixelBox& pb)
 {
   return Envelope(_envelope.MinX + pb.minX * _pixelSize,
@@ -152,6 +152,14 @@ public:
 
   std::vector< std::vector<geos::geom::Envelope> > calculateTiles();
 
+  /**
+   * Returns the estimated conflation cost of each tile produced by the last calculateTiles()
+   * call, in the same grid layout as the returned envelopes. The estimate is the number of
+   * candidate pairs implied by the node density rasters. A scheduler can use these to assign the
+   * most expensive tiles first (LPT) rather than treating all tiles as equal.
+   */
+  const std::vector< std::vector<double> >& getTileCosts() const { return _tileCosts; }
+
   void renderImage(boost::shared_ptr<OsmMap> map);
 
   void renderImage(boost::shared_ptr<OsmMap> map, cv::Mat& r1, cv::Mat& r2);
@@ -166,6 +174,15 @@ public:
    */
   void setMaxNodesPerBox(long max) { _maxNodesPerBox = max; }
 
+  /**
+   * When set to a value greater than zero the tree is split toward equal estimated conflation
+   * cost rather than equal node count, and grows until every box's estimated cost is less than
+   * or equal to this value. Cost is estimated as the number of Unknown1 x Unknown2 candidate
+   * pairs per pixel, which tracks conflation wall time much more closely than the raw node
+   * count. Disabled (zero) by default.
+   */
+  void setMaxCostPerBox(double max) { _maxCostPerBox = max; }
+
   /**
    * Set the slop. This is the percentage that the line can vary from center. A higher slop will
    * slightly better conflation results, but less efficient distribution. The default should be
@@ -175,13 +192,15 @@ public:
 
 private:
 
-  cv::Mat _r1, _r2, _min;
+  cv::Mat _r1, _r2, _min, _cost;
 
   double _pixelSize;
   OGREnvelope _envelope;
   long _maxNodesPerBox;
+  double _maxCostPerBox;
   double _slop;
   int32_t _maxValue;
+  std::vector< std::vector<double> > _tileCosts;
 
   void _calculateMin();
 
@@ -203,6 +222,14 @@ private:
 
   long _sumPixels(const PixelBox& pb) { return _sumPixels(pb, _r1) + _sumPixels(pb, _r2); }
 
+  double _sumCost(const PixelBox& pb);
+
+  /**
+   * The quantity the splits are balanced against; estimated cost when a max cost per box is set,
+   * otherwise the node count.
+   */
+  double _boxWeight(const PixelBox& pb);
+
   geos::geom::Envelope _toEnvelope(const PixelBox& pb);
 
   // used for white box testing.
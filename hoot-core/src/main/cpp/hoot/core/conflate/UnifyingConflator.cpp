@@ -39,14 +39,20 @@
 #include <hoot/core/conflate/polygon/BuildingMergerCreator.h>
 #include <hoot/core/io/OsmMapWriterFactory.h>
 #include <hoot/core/ops/NamedOp.h>
+#include <hoot/core/ops/RemoveElementOp.h>
+#include <hoot/core/util/Cancellation.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/MetadataTags.h>
+#include <hoot/core/util/Profiler.h>
 #include <hoot/core/conflate/MatchClassification.h>
 #include <hoot/core/elements/ElementId.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/schema/TranslateStringDistance.h>
+#include <hoot/core/visitors/MatchCandidateCountVisitor.h>
 
 // standard
 #include <algorithm>
+#include <queue>
 
 // tgs
 #include <tgs/System/SystemInfo.h>
@@ -128,28 +134,63 @@ void UnifyingConflator::apply(OsmMapPtr& map)
 
   _stats.append(SingleStat("Apply Pre Ops Time (sec)", timer.getElapsedAndRestart()));
 
+  // phase boundaries double as cancellation points; a cancelled conflation aborts with the map
+  // consistent and the already completed phases' work intact for checkpointing.
+  Cancellation::checkIn();
+
   // will reproject if necessary.
   MapProjector::projectToPlanar(map);
 
   _stats.append(SingleStat("Project to Planar Time (sec)", timer.getElapsedAndRestart()));
 
-  // find all the matches in this map
-  if (_matchThreshold.get())
+  if (ConfigOptions(_settings).getConflateMatchCandidateStats())
+  {
+    // one extra read-only pass over the map; gated because isMatchCandidate isn't free for the
+    // script creators.
+    MatchCandidateCountVisitor candidateCounter(_matchFactory.getCreators());
+    map->visitRo(candidateCounter);
+    QMap<QString, long> candidateCounts =
+      boost::any_cast<QMap<QString, long> >(candidateCounter.getData());
+    for (QMap<QString, long>::const_iterator it = candidateCounts.constBegin();
+         it != candidateCounts.constEnd(); ++it)
+    {
+      _stats.append(
+        SingleStat(QString("Match Candidates - %1").arg(it.key()), (double)it.value()));
+    }
+  }
+
+  if (ConfigOptions(_settings).getConflatePreTranslateNames())
   {
-    //ScoreMatches logic seems to be the only one that needs to pass in the match threshold now when
-    //the optimize param is activated.  Otherwise, we get the match threshold information from the
-    //config.
-    _matchFactory.createMatches(map, _matches, _bounds, _matchThreshold);
+    // warm the process wide translation cache on worker threads so transliteration doesn't show
+    // up in the match phase.
+    TranslateStringDistance::preTranslateNames(map);
+    _stats.append(SingleStat("Pre Translate Names Time (sec)", timer.getElapsedAndRestart()));
   }
-  else
+
+  Cancellation::checkIn();
+
+  // find all the matches in this map
   {
-    _matchFactory.createMatches(map, _matches, _bounds);
+    ProfileScope profile("find matches");
+    if (_matchThreshold.get())
+    {
+      //ScoreMatches logic seems to be the only one that needs to pass in the match threshold now
+      //when the optimize param is activated.  Otherwise, we get the match threshold information
+      //from the config.
+      _matchFactory.createMatches(map, _matches, _bounds, _matchThreshold);
+    }
+    else
+    {
+      _matchFactory.createMatches(map, _matches, _bounds);
+    }
   }
   LOG_DEBUG("Match count: " << _matches.size());
   LOG_TRACE(SystemInfo::getMemoryUsageString());
 
   double findMatchesTime = timer.getElapsedAndRestart();
   _stats.append(SingleStat("Find Matches Time (sec)", findMatchesTime));
+  // fold in the per creator timing and match counts collected by the factory.
+  _stats.append(_matchFactory.getStats());
   _stats.append(SingleStat("Number of Matches Found", _matches.size()));
   _stats.append(SingleStat("Number of Matches Found per Second",
     (double)_matches.size() / findMatchesTime));
@@ -170,8 +211,11 @@ void UnifyingConflator::apply(OsmMapPtr& map)
   LOG_DEBUG("Number of Whole Groups: " << matchSets.size());
   LOG_DEBUG("Number of Matches After Whole Groups: " << _matches.size());
 
+  Cancellation::checkIn();
+
   // Globally optimize the set of matches to maximize the conflation score.
   {
+    ProfileScope profile("optimize matches");
     OptimalConstrainedMatches cm(map);
     vector<const Match*> cmMatches;
 
@@ -241,11 +285,16 @@ void UnifyingConflator::apply(OsmMapPtr& map)
   LOG_TRACE(SystemInfo::getMemoryUsageString());
   /// @todo would it help to sort the matches so the biggest or best ones get merged first?
 
+  Cancellation::checkIn();
+
   // convert all the match sets into mergers.
   LOG_INFO("Creating mergers...");
-  for (size_t i = 0; i < matchSets.size(); ++i)
   {
-    _mergerFactory->createMergers(map, matchSets[i], _mergers);
+    ProfileScope profile("create mergers");
+    for (size_t i = 0; i < matchSets.size(); ++i)
+    {
+      _mergerFactory->createMergers(map, matchSets[i], _mergers);
+    }
   }
 
   LOG_TRACE(SystemInfo::getMemoryUsageString());
@@ -260,17 +309,12 @@ void UnifyingConflator::apply(OsmMapPtr& map)
   _stats.append(SingleStat("Create Mergers Time (sec)", timer.getElapsedAndRestart()));
 
   LOG_INFO("Applying " << _mergers.size() << " mergers...");
-  vector< pair<ElementId, ElementId> > replaced;
-  for (size_t i = 0; i < _mergers.size(); ++i)
+  size_t batchCount;
   {
-    LOG_TRACE(
-      "Applying merger: " << i + 1 << " / " << _mergers.size() << " - " << _mergers[i]->toString());
-    _mergers[i]->apply(map, replaced);
-
-    // update any mergers that reference the replaced values
-    _replaceElementIds(replaced);
-    replaced.clear();
+    ProfileScope profile("apply mergers");
+    batchCount = _applyMergers(map);
   }
+  _stats.append(SingleStat("Number of Merger Batches", batchCount));
   if (Log::getInstance().getLevel() == Log::Debug)
   {
     cout << endl;
@@ -297,6 +341,283 @@ void UnifyingConflator::apply(OsmMapPtr& map)
   _stats.append(SingleStat("Apply Post Ops Time (sec)", timer.getElapsedAndRestart()));
 }
 
+void UnifyingConflator::applyIncremental(OsmMapPtr& map, ChangeSetProviderPtr changes)
+{
+  geos::geom::Envelope dirty;
+  int changeCount = 0;
+
+  while (changes->hasMoreChanges())
+  {
+    Change c = changes->readNextChange();
+    if (c.getType() == Change::Unknown || c.getElement() == 0)
+    {
+      continue;
+    }
+    ElementId eid = c.getElement()->getElementId();
+
+    // the neighborhood around the old version of the element is dirty too - a feature that moved
+    // away may release a match it used to hold.
+    if (map->containsElement(eid))
+    {
+      auto_ptr<geos::geom::Envelope> env(map->getElement(eid)->getEnvelope(map));
+      if (env->isNull() == false)
+      {
+        dirty.expandToInclude(env.get());
+      }
+    }
+
+    switch (c.getType())
+    {
+    case Change::Create:
+      map->addElement(ElementPtr(c.getElement()->clone()));
+      break;
+    case Change::Modify:
+      if (map->containsElement(eid))
+      {
+        map->replace(map->getElement(eid), ElementPtr(c.getElement()->clone()));
+      }
+      else
+      {
+        map->addElement(ElementPtr(c.getElement()->clone()));
+      }
+      break;
+    case Change::Delete:
+      if (map->containsElement(eid))
+      {
+        RemoveElementOp::removeElement(map, eid);
+      }
+      break;
+    default:
+      break;
+    }
+
+    if (map->containsElement(eid))
+    {
+      auto_ptr<geos::geom::Envelope> env(map->getElement(eid)->getEnvelope(map));
+      if (env->isNull() == false)
+      {
+        dirty.expandToInclude(env.get());
+      }
+    }
+    changeCount++;
+  }
+  LOG_INFO("Applied " << changeCount << " changes.");
+
+  if (changeCount == 0 || dirty.isNull())
+  {
+    return;
+  }
+
+  dirty.expandBy(ConfigOptions(_settings).getConflateIncrementalBuffer());
+  LOG_INFO("Re-conflating dirty region: " << dirty.toString());
+  setBounds(dirty);
+  apply(map);
+}
+
+void UnifyingConflator::applyStreaming(OsmMapPtr& map, MergeListener& listener)
+{
+  Timer timer;
+  _reset();
+
+  LOG_INFO("Applying pre-unifying conflation operations...");
+  NamedOp(ConfigOptions().getUnifyPreOps()).apply(map);
+  _stats.append(SingleStat("Apply Pre Ops Time (sec)", timer.getElapsedAndRestart()));
+
+  Cancellation::checkIn();
+
+  // will reproject if necessary.
+  MapProjector::projectToPlanar(map);
+
+  if (ConfigOptions(_settings).getConflatePreTranslateNames())
+  {
+    TranslateStringDistance::preTranslateNames(map);
+  }
+
+  // find all the matches in this map
+  {
+    ProfileScope profile("find matches");
+    if (_matchThreshold.get())
+    {
+      _matchFactory.createMatches(map, _matches, _bounds, _matchThreshold);
+    }
+    else
+    {
+      _matchFactory.createMatches(map, _matches, _bounds);
+    }
+  }
+  LOG_DEBUG("Match count: " << _matches.size());
+  _stats.append(SingleStat("Find Matches Time (sec)", timer.getElapsedAndRestart()));
+
+  vector<const Match*> allMatches = _matches;
+  _addReviewTags(map, allMatches);
+
+  // whole groups must be merged as-is, so they bypass the per component optimization below.
+  MatchSetVector matchSets;
+  _removeWholeGroups(_matches, matchSets, map);
+  const size_t wholeGroupCount = matchSets.size();
+
+  // the remaining matches break into connected components (subgraphs interrelated by element
+  // id). Matches can only conflict when their components overlap by element, so each component
+  // can be optimized and merged without looking at any other.
+  {
+    MatchGraph mg;
+    mg.addMatches(_matches.begin(), _matches.end());
+    MatchSetVector tmpMatchSets = mg.findSubgraphs(map);
+    matchSets.insert(matchSets.end(), tmpMatchSets.begin(), tmpMatchSets.end());
+  }
+  LOG_DEBUG("Match sets count: " << matchSets.size());
+  _stats.append(SingleStat("Build Components Time (sec)", timer.getElapsedAndRestart()));
+
+  Cancellation::checkIn();
+
+  // order the components by their best match score so the listener sees the high confidence
+  // merges first. Time to first result is the point of this mode, so the merge work hasn't been
+  // done yet when the ordering is established - only the match scores are needed for that.
+  priority_queue< pair<double, size_t> > heap;
+  for (size_t i = 0; i < matchSets.size(); ++i)
+  {
+    double best = 0.0;
+    for (MatchSet::const_iterator it = matchSets[i].begin(); it != matchSets[i].end(); ++it)
+    {
+      best = max(best, (*it)->getScore());
+    }
+    heap.push(pair<double, size_t>(best, i));
+  }
+
+  LOG_INFO("Merging " << matchSets.size() << " match components, best first...");
+  while (heap.empty() == false)
+  {
+    // a component boundary is a cancellation point; everything merged so far is consistent.
+    Cancellation::checkIn();
+
+    const double score = heap.top().first;
+    const size_t index = heap.top().second;
+    heap.pop();
+
+    // resolve conflicts inside the component. The optimal solver is skipped on purpose: the
+    // components are small enough that the greedy solution is nearly always identical and the
+    // solver's setup cost would delay every result behind it.
+    MatchSet resolved = matchSets[index];
+    if (index >= wholeGroupCount && resolved.size() > 1)
+    {
+      GreedyConstrainedMatches gm(map);
+      gm.addMatches(resolved.begin(), resolved.end());
+      vector<const Match*> subset = gm.calculateSubset();
+      resolved = MatchSet(subset.begin(), subset.end());
+    }
+
+    vector<Merger*> mergers;
+    _mergerFactory->createMergers(map, resolved, mergers);
+
+    // apply the component's mergers immediately. Components don't share element ids, so id
+    // replacements only need to propagate to the rest of this component.
+    vector< pair<ElementId, ElementId> > replaced;
+    set<ElementId> impacted;
+    for (size_t j = 0; j < mergers.size(); ++j)
+    {
+      set<ElementId> ids = mergers[j]->getImpactedElementIds();
+      impacted.insert(ids.begin(), ids.end());
+      mergers[j]->apply(map, replaced);
+      for (size_t k = 0; k < replaced.size(); ++k)
+      {
+        for (size_t l = j + 1; l < mergers.size(); ++l)
+        {
+          mergers[l]->replace(replaced[k].first, replaced[k].second);
+        }
+      }
+      replaced.clear();
+    }
+    // keep the mergers around so unknown1 id mapping and _reset see them.
+    _mergers.insert(_mergers.end(), mergers.begin(), mergers.end());
+
+    listener.componentMerged(score, impacted);
+  }
+
+  _deleteAll(allMatches);
+  _matches.clear();
+  _stats.append(SingleStat("Number of Mergers Applied", _mergers.size()));
+  _stats.append(SingleStat("Apply Mergers Time (sec)", timer.getElapsedAndRestart()));
+
+  if (ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures())
+  {
+    _mapUnknown1IdsBackToModifiedElements(map);
+  }
+
+  // free up any used resources.
+  _reset();
+
+  LOG_INFO("Applying post-unifying conflation operations...");
+  NamedOp(ConfigOptions().getUnifyPostOps()).apply(map);
+  _stats.append(SingleStat("Apply Post Ops Time (sec)", timer.getElapsedAndRestart()));
+}
+
+size_t UnifyingConflator::_applyMergers(const OsmMapPtr& map)
+{
+  size_t applied = 0;
+  size_t batchCount = 0;
+  vector<bool> done(_mergers.size(), false);
+  vector< pair<ElementId, ElementId> > replaced;
+
+  while (applied < _mergers.size())
+  {
+    // batch boundaries are cancellation points: the element id replacements for the previous
+    // batch have been propagated, so the map is consistent here.
+    Cancellation::checkIn();
+
+    // Greedily build a batch of mergers whose element id footprints don't overlap. To preserve
+    // the original application order between conflicting mergers, a merger is only admitted to
+    // the batch if it is also disjoint from every merger that has been passed over for this
+    // batch.
+    set<ElementId> batchFootprint;
+    set<ElementId> deferredFootprint;
+    vector<size_t> batch;
+    for (size_t i = 0; i < _mergers.size(); ++i)
+    {
+      if (done[i])
+      {
+        continue;
+      }
+      set<ElementId> impacted = _mergers[i]->getImpactedElementIds();
+      bool disjoint = true;
+      for (set<ElementId>::const_iterator it = impacted.begin();
+           disjoint && it != impacted.end(); ++it)
+      {
+        if (batchFootprint.count(*it) > 0 || deferredFootprint.count(*it) > 0)
+        {
+          disjoint = false;
+        }
+      }
+      if (disjoint)
+      {
+        batchFootprint.insert(impacted.begin(), impacted.end());
+        batch.push_back(i);
+      }
+      else
+      {
+        deferredFootprint.insert(impacted.begin(), impacted.end());
+      }
+    }
+
+    // the mergers in a batch are pairwise independent, so no replacement made by one member is
+    // relevant to another and the propagation only needs to run once for the whole batch.
+    for (size_t j = 0; j < batch.size(); ++j)
+    {
+      size_t i = batch[j];
+      LOG_TRACE(
+        "Applying merger: " << applied + 1 << " / " << _mergers.size() << " - " <<
+        _mergers[i]->toString());
+      _mergers[i]->apply(map, replaced);
+      done[i] = true;
+      applied++;
+    }
+    _replaceElementIds(replaced);
+    replaced.clear();
+    batchCount++;
+  }
+
+  return batchCount;
+}
+
 bool elementIdPairCompare(const pair<ElementId, ElementId>& pair1,
                           const pair<ElementId, ElementId>& pair2)
 {
@@ -29,6 +29,7 @@
 
 // hoot
 #include <hoot/core/OsmMap.h>
+#include <hoot/core/io/ChangesetProvider.h>
 #include <hoot/core/io/Serializable.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 #include <hoot/core/ops/Boundable.h>
@@ -70,6 +71,28 @@ class UnifyingConflator : public OsmMapOperation, public Serializable, public Bo
 public:
   static std::string className() { return "hoot::UnifyingConflator"; }
 
+  /**
+   * Receives per component results from applyStreaming as soon as each connected component of
+   * matches has been resolved and merged. Implementations are called from the conflation thread
+   * and should hand the result off quickly (e.g. queue it for the review UI) rather than doing
+   * heavy work inline.
+   */
+  class MergeListener
+  {
+  public:
+
+    virtual ~MergeListener() {}
+
+    /**
+     * Called after the mergers for one connected component of matches have been applied to the
+     * map. Components are delivered in descending score order, so the first calls carry the
+     * highest confidence merges.
+     * @param score the score of the best match in the component
+     * @param impacted the element ids the component's mergers reported as impacted
+     */
+    virtual void componentMerged(double score, const std::set<ElementId>& impacted) = 0;
+  };
+
   UnifyingConflator();
 
   UnifyingConflator(boost::shared_ptr<MatchThreshold> matchThreshold);
@@ -82,6 +105,28 @@ public:
    */
   virtual void apply(OsmMapPtr& map);
 
+  /**
+   * Incrementally conflates a previously conflated map against a changeset (e.g. from
+   * ChangesetDeriver). The changes are applied to the map, the dirty region is computed from the
+   * old and new versions of every changed element and buffered by
+   * conflate.incremental.buffer, and matching is then restricted to that region via the normal
+   * Boundable mechanism. Elements outside the dirty region are untouched, so re-conflating a
+   * large region with a small changeset only pays for the changed neighborhoods. If the
+   * changeset is empty the map is left as is.
+   */
+  void applyIncremental(OsmMapPtr& map, ChangeSetProviderPtr changes);
+
+  /**
+   * Conflates the specified map like apply, but emits results incrementally instead of all at
+   * once. After the match phase the connected components of the match graph are ordered by their
+   * best match score and merged one at a time, best first, with conflict resolution localized to
+   * the component being merged. The listener is notified as each component lands, so a caller
+   * can stream high confidence merges to a review UI while the low confidence remainder is still
+   * being resolved. The final map is equivalent to apply's output except that matches are
+   * optimized per component (greedy) rather than globally.
+   */
+  void applyStreaming(OsmMapPtr& map, MergeListener& listener);
+
   virtual std::string getClassName() const { return className(); }
 
   QList<SingleStat> getStats() const { return _stats; }
@@ -114,6 +159,13 @@ private:
   void _addReviewTags(const OsmMapPtr &map, const std::vector<const Match *> &matches);
   void _addScoreTags(const ElementPtr& e, const MatchClassification& mc);
 
+  /**
+   * Applies all the mergers in _mergers to the map. The mergers are scheduled into batches whose
+   * element id footprints don't overlap, so element id replacements only have to be propagated
+   * once per batch rather than after every merger. Returns the number of batches.
+   */
+  size_t _applyMergers(const OsmMapPtr& map);
+
   template <typename InputCollection>
   void _deleteAll(InputCollection& ic)
   {
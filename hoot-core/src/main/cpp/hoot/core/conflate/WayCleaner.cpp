@@ -26,6 +26,7 @@
  */
 #include "WayCleaner.h"
 
+#include <hoot/core/ops/RemoveWayOp.h>
 #include <hoot/core/util/Log.h>
 
 using namespace geos::geom;
@@ -259,4 +260,36 @@ vector<ConstWayPtr> WayCleaner::cleanWays(const vector<ConstWayPtr>& ways, const
   return cleanedWays;
 }
 
+void WayCleaner::cleanWays(OsmMapPtr map)
+{
+  //collect the flagged ids first; removing a way invalidates iterators into the way map
+  vector<long> flaggedWayIds;
+  const WayMap& ways = map->getWays();
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    if (it->second->getCleanRequired())
+    {
+      flaggedWayIds.push_back(it->first);
+    }
+  }
+
+  for (size_t i = 0; i < flaggedWayIds.size(); i++)
+  {
+    WayPtr way = map->getWay(flaggedWayIds[i]);
+    if (isZeroLengthWay(way, map))
+    {
+      RemoveWayOp::removeWay(map, flaggedWayIds[i]);
+    }
+    else
+    {
+      if (hasDuplicateNodes(way) || hasDuplicateCoords(way, *map))
+      {
+        cleanWay(way, map);
+      }
+      //cleaning rewrites the node list, which re-flags the way, so clear the flag afterward
+      way->setCleanRequired(false);
+    }
+  }
+}
+
 }
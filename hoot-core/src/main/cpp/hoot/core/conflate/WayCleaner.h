@@ -107,6 +107,18 @@ class WayCleaner
      * @return a collection of unmodifiable cleaned ways
      */
     static std::vector<ConstWayPtr> cleanWays(const std::vector<ConstWayPtr>& ways, const ConstOsmMapPtr& map);
+
+    /**
+     * Cleans only the ways in the map whose clean required flag is set
+     *
+     * The node list mutators set the flag, so after an op chain runs this visits just the ways
+     * the ops touched rather than scanning the whole map.  Flagged zero length ways are removed
+     * and duplicate nodes and coordinates are cleaned from the rest; the flag is cleared on every
+     * way visited.
+     *
+     * @param map the map to be cleaned
+     */
+    static void cleanWays(OsmMapPtr map);
 };
 
 }
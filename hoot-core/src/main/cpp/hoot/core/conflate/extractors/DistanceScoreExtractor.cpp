@@ -28,6 +28,7 @@
 
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/algorithms/ProbabilityOfMatch.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 
 namespace hoot
 {
@@ -40,4 +41,12 @@ double DistanceScoreExtractor::_extract(const OsmMap& map, const ConstWayPtr& w1
   return ProbabilityOfMatch::getInstance().distanceScore(map.shared_from_this(), w1, w2);
 }
 
+double DistanceScoreExtractor::_extract(const OsmMap& map, const ConstWayPtr& w1,
+                                        const ConstWayPtr& w2,
+                                        FeatureExtractionContext& context) const
+{
+  return ProbabilityOfMatch::getInstance().distanceScore(map.shared_from_this(), w1,
+    context.getLineString(w2), w2->getCircularError());
+}
+
 }
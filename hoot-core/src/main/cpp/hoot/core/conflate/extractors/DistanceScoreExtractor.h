@@ -49,6 +49,9 @@ public:
 protected:
 
   double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2) const;
+
+  virtual double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2,
+    FeatureExtractionContext& context) const;
 };
 
 }
@@ -0,0 +1,124 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "FeatureExtractionContext.h"
+
+// geos
+#include <geos/geom/Geometry.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+
+// hoot
+#include <hoot/core/algorithms/WayDiscretizer.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+FeatureExtractionContext::FeatureExtractionContext(const ConstOsmMapPtr& map) :
+_map(map),
+_converter(map)
+{
+}
+
+boost::shared_ptr<Geometry> FeatureExtractionContext::getGeometry(const ConstElementPtr& e)
+{
+  QHash<ElementId, boost::shared_ptr<Geometry> >::const_iterator it =
+    _geometries.find(e->getElementId());
+  if (it != _geometries.end())
+  {
+    return it.value();
+  }
+
+  boost::shared_ptr<Geometry> result = _converter.convertToGeometry(e);
+  _geometries.insert(e->getElementId(), result);
+  return result;
+}
+
+boost::shared_ptr<LineString> FeatureExtractionContext::getLineString(const ConstWayPtr& w)
+{
+  QHash<ElementId, boost::shared_ptr<LineString> >::const_iterator it =
+    _lineStrings.find(w->getElementId());
+  if (it != _lineStrings.end())
+  {
+    return it.value();
+  }
+
+  boost::shared_ptr<LineString> result = _converter.convertToLineString(w);
+  _lineStrings.insert(w->getElementId(), result);
+  return result;
+}
+
+Meters FeatureExtractionContext::getLength(const ConstElementPtr& e)
+{
+  QHash<ElementId, Meters>::const_iterator it = _lengths.find(e->getElementId());
+  if (it != _lengths.end())
+  {
+    return it.value();
+  }
+
+  const Meters result = _converter.calculateLength(e);
+  _lengths.insert(e->getElementId(), result);
+  return result;
+}
+
+boost::shared_ptr<Point> FeatureExtractionContext::getCentroid(const ConstElementPtr& e)
+{
+  QHash<ElementId, boost::shared_ptr<Point> >::const_iterator it =
+    _centroids.find(e->getElementId());
+  if (it != _centroids.end())
+  {
+    return it.value();
+  }
+
+  boost::shared_ptr<Point> result;
+  boost::shared_ptr<Geometry> g = getGeometry(e);
+  if (g.get() != 0 && g->isEmpty() == false)
+  {
+    result.reset(g->getCentroid());
+  }
+  _centroids.insert(e->getElementId(), result);
+  return result;
+}
+
+const vector<Coordinate>& FeatureExtractionContext::getDiscretizedPoints(const ConstWayPtr& w,
+  double spacing)
+{
+  pair<double, boost::shared_ptr<vector<Coordinate> > >& entry =
+    _discretizedPoints[w->getElementId()];
+  if (entry.second.get() == 0 || entry.first != spacing)
+  {
+    entry.first = spacing;
+    entry.second.reset(new vector<Coordinate>());
+    WayDiscretizer wd(_map, w);
+    wd.discretize(spacing, *entry.second);
+  }
+  return *entry.second;
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef FEATUREEXTRACTIONCONTEXT_H
+#define FEATUREEXTRACTIONCONTEXT_H
+
+// geos
+#include <geos/geom/Coordinate.h>
+
+// hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/util/ElementConverter.h>
+
+// Qt
+#include <QHash>
+
+// Standard
+#include <utility>
+#include <vector>
+
+namespace geos
+{
+namespace geom
+{
+class Geometry;
+class LineString;
+class Point;
+}
+}
+
+namespace hoot
+{
+
+/**
+ * Memoizes the intermediate geometric products (geometries, line strings, lengths, centroids,
+ * discretized points) that several FeatureExtractors derive from the same elements. The
+ * classifiers create one context per element pair and pass it through their extractor list so
+ * sibling extractors share these reductions instead of each recomputing them.
+ *
+ * A context is cheap to construct when nothing is requested from it and is not thread safe;
+ * share it only within a single classification call.
+ */
+class FeatureExtractionContext
+{
+public:
+
+  FeatureExtractionContext(const ConstOsmMapPtr& map);
+
+  /**
+   * Returns the geometry for e as ElementConverter::convertToGeometry would.
+   */
+  boost::shared_ptr<geos::geom::Geometry> getGeometry(const ConstElementPtr& e);
+
+  /**
+   * Returns the line string for w as ElementConverter::convertToLineString would.
+   */
+  boost::shared_ptr<geos::geom::LineString> getLineString(const ConstWayPtr& w);
+
+  /**
+   * Returns the length of e as ElementConverter::calculateLength would.
+   */
+  Meters getLength(const ConstElementPtr& e);
+
+  /**
+   * Returns the centroid of e's geometry, or an empty pointer if no centroid can be calculated.
+   */
+  boost::shared_ptr<geos::geom::Point> getCentroid(const ConstElementPtr& e);
+
+  /**
+   * Returns w discretized into points spacing meters apart. Only the most recently requested
+   * spacing is cached per way; in practice the extractors all sample at the same spacing. The
+   * reference is valid until the next call with the same way and a different spacing.
+   */
+  const std::vector<geos::geom::Coordinate>& getDiscretizedPoints(const ConstWayPtr& w,
+    double spacing);
+
+private:
+
+  ConstOsmMapPtr _map;
+  ElementConverter _converter;
+
+  QHash<ElementId, boost::shared_ptr<geos::geom::Geometry> > _geometries;
+  QHash<ElementId, boost::shared_ptr<geos::geom::LineString> > _lineStrings;
+  QHash<ElementId, Meters> _lengths;
+  QHash<ElementId, boost::shared_ptr<geos::geom::Point> > _centroids;
+  QHash<ElementId, std::pair<double, boost::shared_ptr<std::vector<geos::geom::Coordinate> > > >
+    _discretizedPoints;
+};
+
+}
+
+#endif // FEATUREEXTRACTIONCONTEXT_H
@@ -35,6 +35,8 @@
 
 // Standard
 #include <string>
+#include <utility>
+#include <vector>
 
 // tgs
 #include <tgs/SharedPtr.h>
@@ -43,6 +45,8 @@
 namespace hoot
 {
 
+class FeatureExtractionContext;
+
 /**
  * Extracts a single feature (AKA factor) for a given element pair.
  */
@@ -60,6 +64,36 @@ public:
   virtual double extract(const OsmMap& map, const boost::shared_ptr<const Element>& target,
     const boost::shared_ptr<const Element>& candidate) const = 0;
 
+  /**
+   * Context aware variant of extract(). The classifiers pass one context through their whole
+   * extractor list so intermediate products (geometries, lengths, etc.) derived from the same
+   * pair are shared across sibling extractors. The default implementation simply ignores the
+   * context; extractors that can reuse memoized products override it.
+   */
+  virtual double extract(const OsmMap& map, const boost::shared_ptr<const Element>& target,
+    const boost::shared_ptr<const Element>& candidate, FeatureExtractionContext& /*context*/)
+    const
+  {
+    return extract(map, target, candidate);
+  }
+
+  /**
+   * Extracts the feature for an array of pairs, sharing one context across all of them. The
+   * default implementation is a scalar loop; it is the hook for implementations that process
+   * many pairs at once (e.g. with vectorized kernels).
+   */
+  virtual void extract(const OsmMap& map,
+    const std::vector< std::pair<boost::shared_ptr<const Element>,
+      boost::shared_ptr<const Element> > >& pairs,
+    FeatureExtractionContext& context, std::vector<double>& result) const
+  {
+    result.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+      result[i] = extract(map, pairs[i].first, pairs[i].second, context);
+    }
+  }
+
   virtual std::string getClassName() const = 0;
 
   virtual std::string getName() const { return getClassName(); }
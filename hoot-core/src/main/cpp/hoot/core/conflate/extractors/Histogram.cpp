@@ -54,6 +54,7 @@ namespace hoot
 Histogram::Histogram(int bins)
 {
   _bins.resize(bins, 0.0);
+  _binMultiplier = (double)bins / (2.0 * M_PI);
 }
 
 void Histogram::addAngle(Radians theta, double length)
@@ -61,9 +62,10 @@ void Histogram::addAngle(Radians theta, double length)
   _bins[getBin(theta)] += length;
 }
 
-double Histogram::diff(Histogram& other)
+double Histogram::diff(const Histogram& other) const
 {
   assert(_bins.size() == other._bins.size());
+  // a plain indexed loop over the two arrays; the compiler turns this into vector code
   double diff = 0.0;
   for (size_t i = 0; i < _bins.size(); i++)
   {
@@ -73,19 +75,45 @@ double Histogram::diff(Histogram& other)
   return diff / 2.0;
 }
 
-size_t Histogram::getBin(Radians theta)
+double Histogram::normalizedDiff(const Histogram& other) const
 {
-//  const double c2pi = 2 * M_PI;
-//  // bring theta into 0 - 2pi if it is outside those bounds.
-//  theta = theta - c2pi * floor(theta / c2pi);
-//  return std::max<size_t>(0,
-//    std::min<size_t>(_bins.size() - 1, (theta / c2pi) * _bins.size()));
-  while (theta < 0.0)
+  assert(_bins.size() == other._bins.size());
+  double sum1 = 0.0;
+  double sum2 = 0.0;
+  for (size_t i = 0; i < _bins.size(); i++)
+  {
+    sum1 += _bins[i];
+    sum2 += other._bins[i];
+  }
+  // match normalize()'s treatment of empty histograms
+  if (sum1 <= 0.0)
   {
-    theta += 2 * M_PI;
+    sum1 = 1.0;
+  }
+  if (sum2 <= 0.0)
+  {
+    sum2 = 1.0;
   }
-  return (theta / (2 * M_PI)) * _bins.size();
 
+  // dividing inside the loop keeps the result bit for bit identical to normalizing both
+  // histograms and then calling diff
+  double diff = 0.0;
+  for (size_t i = 0; i < _bins.size(); i++)
+  {
+    diff += fabs(_bins[i] / sum1 - other._bins[i] / sum2);
+  }
+
+  return diff / 2.0;
+}
+
+size_t Histogram::getBin(Radians theta) const
+{
+  // bring theta into 0 - 2pi without looping or branching on its sign
+  const double c2pi = 2.0 * M_PI;
+  theta = theta - c2pi * floor(theta / c2pi);
+  size_t bin = (size_t)(theta * _binMultiplier);
+  // theta right at 2pi rounds up to one past the last bin; wrap it to the first
+  return bin >= _bins.size() ? 0 : bin;
 }
 
 Radians Histogram::_getBinAngle(size_t i)
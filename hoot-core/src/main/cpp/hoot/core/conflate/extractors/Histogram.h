@@ -52,7 +52,7 @@ public:
 
   void addAngle(Radians theta, double length);
 
-  size_t getBin(Radians theta);
+  size_t getBin(Radians theta) const;
 
   /**
    * Returns the angle of the center of the specified bin.
@@ -67,7 +67,15 @@ public:
   /**
    * Returns a value from 0.0 to 1.0 describing the diff. 1.0 is exactly the same.
    */
-  double diff(Histogram& other);
+  double diff(const Histogram& other) const;
+
+  /**
+   * Returns the same value diff would return if both histograms were normalized first, but
+   * without modifying either histogram or making copies. This is what sits in the extractor
+   * inner loop, so the bin sums are folded into the comparison rather than materializing
+   * normalized histograms.
+   */
+  double normalizedDiff(const Histogram& other) const;
 
   /**
    * Smooth the histogram with a gaussian filter with the specified sigma.
@@ -79,6 +87,8 @@ public:
 private:
 
   std::vector<double> _bins;
+  // bins per radian; lets getBin multiply instead of divide
+  double _binMultiplier;
 
   Radians _getBinAngle(size_t i);
 
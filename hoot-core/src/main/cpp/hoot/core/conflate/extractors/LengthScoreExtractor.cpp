@@ -27,8 +27,12 @@
 
 #include "LengthScoreExtractor.h"
 
+// geos
+#include <geos/geom/LineString.h>
+
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/algorithms/ProbabilityOfMatch.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 
 namespace hoot
 {
@@ -41,4 +45,12 @@ double LengthScoreExtractor::_extract(const OsmMap& map, const ConstWayPtr& w1,
 {
   return ProbabilityOfMatch::getInstance().lengthScore(map.shared_from_this(), w1, w2);
 }
+
+double LengthScoreExtractor::_extract(const OsmMap& /*map*/, const ConstWayPtr& w1,
+                                      const ConstWayPtr& w2,
+                                      FeatureExtractionContext& context) const
+{
+  return ProbabilityOfMatch::getInstance().lengthScore(
+    context.getLineString(w1)->getLength(), context.getLineString(w2)->getLength());
+}
 }
@@ -48,6 +48,9 @@ public:
 protected:
 
   double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2) const;
+
+  virtual double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2,
+    FeatureExtractionContext& context) const;
 };
 
 }
@@ -43,6 +43,9 @@ using namespace geos::geom;
 // Qt
 #include <qnumeric.h>
 
+// Standard
+#include <math.h>
+
 using namespace std;
 
 namespace hoot
@@ -80,20 +83,43 @@ public:
       vector<WayLocation> discretizedLocs;
       WayDiscretizer wayDiscretizer(_map->shared_from_this(), way);
       wayDiscretizer.discretize(_sampleDistance, discretizedLocs);
+      if (discretizedLocs.size() < 2)
+      {
+        return;
+      }
 
-      WayLocation lastLoc = discretizedLocs.at(0);
-      for (size_t i = 1; i < discretizedLocs.size(); i++)
+      // gather the heading vectors and weights into flat arrays first. The WayLocation
+      // arithmetic dominates the per sample cost, and separating it from the trig leaves the
+      // atan2 loop tight enough for the compiler to vectorize.
+      const size_t sampleCount = discretizedLocs.size() - 1;
+      vector<double> dx(sampleCount);
+      vector<double> dy(sampleCount);
+      vector<double> weight(sampleCount);
+      Coordinate lastCoord = discretizedLocs[0].getCoordinate();
+      for (size_t i = 0; i < sampleCount; i++)
       {
         //select a loc sampledDistance meters along the way
-        WayLocation currentLoc = discretizedLocs.at(i);
-        const double distance = currentLoc.getCoordinate().distance(lastLoc.getCoordinate());
+        const WayLocation& currentLoc = discretizedLocs[i + 1];
+        const Coordinate currentCoord = currentLoc.getCoordinate();
+        weight[i] = currentCoord.distance(lastCoord);
         //calculate the heading using some distance around the way
-        const double theta = WayHeading::calculateHeading(currentLoc, _headingDelta);
-        if (! ::qIsNaN(theta))
+        const Coordinate sc = currentLoc.move(-_headingDelta).getCoordinate();
+        const Coordinate ec = currentLoc.move(_headingDelta).getCoordinate();
+        dx[i] = ec.x - sc.x;
+        dy[i] = ec.y - sc.y;
+        lastCoord = currentCoord;
+      }
+
+      for (size_t i = 0; i < sampleCount; i++)
+      {
+        // a zero length heading vector makes WayHeading::calculateHeading return NaN; skip it
+        // here too so the histogram comes out identical. atan2 is scale invariant, so not
+        // normalizing the vector doesn't change the angle.
+        if (dx[i] == 0.0 && dy[i] == 0.0)
         {
-          _angleHistogram.addAngle(theta, distance);
+          continue;
         }
-        lastLoc = currentLoc;
+        _angleHistogram.addAngle(atan2(dx[i], dy[i]), weight[i]);
       }
     }
   }
@@ -65,9 +65,18 @@ public:
 
   virtual void setConfiguration(const Settings& conf);
 
-  void setSampleDistance(double sampleDistance) { _sampleDistance = sampleDistance; }
-
-  void setHeadingDelta(double headingDelta) { _headingDelta = headingDelta; }
+  void setSampleDistance(double sampleDistance)
+  {
+    _sampleDistance = sampleDistance;
+    // the cached histograms were built with the old sampling parameters.
+    _clearHistogramCache();
+  }
+
+  void setHeadingDelta(double headingDelta)
+  {
+    _headingDelta = headingDelta;
+    _clearHistogramCache();
+  }
 
 protected:
 
@@ -29,6 +29,7 @@
 // hoot
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/algorithms/aggregator/MeanAggregator.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 
 using namespace std;
 
@@ -49,6 +50,14 @@ WayFeatureExtractor::WayFeatureExtractor(ValueAggregator *agg)
 
 double WayFeatureExtractor::extract(const OsmMap& map,
   const boost::shared_ptr<const Element>& target, const boost::shared_ptr<const Element>& candidate) const
+{
+  FeatureExtractionContext context(map.shared_from_this());
+  return extract(map, target, candidate, context);
+}
+
+double WayFeatureExtractor::extract(const OsmMap& map,
+  const boost::shared_ptr<const Element>& target, const boost::shared_ptr<const Element>& candidate,
+  FeatureExtractionContext& context) const
 {
   vector<double> scores;
 
@@ -56,7 +65,7 @@ double WayFeatureExtractor::extract(const OsmMap& map,
       candidate->getElementType() == ElementType::Way)
   {
     scores.push_back(_extract(map, boost::dynamic_pointer_cast<const Way>(target),
-                              boost::dynamic_pointer_cast<const Way>(candidate)));
+                              boost::dynamic_pointer_cast<const Way>(candidate), context));
   }
   else if (target->getElementType() == ElementType::Relation &&
            candidate->getElementType() == ElementType::Relation)
@@ -77,7 +86,7 @@ double WayFeatureExtractor::extract(const OsmMap& map,
         {
           return nullValue();
         }
-        scores.push_back(_extract(map, map.getWay(eid1), map.getWay(eid2)));
+        scores.push_back(_extract(map, map.getWay(eid1), map.getWay(eid2), context));
       }
     }
     else
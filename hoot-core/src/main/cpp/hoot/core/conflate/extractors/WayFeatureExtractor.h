@@ -53,6 +53,9 @@ public:
   virtual double extract(const OsmMap& map, const boost::shared_ptr<const Element>& target,
     const boost::shared_ptr<const Element>& candidate) const;
 
+  virtual double extract(const OsmMap& map, const boost::shared_ptr<const Element>& target,
+    const boost::shared_ptr<const Element>& candidate, FeatureExtractionContext& context) const;
+
   virtual std::string getClassName() const { return className(); }
 
   virtual std::string getName() const;
@@ -63,6 +66,16 @@ protected:
   virtual double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2)
     const = 0;
 
+  /**
+   * Context aware variant of _extract(). The default ignores the context; subclasses that can
+   * reuse the context's memoized products override it.
+   */
+  virtual double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2,
+    FeatureExtractionContext& /*context*/) const
+  {
+    return _extract(map, w1, w2);
+  }
+
   ValueAggregatorPtr _agg;
 };
 
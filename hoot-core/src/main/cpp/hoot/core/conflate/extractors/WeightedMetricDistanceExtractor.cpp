@@ -35,6 +35,7 @@
 // hoot
 #include <hoot/core/algorithms/aggregator/MeanAggregator.h>
 #include <hoot/core/algorithms/WayDiscretizer.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 #include <hoot/core/util/ElementConverter.h>
 #include <hoot/core/util/Factory.h>
 
@@ -65,14 +66,26 @@ WeightedMetricDistanceExtractor::WeightedMetricDistanceExtractor(ValueAggregator
 double WeightedMetricDistanceExtractor::_extract(const OsmMap& map, const ConstWayPtr& w1,
   const ConstWayPtr& w2) const
 {
-  vector<double> distances;
-
   vector<Coordinate> v;
   WayDiscretizer wd(map.shared_from_this(), w1);
   wd.discretize(2.0, v);
 
   boost::shared_ptr<LineString> ls2 = ElementConverter(map.shared_from_this()).convertToLineString(w2);
 
+  return _extract(w1, w2, v, ls2);
+}
+
+double WeightedMetricDistanceExtractor::_extract(const OsmMap& /*map*/, const ConstWayPtr& w1,
+  const ConstWayPtr& w2, FeatureExtractionContext& context) const
+{
+  return _extract(w1, w2, context.getDiscretizedPoints(w1, 2.0), context.getLineString(w2));
+}
+
+double WeightedMetricDistanceExtractor::_extract(const ConstWayPtr& w1, const ConstWayPtr& w2,
+  const vector<Coordinate>& v, const boost::shared_ptr<LineString>& ls2) const
+{
+  vector<double> distances;
+
   double sigma = _searchRadius;
 
   if (_searchRadius == -1)
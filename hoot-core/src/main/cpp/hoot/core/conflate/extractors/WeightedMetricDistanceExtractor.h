@@ -31,6 +31,15 @@
 
 #include <hoot/core/util/Configurable.h>
 
+namespace geos
+{
+namespace geom
+{
+class Coordinate;
+class LineString;
+}
+}
+
 namespace hoot
 {
 
@@ -59,8 +68,21 @@ public:
 protected:
   double _extract(const OsmMap& /*map*/, const ConstWayPtr& w1, const ConstWayPtr& w2) const;
 
+  virtual double _extract(const OsmMap& map, const ConstWayPtr& w1, const ConstWayPtr& w2,
+    FeatureExtractionContext& context) const;
+
   std::auto_ptr<ValueAggregator> _pointAgg;
   Meters _searchRadius;
+
+private:
+
+  /**
+   * The distance aggregation shared by the context aware and context free paths; v is w1
+   * discretized at 2m and ls2 is w2's line string.
+   */
+  double _extract(const ConstWayPtr& w1, const ConstWayPtr& w2,
+    const std::vector<geos::geom::Coordinate>& v,
+    const boost::shared_ptr<geos::geom::LineString>& ls2) const;
 };
 
 }
@@ -75,11 +75,6 @@ MatchClassification HighwayExpertClassifier::classify(const ConstOsmMapPtr& map,
 {
   MatchClassification result;
 
-  OsmMapPtr mapCopy(new OsmMap());
-  CopySubsetOp(map,
-               match.getSubline1().getElementId(),
-               match.getSubline2().getElementId()).apply(mapCopy);
-
   if (match.isValid() == false)
   {
     result.setMissP(1.0);
@@ -88,30 +83,21 @@ MatchClassification HighwayExpertClassifier::classify(const ConstOsmMapPtr& map,
     return result;
   }
 
-  WayPtr sl1 = match.getSubline1().toWay(mapCopy);
-  WayPtr sl2 = match.getSubline2().toWay(mapCopy);
-
-  ElementConverter ec(mapCopy);
-  Meters l1 = ec.convertToLineString(match.getSubline1().getWay())->getLength();
-  Meters l2 = ec.convertToLineString(match.getSubline2().getWay())->getLength();
-
-  // what portion of the original lines is the MNS
-  double po1 = ec.convertToLineString(sl1)->getLength() / l1;
-  double po2 = ec.convertToLineString(sl2)->getLength() / l2;
+  const FeatureRow row = _computeFeatureRow(map, match);
 
   // give it a score
-  double ps = std::min(po1, po2) / 2.0 + 0.5;
+  double ps = std::min(row.po1, row.po2) / 2.0 + 0.5;
 
   double p;
 
   // if either of the lines are zero in length.
-  if (po1 == 0 || po2 == 0)
+  if (row.po1 == 0 || row.po2 == 0)
   {
     p = 0.0;
   }
   else
   {
-    p = ps * ProbabilityOfMatch::getInstance().expertProbability(mapCopy, sl1, sl2);
+    p = ps * row.expertP;
   }
 
   result.setMatchP(p);
@@ -120,6 +106,105 @@ MatchClassification HighwayExpertClassifier::classify(const ConstOsmMapPtr& map,
   return result;
 }
 
+void HighwayExpertClassifier::classify(const ConstOsmMapPtr& map,
+  const vector<const WaySublineMatchString*>& matches, vector<MatchClassification>& results)
+{
+  results.resize(matches.size());
+
+  // derive the feature rows for every subline of every candidate up front. This is where the
+  // allocations (subset map copies, line string conversions) live.
+  vector<FeatureRow> rows;
+  vector<size_t> firstRow;
+  firstRow.reserve(matches.size() + 1);
+  for (size_t i = 0; i < matches.size(); i++)
+  {
+    firstRow.push_back(rows.size());
+    const vector<WaySublineMatch>& sublines = matches[i]->getMatches();
+    for (size_t j = 0; j < sublines.size(); j++)
+    {
+      if (sublines[j].isValid())
+      {
+        rows.push_back(_computeFeatureRow(map, sublines[j]));
+      }
+      else
+      {
+        FeatureRow row;
+        row.po1 = 0.0;
+        row.po2 = 0.0;
+        row.expertP = 0.0;
+        row.valid = 0.0;
+        rows.push_back(row);
+      }
+    }
+  }
+  firstRow.push_back(rows.size());
+
+  // one branch light pass over the packed rows; an invalid or zero length row scores 0, which
+  // contributes the same miss an invalid subline contributes in the scalar path
+  vector<double> p(rows.size());
+  for (size_t i = 0; i < rows.size(); i++)
+  {
+    const double ps = std::min(rows[i].po1, rows[i].po2) / 2.0 + 0.5;
+    const double nonZero = (rows[i].po1 != 0.0 && rows[i].po2 != 0.0) ? 1.0 : 0.0;
+    p[i] = ps * rows[i].expertP * rows[i].valid * nonZero;
+  }
+
+  // aggregate per candidate the same way the match string classify does
+  for (size_t i = 0; i < matches.size(); i++)
+  {
+    MatchClassification result;
+    for (size_t j = firstRow[i]; j < firstRow[i + 1]; j++)
+    {
+      result.setMatchP(p[j] + result.getMatchP());
+      result.setMissP((1.0 - p[j]) + result.getMissP());
+    }
+
+    if (result.getMatchP() + result.getMissP() + result.getReviewP() == 0.0)
+    {
+      result.setMiss();
+    }
+
+    result.normalize();
+
+    results[i] = result;
+  }
+}
+
+HighwayExpertClassifier::FeatureRow HighwayExpertClassifier::_computeFeatureRow(
+  const ConstOsmMapPtr& map, const WaySublineMatch& match) const
+{
+  FeatureRow row;
+  row.po1 = 0.0;
+  row.po2 = 0.0;
+  row.expertP = 0.0;
+  row.valid = 1.0;
+
+  OsmMapPtr mapCopy(new OsmMap());
+  CopySubsetOp(map,
+               match.getSubline1().getElementId(),
+               match.getSubline2().getElementId()).apply(mapCopy);
+
+  WayPtr sl1 = match.getSubline1().toWay(mapCopy);
+  WayPtr sl2 = match.getSubline2().toWay(mapCopy);
+
+  ElementConverter ec(mapCopy);
+  Meters l1 = ec.convertToLineString(match.getSubline1().getWay())->getLength();
+  Meters l2 = ec.convertToLineString(match.getSubline2().getWay())->getLength();
+
+  // what portion of the original lines is the MNS
+  row.po1 = ec.convertToLineString(sl1)->getLength() / l1;
+  row.po2 = ec.convertToLineString(sl2)->getLength() / l2;
+
+  // if either of the lines are zero in length the probability isn't needed; classify scores
+  // those rows 0 without it.
+  if (row.po1 != 0 && row.po2 != 0)
+  {
+    row.expertP = ProbabilityOfMatch::getInstance().expertProbability(mapCopy, sl1, sl2);
+  }
+
+  return row;
+}
+
 map<QString, double> HighwayExpertClassifier::getFeatures(const ConstOsmMapPtr& /*m*/,
   ElementId /*eid1*/, ElementId /*eid2*/, const WaySublineMatchString& /*match*/) const
 {
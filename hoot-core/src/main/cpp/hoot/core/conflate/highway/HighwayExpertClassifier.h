@@ -29,6 +29,9 @@
 
 #include "HighwayClassifier.h"
 
+// Standard
+#include <vector>
+
 namespace hoot
 {
 
@@ -48,8 +51,31 @@ public:
   MatchClassification classify(const ConstOsmMapPtr& map,
     const WaySublineMatch& match);
 
+  /**
+   * Array oriented form of classify: classifies a batch of candidate subline match strings and
+   * writes the classification for matches[i] into results[i] (results is resized to fit). The
+   * expensive per subline feature derivation happens up front into packed rows; the probability
+   * math then runs as one pass over the rows that the compiler can vectorize.
+   */
+  void classify(const ConstOsmMapPtr& map,
+    const std::vector<const WaySublineMatchString*>& matches,
+    std::vector<MatchClassification>& results);
+
   std::map<QString, double> getFeatures(const ConstOsmMapPtr& m,
     ElementId eid1, ElementId eid2, const WaySublineMatchString& match) const;
+
+private:
+
+  /// the features classify derives for one subline match; see the batch classify
+  struct FeatureRow
+  {
+    double po1;
+    double po2;
+    double expertP;
+    double valid;
+  };
+
+  FeatureRow _computeFeatureRow(const ConstOsmMapPtr& map, const WaySublineMatch& match) const;
 };
 
 }
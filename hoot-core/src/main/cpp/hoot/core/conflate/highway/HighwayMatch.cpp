@@ -71,6 +71,13 @@ HighwayMatch::HighwayMatch(const boost::shared_ptr<HighwayClassifier>& classifie
   const ConstElementPtr e1 = map->getElement(eid1);
   const ConstElementPtr e2 = map->getElement(eid2);
 
+  // record the way geometry revisions so the merge phase can tell whether _sublineMatch is
+  // still usable then
+  ConstWayPtr w1 = boost::dynamic_pointer_cast<const Way>(e1);
+  ConstWayPtr w2 = boost::dynamic_pointer_cast<const Way>(e2);
+  _geometryRevision1 = w1.get() != 0 ? w1->getGeometryRevision() : 0;
+  _geometryRevision2 = w2.get() != 0 ? w2->getGeometryRevision() : 0;
+
   try
   {
     // calculated the shared sublines
@@ -88,6 +88,14 @@ public:
 
   const WaySublineMatchString& getSublineMatch() const { return _sublineMatch; }
 
+  /**
+   * Returns the geometry revision the matched way had when the subline match was computed, or
+   * 0 if the element isn't a way. The merge phase compares these against the current revisions
+   * to decide whether the stored subline match can be reused (see HighwaySnapMerger).
+   */
+  unsigned long getWayGeometryRevision1() const { return _geometryRevision1; }
+  unsigned long getWayGeometryRevision2() const { return _geometryRevision2; }
+
   virtual QString toString() const;
 
 private:
@@ -99,6 +107,8 @@ private:
   double _minSplitSize;
   double _score;
   WaySublineMatchString _sublineMatch;
+  unsigned long _geometryRevision1;
+  unsigned long _geometryRevision2;
   mutable QHash<ElementId, bool> _conflicts;
   QString _explainText;
   static QString _matchName;
@@ -40,6 +40,7 @@
 #include <hoot/core/algorithms/Soundex.h>
 #include <hoot/core/conflate/MatchType.h>
 #include <hoot/core/conflate/extractors/AttributeScoreExtractor.h>
+#include <hoot/core/conflate/extractors/FeatureExtractionContext.h>
 #include <hoot/core/conflate/extractors/DistanceScoreExtractor.h>
 #include <hoot/core/conflate/extractors/LengthScoreExtractor.h>
 #include <hoot/core/conflate/extractors/WeightedMetricDistanceExtractor.h>
@@ -264,9 +265,12 @@ map<QString, double> HighwayRfClassifier::getFeatures(const ConstOsmMapPtr& m,
   }
   else
   {
+    // one context for the whole extractor list, so intermediate products derived from this pair
+    // are computed once and shared across the extractors.
+    FeatureExtractionContext context(copiedMap);
     for (size_t i = 0; i < _extractors.size(); i++)
     {
-      double v = _extractors[i]->extract(*copiedMap, match1, match2);
+      double v = _extractors[i]->extract(*copiedMap, match1, match2, context);
       // if it isn't null then include it.
       if (!FeatureExtractor::isNull(v))
       {
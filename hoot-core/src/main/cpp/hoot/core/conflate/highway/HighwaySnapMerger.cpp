@@ -66,7 +66,9 @@ HighwaySnapMerger::HighwaySnapMerger(Meters minSplitSize,
   const boost::shared_ptr<SublineStringMatcher> &sublineMatcher) :
   _minSplitSize(minSplitSize),
   _pairs(pairs),
-  _sublineMatcher(sublineMatcher)
+  _sublineMatcher(sublineMatcher),
+  _preserveUnknown1ElementId(
+    ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures())
 {
 }
 
@@ -144,6 +146,20 @@ void HighwaySnapMerger::apply(const OsmMapPtr& map, vector< pair<ElementId, Elem
   }
 }
 
+bool HighwaySnapMerger::_canReuseSublineMatch(const ConstOsmMapPtr& map, ElementId eid1,
+  ElementId eid2, const CachedSublineMatch& cached) const
+{
+  if (eid1.getType() != ElementType::Way || eid2.getType() != ElementType::Way)
+  {
+    return false;
+  }
+  ConstWayPtr w1 = map->getWay(eid1.getId());
+  ConstWayPtr w2 = map->getWay(eid2.getId());
+  return w1.get() != 0 && w2.get() != 0 &&
+    w1->getGeometryRevision() == cached.geometryRevision1 &&
+    w2->getGeometryRevision() == cached.geometryRevision2;
+}
+
 bool HighwaySnapMerger::_directConnect(const ConstOsmMapPtr& map, WayPtr w) const
 {
   boost::shared_ptr<LineString> ls = ElementConverter(map).convertToLineString(w);
@@ -238,15 +254,29 @@ void HighwaySnapMerger::_mergePair(const OsmMapPtr& map, ElementId eid1, Element
 
   // split w2 into sublines
   WaySublineMatchString match;
-  try
+  bool haveMatch = false;
+  std::map<pair<ElementId, ElementId>, CachedSublineMatch>::const_iterator cachedIt =
+    _cachedSublineMatches.find(pair<ElementId, ElementId>(eid1, eid2));
+  if (cachedIt != _cachedSublineMatches.end() &&
+      _canReuseSublineMatch(result, eid1, eid2, cachedIt->second))
   {
-    match = _sublineMatcher->findMatch(result, e1, e2);
+    // the match phase already ran the subline matcher on this pair and the ways haven't
+    // changed since, so remap its result onto this map instead of running the matcher again
+    match = WaySublineMatchString(cachedIt->second.match, result);
+    haveMatch = true;
   }
-  catch (const NeedsReviewException& e)
+  if (!haveMatch)
   {
-    LOG_VART(e.getWhat());
-    _markNeedsReview(result, e1, e2, e.getWhat(), HighwayMatch::getHighwayMatchName());
-    return;
+    try
+    {
+      match = _sublineMatcher->findMatch(result, e1, e2);
+    }
+    catch (const NeedsReviewException& e)
+    {
+      LOG_VART(e.getWhat());
+      _markNeedsReview(result, e1, e2, e.getWhat(), HighwayMatch::getHighwayMatchName());
+      return;
+    }
   }
   LOG_VART(match);
 
@@ -293,7 +323,7 @@ void HighwaySnapMerger::_mergePair(const OsmMapPtr& map, ElementId eid1, Element
     RemoveReviewsByEidOp(eid1, true).apply(result);
   }
 
-  if (ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures())
+  if (_preserveUnknown1ElementId)
   {
     //With this option enabled, we want to retain the element ID of the original modified
     //unknown1 way for provenance purposes.  So, we'll keep a mapping from the unknown 1 ID to the
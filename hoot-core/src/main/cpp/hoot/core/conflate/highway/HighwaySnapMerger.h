@@ -28,6 +28,10 @@
 #define HIGHWAYSNAPMERGER_H
 
 #include <hoot/core/conflate/MergerBase.h>
+#include <hoot/core/algorithms/linearreference/WaySublineMatchString.h>
+
+// Standard
+#include <map>
 
 namespace hoot
 {
@@ -48,6 +52,26 @@ public:
 
   virtual void apply(const OsmMapPtr& map, std::vector< std::pair<ElementId, ElementId> >& replaced);
 
+  /**
+   * A subline match carried over from the match phase, along with the geometry revisions the
+   * matched ways had when it was computed.
+   */
+  struct CachedSublineMatch
+  {
+    WaySublineMatchString match;
+    unsigned long geometryRevision1;
+    unsigned long geometryRevision2;
+  };
+
+  /**
+   * Supplies the subline matches the match phase already computed, keyed by element id pair.
+   * When a pair's ways are unchanged at merge time the merger reuses the stored match instead
+   * of rerunning the subline matcher, which is the most expensive step of the merge.
+   */
+  void setCachedSublineMatches(
+    const std::map<std::pair<ElementId, ElementId>, CachedSublineMatch>& matches)
+  { _cachedSublineMatches = matches; }
+
   virtual QString toString() const;
 
 protected:
@@ -60,11 +84,22 @@ private:
   double _minSplitSize;
   std::set< std::pair<ElementId, ElementId> > _pairs;
   boost::shared_ptr<SublineStringMatcher> _sublineMatcher;
+  // copied out of the configuration at construction; _mergePair runs once per merged pair.
+  bool _preserveUnknown1ElementId;
+  std::map<std::pair<ElementId, ElementId>, CachedSublineMatch> _cachedSublineMatches;
 
   /**
    * Returns true if the way directly connects the left and right ways. There is some tolerance
    * for "directly". See ticket #951 for details.
    */
+  /**
+   * Returns true if the cached match can stand in for rerunning the subline matcher on the
+   * pair: both elements are still ways and their geometry revisions match the ones recorded at
+   * match time. A way split remaps the ids, so a split pair recomputes.
+   */
+  bool _canReuseSublineMatch(const ConstOsmMapPtr& map, ElementId eid1, ElementId eid2,
+    const CachedSublineMatch& cached) const;
+
   bool _directConnect(const ConstOsmMapPtr &map, WayPtr w) const;
 
   void _markNeedsReview(const OsmMapPtr& map, ElementPtr e1, ElementPtr e2, QString note,
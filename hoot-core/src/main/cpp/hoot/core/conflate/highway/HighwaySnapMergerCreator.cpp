@@ -54,6 +54,7 @@ bool HighwaySnapMergerCreator::createMergers(const MatchSet& matches, vector<Mer
   assert(matches.size() > 0);
 
   set< pair<ElementId, ElementId> > eids;
+  std::map<pair<ElementId, ElementId>, HighwaySnapMerger::CachedSublineMatch> cachedMatches;
 
   boost::shared_ptr<SublineStringMatcher> sublineMatcher;
   // go through all the matches
@@ -76,13 +77,25 @@ bool HighwaySnapMergerCreator::createMergers(const MatchSet& matches, vector<Mer
       sublineMatcher = hm->getSublineMatcher();
       set< pair<ElementId, ElementId> > s = hm->getMatchPairs();
       eids.insert(s.begin(), s.end());
+      // carry the subline match forward so the merger doesn't have to recompute it
+      for (set< pair<ElementId, ElementId> >::const_iterator pairIt = s.begin();
+           pairIt != s.end(); ++pairIt)
+      {
+        HighwaySnapMerger::CachedSublineMatch cached;
+        cached.match = hm->getSublineMatch();
+        cached.geometryRevision1 = hm->getWayGeometryRevision1();
+        cached.geometryRevision2 = hm->getWayGeometryRevision2();
+        cachedMatches[*pairIt] = cached;
+      }
     }
   }
 
   // only add the highway merge if there are elements to merge.
   if (eids.size() > 0)
   {
-    mergers.push_back(new HighwaySnapMerger(_minSplitSize, eids, sublineMatcher));
+    HighwaySnapMerger* merger = new HighwaySnapMerger(_minSplitSize, eids, sublineMatcher);
+    merger->setCachedSublineMatches(cachedMatches);
+    mergers.push_back(merger);
     result = true;
   }
 
@@ -30,6 +30,14 @@
 #include <hoot/core/conflate/Match.h>
 #include <hoot/core/util/Log.h>
 
+// Qt
+#include <QHash>
+#include <QVector>
+#include <QtConcurrentMap>
+
+// tgs
+#include <tgs/DisjointSet/DisjointSet.h>
+
 using namespace std;
 
 namespace hoot
@@ -56,6 +64,66 @@ private:
   const vector<const Match*>& _matches;
 };
 
+/**
+ * Runs the greedy sweep on one connected component of the conflict graph. Components are
+ * independent by construction, so they can be optimized concurrently; the component holds its
+ * matches in global score order, which makes the per-component sweep identical to the matching
+ * piece of a global sweep.
+ */
+class ComponentSweeper
+{
+public:
+  typedef pair< vector<size_t>, double > result_type;
+
+  ComponentSweeper(const vector< vector<size_t> >& components,
+    const MatchConflicts::ConflictMap& cm, const vector<const Match*>& matches) :
+    _components(components),
+    _cm(cm),
+    _matches(matches)
+  {
+  }
+
+  result_type operator()(int componentIndex) const
+  {
+    const vector<size_t>& component = _components[componentIndex];
+    result_type result;
+    result.second = 0;
+    set<size_t> keepers;
+
+    for (size_t i = 0; i < component.size(); i++)
+    {
+      size_t mi = component[i];
+      bool keep = true;
+
+      // see if any of our conflicting matches are already being kept
+      for (MatchConflicts::ConflictMap::const_iterator it = _cm.find(mi);
+           it != _cm.end() && it.key() == mi; ++it)
+      {
+        if (keepers.count(it.value()))
+        {
+          keep = false;
+        }
+      }
+
+      if (keep)
+      {
+        keepers.insert(mi);
+        result.first.push_back(mi);
+        // while adding EPSILON isn't strictly necessary here it does give consistent scores when
+        // comparing between optimal and greedy.
+        result.second += _matches[mi]->getScore() + ConstrainedMatches::EPSILON;
+      }
+    }
+
+    return result;
+  }
+
+private:
+  const vector< vector<size_t> >& _components;
+  const MatchConflicts::ConflictMap& _cm;
+  const vector<const Match*>& _matches;
+};
+
 vector<const Match *> GreedyConstrainedMatches::calculateSubset()
 {
   _score = -1;
@@ -101,27 +169,65 @@ vector<const Match *> GreedyConstrainedMatches::calculateSubset()
   }
 
   _score = 0;
+
+  // Partition the conflict graph into connected components. Matches in different components can
+  // never conflict, so each component can be swept independently and, since there are typically
+  // a huge number of tiny components, concurrently.
+  DisjointSet ds(_matches.size());
+  for (MatchConflicts::ConflictMap::const_iterator it = _conflicts.constBegin();
+       it != _conflicts.constEnd(); ++it)
+  {
+    ds.join(it.key(), it.value());
+  }
+
+  // Group the conflicting matches by component, preserving the global score order within each
+  // component. Matches that conflict with nothing are always kept and skip the sweep entirely.
+  QHash<int, int> rootToComponent;
+  vector< vector<size_t> > components;
   for (size_t i = 0; i < matchOrder.size(); i++)
   {
-    bool keep = true;
     size_t mi = matchOrder[i];
-
-    // see if any of our conflicting matches are already being kept
-    for (MatchConflicts::ConflictMap::const_iterator it = cm.find(mi); it != cm.end() && it.key() == mi; ++it)
+    if (cm.contains(mi) == false)
     {
-      if (keepers.count(it.value()))
-      {
-        keep = false;
-      }
+      keepers.insert(mi);
+      _score += _matches[mi]->getScore() + EPSILON;
+      continue;
+    }
+    int root = ds.find(mi);
+    QHash<int, int>::const_iterator cit = rootToComponent.find(root);
+    if (cit == rootToComponent.constEnd())
+    {
+      rootToComponent.insert(root, components.size());
+      components.push_back(vector<size_t>());
+      components.back().push_back(mi);
     }
+    else
+    {
+      components[cit.value()].push_back(mi);
+    }
+  }
 
-    if (keep)
+  QVector<int> componentIndexes(components.size());
+  for (int i = 0; i < componentIndexes.size(); i++)
+  {
+    componentIndexes[i] = i;
+  }
+  ComponentSweeper sweeper(components, cm, _matches);
+  QVector<ComponentSweeper::result_type> swept =
+    QtConcurrent::blockingMapped(componentIndexes, sweeper);
+
+  for (int i = 0; i < swept.size(); i++)
+  {
+    keepers.insert(swept[i].first.begin(), swept[i].first.end());
+    _score += swept[i].second;
+  }
+
+  // assemble the result in global score order so the output is identical to a serial sweep.
+  for (size_t i = 0; i < matchOrder.size(); i++)
+  {
+    if (keepers.count(matchOrder[i]))
     {
-      keepers.insert(mi);
-      result.push_back(_matches[mi]);
-      // while adding EPSILON isn't strictly necessary here it does give consistent scores when
-      // comparing between optimal and greedy.
-      _score += _matches[mi]->getScore() + EPSILON;
+      result.push_back(_matches[matchOrder[i]]);
     }
   }
 
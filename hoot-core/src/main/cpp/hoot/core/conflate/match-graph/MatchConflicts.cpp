@@ -32,6 +32,7 @@
 #include <hoot/core/elements/ElementId.h>
 
 // Standard
+#include <algorithm>
 #include <map>
 #include <set>
 
@@ -70,6 +71,13 @@ void MatchConflicts::calculateMatchConflicts(const vector<const Match*>& matches
   // go through all the matches and map from eid to the match index.
   EidIndexMap eidToMatches = calculateEidIndexMap(matches);
 
+  // Gather the candidate pairs (matches that share at least one element id) before scoring any
+  // of them. In dense areas the same pair shares many element ids, so it used to get an
+  // isConflicting check and a conflicts entry once per shared id; deduplicating the pair list
+  // first runs the expensive check exactly once per pair and keeps duplicate rows out of the
+  // downstream solvers.
+  vector< pair<size_t, size_t> > candidates;
+
   // go through all the eids with matches ordered by eid
   ElementId lastEid;
   // the set of indexes to all the matches that use a common ElementId
@@ -79,7 +87,7 @@ void MatchConflicts::calculateMatchConflicts(const vector<const Match*>& matches
     // if we got a new Eid.
     if (it->first != lastEid)
     {
-      calculateSubsetConflicts(matches, conflicts, matchSet);
+      _appendSubsetPairs(matchSet, candidates);
 
       // start over with a new match set
       matchSet.clear();
@@ -89,7 +97,44 @@ void MatchConflicts::calculateMatchConflicts(const vector<const Match*>& matches
     lastEid = it->first;
   }
 
-  calculateSubsetConflicts(matches, conflicts, matchSet);
+  _appendSubsetPairs(matchSet, candidates);
+
+  sort(candidates.begin(), candidates.end());
+  candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+  for (size_t i = 0; i < candidates.size(); i++)
+  {
+    size_t m1 = candidates[i].first;
+    size_t m2 = candidates[i].second;
+    if (MergerFactory::getInstance().isConflicting(_map, matches[m1], matches[m2]) ||
+        MergerFactory::getInstance().isConflicting(_map, matches[m2], matches[m1]))
+    {
+      conflicts.insert(m1, m2);
+    }
+  }
+}
+
+void MatchConflicts::_appendSubsetPairs(const vector<int>& matchSet,
+  vector< pair<size_t, size_t> >& candidates)
+{
+  for (size_t i = 0; i < matchSet.size(); i++)
+  {
+    for (size_t j = i + 1; j < matchSet.size(); j++)
+    {
+      size_t m1 = matchSet[i];
+      size_t m2 = matchSet[j];
+      if (m1 == m2)
+      {
+        continue;
+      }
+      // make sure we're consistent and put the smaller one first.
+      if (m2 < m1)
+      {
+        swap(m1, m2);
+      }
+      candidates.push_back(pair<size_t, size_t>(m1, m2));
+    }
+  }
 }
 
 void MatchConflicts::calculateSubsetConflicts(const vector<const Match *> &matches, ConflictMap& conflicts,
@@ -63,6 +63,14 @@ public:
 private:
   const ConstOsmMapPtr& _map;
 
+  /**
+   * Appends the normalized (smaller index first) candidate pairs within a set of matches that
+   * share an element id. The caller deduplicates the combined list before any of the pairs are
+   * checked for conflicts.
+   */
+  static void _appendSubsetPairs(const std::vector<int>& matchSet,
+    std::vector< std::pair<size_t, size_t> >& candidates);
+
 };
 
 }
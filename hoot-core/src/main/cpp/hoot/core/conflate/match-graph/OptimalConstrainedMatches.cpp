@@ -29,13 +29,33 @@
 // hoot
 #include <hoot/core/algorithms/optimizer/IntegerProgrammingSolver.h>
 #include <hoot/core/conflate/Match.h>
+#include <hoot/core/util/Exception.h>
 #include <hoot/core/util/Log.h>
 
+// Qt
+#include <QDataStream>
+#include <QHash>
+#include <QMutexLocker>
+
+// Standard
+#include <algorithm>
+#include <set>
+
+// tgs
+#include <tgs/DisjointSet/DisjointSet.h>
+#include <tgs/System/Time.h>
+
 using namespace std;
+using namespace Tgs;
 
 namespace hoot
 {
 
+// sized in components; country scale sliding window runs revisit far fewer distinct components
+// than this.
+QCache<QByteArray, QVector<int> > OptimalConstrainedMatches::_solutionCache(100000);
+QMutex OptimalConstrainedMatches::_solutionCacheMutex;
+
 OptimalConstrainedMatches::OptimalConstrainedMatches(const ConstOsmMapPtr &map) :
   ConstrainedMatches(map)
 {
@@ -64,27 +84,134 @@ vector<const Match *> OptimalConstrainedMatches::calculateSubset()
     return _matches;
   }
 
-  // populate the solver with
-  IntegerProgrammingSolver solver;
-  _populateSolver(solver);
-  if (_timeLimit > 0)
+  // Partition the conflict graph into connected components. Components are independent, so the
+  // global optimum is just the union of the per-component optima, and small subproblems are far
+  // cheaper for the IP solver than one monolithic one.
+  DisjointSet ds(_matches.size());
+  vector<bool> conflicted(_matches.size(), false);
+  for (MatchConflicts::ConflictMap::const_iterator it = _conflicts.constBegin();
+       it != _conflicts.constEnd(); ++it)
   {
-    solver.setTimeLimit(_timeLimit);
+    ds.join(it.key(), it.value());
+    conflicted[it.key()] = true;
+    conflicted[it.value()] = true;
   }
 
-  // solve the Integer Programming problem.
-  solver.solve();
-  _score = solver.getObjectiveValue();
+  QHash<int, int> rootToComponent;
+  vector< vector<size_t> > components;
+  vector<bool> keep(_matches.size(), false);
+  _score = 0;
+  for (size_t i = 0; i < _matches.size(); i++)
+  {
+    if (conflicted[i] == false)
+    {
+      // matches with no conflicts are trivially part of the optimal answer.
+      keep[i] = true;
+      _score += _matches[i]->getScore() + EPSILON;
+      continue;
+    }
+    int root = ds.find(i);
+    QHash<int, int>::const_iterator cit = rootToComponent.find(root);
+    if (cit == rootToComponent.constEnd())
+    {
+      rootToComponent.insert(root, components.size());
+      components.push_back(vector<size_t>());
+      components.back().push_back(i);
+    }
+    else
+    {
+      components[cit.value()].push_back(i);
+    }
+  }
 
-  result.reserve(_matches.size());
+  // per-component conflicts in local index space.
+  vector< vector< pair<int, int> > > componentConflicts(components.size());
+  {
+    QHash<size_t, int> globalToLocal;
+    for (size_t c = 0; c < components.size(); c++)
+    {
+      for (size_t i = 0; i < components[c].size(); i++)
+      {
+        globalToLocal.insert(components[c][i], (int)i);
+      }
+    }
+    for (MatchConflicts::ConflictMap::const_iterator it = _conflicts.constBegin();
+         it != _conflicts.constEnd(); ++it)
+    {
+      int c = rootToComponent[ds.find(it.key())];
+      componentConflicts[c].push_back(
+        pair<int, int>(globalToLocal[it.key()], globalToLocal[it.value()]));
+    }
+    for (size_t c = 0; c < componentConflicts.size(); c++)
+    {
+      sort(componentConflicts[c].begin(), componentConflicts[c].end());
+    }
+  }
 
-  // go through all the columns (variables)
-  for (int i = 0; i < solver.getNumColumns(); i++)
+  double startTime = Time::getTime();
+  int cacheHits = 0;
+  int greedyFallbacks = 0;
+  for (size_t c = 0; c < components.size(); c++)
   {
-    // if the value is close to 1 (as opposed to 0)
-    if (solver.getColumnPrimalValue(i + 1) > 0.99)
+    const vector<size_t>& component = components[c];
+    const vector< pair<int, int> >& localConflicts = componentConflicts[c];
+
+    QByteArray key = _componentKey(component, localConflicts);
+    vector<int> kept;
+    bool cached = false;
+    {
+      QMutexLocker locker(&_solutionCacheMutex);
+      QVector<int>* entry = _solutionCache.object(key);
+      if (entry != 0)
+      {
+        kept = vector<int>(entry->begin(), entry->end());
+        cached = true;
+        cacheHits++;
+      }
+    }
+
+    if (cached == false)
+    {
+      double remaining = _timeLimit > 0 ? _timeLimit - (Time::getTime() - startTime) : -1;
+      if (_timeLimit > 0 && remaining <= 0)
+      {
+        // the budget is spent; degrade just this component to the greedy answer.
+        kept = _sweepComponentGreedy(component, localConflicts);
+        greedyFallbacks++;
+      }
+      else
+      {
+        try
+        {
+          kept = _solveComponent(component, localConflicts, remaining);
+        }
+        catch (const Exception& e)
+        {
+          LOG_WARN("Solving a match component failed (" << e.what() <<
+                   "); falling back to a greedy sweep for this component.");
+          kept = _sweepComponentGreedy(component, localConflicts);
+          greedyFallbacks++;
+        }
+      }
+      QMutexLocker locker(&_solutionCacheMutex);
+      _solutionCache.insert(key, new QVector<int>(QVector<int>::fromStdVector(kept)));
+    }
+
+    for (size_t i = 0; i < kept.size(); i++)
+    {
+      size_t mi = component[kept[i]];
+      keep[mi] = true;
+      _score += _matches[mi]->getScore() + EPSILON;
+    }
+  }
+  LOG_DEBUG("Solved " << components.size() << " match components (" << cacheHits <<
+            " cache hits, " << greedyFallbacks << " greedy fallbacks).");
+
+  result.reserve(_matches.size());
+  for (size_t i = 0; i < _matches.size(); i++)
+  {
+    if (keep[i])
     {
-      // it is a keeper
       result.push_back(_matches[i]);
     }
   }
@@ -92,45 +219,120 @@ vector<const Match *> OptimalConstrainedMatches::calculateSubset()
   return result;
 }
 
-void OptimalConstrainedMatches::_populateSolver(IntegerProgrammingSolver& solver)
+QByteArray OptimalConstrainedMatches::_componentKey(const vector<size_t>& component,
+  const vector< pair<int, int> >& localConflicts) const
+{
+  QByteArray key;
+  QDataStream ds(&key, QIODevice::WriteOnly);
+  ds << (quint32)component.size();
+  for (size_t i = 0; i < component.size(); i++)
+  {
+    ds << _matches[component[i]]->getScore();
+  }
+  ds << (quint32)localConflicts.size();
+  for (size_t i = 0; i < localConflicts.size(); i++)
+  {
+    ds << (qint32)localConflicts[i].first << (qint32)localConflicts[i].second;
+  }
+  return key;
+}
+
+vector<int> OptimalConstrainedMatches::_sweepComponentGreedy(const vector<size_t>& component,
+  const vector< pair<int, int> >& localConflicts) const
+{
+  // order the members by descending score.
+  vector< pair<double, int> > order(component.size());
+  for (size_t i = 0; i < component.size(); i++)
+  {
+    order[i] = pair<double, int>(-_matches[component[i]]->getScore(), (int)i);
+  }
+  sort(order.begin(), order.end());
+
+  QMultiHash<int, int> cm;
+  for (size_t i = 0; i < localConflicts.size(); i++)
+  {
+    cm.insert(localConflicts[i].first, localConflicts[i].second);
+    cm.insert(localConflicts[i].second, localConflicts[i].first);
+  }
+
+  vector<int> kept;
+  set<int> keepers;
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    int mi = order[i].second;
+    bool keep = true;
+    for (QMultiHash<int, int>::const_iterator it = cm.find(mi);
+         it != cm.end() && it.key() == mi; ++it)
+    {
+      if (keepers.count(it.value()))
+      {
+        keep = false;
+      }
+    }
+    if (keep)
+    {
+      keepers.insert(mi);
+      kept.push_back(mi);
+    }
+  }
+  sort(kept.begin(), kept.end());
+  return kept;
+}
+
+vector<int> OptimalConstrainedMatches::_solveComponent(const vector<size_t>& component,
+  const vector< pair<int, int> >& localConflicts, double timeLimit) const
 {
+  IntegerProgrammingSolver solver;
   // try to maximize the score.
   solver.setObjectiveDirection(GLP_MAX);
 
   // each match is a column (variable) in the function that we want to maximize.
-  solver.addColumns(_matches.size());
-  for (size_t i = 0; i < _matches.size(); i++)
+  solver.addColumns(component.size());
+  for (size_t i = 0; i < component.size(); i++)
   {
     solver.setColumnKind(i + 1, GLP_BV);
-    //solver.setColumnBounds(i + 1, GLP_DB, 0.0, 1.0);
     // The score of a match is the coefficient. This makes higher score matches worth
     // more in the function.
-    solver.setObjectiveCoefficient(i + 1, _matches[i]->getScore() + EPSILON);
+    solver.setObjectiveCoefficient(i + 1, _matches[component[i]]->getScore() + EPSILON);
   }
 
   // there is one row (constraint) for each conflict.
-  solver.addRows(_conflicts.size());
-  vector<int> ia(_conflicts.size() * 2 + 1);
-  vector<int> ja(_conflicts.size() * 2 + 1);
-  vector<double> ra(_conflicts.size() * 2 + 1);
-  int i = 0;
-  for (MatchConflicts::ConflictMap::const_iterator it = _conflicts.constBegin();
-       it != _conflicts.constEnd(); ++it)
+  solver.addRows(localConflicts.size());
+  vector<int> ia(localConflicts.size() * 2 + 1);
+  vector<int> ja(localConflicts.size() * 2 + 1);
+  vector<double> ra(localConflicts.size() * 2 + 1);
+  for (size_t i = 0; i < localConflicts.size(); i++)
   {
     // Set the coefficients to 1 for each of the conflicting pairs and set the max value to 1. This
     // will make it so only one of the values can be 1 at a time, or they can both be 0.
     solver.setRowBounds(i + 1, GLP_DB, 0.0, 1.0);
     ia[i * 2 + 1] = i + 1;
-    ja[i * 2 + 1] = (int)it.key() + 1;
+    ja[i * 2 + 1] = localConflicts[i].first + 1;
     ra[i * 2 + 1] = 1.0;
     ia[i * 2 + 2] = i + 1;
-    ja[i * 2 + 2] = (int)it.value() + 1;
+    ja[i * 2 + 2] = localConflicts[i].second + 1;
     ra[i * 2 + 2] = 1.0;
-    i++;
   }
 
   // Populate the row coefficients.
   solver.loadMatrix(ia, ja, ra);
+
+  if (timeLimit > 0)
+  {
+    solver.setTimeLimit(timeLimit);
+  }
+  solver.solve();
+
+  vector<int> kept;
+  for (int i = 0; i < solver.getNumColumns(); i++)
+  {
+    // if the value is close to 1 (as opposed to 0)
+    if (solver.getColumnPrimalValue(i + 1) > 0.99)
+    {
+      kept.push_back(i);
+    }
+  }
+  return kept;
 }
 
 }
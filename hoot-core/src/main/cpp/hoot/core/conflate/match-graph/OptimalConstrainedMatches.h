@@ -30,6 +30,12 @@
 // Hoot
 #include <hoot/core/conflate/match-graph/ConstrainedMatches.h>
 
+// Qt
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QVector>
+
 namespace hoot
 {
 
@@ -39,6 +45,12 @@ namespace hoot
  *
  * Maximizing the set of matches is kind of tricky. For now, best is defined as maximizing the sum
  * of the Match scores.
+ *
+ * The conflict graph is solved one connected component at a time. Component solutions are
+ * memoized in a process-wide cache keyed by the component's structure and scores, so sliding
+ * window runs that see the same component repeatedly only solve it once. When a time limit is
+ * set and exhausted, the remaining components fall back to a greedy sweep individually instead of
+ * abandoning the whole solve.
  */
 class OptimalConstrainedMatches : public ConstrainedMatches
 {
@@ -54,7 +66,28 @@ public:
 
 private:
 
-  void _populateSolver(IntegerProgrammingSolver& solver);
+  static QCache<QByteArray, QVector<int> > _solutionCache;
+  static QMutex _solutionCacheMutex;
+
+  /**
+   * Returns a key that identifies the component's subproblem independently of the global match
+   * indexes: the local conflict structure plus the exact score of every member.
+   */
+  QByteArray _componentKey(const std::vector<size_t>& component,
+    const std::vector< std::pair<int, int> >& localConflicts) const;
+
+  /**
+   * Runs the greedy sweep on a single component; used when the time budget is spent or the
+   * solver fails.
+   */
+  std::vector<int> _sweepComponentGreedy(const std::vector<size_t>& component,
+    const std::vector< std::pair<int, int> >& localConflicts) const;
+
+  /**
+   * Solves one component with the IP solver and returns the kept local indexes.
+   */
+  std::vector<int> _solveComponent(const std::vector<size_t>& component,
+    const std::vector< std::pair<int, int> >& localConflicts, double timeLimit) const;
 };
 
 }
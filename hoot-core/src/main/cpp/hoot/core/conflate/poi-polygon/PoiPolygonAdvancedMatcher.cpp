@@ -30,12 +30,14 @@
 #include <geos/geom/LineString.h>
 #include <geos/util/TopologyException.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/prep/PreparedGeometry.h>
 
 // hoot
 #include <hoot/core/conflate/MatchClassification.h>
 #include <hoot/core/schema/OsmSchema.h>
-#include <hoot/core/util/ElementConverter.h>
+#include <hoot/core/index/OsmMapIndex.h>
 #include <hoot/core/algorithms/Translator.h>
+#include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/util/Log.h>
 
 #include "extractors/PoiPolygonNameScoreExtractor.h"
@@ -76,8 +78,9 @@ bool PoiPolygonAdvancedMatcher::triggersRule(ConstElementPtr poi, ConstElementPt
   //to suppress the ElementConverter poly warnings...warnings worth looking into at some point
   DisableLog dl(Log::Warn);
 
-  ElementConverter elementConverter(_map);
-  boost::shared_ptr<Geometry> polyGeom = elementConverter.convertToGeometry(poly);
+  //the index caches the way geometries, so repeated pairs against the same poly don't
+  //rebuild them
+  boost::shared_ptr<const Geometry> polyGeom = _map->getIndex().getGeometry(poly);
   if (QString::fromStdString(polyGeom->toString()).toUpper().contains("EMPTY"))
   {
     throw geos::util::TopologyException();
@@ -89,6 +92,10 @@ bool PoiPolygonAdvancedMatcher::triggersRule(ConstElementPtr poi, ConstElementPt
   {
     return false;
   }
+
+  //gather the neighbors whose name matches the poi's address, then run the containment tests
+  //as one batch against the prepared poly
+  vector<boost::shared_ptr<const Geometry> > addressMatchGeoms;
   for (set<ElementId>::const_iterator poiNeighborItr = _poiNeighborIds.begin();
        poiNeighborItr != _poiNeighborIds.end(); ++poiNeighborItr)
   {
@@ -100,15 +107,7 @@ bool PoiPolygonAdvancedMatcher::triggersRule(ConstElementPtr poi, ConstElementPt
         const QString poiNeighborName = PoiPolygonNameScoreExtractor::getElementName(poiNeighbor);
         if (!poiNeighborName.isEmpty() && poiNeighborName == poiAddress)
         {
-          boost::shared_ptr<Geometry> poiNeighborGeom =
-            ElementConverter(_map).convertToGeometry(poiNeighbor);
-          //If a building in the area contains a another POI with a matching address to the
-          //POI being examined, increase the evidence.
-          if (polyGeom->contains(poiNeighborGeom.get()))
-          {
-            LOG_TRACE("Found evidence per rule #1...");
-            return true;
-          }
+          addressMatchGeoms.push_back(_map->getIndex().getGeometry(poiNeighbor));
         }
       }
       catch (const geos::util::TopologyException& e)
@@ -124,6 +123,36 @@ bool PoiPolygonAdvancedMatcher::triggersRule(ConstElementPtr poi, ConstElementPt
     }
   }
 
+  if (addressMatchGeoms.size() > 0)
+  {
+    try
+    {
+      vector<bool> contained;
+      GeometryUtils::containsAll(
+        *_map->getIndex().getPreparedGeometry(poly), addressMatchGeoms, contained);
+      for (size_t i = 0; i < contained.size(); i++)
+      {
+        //If a building in the area contains a another POI with a matching address to the
+        //POI being examined, increase the evidence.
+        if (contained[i])
+        {
+          LOG_TRACE("Found evidence per rule #1...");
+          return true;
+        }
+      }
+    }
+    catch (const geos::util::TopologyException& e)
+    {
+      if (_badGeomCount <= ConfigOptions().getLogWarnMessageLimit())
+      {
+        LOG_TRACE(
+          "Feature passed to PoiPolygonMatchCreator caused a topology exception during the "
+          "containment tests: " << poly->toString() << "\n" << e.what());
+        _badGeomCount++;
+      }
+    }
+  }
+
   return false;
 }
 
@@ -0,0 +1,122 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "PoiPolygonDistanceProfileMap.h"
+
+// Hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/elements/Relation.h>
+
+// Qt
+#include <QVector>
+#include <QtConcurrentMap>
+
+namespace hoot
+{
+
+void PoiPolygonDistanceProfileMap::build(const ConstOsmMapPtr& map)
+{
+  _profiles.clear();
+
+  QVector<ProfileTask> tasks;
+  tasks.reserve(
+    (int)(map->getNodes().size() + map->getWays().size() + map->getRelations().size()));
+  const NodeMap& nodes = map->getNodes();
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    ProfileTask task;
+    task.element = it->second;
+    tasks.append(task);
+  }
+  const WayMap& ways = map->getWays();
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    ProfileTask task;
+    task.element = it->second;
+    tasks.append(task);
+  }
+  const RelationMap& relations = map->getRelations();
+  for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
+  {
+    ProfileTask task;
+    task.element = it->second;
+    tasks.append(task);
+  }
+
+  //the tag probes only read the map, so they fan out across the thread pool
+  QtConcurrent::blockingMap(tasks, &PoiPolygonDistanceProfileMap::_profileElement);
+
+  //elements with no relevant tags are left out of the table; getProfile returns zero for them
+  for (int i = 0; i < tasks.size(); i++)
+  {
+    if (tasks[i].profile != 0)
+    {
+      _profiles.insert(tasks[i].element->getElementId(), tasks[i].profile);
+    }
+  }
+}
+
+void PoiPolygonDistanceProfileMap::_profileElement(ProfileTask& task)
+{
+  task.profile = profileTags(task.element->getTags());
+}
+
+unsigned char PoiPolygonDistanceProfileMap::profileTags(const Tags& tags)
+{
+  unsigned char profile = 0;
+  if (tags.get("leisure") == "park")
+  {
+    profile |= PARK;
+  }
+  if (tags.get("station") == "light_rail" || tags.get("railway") == "platform")
+  {
+    profile |= RAIL_PLATFORM;
+  }
+  if (tags.get("subway") == "yes" || tags.get("tunnel") == "yes")
+  {
+    profile |= SUBWAY_OR_TUNNEL;
+  }
+  return profile;
+}
+
+double PoiPolygonDistanceProfileMap::getReviewDistance(unsigned char profile,
+                                                       unsigned char polyProfile,
+                                                       double reviewDistanceDefault)
+{
+  //these distances could be moved to a config
+  if (profile & PARK)
+  {
+    return 25.0;
+  }
+  else if ((profile & RAIL_PLATFORM) && (polyProfile & SUBWAY_OR_TUNNEL))
+  {
+    return 150.0;
+  }
+  return reviewDistanceDefault;
+}
+
+}
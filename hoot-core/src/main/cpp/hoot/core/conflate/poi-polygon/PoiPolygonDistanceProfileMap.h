@@ -0,0 +1,98 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef POIPOLYGONDISTANCEPROFILEMAP_H
+#define POIPOLYGONDISTANCEPROFILEMAP_H
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/ElementId.h>
+
+// Qt
+#include <QHash>
+
+namespace hoot
+{
+
+/**
+ * Side table holding the type derived distance parameters used by poi/polygon matching,
+ * condensed to a bitmask per element. PoiPolygonDistance recomputes these from the type tags
+ * for the same elements across many pairs; building the table once in a pre-pass moves those
+ * tag queries out of the pair loop and leaves the per pair work as two hash lookups and some
+ * bit tests. Only elements with at least one relevant tag get an entry, so the table stays
+ * small on large maps.
+ */
+class PoiPolygonDistanceProfileMap
+{
+
+public:
+
+  //profile bits; see PoiPolygonDistance::getReviewDistanceForType for the rules they feed
+  static const unsigned char PARK = 0x1;
+  static const unsigned char RAIL_PLATFORM = 0x2;
+  static const unsigned char SUBWAY_OR_TUNNEL = 0x4;
+
+  /**
+   * Profiles every element in the map. The per element tag probes are independent of each
+   * other, so they fan out across the thread pool; only the table inserts run serially.
+   */
+  void build(const ConstOsmMapPtr& map);
+
+  /**
+   * Returns the profile bits for an element; zero if the element has none of the relevant tags
+   * (or wasn't profiled).
+   */
+  unsigned char getProfile(const ElementId& eid) const { return _profiles.value(eid, 0); }
+
+  /**
+   * Computes the profile bits for a set of tags.
+   */
+  static unsigned char profileTags(const Tags& tags);
+
+  /**
+   * The profile form of PoiPolygonDistance::getReviewDistanceForType; must stay in sync with
+   * the distances there. polyProfile supplies the subway/tunnel context for the rail platform
+   * rule.
+   */
+  static double getReviewDistance(unsigned char profile, unsigned char polyProfile,
+                                  double reviewDistanceDefault);
+
+private:
+
+  struct ProfileTask
+  {
+    ConstElementPtr element;
+    unsigned char profile;
+  };
+
+  QHash<ElementId, unsigned char> _profiles;
+
+  static void _profileElement(ProfileTask& task);
+};
+
+}
+
+#endif // POIPOLYGONDISTANCEPROFILEMAP_H
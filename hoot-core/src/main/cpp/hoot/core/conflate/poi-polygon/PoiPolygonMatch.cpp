@@ -38,6 +38,7 @@
 #include "extractors/PoiPolygonTypeScoreExtractor.h"
 #include "extractors/PoiPolygonNameScoreExtractor.h"
 #include "PoiPolygonDistance.h"
+#include "PoiPolygonDistanceProfileMap.h"
 #include "extractors/PoiPolygonAddressScoreExtractor.h"
 #include "PoiPolygonReviewReducer.h"
 #include "PoiPolygonAdvancedMatcher.h"
@@ -58,7 +59,8 @@ const unsigned int PoiPolygonMatch::REVIEW_EVIDENCE_THRESHOLD = 1;
 PoiPolygonMatch::PoiPolygonMatch(const ConstOsmMapPtr& map, ConstMatchThresholdPtr threshold,
                                  boost::shared_ptr<const PoiPolygonRfClassifier> rf,
                                  const set<ElementId>& polyNeighborIds,
-                                 const set<ElementId>& poiNeighborIds) :
+                                 const set<ElementId>& poiNeighborIds,
+                                 const boost::shared_ptr<const PoiPolygonDistanceProfileMap>& distanceProfiles) :
 Match(threshold),
 _map(map),
 _closeMatch(false),
@@ -67,6 +69,7 @@ _nameScore(-1.0),
 _addressScore(-1.0),
 _polyNeighborIds(polyNeighborIds),
 _poiNeighborIds(poiNeighborIds),
+_distanceProfiles(distanceProfiles),
 _rf(rf)
 {
 }
@@ -367,20 +370,37 @@ unsigned int PoiPolygonMatch::_getDistanceEvidence(ConstElementPtr poi, ConstEle
     return 0;
   }
 
-  //search radius taken from PoiPolygonMatchCreator
-  PoiPolygonDistance distanceCalc(
-    _matchDistanceThreshold, _reviewDistanceThreshold, poly->getTags(),
-    poi->getCircularError() + ConfigOptions().getPoiPolygonReviewDistanceThreshold());
-  //type based match distance changes didn't have any positive effect experimentally; leaving it
-  //commented out here in case there is need for further examination
-//  _matchDistanceThreshold =
-//    max(
-//      distanceCalc.getMatchDistanceForType(_t1BestKvp),
-//      distanceCalc.getMatchDistanceForType(_t2BestKvp));
-  _reviewDistanceThreshold =
-    max(
-      distanceCalc.getReviewDistanceForType(_poi->getTags()),
-      distanceCalc.getReviewDistanceForType(_poly->getTags()));
+  if (_distanceProfiles)
+  {
+    //the type derived distance parameters were computed once per element in a pre-pass (see
+    //PoiPolygonDistanceProfileMap), so none of the tag queries behind PoiPolygonDistance run
+    //inside the pair loop
+    const unsigned char poiProfile = _distanceProfiles->getProfile(poi->getElementId());
+    const unsigned char polyProfile = _distanceProfiles->getProfile(poly->getElementId());
+    _reviewDistanceThreshold =
+      max(
+        PoiPolygonDistanceProfileMap::getReviewDistance(
+          poiProfile, polyProfile, _reviewDistanceThreshold),
+        PoiPolygonDistanceProfileMap::getReviewDistance(
+          polyProfile, polyProfile, _reviewDistanceThreshold));
+  }
+  else
+  {
+    //search radius taken from PoiPolygonMatchCreator
+    PoiPolygonDistance distanceCalc(
+      _matchDistanceThreshold, _reviewDistanceThreshold, poly->getTags(),
+      poi->getCircularError() + ConfigOptions().getPoiPolygonReviewDistanceThreshold());
+    //type based match distance changes didn't have any positive effect experimentally; leaving it
+    //commented out here in case there is need for further examination
+//    _matchDistanceThreshold =
+//      max(
+//        distanceCalc.getMatchDistanceForType(_t1BestKvp),
+//        distanceCalc.getMatchDistanceForType(_t2BestKvp));
+    _reviewDistanceThreshold =
+      max(
+        distanceCalc.getReviewDistanceForType(_poi->getTags()),
+        distanceCalc.getReviewDistanceForType(_poly->getTags()));
+  }
   //density based distance changes didn't have any positive effect experimentally; leaving it
   //commented out here in case there is need for further examination
   /*if (poi->getTags().get("station") != "light_rail" &&
@@ -41,6 +41,8 @@
 namespace hoot
 {
 
+class PoiPolygonDistanceProfileMap;
+
 /**
  * This is a additive, rule based mechanism for matching POIs to polygons. See "POI to
  * Polygon Conflation" in the Hootenanny Algorithms document for more details.
@@ -56,7 +58,9 @@ public:
   PoiPolygonMatch(const ConstOsmMapPtr& map, ConstMatchThresholdPtr threshold,
     boost::shared_ptr<const PoiPolygonRfClassifier> rf,
     const std::set<ElementId>& polyNeighborIds = std::set<ElementId>(),
-    const std::set<ElementId>& poiNeighborIds = std::set<ElementId>());
+    const std::set<ElementId>& poiNeighborIds = std::set<ElementId>(),
+    const boost::shared_ptr<const PoiPolygonDistanceProfileMap>& distanceProfiles =
+      boost::shared_ptr<const PoiPolygonDistanceProfileMap>());
 
   virtual void setConfiguration(const Settings& conf);
 
@@ -164,6 +168,10 @@ private:
   std::set<ElementId> _polyNeighborIds;
   std::set<ElementId> _poiNeighborIds;
 
+  //optional side table with the type derived distance parameters precomputed per element; when
+  //absent they're computed from the tags per pair as before
+  boost::shared_ptr<const PoiPolygonDistanceProfileMap> _distanceProfiles;
+
   MatchClassification _class;
 
   bool _enableAdvancedMatching;
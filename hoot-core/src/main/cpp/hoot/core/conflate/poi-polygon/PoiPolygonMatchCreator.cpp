@@ -34,6 +34,7 @@
 #include <hoot/core/util/ConfigOptions.h>
 
 #include "PoiPolygonMatch.h"
+#include "PoiPolygonDistanceProfileMap.h"
 #include "visitors/PoiPolygonMatchVisitor.h"
 
 
@@ -78,7 +79,13 @@ void PoiPolygonMatchCreator::createMatches(const ConstOsmMapPtr& map,
 
   PoiPolygonMatch::resetMatchDistanceInfo();
 
-  PoiPolygonMatchVisitor v(map, matches, threshold, _getRf());
+  //compute the type derived distance parameters once per element before the pair loop; see
+  //PoiPolygonDistanceProfileMap
+  boost::shared_ptr<PoiPolygonDistanceProfileMap> distanceProfiles(
+    new PoiPolygonDistanceProfileMap());
+  distanceProfiles->build(map);
+
+  PoiPolygonMatchVisitor v(map, matches, threshold, _getRf(), distanceProfiles);
   map->visitRo(v);
 
   if (conf().getBool(ConfigOptions::getPoiPolygonPrintMatchDistanceTruthKey()))
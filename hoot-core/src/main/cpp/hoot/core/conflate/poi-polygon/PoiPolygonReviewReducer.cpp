@@ -30,10 +30,12 @@
 #include <geos/geom/LineString.h>
 #include <geos/util/TopologyException.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/prep/PreparedGeometry.h>
 
 // hoot
 #include <hoot/core/conflate/MatchClassification.h>
 #include <hoot/core/schema/OsmSchema.h>
+#include <hoot/core/index/OsmMapIndex.h>
 #include <hoot/core/util/ElementConverter.h>
 #include <hoot/core/conflate/polygon/extractors/AngleHistogramExtractor.h>
 #include <hoot/core/conflate/polygon/extractors/OverlapExtractor.h>
@@ -91,13 +93,14 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
   //to suppress the ElementConverter poly warnings...warnings worth looking into at some point
   DisableLog dl(Log::Warn);
 
-  ElementConverter elementConverter(_map);
-  boost::shared_ptr<Geometry> polyGeom = elementConverter.convertToGeometry(poly);
+  //the index caches the way geometries, so the repeated pairs against the same poly and the
+  //neighbor scan below don't rebuild them
+  boost::shared_ptr<const Geometry> polyGeom = _map->getIndex().getGeometry(poly);
   if (QString::fromStdString(polyGeom->toString()).toUpper().contains("EMPTY"))
   {
     throw geos::util::TopologyException();
   }
-  boost::shared_ptr<Geometry> poiGeom = elementConverter.convertToGeometry(poi);
+  boost::shared_ptr<const Geometry> poiGeom = _map->getIndex().getGeometry(poi);
 
   //The rules below are roughly ordered by increasing processing expense and by decreasing
   //likelihood of occurrence.
@@ -283,10 +286,10 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
     ConstElementPtr polyNeighbor = _map->getElement(*polyNeighborItr);
     if (polyNeighbor->getElementId() != poly->getElementId())
     {
-      boost::shared_ptr<Geometry> polyNeighborGeom;
+      boost::shared_ptr<const Geometry> polyNeighborGeom;
       try
       {
-        polyNeighborGeom = ElementConverter(_map).convertToGeometry(polyNeighbor);
+        polyNeighborGeom = _map->getIndex().getGeometry(polyNeighbor);
 
         if (polyNeighborGeom.get() &&
             QString::fromStdString(polyNeighborGeom->toString()).toUpper().contains("EMPTY"))
@@ -301,6 +304,10 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
         }
         else if (polyNeighborGeom.get())
         {
+          //the neighbor poly is probed repeatedly across the pair loop, so use its prepared
+          //form from the index
+          boost::shared_ptr<const geos::geom::prep::PreparedGeometry> polyNeighborPrepGeom =
+            _map->getIndex().getPreparedGeometry(polyNeighbor);
           if (PoiPolygonTypeScoreExtractor::isPark(polyNeighbor))
           {
             //TODO: should this be OsmSchema::elementHasName instead?
@@ -308,7 +315,7 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
             otherParkPolyNameScore = nameScorer.extract(*_map, poi, polyNeighbor);
             otherParkPolyNameMatch = otherParkPolyNameScore >= _nameScoreThreshold;
 
-            if (polyNeighborGeom->contains(poiGeom.get()))
+            if (polyNeighborPrepGeom->contains(poiGeom.get()))
             {
               poiContainedInAnotherParkPoly = true;
 
@@ -318,7 +325,7 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
               LOG_TRACE("park poly it is very close to: " << polyNeighbor->toString());
             }
 
-            if (polyNeighborGeom->intersects(polyGeom.get()))
+            if (polyNeighborPrepGeom->intersects(polyGeom.get()))
             {
               parkPolyAngleHistVal = AngleHistogramExtractor().extract(*_map, polyNeighbor, poly);
               parkPolyOverlapVal = OverlapExtractor().extract(*_map, polyNeighbor, poly);
@@ -358,7 +365,7 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
           {
             //this is a little loose, b/c there could be more than one type match set of tags...
             if (PoiPolygonTypeScoreExtractor::isSport(polyNeighbor) &&
-                polyNeighborGeom->contains(poiGeom.get()) &&
+                polyNeighborPrepGeom->contains(poiGeom.get()) &&
                 typeScorer.extract(*_map, poi, polyNeighbor) == 1.0)
             {
               sportPoiOnOtherSportPolyWithExactTypeMatch = true;
@@ -366,7 +373,7 @@ bool PoiPolygonReviewReducer::triggersRule(ConstElementPtr poi, ConstElementPtr
           }
           else if (OsmSchema::getInstance().isBuilding(polyNeighbor))
           {
-            if (polyNeighborGeom->contains(poiGeom.get()))
+            if (polyNeighborPrepGeom->contains(poiGeom.get()))
             {
               poiOnBuilding = true;
             }
@@ -27,7 +27,7 @@
 #include "PoiPolygonDistanceExtractor.h"
 
 // hoot
-#include <hoot/core/util/ElementConverter.h>
+#include <hoot/core/index/OsmMapIndex.h>
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/Log.h>
 
@@ -54,13 +54,14 @@ double PoiPolygonDistanceExtractor::extract(const OsmMap& map, const ConstElemen
     //to suppress the ElementConverter poly warnings...warnings worth looking into at some point
     DisableLog dl(Log::Warn);
 
-    ElementConverter elementConverter(map.shared_from_this());
-    boost::shared_ptr<Geometry> polyGeom = elementConverter.convertToGeometry(poly);
+    //the index caches the way geometries, so repeated pairs against the same poly don't
+    //rebuild them
+    boost::shared_ptr<const Geometry> polyGeom = map.getIndex().getGeometry(poly);
     if (QString::fromStdString(polyGeom->toString()).toUpper().contains("EMPTY"))
     {
       throw geos::util::TopologyException();
     }
-    boost::shared_ptr<Geometry> poiGeom = elementConverter.convertToGeometry(poi);
+    boost::shared_ptr<const Geometry> poiGeom = map.getIndex().getGeometry(poi);
     return polyGeom->distance(poiGeom.get());
   }
   catch (const geos::util::TopologyException& e)
@@ -34,6 +34,7 @@
 #include <hoot/core/util/Log.h>
 
 #include "../PoiPolygonMatch.h"
+#include "../PoiPolygonDistanceProfileMap.h"
 #include "../filters/PoiPolygonPolyCriterion.h"
 #include "../filters/PoiPolygonPoiCriterion.h"
 
@@ -47,22 +48,38 @@
 namespace hoot
 {
 
+//prescreen flag bits (see _getElementFlags)
+static const unsigned char FLAG_POI = 0x1;
+static const unsigned char FLAG_POLY = 0x2;
+
  PoiPolygonMatchVisitor::PoiPolygonMatchVisitor(const ConstOsmMapPtr& map,
                                                 std::vector<const Match*>& result,
                                                 ConstMatchThresholdPtr threshold,
-                                                boost::shared_ptr<PoiPolygonRfClassifier> rf) :
+                                                boost::shared_ptr<PoiPolygonRfClassifier> rf,
+                                                const boost::shared_ptr<const PoiPolygonDistanceProfileMap>& distanceProfiles) :
 _map(map),
 _result(result),
 _threshold(threshold),
-_rf(rf)
+_rf(rf),
+_distanceProfiles(distanceProfiles)
 {
   _neighborCountMax = -1;
   _neighborCountSum = 0;
   _elementsEvaluated = 0;
+  _numEnvelopeNeighbors = 0;
+  _numPrescreenRejects = 0;
+  _numFullEvaluations = 0;
+  _numMatchesCreated = 0;
 }
 
 PoiPolygonMatchVisitor::~PoiPolygonMatchVisitor()
 {
+  //show how hard the prescreen is working; in dense commercial districts the index produces far
+  //more candidates than survive to a full evaluation
+  LOG_DEBUG(
+    "POI to Polygon prescreen: " << _numEnvelopeNeighbors << " index neighbors examined, " <<
+    _numPrescreenRejects << " rejected by the cached type flags, " << _numFullEvaluations <<
+    " fully evaluated, " << _numMatchesCreated << " matches/reviews kept.");
 }
 
 void PoiPolygonMatchVisitor::_checkForMatch(const boost::shared_ptr<const Element>& e)
@@ -85,13 +102,19 @@ void PoiPolygonMatchVisitor::_checkForMatch(const boost::shared_ptr<const Elemen
     if (from != *it)
     {
       const boost::shared_ptr<const Element>& n = _map->getElement(*it);
+      _numEnvelopeNeighbors++;
 
-      if (n->isUnknown() && PoiPolygonMatch::isPoly(*n))
+      //the index query is the distance gate; the cached flags are the type gate. Both run
+      //before any of the name/type/distance scoring inside PoiPolygonMatch.
+      if (n->isUnknown() && (_getElementFlags(n) & FLAG_POLY))
       {
+        _numFullEvaluations++;
+
         // score each candidate and push it on the result vector
         PoiPolygonMatch* m =
           new PoiPolygonMatch(
-            _map, /*from, *it,*/ _threshold, _rf, _surroundingPolyIds, _surroundingPoiIds);
+            _map, /*from, *it,*/ _threshold, _rf, _surroundingPolyIds, _surroundingPoiIds,
+            _distanceProfiles);
         m->setConfiguration(conf());
         m->calculateMatch(from, *it);
 
@@ -103,9 +126,14 @@ void PoiPolygonMatchVisitor::_checkForMatch(const boost::shared_ptr<const Elemen
         else
         {
           _result.push_back(m);
+          _numMatchesCreated++;
           neighborCount++;
         }
       }
+      else
+      {
+        _numPrescreenRejects++;
+      }
     }
   }
 
@@ -132,7 +160,7 @@ void PoiPolygonMatchVisitor::_collectSurroundingPolyIds(const boost::shared_ptr<
     {
       const boost::shared_ptr<const Element>& n = _map->getElement(*it);
 
-      if (n->isUnknown() && PoiPolygonMatch::isPoly(*n))
+      if (n->isUnknown() && (_getElementFlags(n) & FLAG_POLY))
       {
         _surroundingPolyIds.insert(*it);
       }
@@ -159,7 +187,7 @@ void PoiPolygonMatchVisitor::_collectSurroundingPoiIds(const boost::shared_ptr<c
     {
       const boost::shared_ptr<const Element>& n = _map->getElement(*it);
 
-      if (n->isUnknown() && PoiPolygonMatch::isPoi(*n))
+      if (n->isUnknown() && (_getElementFlags(n) & FLAG_POI))
       {
         _surroundingPoiIds.insert(*it);
       }
@@ -191,6 +219,32 @@ void PoiPolygonMatchVisitor::visit(const ConstElementPtr& e)
   }
 }
 
+unsigned char PoiPolygonMatchVisitor::_getElementFlags(
+  const boost::shared_ptr<const Element>& e)
+{
+  const ElementId eid = e->getElementId();
+  QHash<ElementId, unsigned char>::const_iterator it = _elementFlags.find(eid);
+  if (it != _elementFlags.end())
+  {
+    return it.value();
+  }
+
+  //isPoi/isPoly walk the tag map and hit the schema category lookups; in a dense district every
+  //poly gets re-screened for every nearby POI, so the verdicts are condensed to a bitmask and
+  //computed only once per element
+  unsigned char flags = 0;
+  if (PoiPolygonMatch::isPoi(*e))
+  {
+    flags |= FLAG_POI;
+  }
+  if (PoiPolygonMatch::isPoly(*e))
+  {
+    flags |= FLAG_POLY;
+  }
+  _elementFlags.insert(eid, flags);
+  return flags;
+}
+
 bool PoiPolygonMatchVisitor::_isMatchCandidate(ConstElementPtr element)
 {
   //simpler logic to just examine each POI and check for surrounding polys, rather than check both
@@ -37,10 +37,15 @@
 // tgs
 #include <tgs/RStarTree/HilbertRTree.h>
 
+// Qt
+#include <QHash>
+
 
 namespace hoot
 {
 
+class PoiPolygonDistanceProfileMap;
+
 /**
  * Searches maps for any poi/polygon match potentials
  */
@@ -51,7 +56,10 @@ public:
 
   PoiPolygonMatchVisitor(const ConstOsmMapPtr& map, std::vector<const Match*>& result,
                          ConstMatchThresholdPtr threshold,
-                         boost::shared_ptr<PoiPolygonRfClassifier> rf);
+                         boost::shared_ptr<PoiPolygonRfClassifier> rf,
+                         const boost::shared_ptr<const PoiPolygonDistanceProfileMap>&
+                           distanceProfiles =
+                             boost::shared_ptr<const PoiPolygonDistanceProfileMap>());
   ~PoiPolygonMatchVisitor();
 
   /**
@@ -85,6 +93,20 @@ private:
 
   boost::shared_ptr<PoiPolygonRfClassifier> _rf;
 
+  //distance parameters precomputed per element, handed to each match (see
+  //PoiPolygonDistanceProfileMap)
+  boost::shared_ptr<const PoiPolygonDistanceProfileMap> _distanceProfiles;
+
+  //poi/poly verdicts cached as a bitmask per element; the schema category lookups behind
+  //isPoi/isPoly are re-run for every pair otherwise (see _getElementFlags)
+  QHash<ElementId, unsigned char> _elementFlags;
+
+  //prescreen counters, reported when the visitor is destroyed
+  long _numEnvelopeNeighbors;
+  long _numPrescreenRejects;
+  long _numFullEvaluations;
+  long _numMatchesCreated;
+
   void _checkForMatch(const boost::shared_ptr<const Element>& e);
   void _collectSurroundingPolyIds(const boost::shared_ptr<const Element>& e);
   void _collectSurroundingPoiIds(const boost::shared_ptr<const Element>& e);
@@ -92,6 +114,13 @@ private:
 
   static bool _isMatchCandidate(ConstElementPtr element);
 
+  /**
+   * Returns the POI/polygon prescreen flags for an element, computing and caching them on first
+   * use. The flags condense the OsmSchema category checks down to two bits so the per pair
+   * screening in _checkForMatch is a hash lookup and a bit test.
+   */
+  unsigned char _getElementFlags(const boost::shared_ptr<const Element>& e);
+
   boost::shared_ptr<Tgs::HilbertRTree>& _getPolyIndex();
   boost::shared_ptr<Tgs::HilbertRTree>& _getPoiIndex();
 
@@ -77,7 +77,9 @@ public:
 };
 
 BuildingMerger::BuildingMerger(const set< pair<ElementId, ElementId> >& pairs) :
-  _pairs(pairs)
+  _pairs(pairs),
+  _preserveUnknown1ElementId(
+    ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures())
 {
 }
 
@@ -165,8 +167,7 @@ void BuildingMerger::apply(const OsmMapPtr& map, vector< pair<ElementId, Element
     scrap->getTags().clear();
 
     // see comments for similar functionality in HighwaySnapMerger::_mergePair
-    if (scrapStatus == Status::Unknown1 &&
-        ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures())
+    if (scrapStatus == Status::Unknown1 && _preserveUnknown1ElementId)
     {
       LOG_TRACE(
         "Retaining reference ID by mapping unknown1 ID: " << scrapId << " to ID: " <<
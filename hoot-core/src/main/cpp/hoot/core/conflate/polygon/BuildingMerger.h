@@ -61,6 +61,8 @@ protected:
 private:
 
   std::set< std::pair<ElementId, ElementId> > _pairs;
+  // copied out of the configuration at construction; apply runs once per merged pair.
+  bool _preserveUnknown1ElementId;
 
   boost::shared_ptr<Element> _buildBuilding1(const OsmMapPtr& map) const;
   boost::shared_ptr<Element> _buildBuilding2(const OsmMapPtr& map) const;
@@ -34,8 +34,12 @@
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/conflate/extractors/Histogram.h>
 #include <hoot/core/elements/ConstElementVisitor.h>
+#include <hoot/core/elements/Way.h>
 #include <hoot/core/util/GeometryConverter.h>
 
+// Qt
+#include <QMutexLocker>
+
 using namespace geos::geom;
 using namespace std;
 
@@ -82,7 +86,7 @@ private:
 };
 
 AngleHistogramExtractor::AngleHistogramExtractor(Radians smoothing, unsigned int bins)
-  : _smoothing(smoothing), _bins(bins)
+  : _smoothing(smoothing), _bins(bins), _histogramCache(10000)
 {
 }
 
@@ -95,20 +99,63 @@ Histogram* AngleHistogramExtractor::_createHistogram(const OsmMap& map, const Co
   return result;
 }
 
+boost::shared_ptr<const Histogram> AngleHistogramExtractor::_getHistogram(const OsmMap& map,
+  const ConstElementPtr& e) const
+{
+  if (e->getElementType() != ElementType::Way)
+  {
+    // relations aggregate several child geometries and have no cheap version stamp, so they
+    // aren't cached.
+    return boost::shared_ptr<const Histogram>(_createHistogram(map, e));
+  }
+
+  ConstWayPtr w = boost::dynamic_pointer_cast<const Way>(e);
+  const QString key = QString("%1;%2;%3").arg(w->getId()).arg(w->getGeometryRevision())
+    .arg(Element::getNodePositionEpoch());
+
+  {
+    QMutexLocker locker(&_histogramCacheMutex);
+    boost::shared_ptr<const Histogram>* cached = _histogramCache.object(key);
+    if (cached != 0)
+    {
+      return *cached;
+    }
+  }
+
+  boost::shared_ptr<const Histogram> result(_createHistogram(map, e));
+
+  QMutexLocker locker(&_histogramCacheMutex);
+  if (_histogramCache.contains(key) == false)
+  {
+    _histogramCache.insert(key, new boost::shared_ptr<const Histogram>(result));
+  }
+  return result;
+}
+
+void AngleHistogramExtractor::_clearHistogramCache()
+{
+  QMutexLocker locker(&_histogramCacheMutex);
+  _histogramCache.clear();
+}
+
 double AngleHistogramExtractor::extract(const OsmMap& map, const ConstElementPtr& target,
   const ConstElementPtr& candidate) const
 {
-  auto_ptr<Histogram> h1(_createHistogram(map, target));
-  auto_ptr<Histogram> h2(_createHistogram(map, candidate));
+  boost::shared_ptr<const Histogram> h1 = _getHistogram(map, target);
+  boost::shared_ptr<const Histogram> h2 = _getHistogram(map, candidate);
   if (_smoothing > 0.0)
   {
-    h1->smooth(_smoothing);
-    h2->smooth(_smoothing);
+    // smoothing mutates, so work on copies of the cached histograms
+    Histogram s1(*h1);
+    Histogram s2(*h2);
+    s1.smooth(_smoothing);
+    s2.smooth(_smoothing);
+    const double diff = max(0.0, s1.normalizedDiff(s2));
+    return 1.0 - diff;
   }
-  h1->normalize();
-  h2->normalize();
 
-  const double diff = max(0.0, h1->diff(*h2));
+  // the common path compares the shared histograms in place without copying or normalizing
+  const double diff = max(0.0, h1->normalizedDiff(*h2));
   return 1.0 - diff;
 }
 
@@ -32,6 +32,10 @@
 #include <hoot/core/conflate/extractors/FeatureExtractor.h>
 #include <hoot/core/elements/Element.h>
 
+// Qt
+#include <QCache>
+#include <QMutex>
+
 namespace geos
 {
 namespace geom
@@ -81,8 +85,29 @@ public:
 protected:
   virtual Histogram* _createHistogram(const OsmMap& map, const ConstElementPtr& e) const;
 
+  /**
+   * Returns the raw (unsmoothed, unnormalized) histogram for e, serving ways from a per instance
+   * cache. A feature's histogram gets rebuilt once per candidate pair it participates in, so the
+   * cache turns O(pairs) derivations into O(features). The key includes the way's geometry
+   * revision and the node position epoch, so edits to the way or its nodes invalidate stale
+   * entries. The histogram is shared with the cache, so treat it as read only.
+   */
+  boost::shared_ptr<const Histogram> _getHistogram(const OsmMap& map,
+    const ConstElementPtr& e) const;
+
+  /**
+   * Drops all cached histograms. Subclasses must call this when a setting that changes the output
+   * of _createHistogram is modified.
+   */
+  void _clearHistogramCache();
+
   Radians _smoothing;
   unsigned int _bins;
+
+private:
+  // a raw histogram is only a handful of doubles, so even a full cache stays small.
+  mutable QCache<QString, boost::shared_ptr<const Histogram> > _histogramCache;
+  mutable QMutex _histogramCacheMutex;
 };
 
 }
@@ -28,6 +28,7 @@
 #include "DualWaySplitter.h"
 
 // GEOS
+#include <geos/geom/CoordinateArraySequence.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/GeometryFactory.h>
@@ -60,6 +61,9 @@ using namespace geos::operation::buffer;
 
 // Qt
 #include <QDebug>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
 
 // Standard
 #include <limits>
@@ -260,6 +264,76 @@ boost::shared_ptr<OsmMap> DualWaySplitter::splitAll(boost::shared_ptr<const OsmM
   return dws.splitAll();
 }
 
+DualWaySplitter::OffsetGeometry DualWaySplitter::_buildOffsetGeometry(
+  const std::vector<Coordinate>& coords, double splitSize)
+{
+  OffsetGeometry result;
+  result.leftIsFallback = false;
+  result.rightIsFallback = false;
+  result.zeroLength = false;
+
+  // each call uses its own factory so no GEOS state is shared between worker threads.
+  GeometryFactory gf;
+  CoordinateArraySequence* cs = new CoordinateArraySequence();
+  for (size_t i = 0; i < coords.size(); i++)
+  {
+    cs->add(coords[i]);
+  }
+  // the line string takes ownership of the sequence.
+  auto_ptr<LineString> ls(gf.createLineString(cs));
+
+  if (ls->getLength() <= 0.0)
+  {
+    result.zeroLength = true;
+    return result;
+  }
+
+  for (int side = 0; side < 2; side++)
+  {
+    const bool left = (side == 0);
+
+    BufferParameters bp(8, BufferParameters::CAP_FLAT, BufferParameters::JOIN_ROUND,
+                        splitSize * 2);
+    BufferBuilder bb(bp);
+    auto_ptr<Geometry> g(bb.bufferLineSingleSided(ls.get(), splitSize, left));
+    const LineString* newLs = dynamic_cast<const LineString*>(g.get());
+
+    vector<Coordinate>& out = left ? result.left : result.right;
+    bool& fallback = left ? result.leftIsFallback : result.rightIsFallback;
+
+    // This sometimes happens if the buffer builder returns a multilinestring. See #2275
+    if (newLs == 0)
+    {
+      out = coords;
+      fallback = true;
+    }
+    else
+    {
+      const CoordinateSequence* ncs = newLs->getCoordinatesRO();
+      out.reserve(ncs->getSize());
+      for (size_t i = 0; i < ncs->getSize(); i++)
+      {
+        out.push_back(ncs->getAt(i));
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<DualWaySplitter::OffsetGeometry> DualWaySplitter::_buildOffsetGeometries(
+  const std::vector<std::vector<Coordinate> >* coords, const std::vector<double>* splitSizes,
+  size_t beginIdx, size_t endIdx)
+{
+  vector<OffsetGeometry> result;
+  result.reserve(endIdx - beginIdx);
+  for (size_t i = beginIdx; i < endIdx; i++)
+  {
+    result.push_back(_buildOffsetGeometry((*coords)[i], (*splitSizes)[i]));
+  }
+  return result;
+}
+
 boost::shared_ptr<OsmMap> DualWaySplitter::splitAll()
 {
   boost::shared_ptr<OsmMap> result(new OsmMap(_map));
@@ -268,16 +342,72 @@ boost::shared_ptr<OsmMap> DualWaySplitter::splitAll()
   TagCriterion tagCrit("divider", "yes");
   vector<long> wayIds = FindWaysVisitor::findWays(_result, &tagCrit);
 
+  const int threadCount = QThread::idealThreadCount();
   bool todoLogged = false;
-  for (size_t i = 0; i < wayIds.size(); i++)
+  if (threadCount > 1 && wayIds.size() >= 8)
   {
-    if (Log::getInstance().isInfoEnabled() && wayIds.size() % 1000 == 0 && wayIds.size() > 0)
+    // Snapshot the coordinates of each divider way. The offset geometry depends only on the
+    // unmodified input way (node coordinates never change while splitting), so it can be built
+    // on worker threads before any way is touched.
+    vector< vector<Coordinate> > coords(wayIds.size());
+    vector<double> splitSizes(wayIds.size());
+    for (size_t i = 0; i < wayIds.size(); i++)
+    {
+      boost::shared_ptr<const Way> w = _map->getWay(wayIds[i]);
+      const vector<long>& nids = w->getNodeIds();
+      coords[i].reserve(nids.size());
+      for (size_t j = 0; j < nids.size(); j++)
+      {
+        coords[i].push_back(_map->getNode(nids[j])->toCoordinate());
+      }
+      splitSizes[i] = _defaultSplitSize / 2.0;
+      if (w->getTags().contains("divider:width"))
+      {
+        splitSizes[i] = w->getTags().readMeters("divider:width") / 2.0;
+      }
+    }
+
+    QList< QFuture< vector<OffsetGeometry> > > futures;
+    const size_t chunkSize = (wayIds.size() + threadCount - 1) / threadCount;
+    for (size_t beginIdx = 0; beginIdx < wayIds.size(); beginIdx += chunkSize)
     {
-      cout << "  splitting " << i << " / " << wayIds.size() << "\r";
-      cout.flush();
-      todoLogged = true;
+      const size_t endIdx = std::min(beginIdx + chunkSize, wayIds.size());
+      futures.append(QtConcurrent::run(&DualWaySplitter::_buildOffsetGeometries, &coords,
+        &splitSizes, beginIdx, endIdx));
+    }
+
+    vector<OffsetGeometry> geometries;
+    geometries.reserve(wayIds.size());
+    for (int i = 0; i < futures.size(); i++)
+    {
+      const vector<OffsetGeometry> part = futures[i].result();
+      geometries.insert(geometries.end(), part.begin(), part.end());
+    }
+
+    // apply the results serially in input order so the output is deterministic.
+    for (size_t i = 0; i < wayIds.size(); i++)
+    {
+      if (Log::getInstance().isInfoEnabled() && i % 1000 == 0 && i > 0)
+      {
+        cout << "  splitting " << i << " / " << wayIds.size() << "\r";
+        cout.flush();
+        todoLogged = true;
+      }
+      _splitWay(wayIds[i], &geometries[i]);
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < wayIds.size(); i++)
+    {
+      if (Log::getInstance().isInfoEnabled() && wayIds.size() % 1000 == 0 && wayIds.size() > 0)
+      {
+        cout << "  splitting " << i << " / " << wayIds.size() << "\r";
+        cout.flush();
+        todoLogged = true;
+      }
+      _splitWay(wayIds[i]);
     }
-    _splitWay(wayIds[i]);
   }
 
   if (Log::getInstance().isInfoEnabled() && todoLogged)
@@ -289,6 +419,39 @@ boost::shared_ptr<OsmMap> DualWaySplitter::splitAll()
   return result;
 }
 
+boost::shared_ptr<Way> DualWaySplitter::_wayFromCoordinates(boost::shared_ptr<const Way> w,
+  const std::vector<Coordinate>& coords, bool isFallback)
+{
+  if (isFallback)
+  {
+    // see the corresponding branch in _createOneWay; the warning is logged here rather than on
+    // the worker thread so the warn count stays consistent.
+    if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN(
+        "Inappropriate handling of geometry.  Adding original line back in to keep things moving...");
+    }
+    else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+    }
+    logWarnCount++;
+  }
+
+  boost::shared_ptr<Way> result(new Way(w->getStatus(), _result->createNextWayId(),
+    w->getRawCircularError()));
+
+  for (size_t i = 0; i < coords.size(); i++)
+  {
+    boost::shared_ptr<Node> n(new Node(w->getStatus(), _result->createNextNodeId(), coords[i],
+      w->getCircularError()));
+    _result->addNode(n);
+    result->addNode(n->getId());
+  }
+
+  return result;
+}
+
 void DualWaySplitter::_fixLanes(boost::shared_ptr<Way> w)
 {
   QString lanesStr = w->getTags()["lanes"];
@@ -404,11 +567,12 @@ void DualWaySplitter::_splitIntersectingWays(long nid)
   }
 }
 
-void DualWaySplitter::_splitWay(long wid)
+void DualWaySplitter::_splitWay(long wid, const OffsetGeometry* geom)
 {
   _working = _map->getWay(wid);
 
-  if (ElementConverter(_result).convertToLineString(_working)->getLength() <= 0.0)
+  if (geom != 0 ? geom->zeroLength :
+      ElementConverter(_result).convertToLineString(_working)->getLength() <= 0.0)
   {
     return;
   }
@@ -421,8 +585,16 @@ void DualWaySplitter::_splitWay(long wid)
   }
 
   // Create the two new ways.
-  _left = _createOneWay(_working, _splitSize, true);
-  _right = _createOneWay(_working, _splitSize, false);
+  if (geom != 0)
+  {
+    _left = _wayFromCoordinates(_working, geom->left, geom->leftIsFallback);
+    _right = _wayFromCoordinates(_working, geom->right, geom->rightIsFallback);
+  }
+  else
+  {
+    _left = _createOneWay(_working, _splitSize, true);
+    _right = _createOneWay(_working, _splitSize, false);
+  }
 
   // set the tags
   _left->setTags(_working->getTags());
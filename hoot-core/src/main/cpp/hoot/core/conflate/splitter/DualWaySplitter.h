@@ -35,6 +35,9 @@
 #include <hoot/core/util/Units.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 
+// Standard
+#include <vector>
+
 // Tgs
 #include <tgs/SharedPtr.h>
 
@@ -74,6 +77,23 @@ public:
   void apply(boost::shared_ptr<OsmMap>& map);
 
 private:
+
+  /**
+   * Precomputed one-way offset geometry for a single divider way. The offset coordinates depend
+   * only on the unmodified input way, so they can be generated on worker threads before any way
+   * is split.
+   */
+  struct OffsetGeometry
+  {
+    std::vector<geos::geom::Coordinate> left;
+    std::vector<geos::geom::Coordinate> right;
+    //set when the single-sided buffer didn't produce a line string and the original coordinates
+    //are used instead; the warning is logged when the result is applied.
+    bool leftIsFallback;
+    bool rightIsFallback;
+    bool zeroLength;
+  };
+
   Meters _defaultSplitSize;
   DrivingSide _drivingSide;
   boost::shared_ptr<const OsmMap> _map;
@@ -107,7 +127,31 @@ private:
 
   void _splitIntersectingWays(long nid);
 
-  void _splitWay(long wid);
+  /**
+   * Splits the given divider way. When geom is provided the precomputed offset coordinates are
+   * used; otherwise the buffers are built inline (single threaded path).
+   */
+  void _splitWay(long wid, const OffsetGeometry* geom = 0);
+
+  /**
+   * Builds the offset geometry for the given input coordinates. Pure geometry; safe to run on a
+   * worker thread.
+   */
+  static OffsetGeometry _buildOffsetGeometry(const std::vector<geos::geom::Coordinate>& coords,
+                                             double splitSize);
+
+  /**
+   * Worker function; builds offset geometries for the tasks in [beginIdx, endIdx).
+   */
+  static std::vector<OffsetGeometry> _buildOffsetGeometries(
+    const std::vector<std::vector<geos::geom::Coordinate> >* coords,
+    const std::vector<double>* splitSizes, size_t beginIdx, size_t endIdx);
+
+  /**
+   * Creates a new way in the result map from the given precomputed coordinates.
+   */
+  boost::shared_ptr<Way> _wayFromCoordinates(boost::shared_ptr<const Way> w,
+    const std::vector<geos::geom::Coordinate>& coords, bool isFallback);
 };
 
 }
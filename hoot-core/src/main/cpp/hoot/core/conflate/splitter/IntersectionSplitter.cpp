@@ -115,17 +115,6 @@ void IntersectionSplitter::_mapNodesToWays()
   }
 }
 
-void IntersectionSplitter::_removeWayFromMap(boost::shared_ptr<Way> way)
-{
-  long wId = way->getId();
-
-  const std::vector<long>& nodes = way->getNodeIds();
-  for (size_t i = 0; i < nodes.size(); i++)
-  {
-    _nodeToWays.remove(nodes[i], wId);
-  }
-}
-
 void IntersectionSplitter::splitIntersections(boost::shared_ptr<OsmMap> map)
 {
   IntersectionSplitter is(map);
@@ -136,41 +125,32 @@ void IntersectionSplitter::splitIntersections()
 {
   // make a map of nodes to ways.
   _mapNodesToWays();
-  _wayReplacements.clear();
 
-  // go through all the nodes
-  bool todoLogged = false;
-  while (_todoNodes.isEmpty() == false)
+  // Plan every split up front against the unsplit ways. Splitting doesn't add intersection nodes
+  // and doesn't change a node's neighbors within the piece that keeps it, so decisions made
+  // against the original ways match what splitting one intersection at a time would produce --
+  // without re-querying the node-to-way mapping after every split.
+  QHash<long, QSet<int> > splitPoints;
+  foreach (long nodeId, _todoNodes)
   {
-    long nodeId = *_todoNodes.begin();
-    //  Remove the node first in case it needs to be reprocessed later
-    _todoNodes.remove(nodeId);
-
-    if (Log::getInstance().isInfoEnabled() && _todoNodes.size() % 1000 == 0 && _todoNodes.size() > 0)
-    {
-      cout << "  Intersection splitter todo: " << _todoNodes.size() << "       \r";
-      cout.flush();
-      todoLogged = true;
-    }
     // if the node is part of two or more ways
     if (_nodeToWays.count(nodeId) >= 2)
     {
-      // evaluate each way for splitting
+      // evaluate each way for splitting; a self-intersecting way is listed more than once.
       QList<long> ways = _nodeToWays.values(nodeId);
-      for (QList<long>::const_iterator way = ways.begin(); way != ways.end(); ++way)
+      foreach (long wayId, QSet<long>::fromList(ways))
       {
-        _splitWay(*way, nodeId);
+        _planSplits(wayId, nodeId, splitPoints);
       }
     }
   }
 
-  if (Log::getInstance().isInfoEnabled() && todoLogged)
-  {
-    cout << endl;
-  }
+  // execute all of the splits for each way in a single pass.
+  _applySplits(splitPoints);
 }
 
-void IntersectionSplitter::_splitWay(long wayId, long nodeId)
+void IntersectionSplitter::_planSplits(long wayId, long nodeId,
+                                       QHash<long, QSet<int> >& splitPoints)
 {
   boost::shared_ptr<Way> way = _map->getWay(wayId);
   if (way == 0)
@@ -179,28 +159,18 @@ void IntersectionSplitter::_splitWay(long wayId, long nodeId)
     return;
   }
 
-  LOG_TRACE(
-    "Splitting way: " << way->getElementId() << " at node: " <<
-    ElementId(ElementType::Node, nodeId));
-
-  // find the first index of the split node that isn't an endpoint.
-  int firstIndex = -1;
   const std::vector<long>& nodeIds = way->getNodeIds();
+  QList<long> ways = _nodeToWays.values(nodeId);
+
+  // every interior occurrence of the node is a candidate split point. For a self-intersecting way
+  // the later occurrences would otherwise only surface when the split pieces were reprocessed.
   for (size_t i = 1; i < nodeIds.size() - 1; i++)
   {
-    if (nodeIds[i] == nodeId)
+    if (nodeIds[i] != nodeId)
     {
-      firstIndex = i;
-      break;
+      continue;
     }
-  }
-  LOG_VART(firstIndex);
 
-  // if the first index wasn't an endpoint.
-  if (firstIndex != -1)
-  {
-    QList<long> ways = _nodeToWays.values(nodeId);
-    LOG_VART(ways);
     int concurrent_count = 0;
     int otherWays_count = ways.count() - 1;
     for (QList<long>::const_iterator it = ways.begin(); it != ways.end(); ++it)
@@ -212,22 +182,18 @@ void IntersectionSplitter::_splitWay(long wayId, long nodeId)
         continue;
 
       //  Get the way info to make the comparison
-      if (_wayReplacements.contains(compWayId))
-      {
-        compWayId = _wayReplacements[compWayId];
-      }
       boost::shared_ptr<Way> comp = _map->getWay(compWayId);
       LOG_VART(comp.get());
       const std::vector<long>& compIds = comp->getNodeIds();
       long idx = comp->getNodeIndex(nodeId);
 
       //  Endpoints of the other way should be split
-      if (idx < 1 || idx > (long)compIds.size() - 1)
+      if (idx < 1 || idx >= (long)compIds.size() - 1)
         continue;
 
       //  Check both in forward and reverse for shared nodes in the way
-      if ((nodeIds[firstIndex - 1] == compIds[idx - 1] && nodeIds[firstIndex + 1] == compIds[idx + 1]) ||
-          (nodeIds[firstIndex - 1] == compIds[idx + 1] && nodeIds[firstIndex + 1] == compIds[idx - 1]))
+      if ((nodeIds[i - 1] == compIds[idx - 1] && nodeIds[i + 1] == compIds[idx + 1]) ||
+          (nodeIds[i - 1] == compIds[idx + 1] && nodeIds[i + 1] == compIds[idx - 1]))
         concurrent_count++;
     }
 
@@ -235,55 +201,93 @@ void IntersectionSplitter::_splitWay(long wayId, long nodeId)
     //  A split point is found when there is at least one non-concurrent way at this node
     if (concurrent_count < otherWays_count)
     {
-      // split the way and remove it from the map
-      WayLocation wl(_map, way, firstIndex, 0.0);
-      vector< boost::shared_ptr<Way> > splits = WaySplitter::split(_map, way, wl);
+      splitPoints[wayId].insert((int)i);
+    }
+  }
+}
 
-      // if a split occurred.
-      if (splits.size() > 1)
-      {
-        LOG_VART(way->getElementId());
-        LOG_VART(way->getStatus());
-        LOG_VART(splits[0]->getElementId());
+void IntersectionSplitter::_applySplits(const QHash<long, QSet<int> >& splitPoints)
+{
+  int processed = 0;
+  bool todoLogged = false;
+  for (QHash<long, QSet<int> >::const_iterator spIt = splitPoints.begin();
+       spIt != splitPoints.end(); ++spIt)
+  {
+    processed++;
+    if (Log::getInstance().isInfoEnabled() && processed % 1000 == 0)
+    {
+      cout << "  Intersection splitter: " << processed << " / " << splitPoints.size() <<
+        " ways       \r";
+      cout.flush();
+      todoLogged = true;
+    }
 
-        const ElementId splitWayId = way->getElementId();
+    boost::shared_ptr<Way> way = _map->getWay(spIt.key());
+    if (way == 0)
+    {
+      continue;
+    }
 
-        QList<ElementPtr> newWays;
-        foreach (const boost::shared_ptr<Way>& w, splits)
-        {
-          newWays.append(w);
-        }
+    QList<int> indexes = spIt.value().toList();
+    qSort(indexes);
 
-        // make sure any ways that are part of relations continue to be part of those relations after
-        // they're split.
-        _map->replace(way, newWays);
+    LOG_TRACE("Splitting way: " << way->getElementId() << " at " << indexes.size() << " nodes");
 
-        // see comments for similar functionality in HighwaySnapMerger::_mergePair
-        if (ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures() &&
-            way->getStatus() == Status::Unknown1)
-        {
-          LOG_TRACE(
-            "Setting unknown1 " << way->getElementId().getId() << " on " <<
-            splits[0]->getElementId() << "...");
-          ElementPtr newWaySegment(_map->getElement(splits[0]->getElementId())->clone());
-          newWaySegment->setId(way->getElementId().getId());
-          _map->replace(_map->getElement(splits[0]->getElementId()), newWaySegment);
-          _wayReplacements[splits[0]->getElementId().getId()] = way->getElementId().getId();
-        }
+    vector<WayLocation> wls;
+    wls.reserve(indexes.size());
+    for (int i = 0; i < indexes.size(); i++)
+    {
+      wls.push_back(WayLocation(_map, way, indexes[i], 0.0));
+    }
 
-        _removeWayFromMap(way);
+    // split the way at all of its intersections at once.
+    WaySplitter splitter(_map, way);
+    vector< boost::shared_ptr<Way> > rawSplits = splitter.createSplits(wls);
 
-        // go through all the resulting splits
-        for (size_t i = 0; i < splits.size(); i++)
-        {
-          // add the new ways nodes just in case the way was self intersecting.
-          _mapNodesToWay(splits[i]);
-        }
+    vector< boost::shared_ptr<Way> > splits;
+    for (size_t i = 0; i < rawSplits.size(); i++)
+    {
+      if (rawSplits[i])
+      {
+        splits.push_back(rawSplits[i]);
+      }
+    }
+
+    // if a split occurred.
+    if (splits.size() > 1)
+    {
+      LOG_VART(way->getElementId());
+      LOG_VART(way->getStatus());
+      LOG_VART(splits[0]->getElementId());
 
-        LOG_VART(_map->containsElement(splitWayId));
+      QList<ElementPtr> newWays;
+      foreach (const boost::shared_ptr<Way>& w, splits)
+      {
+        newWays.append(w);
+      }
+
+      // make sure any ways that are part of relations continue to be part of those relations after
+      // they're split.
+      _map->replace(way, newWays);
+
+      // see comments for similar functionality in HighwaySnapMerger::_mergePair
+      if (ConfigOptions().getPreserveUnknown1ElementIdWhenModifyingFeatures() &&
+          way->getStatus() == Status::Unknown1)
+      {
+        LOG_TRACE(
+          "Setting unknown1 " << way->getElementId().getId() << " on " <<
+          splits[0]->getElementId() << "...");
+        ElementPtr newWaySegment(_map->getElement(splits[0]->getElementId())->clone());
+        newWaySegment->setId(way->getElementId().getId());
+        _map->replace(_map->getElement(splits[0]->getElementId()), newWaySegment);
       }
     }
   }
+
+  if (Log::getInstance().isInfoEnabled() && todoLogged)
+  {
+    cout << endl;
+  }
 }
 
 void IntersectionSplitter::apply(boost::shared_ptr<OsmMap> &map)
@@ -32,9 +32,9 @@
 #include <hoot/core/ops/OsmMapOperation.h>
 
 // Qt
+#include <QHash>
 #include <QMultiHash>
 #include <QSet>
-#include <QMap>
 
 namespace hoot
 {
@@ -70,18 +70,22 @@ private:
   boost::shared_ptr<OsmMap> _map;
   QMultiHash<long, long> _nodeToWays;
   QSet<long> _todoNodes;
-  QMap<long, long> _wayReplacements;
 
   void _mapNodesToWays();
 
   void _mapNodesToWay(boost::shared_ptr<Way> w);
 
-  void _removeWayFromMap(boost::shared_ptr<Way> way);
+  /**
+   * Records the interior node indexes at which the given way should be split at the given node.
+   * Planning happens against the unsplit ways, before any split is executed.
+   */
+  void _planSplits(long wayId, long nodeId, QHash<long, QSet<int> >& splitPoints);
 
   /**
-   * Given a way and a node, split the way at that node.
+   * Executes all of the planned splits, splitting each way exactly once at all of its split
+   * points.
    */
-  void _splitWay(long wayId, long nodeId);
+  void _applySplits(const QHash<long, QSet<int> >& splitPoints);
 };
 
 }
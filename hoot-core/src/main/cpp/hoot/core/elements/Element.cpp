@@ -35,6 +35,8 @@
 namespace hoot
 {
 
+unsigned long Element::_nodePositionEpoch = 0;
+
 Element::Element() :
   _status(Status::Invalid),
   _listener(0)
@@ -53,6 +55,8 @@ QString Element::getStatusString() const
 
 void Element::_postGeometryChange()
 {
+  // way and relation membership is part of the content hash.
+  _getElementData().clearCachedHash();
   if (_listener != 0)
   {
     _listener->postGeometryChange(this);
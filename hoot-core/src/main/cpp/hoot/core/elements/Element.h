@@ -126,6 +126,16 @@ public:
   bool getVisible() const { return _getElementData().getVisible(); }
   void setVisible(bool visible) { _getElementData().setVisible(visible); }
 
+  /**
+   * The element's cached content hash. Maintained by CalculateHashVisitor and invalidated by the
+   * mutators on this class and its subclasses; other code should treat the value and epoch as
+   * opaque. See ElementData::getCachedHash.
+   */
+  const QByteArray& getCachedHash() const { return _getElementData().getCachedHash(); }
+  int getCachedHashEpoch() const { return _getElementData().getCachedHashEpoch(); }
+  void setCachedHash(const QByteArray& hash, int epoch) const
+  { _getElementData().setCachedHash(hash, epoch); }
+
   Status getStatus() const { return _status; }
   QString getStatusString() const;
 
@@ -148,6 +158,15 @@ public:
    */
   virtual QString toString() const = 0;
 
+  /**
+   * Returns a process wide counter that is incremented every time any node's position changes.
+   * Derived geometry caches (e.g. the way envelope cache) record the epoch they were computed at
+   * and treat themselves as stale once it moves. This is intentionally coarse; it trades some
+   * unnecessary recomputation after node moves for not having to track node to way membership on
+   * every coordinate change.
+   */
+  static unsigned long getNodePositionEpoch() { return _nodePositionEpoch; }
+
   /**
    * Applies a read only visitor to this element and all child elements. The visitor will be called
    * at least once for each element in the tree. For instance if the Element is a Way it may be
@@ -187,15 +206,17 @@ protected:
 
   ElementListener* _listener;
 
+  static unsigned long _nodePositionEpoch;
+
   Element(Status s);
 
   virtual ElementData& _getElementData() = 0;
 
   virtual const ElementData& _getElementData() const = 0;
 
-  void _postGeometryChange();
+  virtual void _postGeometryChange();
 
-  void _preGeometryChange();
+  virtual void _preGeometryChange();
 
 };
 
@@ -39,6 +39,7 @@
 // Standard
 #include <set>
 
+#include <QByteArray>
 #include <QString>
 
 namespace hoot
@@ -64,7 +65,7 @@ public:
 
   virtual ~ElementData() {}
 
-  virtual void clear() { _tags.clear(); }
+  virtual void clear() { _tags.clear(); clearCachedHash(); }
 
   Meters getCircularError() const { return _circularError >= 0 ? _circularError : 15.0; }
 
@@ -91,16 +92,31 @@ public:
   void setUid(long uid) { _uid = uid; }
 
   const Tags& getTags() const { return _tags; }
-  Tags& getTags() { return _tags; }
+  // a mutable reference may be used to change the tags, so conservatively drop the cached hash.
+  Tags& getTags() { clearCachedHash(); return _tags; }
 
-  void setCircularError(Meters circularError) { _circularError = circularError; }
+  void setCircularError(Meters circularError)
+  { _circularError = circularError; clearCachedHash(); }
 
-  void setTags(const Tags& tags) { _tags = tags; }
-  void setTag(QString k, QString v) { _tags.insert(k, v); }
+  void setTags(const Tags& tags) { _tags = tags; clearCachedHash(); }
+  void setTag(QString k, QString v) { _tags.insert(k, v); clearCachedHash(); }
 
   bool getVisible() const { return _visible; }
   void setVisible(bool visible) { _visible = visible; }
 
+  /**
+   * The element's content hash as computed by CalculateHashVisitor, or empty if it hasn't been
+   * computed since the last mutation of the hashed content. The cache lets workflows that check
+   * hashes repeatedly (changeset derivation, tile dedup, content-addressed caching) avoid a full
+   * recompute per check. The epoch records the hash sensitivity settings the hash was computed
+   * under; CalculateHashVisitor maintains both and other code should treat them as opaque.
+   */
+  const QByteArray& getCachedHash() const { return _cachedHash; }
+  int getCachedHashEpoch() const { return _cachedHashEpoch; }
+  void setCachedHash(const QByteArray& hash, int epoch) const
+  { _cachedHash = hash; _cachedHashEpoch = epoch; }
+  void clearCachedHash() const { _cachedHash.clear(); }
+
 protected:
 
   // Please don't add any additional constructors. Multiple constructors has lead to a large number
@@ -122,6 +138,10 @@ protected:
   QString _user;
   long _uid;
   bool _visible;
+  // the hash is a cache over the other members, so computing it on a const element is still
+  // logically const.
+  mutable QByteArray _cachedHash;
+  mutable int _cachedHashEpoch;
 
 };
 
@@ -136,7 +156,8 @@ inline ElementData::ElementData(long id, const Tags& tags, Meters circularError,
   _timestamp(timestamp),
   _user(user),
   _uid(uid),
-  _visible(visible)
+  _visible(visible),
+  _cachedHashEpoch(0)
 {
 }
 
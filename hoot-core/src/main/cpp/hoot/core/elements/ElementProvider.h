@@ -39,6 +39,12 @@ class OGRSpatialReference;
 #include "Way.h"
 #include "Relation.h"
 
+// hoot
+#include <hoot/core/util/HootException.h>
+
+// Standard
+#include <vector>
+
 namespace hoot
 {
 
@@ -66,6 +72,27 @@ public:
 
   virtual const WayPtr getWay(long id) = 0;
 
+  /**
+   * Resolves an array of node ids to an array of coordinates in a single call. Way geometry
+   * assembly does this constantly, so providers backed by an in-memory node store override the
+   * default to avoid handing out one node pointer per id. Throws if an id isn't known to the
+   * provider.
+   */
+  virtual void getNodeCoordinates(const std::vector<long>& ids,
+    std::vector<geos::geom::Coordinate>& coords) const
+  {
+    coords.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      ConstNodePtr n = getNode(ids[i]);
+      if (n.get() == 0)
+      {
+        throw HootException(QString("Unknown node id: %1").arg(ids[i]));
+      }
+      coords[i] = n->toCoordinate();
+    }
+  }
+
   virtual bool containsNode(long id) const = 0;
 
   virtual bool containsRelation(long id) const = 0;
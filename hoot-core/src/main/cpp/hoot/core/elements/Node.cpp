@@ -89,11 +89,15 @@ Envelope* Node::getEnvelope(const boost::shared_ptr<const ElementProvider> &/*ep
 void Node::setX(double x)
 {
   _nodeData.setX(x);
+  _nodeData.clearCachedHash();
+  ++_nodePositionEpoch;
 }
 
 void Node::setY(double y)
 {
   _nodeData.setY(y);
+  _nodeData.clearCachedHash();
+  ++_nodePositionEpoch;
 }
 
 boost::shared_ptr<geos::geom::Point> Node::toPoint() const
@@ -0,0 +1,103 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "PackedNodeCoordinates.h"
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/util/HootException.h>
+
+// Standard
+#include <algorithm>
+
+using namespace std;
+
+namespace hoot
+{
+
+PackedNodeCoordinates::PackedNodeCoordinates(const OsmMap& map)
+{
+  const NodeMap& nodes = map.getNodes();
+  _nodeIds.reserve(nodes.size());
+  _x.reserve(nodes.size());
+  _y.reserve(nodes.size());
+
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    const Node* n = it->second.get();
+    _nodeIds.push_back(it->first);
+    _x.push_back(n->getX());
+    _y.push_back(n->getY());
+  }
+}
+
+OGREnvelope PackedNodeCoordinates::calculateBounds() const
+{
+  OGREnvelope result;
+
+  if (_x.empty())
+  {
+    return result;
+  }
+
+  double minX = _x[0];
+  double maxX = _x[0];
+  double minY = _y[0];
+  double maxY = _y[0];
+
+  // straight min/max over contiguous doubles; compilers vectorize this.
+  const size_t s = _x.size();
+  for (size_t i = 1; i < s; ++i)
+  {
+    minX = std::min(minX, _x[i]);
+    maxX = std::max(maxX, _x[i]);
+    minY = std::min(minY, _y[i]);
+    maxY = std::max(maxY, _y[i]);
+  }
+
+  result.Merge(minX, minY);
+  result.Merge(maxX, maxY);
+
+  return result;
+}
+
+void PackedNodeCoordinates::applyToMap(OsmMap& map) const
+{
+  for (size_t i = 0; i < _nodeIds.size(); ++i)
+  {
+    const NodePtr& n = map.getNode(_nodeIds[i]);
+    if (!n)
+    {
+      throw HootException(QString("Node %1 was removed while a packed coordinate snapshot was "
+        "outstanding.").arg(_nodeIds[i]));
+    }
+    n->setX(_x[i]);
+    n->setY(_y[i]);
+  }
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PACKEDNODECOORDINATES_H
+#define PACKEDNODECOORDINATES_H
+
+// GDAL
+#include <ogr_core.h>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+class OsmMap;
+
+/**
+ * A struct-of-arrays snapshot of a map's node coordinates.
+ *
+ * Walking every node through a shared pointer is cache-hostile and the dominant cost in purely
+ * data-parallel operations such as bounds calculation and reprojection. This class gathers all
+ * the node coordinates into parallel contiguous arrays of x/y doubles (plus the matching node
+ * IDs) so those operations can run as tight loops over flat memory. The loops are deliberately
+ * branch-free so the compiler can vectorize them.
+ *
+ * This is a snapshot, not a live view. The OsmMapListener interface only reports node
+ * replacement, so there is no hook to keep a table like this in sync through arbitrary mutations.
+ * Gather the coordinates, operate on the arrays, then call applyToMap() to scatter the results
+ * back before anything else touches the map.
+ */
+class PackedNodeCoordinates
+{
+public:
+
+  /**
+   * Gathers the coordinates of every node in the map.
+   */
+  explicit PackedNodeCoordinates(const OsmMap& map);
+
+  /**
+   * Calculates the envelope of all the gathered coordinates in a single vectorizable pass.
+   * Returns an uninitialized envelope if the map had no nodes.
+   */
+  OGREnvelope calculateBounds() const;
+
+  /**
+   * Writes the (possibly modified) coordinates back to the corresponding nodes in the map. The
+   * map must still contain every node that was present when the snapshot was taken.
+   */
+  void applyToMap(OsmMap& map) const;
+
+  size_t size() const { return _nodeIds.size(); }
+
+  const std::vector<long>& getNodeIds() const { return _nodeIds; }
+
+  std::vector<double>& getX() { return _x; }
+  const std::vector<double>& getX() const { return _x; }
+
+  std::vector<double>& getY() { return _y; }
+  const std::vector<double>& getY() const { return _y; }
+
+private:
+
+  std::vector<long> _nodeIds;
+  std::vector<double> _x;
+  std::vector<double> _y;
+};
+
+}
+
+#endif // PACKEDNODECOORDINATES_H
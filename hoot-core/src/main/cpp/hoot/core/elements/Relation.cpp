@@ -222,10 +222,20 @@ void Relation::setMembers(const vector<RelationData::Entry>& members)
   _postGeometryChange();
 }
 
+void Relation::setMembersViaSwap(vector<RelationData::Entry>& members)
+{
+  _preGeometryChange();
+  _makeWritable();
+  _relationData->setMembersViaSwap(members);
+  _postGeometryChange();
+}
+
 void Relation::setType(const QString& type)
 {
   _makeWritable();
   _relationData->setType(type);
+  // the relation type is part of the content hash.
+  _relationData->clearCachedHash();
 }
 
 QString Relation::toString() const
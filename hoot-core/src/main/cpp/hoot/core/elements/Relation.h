@@ -144,6 +144,12 @@ public:
 
   void setMembers(const std::vector<RelationData::Entry>& members);
 
+  /**
+   * Swap based variant of setMembers; members is left holding the old list. Fires a single
+   * geometry change notification for the whole handoff.
+   */
+  void setMembersViaSwap(std::vector<RelationData::Entry>& members);
+
   /**
    * Sets the "type" of the relation. See the OSM wiki [1] for a detailed description. Example
    * types include "building", "multipolygon" and "multilinestring".
@@ -101,6 +101,12 @@ public:
 
   void setMembers(const std::vector<Entry>& members) { _members = members; }
 
+  /**
+   * Swap based variant of setMembers; members is left holding the old list. A C++03 substitute
+   * for move semantics so builders can hand off a scratch buffer without copying it.
+   */
+  void setMembersViaSwap(std::vector<Entry>& members) { _members.swap(members); }
+
   void setType(const QString& type) { _type = type; }
 
 private:
@@ -0,0 +1,91 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "TagDictionary.h"
+
+// Qt
+#include <QMutexLocker>
+
+namespace hoot
+{
+
+TagDictionary* TagDictionary::_theInstance = 0;
+
+TagDictionary& TagDictionary::getInstance()
+{
+  if (_theInstance == 0)
+  {
+    _theInstance = new TagDictionary();
+  }
+  return *_theInstance;
+}
+
+TagDictionary::TagDictionary()
+{
+}
+
+QString TagDictionary::intern(const QString& s)
+{
+  QMutexLocker lock(&_mutex);
+  return _intern(s);
+}
+
+Tags TagDictionary::internTags(const Tags& tags)
+{
+  Tags result;
+  // one lock per element rather than one per string.
+  QMutexLocker lock(&_mutex);
+  for (Tags::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    result.insert(_intern(it.key()), _intern(it.value()));
+  }
+  return result;
+}
+
+void TagDictionary::clear()
+{
+  QMutexLocker lock(&_mutex);
+  _strings.clear();
+}
+
+int TagDictionary::size() const
+{
+  QMutexLocker lock(&_mutex);
+  return _strings.size();
+}
+
+QString TagDictionary::_intern(const QString& s)
+{
+  QSet<QString>::const_iterator it = _strings.constFind(s);
+  if (it == _strings.constEnd())
+  {
+    // the set's copy shares the caller's buffer, so a new entry costs one hash table node.
+    it = _strings.insert(s);
+  }
+  return *it;
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef TAGDICTIONARY_H
+#define TAGDICTIONARY_H
+
+// Hoot
+#include <hoot/core/elements/Tags.h>
+
+// Qt
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+namespace hoot
+{
+
+/**
+ * A process wide dictionary of canonical tag strings.
+ *
+ * Tag heavy maps (POI data especially) repeat the same keys and values across millions of
+ * elements, and in a plain QHash every element owns its own copy of each string. Interning
+ * replaces every tag string with the dictionary's canonical instance; QString is implicitly
+ * shared, so all elements holding an interned string share one refcounted buffer and the map
+ * pays for each distinct string once. Readers keep the normal Tags interface - an interned
+ * QString behaves exactly like any other - and copy on write kicks in automatically if a tag is
+ * later modified.
+ *
+ * The dictionary itself stores shallow copies, so its overhead per distinct string is one hash
+ * table entry. Thread safe; typically populated during load via InternTagsVisitor on read-mostly
+ * maps.
+ */
+class TagDictionary
+{
+public:
+
+  static TagDictionary& getInstance();
+
+  /**
+   * Returns the canonical instance of the given string, inserting it if it's new.
+   */
+  QString intern(const QString& s);
+
+  /**
+   * Returns a copy of the given tags with every key and value interned.
+   */
+  Tags internTags(const Tags& tags);
+
+  /**
+   * Drops all canonical strings. Strings already handed out remain valid; they just stop being
+   * shared with future interns.
+   */
+  void clear();
+
+  /**
+   * Returns the number of distinct strings in the dictionary.
+   */
+  int size() const;
+
+private:
+
+  TagDictionary();
+
+  QString _intern(const QString& s);
+
+  static TagDictionary* _theInstance;
+
+  mutable QMutex _mutex;
+  QSet<QString> _strings;
+};
+
+}
+
+#endif // TAGDICTIONARY_H
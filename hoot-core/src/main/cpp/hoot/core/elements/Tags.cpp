@@ -30,6 +30,7 @@
 // Hoot
 #include <hoot/core/util/Exception.h>
 #include <hoot/core/schema/OsmSchema.h>
+#include <hoot/core/schema/TagKeyInterner.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
@@ -45,6 +46,13 @@ namespace hoot
 QStringList Tags::_nameKeys;
 QStringList Tags::_pseudoNameKeys;
 
+const QString& Tags::_emptyString()
+{
+  // shared instance handed out by getRef for missing keys.
+  static QString empty;
+  return empty;
+}
+
 void Tags::addTags(const Tags& t)
 {
   for (Tags::const_iterator it = t.constBegin(); it != t.constEnd(); ++it)
@@ -70,7 +78,7 @@ void Tags::appendValue(QString k, QString v)
   }
   else
   {
-    insert(k, v);
+    insert(TagKeyInterner::getInstance().intern(k), v);
   }
 }
 
@@ -162,7 +170,7 @@ QStringList Tags::getCreateUuid()
 
 double Tags::getDouble(const QString& k) const
 {
-  QString v = get(k);
+  const QString& v = getRef(k);
 
   bool ok;
   double result = v.toDouble(&ok);
@@ -457,14 +465,22 @@ QStringList Tags::getPseudoNames() const
 
 bool Tags::isFalse(const QString& key) const
 {
-  QString v = value(key).toLower();
-  return (v == "no" || v == "false" || v == "0" || v == "off");
+  // compare case insensitively in place rather than building a lowered copy per check.
+  const QString& v = getRef(key);
+  return (v.compare("no", Qt::CaseInsensitive) == 0 ||
+          v.compare("false", Qt::CaseInsensitive) == 0 ||
+          v == "0" ||
+          v.compare("off", Qt::CaseInsensitive) == 0);
 }
 
 bool Tags::isTrue(const QString& key) const
 {
-  QString v = value(key).toLower();
-  return (v == "yes" || v == "true" || v == "1" || v == "on");
+  // compare case insensitively in place rather than building a lowered copy per check.
+  const QString& v = getRef(key);
+  return (v.compare("yes", Qt::CaseInsensitive) == 0 ||
+          v.compare("true", Qt::CaseInsensitive) == 0 ||
+          v == "1" ||
+          v.compare("on", Qt::CaseInsensitive) == 0);
 }
 
 bool Tags::operator==(const Tags& other) const
@@ -537,7 +553,8 @@ void Tags::removeEmptyTags()
 
 void Tags::set(const QString& key, const QString& value)
 {
-  operator[](key) = value;
+  // interned keys share one QString buffer across all Tags instances.
+  operator[](TagKeyInterner::getInstance().intern(key)) = value;
 }
 
 void Tags::set(const QString& key, bool v)
@@ -91,6 +91,23 @@ public:
 
   const QString get(const QString& k) const { return operator[](k); }
 
+  /**
+   * Returns a reference to the value stored for k, or a shared empty string if k isn't present.
+   * Unlike get() no QString copy is handed out, so hot read paths (criterion and schema checks
+   * that only compare or test emptiness) avoid the refcount traffic of a copy per lookup. The
+   * reference is only valid until the tags are next modified. Qt 4's QStringRef can't refer into
+   * container storage, so a const reference serves as the view type.
+   */
+  const QString& getRef(const QString& k) const
+  {
+    const_iterator it = find(k);
+    if (it == end())
+    {
+      return _emptyString();
+    }
+    return it.value();
+  }
+
   /**
    * Gets the element's UUID(s). If the UUID doesn't exist then it creates a new UUID.
    *
@@ -241,6 +258,8 @@ public:
 private:
   void _valueRegexParser(const QString& str, QString& num, QString& units) const;
 
+  static const QString& _emptyString();
+
   static QStringList _nameKeys;
   static QStringList _pseudoNameKeys;
 };
@@ -53,7 +53,10 @@ namespace hoot
 
 Way::Way(Status s, long id, Meters circularError, long changeset, long version,
          unsigned int timestamp, QString user, long uid, bool visible)
-: Element(s)
+: Element(s),
+  _cachedEnvelopeValid(false),
+  _cachedEnvelopeEpoch(0),
+  _geometryRevision(0)
 {
   _wayData.reset(new WayData(id, changeset, version, timestamp, user, uid, visible));
   _getElementData().setCircularError(circularError);
@@ -61,7 +64,10 @@ Way::Way(Status s, long id, Meters circularError, long changeset, long version,
 
 Way::Way(const Way& from) :
 Element(from.getStatus()),
-_wayData(from._wayData)
+_wayData(from._wayData),
+_cachedEnvelopeValid(false),
+_cachedEnvelopeEpoch(0),
+_geometryRevision(0)
 {
 
 }
@@ -161,6 +167,13 @@ const Envelope& Way::getApproximateEnvelope(boost::shared_ptr<const ElementProvi
 
 const Envelope& Way::getEnvelopeInternal(boost::shared_ptr<const ElementProvider> ep) const
 {
+  // the cache is dropped whenever this way's node list changes and goes stale whenever any node
+  // moves (see Element::getNodePositionEpoch()).
+  if (_cachedEnvelopeValid && _cachedEnvelopeEpoch == Element::getNodePositionEpoch())
+  {
+    return _cachedEnvelope;
+  }
+
   _cachedEnvelope.init();
 
   const std::vector<long>& ids = _wayData->getNodeIds();
@@ -172,6 +185,9 @@ const Envelope& Way::getEnvelopeInternal(boost::shared_ptr<const ElementProvider
     _cachedEnvelope.expandToInclude(n->getX(), n->getY());
   }
 
+  _cachedEnvelopeValid = true;
+  _cachedEnvelopeEpoch = Element::getNodePositionEpoch();
+
   return _cachedEnvelope;
 }
 
@@ -185,6 +201,16 @@ void Way::setNodes(const vector<long>& newNodes)
   _postGeometryChange();
 }
 
+void Way::setNodesViaSwap(vector<long>& newNodes)
+{
+  _preGeometryChange();
+  _makeWritable();
+
+  _wayData->getNodeIds().swap(newNodes);
+
+  _postGeometryChange();
+}
+
 int Way::getNodeIndex(long nodeId) const
 {
   const std::vector<long>& ids = _wayData->getNodeIds();
@@ -256,8 +282,20 @@ void Way::_makeWritable()
   }
 }
 
+void Way::_postGeometryChange()
+{
+  _cachedEnvelopeValid = false;
+  _geometryRevision++;
+  // any node list change may have introduced duplicate nodes or a zero length way, so mark the
+  // way for the next cleaning pass.
+  _wayData->setCleanRequired(true);
+  Element::_postGeometryChange();
+}
+
 void Way::removeNode(long id)
 {
+  _preGeometryChange();
+  _makeWritable();
   std::vector<long>& nodes = _wayData->getNodeIds();
   size_t newCount = 0;
 
@@ -271,6 +309,7 @@ void Way::removeNode(long id)
   }
 
   nodes.resize(newCount);
+  _postGeometryChange();
 }
 
 void Way::replaceNode(long oldId, long newId)
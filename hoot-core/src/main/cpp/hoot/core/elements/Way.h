@@ -132,8 +132,32 @@ public:
 
   const std::vector<long>& getNodeIds() const { return _wayData->getNodeIds(); }
 
+  /**
+   * Returns a counter that increments every time this way's node list changes. Together with
+   * Element::getNodePositionEpoch() this gives callers a cheap way to tell whether a derived
+   * product (e.g. a cached histogram) computed from this way's geometry is still current.
+   */
+  unsigned long getGeometryRevision() const { return _geometryRevision; }
+
+  /**
+   * Returns true if a node list mutation has touched this way since the flag was last cleared.
+   * The node list mutators set the flag automatically and WayCleaner::cleanWays(map) clears it
+   * after verifying the way, so a cleaning pass only visits the ways an op chain changed.
+   */
+  bool getCleanRequired() const { return _wayData->getCleanRequired(); }
+
+  void setCleanRequired(bool cleanRequired)
+  { _makeWritable(); _wayData->setCleanRequired(cleanRequired); }
+
   void setNodes(const std::vector<long>& newNodes);
 
+  /**
+   * Swap based variant of setNodes; newNodes is left holding the old list. A C++03 substitute
+   * for move semantics so readers can build the node id list in a scratch buffer and hand it off
+   * without copying. Fires a single geometry change notification.
+   */
+  void setNodesViaSwap(std::vector<long>& newNodes);
+
   bool hasNode(long nodeId) const;
 
   bool isOneWay() const;
@@ -171,7 +195,8 @@ public:
    * This is rarely used. Primarily it is useful when loading the way from a file that does
    * cache way envelope bounds (see .osm.pbf).
    */
-  void setCachedEnvelope(const geos::geom::Envelope& e) { _cachedEnvelope = e; }
+  void setCachedEnvelope(const geos::geom::Envelope& e)
+  { _cachedEnvelope = e; _cachedEnvelopeValid = false; }
 
   QString toString() const;
 
@@ -186,6 +211,10 @@ protected:
    * This envelope may be cached, but it also may not be exact.
    */
   mutable geos::geom::Envelope _cachedEnvelope;
+  // true if _cachedEnvelope holds an exact envelope computed at _cachedEnvelopeEpoch.
+  mutable bool _cachedEnvelopeValid;
+  mutable unsigned long _cachedEnvelopeEpoch;
+  unsigned long _geometryRevision;
 
   virtual ElementData& _getElementData() { _makeWritable(); return *_wayData; }
 
@@ -193,6 +222,11 @@ protected:
 
   void _makeWritable();
 
+  /**
+   * The way's node list changed; drop the cached envelope before notifying listeners.
+   */
+  virtual void _postGeometryChange();
+
 private:
 
 };
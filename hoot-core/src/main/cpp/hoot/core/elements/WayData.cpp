@@ -36,7 +36,8 @@ namespace hoot
 
 WayData::WayData(long id, long changeset, long version, unsigned int timestamp, QString user,
                  long uid, bool visible) :
-ElementData(id, Tags(), -1, changeset, version, timestamp, user, uid, visible)
+ElementData(id, Tags(), -1, changeset, version, timestamp, user, uid, visible),
+_cleanRequired(false)
 {
 }
 
@@ -44,7 +45,8 @@ WayData::WayData(const WayData& from) :
 ElementData(from.getId(), from.getTags(), from.getCircularError(), from.getChangeset(),
             from.getVersion(), from.getTimestamp(), from.getUser(), from.getUid(),
             from.getVisible()),
-_nodes(from._nodes)
+_nodes(from._nodes),
+_cleanRequired(from._cleanRequired)
 {
 
 }
@@ -55,7 +55,16 @@ public:
 
   void addNode(long id) { _nodes.push_back(id); }
 
-  void clear() { ElementData::clear(); _nodes.clear(); }
+  void clear() { ElementData::clear(); _nodes.clear(); _cleanRequired = false; }
+
+  /**
+   * A dirty bit maintained by the node list mutators. It is set whenever the node list changes
+   * and cleared once the way has been verified or cleaned, so a cleaning pass can skip the ways
+   * an op chain never touched.
+   */
+  bool getCleanRequired() const { return _cleanRequired; }
+
+  void setCleanRequired(bool cleanRequired) { _cleanRequired = cleanRequired; }
 
   const std::vector<long>& getNodeIds() const { return _nodes; }
 
@@ -64,6 +73,7 @@ public:
 protected:
 
   std::vector<long> _nodes;
+  bool _cleanRequired;
 };
 
 }
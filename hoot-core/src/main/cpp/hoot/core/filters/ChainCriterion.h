@@ -54,6 +54,9 @@ public:
 
   virtual ElementCriterion* clone() { return new ChainCriterion(_filters); }
 
+  const std::vector< boost::shared_ptr<ElementCriterion> >& getChildren() const
+  { return _filters; }
+
 protected:
 
   ChainCriterion(std::vector< boost::shared_ptr<ElementCriterion> > filters);
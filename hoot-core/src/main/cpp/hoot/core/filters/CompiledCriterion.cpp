@@ -0,0 +1,112 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "CompiledCriterion.h"
+
+// hoot
+#include <hoot/core/filters/ChainCriterion.h>
+
+// Standard
+#include <algorithm>
+
+namespace hoot
+{
+
+namespace
+{
+  // how many evaluations to observe before each reorder. A power of two keeps the modulo cheap.
+  const long REORDER_INTERVAL = 1024;
+}
+
+CompiledCriterion::CompiledCriterion(const ElementCriterionPtr& criterion) :
+  _criterion(criterion),
+  _evaluations(0)
+{
+  _flatten(criterion);
+}
+
+void CompiledCriterion::_flatten(const ElementCriterionPtr& c)
+{
+  ChainCriterion* chain = dynamic_cast<ChainCriterion*>(c.get());
+  if (chain != 0)
+  {
+    const std::vector<ElementCriterionPtr>& children = chain->getChildren();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+      _flatten(children[i]);
+    }
+  }
+  else
+  {
+    Step s;
+    s.criterion = c;
+    s.calls = 0;
+    s.rejects = 0;
+    _steps.push_back(s);
+  }
+}
+
+bool CompiledCriterion::_stepCompare(const Step& s1, const Step& s2)
+{
+  const double r1 = s1.calls > 0 ? (double)s1.rejects / (double)s1.calls : 0.0;
+  const double r2 = s2.calls > 0 ? (double)s2.rejects / (double)s2.calls : 0.0;
+  return r1 > r2;
+}
+
+void CompiledCriterion::_reorder() const
+{
+  // stable so criteria with equal rates keep their relative order and results stay deterministic.
+  std::stable_sort(_steps.begin(), _steps.end(), _stepCompare);
+}
+
+bool CompiledCriterion::isSatisfied(const boost::shared_ptr<const Element>& e) const
+{
+  _evaluations++;
+  if (_evaluations % REORDER_INTERVAL == 0)
+  {
+    _reorder();
+  }
+
+  for (size_t i = 0; i < _steps.size(); i++)
+  {
+    Step& s = _steps[i];
+    s.calls++;
+    if (s.criterion->isSatisfied(e) == false)
+    {
+      s.rejects++;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+ElementCriterion* CompiledCriterion::clone()
+{
+  return new CompiledCriterion(ElementCriterionPtr(_criterion->clone()));
+}
+
+}
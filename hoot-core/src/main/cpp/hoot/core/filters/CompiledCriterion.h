@@ -0,0 +1,92 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef COMPILEDCRITERION_H
+#define COMPILEDCRITERION_H
+
+#include "ElementCriterion.h"
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Compiles a tree of chained criteria into a flat, short-circuiting list that reorders itself
+ * based on observed selectivity.
+ *
+ * Nested ChainCriterion children are flattened into a single list of leaf criteria (legal since
+ * "and" is associative); everything else, including NotCriterion and OrCriterion, is treated as a
+ * leaf. During evaluation each leaf's rejection rate is tracked and every so often the list is
+ * resorted so the most-rejecting criteria run first, which minimizes the number of virtual calls
+ * per element on chains that are evaluated millions of times.
+ *
+ * The wrapped criteria must be pure predicates (all of the stock ones are); reordering a chain of
+ * predicates with side effects would change behavior.
+ */
+class CompiledCriterion : public ElementCriterion
+{
+public:
+
+  static std::string className() { return "hoot::CompiledCriterion"; }
+
+  CompiledCriterion(const ElementCriterionPtr& criterion);
+
+  virtual bool isSatisfied(const boost::shared_ptr<const Element>& e) const;
+
+  virtual ElementCriterion* clone();
+
+  /**
+   * Returns the number of leaf criteria after flattening. Useful mostly for testing.
+   */
+  size_t getStepCount() const { return _steps.size(); }
+
+private:
+
+  struct Step
+  {
+    ElementCriterionPtr criterion;
+    long calls;
+    long rejects;
+  };
+
+  // the original tree is kept for cloning.
+  ElementCriterionPtr _criterion;
+  // reordered in place during (conceptually const) evaluation.
+  mutable std::vector<Step> _steps;
+  mutable long _evaluations;
+
+  void _flatten(const ElementCriterionPtr& c);
+
+  void _reorder() const;
+
+  static bool _stepCompare(const Step& s1, const Step& s2);
+};
+
+}
+
+#endif // COMPILEDCRITERION_H
@@ -59,7 +59,9 @@ bool TagContainsFilter::isFiltered(const Element& e) const
 
   for (int i = 0; i < _key.size(); i++)
   {
-    if (e.getTags().contains(_key[i]) && e.getTags()[_key[i]].contains(_valueSubstring[i]))
+    // one lookup and no value copy instead of a contains() plus operator[].
+    Tags::const_iterator it = e.getTags().find(_key[i]);
+    if (it != e.getTags().end() && it.value().contains(_valueSubstring[i]))
     {
         matches = true;
         break;  //  Only one match is required
@@ -131,6 +131,9 @@ void FourPassManager::apply(QString outputPath)
       }
     }
 
+    // the last pass doesn't need to produce scratch state for a later pass, which lets the
+    // worker skip the final remap round trip when nothing is pending.
+    _worker->setFinalPass(i == 3);
     _worker->applyOp(_op, appliedBits, _scratchIn, _scratchOut);
   }
 
@@ -43,10 +43,21 @@
 #include <hoot/core/util/FileUtils.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/UuidHelper.h>
+#include <hoot/core/visitors/CalculateHashVisitor2.h>
 #include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+#include <hoot/core/visitors/RemoveTagVisitor.h>
+#include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/conflate/NodeReplacements.h>
 
+// Standard
+#include <queue>
+
+// POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace geos::geom;
 using namespace std;
 
@@ -71,7 +82,9 @@ protected:
 
 LocalTileWorker2::LocalTileWorker2()
 {
+  _finalPass = false;
   _mapPart = 0;
+  _maxConcurrency = 1;
   _workDir = QDir::tempPath() + "/" +
       UuidHelper::createUuid().toString().replace("{", "").replace("}", "") +
       "-LocalTileWorker2/";
@@ -82,43 +95,161 @@ void LocalTileWorker2::applyOp(boost::shared_ptr<OsmMapOperation> op, const vect
   QString mapIn, QString mapOut)
 {
   _mapPart = 0;
-  for (size_t i = 0; i < tiles.size(); i++)
+
+  // every tile reads the same input, so parse it once up front rather than once per tile.
+  boost::shared_ptr<const OsmMap> baseMap = _readAllParts(mapIn);
+
+  if (_maxConcurrency > 1 && tiles.size() > 1)
+  {
+    _applyOpParallel(op, baseMap, tiles, mapIn, mapOut);
+  }
+  else
   {
-    NodeReplacements replacements;
-    replacements.readDir(mapIn);
-    boost::shared_ptr<OsmMap> map = _readTile(mapIn, tiles[i], _buffer);
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+      _applyOpToTile(op, baseMap, tiles[i], i, mapIn, mapOut);
+    }
+  }
 
-    if (map->getNodes().size() > 0)
+  _writeTheRest(mapIn, mapOut, tiles, _buffer);
+}
+
+void LocalTileWorker2::_applyOpToTile(boost::shared_ptr<OsmMapOperation> op,
+  boost::shared_ptr<const OsmMap> baseMap, const Envelope& tile, size_t i, QString mapIn,
+  QString mapOut)
+{
+  NodeReplacements replacements;
+  replacements.readDir(mapIn);
+  boost::shared_ptr<OsmMap> map = _readTile(baseMap, tile, _buffer);
+
+  if (map->getNodes().size() > 0)
+  {
+    // keep track of any replaced nodes.
+    boost::shared_ptr<ReplacedNodeListener> rnl(
+      new ReplacedNodeListener(replacements.getReplacements()));
+    map->registerListener(rnl);
+
+    Boundable* b = dynamic_cast<Boundable*>(op.get());
+    if (b != NULL)
     {
-      // keep track of any replaced nodes.
-      boost::shared_ptr<ReplacedNodeListener> rnl(
-        new ReplacedNodeListener(replacements.getReplacements()));
-      map->registerListener(rnl);
+      b->setBounds(tile);
+    }
+    op->apply(map);
 
-      Boundable* b = dynamic_cast<Boundable*>(op.get());
-      if (b != NULL)
+    // it only actually does a reprojection if necessary.
+    MapProjector::projectToWgs84(map);
+
+    // Using a copy of the map so we can split ways as needed. Make sure they're the right size.
+    const WayMap wm = map->getWays();
+    for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
+    {
+      const WayPtr& w = map->getWay(it->first);
+      // a way whose fingerprint still matches its content was already split to size and stored
+      // by the tile that conflated it, and this tile's op left it alone; don't redo that work.
+      if (CalculateHashVisitor2::isUnchanged(w))
       {
-        b->setBounds(tiles[i]);
+        continue;
       }
-      op->apply(map);
+      WaySplitter::split(map, w, _maxWaySize);
+    }
 
-      // it only actually does a reprojection if necessary.
-      MapProjector::projectToWgs84(map);
+    if (_finalPass)
+    {
+      // no later pass reads the fingerprints; strip them rather than shipping scratch state.
+      RemoveTagVisitor removeHashVisitor(MetadataTags::HootHash());
+      map->visitRw(removeHashVisitor);
+    }
+    else
+    {
+      // fingerprint the conflated result so the tiles whose buffer zones overlap this one can
+      // recognize the geometry they've left untouched.
+      CalculateHashVisitor2 hashVisitor;
+      hashVisitor.setRemoveUuid(false);
+      map->visitRw(hashVisitor);
+    }
 
-      // Using a copy of the map so we can split ways as needed. Make sure they're the right size.
-      const WayMap wm = map->getWays();
-      for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
+    _storeMapPart(map, mapOut, (int)i);
+    _writeNodeReplacements(mapOut, i, replacements);
+  }
+}
+
+void LocalTileWorker2::_applyOpParallel(boost::shared_ptr<OsmMapOperation> op,
+  boost::shared_ptr<const OsmMap> baseMap, const vector<Envelope>& tiles, QString mapIn,
+  QString mapOut)
+{
+  queue<size_t> pending;
+  for (size_t i = 0; i < tiles.size(); i++)
+  {
+    pending.push(i);
+  }
+  vector<int> attempts(tiles.size(), 0);
+  map<pid_t, size_t> running;
+
+  while (pending.empty() == false || running.empty() == false)
+  {
+    while (pending.empty() == false && (int)running.size() < _maxConcurrency)
+    {
+      size_t i = pending.front();
+      pending.pop();
+      attempts[i]++;
+
+      pid_t pid = fork();
+      if (pid == 0)
+      {
+        // the child inherits the parsed input copy-on-write; it only talks back through the
+        // files it writes into mapOut.
+        int status = 0;
+        try
+        {
+          _applyOpToTile(op, baseMap, tiles[i], i, mapIn, mapOut);
+        }
+        catch (const std::exception& e)
+        {
+          LOG_ERROR("Tile " << i << " failed: " << e.what());
+          status = 1;
+        }
+        // don't run the parent's exit handlers.
+        _exit(status);
+      }
+      else if (pid < 0)
+      {
+        // couldn't spawn a child (e.g. out of memory); just do the work here.
+        LOG_WARN("Fork failed, processing tile " << i << " in this process.");
+        _applyOpToTile(op, baseMap, tiles[i], i, mapIn, mapOut);
+      }
+      else
       {
-        const WayPtr& w = map->getWay(it->first);
-        WaySplitter::split(map, w, _maxWaySize);
+        running[pid] = i;
       }
+    }
 
-      _storeMapPart(map, mapOut);
-      _writeNodeReplacements(mapOut, i, replacements);
+    if (running.empty() == false)
+    {
+      int status = 0;
+      pid_t pid = waitpid(-1, &status, 0);
+      if (pid > 0)
+      {
+        size_t i = running[pid];
+        running.erase(pid);
+
+        if (WIFEXITED(status) == false || WEXITSTATUS(status) != 0)
+        {
+          if (attempts[i] < 2)
+          {
+            // could be a transient failure (e.g. the child was OOM killed); try once more.
+            LOG_WARN("Tile " << i << " failed, retrying in a fresh process.");
+            pending.push(i);
+          }
+          else
+          {
+            // retry in this process so the underlying exception propagates to the caller.
+            LOG_WARN("Tile " << i << " failed twice, retrying in this process.");
+            _applyOpToTile(op, baseMap, tiles[i], i, mapIn, mapOut);
+          }
+        }
+      }
     }
   }
-
-  _writeTheRest(mapIn, mapOut, tiles, _buffer);
 }
 
 void LocalTileWorker2::breakWays(QString out)
@@ -178,6 +309,10 @@ void LocalTileWorker2::cleanup(QString mapIn, QString mapOut)
 {
   boost::shared_ptr<OsmMap> map = _readAllParts(mapIn);
 
+  // the fingerprints are scratch state for the tile passes; don't ship them.
+  RemoveTagVisitor removeHashVisitor(MetadataTags::HootHash());
+  map->visitRw(removeHashVisitor);
+
   OsmXmlWriter writer;
   writer.setIncludePointsInWays(true);
   writer.setIncludeHootInfo(true);
@@ -235,7 +370,13 @@ boost::shared_ptr<OsmMap> LocalTileWorker2::_readAllParts(QString dir)
 
 boost::shared_ptr<OsmMap> LocalTileWorker2::_readTile(QString input, const Envelope& e, double buffer)
 {
-  boost::shared_ptr<OsmMap> map = _readAllParts(input);
+  return _readTile(_readAllParts(input), e, buffer);
+}
+
+boost::shared_ptr<OsmMap> LocalTileWorker2::_readTile(boost::shared_ptr<const OsmMap> baseMap,
+  const Envelope& e, double buffer)
+{
+  boost::shared_ptr<OsmMap> map(new OsmMap(baseMap));
 
   Envelope buffered = e;
   buffered.expandBy(buffer);
@@ -267,7 +408,12 @@ void LocalTileWorker2::rmdir(QString dir)
 
 void LocalTileWorker2::_storeMapPart(boost::shared_ptr<OsmMap> map, QString dir)
 {
-  QString fn = dir + QString("/Part%1.osm").arg(_mapPart++, 4, 10, QChar('0'));
+  _storeMapPart(map, dir, _mapPart++);
+}
+
+void LocalTileWorker2::_storeMapPart(boost::shared_ptr<OsmMap> map, QString dir, int part)
+{
+  QString fn = dir + QString("/Part%1.osm").arg(part, 4, 10, QChar('0'));
   OsmXmlWriter writer;
   writer.setIncludePointsInWays(true);
   writer.setIncludeHootInfo(true);
@@ -76,14 +76,43 @@ public:
 
   virtual void rmdir(QString dir);
 
+  /**
+   * Sets the maximum number of tiles that will be conflated concurrently. When greater than one,
+   * each tile in a pass is handed to a forked child process. The children inherit the parsed
+   * input map copy-on-write, so the input is only read once per pass regardless of the tile
+   * count. Defaults to one, which processes the tiles sequentially in this process.
+   */
+  virtual void setFinalPass(bool finalPass) { _finalPass = finalPass; }
+
+  void setMaxConcurrency(int maxConcurrency) { _maxConcurrency = maxConcurrency; }
+
 private:
   QString _workDir;
+  bool _finalPass;
   int _mapPart;
+  int _maxConcurrency;
   double _maxWaySize;
   double _pixelSize;
   QString _in1, _in2;
   double _buffer;
 
+  /**
+   * Applies the op to a single tile and stores the result in mapOut. May run in a forked child
+   * process, so it must only communicate through the output directory.
+   */
+  void _applyOpToTile(boost::shared_ptr<OsmMapOperation> op,
+    boost::shared_ptr<const OsmMap> baseMap, const geos::geom::Envelope& tile, size_t i,
+    QString mapIn, QString mapOut);
+
+  /**
+   * Runs the tiles through a pool of up to _maxConcurrency forked child processes. A tile whose
+   * child dies is retried in a fresh child once and then retried in this process so the
+   * underlying exception surfaces.
+   */
+  void _applyOpParallel(boost::shared_ptr<OsmMapOperation> op,
+    boost::shared_ptr<const OsmMap> baseMap, const std::vector<geos::geom::Envelope>& tiles,
+    QString mapIn, QString mapOut);
+
   /**
    * Read all the part files from the specified directory into a single map.
    */
@@ -97,6 +126,13 @@ private:
 
   boost::shared_ptr<OsmMap> _readTile(QString input, const geos::geom::Envelope& e, double buffer);
 
+  /**
+   * Same as above, but cuts the tile out of a copy of an already parsed map rather than re-reading
+   * the part files.
+   */
+  boost::shared_ptr<OsmMap> _readTile(boost::shared_ptr<const OsmMap> baseMap,
+    const geos::geom::Envelope& e, double buffer);
+
   void _replaceNodes(boost::shared_ptr<OsmMap> map, const HashMap<long, long>& replacements);
 
   void _simplifyNodeReplacements(HashMap<long, long>& r);
@@ -107,6 +143,12 @@ private:
    */
   void _storeMapPart(boost::shared_ptr<OsmMap> map, QString dir);
 
+  /**
+   * Stores the specified map under an explicit part number. Used by the tile paths so a tile
+   * always produces the same file name no matter which process renders it.
+   */
+  void _storeMapPart(boost::shared_ptr<OsmMap> map, QString dir, int part);
+
   void _writeNodeReplacements(QString dir, size_t i,
     NodeReplacements& replacements);
 
@@ -131,6 +131,13 @@ public:
    * Recursively removes a directory and all its children.
    */
   virtual void rmdir(QString dir) = 0;
+
+  /**
+   * Tells the worker whether the next applyOp call is the last pass over the data. Workers may
+   * use this to skip work that only exists to feed a later pass (e.g. fingerprint tags) so the
+   * output of the last pass can be published without another rewrite.
+   */
+  virtual void setFinalPass(bool finalPass) = 0;
 };
 
 }
@@ -28,8 +28,12 @@
 #include "ClosePointHash.h"
 
 // Standard
+#include <algorithm>
 #include <assert.h>
 
+// Qt
+#include <QtConcurrentRun>
+
 using namespace std;
 
 namespace hoot
@@ -39,14 +43,23 @@ ClosePointHash::ClosePointHash(double distance)
 {
   _distance = distance;
   _binSize = _distance * 2;
+  _pos = 0;
+  _sorted = true;
 }
 
 void ClosePointHash::addPoint(double x, double y, long id)
 {
-  _bins[_toBin(x + _distance, y + _distance)].push_back(id);
-  _bins[_toBin(x + _distance, y - _distance)].push_back(id);
-  _bins[_toBin(x - _distance, y + _distance)].push_back(id);
-  _bins[_toBin(x - _distance, y - _distance)].push_back(id);
+  Entry e;
+  e.id = id;
+  e.bin = _toBin(x + _distance, y + _distance);
+  _entries.push_back(e);
+  e.bin = _toBin(x + _distance, y - _distance);
+  _entries.push_back(e);
+  e.bin = _toBin(x - _distance, y + _distance);
+  _entries.push_back(e);
+  e.bin = _toBin(x - _distance, y - _distance);
+  _entries.push_back(e);
+  _sorted = false;
 }
 
 const vector<long>& ClosePointHash::getMatch()
@@ -56,15 +69,26 @@ const vector<long>& ClosePointHash::getMatch()
 
 bool ClosePointHash::next()
 {
-  while (_it != _bins.end())
+  while (_pos < _entries.size())
   {
-    if (_it->second.size() > 1)
+    // find the end of the run of entries that share this bin.
+    size_t runEnd = _pos + 1;
+    while (runEnd < _entries.size() && _entries[runEnd].bin == _entries[_pos].bin)
+    {
+      runEnd++;
+    }
+
+    if (runEnd - _pos > 1)
     {
-      _match = _it->second;
-      ++_it;
+      _match.resize(0);
+      for (size_t i = _pos; i < runEnd; i++)
+      {
+        _match.push_back(_entries[i].id);
+      }
+      _pos = runEnd;
       return true;
     }
-    ++_it;
+    _pos = runEnd;
   }
 
   return false;
@@ -72,7 +96,35 @@ bool ClosePointHash::next()
 
 void ClosePointHash::resetIterator()
 {
-  _it = _bins.begin();
+  if (!_sorted)
+  {
+    _buildIndex();
+  }
+  _pos = 0;
+}
+
+void ClosePointHash::_buildIndex()
+{
+  // the sort dominates the build time on big maps, so above a modest size sort the two halves
+  // concurrently and merge.
+  if (_entries.size() > 100000)
+  {
+    size_t mid = _entries.size() / 2;
+    QFuture<void> f = QtConcurrent::run(&ClosePointHash::_sortRange, &_entries, (size_t)0, mid);
+    _sortRange(&_entries, mid, _entries.size());
+    f.waitForFinished();
+    inplace_merge(_entries.begin(), _entries.begin() + mid, _entries.end());
+  }
+  else
+  {
+    sort(_entries.begin(), _entries.end());
+  }
+  _sorted = true;
+}
+
+void ClosePointHash::_sortRange(std::vector<Entry>* entries, size_t begin, size_t end)
+{
+  sort(entries->begin() + begin, entries->begin() + end);
 }
 
 int64_t ClosePointHash::_toBin(double x, double y)
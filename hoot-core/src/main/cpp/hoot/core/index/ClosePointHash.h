@@ -32,15 +32,16 @@
 #include <stdint.h>
 #include <vector>
 
-// TGS
-#include <tgs/HashMap.h>
-
 namespace hoot
 {
 
 /**
  * Creates a hash with the explicit purpose of finding that are within a predefined distance. This
  * is re-entrant, but not thread safe.
+ *
+ * Internally the points live in a flat array of (bin, id) entries that gets sorted by bin when
+ * the iterator is reset. Iterating then walks the array front to back, so the candidate groups
+ * come out in grid order and sequential memory order rather than hash order.
  */
 class ClosePointHash
 {
@@ -67,29 +68,33 @@ public:
   bool next();
 
   /**
-   * Resets the iterator to the beginning of the hash.
+   * Resets the iterator to the beginning of the hash. If points were added since the last reset
+   * the index is (re)built, which is the expensive part of the operation.
    */
   void resetIterator();
 
 private:
 
-  struct Point
+  struct Entry
   {
-    double x, y;
+    int64_t bin;
+    long id;
 
-    Point(double x, double y)
-    {
-      this->x = x;
-      this->y = y;
-    }
+    bool operator<(const Entry& other) const { return bin < other.bin; }
   };
 
   double _binSize;
   double _distance;
   std::vector<long> _match;
 
-  HashMap< int64_t, std::vector<long> > _bins;
-  HashMap< int64_t, std::vector<long> >::const_iterator _it;
+  /// four entries per point (one per shifted bin); sorted by bin after _buildIndex.
+  std::vector<Entry> _entries;
+  size_t _pos;
+  bool _sorted;
+
+  void _buildIndex();
+
+  static void _sortRange(std::vector<Entry>* entries, size_t begin, size_t end);
 
   int64_t _toBin(double x, double y);
 };
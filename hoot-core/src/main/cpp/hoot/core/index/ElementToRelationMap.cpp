@@ -39,6 +39,7 @@ namespace hoot
 
 ElementToRelationMap::ElementToRelationMap()
 {
+  _bloom.reset(new BloomFilter());
 }
 
 void ElementToRelationMap::addRelation(const OsmMap& map, const boost::shared_ptr<const Relation> &r)
@@ -48,9 +49,12 @@ void ElementToRelationMap::addRelation(const OsmMap& map, const boost::shared_pt
   public:
 
     HashMap< ElementId, set<long> >& _mapping;
+    BloomFilter& _bloom;
     long _rid;
 
-    AddMemberVisitor(HashMap< ElementId, set<long> >& mapping, long rid) : _mapping(mapping)
+    AddMemberVisitor(HashMap< ElementId, set<long> >& mapping, BloomFilter& bloom, long rid) :
+      _mapping(mapping),
+      _bloom(bloom)
     {
       _rid = rid;
     }
@@ -61,17 +65,37 @@ void ElementToRelationMap::addRelation(const OsmMap& map, const boost::shared_pt
       // no need to map it to itself.
       if (eid != ElementId::relation(_rid))
       {
+        _bloom.insert(_toBloomKey(eid));
         _mapping[ElementId(e->getElementType(), e->getId())].insert(_rid);
       }
     }
   };
 
-  AddMemberVisitor filter(_mapping, r->getId());
+  AddMemberVisitor filter(_mapping, *_bloom, r->getId());
   r->visitRo(map, filter);
 }
 
+size_t ElementToRelationMap::getMemoryUsageEstimate() const
+{
+  // one hash node per element plus one tree node per relation id; overheads charged at typical
+  // glibc sizes.
+  size_t result = sizeof(*this) + sizeof(BloomFilter);
+  for (HashMap< ElementId, set<long> >::const_iterator it = _mapping.begin();
+       it != _mapping.end(); ++it)
+  {
+    result += sizeof(ElementId) + sizeof(set<long>) + 32;
+    result += it->second.size() * (sizeof(long) + 40);
+  }
+  return result;
+}
+
 const set<long>& ElementToRelationMap::getRelationByElement(ElementId eid) const
 {
+  // check the least expensive operations first.
+  if (_bloom->probably_contains(_toBloomKey(eid)) == false)
+  {
+    return _emptySet;
+  }
   HashMap< ElementId, set<long> >::const_iterator it = _mapping.find(eid);
   if (it == _mapping.end())
   {
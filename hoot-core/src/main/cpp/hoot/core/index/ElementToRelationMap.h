@@ -34,6 +34,7 @@
 #include <set>
 
 // Tgs
+#include <tgs/BigContainers/BasicBloomFilter.h>
 #include <tgs/HashMap.h>
 
 // Hoot
@@ -66,6 +67,11 @@ public:
    * multipolygon and the multipolygon contains a way w/ id 3, when this is called with
    * (ElementType::Way, 3) you will get both the multipolygon and the building relation.
    */
+  /**
+   * Returns a rough estimate of the bytes of RAM this index occupies.
+   */
+  size_t getMemoryUsageEstimate() const;
+
   const std::set<long>& getRelationByElement(ElementId eid) const;
   const std::set<long>& getRelationByElement(const boost::shared_ptr<const Element>& e) const;
   const std::set<long>& getRelationByElement(const Element* e) const;
@@ -85,9 +91,29 @@ public:
 
 private:
 
+  // relation membership is much sparser than way membership, so a smaller filter suffices.
+  // http://hur.st/bloomfilter?n=1000000&p=0.05
+  typedef boost::bloom_filters::basic_bloom_filter<long, 6236 * 1000, boost::mpl::vector<
+      boost::bloom_filters::boost_hash<size_t, 0x327B23C66B8B4567>,
+      boost::bloom_filters::boost_hash<size_t, 0x66334873643C9869>,
+      boost::bloom_filters::boost_hash<size_t, 0x19495CFF74B0DC51>,
+      boost::bloom_filters::boost_hash<size_t, 0x625558EC2AE8944A> > > BloomFilter;
+
   std::set<long> _emptySet;
   HashMap< ElementId, std::set<long> > _mapping;
+  // Strictly a negative cache in front of _mapping. removeRelation can't clear bits, so a stale
+  // positive just falls through to the normal find. Heap allocated - the bitset is too large to
+  // hold by value.
+  boost::shared_ptr<BloomFilter> _bloom;
 
+  /**
+   * Folds the element id down to the long key the bloom filter hashes. A collision between two
+   * element ids only costs a false positive, which the map lookup resolves.
+   */
+  static long _toBloomKey(ElementId eid)
+  {
+    return eid.getId() * (ElementType::Unknown + 1) + eid.getType().getEnum();
+  }
 };
 
 }
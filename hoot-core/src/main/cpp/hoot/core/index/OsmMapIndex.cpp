@@ -31,17 +31,22 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/LineString.h>
 #include <geos/geom/Point.h>
+#include <geos/geom/prep/PreparedGeometry.h>
 
 // Hoot
 #include <hoot/core/OsmMap.h>
+#include <hoot/core/algorithms/WayDiscretizer.h>
 #include <hoot/core/util/MapProjector.h>
 #include <hoot/core/conflate/NodeToWayMap.h>
 #include <hoot/core/index/KnnWayIterator.h>
 #include <hoot/core/util/ElementConverter.h>
+#include <hoot/core/util/GeometryUtils.h>
+#include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/Validate.h>
 
 // Qt
+#include <QMutexLocker>
 #include <QTime>
 
 // Standard
@@ -49,6 +54,7 @@
 #include <algorithm>
 
 // TGS
+#include <tgs/RStarTree/HilbertCurve.h>
 #include <tgs/RStarTree/MemoryPageStore.h>
 #include <tgs/RStarTree/RStarTreePrinter.h>
 #include <tgs/RStarTree/IntersectionIterator.h>
@@ -60,7 +66,10 @@ using namespace Tgs;
 namespace hoot
 {
 
-OsmMapIndex::OsmMapIndex(const OsmMap& map) : _map(map)
+OsmMapIndex::OsmMapIndex(const OsmMap& map) :
+_map(map),
+_geometryCache(10000),
+_preparedGeometryCache(10000)
 {
   _indexSlush = 0.0;
 }
@@ -102,6 +111,7 @@ void OsmMapIndex::_buildNodeTree() const
   const NodeMap& nodes = _map.getNodes();
 
   _treeIdToNid.resize(0);
+  _nidToTreeId.clear();
   _treeIdToNid.reserve(nodes.size());
   boxes.reserve(nodes.size());
   ids.reserve(nodes.size());
@@ -157,10 +167,12 @@ void OsmMapIndex::_buildWayTree() const
   const WayMap& ways = _map.getWays();
 
   _treeIdToWid.resize(0);
+  _widToTreeId.clear();
   _treeIdToWid.reserve(ways.size());
   boxes.reserve(ways.size());
   ids.reserve(ways.size());
 
+  ElementConverter converter(_map.shared_from_this());
   Box b(2);
   int count = 0;
   for (WayMap::const_iterator it = ways.begin();
@@ -168,7 +180,7 @@ void OsmMapIndex::_buildWayTree() const
   {
     ConstWayPtr w = it->second;
 
-    boost::shared_ptr<LineString> ls = ElementConverter(_map.shared_from_this()).convertToLineString(w);
+    boost::shared_ptr<LineString> ls = converter.convertToLineString(w);
     const Envelope* e = ls->getEnvelopeInternal();
 
     Meters a = w->getCircularError();
@@ -205,6 +217,7 @@ int OsmMapIndex::_createTreeNid(long nid) const
 {
   int result = _treeIdToNid.size();
   _treeIdToNid.push_back(nid);
+  _nidToTreeId.insert(pair<long, int>(nid, result));
   return result;
 }
 
@@ -212,6 +225,7 @@ int OsmMapIndex::_createTreeWid(long wid) const
 {
   int result = _treeIdToWid.size();
   _treeIdToWid.push_back(wid);
+  _widToTreeId.insert(pair<long, int>(wid, result));
   return result;
 }
 
@@ -303,6 +317,61 @@ vector<long> OsmMapIndex::findWayNeighbors(const ConstWayPtr &way, Meters buffer
   return result;
 }
 
+vector< vector<long> > OsmMapIndex::findWayNeighbors(const vector<ConstWayPtr>& ways,
+                                                     Meters buffer, bool addError) const
+{
+  vector< vector<long> > result(ways.size());
+
+  // make sure the tree is built up front rather than as a side effect of the first query.
+  getWayTree();
+
+  // determine the bounds of all the query ways so their Hilbert values are comparable.
+  Envelope bounds;
+  vector<Envelope> envelopes(ways.size());
+  for (size_t i = 0; i < ways.size(); i++)
+  {
+    envelopes[i] = ways[i]->getApproximateEnvelope(_map.shared_from_this());
+    bounds.expandToInclude(&envelopes[i]);
+  }
+
+  // sort the queries by the Hilbert value of their envelope center. Consecutive queries then
+  // land near each other in the tree and descend through the same upper levels while those
+  // nodes are still hot in the node store's cache.
+  const int order = 16;
+  Tgs::HilbertCurve curve(2, order);
+  double w = bounds.getWidth() != 0 ? bounds.getWidth() : 1.0;
+  double h = bounds.getHeight() != 0 ? bounds.getHeight() : 1.0;
+  vector< pair<long, size_t> > sorted;
+  sorted.reserve(ways.size());
+  int point[2];
+  for (size_t i = 0; i < ways.size(); i++)
+  {
+    const Envelope& e = envelopes[i];
+    if (e.isNull())
+    {
+      point[0] = 0;
+      point[1] = 0;
+    }
+    else
+    {
+      point[0] = int(((1 << order) - 1) *
+        (((e.getMinX() + e.getMaxX()) / 2.0 - bounds.getMinX()) / w));
+      point[1] = int(((1 << order) - 1) *
+        (((e.getMinY() + e.getMaxY()) / 2.0 - bounds.getMinY()) / h));
+    }
+    sorted.push_back(pair<long, size_t>(curve.encode(point), i));
+  }
+  sort(sorted.begin(), sorted.end());
+
+  for (size_t i = 0; i < sorted.size(); i++)
+  {
+    size_t queryIndex = sorted[i].second;
+    result[queryIndex] = findWayNeighbors(ways[queryIndex], buffer, addError);
+  }
+
+  return result;
+}
+
 vector<long> OsmMapIndex::findWayNeighborsBruteForce(ConstWayPtr way, Meters buffer) const
 {
   vector<long> result;
@@ -417,6 +486,45 @@ vector<long> OsmMapIndex::findWays(const Envelope& e) const
   return result;
 }
 
+size_t OsmMapIndex::getMemoryUsageEstimate() const
+{
+  size_t result = sizeof(*this);
+
+  if (_nodeToWayMap)
+  {
+    for (NodeToWayMap::const_iterator it = _nodeToWayMap->begin(); it != _nodeToWayMap->end();
+         ++it)
+    {
+      result += sizeof(long) + sizeof(set<long>) + 40;
+      result += it->second.size() * (sizeof(long) + 40);
+    }
+  }
+
+  if (_elementToRelationMap)
+  {
+    result += _elementToRelationMap->getMemoryUsageEstimate();
+  }
+
+  // the R-Trees store fixed size 2D boxes; ~48 bytes per entry is representative once the
+  // internal nodes are amortized in.
+  if (_nodeTree)
+  {
+    result += _treeIdToNid.size() * (sizeof(long) + 48);
+  }
+  if (_wayTree)
+  {
+    result += _treeIdToWid.size() * (sizeof(long) + 48);
+  }
+
+  result += (_pendingWayInsert.size() + _pendingWayRemoval.size() + _pendingNodeInsert.size() +
+    _pendingNodeRemoval.size() + _pendingRelationChange.size()) * (sizeof(long) + 40);
+
+  result += (_nidToTreeId.size() + _widToTreeId.size()) *
+    (sizeof(long) + sizeof(int) + 40);
+
+  return result;
+}
+
 const boost::shared_ptr<ElementToRelationMap> &OsmMapIndex::getElementToRelationMap() const
 {
   if (_elementToRelationMap == 0)
@@ -450,20 +558,117 @@ boost::shared_ptr<const HilbertRTree> OsmMapIndex::getNodeTree() const
     _buildNodeTree();
   }
 
-  OsmMapIndex* t = const_cast<OsmMapIndex*>(this);
-  for (set<long>::const_iterator it = _pendingNodeInsert.begin(); it != _pendingNodeInsert.end();
-       ++it)
+  if (_pendingNodeInsert.size() > 0)
   {
-    if (_map.containsNode(*it))
+    OsmMapIndex* t = const_cast<OsmMapIndex*>(this);
+    for (set<long>::const_iterator it = _pendingNodeInsert.begin();
+         it != _pendingNodeInsert.end(); ++it)
     {
-      t->_insertNode(*it);
+      if (_map.containsNode(*it))
+      {
+        t->_insertNode(*it);
+      }
     }
+    _pendingNodeInsert.clear();
   }
-  _pendingNodeInsert.clear();
 
   return _nodeTree;
 }
 
+boost::shared_ptr<const vector<Coordinate> > OsmMapIndex::getDirectionSamples(
+  const ConstWayPtr& way) const
+{
+  pair<unsigned long, boost::shared_ptr<vector<Coordinate> > >& entry =
+    _directionSamples[way->getId()];
+  if (entry.second.get() == 0 || entry.first != Element::getNodePositionEpoch())
+  {
+    entry.first = Element::getNodePositionEpoch();
+    entry.second.reset(new vector<Coordinate>());
+    WayDiscretizer wd(_map.shared_from_this(), way);
+    wd.discretize(5, *entry.second);
+  }
+  return entry.second;
+}
+
+boost::shared_ptr<const Geometry> OsmMapIndex::getGeometry(const ConstElementPtr& e) const
+{
+  ConstWayPtr w = boost::dynamic_pointer_cast<const Way>(e);
+  if (w.get() == 0)
+  {
+    // only ways are cached; see the header
+    return ElementConverter(_map.shared_from_this()).convertToGeometry(e);
+  }
+
+  const QString key = QString("%1;%2;%3")
+    .arg(w->getId())
+    .arg(w->getGeometryRevision())
+    .arg(Element::getNodePositionEpoch());
+  {
+    QMutexLocker lock(&_geometryCacheMutex);
+    boost::shared_ptr<const Geometry>* cached = _geometryCache.object(key);
+    if (cached != 0)
+    {
+      return *cached;
+    }
+  }
+
+  boost::shared_ptr<const Geometry> g =
+    ElementConverter(_map.shared_from_this()).convertToGeometry(e);
+  // force the lazy envelope calculation while the geometry is still private to this thread;
+  // GEOS computes it unlocked on first use, which would race once the object is shared.
+  g->getEnvelopeInternal();
+  {
+    QMutexLocker lock(&_geometryCacheMutex);
+    // another thread may have converted the same way in the mean time.
+    if (_geometryCache.contains(key) == false)
+    {
+      _geometryCache.insert(key, new boost::shared_ptr<const Geometry>(g));
+    }
+  }
+  return g;
+}
+
+boost::shared_ptr<const geos::geom::prep::PreparedGeometry> OsmMapIndex::getPreparedGeometry(
+  const ConstElementPtr& e) const
+{
+  ConstWayPtr w = boost::dynamic_pointer_cast<const Way>(e);
+  if (w.get() == 0)
+  {
+    // only ways are cached; see the header
+    return GeometryUtils::prepareGeometry(getGeometry(e));
+  }
+
+  const QString key = QString("%1;%2;%3")
+    .arg(w->getId())
+    .arg(w->getGeometryRevision())
+    .arg(Element::getNodePositionEpoch());
+  {
+    QMutexLocker lock(&_geometryCacheMutex);
+    boost::shared_ptr<const geos::geom::prep::PreparedGeometry>* cached =
+      _preparedGeometryCache.object(key);
+    if (cached != 0)
+    {
+      return *cached;
+    }
+  }
+
+  boost::shared_ptr<const geos::geom::prep::PreparedGeometry> pg =
+    GeometryUtils::prepareGeometry(getGeometry(e));
+  // as in getGeometry, force the lazy envelope calculation on the wrapped geometry before the
+  // prepared geometry is shared between threads.
+  pg->getGeometry().getEnvelopeInternal();
+  {
+    QMutexLocker lock(&_geometryCacheMutex);
+    // another thread may have prepared the same way in the mean time.
+    if (_preparedGeometryCache.contains(key) == false)
+    {
+      _preparedGeometryCache.insert(
+        key, new boost::shared_ptr<const geos::geom::prep::PreparedGeometry>(pg));
+    }
+  }
+  return pg;
+}
+
 set<ElementId> OsmMapIndex::getParents(ElementId eid) const
 {
   set<ElementId> result;
@@ -508,21 +713,40 @@ boost::shared_ptr<const HilbertRTree> OsmMapIndex::getWayTree() const
     _buildWayTree();
   }
 
-  OsmMapIndex* t = const_cast<OsmMapIndex*>(this);
-  for (set<long>::const_iterator it = _pendingWayInsert.begin(); it != _pendingWayInsert.end(); ++it)
+  if (_pendingWayInsert.size() > 0)
   {
-    if (_map.containsWay(*it))
+    OsmMapIndex* t = const_cast<OsmMapIndex*>(this);
+    for (set<long>::const_iterator it = _pendingWayInsert.begin();
+         it != _pendingWayInsert.end(); ++it)
     {
-      t->_insertWay(*it);
+      if (_map.containsWay(*it))
+      {
+        t->_insertWay(*it);
+      }
     }
+    _pendingWayInsert.clear();
   }
-  _pendingWayInsert.clear();
 
   return _wayTree;
 }
 
+void OsmMapIndex::prepareForConcurrentReads() const
+{
+  getNodeTree();
+  getWayTree();
+  // these are only lazily constructed; build them now so two readers can't race to do it.
+  getNodeToWayMap();
+  getElementToRelationMap();
+  _nodeTree->setConcurrentReadMode(true);
+  _wayTree->setConcurrentReadMode(true);
+}
+
 void OsmMapIndex::_insertNode(long nid)
 {
+  // the cache eviction that concurrent read mode suppresses is safe again once the tree is
+  // being modified.
+  _nodeTree->setConcurrentReadMode(false);
+
   ConstNodePtr n = _map.getNode(nid);
 
   Box b(2);
@@ -535,6 +759,8 @@ void OsmMapIndex::_insertNode(long nid)
 
 void OsmMapIndex::_insertWay(long wid)
 {
+  _wayTree->setConcurrentReadMode(false);
+
   ConstWayPtr w = _map.getWay(wid);
 
   Box b(2);
@@ -548,6 +774,79 @@ void OsmMapIndex::_insertWay(long wid)
   _wayTree->insert(b, _createTreeWid(wid));
 }
 
+bool OsmMapIndex::_removeNodeFromTree(ConstNodePtr n)
+{
+  _nodeTree->setConcurrentReadMode(false);
+
+  bool result = true;
+
+  // the search box only needs to intersect the box the entry was inserted with, so the node's
+  // current location works as long as the node hasn't moved since it was indexed.
+  Box b(2);
+  b.setBounds(0, n->getX(), n->getX());
+  b.setBounds(1, n->getY(), n->getY());
+
+  pair<multimap<long, int>::iterator, multimap<long, int>::iterator> range =
+    _nidToTreeId.equal_range(n->getId());
+  for (multimap<long, int>::iterator it = range.first; it != range.second;)
+  {
+    if (_nodeTree->remove(b, it->second))
+    {
+      _nidToTreeId.erase(it++);
+    }
+    else
+    {
+      result = false;
+      ++it;
+    }
+  }
+
+  return result;
+}
+
+bool OsmMapIndex::_removeWayFromTree(ConstWayPtr w)
+{
+  _wayTree->setConcurrentReadMode(false);
+
+  bool result = true;
+
+  // the stored boxes are padded versions of the way's envelope, so the raw envelope is
+  // guaranteed to intersect them as long as the geometry hasn't changed since it was indexed.
+  Box b(2);
+  try
+  {
+    boost::shared_ptr<LineString> ls =
+      ElementConverter(_map.shared_from_this()).convertToLineString(w);
+    const Envelope* e = ls->getEnvelopeInternal();
+
+    b.setBounds(0, e->getMinX(), e->getMaxX());
+    b.setBounds(1, e->getMinY(), e->getMaxY());
+  }
+  catch (const HootException&)
+  {
+    // can't derive the geometry (e.g. the way's nodes are already gone); let the caller fall
+    // back to the rebuild threshold.
+    return false;
+  }
+
+  pair<multimap<long, int>::iterator, multimap<long, int>::iterator> range =
+    _widToTreeId.equal_range(w->getId());
+  for (multimap<long, int>::iterator it = range.first; it != range.second;)
+  {
+    if (_wayTree->remove(b, it->second))
+    {
+      _widToTreeId.erase(it++);
+    }
+    else
+    {
+      result = false;
+      ++it;
+    }
+  }
+
+  return result;
+}
+
 void OsmMapIndex::preGeometryChange(Element* e)
 {
   if (_nodeToWayMap != 0)
@@ -587,6 +886,7 @@ void OsmMapIndex::postGeometryChange(Element* e)
   if (e->getElementType() == ElementType::Way)
   {
     addWay(_map.getWay(e->getId()));
+    _directionSamples.erase(e->getId());
   }
   if (_nodeToWayMap != 0)
   {
@@ -609,14 +909,20 @@ void OsmMapIndex::removeNode(ConstNodePtr n)
 {
   if (_nodeTree)
   {
-    _pendingNodeRemoval.insert(n->getId());
     _pendingNodeInsert.erase(n->getId());
 
-    if (_pendingNodeRemoval.size() > std::max((size_t)100, (size_t)_map.getNodes().size() / 8) &&
-        _nodeTree != 0)
+    // remove the entries from the R-Tree rather than rebuilding it later. If an entry can't be
+    // located (e.g. the node moved since it was indexed) fall back to the old rebuild threshold
+    // so stale entries don't accumulate without bound.
+    if (_removeNodeFromTree(n) == false)
     {
-      LOG_DEBUG("pending removal size: " << _pendingNodeRemoval.size());
-      _nodeTree.reset();
+      _pendingNodeRemoval.insert(n->getId());
+
+      if (_pendingNodeRemoval.size() > std::max((size_t)100, (size_t)_map.getNodes().size() / 8))
+      {
+        LOG_DEBUG("pending removal size: " << _pendingNodeRemoval.size());
+        _nodeTree.reset();
+      }
     }
   }
 }
@@ -631,8 +937,8 @@ void OsmMapIndex::removeRelation(const ConstRelationPtr& r)
 
 void OsmMapIndex::removeWay(ConstWayPtr w)
 {
-  _pendingWayRemoval.insert(w->getId());
   _pendingWayInsert.erase(w->getId());
+  _directionSamples.erase(w->getId());
 
   if (_nodeToWayMap != 0)
   {
@@ -640,11 +946,21 @@ void OsmMapIndex::removeWay(ConstWayPtr w)
     _nodeToWayMap->removeWay(w);
   }
 
-  if (_wayTree != 0 &&
-      _pendingWayRemoval.size() > std::max((size_t)100, (size_t)_map.getWays().size() / 8))
+  if (_wayTree != 0)
   {
-    LOG_DEBUG("pending removal size: " << _pendingWayRemoval.size());
-    _wayTree.reset();
+    // remove the entries from the R-Tree rather than rebuilding it later. If an entry can't be
+    // located (e.g. the geometry changed since it was indexed) fall back to the old rebuild
+    // threshold so stale entries don't accumulate without bound.
+    if (_removeWayFromTree(w) == false)
+    {
+      _pendingWayRemoval.insert(w->getId());
+
+      if (_pendingWayRemoval.size() > std::max((size_t)100, (size_t)_map.getWays().size() / 8))
+      {
+        LOG_DEBUG("pending removal size: " << _pendingWayRemoval.size());
+        _wayTree.reset();
+      }
+    }
   }
 }
 
@@ -654,6 +970,14 @@ void OsmMapIndex::reset()
   _pendingWayRemoval.clear();
   _pendingNodeInsert.clear();
   _pendingNodeRemoval.clear();
+  _nidToTreeId.clear();
+  _widToTreeId.clear();
+  _directionSamples.clear();
+  {
+    QMutexLocker lock(&_geometryCacheMutex);
+    _geometryCache.clear();
+    _preparedGeometryCache.clear();
+  }
   _nodeToWayMap.reset();
   _wayTree.reset();
   _nodeTree.reset();
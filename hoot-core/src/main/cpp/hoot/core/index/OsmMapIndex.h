@@ -34,11 +34,27 @@
 #include <hoot/core/index/ElementToRelationMap.h>
 
 // STL
+#include <map>
 #include <vector>
 
 // TGS
 #include <tgs/RStarTree/HilbertRTree.h>
 
+namespace geos
+{
+  namespace geom
+  {
+    namespace prep
+    {
+      class PreparedGeometry;
+    }
+  }
+}
+
+// Qt
+#include <QCache>
+#include <QMutex>
+
 namespace hoot
 {
 
@@ -86,6 +102,14 @@ public:
    */
   std::vector<long> findWayNeighbors(geos::geom::Coordinate& from, Meters buffer) const;
 
+  /**
+   * Batched version of findWayNeighbors. The queries are evaluated in Hilbert order so
+   * consecutive searches descend through the same upper levels of the tree while those nodes
+   * are still hot in the node cache. The result is in the same order as the input ways.
+   */
+  std::vector< std::vector<long> > findWayNeighbors(const std::vector<ConstWayPtr>& ways,
+    Meters buffer, bool addError = false) const;
+
   std::vector<long> findWayNeighborsBruteForce(ConstWayPtr way, Meters buffer) const;
 
   /**
@@ -96,6 +120,12 @@ public:
 
   Meters getIndexSlush() const { return _indexSlush; }
 
+  /**
+   * Returns a rough estimate of the bytes of RAM the index structures occupy. Only structures
+   * that have already been built are counted; nothing is built as a side effect of asking.
+   */
+  size_t getMemoryUsageEstimate() const;
+
   boost::shared_ptr<NodeToWayMap> getNodeToWayMap() const;
 
   /**
@@ -108,11 +138,48 @@ public:
    */
   boost::shared_ptr<const Tgs::HilbertRTree> getNodeTree() const;
 
+  /**
+   * Returns the way discretized into 5m samples for direction comparisons (see
+   * DirectionFinder). The samples are cached per way and dropped when the way's geometry
+   * changes, so the repeated direction checks inside merge cascades become table lookups. The
+   * returned pointer stays valid after the cache entry is dropped.
+   */
+  boost::shared_ptr<const std::vector<geos::geom::Coordinate> > getDirectionSamples(
+    const ConstWayPtr& way) const;
+
+  /**
+   * Returns the element converted to a geos geometry, serving repeats from a bounded cache.
+   * Matching converts the same polygons dozens of times per run; with the cache the GEOS
+   * construction happens once per way geometry. The cache key includes the way's geometry
+   * revision and the node position epoch, so a stale geometry is never returned -- entries for
+   * old geometries simply age out. Only ways are cached (nodes are cheap and relations have no
+   * geometry revision to key on). The returned geometry is shared: treat it as read only. Safe
+   * to call from multiple threads.
+   */
+  boost::shared_ptr<const geos::geom::Geometry> getGeometry(const ConstElementPtr& e) const;
+
+  /**
+   * Like getGeometry, but returns the geometry wrapped in a GEOS PreparedGeometry (see
+   * GeometryUtils::prepareGeometry) so repeated contains/intersects probes against the same
+   * polygon run against its edge index instead of evaluating a full intersection matrix each
+   * time. Cached and keyed like getGeometry; safe to call from multiple threads.
+   */
+  boost::shared_ptr<const geos::geom::prep::PreparedGeometry> getPreparedGeometry(
+    const ConstElementPtr& e) const;
+
   /**
    * Get all the direct parents of a given element. This will not return grand parents, etc.
    */
   std::set<ElementId> getParents(ElementId eid) const;
 
+  /**
+   * Builds the way and node R-trees if necessary, applies all pending changes and puts the
+   * trees into a mode where concurrent reads (e.g. findWayNeighbors or findNodes from multiple
+   * threads) are safe. The mode lasts until the map is modified; modifying the map while
+   * readers are active is not safe.
+   */
+  void prepareForConcurrentReads() const;
+
   const std::vector<long>& getTreeIdToWidMap() const { return _treeIdToWid; }
 
   boost::shared_ptr<const Tgs::HilbertRTree> getWayTree() const;
@@ -161,6 +228,25 @@ private:
   mutable std::vector<long> _treeIdToNid;
   mutable std::vector<long> _treeIdToWid;
 
+  // reverse lookups used to remove entries from the trees. An element that changed multiple
+  // times may have multiple tree ids.
+  mutable std::multimap<long, int> _nidToTreeId;
+  mutable std::multimap<long, int> _widToTreeId;
+
+  // cached 5m direction samples per way (see getDirectionSamples). The first pair member is
+  // the node position epoch the samples were computed at; node moves invalidate them lazily
+  // while way changes erase the entry outright.
+  mutable HashMap<long, std::pair<unsigned long,
+    boost::shared_ptr<std::vector<geos::geom::Coordinate> > > > _directionSamples;
+
+  // bounded cache of way geometries (see getGeometry). The entry count bound approximates a
+  // memory bound; way polygons are small compared to the map itself.
+  mutable QCache<QString, boost::shared_ptr<const geos::geom::Geometry> > _geometryCache;
+  // prepared counterparts of the cached geometries; both caches share one mutex
+  mutable QCache<QString,
+    boost::shared_ptr<const geos::geom::prep::PreparedGeometry> > _preparedGeometryCache;
+  mutable QMutex _geometryCacheMutex;
+
   void _buildNodeTree() const;
   void _buildWayTree() const;
 
@@ -170,6 +256,13 @@ private:
   void _insertNode(long nid);
   void _insertWay(long wid);
 
+  /**
+   * Remove all the tree entries for the given element. Returns false if one or more entries
+   * couldn't be located (e.g. the geometry changed since it was indexed).
+   */
+  bool _removeNodeFromTree(ConstNodePtr n);
+  bool _removeWayFromTree(ConstWayPtr w);
+
   long _mapToWayId(int treeId) const { return _treeIdToWid[treeId]; }
   long _mapToNodeId(int treeId) const { return _treeIdToNid[treeId]; }
 };
@@ -0,0 +1,231 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "SpatialJoin.h"
+
+// Hoot
+#include <hoot/core/index/OsmMapIndex.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/HootException.h>
+
+// Qt
+#include <QThread>
+
+// Standard
+#include <algorithm>
+#include <memory>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+
+/**
+ * Probes a contiguous shard of the join's probe elements against the map index. Each worker
+ * writes into its own output vector, so no locking is needed.
+ */
+class JoinShardWorker : public QThread
+{
+public:
+
+  JoinShardWorker(const ConstOsmMapPtr& map, const vector<ElementId>& probes,
+    const set<ElementId>& target, Meters distance, bool selfJoin, size_t begin, size_t end) :
+    _map(map),
+    _probes(probes),
+    _target(target),
+    _distance(distance),
+    _selfJoin(selfJoin),
+    _begin(begin),
+    _end(end)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      const OsmMapIndex& index = _map->getIndex();
+      for (size_t i = _begin; i < _end; i++)
+      {
+        const ElementId eid = _probes[i];
+        Envelope env;
+        if (eid.getType() == ElementType::Node)
+        {
+          ConstNodePtr n = _map->getNode(eid.getId());
+          env = Envelope(n->getX(), n->getX(), n->getY(), n->getY());
+        }
+        else
+        {
+          auto_ptr<Envelope> e(_map->getWay(eid.getId())->getEnvelope(_map));
+          if (e->isNull())
+          {
+            continue;
+          }
+          env = *e;
+        }
+        env.expandBy(_distance);
+
+        vector<long> nids = index.findNodes(env);
+        for (size_t k = 0; k < nids.size(); ++k)
+        {
+          _emit(eid, ElementId::node(nids[k]));
+        }
+        vector<long> wids = index.findWays(env);
+        for (size_t k = 0; k < wids.size(); ++k)
+        {
+          _emit(eid, ElementId::way(wids[k]));
+        }
+      }
+    }
+    catch (const HootException& e)
+    {
+      _error = e.getWhat();
+    }
+  }
+
+  const vector< pair<ElementId, ElementId> >& getPairs() const { return _pairs; }
+  bool hasError() const { return _error.isEmpty() == false; }
+  QString getError() const { return _error; }
+
+private:
+
+  void _emit(const ElementId& eid, const ElementId& other)
+  {
+    // a self join normalizes smaller id first so each unordered pair appears once.
+    if (_selfJoin && !(eid < other))
+    {
+      return;
+    }
+    if (other != eid && _target.count(other) > 0)
+    {
+      _pairs.push_back(pair<ElementId, ElementId>(eid, other));
+    }
+  }
+
+  ConstOsmMapPtr _map;
+  const vector<ElementId>& _probes;
+  const set<ElementId>& _target;
+  Meters _distance;
+  bool _selfJoin;
+  size_t _begin;
+  size_t _end;
+  vector< pair<ElementId, ElementId> > _pairs;
+  QString _error;
+};
+
+}
+
+SpatialJoin::SpatialJoin(const ConstOsmMapPtr& map) :
+_map(map)
+{
+}
+
+vector< pair<ElementId, ElementId> > SpatialJoin::join(const set<ElementId>& candidates,
+  Meters distance) const
+{
+  return _join(candidates, candidates, distance, true);
+}
+
+vector< pair<ElementId, ElementId> > SpatialJoin::join(const set<ElementId>& from,
+  const set<ElementId>& to, Meters distance) const
+{
+  return _join(from, to, distance, false);
+}
+
+vector< pair<ElementId, ElementId> > SpatialJoin::_join(const set<ElementId>& from,
+  const set<ElementId>& to, Meters distance, bool selfJoin) const
+{
+  vector< pair<ElementId, ElementId> > result;
+
+  // relations aren't indexed, so only nodes and ways probe.
+  vector<ElementId> probes;
+  probes.reserve(from.size());
+  for (set<ElementId>::const_iterator it = from.begin(); it != from.end(); ++it)
+  {
+    if (it->getType() == ElementType::Node || it->getType() == ElementType::Way)
+    {
+      probes.push_back(*it);
+    }
+  }
+  if (probes.empty())
+  {
+    return result;
+  }
+
+  const int threadCount =
+    max(1, min(ConfigOptions().getSpatialJoinThreads(), (int)probes.size()));
+  if (threadCount > 1)
+  {
+    // build the lazy indexes up front; the workers only read them.
+    _map->getIndex().prepareForConcurrentReads();
+  }
+  else
+  {
+    // a single shard run on the calling thread covers the serial case.
+    JoinShardWorker worker(_map, probes, to, distance, selfJoin, 0, probes.size());
+    worker.run();
+    if (worker.hasError())
+    {
+      throw HootException(worker.getError());
+    }
+    return worker.getPairs();
+  }
+
+  const size_t shardSize = (probes.size() + threadCount - 1) / threadCount;
+  vector<JoinShardWorker*> workers;
+  for (int t = 0; t < threadCount; t++)
+  {
+    const size_t begin = min(probes.size(), (size_t)t * shardSize);
+    const size_t end = min(probes.size(), begin + shardSize);
+    workers.push_back(new JoinShardWorker(_map, probes, to, distance, selfJoin, begin, end));
+    workers.back()->start();
+  }
+
+  QString error;
+  for (size_t t = 0; t < workers.size(); t++)
+  {
+    workers[t]->wait();
+    if (error.isEmpty() && workers[t]->hasError())
+    {
+      error = workers[t]->getError();
+    }
+    // concatenating in shard order keeps the result identical at any thread count.
+    result.insert(result.end(), workers[t]->getPairs().begin(), workers[t]->getPairs().end());
+    delete workers[t];
+  }
+  if (error.isEmpty() == false)
+  {
+    throw HootException(error);
+  }
+
+  return result;
+}
+
+}
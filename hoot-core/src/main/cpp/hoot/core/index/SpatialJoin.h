@@ -0,0 +1,86 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef SPATIALJOIN_H
+#define SPATIALJOIN_H
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+
+// Standard
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Evaluates distance joins between element sets using the map's spatial indexes.
+ *
+ * Several code paths (match candidate discovery, tie point searches, overlap checks) used to run
+ * their own ad hoc neighbor sweeps over OsmMapIndex. Routing them through one kernel means the
+ * partitioning, index priming and threading only have to be tuned in one place. The probe
+ * elements are split into contiguous shards that query the index concurrently on
+ * spatial.join.threads worker threads; the emitted pairs are concatenated in shard order, so the
+ * result is identical at any thread count.
+ *
+ * Only nodes and ways participate; the map index doesn't index relations, so relation ids in the
+ * input sets are silently skipped. The distance predicate is evaluated on element envelopes
+ * expanded by the join distance, which is the same candidate semantic the index queries have
+ * always provided - callers needing an exact geometric distance filter the pairs afterward.
+ */
+class SpatialJoin
+{
+public:
+
+  SpatialJoin(const ConstOsmMapPtr& map);
+
+  /**
+   * Self join: returns every unordered pair of distinct candidates whose envelopes are within
+   * the given distance, normalized smaller id first so each pair appears once.
+   */
+  std::vector< std::pair<ElementId, ElementId> > join(const std::set<ElementId>& candidates,
+    Meters distance) const;
+
+  /**
+   * Join between two sets: returns every (from, to) pair of distinct elements whose envelopes
+   * are within the given distance.
+   */
+  std::vector< std::pair<ElementId, ElementId> > join(const std::set<ElementId>& from,
+    const std::set<ElementId>& to, Meters distance) const;
+
+private:
+
+  ConstOsmMapPtr _map;
+
+  std::vector< std::pair<ElementId, ElementId> > _join(const std::set<ElementId>& from,
+    const std::set<ElementId>& to, Meters distance, bool selfJoin) const;
+};
+
+}
+
+#endif // SPATIALJOIN_H
@@ -307,7 +307,8 @@ public:
     for (size_t i = 0; i < leaf->getSize(); ++i)
     {
       const std::pair<KeyType, DataType>& p = leaf->get(i);
-      int d = _df(_query.getMetricElement(), p.first.getMetricElement());
+      // use the bounded form so far away candidates can be rejected cheaply.
+      int d = _df(_query.getMetricElement(), p.first.getMetricElement(), _queryD);
       if (d <= _queryD)
       {
         result.insert(p.second);
@@ -317,6 +318,12 @@ public:
 
   int getDepth() const { return _depth; }
 
+  /**
+   * Returns the fixed query keys, one per FQ depth. Exposed so a built tree can be serialized
+   * and reloaded without rebuilding.
+   */
+  const std::vector<KeyType>& getFixedQueries() const { return _q; }
+
   int getQueryD() const { return _queryD; }
 
   int resetDistanceCount()
@@ -339,6 +346,8 @@ public:
 
   void setDepth(int depth) { _depth = depth; }
 
+  void setFixedQueries(const std::vector<KeyType>& q) { _q = q; }
+
   /**
    * Sets the keys and values that will be used to build the layers. The keys and values should
    * not change through the build process.
@@ -418,6 +427,11 @@ private:
  *
  *   int operator() (<element type>, <element type>);
  *
+ *   int operator() (<element type>, <element type>, int maxD);
+ *
+ * The bounded form may return any value greater than maxD once the distance is known to exceed
+ * maxD, which lets the function reject candidates without a full computation.
+ *
  * The <element type> does not need to by known by the tree.
  *
  * 1. Proximity Matching Using Fixed-Queries Trees
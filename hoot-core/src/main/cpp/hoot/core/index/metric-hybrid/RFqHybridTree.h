@@ -33,6 +33,12 @@
 // boost
 #include <boost/pool/object_pool.hpp>
 
+// hoot
+#include <hoot/core/util/HootException.h>
+
+// Qt
+#include <QDataStream>
+
 namespace hoot
 {
 
@@ -53,6 +59,11 @@ namespace hybrid
  *
  *   int operator() (<element type>, <element type>);
  *
+ *   int operator() (<element type>, <element type>, int maxD);
+ *
+ * The bounded form may return any value greater than maxD once the distance is known to exceed
+ * maxD, which lets the function reject candidates without a full computation.
+ *
  * The <element type> does not need to by known by the tree.
  *
  * @optimize This data structure has not been through any real optimization steps. I tuned the
@@ -157,6 +168,22 @@ public:
     return result;
   }
 
+  /**
+   * Bulk version of find. Evaluates each (coordinate, key) probe in turn and returns the results
+   * in the same order as the probes. points and ks must be the same size.
+   */
+  std::vector< std::set<DataType> > find(const std::vector<geos::geom::Coordinate>& points,
+    const std::vector<KeyType>& ks, double radius, int D) const
+  {
+    assert(points.size() == ks.size());
+    std::vector< std::set<DataType> > result(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      result[i] = find(points[i], radius, ks[i], D);
+    }
+    return result;
+  }
+
   virtual void findLeaf(const Leaf<KeyType, DataType>* leaf, std::set<DataType>& result) const
   {
     for (size_t i = 0; i < leaf->getSize(); ++i)
@@ -165,7 +192,9 @@ public:
       if (_rLayer.distance(_rLayer.getQueryCoordinate(), p.first.getEnvelope()) <=
           _rLayer.getQueryRadius())
       {
-        int d = _df(_queryTerm.getMetricElement(), p.first.getMetricElement());
+        // use the bounded form so far away candidates can be rejected cheaply.
+        int d = _df(_queryTerm.getMetricElement(), p.first.getMetricElement(),
+                    _fqLayer.getQueryD());
         if (d <= _fqLayer.getQueryD())
         {
           result.insert(p.second);
@@ -174,6 +203,39 @@ public:
     }
   }
 
+  /**
+   * Reads an index written by writeObject, replacing any index currently in memory. The tree
+   * must be constructed with the same bucket size and child count that were used when the index
+   * was built.
+   */
+  void readObject(QDataStream& is)
+  {
+    delete _root;
+    _root = 0;
+
+    qint32 version;
+    is >> version;
+    if (version != 1)
+    {
+      throw HootException(QString("Unexpected RFqHybridTree index version: %1").arg(version));
+    }
+    qint32 rDepth, fqDepth;
+    is >> rDepth >> fqDepth;
+    _rDepth = rDepth;
+    _fqDepth = fqDepth;
+
+    quint32 qSize;
+    is >> qSize;
+    std::vector<KeyType> q((size_t)qSize);
+    for (size_t i = 0; i < q.size(); ++i)
+    {
+      is >> q[i];
+    }
+    _fqLayer.setFixedQueries(q);
+
+    _root = _readNode(is);
+  }
+
   int resetDistanceCount()
   {
     return _rLayer.resetDistanceCount();
@@ -189,8 +251,34 @@ public:
     return result;
   }
 
+  /**
+   * Writes the built index to a stream so a later process can reload it with readObject instead
+   * of rebuilding it. KeyType and DataType must support QDataStream's << and >> operators.
+   */
+  void writeObject(QDataStream& os) const
+  {
+    os << (qint32)1;
+    os << (qint32)_rDepth;
+    os << (qint32)_fqDepth;
+    const std::vector<KeyType>& q = _fqLayer.getFixedQueries();
+    os << (quint32)q.size();
+    for (size_t i = 0; i < q.size(); ++i)
+    {
+      os << q[i];
+    }
+    _writeNode(os, _root);
+  }
+
 protected:
 
+  enum SerializedNodeType
+  {
+    NullNodeType = 0,
+    RNodeType = 1,
+    FqNodeType = 2,
+    LeafType = 3
+  };
+
   Node<KeyType, DataType>* _root;
 
   mutable KeyType _queryTerm;
@@ -200,6 +288,108 @@ protected:
   int _rDepth;
   int _fqDepth;
 
+  Node<KeyType, DataType>* _readNode(QDataStream& is)
+  {
+    qint8 type;
+    is >> type;
+
+    switch (type)
+    {
+    case NullNodeType:
+      return 0;
+    case LeafType:
+      {
+        Leaf<KeyType, DataType>* leaf = new Leaf<KeyType, DataType>();
+        quint32 size;
+        is >> size;
+        KeyType k;
+        DataType d;
+        for (quint32 i = 0; i < size; ++i)
+        {
+          is >> k;
+          is >> d;
+          leaf->addData(k, d);
+        }
+        return leaf;
+      }
+    case RNodeType:
+      {
+        RNode<KeyType, DataType>* rn = new RNode<KeyType, DataType>();
+        quint32 count;
+        is >> count;
+        double minX, maxX, minY, maxY;
+        for (quint32 i = 0; i < count; ++i)
+        {
+          is >> minX >> maxX >> minY >> maxY;
+          rn->addChild(_readNode(is), geos::geom::Envelope(minX, maxX, minY, maxY));
+        }
+        return rn;
+      }
+    case FqNodeType:
+      {
+        FqNode<KeyType, DataType>* fqn = new FqNode<KeyType, DataType>();
+        quint32 count;
+        is >> count;
+        qint16 d;
+        for (quint32 i = 0; i < count; ++i)
+        {
+          is >> d;
+          fqn->addChild(_readNode(is), (short)d);
+        }
+        return fqn;
+      }
+    default:
+      throw HootException(QString("Unexpected node type in RFqHybridTree index: %1").arg(type));
+    }
+  }
+
+  void _writeNode(QDataStream& os, const Node<KeyType, DataType>* n) const
+  {
+    if (n == 0)
+    {
+      os << (qint8)NullNodeType;
+      return;
+    }
+
+    const Leaf<KeyType, DataType>* leaf = dynamic_cast<const Leaf<KeyType, DataType>*>(n);
+    if (leaf != 0)
+    {
+      os << (qint8)LeafType;
+      os << (quint32)leaf->getSize();
+      for (size_t i = 0; i < leaf->getSize(); ++i)
+      {
+        const std::pair<KeyType, DataType>& p = leaf->get(i);
+        os << p.first;
+        os << p.second;
+      }
+      return;
+    }
+
+    const RNode<KeyType, DataType>* rn = dynamic_cast<const RNode<KeyType, DataType>*>(n);
+    if (rn != 0)
+    {
+      os << (qint8)RNodeType;
+      os << (quint32)rn->getChildCount();
+      for (size_t i = 0; i < rn->getChildCount(); ++i)
+      {
+        const geos::geom::Envelope& e = rn->getChildEnvelope(i);
+        os << e.getMinX() << e.getMaxX() << e.getMinY() << e.getMaxY();
+        _writeNode(os, rn->getChild(i));
+      }
+      return;
+    }
+
+    const FqNode<KeyType, DataType>* fqn = dynamic_cast<const FqNode<KeyType, DataType>*>(n);
+    assert(fqn != 0);
+    os << (qint8)FqNodeType;
+    os << (quint32)fqn->getChildCount();
+    for (size_t i = 0; i < fqn->getChildCount(); ++i)
+    {
+      os << (qint16)fqn->getChildDistance(i);
+      _writeNode(os, fqn->getChild(i));
+    }
+  }
+
   /**
    * Returns true if the layer at this depth is a RLayer.
    */
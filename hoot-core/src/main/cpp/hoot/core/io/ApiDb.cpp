@@ -28,6 +28,7 @@
 
 // hoot
 #include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/TagDictionary.h>
 #include <hoot/core/elements/Way.h>
 #include <hoot/core/elements/Relation.h>
 #include <hoot/core/io/SqlBulkInsert.h>
@@ -320,42 +321,83 @@ boost::shared_ptr<QSqlQuery> ApiDb::selectNodesForWay(long wayId, const QString
   return _selectNodeIdsForWay;
 }
 
+bool ApiDb::_parseHstoreQuotedString(const QString& str, int& pos, QString& out)
+{
+  const int len = str.length();
+  //advance to the opening quote; this skips the "=>" and ", " separators between entries.
+  while (pos < len && str[pos] != QChar('"'))
+  {
+    pos++;
+  }
+  if (pos >= len)
+  {
+    return false;
+  }
+  pos++;
+
+  out.resize(0);
+  while (pos < len)
+  {
+    const QChar c = str[pos];
+    if (c == QChar('\\'))
+    {
+      //hstore emits \" and \\; the octal forms show up in data written by older versions.
+      if (str.mid(pos + 1, 3) == "042")
+      {
+        out += QChar('"');
+        pos += 4;
+      }
+      else if (str.mid(pos + 1, 3) == "134")
+      {
+        out += QChar('\\');
+        pos += 4;
+      }
+      else if (pos + 1 < len)
+      {
+        out += str[pos + 1];
+        pos += 2;
+      }
+      else
+      {
+        pos++;
+      }
+    }
+    else if (c == QChar('"'))
+    {
+      pos++;
+      return true;
+    }
+    else
+    {
+      out += c;
+      pos++;
+    }
+  }
+  //unterminated string; treat it as the end of the input.
+  return false;
+}
+
 Tags ApiDb::unescapeTags(const QVariant &v)
 {
-  /** NOTE:  When we upgrade from Qt4 to Qt5 we can use the QRegularExpression
-   *  classes that should enable the regex below that has both greedy matching
-   *  and lazy matching in the same regex.  The QRegExp class doesn't allow this
-   *  that is why there are two regex objects in this function.
-   *
-   *  Replace it with this:
-   *    QRegularExpression rxKeyValue("\"(.*?)\"=>\"((?:(?!\",).)*)\"(?:, )?");
-   */
   assert(v.type() == QVariant::String);
-  QString str = v.toString();
+  const QString str = v.toString();
 
+  //a single pass scanner replaced the old QRegExp pair here: the regexes were recompiled on
+  //every call and rescanned the text several times, which showed up badly when reading tag
+  //heavy maps. Escaped quotes inside values are handled directly instead of post-processed.
   Tags result;
-  QRegExp rxKey("\"(.*)\"=>\"");
-  QRegExp rxValue("((?:(?!\",).)*)\"(?:, )?");
-  //  The key regex needs to be minimal should be (.*?) but that doesn't work
-  //  while the value regex needs to be maximal to consume quotes within the value
-  rxKey.setMinimal(true);
-  rxValue.setMinimal(false);
+  TagDictionary& dictionary = TagDictionary::getInstance();
   int pos = 0;
-  //  Match the key first
-  while ((pos = rxKey.indexIn(str, pos)) != -1)
+  QString key;
+  QString value;
+  while (_parseHstoreQuotedString(str, pos, key))
   {
-    pos += rxKey.matchedLength();
-    //  Then match the value, ignoring any key/value pairs that don't match
-    if ((pos = rxValue.indexIn(str, pos)) != -1)
+    if (!_parseHstoreQuotedString(str, pos, value))
     {
-      QString key = rxKey.cap(1);
-      QString value = rxValue.cap(1);
-      //  Unescape the actual key/value pairs
-      _unescapeString(key);
-      _unescapeString(value);
-      result.insert(key, value);
-      pos += rxValue.matchedLength();
+      break;
     }
+    //interning means every element holding a repeated key or value shares one string buffer.
+    result.insert(dictionary.intern(key), dictionary.intern(value));
   }
 
   return result;
@@ -509,6 +551,22 @@ boost::shared_ptr<QSqlQuery> ApiDb::selectWayIdsByWayNodeIds(const QSet<QString>
   return _selectWayIdsByWayNodeIds;
 }
 
+boost::shared_ptr<QSqlQuery> ApiDb::selectElementsInRange(const ElementType& /*elementType*/,
+                                                          long /*minId*/, long /*maxId*/)
+{
+  throw HootException("Ranged element selection is not supported by this API database.");
+}
+
+long ApiDb::minId(const ElementType& /*elementType*/)
+{
+  throw HootException("Ranged element selection is not supported by this API database.");
+}
+
+long ApiDb::maxId(const ElementType& /*elementType*/)
+{
+  throw HootException("Ranged element selection is not supported by this API database.");
+}
+
 boost::shared_ptr<QSqlQuery> ApiDb::selectElementsByElementIdList(const QSet<QString>& elementIds,
                                                            const TableType& tableType)
 {
@@ -152,6 +152,30 @@ public:
   virtual boost::shared_ptr<QSqlQuery> selectElements(const ElementType& elementType,
                                                       const bool sorted = false) = 0;
 
+  /**
+   * Returns a results iterator to the OSM elements of the given type whose ids fall in
+   * [minId, maxId]. Used by the partitioned parallel read; unsupported by default.
+   *
+   * @param elementType the type of element to return
+   * @param minId the low end of the id range, inclusive
+   * @param maxId the high end of the id range, inclusive
+   * @return a result iterator to the elements
+   */
+  virtual boost::shared_ptr<QSqlQuery> selectElementsInRange(const ElementType& elementType,
+                                                             long minId, long maxId);
+
+  /**
+   * Returns the smallest element id of the given type, or 0 when the table is empty. Unsupported
+   * by default; see selectElementsInRange.
+   */
+  virtual long minId(const ElementType& elementType);
+
+  /**
+   * Returns the largest element id of the given type, or 0 when the table is empty. Unsupported
+   * by default; see selectElementsInRange.
+   */
+  virtual long maxId(const ElementType& elementType);
+
   /**
    * Returns a vector with all the OSM node ID's for a given way
    */
@@ -188,7 +212,9 @@ public:
   virtual void deleteUser(long userId) = 0;
 
   /**
-   * Given a QVariant (string), unscape the tags into a full tag map.
+   * Given a QVariant (string), unscape the tags into a full tag map. The hstore text is decoded
+   * in a single pass and the keys and values are interned through TagDictionary, so repeated
+   * tag strings across a large read share storage instead of being reallocated per element.
    */
   static Tags unescapeTags(const QVariant& v);
 
@@ -365,6 +391,10 @@ protected:
 
   static void _unescapeString(QString& s);
 
+  //scans one quoted hstore string starting at or after pos, leaving pos just past the closing
+  //quote; returns false when no further quoted string exists
+  static bool _parseHstoreQuotedString(const QString& str, int& pos, QString& out);
+
   virtual void _resetQueries();
 
 private:
@@ -27,6 +27,8 @@
 #include "ApiDbReader.h"
 
 // Hoot
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Factory.h>
 #include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/io/TableType.h>
@@ -34,7 +36,13 @@
 #include <hoot/core/util/Log.h>
 
 // Qt
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSet>
+#include <QThread>
+
+// Standard
+#include <algorithm>
 
 using namespace geos::geom;
 
@@ -43,6 +51,121 @@ namespace hoot
 
 unsigned int ApiDbReader::logWarnCount = 0;
 
+namespace // anonymous
+{
+
+//a contiguous id range of one element type read by a single parallel worker
+struct ReadShard
+{
+  ElementType::Type elementType;
+  long minId;
+  long maxId;
+};
+
+}
+
+/**
+ * One worker thread of the partitioned parallel read. Each worker constructs its own reader (and
+ * therefore its own database connection) through the factory, pulls id range shards off a shared
+ * work list, reads each shard into a private map and bulk-adds the results into the shared output
+ * map under its lock.
+ */
+class ApiDbReader::ParallelReadWorker : public QThread
+{
+public:
+
+  ParallelReadWorker(const std::string& readerName, const QString& url, const Status& status,
+                     const std::vector<ReadShard>& shards, size_t& nextShardIndex,
+                     QMutex& shardMutex, OsmMapPtr map, QMutex& mapMutex) :
+    _readerName(readerName),
+    _url(url),
+    _status(status),
+    _shards(shards),
+    _nextShardIndex(nextShardIndex),
+    _shardMutex(shardMutex),
+    _map(map),
+    _mapMutex(mapMutex)
+  {
+  }
+
+  QString getError() const { return _error; }
+
+  virtual void run()
+  {
+    try
+    {
+      boost::shared_ptr<OsmMapReader> reader(
+        Factory::getInstance().constructObject<OsmMapReader>(_readerName));
+      boost::shared_ptr<ApiDbReader> dbReader =
+        boost::dynamic_pointer_cast<ApiDbReader>(reader);
+      if (dbReader == 0)
+      {
+        throw HootException(
+          "Parallel read worker requires an ApiDbReader; got: " +
+          QString::fromStdString(_readerName));
+      }
+      dbReader->setUseDataSourceIds(true);
+      dbReader->setDefaultStatus(_status);
+      dbReader->open(_url);
+
+      while (true)
+      {
+        ReadShard shard;
+        {
+          QMutexLocker lock(&_shardMutex);
+          if (_nextShardIndex >= _shards.size())
+          {
+            break;
+          }
+          shard = _shards[_nextShardIndex++];
+        }
+
+        OsmMapPtr shardMap(new OsmMap());
+        dbReader->_readRange(shardMap, shard.elementType, shard.minId, shard.maxId);
+
+        QMutexLocker lock(&_mapMutex);
+        const NodeMap& nodes = shardMap->getNodes();
+        for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+        {
+          _map->addElement(it->second);
+        }
+        const WayMap& ways = shardMap->getWays();
+        for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+        {
+          _map->addElement(it->second);
+        }
+        const RelationMap& relations = shardMap->getRelations();
+        for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
+        {
+          _map->addElement(it->second);
+        }
+      }
+
+      dbReader->close();
+    }
+    catch (const HootException& e)
+    {
+      _error = e.getWhat();
+    }
+    catch (const std::exception& e)
+    {
+      _error = QString(e.what());
+    }
+  }
+
+private:
+
+  std::string _readerName;
+  QString _url;
+  Status _status;
+  const std::vector<ReadShard>& _shards;
+  size_t& _nextShardIndex;
+  QMutex& _shardMutex;
+  OsmMapPtr _map;
+  QMutex& _mapMutex;
+  QString _error;
+};
+
 ApiDbReader::ApiDbReader() :
 _useDataSourceIds(true),
 _status(Status::Invalid),
@@ -443,6 +566,21 @@ void ApiDbReader::read(OsmMapPtr map)
 {
   if (!_hasBounds())
   {
+    const int readThreads = ConfigOptions().getApiDbReaderReadThreads();
+    if (readThreads > 1)
+    {
+      //id remapping is order dependent, so the parallel read requires source ids
+      if (_supportsParallelRead() && _useDataSourceIds)
+      {
+        LOG_DEBUG("Executing parallel API read query with " << readThreads << " threads...");
+        _readParallel(map, readThreads);
+        return;
+      }
+      LOG_WARN(
+        "Parallel read requested but not supported by this reader configuration; reading " <<
+        "serially instead.");
+    }
+
     LOG_DEBUG("Executing API read query...");
     for (int ctr = ElementType::Node; ctr != ElementType::Unknown; ctr++)
     {
@@ -501,6 +639,90 @@ void ApiDbReader::_read(OsmMapPtr map, const ElementType& elementType)
   LOG_VARD(map->getRelations().size());
 }
 
+void ApiDbReader::_readRange(OsmMapPtr map, const ElementType& elementType, long minId,
+                             long maxId)
+{
+  boost::shared_ptr<QSqlQuery> elementResultsIterator =
+    _getDatabase()->selectElementsInRange(elementType, minId, maxId);
+
+  //see the iteration comments in _read
+  while (elementResultsIterator->isActive())
+  {
+    boost::shared_ptr<Element> element =
+      _resultToElement(*elementResultsIterator, elementType, *map);
+    if (element.get())
+    {
+      map->addElement(element);
+    }
+  }
+}
+
+void ApiDbReader::_readParallel(OsmMapPtr map, int threadCount)
+{
+  //split each element type's id range into more shards than threads, so sparse id ranges still
+  //balance across the workers
+  std::vector<ReadShard> shards;
+  for (int ctr = ElementType::Node; ctr != ElementType::Unknown; ctr++)
+  {
+    if (_returnNodesOnly && ctr != ElementType::Node)
+    {
+      break;
+    }
+    const ElementType elementType = static_cast<ElementType::Type>(ctr);
+    const long minId = _getDatabase()->minId(elementType);
+    const long maxId = _getDatabase()->maxId(elementType);
+    if (minId == 0 && maxId == 0)
+    {
+      continue;
+    }
+    long shardSize = (maxId - minId + 1) / (threadCount * 4);
+    if (shardSize < 1)
+    {
+      shardSize = 1;
+    }
+    for (long start = minId; start <= maxId; start += shardSize)
+    {
+      ReadShard shard;
+      shard.elementType = static_cast<ElementType::Type>(ctr);
+      shard.minId = start;
+      shard.maxId = std::min(maxId, start + shardSize - 1);
+      shards.push_back(shard);
+    }
+  }
+
+  size_t nextShardIndex = 0;
+  QMutex shardMutex;
+  QMutex mapMutex;
+  std::vector<boost::shared_ptr<ParallelReadWorker> > workers;
+  for (int i = 0; i < threadCount; i++)
+  {
+    workers.push_back(
+      boost::shared_ptr<ParallelReadWorker>(
+        new ParallelReadWorker(
+          _getReaderClassName(), _url, _status, shards, nextShardIndex, shardMutex, map,
+          mapMutex)));
+    workers[i]->start();
+  }
+
+  QString error;
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i]->wait();
+    if (error.isEmpty())
+    {
+      error = workers[i]->getError();
+    }
+  }
+  if (!error.isEmpty())
+  {
+    throw HootException(error);
+  }
+
+  LOG_VARD(map->getNodes().size());
+  LOG_VARD(map->getWays().size());
+  LOG_VARD(map->getRelations().size());
+}
+
 boost::shared_ptr<Element> ApiDbReader::_getElementUsingIterator()
 {
   LOG_TRACE("Retrieving next element from iterator...");
@@ -110,6 +110,8 @@ protected:
   bool _open;
   QString _email;
   bool _sortById;
+  //the url passed to open; used to open sibling connections for the parallel read
+  QString _url;
 
   Tgs::BigMap<long, long> _nodeIdMap;
   Tgs::BigMap<long, long> _relationIdMap;
@@ -145,10 +147,38 @@ protected:
   static bool _isValidBounds(const geos::geom::Envelope& bounds);
   bool _hasBounds();
 
+  /**
+   * Returns true when this reader can service the partitioned parallel read
+   * (api.db.reader.read.threads); requires ranged selects on the backing database and a factory
+   * registered reader class name from _getReaderClassName.
+   */
+  virtual bool _supportsParallelRead() const { return false; }
+
+  /**
+   * The factory class name used to construct sibling readers for parallel read shards; empty by
+   * default, which disables the parallel read.
+   */
+  virtual std::string _getReaderClassName() const { return ""; }
+
 private:
 
+  class ParallelReadWorker;
+  friend class ParallelReadWorker;
+
   void _read(OsmMapPtr map, const ElementType& elementType);
 
+  /**
+   * Reads the elements of the given type with ids in [minId, maxId] into the map; used by the
+   * parallel read workers, where each worker owns its own database connection.
+   */
+  void _readRange(OsmMapPtr map, const ElementType& elementType, long minId, long maxId);
+
+  /**
+   * Splits each element type's id range into shards and reads them on parallel worker threads,
+   * each with its own connection; see api.db.reader.read.threads.
+   */
+  void _readParallel(OsmMapPtr map, int threadCount);
+
   boost::shared_ptr<Element> _getElementUsingIterator();
 
   /**
@@ -0,0 +1,255 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "DeclarativeTranslator.h"
+
+// hoot
+#include <hoot/core/io/ScriptTranslatorFactory.h>
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QStringList>
+#include <QTextStream>
+
+using namespace std;
+
+namespace hoot
+{
+
+HOOT_FACTORY_REGISTER(ScriptTranslator, DeclarativeTranslator)
+
+DeclarativeTranslator::DeclarativeTranslator()
+{
+}
+
+DeclarativeTranslator::~DeclarativeTranslator()
+{
+  close();
+}
+
+const QString DeclarativeTranslator::getLayerNameFilter()
+{
+  if (!_initialized)
+  {
+    _init();
+    _initialized = true;
+  }
+
+  if (_layerFilter.isEmpty())
+  {
+    return ScriptTranslator::getLayerNameFilter();
+  }
+  return _layerFilter;
+}
+
+bool DeclarativeTranslator::isValidScript()
+{
+  QFileInfo info(_scriptPath);
+  if (_scriptPath.endsWith(".rules", Qt::CaseInsensitive) == false || info.exists() == false)
+  {
+    return false;
+  }
+
+  if (!_initialized)
+  {
+    try
+    {
+      _init();
+      _initialized = true;
+    }
+    catch (const HootException& e)
+    {
+      LOG_ERROR("Error parsing rule file: " + e.getWhat());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DeclarativeTranslator::isThreadSafe()
+{
+  if (!_initialized)
+  {
+    _init();
+    _initialized = true;
+  }
+
+  if (_fallback.get() != 0)
+  {
+    return _fallback->isThreadSafe();
+  }
+  return true;
+}
+
+void DeclarativeTranslator::_init()
+{
+  LOG_DEBUG("Loading rule file: " << _scriptPath);
+  _parseRuleFile();
+
+  if (_fallbackColumns.isEmpty() == false && _fallbackScript.isEmpty())
+  {
+    throw HootException("fallback-when-unmatched requires a fallback directive. (" + _scriptPath +
+      ")");
+  }
+  if (_fallbackScript.isEmpty() == false)
+  {
+    _fallback.reset(ScriptTranslatorFactory::getInstance().createTranslator(_fallbackScript));
+    _fallback->setErrorTreatment(_strict);
+  }
+}
+
+void DeclarativeTranslator::_finalize()
+{
+  if (_fallback.get() != 0)
+  {
+    _fallback->close();
+    _fallback.reset();
+  }
+  _copyRules.clear();
+  _matchRules.clear();
+  _constantTags.clear();
+  _layerFilter.clear();
+  _fallbackScript.clear();
+  _fallbackColumns.clear();
+}
+
+void DeclarativeTranslator::_parseRuleFile()
+{
+  QFile fp(_scriptPath);
+  if (fp.open(QFile::ReadOnly) == false)
+  {
+    throw HootException("Error opening rule file: " + _scriptPath);
+  }
+  QTextStream ts(&fp);
+
+  int lineNumber = 0;
+  while (ts.atEnd() == false)
+  {
+    lineNumber++;
+    QString line = ts.readLine().trimmed();
+    if (line.isEmpty() || line.startsWith("#"))
+    {
+      continue;
+    }
+
+    QStringList parts = line.split(QRegExp("\\s+"));
+    const QString directive = parts[0];
+
+    if (directive == "layer" && parts.size() == 2)
+    {
+      _layerFilter = parts[1];
+    }
+    else if (directive == "copy" && parts.size() == 3)
+    {
+      _copyRules[parts[1]] = parts[2];
+    }
+    else if (directive == "match" && parts.size() == 4)
+    {
+      _matchRules[parts[1]][parts[2]].addTags(_parseTagList(parts[3], lineNumber));
+    }
+    else if (directive == "always" && parts.size() == 2)
+    {
+      _constantTags.addTags(_parseTagList(parts[1], lineNumber));
+    }
+    else if (directive == "fallback" && parts.size() == 2)
+    {
+      _fallbackScript = parts[1];
+    }
+    else if (directive == "fallback-when-unmatched" && parts.size() == 2)
+    {
+      _fallbackColumns.insert(parts[1]);
+    }
+    else
+    {
+      throw HootException(QString("Unrecognized rule on line %1 of %2: %3")
+        .arg(lineNumber).arg(_scriptPath).arg(line));
+    }
+  }
+}
+
+Tags DeclarativeTranslator::_parseTagList(const QString& s, int lineNumber) const
+{
+  Tags result;
+  QStringList kvps = s.split(";", QString::SkipEmptyParts);
+  for (int i = 0; i < kvps.size(); i++)
+  {
+    const int eq = kvps[i].indexOf("=");
+    if (eq < 1)
+    {
+      throw HootException(QString("Expected k=v on line %1 of %2: %3")
+        .arg(lineNumber).arg(_scriptPath).arg(s));
+    }
+    result.set(kvps[i].left(eq), kvps[i].mid(eq + 1));
+  }
+  return result;
+}
+
+void DeclarativeTranslator::_translateToOsm(Tags& tags, const char* layerName,
+  const char* geomType)
+{
+  // rows whose guarded columns hit values the rules don't know get the full script treatment.
+  for (QSet<QString>::const_iterator it = _fallbackColumns.begin(); it != _fallbackColumns.end();
+       ++it)
+  {
+    const QString v = tags.get(*it);
+    if (v.isEmpty() == false && _matchRules.value(*it).contains(v) == false)
+    {
+      _fallback->translateToOsm(tags, layerName, geomType);
+      return;
+    }
+  }
+
+  Tags result;
+  for (Tags::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    QHash<QString, QString>::const_iterator copy = _copyRules.find(it.key());
+    if (copy != _copyRules.end() && it.value().isEmpty() == false)
+    {
+      result.set(copy.value(), _saveMemory(it.value()));
+    }
+
+    QHash<QString, QHash<QString, Tags> >::const_iterator match = _matchRules.find(it.key());
+    if (match != _matchRules.end())
+    {
+      const Tags toAdd = match.value().value(it.value());
+      for (Tags::const_iterator jt = toAdd.begin(); jt != toAdd.end(); ++jt)
+      {
+        // the rule tables already share their strings; _saveMemory isn't needed here.
+        result.set(jt.key(), jt.value());
+      }
+    }
+  }
+  result.addTags(_constantTags);
+
+  tags = result;
+}
+
+}
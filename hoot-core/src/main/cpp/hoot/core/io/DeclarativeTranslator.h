@@ -0,0 +1,111 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef DECLARATIVETRANSLATOR_H
+#define DECLARATIVETRANSLATOR_H
+
+// hoot
+#include <hoot/core/elements/Tags.h>
+#include <hoot/core/io/ScriptTranslator.h>
+
+// Qt
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+namespace hoot
+{
+
+/**
+ * Translates attributes using a declarative rule file (*.rules) executed natively. Most OGR
+ * translations are mechanical column to tag mappings; running those without entering a script
+ * engine per feature makes imports substantially faster. Rows needing real logic can be handed
+ * to a scripted translator via the fallback directives.
+ *
+ * The rule file is line oriented, one directive per line, # starts a comment:
+ *
+ *   layer <regexp>                     layer name filter (optional, defaults to ".")
+ *   copy <column> <tag>                copies the column value into the tag when non-empty
+ *   match <column> <value> <k=v[;k=v]> adds the tags when the column has the given value
+ *   always <k=v[;k=v]>                 tags added to every translated feature
+ *   fallback <script>                  scripted translator for rows the rules can't handle
+ *   fallback-when-unmatched <column>   delegate rows whose value for the column has no match
+ *                                      rule (may repeat; requires fallback)
+ *
+ * Columns and values in match rules can't contain whitespace; that covers the code list style
+ * attributes these rules are meant for.
+ */
+class DeclarativeTranslator : public ScriptTranslator
+{
+public:
+
+  static std::string className() { return "hoot::DeclarativeTranslator"; }
+
+  DeclarativeTranslator();
+
+  virtual ~DeclarativeTranslator();
+
+  virtual const QString getLayerNameFilter();
+
+  virtual bool isValidScript();
+
+  /**
+   * Rule tables are immutable after _init, so independent instances may run on separate threads
+   * unless a scripted fallback is configured.
+   */
+  virtual bool isThreadSafe();
+
+  /// before the script engines; isValidScript only accepts .rules files.
+  virtual int order() const { return -10; }
+
+protected:
+
+  virtual void _init();
+
+  virtual void _finalize();
+
+  virtual void _translateToOsm(Tags& tags, const char* layerName, const char* geomType);
+
+private:
+
+  /// column -> tag key
+  QHash<QString, QString> _copyRules;
+  /// column -> attribute value -> tags to add
+  QHash<QString, QHash<QString, Tags> > _matchRules;
+  Tags _constantTags;
+  QString _layerFilter;
+  QString _fallbackScript;
+  QSet<QString> _fallbackColumns;
+  ScriptTranslatorPtr _fallback;
+
+  void _parseRuleFile();
+
+  Tags _parseTagList(const QString& s, int lineNumber) const;
+};
+
+}
+
+#endif // DECLARATIVETRANSLATOR_H
@@ -0,0 +1,343 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#include <hoot/core/elements/Element.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QMutexLocker>
+
+// Standard
+#include <algorithm>
+
+#include "ElementCacheStripedLRU.h"
+
+namespace hoot
+{
+
+ElementCacheStripedLRU::ElementCacheStripedLRU(const unsigned long maxNodeCount,
+                                               const unsigned long maxWayCount,
+                                               const unsigned long maxRelationCount,
+                                               const unsigned int stripeCount) :
+  _maxNodeCount(maxNodeCount),
+  _maxWayCount(maxWayCount),
+  _maxRelationCount(maxRelationCount),
+  _projection(),
+  _nodeStripe(0),
+  _wayStripe(0),
+  _relationStripe(0)
+{
+  unsigned int stripes = stripeCount;
+  if (stripes == 0)
+  {
+    stripes = (unsigned int)std::max(1, ConfigOptions().getElementCacheStripes());
+  }
+
+  //divide the per type capacity evenly across the stripes, never dropping a stripe to zero
+  const unsigned long nodesPerStripe = std::max(1ul, maxNodeCount / stripes);
+  const unsigned long waysPerStripe = std::max(1ul, maxWayCount / stripes);
+  const unsigned long relationsPerStripe = std::max(1ul, maxRelationCount / stripes);
+
+  for (unsigned int i = 0; i < stripes; i++)
+  {
+    _stripes.push_back(
+      boost::shared_ptr<ElementCacheLRU>(
+        new ElementCacheLRU(nodesPerStripe, waysPerStripe, relationsPerStripe)));
+    _stripeMutexes.push_back(boost::shared_ptr<QMutex>(new QMutex()));
+  }
+
+  LOG_TRACE(
+    "New striped LRU cache created with " << stripes << " stripes, " << nodesPerStripe <<
+    " max nodes, " << waysPerStripe << " max ways and " << relationsPerStripe <<
+    " max relations per stripe.");
+}
+
+size_t ElementCacheStripedLRU::_stripeFor(long id) const
+{
+  //Fibonacci hash spreads both the positive ids of source data and the dense negative ids hoot
+  //assigns to new elements evenly across the stripes.
+  return (size_t)(((unsigned long long)id * 11400714819323198485ull) % _stripes.size());
+}
+
+bool ElementCacheStripedLRU::isEmpty() const
+{
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    if (!_stripes[i]->isEmpty())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+unsigned long ElementCacheStripedLRU::size() const
+{
+  unsigned long total = 0;
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    total += _stripes[i]->size();
+  }
+  return total;
+}
+
+unsigned long ElementCacheStripedLRU::typeCount(const ElementType::Type typeToCount) const
+{
+  unsigned long total = 0;
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    total += _stripes[i]->typeCount(typeToCount);
+  }
+  return total;
+}
+
+void ElementCacheStripedLRU::addElement(ConstElementPtr& newElement)
+{
+  const size_t stripe = _stripeFor(newElement->getId());
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  _stripes[stripe]->addElement(newElement);
+}
+
+void ElementCacheStripedLRU::resetElementIterators()
+{
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    _stripes[i]->resetElementIterators();
+  }
+  _nodeStripe = 0;
+  _wayStripe = 0;
+  _relationStripe = 0;
+}
+
+ConstNodePtr ElementCacheStripedLRU::getNextNode()
+{
+  while (_nodeStripe < _stripes.size())
+  {
+    QMutexLocker lock(_stripeMutexes[_nodeStripe].get());
+    ConstNodePtr result = _stripes[_nodeStripe]->getNextNode();
+    if (result.get())
+    {
+      return result;
+    }
+    _nodeStripe++;
+  }
+  return ConstNodePtr();
+}
+
+ConstWayPtr ElementCacheStripedLRU::getNextWay()
+{
+  while (_wayStripe < _stripes.size())
+  {
+    QMutexLocker lock(_stripeMutexes[_wayStripe].get());
+    ConstWayPtr result = _stripes[_wayStripe]->getNextWay();
+    if (result.get())
+    {
+      return result;
+    }
+    _wayStripe++;
+  }
+  return ConstWayPtr();
+}
+
+ConstRelationPtr ElementCacheStripedLRU::getNextRelation()
+{
+  while (_relationStripe < _stripes.size())
+  {
+    QMutexLocker lock(_stripeMutexes[_relationStripe].get());
+    ConstRelationPtr result = _stripes[_relationStripe]->getNextRelation();
+    if (result.get())
+    {
+      return result;
+    }
+    _relationStripe++;
+  }
+  return ConstRelationPtr();
+}
+
+void ElementCacheStripedLRU::close()
+{
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    _stripes[i]->close();
+  }
+  _nodeStripe = 0;
+  _wayStripe = 0;
+  _relationStripe = 0;
+}
+
+bool ElementCacheStripedLRU::hasMoreElements()
+{
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    if (_stripes[i]->hasMoreElements())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+ElementPtr ElementCacheStripedLRU::readNextElement()
+{
+  ElementPtr returnElement;
+
+  ConstNodePtr nextNode = getNextNode();
+  if (nextNode.get())
+  {
+    returnElement.reset(nextNode->clone());
+    return returnElement;
+  }
+  ConstWayPtr nextWay = getNextWay();
+  if (nextWay.get())
+  {
+    returnElement.reset(nextWay->clone());
+    return returnElement;
+  }
+  ConstRelationPtr nextRelation = getNextRelation();
+  if (nextRelation.get())
+  {
+    returnElement.reset(nextRelation->clone());
+  }
+
+  return returnElement;
+}
+
+void ElementCacheStripedLRU::writeElement(ElementPtr& element)
+{
+  ConstElementPtr el = element;
+  addElement(el);
+}
+
+boost::shared_ptr<OGRSpatialReference> ElementCacheStripedLRU::getProjection() const
+{
+  return _projection;
+}
+
+bool ElementCacheStripedLRU::containsElement(const ElementId& eid) const
+{
+  const size_t stripe = _stripeFor(eid.getId());
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->containsElement(eid);
+}
+
+ConstElementPtr ElementCacheStripedLRU::getElement(const ElementId& eid) const
+{
+  const size_t stripe = _stripeFor(eid.getId());
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->getElement(eid);
+}
+
+const ConstNodePtr ElementCacheStripedLRU::getNode(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  const ElementCacheLRU& stripeCache = *_stripes[stripe];
+  return stripeCache.getNode(id);
+}
+
+const NodePtr ElementCacheStripedLRU::getNode(long id)
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->getNode(id);
+}
+
+const ConstRelationPtr ElementCacheStripedLRU::getRelation(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  const ElementCacheLRU& stripeCache = *_stripes[stripe];
+  return stripeCache.getRelation(id);
+}
+
+const RelationPtr ElementCacheStripedLRU::getRelation(long id)
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->getRelation(id);
+}
+
+const ConstWayPtr ElementCacheStripedLRU::getWay(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  const ElementCacheLRU& stripeCache = *_stripes[stripe];
+  return stripeCache.getWay(id);
+}
+
+const WayPtr ElementCacheStripedLRU::getWay(long id)
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->getWay(id);
+}
+
+bool ElementCacheStripedLRU::containsNode(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->containsNode(id);
+}
+
+bool ElementCacheStripedLRU::containsWay(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->containsWay(id);
+}
+
+bool ElementCacheStripedLRU::containsRelation(long id) const
+{
+  const size_t stripe = _stripeFor(id);
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  return _stripes[stripe]->containsRelation(id);
+}
+
+void ElementCacheStripedLRU::removeElement(const ElementId& eid)
+{
+  const size_t stripe = _stripeFor(eid.getId());
+  QMutexLocker lock(_stripeMutexes[stripe].get());
+  _stripes[stripe]->removeElement(eid);
+}
+
+void ElementCacheStripedLRU::removeElements(const ElementType::Type type)
+{
+  for (size_t i = 0; i < _stripes.size(); i++)
+  {
+    QMutexLocker lock(_stripeMutexes[i].get());
+    _stripes[i]->removeElements(type);
+  }
+}
+
+}
@@ -0,0 +1,165 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef ELEMENTCACHESTRIPEDLRU_H
+#define ELEMENTCACHESTRIPEDLRU_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "ElementCache.h"
+#include "ElementCacheLRU.h"
+
+// Qt
+#include <QMutex>
+
+namespace hoot
+{
+
+/**
+ * A thread safe LRU element cache intended to be shared between the threads of a parallel
+ * streaming pipeline, so hot elements (typically nodes) are cached once instead of once per
+ * thread.
+ *
+ * The cache is divided into stripes by element ID, each stripe being an independent
+ * ElementCacheLRU guarded by its own mutex. Threads working on different stripes never contend,
+ * and the per stripe eviction scan touches only a fraction of the cache. Per type capacity is
+ * specified for the cache as a whole and divided evenly across the stripes, so eviction pressure
+ * on one stripe never pushes out elements held by another.
+ *
+ * Unlike ElementCacheLRU, the iteration methods (getNextNode, etc.) return elements grouped by
+ * stripe rather than in globally ascending ID order, and iteration itself is not thread safe; it
+ * is intended for a single threaded drain after the parallel phase completes.
+ */
+class ElementCacheStripedLRU : public ElementCache
+{
+
+public:
+
+  /**
+   * @brief ElementCacheStripedLRU
+   * @param maxNodeCount Total size of node cache before items start being replaced.
+   * @param maxWayCount Total size of ways cache before items start being replaced.
+   * @param maxRelationCount Total size of relation cache before items start being replaced.
+   * @param stripeCount Number of independently locked stripes the cache is divided into; defaults
+   *    to element.cache.stripes when zero is passed.
+   */
+  ElementCacheStripedLRU(const unsigned long maxNodeCount,
+                         const unsigned long maxWayCount,
+                         const unsigned long maxRelationCount,
+                         const unsigned int stripeCount = 0);
+
+  virtual ~ElementCacheStripedLRU() { }
+
+  virtual bool isEmpty() const;
+
+  virtual unsigned long size() const;
+
+  virtual unsigned long typeCount(const ElementType::Type typeToCount) const;
+
+  virtual void addElement(ConstElementPtr& newElement);
+
+  virtual void resetElementIterators();
+
+  virtual ConstNodePtr getNextNode();
+
+  virtual ConstWayPtr getNextWay();
+
+  virtual ConstRelationPtr getNextRelation();
+
+  // Functions for ElementInputStream
+  virtual void close();
+  virtual bool hasMoreElements();
+
+  virtual ElementPtr readNextElement();
+
+  // Functions for ElementOutputStream
+  virtual void writeElement(ElementPtr& element);
+
+  // Functions for ElementProvider
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
+
+  virtual bool containsElement(const ElementId& eid) const;
+
+  virtual ConstElementPtr getElement(const ElementId& id) const;
+
+  virtual const ConstNodePtr getNode(long id) const;
+
+  virtual const NodePtr getNode(long id);
+
+  virtual const ConstRelationPtr getRelation(long id) const;
+
+  virtual const RelationPtr getRelation(long id);
+
+  virtual const ConstWayPtr getWay(long id) const;
+
+  virtual const WayPtr getWay(long id);
+
+  virtual bool containsNode(long id) const;
+
+  virtual bool containsRelation(long id) const;
+
+  virtual bool containsWay(long id) const;
+
+  // Cache-specific items
+  virtual void removeElement(const ElementId& eid);
+
+  virtual void removeElements(const ElementType::Type type);
+
+  virtual unsigned long getNodeCacheSize() { return _maxNodeCount; }
+
+  virtual unsigned long getWayCacheSize() { return _maxWayCount; }
+
+  virtual unsigned long getRelationCacheSize() { return _maxRelationCount; }
+
+  unsigned int getStripeCount() const { return (unsigned int)_stripes.size(); }
+
+private:
+
+  unsigned long _maxNodeCount;
+  unsigned long _maxWayCount;
+  unsigned long _maxRelationCount;
+
+  boost::shared_ptr<OGRSpatialReference> _projection;
+
+  std::vector<boost::shared_ptr<ElementCacheLRU> > _stripes;
+  //QMutex is noncopyable, so the mutexes are held by pointer
+  std::vector<boost::shared_ptr<QMutex> > _stripeMutexes;
+
+  //iteration state; only valid while no other thread is mutating the cache
+  size_t _nodeStripe;
+  size_t _wayStripe;
+  size_t _relationStripe;
+
+  size_t _stripeFor(long id) const;
+};
+
+typedef boost::shared_ptr<ElementCacheStripedLRU> ElementCacheStripedLRUPtr;
+
+}
+
+#endif // ELEMENTCACHESTRIPEDLRU_H
@@ -46,6 +46,9 @@ void ElementComparer::_removeTagsNotImportantForComparison(Tags& tags) const
   tags.remove(MetadataTags::HootStatus());
   //TODO: not sure where "status" is coming from...should be "hoot:status"...bug somewhere?
   tags.remove("status");
+  //the hash is compared separately (and covers the info tags), so differing hash tags shouldn't
+  //also register as a tag change
+  tags.remove(MetadataTags::HootHash());
   //this is ok b/c we have the actual id to compare to, but it should still probably be fixed to
   //carry along the hoot:id tag for consistency's sake when that is desired
   tags.remove(MetadataTags::HootId());
@@ -59,9 +62,21 @@ bool ElementComparer::isSame(ElementPtr e1, ElementPtr e2) const
 
   assert(e1->getElementType() == e2->getElementType());
 
-  //only nodes have been converted over to use hash comparisons so far
+  //only nodes have been converted over to use hash comparisons exclusively so far
   if (e1->getElementType() != ElementType::Node)
   {
+    //fast path: when both elements already carry a hash (e.g. computed by CalculateHashVisitor2
+    //during changeset derivation), identical hashes mean identical content and the full
+    //tag/geometry comparison below can be skipped; differing or missing hashes fall through to
+    //the full comparison
+    const QString hash1 = e1->getTags().value(MetadataTags::HootHash());
+    if (!hash1.isEmpty() && e1->getElementId() == e2->getElementId() &&
+        e1->getVersion() == e2->getVersion() &&
+        hash1 == e2->getTags().value(MetadataTags::HootHash()))
+    {
+      return true;
+    }
+
     //create modified copies of the tags for comparing, as we don't care if some tags are identical
     Tags tags1 = e1->getTags();
     _removeTagsNotImportantForComparison(tags1);
@@ -0,0 +1,254 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ElementCropInputStream.h"
+
+// GEOS
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+
+// Hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Relation.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/util/GeometryUtils.h>
+#include <hoot/core/util/Log.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+ElementCropInputStream::ElementCropInputStream(const ElementInputStreamPtr& elementSource,
+  const Envelope& envelope) :
+_elementSource(elementSource),
+_envelope(envelope),
+_invert(false),
+_gridSize(0)
+{
+}
+
+ElementCropInputStream::ElementCropInputStream(const ElementInputStreamPtr& elementSource,
+  const boost::shared_ptr<const Geometry>& g, bool invert) :
+_elementSource(elementSource),
+_envelopeG(g),
+_invert(invert),
+_gridSize(0)
+{
+  _prepared = GeometryUtils::prepareGeometry(_envelopeG);
+  _buildGrid();
+}
+
+ElementCropInputStream::~ElementCropInputStream()
+{
+}
+
+void ElementCropInputStream::_buildGrid()
+{
+  _gridEnvelope = *_envelopeG->getEnvelopeInternal();
+  _gridSize = 64;
+  _cellWidth = _gridEnvelope.getWidth() / (double)_gridSize;
+  _cellHeight = _gridEnvelope.getHeight() / (double)_gridSize;
+
+  // a degenerate geometry (e.g. a point or a vertical line) has no area to grid; fall back to
+  // testing every node against the prepared geometry.
+  if (_cellWidth <= 0.0 || _cellHeight <= 0.0)
+  {
+    _gridSize = 0;
+    return;
+  }
+
+  _cells.resize((size_t)_gridSize * (size_t)_gridSize, Boundary);
+  for (int cy = 0; cy < _gridSize; cy++)
+  {
+    for (int cx = 0; cx < _gridSize; cx++)
+    {
+      Envelope cellE(
+        _gridEnvelope.getMinX() + (double)cx * _cellWidth,
+        _gridEnvelope.getMinX() + (double)(cx + 1) * _cellWidth,
+        _gridEnvelope.getMinY() + (double)cy * _cellHeight,
+        _gridEnvelope.getMinY() + (double)(cy + 1) * _cellHeight);
+      auto_ptr<Geometry> cellG(GeometryFactory::getDefaultInstance()->toGeometry(&cellE));
+
+      char state;
+      if (_prepared->containsProperly(cellG.get()))
+      {
+        state = Inside;
+      }
+      else if (_prepared->intersects(cellG.get()) == false)
+      {
+        state = Outside;
+      }
+      else
+      {
+        state = Boundary;
+      }
+      _cells[(size_t)cy * (size_t)_gridSize + (size_t)cx] = state;
+    }
+  }
+}
+
+bool ElementCropInputStream::_contains(double x, double y) const
+{
+  bool inside;
+
+  if (_envelope.isNull() == false)
+  {
+    inside = _envelope.covers(Coordinate(x, y));
+  }
+  else if (_gridEnvelope.covers(Coordinate(x, y)) == false)
+  {
+    inside = false;
+  }
+  else
+  {
+    char state = Boundary;
+    if (_gridSize > 0)
+    {
+      int cx = (int)((x - _gridEnvelope.getMinX()) / _cellWidth);
+      int cy = (int)((y - _gridEnvelope.getMinY()) / _cellHeight);
+      cx = std::min(std::max(cx, 0), _gridSize - 1);
+      cy = std::min(std::max(cy, 0), _gridSize - 1);
+      state = _cells[(size_t)cy * (size_t)_gridSize + (size_t)cx];
+    }
+
+    if (state == Inside)
+    {
+      inside = true;
+    }
+    else if (state == Outside)
+    {
+      inside = false;
+    }
+    else
+    {
+      // the node landed in a cell the crop polygon's boundary passes through; do the real test.
+      auto_ptr<Point> p(GeometryFactory::getDefaultInstance()->createPoint(Coordinate(x, y)));
+      inside = _prepared->intersects(p.get());
+    }
+  }
+
+  if (_invert)
+  {
+    inside = !inside;
+  }
+  return inside;
+}
+
+boost::shared_ptr<OGRSpatialReference> ElementCropInputStream::getProjection() const
+{
+  return _elementSource->getProjection();
+}
+
+bool ElementCropInputStream::_keep(const ElementPtr& e)
+{
+  if (e->getElementType() == ElementType::Node)
+  {
+    NodePtr n = boost::dynamic_pointer_cast<Node>(e);
+    if (_contains(n->getX(), n->getY()))
+    {
+      _keptNodes.insert(n->getId());
+      return true;
+    }
+    return false;
+  }
+  else if (e->getElementType() == ElementType::Way)
+  {
+    WayPtr w = boost::dynamic_pointer_cast<Way>(e);
+    const vector<long>& nids = w->getNodeIds();
+    vector<long> kept;
+    kept.reserve(nids.size());
+    for (size_t i = 0; i < nids.size(); i++)
+    {
+      if (_keptNodes.find(nids[i]) != _keptNodes.end())
+      {
+        kept.push_back(nids[i]);
+      }
+    }
+    if (kept.empty())
+    {
+      return false;
+    }
+    if (kept.size() != nids.size())
+    {
+      w->setNodesViaSwap(kept);
+    }
+    _keptWays.insert(w->getId());
+    return true;
+  }
+  else
+  {
+    RelationPtr r = boost::dynamic_pointer_cast<Relation>(e);
+    // copy the member list since we may remove entries while iterating.
+    const vector<RelationData::Entry> members = r->getMembers();
+    for (size_t i = 0; i < members.size(); i++)
+    {
+      const ElementId& eid = members[i].getElementId();
+      bool memberKept;
+      switch (eid.getType().getEnum())
+      {
+      case ElementType::Node:
+        memberKept = _keptNodes.find(eid.getId()) != _keptNodes.end();
+        break;
+      case ElementType::Way:
+        memberKept = _keptWays.find(eid.getId()) != _keptWays.end();
+        break;
+      default:
+        memberKept = _keptRelations.find(eid.getId()) != _keptRelations.end();
+        break;
+      }
+      if (memberKept == false)
+      {
+        r->removeElement(eid);
+      }
+    }
+    if (r->getMembers().empty())
+    {
+      return false;
+    }
+    _keptRelations.insert(r->getId());
+    return true;
+  }
+}
+
+ElementPtr ElementCropInputStream::readNextElement()
+{
+  while (hasMoreElements())
+  {
+    ElementPtr e = _elementSource->readNextElement();
+    if (e.get() != 0 && _keep(e))
+    {
+      return e;
+    }
+  }
+
+  return ElementPtr();
+}
+
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef ELEMENTCROPINPUTSTREAM_H
+#define ELEMENTCROPINPUTSTREAM_H
+
+// GEOS
+#include <geos/geom/Envelope.h>
+
+namespace geos
+{
+  namespace geom
+  {
+    class Geometry;
+    namespace prep
+    {
+      class PreparedGeometry;
+    }
+  }
+}
+
+// Hoot
+#include <hoot/core/io/ElementInputStream.h>
+#include <hoot/core/elements/Element.h>
+
+// TGS
+#include <tgs/HashMap.h>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Crops a stream of elements to a region without ever holding the map in memory. MapCropper
+ * gives an exact crop (ways are cut at the region boundary), but requires the whole input in
+ * RAM, which makes it unusable on planet scale files. This stream instead keeps only the ids of
+ * the elements it has passed through: a node is kept if it falls in the region, a way is kept
+ * with the subset of its nodes that were kept, and a relation is kept with the subset of its
+ * members that were kept. Ways crossing the boundary are therefore truncated at the last kept
+ * node rather than cut exactly at the region edge -- use MapCropper when an exact cut matters
+ * and the input fits in memory.
+ *
+ * The input must be ordered nodes, then ways, then relations (the standard OSM file ordering,
+ * and what ElementSorter produces). Relation members that appear later in the stream than the
+ * relation referencing them are dropped.
+ *
+ * For a rectangular region every node test is a plain envelope comparison and GEOS is never
+ * touched. For a polygon region the polygon's bounding box is divided into a grid of cells,
+ * each classified once up front as wholly inside, wholly outside or on the boundary using a
+ * prepared geometry; only nodes landing in boundary cells pay for a GEOS point-in-polygon test.
+ */
+class ElementCropInputStream : public ElementInputStream
+{
+public:
+
+  /**
+   * Keeps the elements within the envelope.
+   */
+  ElementCropInputStream(const ElementInputStreamPtr& elementSource,
+    const geos::geom::Envelope& envelope);
+
+  /**
+   * Keeps the elements within the geometry, or outside it if invert is set.
+   */
+  ElementCropInputStream(const ElementInputStreamPtr& elementSource,
+    const boost::shared_ptr<const geos::geom::Geometry>& g, bool invert = false);
+
+  virtual ~ElementCropInputStream();
+
+  virtual void close() { _elementSource->close(); }
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
+
+  virtual bool hasMoreElements() { return _elementSource->hasMoreElements(); }
+
+  /**
+   * Returns the next element that falls (at least partially) within the crop region, or an
+   * empty pointer if the source is exhausted first. Ways and relations are modified in place to
+   * drop references to elements that were not kept.
+   */
+  virtual ElementPtr readNextElement();
+
+private:
+
+  enum CellState
+  {
+    Outside = 0,
+    Inside = 1,
+    Boundary = 2
+  };
+
+  ElementInputStreamPtr _elementSource;
+  geos::geom::Envelope _envelope;
+  boost::shared_ptr<const geos::geom::Geometry> _envelopeG;
+  boost::shared_ptr<const geos::geom::prep::PreparedGeometry> _prepared;
+  bool _invert;
+
+  /// grid of cell classifications over _envelopeG's bounding box (polygon crops only)
+  geos::geom::Envelope _gridEnvelope;
+  int _gridSize;
+  double _cellWidth;
+  double _cellHeight;
+  std::vector<char> _cells;
+
+  /// ids of the elements that have been passed through so far
+  HashSet<long> _keptNodes;
+  HashSet<long> _keptWays;
+  HashSet<long> _keptRelations;
+
+  /**
+   * Classifies each grid cell against the crop polygon once so the per node test is usually a
+   * lookup rather than a GEOS call.
+   */
+  void _buildGrid();
+
+  /**
+   * Returns true if the point is inside the crop region, honoring _invert.
+   */
+  bool _contains(double x, double y) const;
+
+  /**
+   * Returns true if e should be passed downstream; filters way nodes and relation members as a
+   * side effect.
+   */
+  bool _keep(const ElementPtr& e);
+};
+
+}
+
+#endif // ELEMENTCROPINPUTSTREAM_H
@@ -0,0 +1,239 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ElementMergeInputStream.h"
+
+// hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Relation.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/util/HootException.h>
+
+namespace hoot
+{
+
+ElementMergeInputStream::ElementMergeInputStream(
+  const std::vector<ElementInputStreamPtr>& inputs) :
+  _nextNodeId(-1),
+  _nextWayId(-1),
+  _nextRelationId(-1)
+{
+  if (inputs.empty())
+  {
+    throw HootException("ElementMergeInputStream requires at least one input.");
+  }
+  _inputs.resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    _inputs[i].stream = inputs[i];
+    _advance(i);
+  }
+}
+
+ElementMergeInputStream::~ElementMergeInputStream()
+{
+  close();
+}
+
+boost::shared_ptr<OGRSpatialReference> ElementMergeInputStream::getProjection() const
+{
+  return _inputs[0].stream->getProjection();
+}
+
+void ElementMergeInputStream::close()
+{
+  for (size_t i = 0; i < _inputs.size(); i++)
+  {
+    if (_inputs[i].stream.get())
+    {
+      _inputs[i].stream->close();
+    }
+  }
+}
+
+bool ElementMergeInputStream::hasMoreElements()
+{
+  for (size_t i = 0; i < _inputs.size(); i++)
+  {
+    if (_inputs[i].head.get())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ElementMergeInputStream::_advance(size_t i)
+{
+  InputState& state = _inputs[i];
+  state.head.reset();
+  while (state.stream->hasMoreElements())
+  {
+    ElementPtr e = state.stream->readNextElement();
+    if (e.get())
+    {
+      state.head = e;
+      break;
+    }
+  }
+}
+
+int ElementMergeInputStream::_selectInput()
+{
+  int best = -1;
+  for (size_t i = 0; i < _inputs.size(); i++)
+  {
+    const ElementPtr& head = _inputs[i].head;
+    if (head.get() == 0)
+    {
+      continue;
+    }
+    if (best == -1)
+    {
+      best = (int)i;
+      continue;
+    }
+    const ElementPtr& bestHead = _inputs[best].head;
+    int t = head->getElementType().getEnum();
+    int bt = bestHead->getElementType().getEnum();
+    if (t < bt || (t == bt && head->getId() < bestHead->getId()))
+    {
+      best = (int)i;
+    }
+  }
+  return best;
+}
+
+long ElementMergeInputStream::_claimId(InputState& state, const ElementType& type, long id)
+{
+  QSet<long>* used;
+  QHash<long, long>* map;
+  long* next;
+  switch (type.getEnum())
+  {
+  case ElementType::Node:
+    used = &_usedNodeIds;
+    map = &state.nodeMap;
+    next = &_nextNodeId;
+    break;
+  case ElementType::Way:
+    used = &_usedWayIds;
+    map = &state.wayMap;
+    next = &_nextWayId;
+    break;
+  default:
+    used = &_usedRelationIds;
+    map = &state.relationMap;
+    next = &_nextRelationId;
+    break;
+  }
+
+  long result = id;
+  if (used->contains(id))
+  {
+    // ids from the inputs may be negative too, so walk the counter past any in use
+    while (used->contains(*next))
+    {
+      (*next)--;
+    }
+    result = (*next)--;
+    map->insert(id, result);
+  }
+  used->insert(result);
+  return result;
+}
+
+long ElementMergeInputStream::_resolveRef(const InputState& state, const ElementType& type,
+                                          long id) const
+{
+  switch (type.getEnum())
+  {
+  case ElementType::Node:
+    return state.nodeMap.value(id, id);
+  case ElementType::Way:
+    return state.wayMap.value(id, id);
+  default:
+    return state.relationMap.value(id, id);
+  }
+}
+
+ElementPtr ElementMergeInputStream::readNextElement()
+{
+  int i = _selectInput();
+  if (i == -1)
+  {
+    return ElementPtr();
+  }
+
+  InputState& state = _inputs[i];
+  ElementPtr e = state.head;
+  _advance(i);
+
+  long newId = _claimId(state, e->getElementType(), e->getId());
+  if (newId != e->getId())
+  {
+    e->setId(newId);
+  }
+
+  if (e->getElementType() == ElementType::Way)
+  {
+    WayPtr w = boost::dynamic_pointer_cast<Way>(e);
+    const std::vector<long>& nids = w->getNodeIds();
+    bool changed = false;
+    std::vector<long> remapped(nids.size());
+    for (size_t j = 0; j < nids.size(); j++)
+    {
+      remapped[j] = _resolveRef(state, ElementType::Node, nids[j]);
+      changed = changed || remapped[j] != nids[j];
+    }
+    if (changed)
+    {
+      w->setNodesViaSwap(remapped);
+    }
+  }
+  else if (e->getElementType() == ElementType::Relation)
+  {
+    RelationPtr r = boost::dynamic_pointer_cast<Relation>(e);
+    const std::vector<RelationData::Entry>& members = r->getMembers();
+    bool changed = false;
+    std::vector<RelationData::Entry> remapped(members.size());
+    for (size_t j = 0; j < members.size(); j++)
+    {
+      ElementId eid = members[j].getElementId();
+      long rid = _resolveRef(state, eid.getType(), eid.getId());
+      remapped[j] = RelationData::Entry(members[j].getRole(), ElementId(eid.getType(), rid));
+      changed = changed || rid != eid.getId();
+    }
+    if (changed)
+    {
+      r->setMembersViaSwap(remapped);
+    }
+  }
+
+  return e;
+}
+
+}
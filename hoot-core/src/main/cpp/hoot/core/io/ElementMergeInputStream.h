@@ -0,0 +1,123 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef ELEMENTMERGEINPUTSTREAM_H
+#define ELEMENTMERGEINPUTSTREAM_H
+
+// hoot
+#include <hoot/core/io/ElementInputStream.h>
+
+// Qt
+#include <QHash>
+#include <QSet>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * A k-way merge over multiple element input streams. Assuming each input emits elements in the
+ * usual OSM file order (nodes, then ways, then relations, each sorted by id), the merged stream
+ * is in the same order, so it can feed a streaming writer directly and merging any number of
+ * inputs runs in constant memory apart from the id bookkeeping below.
+ *
+ * Id conflicts are resolved on the fly: the first input to emit a given (type, id) keeps it, and
+ * later occurrences are remapped to unused negative ids. Way node references and relation members
+ * are rewritten through the owning input's remap table, which relies on the referenced elements
+ * appearing before their referrers (true for the file order above). Only conflicting ids are
+ * recorded per input, but the set of all seen ids is kept for conflict detection, so memory grows
+ * with the id count rather than the element data.
+ */
+class ElementMergeInputStream : public ElementInputStream
+{
+public:
+
+  ElementMergeInputStream(const std::vector<ElementInputStreamPtr>& inputs);
+
+  virtual ~ElementMergeInputStream();
+
+  /**
+   * Returns the projection of the first input. The caller is responsible for ensuring all inputs
+   * share a projection; streaming inputs are in WGS84 in practice.
+   */
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
+
+  virtual void close();
+
+  virtual bool hasMoreElements();
+
+  virtual ElementPtr readNextElement();
+
+private:
+
+  struct InputState
+  {
+    ElementInputStreamPtr stream;
+    ElementPtr head;
+    // original id -> remapped id, populated only for conflicting ids
+    QHash<long, long> nodeMap;
+    QHash<long, long> wayMap;
+    QHash<long, long> relationMap;
+  };
+
+  std::vector<InputState> _inputs;
+  QSet<long> _usedNodeIds;
+  QSet<long> _usedWayIds;
+  QSet<long> _usedRelationIds;
+  long _nextNodeId;
+  long _nextWayId;
+  long _nextRelationId;
+
+  /**
+   * Refills the head slot of input i from its stream; leaves it null when exhausted.
+   */
+  void _advance(size_t i);
+
+  /**
+   * Returns the index of the input whose head comes first in (type, id) order, or -1 when all
+   * inputs are exhausted. Ties go to the earlier input, so it keeps its id and the later input
+   * gets remapped.
+   */
+  int _selectInput();
+
+  /**
+   * Claims an output id for (type, id) from input i, remapping on conflict, and records the
+   * mapping so later references from the same input resolve consistently.
+   */
+  long _claimId(InputState& state, const ElementType& type, long id);
+
+  /**
+   * Resolves a reference from input i: remapped if this input's element was remapped, unchanged
+   * otherwise.
+   */
+  long _resolveRef(const InputState& state, const ElementType& type, long id) const;
+};
+
+}
+
+#endif // ELEMENTMERGEINPUTSTREAM_H
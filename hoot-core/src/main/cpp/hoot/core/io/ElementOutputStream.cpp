@@ -25,13 +25,197 @@
  * @copyright Copyright (C) 2015, 2017 DigitalGlobe (http://www.digitalglobe.com/)
  */
 
+#include <hoot/core/util/Cancellation.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
 #include "ElementInputStream.h"
 #include "ElementOutputStream.h"
 
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+// Standard
+#include <deque>
+#include <vector>
+
 namespace hoot
 {
 
+namespace // anonymous
+{
+
+// how many batches may sit between the reader and writer before the reader blocks. Enough to
+// ride out bursts on either side without holding a large chunk of the map in flight.
+const int MAX_QUEUED_BATCHES = 4;
+
+// how many elements the serial pump writes between cancellation checks. Large enough that the
+// check doesn't show up on the profile, small enough to keep cancellation responsive.
+const long CANCEL_CHECK_INTERVAL = 10000;
+
+/**
+ * A bounded queue of element batches shared by the producer (reader) thread and the consuming
+ * writer thread. Batches are swapped in and out rather than copied.
+ */
+class ElementBatchQueue
+{
+public:
+
+  typedef std::vector<ElementPtr> Batch;
+
+  ElementBatchQueue() :
+    _done(false),
+    _aborted(false)
+  {
+  }
+
+  /**
+   * Producer side; blocks while the queue is full. Leaves batch empty.
+   */
+  void push(Batch& batch)
+  {
+    QMutexLocker lock(&_mutex);
+    while ((int)_queue.size() >= MAX_QUEUED_BATCHES && !_aborted)
+    {
+      _notFull.wait(&_mutex);
+    }
+    if (_aborted)
+    {
+      batch.clear();
+      return;
+    }
+    _queue.push_back(Batch());
+    _queue.back().swap(batch);
+    _notEmpty.wakeOne();
+  }
+
+  /**
+   * Producer side; marks the stream exhausted, optionally with an error to rethrow on the
+   * consumer thread.
+   */
+  void finish(QString error = QString())
+  {
+    QMutexLocker lock(&_mutex);
+    _done = true;
+    _error = error;
+    _notEmpty.wakeAll();
+  }
+
+  /**
+   * Consumer side; blocks until a batch is available. Returns false once the producer has
+   * finished and the queue is drained. Rethrows any producer error.
+   */
+  bool pop(Batch& batch)
+  {
+    QMutexLocker lock(&_mutex);
+    while (_queue.empty() && !_done)
+    {
+      _notEmpty.wait(&_mutex);
+    }
+    if (_done && !_error.isEmpty())
+    {
+      throw HootException(_error);
+    }
+    if (!_queue.empty())
+    {
+      batch.swap(_queue.front());
+      _queue.pop_front();
+      _notFull.wakeOne();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Consumer side; unblocks the producer and discards anything it pushes afterwards. Used when
+   * the writer fails so the reader thread can wind down.
+   */
+  void abort()
+  {
+    QMutexLocker lock(&_mutex);
+    _aborted = true;
+    _notFull.wakeAll();
+  }
+
+  bool isAborted()
+  {
+    QMutexLocker lock(&_mutex);
+    return _aborted;
+  }
+
+private:
+
+  QMutex _mutex;
+  QWaitCondition _notFull;
+  QWaitCondition _notEmpty;
+  std::deque<Batch> _queue;
+  bool _done;
+  bool _aborted;
+  QString _error;
+};
+
+/**
+ * Reads batches of elements off an ElementInputStream and pushes them into the queue. Any reader
+ * exception is carried across to the consumer thread.
+ */
+class ElementProducerThread : public QThread
+{
+public:
+
+  ElementProducerThread(ElementInputStream& eis, ElementBatchQueue& queue, int batchSize) :
+    _eis(eis),
+    _queue(queue),
+    _batchSize(batchSize)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      ElementBatchQueue::Batch batch;
+      batch.reserve(_batchSize);
+      while (_eis.hasMoreElements() && !_queue.isAborted())
+      {
+        ElementPtr e = _eis.readNextElement();
+        if (e.get())
+        {
+          batch.push_back(e);
+        }
+        if ((int)batch.size() >= _batchSize)
+        {
+          _queue.push(batch);
+          batch.reserve(_batchSize);
+        }
+      }
+      if (!batch.empty())
+      {
+        _queue.push(batch);
+      }
+      _queue.finish();
+    }
+    catch (const HootException& e)
+    {
+      _queue.finish(e.getWhat());
+    }
+    catch (const std::exception& e)
+    {
+      _queue.finish(QString(e.what()));
+    }
+  }
+
+private:
+
+  ElementInputStream& _eis;
+  ElementBatchQueue& _queue;
+  int _batchSize;
+};
+
+}
+
 ElementOutputStream::ElementOutputStream()
 {
 }
@@ -42,8 +226,19 @@ ElementOutputStream::~ElementOutputStream()
 
 void ElementOutputStream::writeAllElements(ElementInputStream& eis, ElementOutputStream& eos)
 {
+  if (ConfigOptions().getElementStreamAsync())
+  {
+    _writeAllElementsAsync(eis, eos);
+    return;
+  }
+
+  long count = 0;
   while (eis.hasMoreElements())
   {
+    if (count++ % CANCEL_CHECK_INTERVAL == 0)
+    {
+      Cancellation::checkIn();
+    }
     ElementPtr e = eis.readNextElement();
     if (e.get())
     {
@@ -52,4 +247,41 @@ void ElementOutputStream::writeAllElements(ElementInputStream& eis, ElementOutpu
   }
 }
 
+void ElementOutputStream::_writeAllElementsAsync(ElementInputStream& eis, ElementOutputStream& eos)
+{
+  int batchSize = ConfigOptions().getElementStreamAsyncBatchSize();
+  if (batchSize < 1)
+  {
+    batchSize = 1;
+  }
+
+  ElementBatchQueue queue;
+  ElementProducerThread producer(eis, queue, batchSize);
+  producer.start();
+
+  try
+  {
+    ElementBatchQueue::Batch batch;
+    while (queue.pop(batch))
+    {
+      // once per batch on the writer side; the catch below unwinds the reader thread cleanly.
+      Cancellation::checkIn();
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+        eos.writeElement(batch[i]);
+      }
+      batch.clear();
+    }
+  }
+  catch (...)
+  {
+    // let the reader thread wind down before the exception propagates
+    queue.abort();
+    producer.wait();
+    throw;
+  }
+
+  producer.wait();
+}
+
 }
@@ -59,8 +59,19 @@ public:
   /**
    * Read elements from the input stream and write to the output stream. There may be a better place
    * for this to live, but it works for now.
+   *
+   * With element.stream.async enabled the reader runs on a producer thread and feeds the writer
+   * through a bounded queue of element batches, so parsing overlaps with writing. Element order
+   * is preserved either way.
    */
   static void writeAllElements(ElementInputStream& eis, ElementOutputStream& eos);
+
+private:
+
+  /**
+   * The threaded implementation behind writeAllElements; see element.stream.async.
+   */
+  static void _writeAllElementsAsync(ElementInputStream& eis, ElementOutputStream& eos);
 };
 
 }
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ElementReprojectInputStream.h"
+
+// Hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/MapProjector.h>
+
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+// same batch size MapProjector uses for packed array transforms.
+const size_t BATCH_SIZE = 16384;
+}
+
+ElementReprojectInputStream::ElementReprojectInputStream(
+  const ElementInputStreamPtr& elementSource,
+  const boost::shared_ptr<OGRSpatialReference>& projection) :
+_elementSource(elementSource),
+_projection(projection),
+_transform(0),
+_sameProjection(false),
+_initialized(false)
+{
+}
+
+ElementReprojectInputStream::~ElementReprojectInputStream()
+{
+}
+
+bool ElementReprojectInputStream::hasMoreElements()
+{
+  return _buffer.empty() == false || _elementSource->hasMoreElements();
+}
+
+ElementPtr ElementReprojectInputStream::readNextElement()
+{
+  if (_buffer.empty())
+  {
+    _fill();
+  }
+  if (_buffer.empty())
+  {
+    return ElementPtr();
+  }
+
+  ElementPtr result = _buffer.front();
+  _buffer.pop_front();
+  return result;
+}
+
+void ElementReprojectInputStream::_init()
+{
+  boost::shared_ptr<OGRSpatialReference> sourceProjection = _elementSource->getProjection();
+  if (sourceProjection->IsSame(_projection.get()))
+  {
+    _sameProjection = true;
+  }
+  else
+  {
+    _transform = MapProjector::getCachedTransformation(sourceProjection, _projection);
+  }
+  _initialized = true;
+}
+
+void ElementReprojectInputStream::_fill()
+{
+  if (_initialized == false)
+  {
+    _init();
+  }
+
+  vector<NodePtr> nodes;
+  vector<double> x;
+  vector<double> y;
+
+  while (_buffer.size() < BATCH_SIZE && _elementSource->hasMoreElements())
+  {
+    ElementPtr e = _elementSource->readNextElement();
+    if (e.get() == 0)
+    {
+      break;
+    }
+    _buffer.push_back(e);
+
+    if (_sameProjection == false && e->getElementType() == ElementType::Node)
+    {
+      NodePtr n = boost::dynamic_pointer_cast<Node>(e);
+      nodes.push_back(n);
+      x.push_back(n->getX());
+      y.push_back(n->getY());
+    }
+  }
+
+  if (nodes.empty())
+  {
+    return;
+  }
+
+  vector<int> success(nodes.size());
+  _transform->TransformEx(nodes.size(), &x[0], &y[0], 0, &success[0]);
+
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    if (success[i] == FALSE)
+    {
+      throw IllegalArgumentException("Error projecting point. Is the point outside of the "
+                                     "projection's bounds?");
+    }
+    nodes[i]->setX(x[i]);
+    nodes[i]->setY(y[i]);
+  }
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef ELEMENTREPROJECTINPUTSTREAM_H
+#define ELEMENTREPROJECTINPUTSTREAM_H
+
+// Hoot
+#include <hoot/core/io/ElementInputStream.h>
+
+// Standard
+#include <deque>
+#include <vector>
+
+class OGRCoordinateTransformation;
+
+namespace hoot
+{
+
+/**
+ * Reprojects a stream of elements without ever holding the map in memory, so streaming pipelines
+ * don't have to materialize a map just to change projection. Nodes are read ahead in batches and
+ * their coordinates handed to GDAL through a single packed array transform per batch rather than
+ * one virtual transform call per node; ways and relations carry no geometry of their own and
+ * pass through untouched. Downstream consumers see the target projection. When the source is
+ * already in the target projection the stream passes elements through unmodified.
+ */
+class ElementReprojectInputStream : public ElementInputStream
+{
+public:
+
+  ElementReprojectInputStream(const ElementInputStreamPtr& elementSource,
+    const boost::shared_ptr<OGRSpatialReference>& projection);
+
+  virtual ~ElementReprojectInputStream();
+
+  virtual void close() { _elementSource->close(); }
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const { return _projection; }
+
+  virtual bool hasMoreElements();
+
+  virtual ElementPtr readNextElement();
+
+private:
+
+  ElementInputStreamPtr _elementSource;
+  boost::shared_ptr<OGRSpatialReference> _projection;
+  /// owned by MapProjector's transformation cache
+  OGRCoordinateTransformation* _transform;
+  bool _sameProjection;
+  bool _initialized;
+  std::deque<ElementPtr> _buffer;
+
+  /**
+   * Reads the next batch of elements from the source into the buffer and reprojects the nodes
+   * among them with one packed array transform.
+   */
+  void _fill();
+
+  /**
+   * Looks up the cached transformation on first use; the source projection may not be known
+   * until the source stream has been opened and read from.
+   */
+  void _init();
+};
+
+}
+
+#endif // ELEMENTREPROJECTINPUTSTREAM_H
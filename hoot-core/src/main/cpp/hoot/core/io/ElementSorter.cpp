@@ -26,20 +26,223 @@
  */
 #include "ElementSorter.h"
 
+#include <hoot/core/io/OsmPbfReader.h>
+#include <hoot/core/io/OsmPbfWriter.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
 
+// Qt
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QWaitCondition>
+
 // Standard
 #include <algorithm>
+#include <deque>
 
 using namespace std;
 
 namespace hoot
 {
 
+namespace
+{
+
+bool elementLessThan(const ElementPtr& e1, const ElementPtr& e2)
+{
+  if (e1->getElementType().getEnum() != e2->getElementType().getEnum())
+  {
+    return e1->getElementType().getEnum() < e2->getElementType().getEnum();
+  }
+  return e1->getId() < e2->getId();
+}
+
+/**
+ * Sorts a run of elements and writes it to a temporary PBF file, returning the file path. The
+ * PBF format round trips element status and circular error through tags, so nothing is lost
+ * across the spill.
+ */
+QString sortAndSpillRun(vector<ElementPtr>& run)
+{
+  sort(run.begin(), run.end(), elementLessThan);
+
+  QString path;
+  {
+    QTemporaryFile tmp(QDir::tempPath() + "/ElementSorter-XXXXXX.pbf");
+    tmp.setAutoRemove(false);
+    if (!tmp.open())
+    {
+      throw HootException("Error creating temporary file for element sort run.");
+    }
+    path = tmp.fileName();
+  }
+
+  OsmPbfWriter writer;
+  writer.open(path);
+  writer.initializePartial();
+  for (size_t i = 0; i < run.size(); i++)
+  {
+    switch (run[i]->getElementType().getEnum())
+    {
+    case ElementType::Node:
+      writer.writePartial(boost::dynamic_pointer_cast<const Node>(run[i]));
+      break;
+    case ElementType::Way:
+      writer.writePartial(boost::dynamic_pointer_cast<const Way>(run[i]));
+      break;
+    case ElementType::Relation:
+      writer.writePartial(boost::dynamic_pointer_cast<const Relation>(run[i]));
+      break;
+    default:
+      throw HootException("Unexpected element type in sort run.");
+    }
+  }
+  writer.finalizePartial();
+  writer.close();
+
+  run.clear();
+  return path;
+}
+
+/**
+ * Hands full runs from the reading thread to the spill workers and collects the resulting run
+ * file paths. Bounded so the reader can't race arbitrarily far ahead of the sorters.
+ */
+class RunSpillQueue
+{
+public:
+
+  RunSpillQueue(int maxPending) :
+    _maxPending(maxPending),
+    _done(false)
+  {
+  }
+
+  void push(vector<ElementPtr>& run)
+  {
+    QMutexLocker lock(&_mutex);
+    while ((int)_pending.size() >= _maxPending && _error.isEmpty())
+    {
+      _notFull.wait(&_mutex);
+    }
+    _pending.push_back(vector<ElementPtr>());
+    _pending.back().swap(run);
+    _notEmpty.wakeOne();
+  }
+
+  bool pop(vector<ElementPtr>& run)
+  {
+    QMutexLocker lock(&_mutex);
+    while (_pending.empty() && !_done)
+    {
+      _notEmpty.wait(&_mutex);
+    }
+    if (!_pending.empty())
+    {
+      run.swap(_pending.front());
+      _pending.pop_front();
+      _notFull.wakeOne();
+      return true;
+    }
+    return false;
+  }
+
+  void finish()
+  {
+    QMutexLocker lock(&_mutex);
+    _done = true;
+    _notEmpty.wakeAll();
+  }
+
+  void addRunFile(const QString& path)
+  {
+    QMutexLocker lock(&_mutex);
+    _runFiles.append(path);
+  }
+
+  void setError(const QString& error)
+  {
+    QMutexLocker lock(&_mutex);
+    if (_error.isEmpty())
+    {
+      _error = error;
+    }
+    _notFull.wakeAll();
+  }
+
+  QString getError()
+  {
+    QMutexLocker lock(&_mutex);
+    return _error;
+  }
+
+  QStringList getRunFiles()
+  {
+    QMutexLocker lock(&_mutex);
+    return _runFiles;
+  }
+
+private:
+
+  QMutex _mutex;
+  QWaitCondition _notFull;
+  QWaitCondition _notEmpty;
+  std::deque<vector<ElementPtr> > _pending;
+  QStringList _runFiles;
+  QString _error;
+  int _maxPending;
+  bool _done;
+};
+
+/**
+ * Pops runs off the queue, sorts them and spills them to disk. Any error is carried back to the
+ * reading thread.
+ */
+class RunSpillThread : public QThread
+{
+public:
+
+  RunSpillThread(RunSpillQueue& queue) :
+    _queue(queue)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      vector<ElementPtr> run;
+      while (_queue.pop(run))
+      {
+        _queue.addRunFile(sortAndSpillRun(run));
+      }
+    }
+    catch (const HootException& e)
+    {
+      _queue.setError(e.getWhat());
+    }
+    catch (const std::exception& e)
+    {
+      _queue.setError(QString(e.what()));
+    }
+  }
+
+private:
+
+  RunSpillQueue& _queue;
+};
+
+}
+
 ElementSorter::ElementSorter(ConstOsmMapPtr source) :
   _nodeIndex(0),
   _wayIndex(0),
-  _relationIndex(0)
+  _relationIndex(0),
+  _inMemoryIndex(0)
 {
   LOG_DEBUG(
     "Sorting elements by element type for map with element count: " << source->getElementCount());
@@ -67,20 +270,195 @@ ElementSorter::ElementSorter(ConstOsmMapPtr source) :
   sort(_relationIds.begin(), _relationIds.end());
 }
 
+ElementSorter::ElementSorter(ElementInputStreamPtr input) :
+  _nodeIndex(0),
+  _wayIndex(0),
+  _relationIndex(0),
+  _inMemoryIndex(0)
+{
+  _projection = input->getProjection();
+  _externalSort(input);
+}
+
+ElementSorter::~ElementSorter()
+{
+  close();
+}
+
+void ElementSorter::_externalSort(ElementInputStreamPtr input)
+{
+  ConfigOptions configOptions;
+  const size_t runSize = (size_t)std::max(1, configOptions.getElementSorterBufferSize());
+  const int threadCount = std::max(1, configOptions.getElementSorterThreads());
+
+  //read the first run; if the entire input fits in it there's nothing to spill
+  vector<ElementPtr> run;
+  while (input->hasMoreElements() && run.size() < runSize)
+  {
+    ElementPtr e = input->readNextElement();
+    if (e.get())
+    {
+      run.push_back(e);
+    }
+  }
+
+  if (!input->hasMoreElements())
+  {
+    sort(run.begin(), run.end(), elementLessThan);
+    _inMemoryRun.swap(run);
+    return;
+  }
+
+  LOG_INFO(
+    "Input exceeds the element sort buffer size of " << runSize <<
+    "; spilling sorted runs to disk...");
+
+  RunSpillQueue queue(threadCount);
+  vector<boost::shared_ptr<RunSpillThread> > workers;
+  for (int i = 0; i < threadCount; i++)
+  {
+    boost::shared_ptr<RunSpillThread> worker(new RunSpillThread(queue));
+    worker->start();
+    workers.push_back(worker);
+  }
+
+  queue.push(run);
+  while (input->hasMoreElements() && queue.getError().isEmpty())
+  {
+    while (input->hasMoreElements() && run.size() < runSize)
+    {
+      ElementPtr e = input->readNextElement();
+      if (e.get())
+      {
+        run.push_back(e);
+      }
+    }
+    if (!run.empty())
+    {
+      queue.push(run);
+    }
+  }
+  queue.finish();
+
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i]->wait();
+  }
+
+  _runFiles = queue.getRunFiles();
+  const QString error = queue.getError();
+  if (!error.isEmpty())
+  {
+    close();
+    throw HootException(error);
+  }
+  LOG_DEBUG("Merging " << _runFiles.size() << " sorted runs...");
+
+  _openRuns();
+}
+
+void ElementSorter::_openRuns()
+{
+  for (int i = 0; i < _runFiles.size(); i++)
+  {
+    //file ids must be preserved so the merged output matches the input ids
+    boost::shared_ptr<OsmPbfReader> reader(new OsmPbfReader(true));
+    reader->open(_runFiles[i]);
+    reader->initializePartial();
+    _runReaders.push_back(reader);
+    _runHeads.push_back(ElementPtr());
+    _advanceRun(_runReaders.size() - 1);
+  }
+}
+
+void ElementSorter::_advanceRun(size_t i)
+{
+  ElementPtr next;
+  while (_runReaders[i]->hasMoreElements() && !next.get())
+  {
+    next = _runReaders[i]->readNextElement();
+  }
+  _runHeads[i] = next;
+}
+
 boost::shared_ptr<OGRSpatialReference> ElementSorter::getProjection() const
 {
-  return _source->getProjection();
+  if (_source.get())
+  {
+    return _source->getProjection();
+  }
+  return _projection;
+}
+
+void ElementSorter::close()
+{
+  for (size_t i = 0; i < _runReaders.size(); i++)
+  {
+    _runReaders[i]->close();
+  }
+  _runReaders.clear();
+  _runHeads.clear();
+  for (int i = 0; i < _runFiles.size(); i++)
+  {
+    QFile::remove(_runFiles[i]);
+  }
+  _runFiles.clear();
 }
 
 bool ElementSorter::hasMoreElements()
 {
-  return _nodeIndex != _nodeIds.size() ||
-    _wayIndex != _wayIds.size() ||
-    _relationIndex != _relationIds.size();
+  if (_source.get())
+  {
+    return _nodeIndex != _nodeIds.size() ||
+      _wayIndex != _wayIds.size() ||
+      _relationIndex != _relationIds.size();
+  }
+
+  if (_inMemoryIndex != _inMemoryRun.size())
+  {
+    return true;
+  }
+  for (size_t i = 0; i < _runHeads.size(); i++)
+  {
+    if (_runHeads[i].get())
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 ElementPtr ElementSorter::readNextElement()
 {
+  if (!_source.get())
+  {
+    if (_inMemoryIndex != _inMemoryRun.size())
+    {
+      ElementPtr result = _inMemoryRun[_inMemoryIndex];
+      _inMemoryRun[_inMemoryIndex].reset();
+      _inMemoryIndex++;
+      return result;
+    }
+
+    //k-way merge: return the smallest run head and refill that run
+    int best = -1;
+    for (size_t i = 0; i < _runHeads.size(); i++)
+    {
+      if (_runHeads[i].get() &&
+          (best == -1 || elementLessThan(_runHeads[i], _runHeads[best])))
+      {
+        best = (int)i;
+      }
+    }
+    ElementPtr result;
+    if (best != -1)
+    {
+      result = _runHeads[best];
+      _advanceRun((size_t)best);
+    }
+    return result;
+  }
+
   ElementPtr result;
   ConstElementPtr cr;
 
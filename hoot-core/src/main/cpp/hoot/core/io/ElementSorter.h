@@ -34,14 +34,24 @@
 
 // Qt
 #include <QFile>
+#include <QStringList>
 #include <QUrl>
 
 namespace hoot
 {
 
+class OsmPbfReader;
+
 /**
  * An element stream that returns elements in the order of node, way, then relation, sorted by
  * element ID
+ *
+ * Two modes are supported: sorting an in memory map, which only sorts element IDs since the
+ * elements themselves are already resident, and sorting an arbitrary element stream with an
+ * external merge sort. The streaming mode reads bounded runs of elements
+ * (element.sorter.buffer.size), sorts them on worker threads (element.sorter.threads), spills
+ * each run to a temporary PBF file, and merges the runs back together as elements are read. If
+ * the entire input fits in a single run no temporary files are created.
  */
 class ElementSorter : public ElementInputStream
 {
@@ -50,17 +60,25 @@ public:
 
   ElementSorter(ConstOsmMapPtr map);
 
+  /**
+   * Sorts elements from a stream without ever materializing the full input in memory. Memory use
+   * is bounded by element.sorter.buffer.size elements per in flight run.
+   */
+  ElementSorter(ElementInputStreamPtr input);
+
   /**
    * @see ElementInputStream
    */
   virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
 
-  virtual ~ElementSorter() {}
+  virtual ~ElementSorter();
 
   /**
    * @see ElementInputStream
+   *
+   * Closes any open run files and removes them from disk.
    */
-  virtual void close() {}
+  virtual void close();
 
   /**
    * @see ElementInputStream
@@ -79,6 +97,18 @@ private:
   std::vector<long> _nodeIds, _wayIds, _relationIds;
   size_t _nodeIndex, _wayIndex, _relationIndex;
 
+  //external merge sort state used by the streaming constructor
+  boost::shared_ptr<OGRSpatialReference> _projection;
+  std::vector<ElementPtr> _inMemoryRun;
+  size_t _inMemoryIndex;
+  QStringList _runFiles;
+  std::vector<boost::shared_ptr<OsmPbfReader> > _runReaders;
+  std::vector<ElementPtr> _runHeads;
+
+  void _externalSort(ElementInputStreamPtr input);
+  void _openRuns();
+  void _advanceRun(size_t i);
+
 };
 
 typedef boost::shared_ptr<ElementSorter> ElementSorterPtr;
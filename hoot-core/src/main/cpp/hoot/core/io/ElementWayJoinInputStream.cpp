@@ -0,0 +1,112 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ElementWayJoinInputStream.h"
+
+// Hoot
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Way.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Log.h>
+
+// GEOS
+#include <geos/geom/Envelope.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+unsigned int ElementWayJoinInputStream::logWarnCount = 0;
+
+ElementWayJoinInputStream::ElementWayJoinInputStream(const ElementInputStreamPtr& elementSource) :
+_elementSource(elementSource)
+{
+}
+
+ElementWayJoinInputStream::~ElementWayJoinInputStream()
+{
+}
+
+void ElementWayJoinInputStream::close()
+{
+  _coords.clear();
+  _elementSource->close();
+}
+
+ElementPtr ElementWayJoinInputStream::readNextElement()
+{
+  ElementPtr e = _elementSource->readNextElement();
+  if (e.get() == 0)
+  {
+    return e;
+  }
+
+  if (e->getElementType() == ElementType::Node)
+  {
+    NodePtr n = boost::dynamic_pointer_cast<Node>(e);
+    _coords.insert(n->getId(), pair<double, double>(n->getX(), n->getY()));
+  }
+  else if (e->getElementType() == ElementType::Way)
+  {
+    WayPtr w = boost::dynamic_pointer_cast<Way>(e);
+    Envelope env;
+    const vector<long>& nids = w->getNodeIds();
+    for (size_t i = 0; i < nids.size(); i++)
+    {
+      if (_coords.contains(nids[i]))
+      {
+        const pair<double, double>& c = _coords.at(nids[i]);
+        env.expandToInclude(c.first, c.second);
+      }
+      else
+      {
+        // either the input isn't node first ordered or the way references a node that isn't in
+        // the input; the envelope is computed from the nodes that did stream by.
+        if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN(
+            "Way " << w->getId() << " references node " << nids[i] <<
+            " that hasn't streamed by; its envelope may be incomplete.");
+        }
+        else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+        }
+        logWarnCount++;
+      }
+    }
+    if (env.isNull() == false)
+    {
+      w->setCachedEnvelope(env);
+    }
+  }
+
+  return e;
+}
+
+}
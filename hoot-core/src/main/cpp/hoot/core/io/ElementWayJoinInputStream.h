@@ -0,0 +1,85 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef ELEMENTWAYJOININPUTSTREAM_H
+#define ELEMENTWAYJOININPUTSTREAM_H
+
+// Hoot
+#include <hoot/core/io/ElementInputStream.h>
+
+// Standard
+#include <string>
+#include <utility>
+
+// Tgs
+#include <tgs/BigContainers/BigMap.h>
+
+namespace hoot
+{
+
+/**
+ * Resolves way geometry in a streaming pipeline without holding the nodes in memory, mirroring
+ * what hoot-hadoop's way-join does on the cluster but locally. As nodes flow past, their
+ * coordinates are recorded in a disk backed BigMap; when the ways arrive their envelopes are
+ * computed from the recorded coordinates and attached as cached envelopes (the same envelope the
+ * cluster way-join produces, serialized to .osm.pbf by OsmPbfWriter). Memory use is bounded by
+ * the BigMap's in RAM budget, so planet scale files can be joined on one machine.
+ *
+ * The source must deliver all of a way's nodes before the way, which the usual element type
+ * ordering (node, way, relation) guarantees; ElementSorter produces it and .osm.pbf files
+ * normally carry it. A way node that never streamed by simply doesn't contribute to the
+ * envelope.
+ */
+class ElementWayJoinInputStream : public ElementInputStream
+{
+public:
+
+  static std::string className() { return "hoot::ElementWayJoinInputStream"; }
+
+  static unsigned int logWarnCount;
+
+  ElementWayJoinInputStream(const ElementInputStreamPtr& elementSource);
+
+  virtual ~ElementWayJoinInputStream();
+
+  virtual void close();
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const
+  { return _elementSource->getProjection(); }
+
+  virtual bool hasMoreElements() { return _elementSource->hasMoreElements(); }
+
+  virtual ElementPtr readNextElement();
+
+private:
+
+  ElementInputStreamPtr _elementSource;
+  Tgs::BigMap<long, std::pair<double, double> > _coords;
+};
+
+}
+
+#endif // ELEMENTWAYJOININPUTSTREAM_H
@@ -26,6 +26,9 @@
  */
 #include "GeoNamesReader.h"
 
+// Boost
+#include <boost/iostreams/filter/gzip.hpp>
+
 // hoot
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/MapProjector.h>
@@ -35,6 +38,8 @@
 #include <QDir>
 #include <QFile>
 
+using namespace std;
+
 namespace hoot
 {
 
@@ -45,6 +50,9 @@ GeoNamesReader::GeoNamesReader()
   _maxSaveMemoryStrings = 100000;
   _circularError = 15.0;
   _useDataSourceIds = false;
+  _strm = 0;
+  _bufferPos = 0;
+  _eof = true;
 
   _columns << "geonameid";
   _columns << "name";
@@ -74,7 +82,12 @@ GeoNamesReader::GeoNamesReader()
 
 void GeoNamesReader::close()
 {
-  _fp.close();
+  _zStrm.reset();
+  _fileStrm.reset();
+  _strm = 0;
+  _buffer.clear();
+  _bufferPos = 0;
+  _eof = true;
 }
 
 boost::shared_ptr<OGRSpatialReference> GeoNamesReader::getProjection() const
@@ -89,7 +102,11 @@ boost::shared_ptr<OGRSpatialReference> GeoNamesReader::getProjection() const
 
 bool GeoNamesReader::hasMoreElements()
 {
-  return !_fp.atEnd();
+  if (_bufferPos < _buffer.size())
+  {
+    return true;
+  }
+  return _fillBuffer();
 }
 
 bool GeoNamesReader::isSupported(QString url)
@@ -97,50 +114,152 @@ bool GeoNamesReader::isSupported(QString url)
   url = QDir().absoluteFilePath(url);
   QFile f(url);
 
-  bool result = url.toLower().endsWith(".geonames") && f.exists();
+  bool result = (url.toLower().endsWith(".geonames") || url.toLower().endsWith(".geonames.gz")) &&
+    f.exists();
   return result;
 }
 
 void GeoNamesReader::open(QString url)
 {
-  _fp.close();
-  _fp.setFileName(QDir().absoluteFilePath(url));
+  close();
   _elementsRead = 0;
 
-  if (_fp.open(QFile::ReadOnly) == false)
+  const QString path = QDir().absoluteFilePath(url);
+  fstream* fs = new fstream();
+  _fileStrm.reset(fs);
+  QByteArray arr = path.toUtf8();
+  fs->open(arr.data(), ios_base::in | ios_base::binary);
+  if (fs->is_open() == false)
   {
     throw HootException("Error opening file for reading: " + url);
   }
+  _strm = fs;
+
+  if (path.toLower().endsWith(".gz"))
+  {
+    _zStrm.reset(new boost::iostreams::filtering_istream);
+    boost::iostreams::filtering_istream& zdat = *_zStrm;
+    zdat.push(boost::iostreams::gzip_decompressor());
+    zdat.push(*fs);
+    _strm = &zdat;
+  }
+
+  _eof = false;
+}
+
+bool GeoNamesReader::_fillBuffer()
+{
+  if (_eof)
+  {
+    return false;
+  }
+
+  // drop the bytes that have already been consumed before reading more
+  if (_bufferPos > 0)
+  {
+    _buffer.remove(0, _bufferPos);
+    _bufferPos = 0;
+  }
+
+  const int chunkSize = 1024 * 1024;
+  const int oldSize = _buffer.size();
+  _buffer.resize(oldSize + chunkSize);
+  _strm->read(_buffer.data() + oldSize, chunkSize);
+  const int bytesRead = (int)_strm->gcount();
+  _buffer.resize(oldSize + bytesRead);
+
+  if (bytesRead == 0)
+  {
+    _eof = true;
+    return false;
+  }
+  return true;
+}
+
+bool GeoNamesReader::_readLine(const char*& lineStart, int& lineLength)
+{
+  int nl = _buffer.indexOf('\n', _bufferPos);
+  while (nl == -1 && _fillBuffer())
+  {
+    nl = _buffer.indexOf('\n', _bufferPos);
+  }
+
+  if (nl == -1)
+  {
+    // last line in a file without a trailing newline
+    if (_bufferPos >= _buffer.size())
+    {
+      return false;
+    }
+    lineStart = _buffer.constData() + _bufferPos;
+    lineLength = _buffer.size() - _bufferPos;
+    _bufferPos = _buffer.size();
+    return true;
+  }
+
+  lineStart = _buffer.constData() + _bufferPos;
+  // include the newline to match what QIODevice::readLine historically returned
+  lineLength = nl - _bufferPos + 1;
+  _bufferPos = nl + 1;
+  return true;
 }
 
 ElementPtr GeoNamesReader::readNextElement()
 {
-  QByteArray lineBytes = _fp.readLine();
-  QString line = QString::fromUtf8(lineBytes.constData());
-  QStringList fields = line.split('\t');
+  const char* line;
+  int lineLength;
+  if (!_readLine(line, lineLength))
+  {
+    throw HootException("Attempted to read past the end of the GeoNames file.");
+  }
 
+  // split the line on tabs without allocating any strings
+  _fieldStarts.clear();
+  _fieldLengths.clear();
+  int start = 0;
+  for (int i = 0; i < lineLength; i++)
+  {
+    if (line[i] == '\t')
+    {
+      _fieldStarts.push_back(start);
+      _fieldLengths.push_back(i - start);
+      start = i + 1;
+    }
+  }
+  _fieldStarts.push_back(start);
+  _fieldLengths.push_back(lineLength - start);
+
+  if (_columns.size() != (int)_fieldStarts.size())
+  {
+    throw HootException(QString("Expected %1 fields but found %2 fields. %3").arg(_columns.size()).
+      arg(_fieldStarts.size()).arg(QString::fromUtf8(line, lineLength)));
+  }
+
+  // the numeric fields are parsed from the raw bytes; the copies are tiny and nul terminated for
+  // toDouble/toLong
   bool ok;
-  double x = fields[_LONGITUDE].toDouble(&ok);
+  double x = QByteArray(line + _fieldStarts[_LONGITUDE], _fieldLengths[_LONGITUDE]).toDouble(&ok);
   if (ok == false)
   {
-    throw HootException(QString("Error parsing longitude (%1): %2").arg(fields[_LONGITUDE]).
-      arg(line));
+    throw HootException(QString("Error parsing longitude (%1): %2").
+      arg(QString::fromUtf8(line + _fieldStarts[_LONGITUDE], _fieldLengths[_LONGITUDE])).
+      arg(QString::fromUtf8(line, lineLength)));
   }
-  double y = fields[_LATITUDE].toDouble(&ok);
+  double y = QByteArray(line + _fieldStarts[_LATITUDE], _fieldLengths[_LATITUDE]).toDouble(&ok);
   if (ok == false)
   {
-    throw HootException(QString("Error parsing latitude (%1): %2").arg(fields[_LATITUDE]).
-      arg(line));
+    throw HootException(QString("Error parsing latitude (%1): %2").
+      arg(QString::fromUtf8(line + _fieldStarts[_LATITUDE], _fieldLengths[_LATITUDE])).
+      arg(QString::fromUtf8(line, lineLength)));
   }
 
   long id;
   if (_useDataSourceIds)
   {
-    bool ok;
-    id = fields[_GEONAMESID].toLong(&ok);
+    id = QByteArray(line + _fieldStarts[_GEONAMESID], _fieldLengths[_GEONAMESID]).toLong(&ok);
     if (!ok)
     {
-      throw HootException("Error parsing geonames ID: " + line);
+      throw HootException("Error parsing geonames ID: " + QString::fromUtf8(line, lineLength));
     }
   }
   else
@@ -150,16 +269,11 @@ ElementPtr GeoNamesReader::readNextElement()
 
   NodePtr n(new Node(_status, id, x, y, _circularError));
 
-  if (_columns.size() != fields.size())
-  {
-    throw HootException(QString("Expected %1 fields but found %2 fields. %3").arg(_columns.size()).
-      arg(fields.size()).arg(line));
-  }
-
   for (int i = 0; i < _columns.size(); i++)
   {
     int j = i; //convertColumns[i];
-    n->getTags()[_columns[j]] = _saveMemory(fields[j]);
+    n->getTags()[_columns[j]] =
+      _saveMemory(QString::fromUtf8(line + _fieldStarts[j], _fieldLengths[j]));
   }
 
   return n;
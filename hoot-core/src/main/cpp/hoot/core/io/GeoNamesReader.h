@@ -27,15 +27,26 @@
 #ifndef GEONAMESREADER_H
 #define GEONAMESREADER_H
 
+// boost
+#include <boost/iostreams/filtering_stream.hpp>
+
 // hoot
 #include <hoot/core/io/PartialOsmMapReader.h>
 
-// Qt
-#include <QFile>
+// Standard
+#include <fstream>
+#include <memory>
+#include <vector>
 
 namespace hoot
 {
 
+/**
+ * Reads the tab delimited GeoNames.org file format (e.g. allCountries.txt). The file is read in
+ * large chunks and lines are split at the byte level; the numeric fields are validated before any
+ * QString is allocated, which matters when parsing the full 12M row GeoNames dump. Gzipped input
+ * (.geonames.gz) is decompressed while reading.
+ */
 class GeoNamesReader : public PartialOsmMapReader
 {
 public:
@@ -69,7 +80,6 @@ private:
   Meters _circularError;
   QStringList _columns;
   QList<int> _convertColumns;
-  QFile _fp;
   Status _status;
   QHash<QString, QString> _strings;
   int _LATITUDE;
@@ -79,7 +89,20 @@ private:
   bool _useDataSourceIds;
   mutable boost::shared_ptr<OGRSpatialReference> _wgs84;
 
-
+  // the filtering stream references the fstream so it must be destroyed first (declared last)
+  std::auto_ptr<std::fstream> _fileStrm;
+  std::auto_ptr<boost::iostreams::filtering_istream> _zStrm;
+  std::istream* _strm;
+  // unconsumed raw bytes read from _strm; see _readLine
+  QByteArray _buffer;
+  int _bufferPos;
+  bool _eof;
+  // scratch space for the field offsets of the current line
+  std::vector<int> _fieldStarts;
+  std::vector<int> _fieldLengths;
+
+  bool _fillBuffer();
+  bool _readLine(const char*& lineStart, int& lineLength);
   QString _saveMemory(const QString& s);
 };
 
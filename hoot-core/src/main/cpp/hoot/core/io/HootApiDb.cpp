@@ -28,6 +28,7 @@
 
 // hoot
 #include <hoot/core/elements/Relation.h>
+#include <hoot/core/io/PgCopyBulkInsert.h>
 #include <hoot/core/io/SqlBulkInsert.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/HootException.h>
@@ -78,7 +79,14 @@ void HootApiDb::_init()
   _capitalizeRelationMemberType = false;
   _inTransaction = false;
 
+  _copyBulkInsertActivated = ConfigOptions().getHootapiDbWriterCopyBulkInsert();
+
   int recordsPerBulkInsert = 500;
+  if (_copyBulkInsertActivated)
+  {
+    // COPY has no statement size limits to worry about, so larger batches pay off
+    recordsPerBulkInsert = ConfigOptions().getHootapiDbWriterCopyBulkInsertBatchSize();
+  }
 
   // set it to something obsurd.
   _lastMapId = -numeric_limits<long>::max();
@@ -463,6 +471,34 @@ QString HootApiDb::_escapeTags(const Tags& tags) const
   return hstoreStr;
 }
 
+boost::shared_ptr<BulkInsert> HootApiDb::_createBulkInsert(const QString& tableName,
+                                                           const QStringList& columns)
+{
+  if (_copyBulkInsertActivated)
+  {
+    return boost::shared_ptr<BulkInsert>(new PgCopyBulkInsert(_db, tableName, columns));
+  }
+  return boost::shared_ptr<BulkInsert>(new SqlBulkInsert(_db, tableName, columns));
+}
+
+QVariant HootApiDb::_tagsAsVariant(const Tags& tags) const
+{
+  if (!_copyBulkInsertActivated)
+  {
+    return _escapeTags(tags);
+  }
+  // the COPY path renders the hstore literal itself from a plain map
+  QVariantMap map;
+  for (Tags::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    if (it.key().isEmpty() == false && it.value().isEmpty() == false)
+    {
+      map.insert(it.key(), it.value());
+    }
+  }
+  return map;
+}
+
 QString HootApiDb::execToString(QString sql, QVariant v1, QVariant v2, QVariant v3)
 {
   QSqlQuery q = _exec(sql, v1, v2, v3);
@@ -722,7 +758,7 @@ bool HootApiDb::insertNode(const long id, const double lat, const double lon, co
     columns << "id" << "latitude" << "longitude" << "changeset_id" << "timestamp" <<
                "tile" << "version" << "tags";
 
-    _nodeBulkInsert.reset(new SqlBulkInsert(_db, getCurrentNodesTableName(mapId), columns));
+    _nodeBulkInsert = _createBulkInsert(getCurrentNodesTableName(mapId), columns);
   }
 
   QList<QVariant> v;
@@ -736,7 +772,7 @@ bool HootApiDb::insertNode(const long id, const double lat, const double lon, co
   // escaping tags ensures that we won't introduce a SQL injection vulnerability, however, if a
   // bad tag is passed and it isn't escaped properly (shouldn't happen) it may result in a syntax
   // error.
-  v.append(_escapeTags(tags));
+  v.append(_tagsAsVariant(tags));
 
   _nodeBulkInsert->insert(v);
 
@@ -815,7 +851,7 @@ bool HootApiDb::insertRelation(const long relationId, const Tags &tags)
     QStringList columns;
     columns << "id" << "changeset_id" << "timestamp" << "version" << "tags";
 
-    _relationBulkInsert.reset(new SqlBulkInsert(_db, getCurrentRelationsTableName(mapId), columns));
+    _relationBulkInsert = _createBulkInsert(getCurrentRelationsTableName(mapId), columns);
   }
 
   QList<QVariant> v;
@@ -826,7 +862,7 @@ bool HootApiDb::insertRelation(const long relationId, const Tags &tags)
   // escaping tags ensures that we won't introduce a SQL injection vulnerability, however, if a
   // bad tag is passed and it isn't escaped properly (shouldn't happen) it may result in a syntax
   // error.
-  v.append(_escapeTags(tags));
+  v.append(_tagsAsVariant(tags));
 
   _relationBulkInsert->insert(v);
 
@@ -1036,6 +1072,7 @@ void HootApiDb::_resetQueries()
   _changesetExists.reset();
   _numTypeElementsForMap.reset();
   _selectElementsForMap.reset();
+  _selectElementsQueries.clear();
   _selectReserveNodeIds.reset();
   _selectNodeIdsForWay.reset();
   _selectMapIds.reset();
@@ -1231,9 +1268,6 @@ long HootApiDb::numElements(const ElementType& elementType)
 boost::shared_ptr<QSqlQuery> HootApiDb::selectElements(const ElementType& elementType,
                                                        const bool sorted)
 {
-  _selectElementsForMap.reset(new QSqlQuery(_db));
-  _selectElementsForMap->setForwardOnly(true);
-
   QString sql = "SELECT * FROM " + tableTypeToTableName(TableType::fromElementType(elementType));
   if (sorted)
   {
@@ -1241,7 +1275,16 @@ boost::shared_ptr<QSqlQuery> HootApiDb::selectElements(const ElementType& elemen
   }
   LOG_VARD(sql);
 
-  _selectElementsForMap->prepare(sql);
+  //reuse the prepared cursor across calls (e.g. repeated bounded reads against the same map);
+  //preparing per call pays for a fresh server side plan every time.
+  _selectElementsForMap = _selectElementsQueries[sql];
+  if (!_selectElementsForMap)
+  {
+    _selectElementsForMap.reset(new QSqlQuery(_db));
+    _selectElementsForMap->setForwardOnly(true);
+    _selectElementsForMap->prepare(sql);
+    _selectElementsQueries[sql] = _selectElementsForMap;
+  }
 
   if (_selectElementsForMap->exec() == false)
   {
@@ -1257,6 +1300,45 @@ boost::shared_ptr<QSqlQuery> HootApiDb::selectElements(const ElementType& elemen
   return _selectElementsForMap;
 }
 
+boost::shared_ptr<QSqlQuery> HootApiDb::selectElementsInRange(const ElementType& elementType,
+                                                              long minId, long maxId)
+{
+  boost::shared_ptr<QSqlQuery> query(new QSqlQuery(_db));
+  query->setForwardOnly(true);
+
+  QString sql =
+    "SELECT * FROM " + tableTypeToTableName(TableType::fromElementType(elementType)) +
+    " WHERE id >= :minId AND id <= :maxId ORDER BY id";
+  query->prepare(sql);
+  query->bindValue(":minId", (qlonglong)minId);
+  query->bindValue(":maxId", (qlonglong)maxId);
+
+  if (query->exec() == false)
+  {
+    const QString err =
+      "Error selecting elements of type: " + elementType.toString() +
+      " in range for map ID: " + QString::number(_currMapId) + " Error: " +
+      query->lastError().text();
+    LOG_ERROR(err);
+    throw HootException(err);
+  }
+  return query;
+}
+
+long HootApiDb::minId(const ElementType& elementType)
+{
+  return execToString(
+    "SELECT COALESCE(MIN(id), 0) FROM " +
+    tableTypeToTableName(TableType::fromElementType(elementType))).toLong();
+}
+
+long HootApiDb::maxId(const ElementType& elementType)
+{
+  return execToString(
+    "SELECT COALESCE(MAX(id), 0) FROM " +
+    tableTypeToTableName(TableType::fromElementType(elementType))).toLong();
+}
+
 vector<long> HootApiDb::selectNodeIdsForWay(long wayId)
 {
   const long mapId = _currMapId;
@@ -1461,7 +1543,7 @@ bool HootApiDb::insertWay(const long wayId, const Tags &tags)
     QStringList columns;
     columns << "id" << "changeset_id" << "timestamp" << "version" << "tags";
 
-    _wayBulkInsert.reset(new SqlBulkInsert(_db, getCurrentWaysTableName(mapId), columns));
+    _wayBulkInsert = _createBulkInsert(getCurrentWaysTableName(mapId), columns);
   }
 
   QList<QVariant> v;
@@ -1472,7 +1554,7 @@ bool HootApiDb::insertWay(const long wayId, const Tags &tags)
   // escaping tags ensures that we won't introduce a SQL injection vulnerability, however, if a
   // bad tag is passed and it isn't escaped properly (shouldn't happen) it may result in a syntax
   // error.
-  v.append(_escapeTags(tags));
+  v.append(_tagsAsVariant(tags));
 
   _wayBulkInsert->insert(v);
 
@@ -1502,7 +1584,7 @@ void HootApiDb::insertWayNodes(long wayId, const vector<long>& nodeIds)
     QStringList columns;
     columns << "way_id" << "node_id" << "sequence_id";
 
-    _wayNodeBulkInsert.reset(new SqlBulkInsert(_db, getCurrentWayNodesTableName(mapId), columns));
+    _wayNodeBulkInsert = _createBulkInsert(getCurrentWayNodesTableName(mapId), columns);
   }
 
   QList<QVariant> v;
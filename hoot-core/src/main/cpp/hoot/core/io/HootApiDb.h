@@ -74,6 +74,22 @@ public:
   /**
    * @see ApiDb::selectElements
    */
+  /**
+   * @see ApiDb::selectElementsInRange
+   */
+  virtual boost::shared_ptr<QSqlQuery> selectElementsInRange(const ElementType& elementType,
+                                                             long minId, long maxId);
+
+  /**
+   * @see ApiDb::minId
+   */
+  virtual long minId(const ElementType& elementType);
+
+  /**
+   * @see ApiDb::maxId
+   */
+  virtual long maxId(const ElementType& elementType);
+
   virtual boost::shared_ptr<QSqlQuery> selectElements(const ElementType& elementType,
                                                       const bool sorted = false);
 
@@ -316,6 +332,8 @@ private:
   boost::shared_ptr<QSqlQuery> _numTypeElementsForMap;
   boost::shared_ptr<QSqlQuery> _selectReserveNodeIds;
   boost::shared_ptr<QSqlQuery> _selectElementsForMap;
+  //prepared element selection cursors, keyed by SQL, so repeated reads reuse the server side plan
+  QMap<QString, boost::shared_ptr<QSqlQuery> > _selectElementsQueries;
   boost::shared_ptr<QSqlQuery> _selectMapIds;
   boost::shared_ptr<QSqlQuery> _selectMembersForRelation;
   boost::shared_ptr<QSqlQuery> _updateNode;
@@ -326,6 +344,10 @@ private:
   boost::shared_ptr<QSqlQuery> _jobStatusExists;
   boost::shared_ptr<QSqlQuery> _mapExistsByName;
 
+  //when true, bulk inserts stream through the PostgreSQL COPY protocol; see
+  //hootapi.db.writer.copy.bulk.insert
+  bool _copyBulkInsertActivated;
+
   boost::shared_ptr<BulkInsert> _nodeBulkInsert;
   long _nodesPerBulkInsert;
   double _nodesInsertElapsed;
@@ -392,6 +414,19 @@ private:
 
   QString _escapeTags(const Tags& tags) const;
 
+  /**
+   * Creates a bulk inserter for the given table; uses the COPY protocol when
+   * hootapi.db.writer.copy.bulk.insert is enabled and multi-row INSERTs otherwise.
+   */
+  boost::shared_ptr<BulkInsert> _createBulkInsert(const QString& tableName,
+                                                  const QStringList& columns);
+
+  /**
+   * Renders tags for a bulk insert row: a pre-escaped hstore SQL expression for the INSERT path,
+   * or a plain map for the COPY path, which does its own escaping.
+   */
+  QVariant _tagsAsVariant(const Tags& tags) const;
+
   void _flushBulkInserts();
   void _flushBulkDeletes();
   long _getNextNodeId();
@@ -29,7 +29,6 @@
 // hoot
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/Settings.h>
-#include <hoot/core/util/OsmUtils.h>
 #include <hoot/core/elements/ElementId.h>
 #include <hoot/core/elements/ElementType.h>
 #include <hoot/core/util/DbUtils.h>
@@ -44,6 +43,20 @@ using namespace std;
 namespace hoot
 {
 
+namespace
+{
+
+//The timestamp columns come back naive and are stored as UTC.  Converting the QDateTime directly
+//avoids the string format/reparse roundtrip through OsmUtils::fromTimeString, which shows up when
+//materializing millions of rows.
+unsigned int dbTimestampToUnixTime(const QVariant& timestamp)
+{
+  const QDateTime dt = timestamp.toDateTime();
+  return QDateTime(dt.date(), dt.time(), Qt::UTC).toTime_t();
+}
+
+}
+
 HOOT_FACTORY_REGISTER(OsmMapReader, HootApiDbReader)
 
 HootApiDbReader::HootApiDbReader() :
@@ -70,6 +83,7 @@ void HootApiDbReader::open(QString urlStr)
   {
     throw HootException("An unsupported URL was passed in to HootApiDbReader: " + urlStr);
   }
+  _url = urlStr;
   initializePartial();
 
   QUrl url(urlStr);
@@ -132,8 +146,7 @@ NodePtr HootApiDbReader::_resultToNode(const QSqlQuery& resultIterator, OsmMap&
       -1,
       resultIterator.value(ApiDb::NODES_CHANGESET).toLongLong(),
       resultIterator.value(ApiDb::NODES_VERSION).toLongLong(),
-      OsmUtils::fromTimeString(
-        resultIterator.value(ApiDb::NODES_TIMESTAMP).toDateTime().toString("yyyy-MM-ddThh:mm:ssZ"))));
+      dbTimestampToUnixTime(resultIterator.value(ApiDb::NODES_TIMESTAMP))));
 
   node->setTags(ApiDb::unescapeTags(resultIterator.value(ApiDb::NODES_TAGS)));
   _updateMetadataOnElement(node);
@@ -165,8 +178,7 @@ WayPtr HootApiDbReader::_resultToWay(const QSqlQuery& resultIterator, OsmMap& ma
       -1,
       resultIterator.value(ApiDb::WAYS_CHANGESET).toLongLong(),
       resultIterator.value(ApiDb::WAYS_VERSION).toLongLong(),
-      OsmUtils::fromTimeString(
-        resultIterator.value(ApiDb::WAYS_TIMESTAMP).toDateTime().toString("yyyy-MM-ddThh:mm:ssZ"))
+      dbTimestampToUnixTime(resultIterator.value(ApiDb::WAYS_TIMESTAMP))
       ));
 
   way->setTags(ApiDb::unescapeTags(resultIterator.value(ApiDb::WAYS_TAGS)));
@@ -205,8 +217,7 @@ RelationPtr HootApiDbReader::_resultToRelation(const QSqlQuery& resultIterator,
       "",/*MetadataTags::RelationCollection()*/ //services db doesn't support relation "type" yet
       resultIterator.value(ApiDb::RELATIONS_CHANGESET).toLongLong(),
       resultIterator.value(ApiDb::RELATIONS_VERSION).toLongLong(),
-      OsmUtils::fromTimeString(
-        resultIterator.value(ApiDb::RELATIONS_TIMESTAMP).toDateTime().toString("yyyy-MM-ddThh:mm:ssZ"))));
+      dbTimestampToUnixTime(resultIterator.value(ApiDb::RELATIONS_TIMESTAMP))));
 
   relation->setTags(ApiDb::unescapeTags(resultIterator.value(ApiDb::RELATIONS_TAGS)));
   _updateMetadataOnElement(relation);
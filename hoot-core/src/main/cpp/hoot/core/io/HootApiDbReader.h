@@ -63,6 +63,10 @@ protected:
 
   virtual boost::shared_ptr<ApiDb> _getDatabase() const { return _database; }
 
+  virtual bool _supportsParallelRead() const { return true; }
+
+  virtual std::string _getReaderClassName() const { return className(); }
+
 private:
 
   boost::shared_ptr<HootApiDb> _database;
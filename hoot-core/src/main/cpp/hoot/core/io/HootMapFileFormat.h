@@ -0,0 +1,166 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef HOOTMAPFILEFORMAT_H
+#define HOOTMAPFILEFORMAT_H
+
+// Qt
+#include <QtGlobal>
+
+namespace hoot
+{
+
+/**
+ * On disk layout for the native map file format (.hmf), shared by
+ * HootMapFileWriter and HootMapFileReader.
+ *
+ * The format exists so that maps passed between pipeline stages (e.g. convert
+ * followed by conflate) don't have to be re-parsed from XML or PBF. The file
+ * is laid out as fixed size records that can be memory mapped and used in
+ * place; elements are only materialized when asked for. Strings (tag keys and
+ * values, relation roles and types, the projection WKT) are pooled in a single
+ * string table and referenced by index.
+ *
+ * Layout, in file order:
+ *  - HmfHeader
+ *  - HmfNodeRecord[nodeCount], sorted by element id ascending
+ *  - HmfWayRecord[wayCount], sorted by element id ascending
+ *  - qint64[wayNodeCount], the concatenated node id lists of all ways
+ *  - HmfRelationRecord[relationCount], sorted by element id ascending
+ *  - HmfRelationMember[relationMemberCount]
+ *  - HmfTagPair[tagPairCount], the concatenated tag lists of all elements
+ *  - quint64[stringCount + 1], byte offsets into the string blob; string i
+ *    occupies [offset[i], offset[i + 1])
+ *  - the string blob (UTF-8, no terminators)
+ *
+ * Records are sorted by id so lookups can binary search the mapped arrays
+ * directly. All fields are naturally aligned and written in host byte order -
+ * the format is a processing intermediate, not an interchange format.
+ */
+
+/** Magic bytes at the start of every map file. */
+const char HMF_MAGIC[8] = { 'H', 'O', 'O', 'T', 'M', 'A', 'P', '\n' };
+
+/** Bump when the record layout changes. */
+const quint32 HMF_VERSION = 1;
+
+struct HmfHeader
+{
+  char magic[8];
+  quint32 version;
+  quint32 pad;
+
+  quint64 nodeCount;
+  quint64 wayCount;
+  quint64 relationCount;
+  quint64 wayNodeCount;
+  quint64 relationMemberCount;
+  quint64 tagPairCount;
+  quint64 stringCount;
+
+  // byte offsets of each section from the start of the file
+  quint64 nodeRecordsPos;
+  quint64 wayRecordsPos;
+  quint64 wayNodesPos;
+  quint64 relationRecordsPos;
+  quint64 relationMembersPos;
+  quint64 tagPairsPos;
+  quint64 stringOffsetsPos;
+  quint64 stringBlobPos;
+
+  // envelope of the whole map, for coarse spatial filtering
+  double minX;
+  double minY;
+  double maxX;
+  double maxY;
+
+  // string table index of the projection WKT, or HMF_NO_STRING
+  quint32 srsWktIdx;
+  quint32 pad2;
+};
+
+/** Marker for "no string" in string table index fields. */
+const quint32 HMF_NO_STRING = 0xffffffff;
+
+/** One tag; both halves index the string table. */
+struct HmfTagPair
+{
+  quint32 key;
+  quint32 value;
+};
+
+struct HmfNodeRecord
+{
+  qint64 id;
+  double x;
+  double y;
+  double circularError;
+  quint64 tagStart;
+  qint32 status;
+  quint32 tagCount;
+};
+
+struct HmfWayRecord
+{
+  qint64 id;
+  double circularError;
+  // envelope of the way's nodes, so bounding box queries don't have to
+  // materialize anything
+  double minX;
+  double minY;
+  double maxX;
+  double maxY;
+  quint64 nodeStart;
+  quint64 tagStart;
+  qint32 status;
+  quint32 nodeCount;
+  quint32 tagCount;
+  quint32 pad;
+};
+
+struct HmfRelationMember
+{
+  qint64 ref;
+  // ElementType::Type of the referenced element
+  qint32 type;
+  quint32 roleIdx;
+};
+
+struct HmfRelationRecord
+{
+  qint64 id;
+  double circularError;
+  quint64 memberStart;
+  quint64 tagStart;
+  qint32 status;
+  quint32 typeIdx;
+  quint32 memberCount;
+  quint32 tagCount;
+};
+
+}
+
+#endif // HOOTMAPFILEFORMAT_H
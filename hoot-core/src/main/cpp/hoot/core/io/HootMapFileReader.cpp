@@ -0,0 +1,463 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "HootMapFileReader.h"
+
+// hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/MetadataTags.h>
+
+// GDAL
+#include <ogr_spatialref.h>
+
+// Standard
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+namespace hoot
+{
+
+HOOT_FACTORY_REGISTER(OsmMapReader, HootMapFileReader)
+
+namespace // anonymous
+{
+  /**
+   * Binary search over a mapped, id sorted record array. Returns 0 if the id
+   * isn't present.
+   */
+  template<class Record>
+  const Record* findRecord(const Record* records, quint64 count, qint64 id)
+  {
+    quint64 lo = 0;
+    quint64 hi = count;
+    while (lo < hi)
+    {
+      quint64 mid = (lo + hi) / 2;
+      if (records[mid].id < id)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (lo < count && records[lo].id == id)
+      return records + lo;
+    return 0;
+  }
+}
+
+HootMapFileReader::HootMapFileReader() :
+  _data(0),
+  _defaultStatus(Status::Invalid),
+  _useDataSourceIds(true),
+  _header(0),
+  _nodeRecords(0),
+  _wayRecords(0),
+  _wayNodeIds(0),
+  _relationRecords(0),
+  _relationMembers(0),
+  _tagPairs(0),
+  _stringOffsets(0),
+  _stringBlob(0)
+{
+}
+
+HootMapFileReader::~HootMapFileReader()
+{
+  close();
+}
+
+void HootMapFileReader::open(QString url)
+{
+  close();
+
+  _file.setFileName(url);
+  if (!_file.open(QIODevice::ReadOnly))
+  {
+    throw HootException(QString("Error opening for reading: %1").arg(url));
+  }
+
+  qint64 size = _file.size();
+  if (size < (qint64)sizeof(HmfHeader))
+  {
+    throw HootException(QString("Invalid map file (too small): %1").arg(url));
+  }
+
+  // map the whole file; records are used in place
+  _data = _file.map(0, size);
+  if (_data == 0)
+  {
+    throw HootException(QString("Error memory mapping map file: %1").arg(url));
+  }
+
+  _header = (const HmfHeader*)_data;
+  if (memcmp(_header->magic, HMF_MAGIC, sizeof(HMF_MAGIC)) != 0)
+  {
+    throw HootException(QString("Invalid map file (bad magic): %1").arg(url));
+  }
+  if (_header->version != HMF_VERSION)
+  {
+    throw HootException(QString("Unsupported map file version (%1): %2")
+                        .arg(_header->version).arg(url));
+  }
+
+  _stringOffsets = (const quint64*)(_data + _header->stringOffsetsPos);
+  quint64 expectedSize = _header->stringBlobPos + _stringOffsets[_header->stringCount];
+  if ((quint64)size < expectedSize)
+  {
+    throw HootException(QString("Invalid map file (truncated): %1").arg(url));
+  }
+
+  _nodeRecords = (const HmfNodeRecord*)(_data + _header->nodeRecordsPos);
+  _wayRecords = (const HmfWayRecord*)(_data + _header->wayRecordsPos);
+  _wayNodeIds = (const qint64*)(_data + _header->wayNodesPos);
+  _relationRecords = (const HmfRelationRecord*)(_data + _header->relationRecordsPos);
+  _relationMembers = (const HmfRelationMember*)(_data + _header->relationMembersPos);
+  _tagPairs = (const HmfTagPair*)(_data + _header->tagPairsPos);
+  _stringBlob = (const char*)(_data + _header->stringBlobPos);
+}
+
+void HootMapFileReader::close()
+{
+  if (_file.isOpen())
+  {
+    _file.close();
+  }
+  _data = 0;
+  _header = 0;
+  _nodeRecords = 0;
+  _wayRecords = 0;
+  _wayNodeIds = 0;
+  _relationRecords = 0;
+  _relationMembers = 0;
+  _tagPairs = 0;
+  _stringOffsets = 0;
+  _stringBlob = 0;
+  _nodeCache.clear();
+  _wayCache.clear();
+  _relationCache.clear();
+  _srs.reset();
+}
+
+void HootMapFileReader::_checkOpen() const
+{
+  if (_header == 0)
+  {
+    throw HootException("Please open the map file before attempting to read.");
+  }
+}
+
+QString HootMapFileReader::_string(quint32 idx) const
+{
+  if (idx == HMF_NO_STRING)
+  {
+    return QString();
+  }
+  if ((quint64)idx >= _header->stringCount)
+  {
+    throw HootException(QString("Invalid map file (bad string index %1)").arg(idx));
+  }
+  quint64 start = _stringOffsets[idx];
+  quint64 end = _stringOffsets[idx + 1];
+  return QString::fromUtf8(_stringBlob + start, (int)(end - start));
+}
+
+void HootMapFileReader::_applyTags(quint64 tagStart, quint32 tagCount, const ElementPtr& e) const
+{
+  for (quint32 i = 0; i < tagCount; i++)
+  {
+    const HmfTagPair& tp = _tagPairs[tagStart + i];
+    e->setTag(_string(tp.key), _string(tp.value));
+  }
+}
+
+NodePtr HootMapFileReader::_materializeNode(const HmfNodeRecord& r) const
+{
+  NodePtr result(new Node(Status(r.status), r.id, r.x, r.y, r.circularError));
+  _applyTags(r.tagStart, r.tagCount, result);
+  _nodeCache.insert(r.id, result);
+  return result;
+}
+
+WayPtr HootMapFileReader::_materializeWay(const HmfWayRecord& r) const
+{
+  WayPtr result(new Way(Status(r.status), r.id, r.circularError));
+  for (quint32 i = 0; i < r.nodeCount; i++)
+  {
+    result->addNode(_wayNodeIds[r.nodeStart + i]);
+  }
+  _applyTags(r.tagStart, r.tagCount, result);
+  _wayCache.insert(r.id, result);
+  return result;
+}
+
+RelationPtr HootMapFileReader::_materializeRelation(const HmfRelationRecord& r) const
+{
+  RelationPtr result(new Relation(Status(r.status), r.id, r.circularError, _string(r.typeIdx)));
+  for (quint32 i = 0; i < r.memberCount; i++)
+  {
+    const HmfRelationMember& m = _relationMembers[r.memberStart + i];
+    result->addElement(_string(m.roleIdx), ElementType((ElementType::Type)m.type), m.ref);
+  }
+  _applyTags(r.tagStart, r.tagCount, result);
+  _relationCache.insert(r.id, result);
+  return result;
+}
+
+boost::shared_ptr<OGRSpatialReference> HootMapFileReader::getProjection() const
+{
+  _checkOpen();
+  if (_srs == 0 && _header->srsWktIdx != HMF_NO_STRING)
+  {
+    QByteArray wkt = _string(_header->srsWktIdx).toUtf8();
+    boost::shared_ptr<OGRSpatialReference> srs(new OGRSpatialReference());
+    char* wktData = wkt.data();
+    if (srs->importFromWkt(&wktData) != OGRERR_NONE)
+    {
+      throw HootException(QString("Error parsing projection WKT in map file: %1")
+                          .arg(_file.fileName()));
+    }
+    _srs = srs;
+  }
+  return _srs;
+}
+
+bool HootMapFileReader::containsElement(const ElementId& eid) const
+{
+  switch (eid.getType().getEnum())
+  {
+  case ElementType::Node:
+    return containsNode(eid.getId());
+  case ElementType::Way:
+    return containsWay(eid.getId());
+  case ElementType::Relation:
+    return containsRelation(eid.getId());
+  default:
+    return false;
+  }
+}
+
+ConstElementPtr HootMapFileReader::getElement(const ElementId& id) const
+{
+  switch (id.getType().getEnum())
+  {
+  case ElementType::Node:
+    return getNode(id.getId());
+  case ElementType::Way:
+    return getWay(id.getId());
+  case ElementType::Relation:
+    return getRelation(id.getId());
+  default:
+    throw HootException("Unexpected element type.");
+  }
+}
+
+const ConstNodePtr HootMapFileReader::getNode(long id) const
+{
+  _checkOpen();
+  QHash<long, NodePtr>::const_iterator it = _nodeCache.find(id);
+  if (it != _nodeCache.end())
+  {
+    return it.value();
+  }
+  const HmfNodeRecord* r = findRecord(_nodeRecords, _header->nodeCount, id);
+  if (r == 0)
+  {
+    return ConstNodePtr();
+  }
+  return _materializeNode(*r);
+}
+
+const NodePtr HootMapFileReader::getNode(long id)
+{
+  _checkOpen();
+  QHash<long, NodePtr>::const_iterator it = _nodeCache.find(id);
+  if (it != _nodeCache.end())
+  {
+    return it.value();
+  }
+  const HmfNodeRecord* r = findRecord(_nodeRecords, _header->nodeCount, id);
+  if (r == 0)
+  {
+    return NodePtr();
+  }
+  return _materializeNode(*r);
+}
+
+const ConstWayPtr HootMapFileReader::getWay(long id) const
+{
+  _checkOpen();
+  QHash<long, WayPtr>::const_iterator it = _wayCache.find(id);
+  if (it != _wayCache.end())
+  {
+    return it.value();
+  }
+  const HmfWayRecord* r = findRecord(_wayRecords, _header->wayCount, id);
+  if (r == 0)
+  {
+    return ConstWayPtr();
+  }
+  return _materializeWay(*r);
+}
+
+const WayPtr HootMapFileReader::getWay(long id)
+{
+  _checkOpen();
+  QHash<long, WayPtr>::const_iterator it = _wayCache.find(id);
+  if (it != _wayCache.end())
+  {
+    return it.value();
+  }
+  const HmfWayRecord* r = findRecord(_wayRecords, _header->wayCount, id);
+  if (r == 0)
+  {
+    return WayPtr();
+  }
+  return _materializeWay(*r);
+}
+
+const ConstRelationPtr HootMapFileReader::getRelation(long id) const
+{
+  _checkOpen();
+  QHash<long, RelationPtr>::const_iterator it = _relationCache.find(id);
+  if (it != _relationCache.end())
+  {
+    return it.value();
+  }
+  const HmfRelationRecord* r = findRecord(_relationRecords, _header->relationCount, id);
+  if (r == 0)
+  {
+    return ConstRelationPtr();
+  }
+  return _materializeRelation(*r);
+}
+
+const RelationPtr HootMapFileReader::getRelation(long id)
+{
+  _checkOpen();
+  QHash<long, RelationPtr>::const_iterator it = _relationCache.find(id);
+  if (it != _relationCache.end())
+  {
+    return it.value();
+  }
+  const HmfRelationRecord* r = findRecord(_relationRecords, _header->relationCount, id);
+  if (r == 0)
+  {
+    return RelationPtr();
+  }
+  return _materializeRelation(*r);
+}
+
+bool HootMapFileReader::containsNode(long id) const
+{
+  _checkOpen();
+  return findRecord(_nodeRecords, _header->nodeCount, id) != 0;
+}
+
+bool HootMapFileReader::containsWay(long id) const
+{
+  _checkOpen();
+  return findRecord(_wayRecords, _header->wayCount, id) != 0;
+}
+
+bool HootMapFileReader::containsRelation(long id) const
+{
+  _checkOpen();
+  return findRecord(_relationRecords, _header->relationCount, id) != 0;
+}
+
+vector<long> HootMapFileReader::getWayIdsInEnvelope(const geos::geom::Envelope& e) const
+{
+  _checkOpen();
+  vector<long> result;
+  // a linear scan over the fixed size records; they're contiguous in the
+  // mapped file so this is cheap even for large maps
+  for (quint64 i = 0; i < _header->wayCount; i++)
+  {
+    const HmfWayRecord& r = _wayRecords[i];
+    geos::geom::Envelope wayEnv(r.minX, r.maxX, r.minY, r.maxY);
+    if (e.intersects(wayEnv))
+    {
+      result.push_back(r.id);
+    }
+  }
+  return result;
+}
+
+geos::geom::Envelope HootMapFileReader::getBounds() const
+{
+  _checkOpen();
+  return geos::geom::Envelope(_header->minX, _header->maxX, _header->minY, _header->maxY);
+}
+
+void HootMapFileReader::read(OsmMapPtr map)
+{
+  _checkOpen();
+
+  if (getProjection() != 0)
+  {
+    map->setProjection(getProjection());
+  }
+
+  for (quint64 i = 0; i < _header->nodeCount; i++)
+  {
+    // don't populate the cache on a full read; the map owns the elements
+    NodePtr n(new Node(Status(_nodeRecords[i].status), _nodeRecords[i].id, _nodeRecords[i].x,
+                       _nodeRecords[i].y, _nodeRecords[i].circularError));
+    _applyTags(_nodeRecords[i].tagStart, _nodeRecords[i].tagCount, n);
+    map->addNode(n);
+  }
+  for (quint64 i = 0; i < _header->wayCount; i++)
+  {
+    const HmfWayRecord& r = _wayRecords[i];
+    WayPtr w(new Way(Status(r.status), r.id, r.circularError));
+    for (quint32 j = 0; j < r.nodeCount; j++)
+    {
+      w->addNode(_wayNodeIds[r.nodeStart + j]);
+    }
+    _applyTags(r.tagStart, r.tagCount, w);
+    map->addWay(w);
+  }
+  for (quint64 i = 0; i < _header->relationCount; i++)
+  {
+    const HmfRelationRecord& r = _relationRecords[i];
+    RelationPtr rel(new Relation(Status(r.status), r.id, r.circularError, _string(r.typeIdx)));
+    for (quint32 j = 0; j < r.memberCount; j++)
+    {
+      const HmfRelationMember& m = _relationMembers[r.memberStart + j];
+      rel->addElement(_string(m.roleIdx), ElementType((ElementType::Type)m.type), m.ref);
+    }
+    _applyTags(r.tagStart, r.tagCount, rel);
+    map->addRelation(rel);
+  }
+
+  close();
+}
+
+}
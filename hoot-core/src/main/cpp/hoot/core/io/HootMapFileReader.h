@@ -0,0 +1,161 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef HOOTMAPFILEREADER_H
+#define HOOTMAPFILEREADER_H
+
+// hoot
+#include <hoot/core/elements/ElementProvider.h>
+#include <hoot/core/io/HootMapFileFormat.h>
+#include <hoot/core/io/OsmMapReader.h>
+
+// geos
+#include <geos/geom/Envelope.h>
+
+// Qt
+#include <QFile>
+#include <QHash>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Reads the native map file format (.hmf) written by HootMapFileWriter. See
+ * HootMapFileFormat.h for the layout.
+ *
+ * The file is memory mapped rather than parsed: open() only validates the
+ * header, so opening a multi-gigabyte map is nearly instant. read() populates
+ * an OsmMap in the usual way, but the class is also an ElementProvider, so
+ * callers that only touch part of the map can leave it on disk and let
+ * individual elements materialize (and be cached) on demand through
+ * getNode()/getWay()/getRelation().
+ *
+ * Element ids, statuses and circular errors are stored in the file, so
+ * setDefaultStatus() and setUseDataSourceIds() have no effect here - the
+ * format is a faithful intermediate, not an import path.
+ */
+class HootMapFileReader : public OsmMapReader, public ElementProvider
+{
+public:
+
+  static std::string className() { return "hoot::HootMapFileReader"; }
+
+  HootMapFileReader();
+
+  virtual ~HootMapFileReader();
+
+  virtual bool isSupported(QString url) { return url.toLower().endsWith(".hmf"); }
+
+  virtual void open(QString url);
+
+  void close();
+
+  virtual void read(OsmMapPtr map);
+
+  virtual void setDefaultStatus(Status status) { _defaultStatus = status; }
+
+  virtual void setUseDataSourceIds(bool useDataSourceIds) { _useDataSourceIds = useDataSourceIds; }
+
+  // ElementProvider interface - elements materialize lazily and are cached
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
+
+  virtual bool containsElement(const ElementId& eid) const;
+
+  virtual ConstElementPtr getElement(const ElementId& id) const;
+
+  virtual const ConstNodePtr getNode(long id) const;
+
+  virtual const NodePtr getNode(long id);
+
+  virtual const ConstRelationPtr getRelation(long id) const;
+
+  virtual const RelationPtr getRelation(long id);
+
+  virtual const ConstWayPtr getWay(long id) const;
+
+  virtual const WayPtr getWay(long id);
+
+  virtual bool containsNode(long id) const;
+
+  virtual bool containsRelation(long id) const;
+
+  virtual bool containsWay(long id) const;
+
+  /**
+   * Returns the ids of all ways whose envelope intersects e, using the
+   * envelopes stored in the way records. No elements are materialized.
+   */
+  std::vector<long> getWayIdsInEnvelope(const geos::geom::Envelope& e) const;
+
+  /**
+   * Returns the envelope of the whole map, as recorded at write time.
+   */
+  geos::geom::Envelope getBounds() const;
+
+private:
+
+  QFile _file;
+  const uchar* _data;
+
+  Status _defaultStatus;
+  bool _useDataSourceIds;
+
+  // typed views into the mapped file
+  const HmfHeader* _header;
+  const HmfNodeRecord* _nodeRecords;
+  const HmfWayRecord* _wayRecords;
+  const qint64* _wayNodeIds;
+  const HmfRelationRecord* _relationRecords;
+  const HmfRelationMember* _relationMembers;
+  const HmfTagPair* _tagPairs;
+  const quint64* _stringOffsets;
+  const char* _stringBlob;
+
+  // elements materialized so far
+  mutable QHash<long, NodePtr> _nodeCache;
+  mutable QHash<long, WayPtr> _wayCache;
+  mutable QHash<long, RelationPtr> _relationCache;
+
+  mutable boost::shared_ptr<OGRSpatialReference> _srs;
+
+  void _checkOpen() const;
+
+  QString _string(quint32 idx) const;
+
+  void _applyTags(quint64 tagStart, quint32 tagCount, const ElementPtr& e) const;
+
+  NodePtr _materializeNode(const HmfNodeRecord& r) const;
+  WayPtr _materializeWay(const HmfWayRecord& r) const;
+  RelationPtr _materializeRelation(const HmfRelationRecord& r) const;
+};
+
+}
+
+#endif // HOOTMAPFILEREADER_H
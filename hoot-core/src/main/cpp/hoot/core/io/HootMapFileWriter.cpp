@@ -0,0 +1,321 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "HootMapFileWriter.h"
+
+// hoot
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+
+// GDAL
+#include <ogr_spatialref.h>
+
+// geos
+#include <geos/geom/Envelope.h>
+
+// Standard
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using namespace std;
+
+namespace hoot
+{
+
+HOOT_FACTORY_REGISTER(OsmMapWriter, HootMapFileWriter)
+
+HootMapFileWriter::HootMapFileWriter()
+{
+}
+
+HootMapFileWriter::~HootMapFileWriter()
+{
+  close();
+}
+
+void HootMapFileWriter::open(QString url)
+{
+  _file.setFileName(url);
+  if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    throw HootException(QString("Error opening for writing: %1").arg(url));
+  }
+}
+
+void HootMapFileWriter::close()
+{
+  if (_file.isOpen())
+  {
+    _file.close();
+  }
+}
+
+quint32 HootMapFileWriter::_getStringIndex(const QString& s)
+{
+  QHash<QString, quint32>::const_iterator it = _stringIndexes.find(s);
+  if (it != _stringIndexes.end())
+  {
+    return it.value();
+  }
+  quint32 result = (quint32)_strings.size();
+  _strings.push_back(s.toUtf8());
+  _stringIndexes.insert(s, result);
+  return result;
+}
+
+void HootMapFileWriter::_addTags(const ConstElementPtr& e, quint64& tagStart, quint32& tagCount)
+{
+  const Tags& tags = e->getTags();
+  tagStart = _tagPairs.size();
+  tagCount = 0;
+  for (Tags::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    HmfTagPair tp;
+    tp.key = _getStringIndex(it.key());
+    tp.value = _getStringIndex(it.value());
+    _tagPairs.push_back(tp);
+    tagCount++;
+  }
+}
+
+void HootMapFileWriter::_addNodes(ConstOsmMapPtr map)
+{
+  const NodeMap& nodes = map->getNodes();
+  vector<long> ids;
+  ids.reserve(nodes.size());
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    ids.push_back(it->first);
+  }
+  // records are sorted by id so the reader can binary search the mapped array
+  sort(ids.begin(), ids.end());
+
+  _nodeRecords.reserve(ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    const ConstNodePtr& n = map->getNode(ids[i]);
+    HmfNodeRecord r;
+    memset(&r, 0, sizeof(r));
+    r.id = n->getId();
+    r.x = n->getX();
+    r.y = n->getY();
+    r.circularError = n->getCircularError();
+    r.status = n->getStatus().getEnum();
+    _addTags(n, r.tagStart, r.tagCount);
+    _nodeRecords.push_back(r);
+  }
+}
+
+void HootMapFileWriter::_addWays(ConstOsmMapPtr map)
+{
+  const WayMap& ways = map->getWays();
+  vector<long> ids;
+  ids.reserve(ways.size());
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    ids.push_back(it->first);
+  }
+  sort(ids.begin(), ids.end());
+
+  _wayRecords.reserve(ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    const ConstWayPtr& w = map->getWay(ids[i]);
+    HmfWayRecord r;
+    memset(&r, 0, sizeof(r));
+    r.id = w->getId();
+    r.circularError = w->getCircularError();
+    r.status = w->getStatus().getEnum();
+
+    auto_ptr<geos::geom::Envelope> env(w->getEnvelope(map));
+    r.minX = env->getMinX();
+    r.minY = env->getMinY();
+    r.maxX = env->getMaxX();
+    r.maxY = env->getMaxY();
+
+    const vector<long>& nodeIds = w->getNodeIds();
+    r.nodeStart = _wayNodeIds.size();
+    r.nodeCount = (quint32)nodeIds.size();
+    for (size_t j = 0; j < nodeIds.size(); j++)
+    {
+      _wayNodeIds.push_back(nodeIds[j]);
+    }
+
+    _addTags(w, r.tagStart, r.tagCount);
+    _wayRecords.push_back(r);
+  }
+}
+
+void HootMapFileWriter::_addRelations(ConstOsmMapPtr map)
+{
+  const RelationMap& relations = map->getRelations();
+  vector<long> ids;
+  ids.reserve(relations.size());
+  for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
+  {
+    ids.push_back(it->first);
+  }
+  sort(ids.begin(), ids.end());
+
+  _relationRecords.reserve(ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    const ConstRelationPtr& rel = map->getRelation(ids[i]);
+    HmfRelationRecord r;
+    memset(&r, 0, sizeof(r));
+    r.id = rel->getId();
+    r.circularError = rel->getCircularError();
+    r.status = rel->getStatus().getEnum();
+    r.typeIdx = _getStringIndex(rel->getType());
+
+    const vector<RelationData::Entry>& members = rel->getMembers();
+    r.memberStart = _relationMembers.size();
+    r.memberCount = (quint32)members.size();
+    for (size_t j = 0; j < members.size(); j++)
+    {
+      HmfRelationMember m;
+      m.ref = members[j].getElementId().getId();
+      m.type = members[j].getElementId().getType().getEnum();
+      m.roleIdx = _getStringIndex(members[j].getRole());
+      _relationMembers.push_back(m);
+    }
+
+    _addTags(rel, r.tagStart, r.tagCount);
+    _relationRecords.push_back(r);
+  }
+}
+
+void HootMapFileWriter::_writeSections(ConstOsmMapPtr map)
+{
+  HmfHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, HMF_MAGIC, sizeof(header.magic));
+  header.version = HMF_VERSION;
+  header.nodeCount = _nodeRecords.size();
+  header.wayCount = _wayRecords.size();
+  header.relationCount = _relationRecords.size();
+  header.wayNodeCount = _wayNodeIds.size();
+  header.relationMemberCount = _relationMembers.size();
+  header.tagPairCount = _tagPairs.size();
+
+  geos::geom::Envelope bounds = CalculateMapBoundsVisitor::getGeosBounds(map);
+  header.minX = bounds.getMinX();
+  header.minY = bounds.getMinY();
+  header.maxX = bounds.getMaxX();
+  header.maxY = bounds.getMaxY();
+
+  header.srsWktIdx = HMF_NO_STRING;
+  if (map->getProjection() != 0)
+  {
+    char* wkt;
+    map->getProjection()->exportToWkt(&wkt);
+    header.srsWktIdx = _getStringIndex(QString::fromUtf8(wkt));
+    free(wkt);
+  }
+
+  header.stringCount = _strings.size();
+
+  // lay the sections out back to back after the header
+  quint64 pos = sizeof(HmfHeader);
+  header.nodeRecordsPos = pos;
+  pos += header.nodeCount * sizeof(HmfNodeRecord);
+  header.wayRecordsPos = pos;
+  pos += header.wayCount * sizeof(HmfWayRecord);
+  header.wayNodesPos = pos;
+  pos += header.wayNodeCount * sizeof(qint64);
+  header.relationRecordsPos = pos;
+  pos += header.relationCount * sizeof(HmfRelationRecord);
+  header.relationMembersPos = pos;
+  pos += header.relationMemberCount * sizeof(HmfRelationMember);
+  header.tagPairsPos = pos;
+  pos += header.tagPairCount * sizeof(HmfTagPair);
+  header.stringOffsetsPos = pos;
+  pos += (header.stringCount + 1) * sizeof(quint64);
+  header.stringBlobPos = pos;
+
+  _file.write((const char*)&header, sizeof(header));
+  if (header.nodeCount > 0)
+    _file.write((const char*)&_nodeRecords[0], header.nodeCount * sizeof(HmfNodeRecord));
+  if (header.wayCount > 0)
+    _file.write((const char*)&_wayRecords[0], header.wayCount * sizeof(HmfWayRecord));
+  if (header.wayNodeCount > 0)
+    _file.write((const char*)&_wayNodeIds[0], header.wayNodeCount * sizeof(qint64));
+  if (header.relationCount > 0)
+    _file.write((const char*)&_relationRecords[0],
+                header.relationCount * sizeof(HmfRelationRecord));
+  if (header.relationMemberCount > 0)
+    _file.write((const char*)&_relationMembers[0],
+                header.relationMemberCount * sizeof(HmfRelationMember));
+  if (header.tagPairCount > 0)
+    _file.write((const char*)&_tagPairs[0], header.tagPairCount * sizeof(HmfTagPair));
+
+  // string offsets, then the blob itself
+  quint64 offset = 0;
+  for (size_t i = 0; i < _strings.size(); i++)
+  {
+    _file.write((const char*)&offset, sizeof(offset));
+    offset += _strings[i].size();
+  }
+  _file.write((const char*)&offset, sizeof(offset));
+  for (size_t i = 0; i < _strings.size(); i++)
+  {
+    _file.write(_strings[i].constData(), _strings[i].size());
+  }
+
+  if (_file.error() != QFile::NoError)
+  {
+    throw HootException(QString("Error writing map file: %1").arg(_file.fileName()));
+  }
+}
+
+void HootMapFileWriter::write(ConstOsmMapPtr map)
+{
+  if (!_file.isOpen())
+  {
+    throw HootException("Please open the map file before attempting to write.");
+  }
+
+  _stringIndexes.clear();
+  _strings.clear();
+  _nodeRecords.clear();
+  _wayRecords.clear();
+  _wayNodeIds.clear();
+  _relationRecords.clear();
+  _relationMembers.clear();
+  _tagPairs.clear();
+
+  _addNodes(map);
+  _addWays(map);
+  _addRelations(map);
+  _writeSections(map);
+
+  close();
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef HOOTMAPFILEWRITER_H
+#define HOOTMAPFILEWRITER_H
+
+// hoot
+#include <hoot/core/io/HootMapFileFormat.h>
+#include <hoot/core/io/OsmMapWriter.h>
+
+// Qt
+#include <QFile>
+#include <QHash>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Writes an OsmMap to the native map file format (.hmf). See
+ * HootMapFileFormat.h for the layout and rationale. The resulting file can be
+ * memory mapped by HootMapFileReader, making it a cheap way to hand a map
+ * from one pipeline stage to the next without re-parsing XML or PBF.
+ */
+class HootMapFileWriter : public OsmMapWriter
+{
+public:
+
+  static std::string className() { return "hoot::HootMapFileWriter"; }
+
+  HootMapFileWriter();
+
+  virtual ~HootMapFileWriter();
+
+  virtual bool isSupported(QString url) { return url.toLower().endsWith(".hmf"); }
+
+  virtual void open(QString url);
+
+  void close();
+
+  virtual void write(ConstOsmMapPtr map);
+
+private:
+
+  QFile _file;
+
+  // string table under construction
+  QHash<QString, quint32> _stringIndexes;
+  std::vector<QByteArray> _strings;
+
+  // record sections under construction
+  std::vector<HmfNodeRecord> _nodeRecords;
+  std::vector<HmfWayRecord> _wayRecords;
+  std::vector<qint64> _wayNodeIds;
+  std::vector<HmfRelationRecord> _relationRecords;
+  std::vector<HmfRelationMember> _relationMembers;
+  std::vector<HmfTagPair> _tagPairs;
+
+  /**
+   * Returns the string table index for s, adding it if needed.
+   */
+  quint32 _getStringIndex(const QString& s);
+
+  /**
+   * Appends an element's tags to the tag pair section and records their
+   * location in the given record fields.
+   */
+  void _addTags(const ConstElementPtr& e, quint64& tagStart, quint32& tagCount);
+
+  void _addNodes(ConstOsmMapPtr map);
+  void _addWays(ConstOsmMapPtr map);
+  void _addRelations(ConstOsmMapPtr map);
+
+  void _writeSections(ConstOsmMapPtr map);
+};
+
+}
+
+#endif // HOOTMAPFILEWRITER_H
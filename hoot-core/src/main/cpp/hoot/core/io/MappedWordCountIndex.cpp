@@ -0,0 +1,242 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "MappedWordCountIndex.h"
+
+// hoot
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/io/WordCount.h>
+
+// Qt
+#include <QDataStream>
+#include <QtEndian>
+
+// Standard
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+  const quint32 INDEX_MAGIC = 0x48575749; // "HWWI"
+  // bump this when the binary layout changes so incompatible files are rejected.
+  const quint32 INDEX_VERSION = 1;
+  // magic, version, total count, entry count, bucket count
+  const qint64 HEADER_SIZE = 4 + 4 + 8 + 4 + 4;
+  // hash, string offset, count
+  const qint64 BUCKET_SIZE = 4 + 4 + 8;
+
+  struct Bucket
+  {
+    quint32 hash;
+    quint32 offset;
+    quint64 count;
+  };
+}
+
+quint32 MappedWordCountIndex::_hashWord(const QByteArray& utf8Word)
+{
+  // FNV-1a; fixed here rather than borrowed so the on-disk format can't drift.
+  quint32 h = 2166136261u;
+  for (int i = 0; i < utf8Word.size(); i++)
+  {
+    h = (h ^ (uchar)utf8Word[i]) * 16777619u;
+  }
+  return h;
+}
+
+MappedWordCountIndex::MappedWordCountIndex(const QString& path) :
+  _file(path)
+{
+  if (_file.open(QIODevice::ReadOnly) == false)
+  {
+    throw HootException("Error opening word count index: " + path);
+  }
+
+  const qint64 size = _file.size();
+  if (size < HEADER_SIZE)
+  {
+    throw HootException("Word count index is truncated: " + path);
+  }
+
+  const uchar* data = _file.map(0, size);
+  if (data == 0)
+  {
+    throw HootException("Error mapping word count index: " + path);
+  }
+
+  const quint32 magic = qFromLittleEndian<quint32>(data);
+  const quint32 version = qFromLittleEndian<quint32>(data + 4);
+  if (magic != INDEX_MAGIC || version != INDEX_VERSION)
+  {
+    throw HootException("Unrecognized word count index format: " + path);
+  }
+
+  _totalCount = (long)qFromLittleEndian<quint64>(data + 8);
+  _wordCount = (int)qFromLittleEndian<quint32>(data + 16);
+  _bucketCount = qFromLittleEndian<quint32>(data + 20);
+
+  if (_bucketCount == 0 || size < HEADER_SIZE + (qint64)_bucketCount * BUCKET_SIZE)
+  {
+    throw HootException("Word count index is truncated: " + path);
+  }
+
+  _buckets = data + HEADER_SIZE;
+  _strings = _buckets + (qint64)_bucketCount * BUCKET_SIZE;
+  _stringsSize = size - (HEADER_SIZE + (qint64)_bucketCount * BUCKET_SIZE);
+}
+
+long MappedWordCountIndex::getCount(const QByteArray& utf8Word) const
+{
+  const quint32 h = _hashWord(utf8Word);
+  const quint32 mask = _bucketCount - 1;
+  quint32 idx = h & mask;
+
+  for (quint32 probes = 0; probes < _bucketCount; probes++)
+  {
+    const uchar* bucket = _buckets + (qint64)idx * BUCKET_SIZE;
+    const quint64 count = qFromLittleEndian<quint64>(bucket + 8);
+    // an empty bucket terminates the probe sequence; the word isn't in the index.
+    if (count == 0)
+    {
+      return 0;
+    }
+
+    if (qFromLittleEndian<quint32>(bucket) == h)
+    {
+      const quint32 offset = qFromLittleEndian<quint32>(bucket + 4);
+      if ((qint64)offset + 2 <= _stringsSize)
+      {
+        const uchar* s = _strings + offset;
+        const quint16 length = qFromLittleEndian<quint16>(s);
+        if (length == utf8Word.size() && (qint64)offset + 2 + length <= _stringsSize &&
+            memcmp(s + 2, utf8Word.constData(), length) == 0)
+        {
+          return (long)count;
+        }
+      }
+    }
+
+    idx = (idx + 1) & mask;
+  }
+
+  return 0;
+}
+
+void MappedWordCountIndex::build(const QString& path, const QVector<WordCount>& words)
+{
+  // size the table to a power of two at no more than half full so probe sequences stay short.
+  quint32 bucketCount = 1;
+  while (bucketCount < (quint32)words.size() * 2)
+  {
+    bucketCount *= 2;
+  }
+
+  vector<Bucket> buckets(bucketCount);
+  for (quint32 i = 0; i < bucketCount; i++)
+  {
+    buckets[i].count = 0;
+  }
+
+  QByteArray strings;
+  quint64 totalCount = 0;
+  quint32 entryCount = 0;
+  const quint32 mask = bucketCount - 1;
+
+  for (int i = 0; i < words.size(); i++)
+  {
+    if (words[i].count <= 0)
+    {
+      continue;
+    }
+    const QByteArray utf8Word = words[i].word.toUtf8();
+    if (utf8Word.size() > 65535)
+    {
+      throw HootException("Word is too long for the word count index: " + words[i].word);
+    }
+
+    totalCount += (quint64)words[i].count;
+
+    const quint32 h = _hashWord(utf8Word);
+    quint32 idx = h & mask;
+    while (buckets[idx].count != 0)
+    {
+      // sum the counts when the same word is passed more than once.
+      if (buckets[idx].hash == h)
+      {
+        const uchar* s = (const uchar*)strings.constData() + buckets[idx].offset;
+        const quint16 length = qFromLittleEndian<quint16>(s);
+        if (length == utf8Word.size() && memcmp(s + 2, utf8Word.constData(), length) == 0)
+        {
+          break;
+        }
+      }
+      idx = (idx + 1) & mask;
+    }
+
+    if (buckets[idx].count != 0)
+    {
+      buckets[idx].count += (quint64)words[i].count;
+    }
+    else
+    {
+      buckets[idx].hash = h;
+      buckets[idx].offset = (quint32)strings.size();
+      buckets[idx].count = (quint64)words[i].count;
+      quint16 length = (quint16)utf8Word.size();
+      quint16 lengthLe = qToLittleEndian<quint16>(length);
+      strings.append((const char*)&lengthLe, 2);
+      strings.append(utf8Word);
+      entryCount++;
+    }
+  }
+
+  QFile f(path);
+  if (f.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+  {
+    throw HootException("Error opening word count index for writing: " + path);
+  }
+
+  QDataStream ds(&f);
+  ds.setByteOrder(QDataStream::LittleEndian);
+  ds << INDEX_MAGIC << INDEX_VERSION;
+  ds << (quint64)totalCount;
+  ds << entryCount << bucketCount;
+  for (quint32 i = 0; i < bucketCount; i++)
+  {
+    ds << buckets[i].hash << buckets[i].offset << buckets[i].count;
+  }
+  if (ds.writeRawData(strings.constData(), strings.size()) != strings.size())
+  {
+    throw HootException("Error writing word count index: " + path);
+  }
+}
+
+}
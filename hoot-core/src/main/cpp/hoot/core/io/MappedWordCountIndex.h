@@ -0,0 +1,99 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef MAPPEDWORDCOUNTINDEX_H
+#define MAPPEDWORDCOUNTINDEX_H
+
+// Qt
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+namespace hoot
+{
+
+class WordCount;
+
+/**
+ * A read-only word frequency index backed by a memory mapped file.
+ *
+ * The index is built offline (see build and WordCountWriter::writeIndex) as an open addressing
+ * hash table with a low load factor, so a lookup touches one or two cache lines and the file can
+ * be used directly through the mapping without any parsing or loading step. Because the mapping
+ * is read-only, the kernel shares the pages between every process on the box that opens the same
+ * file -- the dictionary costs RAM once per host instead of once per process.
+ *
+ * All multi-byte values in the file are little-endian. Words are matched by their exact UTF-8
+ * bytes; any case folding or normalization is the caller's business (see
+ * MappedWordWeightDictionary).
+ */
+class MappedWordCountIndex
+{
+public:
+
+  /**
+   * Maps the index at the given path. Throws if the file is missing, truncated, or wasn't
+   * written by a compatible version of build.
+   */
+  MappedWordCountIndex(const QString& path);
+
+  /**
+   * Builds an index file from the given words. Duplicate words have their counts summed.
+   */
+  static void build(const QString& path, const QVector<WordCount>& words);
+
+  /**
+   * Returns the count for the exact UTF-8 word, or 0 if the word isn't in the index.
+   */
+  long getCount(const QByteArray& utf8Word) const;
+
+  /**
+   * The sum of all counts in the index.
+   */
+  long getTotalCount() const { return _totalCount; }
+
+  /**
+   * The number of distinct words in the index.
+   */
+  int getWordCount() const { return _wordCount; }
+
+private:
+
+  QFile _file;
+  const uchar* _buckets;
+  const uchar* _strings;
+  qint64 _stringsSize;
+  quint32 _bucketCount;
+  long _totalCount;
+  int _wordCount;
+
+  static quint32 _hashWord(const QByteArray& utf8Word);
+};
+
+}
+
+#endif // MAPPEDWORDCOUNTINDEX_H
@@ -28,6 +28,7 @@
 
 // Hoot
 #include <hoot/core/util/Factory.h>
+#include <hoot/core/io/ObjectOutputStream.h>
 #include <hoot/core/io/Serializable.h>
 
 using namespace std;
@@ -36,17 +37,176 @@ using namespace Tgs;
 namespace hoot
 {
 
+namespace
+{
+  quint64 readVarint(QDataStream& in)
+  {
+    quint64 result = 0;
+    int shift = 0;
+    quint8 b;
+    do
+    {
+      if (shift > 63)
+      {
+        throw HootException("Invalid varint in object stream.");
+      }
+      in >> b;
+      result |= (quint64)(b & 0x7F) << shift;
+      shift += 7;
+    }
+    while (b & 0x80);
+    return result;
+  }
+}
+
 ObjectInputStream::ObjectInputStream(istream &is) :
   _stdIoDevice(new StdIoDevice(is))
 {
   _stream = new QDataStream(_stdIoDevice.get());
   // delete it when we're done.
   _streamDelete.reset(_stream);
+  _version = 0;
+  _versionChecked = false;
+  _initialWord = 0;
+  _haveInitialWord = false;
 }
 
 ObjectInputStream::ObjectInputStream(QDataStream &is)
 {
   _stream = &is;
+  _version = 0;
+  _versionChecked = false;
+  _initialWord = 0;
+  _haveInitialWord = false;
+}
+
+void ObjectInputStream::_checkVersion()
+{
+  if (_versionChecked)
+  {
+    return;
+  }
+
+  quint32 first;
+  *_stream >> first;
+  if (first == ObjectOutputStream::formatMagic())
+  {
+    quint8 v;
+    *_stream >> v;
+    if (v != 2)
+    {
+      throw HootException(QString("Unsupported object stream version: %1").arg(v));
+    }
+    _version = 2;
+  }
+  else
+  {
+    // version 1 streams have no header, so the word just read is part of the first record
+    _version = 1;
+    _initialWord = first;
+    _haveInitialWord = true;
+  }
+  _versionChecked = true;
+}
+
+void ObjectInputStream::_endRecord()
+{
+  _payloadStream.reset();
+}
+
+quint64 ObjectInputStream::_readCount()
+{
+  _checkVersion();
+  if (_version == 1)
+  {
+    if (_haveInitialWord)
+    {
+      _haveInitialWord = false;
+      return _initialWord;
+    }
+    quint32 count;
+    *_stream >> count;
+    return count;
+  }
+  return readVarint(*_stream);
+}
+
+QDataStream& ObjectInputStream::_recordStream()
+{
+  if (_version >= 2)
+  {
+    return *_payloadStream;
+  }
+  return *_stream;
+}
+
+QString ObjectInputStream::_startRecord()
+{
+  _checkVersion();
+
+  if (_version == 1)
+  {
+    if (_haveInitialWord)
+    {
+      // the word read during version detection was the class name's byte count; read the UTF-16
+      // data the way QDataStream serializes a QString
+      _haveInitialWord = false;
+      if (_initialWord == 0xFFFFFFFF)
+      {
+        return QString();
+      }
+      QByteArray raw((int)_initialWord, 0);
+      if (_stream->readRawData(raw.data(), raw.size()) != raw.size())
+      {
+        throw HootException("Error reading class name from object stream.");
+      }
+      QString result;
+      for (int i = 0; i + 1 < raw.size(); i += 2)
+      {
+        result.append(QChar((ushort)(((uchar)raw[i] << 8) | (uchar)raw[i + 1])));
+      }
+      return result;
+    }
+    QString className;
+    *_stream >> className;
+    return className;
+  }
+
+  const quint64 classId = readVarint(*_stream);
+  if (classId == (quint64)_classNames.size())
+  {
+    const quint64 nameLength = readVarint(*_stream);
+    QByteArray name((int)nameLength, 0);
+    if (_stream->readRawData(name.data(), name.size()) != name.size())
+    {
+      throw HootException("Error reading class name from object stream.");
+    }
+    _classNames.append(QString::fromUtf8(name.constData(), name.size()));
+  }
+  else if (classId > (quint64)_classNames.size())
+  {
+    throw HootException("Corrupt object stream; unknown class id.");
+  }
+  const QString className = _classNames[(int)classId];
+
+  quint8 compressed;
+  *_stream >> compressed;
+  const quint64 payloadLength = readVarint(*_stream);
+  _payloadArray.resize((int)payloadLength);
+  if (_stream->readRawData(_payloadArray.data(), _payloadArray.size()) != _payloadArray.size())
+  {
+    throw HootException("Error reading record payload from object stream.");
+  }
+  if (compressed == 1)
+  {
+    _payloadArray = qUncompress(_payloadArray);
+    if (_payloadArray.isEmpty() && payloadLength > 0)
+    {
+      throw HootException("Error decompressing record payload from object stream.");
+    }
+  }
+  _payloadStream.reset(new QDataStream(_payloadArray));
+  return className;
 }
 
 }
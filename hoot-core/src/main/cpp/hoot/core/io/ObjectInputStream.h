@@ -37,10 +37,12 @@
 
 // Qt
 #include <QDataStream>
+#include <QVector>
 
 // Standard
 #include <memory>
 #include <sstream>
+#include <vector>
 
 // Tgs
 #include <tgs/Io/StdIoDevice.h>
@@ -48,6 +50,11 @@
 namespace hoot
 {
 
+/**
+ * Deserializes objects written by ObjectOutputStream. Both format versions are supported; the
+ * version is detected from the first word of the stream. See ObjectOutputStream for the format
+ * description.
+ */
 class ObjectInputStream
 {
 public:
@@ -65,6 +72,13 @@ public:
   template <class T>
   T* readObject();
 
+  /**
+   * Reads an object array written by ObjectOutputStream::writeObjects, appending to objs. The
+   * caller takes ownership of the returned objects.
+   */
+  template <class T>
+  void readObjects(std::vector<T*>& objs);
+
 private:
   //  Don't allow copy constructor
   ObjectInputStream(const ObjectInputStream&) { }
@@ -73,13 +87,37 @@ private:
   std::auto_ptr<Tgs::StdIoDevice> _stdIoDevice;
   std::auto_ptr<QDataStream> _streamDelete;
   QDataStream* _stream;
+
+  //format version of the stream being read; detected on the first read
+  int _version;
+  bool _versionChecked;
+  //on a version 1 stream the word read during version detection is part of the first record
+  quint32 _initialWord;
+  bool _haveInitialWord;
+  //interned class names for version 2 records, indexed by class id
+  QVector<QString> _classNames;
+  //decompressed payload of the version 2 record currently being read
+  QByteArray _payloadArray;
+  std::auto_ptr<QDataStream> _payloadStream;
+
+  void _checkVersion();
+  void _endRecord();
+  quint64 _readCount();
+  /**
+   * Returns the stream the current record's fields should be read from; the payload buffer for
+   * version 2, the underlying stream for version 1.
+   */
+  QDataStream& _recordStream();
+  /**
+   * Reads the record framing and returns the class name of the next object.
+   */
+  QString _startRecord();
 };
 
 template <class T>
 inline T* ObjectInputStream::readObject()
 {
-  QString className;
-  (*_stream) >> className;
+  const QString className = _startRecord();
   LOG_INFO("Reading: " << className);
   T* result = Factory::getInstance().constructObject<T>(className.toStdString());
   LOG_INFO("type name: " << typeid(result).name());
@@ -91,10 +129,21 @@ inline T* ObjectInputStream::readObject()
     // I don't think we can ever actually get here, but checking doesn't hurt.
     throw HootException("Object must support serializable. (" + className + ")");
   }
-  s->readObject(*_stream);
+  s->readObject(_recordStream());
+  _endRecord();
   return result;
 }
 
+template <class T>
+inline void ObjectInputStream::readObjects(std::vector<T*>& objs)
+{
+  const quint64 count = _readCount();
+  for (quint64 i = 0; i < count; i++)
+  {
+    objs.push_back(readObject<T>());
+  }
+}
+
 }
 
 #endif // OBJECTINPUTSTREAM_H
@@ -26,23 +26,54 @@
  */
 #include "ObjectOutputStream.h"
 
+// Hoot
+#include <hoot/core/util/ConfigOptions.h>
+
 using namespace std;
 
 namespace hoot
 {
 
+namespace
+{
+  //payloads smaller than this aren't worth the compression attempt
+  const int COMPRESSION_THRESHOLD = 1024;
+
+  void writeVarint(QDataStream& out, quint64 v)
+  {
+    while (v >= 0x80)
+    {
+      out << (quint8)((v & 0x7F) | 0x80);
+      v >>= 7;
+    }
+    out << (quint8)v;
+  }
+}
+
 ObjectOutputStream::ObjectOutputStream(std::ostream& ss)
 {
   _ostream = &ss;
   _array.reset(new QByteArray());
   _stream2Delete.reset(new QDataStream(_array.get(), QIODevice::WriteOnly));
   _stream = _stream2Delete.get();
+  _version = ConfigOptions().getObjectSerializationVersion();
+  if (_version < 1 || _version > 2)
+  {
+    throw HootException(QString("Unsupported object serialization version: %1").arg(_version));
+  }
+  _headerWritten = false;
 }
 
 ObjectOutputStream::ObjectOutputStream(QDataStream& os)
 {
   _ostream = NULL;
   _stream = &os;
+  _version = ConfigOptions().getObjectSerializationVersion();
+  if (_version < 1 || _version > 2)
+  {
+    throw HootException(QString("Unsupported object serialization version: %1").arg(_version));
+  }
+  _headerWritten = false;
 }
 
 ObjectOutputStream::~ObjectOutputStream()
@@ -61,5 +92,75 @@ void ObjectOutputStream::flush()
   }
 }
 
+void ObjectOutputStream::_writeCount(quint64 count)
+{
+  if (_version < 2)
+  {
+    *_stream << (quint32)count;
+    return;
+  }
+
+  if (!_headerWritten)
+  {
+    *_stream << formatMagic() << (quint8)2;
+    _headerWritten = true;
+  }
+  writeVarint(*_stream, count);
+}
+
+void ObjectOutputStream::_writeObject(const Serializable& s)
+{
+  if (_version < 2)
+  {
+    *_stream << QString::fromStdString(s.getClassName());
+    s.writeObject(*_stream);
+    return;
+  }
+
+  if (!_headerWritten)
+  {
+    *_stream << formatMagic() << (quint8)2;
+    _headerWritten = true;
+  }
+
+  // intern the class name; the first record of a class carries the name, later records just the id
+  const QString className = QString::fromStdString(s.getClassName());
+  QHash<QString, int>::const_iterator it = _classIds.find(className);
+  if (it == _classIds.end())
+  {
+    const int id = _classIds.size();
+    _classIds.insert(className, id);
+    writeVarint(*_stream, (quint64)id);
+    const QByteArray name = className.toUtf8();
+    writeVarint(*_stream, (quint64)name.size());
+    _stream->writeRawData(name.constData(), name.size());
+  }
+  else
+  {
+    writeVarint(*_stream, (quint64)it.value());
+  }
+
+  // serialize the object into its own buffer so the record can be length prefixed
+  QByteArray payload;
+  {
+    QDataStream ds(&payload, QIODevice::WriteOnly);
+    s.writeObject(ds);
+  }
+
+  quint8 compressed = 0;
+  if (payload.size() >= COMPRESSION_THRESHOLD)
+  {
+    QByteArray candidate = qCompress(payload);
+    if (candidate.size() < payload.size())
+    {
+      compressed = 1;
+      payload = candidate;
+    }
+  }
+
+  *_stream << compressed;
+  writeVarint(*_stream, (quint64)payload.size());
+  _stream->writeRawData(payload.constData(), payload.size());
+}
 
 }
@@ -38,14 +38,31 @@
 
 // Qt
 #include <QDataStream>
+#include <QHash>
 
 // Standard
 #include <memory>
 #include <sstream>
+#include <vector>
 
 namespace hoot
 {
 
+/**
+ * Serializes objects to a stream. Two formats are supported (see
+ * object.serialization.version):
+ *
+ * Version 1 writes the full class name as a Qt DataStream QString followed by the object fields
+ * for every record.
+ *
+ * Version 2 starts the stream with a magic word and version byte. Class names are interned and
+ * written once; each record is the varint class id followed by a compression flag, a varint
+ * payload length and the payload bytes. Payloads over a threshold are zlib compressed when that
+ * makes them smaller. The length prefix lets readers frame records without virtual per field
+ * dispatch and lets bulk arrays round trip through writeObjects/readObjects.
+ *
+ * ObjectInputStream detects the version automatically.
+ */
 class ObjectOutputStream
 {
 public:
@@ -55,6 +72,12 @@ public:
 
   ~ObjectOutputStream();
 
+  /**
+   * The magic word that starts a version 2 stream. A version 1 stream starts with the byte count
+   * of the first class name, which is always much smaller.
+   */
+  static quint32 formatMagic() { return 0x484F4F54; } //"HOOT"
+
   void flush();
 
   template<class T>
@@ -71,8 +94,32 @@ public:
                           "serialized. (" + s->getClassName() + ")");
     }
     LOG_INFO("Writing object: " << s->getClassName());
-    *_stream << QString::fromStdString(s->getClassName());
-    s->writeObject(*_stream);
+    _writeObject(*s);
+    flush();
+  }
+
+  /**
+   * Writes the object count followed by each object so the whole array round trips through
+   * ObjectInputStream::readObjects with a single flush.
+   */
+  template<class T>
+  void writeObjects(const std::vector<T*>& objs)
+  {
+    _writeCount((quint64)objs.size());
+    for (size_t i = 0; i < objs.size(); i++)
+    {
+      const Serializable* s = dynamic_cast<const Serializable*>(objs[i]);
+      if (s == 0)
+      {
+        throw NotImplementedException("The object must implement serializable.");
+      }
+      if (Factory::getInstance().hasClass(s->getClassName()) == false)
+      {
+        throw HootException("The class must be registered with the factory before it can be "
+                            "serialized. (" + s->getClassName() + ")");
+      }
+      _writeObject(*s);
+    }
     flush();
   }
 
@@ -83,6 +130,17 @@ public:
   std::auto_ptr<QDataStream> _stream2Delete;
   std::auto_ptr<QByteArray> _array;
   std::ostream* _ostream;
+
+private:
+  //see object.serialization.version
+  int _version;
+  //true once the version 2 stream header has been written
+  bool _headerWritten;
+  //class name -> interned id for version 2 records
+  QHash<QString, int> _classIds;
+
+  void _writeCount(quint64 count);
+  void _writeObject(const Serializable& s);
 };
 
 }
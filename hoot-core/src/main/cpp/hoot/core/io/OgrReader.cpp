@@ -479,6 +479,11 @@ void OgrReader::open(QString url)
   _d->open(url, "");
 }
 
+void OgrReader::open(QString url, QString layer)
+{
+  _d->open(url, layer);
+}
+
 boost::shared_ptr<OGRSpatialReference> OgrReader::getProjection() const
 {
   return _d->getProjection();
@@ -120,6 +120,11 @@ public:
 
   virtual void open(QString url);
 
+  /**
+   * Opens only the specified layer rather than all geometry layers in url.
+   */
+  void open(QString url, QString layer);
+
   virtual void setUseDataSourceIds(bool useDataSourceIds);
 
   virtual void finalizePartial();
@@ -69,6 +69,15 @@
 
 #include "OgrOptions.h"
 
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+// Standard
+#include <deque>
+
 using namespace geos::geom;
 using namespace std;
 
@@ -97,6 +106,176 @@ static OGRFieldType toOgrFieldType(QVariant::Type t)
   }
 }
 
+/**
+ * A feature that has been translated but not yet written to the OGR data source.
+ */
+struct TranslatedOgrFeature
+{
+  QString tableName;
+  boost::shared_ptr<Feature> feature;
+  boost::shared_ptr<Geometry> geometry;
+};
+
+/**
+ * Bounded queue of translated feature batches between the translating thread and the flush
+ * thread. Only the producer calls enqueue/finish and only the flush thread calls pop/setError.
+ */
+class OgrFeatureQueue
+{
+public:
+
+  OgrFeatureQueue(int batchSize) : _batchSize(batchSize), _maxBatches(8), _finished(false)
+  {
+  }
+
+  void enqueue(const QString& tableName, boost::shared_ptr<Feature> f,
+               boost::shared_ptr<Geometry> g)
+  {
+    TranslatedOgrFeature tf;
+    tf.tableName = tableName;
+    tf.feature = f;
+    tf.geometry = g;
+    _pending.push_back(tf);
+    if ((int)_pending.size() >= _batchSize)
+    {
+      _push();
+    }
+  }
+
+  /**
+   * Flushes any partial batch and tells the flush thread no more features are coming.
+   */
+  void finish()
+  {
+    QMutexLocker lock(&_mutex);
+    if (_pending.empty() == false)
+    {
+      _queue.push_back(std::vector<TranslatedOgrFeature>());
+      _queue.back().swap(_pending);
+    }
+    _finished = true;
+    _notEmpty.wakeAll();
+  }
+
+  /**
+   * Blocks until a batch is available. Returns false once the producer has finished and the
+   * queue is drained, or when an error has been recorded.
+   */
+  bool pop(std::vector<TranslatedOgrFeature>& batch)
+  {
+    QMutexLocker lock(&_mutex);
+    while (_queue.empty() && !_finished && _error.isEmpty())
+    {
+      _notEmpty.wait(&_mutex);
+    }
+    if (!_error.isEmpty() || _queue.empty())
+    {
+      return false;
+    }
+    batch.swap(_queue.front());
+    _queue.pop_front();
+    _notFull.wakeAll();
+    return true;
+  }
+
+  /**
+   * Flush thread side; records the error and unblocks the producer.
+   */
+  void setError(const QString& error)
+  {
+    QMutexLocker lock(&_mutex);
+    if (_error.isEmpty())
+    {
+      _error = error;
+    }
+    _notFull.wakeAll();
+  }
+
+  QString getError()
+  {
+    QMutexLocker lock(&_mutex);
+    return _error;
+  }
+
+private:
+
+  void _push()
+  {
+    QMutexLocker lock(&_mutex);
+    while ((int)_queue.size() >= _maxBatches && _error.isEmpty())
+    {
+      _notFull.wait(&_mutex);
+    }
+    if (!_error.isEmpty())
+    {
+      //the flush thread died; the producer notices via getError and rethrows
+      _pending.clear();
+      return;
+    }
+    _queue.push_back(std::vector<TranslatedOgrFeature>());
+    _queue.back().swap(_pending);
+    _notEmpty.wakeAll();
+  }
+
+  const int _batchSize;
+  //bounds the number of batches in flight so a slow driver can't buffer the whole input
+  const int _maxBatches;
+  //only touched by the producer
+  std::vector<TranslatedOgrFeature> _pending;
+  QMutex _mutex;
+  QWaitCondition _notFull;
+  QWaitCondition _notEmpty;
+  std::deque<std::vector<TranslatedOgrFeature> > _queue;
+  bool _finished;
+  QString _error;
+};
+
+/**
+ * Pops translated feature batches and performs the OGR writes, creating each layer the first time
+ * a feature lands on it. All OGR calls happen on this thread while features are being streamed so
+ * the translation (CPU) and the driver writes (I/O) overlap.
+ */
+class OgrWriterFlushThread : public QThread
+{
+public:
+
+  OgrWriterFlushThread(OgrWriter& writer, OgrFeatureQueue& queue) : _writer(writer), _queue(queue)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      std::vector<TranslatedOgrFeature> batch;
+      while (_queue.pop(batch))
+      {
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+          OGRLayer* layer = _writer._getLayer(batch[i].tableName);
+          if (layer != 0)
+          {
+            _writer._addFeature(layer, batch[i].feature, batch[i].geometry);
+          }
+        }
+      }
+    }
+    catch (const HootException& e)
+    {
+      _queue.setError(e.getWhat());
+    }
+    catch (const std::exception& e)
+    {
+      _queue.setError(QString(e.what()));
+    }
+  }
+
+private:
+
+  OgrWriter& _writer;
+  OgrFeatureQueue& _queue;
+};
+
 OgrWriter::OgrWriter():
   _elementCache(
     new ElementCacheLRU(
@@ -104,6 +283,9 @@ OgrWriter::OgrWriter():
       ConfigOptions().getElementCacheSizeWay(),
       ConfigOptions().getElementCacheSizeRelation())),
   _wgs84(),
+  _transactionSize(0),
+  _asyncWrite(false),
+  _asyncBatchSize(1),
   _failOnSkipRelation(false)
 {
   setConfiguration(conf());
@@ -116,23 +298,35 @@ OgrWriter::OgrWriter():
 
 OgrWriter::~OgrWriter()
 {
-
+  //join the flush thread without throwing if the caller never finalized
+  if (_flushThread.get() != 0)
+  {
+    _featureQueue->finish();
+    _flushThread->wait();
+  }
 }
 
 void OgrWriter::_addFeature(OGRLayer* layer, boost::shared_ptr<Feature> f, boost::shared_ptr<Geometry> g)
 {
+  if (_transactionSize > 0 && _uncommittedFeatures.value(layer, 0) == 0)
+  {
+    // not all drivers support transactions; unsupported is fine, the writes just aren't batched
+    layer->StartTransaction();
+  }
+
   OGRFeature* poFeature = OGRFeature::CreateFeature( layer->GetLayerDefn() );
 
   // set all the column values.
   const QVariantMap& vm = f->getValues();
+  const QHash<QString, int>& fieldIndexes = _getFieldIndexes(layer);
 
   for (QVariantMap::const_iterator it = vm.constBegin(); it != vm.constEnd(); ++it)
   {
     const QVariant& v = it.value();
-    QByteArray ba = it.key().toUtf8();
 
     // If the field DOESN'T exist in the output layer, skip it.
-    if (poFeature->GetFieldIndex(ba.constData()) == -1)
+    int fieldIndex = fieldIndexes.value(it.key(), -1);
+    if (fieldIndex == -1)
     {
       continue;
     }
@@ -140,21 +334,21 @@ void OgrWriter::_addFeature(OGRLayer* layer, boost::shared_ptr<Feature> f, boost
     switch (v.type())
     {
     case QVariant::Invalid:
-      poFeature->UnsetField(poFeature->GetFieldIndex(ba.constData()));
+      poFeature->UnsetField(fieldIndex);
       break;
     case QVariant::Int:
-      poFeature->SetField(ba.constData(), v.toInt());
+      poFeature->SetField(fieldIndex, v.toInt());
       break;
     case QVariant::LongLong:
-      poFeature->SetField(ba.constData(), v.toLongLong());
+      poFeature->SetField(fieldIndex, v.toLongLong());
       break;
     case QVariant::Double:
-      poFeature->SetField(ba.constData(), v.toDouble());
+      poFeature->SetField(fieldIndex, v.toDouble());
       break;
     case QVariant::String:
     {
       QByteArray vba = v.toString().toUtf8();
-      poFeature->SetField(ba.constData(), vba.constData());
+      poFeature->SetField(fieldIndex, vba.constData());
       break;
     }
     default:
@@ -179,6 +373,46 @@ void OgrWriter::_addFeature(OGRLayer* layer, boost::shared_ptr<Feature> f, boost
   }
 
   OGRFeature::DestroyFeature(poFeature);
+
+  if (_transactionSize > 0)
+  {
+    int count = _uncommittedFeatures.value(layer, 0) + 1;
+    if (count >= _transactionSize)
+    {
+      layer->CommitTransaction();
+      count = 0;
+    }
+    _uncommittedFeatures[layer] = count;
+  }
+}
+
+const QHash<QString, int>& OgrWriter::_getFieldIndexes(OGRLayer* layer)
+{
+  QHash<OGRLayer*, QHash<QString, int> >::iterator it = _fieldIndexes.find(layer);
+  if (it == _fieldIndexes.end())
+  {
+    QHash<QString, int> indexes;
+    OGRFeatureDefn* poFDefn = layer->GetLayerDefn();
+    for (int i = 0; i < poFDefn->GetFieldCount(); i++)
+    {
+      indexes[QString::fromUtf8(poFDefn->GetFieldDefn(i)->GetNameRef())] = i;
+    }
+    it = _fieldIndexes.insert(layer, indexes);
+  }
+  return it.value();
+}
+
+void OgrWriter::_commitOpenTransactions()
+{
+  for (QHash<OGRLayer*, int>::const_iterator it = _uncommittedFeatures.constBegin();
+       it != _uncommittedFeatures.constEnd(); ++it)
+  {
+    if (it.value() > 0)
+    {
+      it.key()->CommitTransaction();
+    }
+  }
+  _uncommittedFeatures.clear();
 }
 
 void OgrWriter::_addFeatureToLayer(OGRLayer* layer, boost::shared_ptr<Feature> f, const Geometry* g,
@@ -214,7 +448,13 @@ void OgrWriter::_addFeatureToLayer(OGRLayer* layer, boost::shared_ptr<Feature> f
 
 void OgrWriter::close()
 {
+  _finishAsyncWrite();
+  if (_ds.get() != 0)
+  {
+    _commitOpenTransactions();
+  }
   _layers.clear();
+  _fieldIndexes.clear();
   _ds.reset();
 }
 
@@ -263,15 +503,15 @@ void OgrWriter::_createLayer(boost::shared_ptr<const Layer> layer)
       options["ENCODING"] = "UTF-8";
     }
 
-    // Add a Feature Dataset to a ESRI File GeoDatabase if requested
     if (name == QString("FileGDB"))
     {
+      // Add a Feature Dataset to a ESRI File GeoDatabase if requested
       if (layer->getFdName() != "")
       {
         options["FEATURE_DATASET"] = layer->getFdName();
-        // speed up bulk inserts.
-        options["FGDB_BULK_LOAD"] = "YES";
       }
+      // speed up bulk inserts.
+      options["FGDB_BULK_LOAD"] = "YES";
     }
   }
 
@@ -448,6 +688,9 @@ void OgrWriter::setConfiguration(const Settings& conf)
   setPrependLayerName(configOptions.getOgrWriterPreLayerName());
 
   _appendData = configOptions.getOgrAppendData();
+  _transactionSize = configOptions.getOgrWriterTransactionSize();
+  _asyncWrite = configOptions.getOgrWriterAsync();
+  _asyncBatchSize = configOptions.getOgrWriterAsyncBatchSize();
 
   QString strictStr = configOptions.getOgrStrictChecking();
   if (strictStr == "on")
@@ -554,6 +797,9 @@ void OgrWriter::write(ConstOsmMapPtr map)
   {
     _writePartial(provider, map->getRelation(*relationIdIter));
   }
+
+  _finishAsyncWrite();
+  _commitOpenTransactions();
 }
 
 void OgrWriter::_writePartial(ElementProviderPtr& provider, const ConstElementPtr& e)
@@ -622,18 +868,60 @@ void OgrWriter::_writePartial(ElementProviderPtr& provider, const ConstElementPt
     // only write the feature if it wasn't filtered by the translation script.
     for (size_t i = 0; i < tf.size(); i++)
     {
-      OGRLayer* layer = _getLayer(tf[i].tableName);
-      if (layer != 0)
+      if (_asyncWrite)
       {
-        _addFeature(layer, tf[i].feature, g);
+        _queueFeature(tf[i].tableName, tf[i].feature, g);
+      }
+      else
+      {
+        OGRLayer* layer = _getLayer(tf[i].tableName);
+        if (layer != 0)
+        {
+          _addFeature(layer, tf[i].feature, g);
+        }
       }
     }
   }
 }
 
+void OgrWriter::_queueFeature(const QString& tableName, boost::shared_ptr<Feature> f,
+                              boost::shared_ptr<Geometry> g)
+{
+  if (_featureQueue.get() == 0)
+  {
+    _featureQueue.reset(new OgrFeatureQueue(_asyncBatchSize));
+    _flushThread.reset(new OgrWriterFlushThread(*this, *_featureQueue));
+    _flushThread->start();
+  }
+  if (_featureQueue->getError().isEmpty() == false)
+  {
+    //the flush thread already died; joins and rethrows its error
+    _finishAsyncWrite();
+  }
+  _featureQueue->enqueue(tableName, f, g);
+}
+
+void OgrWriter::_finishAsyncWrite()
+{
+  if (_flushThread.get() == 0)
+  {
+    return;
+  }
+  _featureQueue->finish();
+  _flushThread->wait();
+  const QString error = _featureQueue->getError();
+  _flushThread.reset();
+  _featureQueue.reset();
+  if (error.isEmpty() == false)
+  {
+    throw HootException(error);
+  }
+}
+
 void OgrWriter::finalizePartial()
 {
-  /// @todo implement
+  _finishAsyncWrite();
+  _commitOpenTransactions();
 }
 
 void OgrWriter::writePartial(const boost::shared_ptr<const hoot::Node>& newNode)
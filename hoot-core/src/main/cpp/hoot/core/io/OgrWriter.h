@@ -61,12 +61,17 @@ class ScriptTranslator;
 class ScriptToOgrTranslator;
 class ElementInputStream;
 class ElementProvider;
+class OgrFeatureQueue;
+class OgrWriterFlushThread;
 
 /**
  * Writes a file to an OGR data source.
  */
 class OgrWriter : public PartialOsmMapWriter, public Configurable
 {
+  //the flush thread calls back into _getLayer/_addFeature; see ogr.writer.async
+  friend class OgrWriterFlushThread;
+
 public:
 
   static std::string className() { return "hoot::OgrWriter"; }
@@ -147,6 +152,19 @@ protected:
   bool _includeDebug;
   ElementCachePtr _elementCache;
   OGRSpatialReference _wgs84;
+  //see ogr.writer.transaction.size; 0 disables batching
+  int _transactionSize;
+  //features created on each layer since its transaction was opened
+  QHash<OGRLayer*, int> _uncommittedFeatures;
+  //field name -> field index for each layer, so the name lookups happen once per layer rather
+  //than once per feature
+  QHash<OGRLayer*, QHash<QString, int> > _fieldIndexes;
+  //see ogr.writer.async; when true translated features are handed off to a background flush
+  //thread which owns all the OGR calls (layer creation and feature writes) while streaming
+  bool _asyncWrite;
+  int _asyncBatchSize;
+  boost::shared_ptr<OgrFeatureQueue> _featureQueue;
+  boost::shared_ptr<OgrWriterFlushThread> _flushThread;
 
   void _addFeature(OGRLayer* layer, boost::shared_ptr<Feature> f, boost::shared_ptr<geos::geom::Geometry> g);
 
@@ -160,6 +178,29 @@ protected:
 
   OGRLayer* _getLayerByName(const QString& layerName);
 
+  /**
+   * Returns the cached field name to index mapping for the layer, building it on first use.
+   */
+  const QHash<QString, int>& _getFieldIndexes(OGRLayer* layer);
+
+  /**
+   * Commits any open per-layer transactions; called when the write finishes or the data source
+   * closes.
+   */
+  void _commitOpenTransactions();
+
+  /**
+   * Hands a translated feature to the flush thread, starting the thread on first use.
+   */
+  void _queueFeature(const QString& tableName, boost::shared_ptr<Feature> f,
+                     boost::shared_ptr<geos::geom::Geometry> g);
+
+  /**
+   * Drains the feature queue and joins the flush thread, rethrowing any error it hit. A no-op if
+   * the flush thread isn't running.
+   */
+  void _finishAsyncWrite();
+
   boost::shared_ptr<geos::geom::Geometry> _toMulti(boost::shared_ptr<geos::geom::Geometry> from);
 
   void strictError(QString warning);
@@ -53,6 +53,9 @@ protected:
 
   virtual ElementId _mapElementId(const OsmMap& map, ElementId oldId);
 
+  //this reader exists to remap ids against the osm api db, which is order dependent
+  virtual bool _supportsParallelRead() const { return false; }
+
 private:
 
   OsmApiDb _osmApiDb;
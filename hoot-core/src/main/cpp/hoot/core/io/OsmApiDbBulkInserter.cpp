@@ -29,9 +29,11 @@
 
 #include <QDateTime>
 #include <QFileInfo>
+#include <QFuture>
 #include <QStringBuilder>
 #include <QDir>
 #include <QUuid>
+#include <QtConcurrentRun>
 
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Factory.h>
@@ -444,7 +446,203 @@ void OsmApiDbBulkInserter::_writeDataToDbPsql()
 
 void OsmApiDbBulkInserter::_writeDataToDb()
 {
-  _writeDataToDbPsql();
+  if (_parallelLoad)
+  {
+    _writeDataToDbParallelPsql();
+  }
+  else
+  {
+    _writeDataToDbPsql();
+  }
+}
+
+int OsmApiDbBulkInserter::_loadPhaseForTable(const QString tableName)
+{
+  if (tableName == ApiDb::getChangesetsTableName())
+  {
+    //everything references changesets, so they commit first along with the sequence updates.
+    return 0;
+  }
+  else if (tableName == ApiDb::getCurrentNodesTableName() ||
+           tableName == ApiDb::getNodesTableName() ||
+           tableName == ApiDb::getCurrentWaysTableName() ||
+           tableName == ApiDb::getWaysTableName() ||
+           tableName == ApiDb::getCurrentRelationsTableName() ||
+           tableName == ApiDb::getRelationsTableName())
+  {
+    //the element tables only reference changesets.
+    return 1;
+  }
+  //tags, way nodes and relation members reference the element tables.
+  return 2;
+}
+
+namespace
+{
+  //runs on a worker thread; exceptions can't cross a QtConcurrent boundary, so failure comes
+  //back as a return value instead.
+  bool execSqlFileNoThrow(const QString dbUrl, const QString sqlFile)
+  {
+    try
+    {
+      ApiDb::execSqlFile(dbUrl, sqlFile);
+      return true;
+    }
+    catch (const HootException& e)
+    {
+      LOG_ERROR("Failed loading " << sqlFile << ": " << e.getWhat());
+      return false;
+    }
+  }
+}
+
+void OsmApiDbBulkInserter::_writeDataToDbParallelPsql()
+{
+  _timer->restart();
+  _fileDataPassCtr++;
+  LOG_INFO(
+    "Executing element SQL for " <<
+    FileUtils::formatPotentiallyLargeNumber(_getTotalRecordsWritten()) <<
+    " records (data pass #" << _fileDataPassCtr << " of " << _numberOfFileDataPasses() <<
+    ") with parallel per table loads...");
+
+  //demultiplex the combined SQL file back into one file per table, grouped into load phases.
+  //phase 0 also picks up everything outside the COPY blocks (the setval statements); the
+  //combined file's own transaction markers are dropped since each split file runs in its own
+  //transaction.
+  const int numPhases = 3;
+  std::vector< std::vector< boost::shared_ptr<QFile> > > phaseFiles(numPhases);
+  std::vector< boost::shared_ptr<QTextStream> > openStreams;
+
+  QFile combinedFile(_sqlOutputCombinedFile->fileName());
+  if (!combinedFile.open(QIODevice::ReadOnly))
+  {
+    throw HootException(
+      "Unable to open combined SQL file: " + _sqlOutputCombinedFile->fileName());
+  }
+  QTextStream inStream(&combinedFile);
+
+  boost::shared_ptr<QTextStream> phase0Stream;
+  {
+    boost::shared_ptr<QFile> phase0File(
+      new QFile(QDir::tempPath() + "/OsmApiDbBulkWriter-phase0-" +
+                QUuid::createUuid().toString() + ".sql"));
+    if (!phase0File->open(QFile::WriteOnly))
+    {
+      throw HootException("Could not open file for SQL output: " + phase0File->fileName());
+    }
+    phaseFiles[0].push_back(phase0File);
+    phase0Stream.reset(new QTextStream(phase0File.get()));
+    openStreams.push_back(phase0Stream);
+    *phase0Stream << "BEGIN TRANSACTION;\n";
+  }
+
+  QTextStream* currentStream = phase0Stream.get();
+  bool inCopyBlock = false;
+  QString line;
+  do
+  {
+    line = inStream.readLine();
+    if (line.isNull())
+    {
+      break;
+    }
+
+    if (!inCopyBlock && line.startsWith("COPY "))
+    {
+      //route this block to a new per table file in the table's phase.
+      const QString tableName = line.split(" ")[1];
+      const int phase = _loadPhaseForTable(tableName);
+      boost::shared_ptr<QFile> tableFile(
+        new QFile(QDir::tempPath() + "/OsmApiDbBulkWriter-" + tableName + "-" +
+                  QUuid::createUuid().toString() + ".sql"));
+      if (!tableFile->open(QFile::WriteOnly))
+      {
+        throw HootException("Could not open file for SQL output: " + tableFile->fileName());
+      }
+      phaseFiles[phase].push_back(tableFile);
+      boost::shared_ptr<QTextStream> tableStream(new QTextStream(tableFile.get()));
+      openStreams.push_back(tableStream);
+      *tableStream << "BEGIN TRANSACTION;\n";
+      currentStream = tableStream.get();
+      inCopyBlock = true;
+    }
+    else if (!inCopyBlock)
+    {
+      //drop the combined file's transaction markers, blank lines and the byte order mark; each
+      //split file carries its own transaction.
+      QString simplified = line.trimmed();
+      simplified.remove(QChar(0xFEFF));
+      if (line == "BEGIN TRANSACTION;" || line == "COMMIT;" || simplified.isEmpty())
+      {
+        continue;
+      }
+    }
+
+    *currentStream << line % "\n";
+
+    if (inCopyBlock && line == "\\.")
+    {
+      *currentStream << "COMMIT;\n";
+      currentStream = phase0Stream.get();
+      inCopyBlock = false;
+    }
+  }
+  while (!line.isNull());
+  combinedFile.close();
+
+  *phase0Stream << "COMMIT;\n";
+  for (size_t i = 0; i < openStreams.size(); i++)
+  {
+    openStreams[i]->flush();
+  }
+  for (int phase = 0; phase < numPhases; phase++)
+  {
+    for (size_t i = 0; i < phaseFiles[phase].size(); i++)
+    {
+      phaseFiles[phase][i]->close();
+    }
+  }
+
+  //load the phases in order; a phase only starts once everything it references has committed.
+  bool success = true;
+  for (int phase = 0; phase < numPhases && success; phase++)
+  {
+    LOG_INFO(
+      "Loading phase " << phase + 1 << " of " << numPhases << " (" <<
+      phaseFiles[phase].size() << " table file(s) in parallel)...");
+    QList< QFuture<bool> > futures;
+    for (size_t i = 0; i < phaseFiles[phase].size(); i++)
+    {
+      futures.append(
+        QtConcurrent::run(&execSqlFileNoThrow, _outputUrl, phaseFiles[phase][i]->fileName()));
+    }
+    for (int i = 0; i < futures.size(); i++)
+    {
+      if (!futures[i].result())
+      {
+        success = false;
+      }
+    }
+  }
+
+  for (int phase = 0; phase < numPhases; phase++)
+  {
+    for (size_t i = 0; i < phaseFiles[phase].size(); i++)
+    {
+      phaseFiles[phase][i]->remove();
+    }
+  }
+
+  if (!success)
+  {
+    throw HootException(
+      "Failed executing bulk element SQL against the database.  Parts of the load may have been "
+      "committed; see the log for the failing table file(s).");
+  }
+
+  LOG_INFO(
+    "SQL execution complete.  Time elapsed: " << FileUtils::secondsToDhms(_timer->elapsed()));
 }
 
 QString OsmApiDbBulkInserter::_getCombinedSqlFileName() const
@@ -974,6 +1172,7 @@ void OsmApiDbBulkInserter::setConfiguration(const Settings& conf)
   setStartingRelationId(confOptions.getOsmapidbBulkInserterStartingRelationId());
   setStxxlMapMinSize(confOptions.getOsmapidbBulkInserterStxxlMapMinSize());
   setValidateData(confOptions.getOsmapidbBulkInserterValidateData());
+  setParallelLoad(confOptions.getOsmapidbBulkInserterParallelLoad());
 
   LOG_VART(_changesetData.changesetUserId);
   LOG_VART(_fileOutputElementBufferSize);
@@ -181,6 +181,7 @@ public:
   }
   void setStxxlMapMinSize(long size) { _stxxlMapMinSize = size; }
   void setValidateData(bool validate) { _validateData = validate; }
+  void setParallelLoad(bool parallel) { _parallelLoad = parallel; }
 
 private:
 
@@ -203,6 +204,7 @@ private:
   unsigned int _fileDataPassCtr;
   long _stxxlMapMinSize;
   bool _validateData;
+  bool _parallelLoad;
 
   //ended up not going with temp files here, since the file outputs aren't always temporary
   std::map<QString, std::pair<boost::shared_ptr<QFile>, boost::shared_ptr<QTextStream> > > _outputSections;
@@ -269,6 +271,10 @@ private:
   void _reserveIdsInDb();
   void _writeDataToDb();
   void _writeDataToDbPsql();
+  void _writeDataToDbParallelPsql();
+  //maps a table to the load phase it belongs to; tables in a phase only reference tables in
+  //earlier phases, so everything within one phase can load concurrently
+  static int _loadPhaseForTable(const QString tableName);
 };
 
 }
@@ -50,6 +50,8 @@ OsmApiDbSqlChangesetApplier::OsmApiDbSqlChangesetApplier(const QUrl targetDataba
   }
   _db.open(targetDatabaseUrl);
 
+  _insertBatchSize = ConfigOptions().getChangesetApplyInsertBatchSize();
+
   _initChangesetStats();
 }
 
@@ -63,6 +65,92 @@ void OsmApiDbSqlChangesetApplier::_initChangesetStats()
   _changesetStats.clear();
 }
 
+namespace
+{
+  /**
+   * Emits the merged INSERT statements for the current run and clears the run state.
+   */
+  void flushInsertRun(QStringList& prefixOrder, QMap<QString, QStringList>& rowsByPrefix,
+                      int batchSize, QString& result)
+  {
+    for (int i = 0; i < prefixOrder.size(); i++)
+    {
+      const QString prefix = prefixOrder[i];
+      const QStringList& rows = rowsByPrefix[prefix];
+      for (int j = 0; j < rows.size(); j += batchSize)
+      {
+        result += prefix + " VALUES " + QStringList(rows.mid(j, batchSize)).join(", ") + ";\n";
+      }
+    }
+    prefixOrder.clear();
+    rowsByPrefix.clear();
+  }
+}
+
+QString OsmApiDbSqlChangesetApplier::batchElementSql(const QString& elementSql,
+                                                     int insertBatchSize)
+{
+  if (insertBatchSize <= 1)
+  {
+    return elementSql;
+  }
+
+  QString result;
+  //inserts in the current run, grouped by their "INSERT INTO <table> (<columns>)" prefix in first
+  //appearance order; the generated changeset SQL always inserts parent rows before the rows that
+  //reference them, so emitting the groups in first appearance order preserves referential order
+  QStringList prefixOrder;
+  QMap<QString, QStringList> rowsByPrefix;
+
+  const QStringList statements = elementSql.split(";");
+  for (int i = 0; i < statements.size(); i++)
+  {
+    QString statement = statements[i].trimmed();
+    if (statement.isEmpty())
+    {
+      continue;
+    }
+
+    //operation comment headers (e.g. /* node create 1 */) share a chunk with the statement that
+    //follows them; pass them through ahead of the statement
+    if (statement.startsWith("/*"))
+    {
+      const int commentEnd = statement.indexOf("*/");
+      if (commentEnd != -1)
+      {
+        result += statement.left(commentEnd + 2) + "\n";
+        statement = statement.mid(commentEnd + 2).trimmed();
+        if (statement.isEmpty())
+        {
+          continue;
+        }
+      }
+    }
+
+    const int valuesIndex = statement.indexOf(" VALUES (");
+    if (statement.startsWith("INSERT INTO ") && valuesIndex != -1)
+    {
+      const QString prefix = statement.left(valuesIndex);
+      const QString row = statement.mid(valuesIndex + 8).trimmed();
+      if (!rowsByPrefix.contains(prefix))
+      {
+        prefixOrder.append(prefix);
+      }
+      rowsByPrefix[prefix].append(row);
+    }
+    else
+    {
+      //updates and deletes end the current run so the relative order of inserts and
+      //updates/deletes on the same tables is never changed
+      flushInsertRun(prefixOrder, rowsByPrefix, insertBatchSize, result);
+      result += statement + ";\n";
+    }
+  }
+  flushInsertRun(prefixOrder, rowsByPrefix, insertBatchSize, result);
+
+  return result;
+}
+
 void OsmApiDbSqlChangesetApplier::write(const QString sql)
 {
   LOG_DEBUG("Executing changeset SQL queries against OSM API database...");
@@ -98,7 +186,7 @@ void OsmApiDbSqlChangesetApplier::write(const QString sql)
         //had problems here when trying to prepare these queries (should they be?); the changeset
         //writing needs to be done before the element writing, hence the separate queries
         DbUtils::execNoPrepare(_db.getDB(), changesetInsertStatement);
-        DbUtils::execNoPrepare(_db.getDB(), elementSqlStatements);
+        DbUtils::execNoPrepare(_db.getDB(), batchElementSql(elementSqlStatements, _insertBatchSize));
 
         changesetInsertStatement = "";
         elementSqlStatements = "";
@@ -165,7 +253,7 @@ void OsmApiDbSqlChangesetApplier::write(const QString sql)
     }
 
     DbUtils::execNoPrepare(_db.getDB(), changesetInsertStatement);
-    DbUtils::execNoPrepare(_db.getDB(), elementSqlStatements);
+    DbUtils::execNoPrepare(_db.getDB(), batchElementSql(elementSqlStatements, _insertBatchSize));
 
     changesetInsertStatement = "";
     elementSqlStatements = "";
@@ -81,6 +81,22 @@ public:
    */
   QString getChangesetStats() const;
 
+  /**
+   * Merges runs of consecutive single row INSERT statements into multi-row INSERT statements to
+   * cut the per statement parse/plan overhead on the database server. Statements are grouped by
+   * table and column list; any UPDATE or DELETE statement ends the current run, so the relative
+   * order of inserts and updates/deletes is never changed. The number of rows merged into one
+   * statement is capped by changeset.apply.insert.batch.size; a value of one or less returns the
+   * SQL unchanged.
+   *
+   * Static so the SQL rewrite can be verified without a database connection.
+   *
+   * @param elementSql the element SQL statements for one changeset, separated by semicolons
+   * @param insertBatchSize the maximum number of rows merged into one INSERT statement
+   * @return the equivalent SQL with batched inserts
+   */
+  static QString batchElementSql(const QString& elementSql, int insertBatchSize);
+
 private:
 
   void _initChangesetStats();
@@ -90,6 +106,9 @@ private:
 
   QMap<QString, long> _changesetStats;
   QString _changesetDetailsStr;
+
+  //max rows per merged INSERT statement; see batchElementSql
+  int _insertBatchSize;
 };
 
 }
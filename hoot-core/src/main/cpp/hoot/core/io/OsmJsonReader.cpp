@@ -29,6 +29,7 @@
 
 // hoot
 #include <hoot/core/Hoot.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/MetadataTags.h>
@@ -40,6 +41,7 @@
 namespace pt = boost::property_tree;
 
 // Qt
+#include <QStringList>
 #include <QTextStream>
 #include <QTextCodec>
 #include <QEventLoop>
@@ -77,6 +79,274 @@ namespace // anonymous
   }
 }
 
+/**
+ * A small pull tokenizer over a QIODevice. It reads the input in chunks and
+ * hands individual JSON tokens to the caller, so the document never has to be
+ * buffered in its entirety. Like the property tree path, it accepts single
+ * quoted strings for ease of coding test data in c++. Defined here to keep the
+ * parsing details out of the public header.
+ */
+class JsonTokenStream
+{
+public:
+
+  JsonTokenStream(QIODevice* device) :
+    _device(device),
+    _pos(0),
+    _line(1)
+  {
+  }
+
+  int getLine() const { return _line; }
+
+  /**
+   * Consumes any whitespace, then consumes c. Throws if the next token isn't c.
+   */
+  void expect(char c)
+  {
+    skipWhitespace();
+    int n = _next();
+    if (n != c)
+    {
+      throw HootException(QString("Error parsing JSON: expected '%1' (line %2)").arg(c)
+                          .arg(_line));
+    }
+  }
+
+  /**
+   * Consumes any whitespace, then consumes c if it is the next character.
+   * Returns true if c was consumed.
+   */
+  bool tryConsume(char c)
+  {
+    skipWhitespace();
+    if (_peek() == c)
+    {
+      _next();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Parses a quoted string, handling escapes. Both single and double quotes
+   * are accepted, mirroring scrubQuotes().
+   */
+  QString parseString()
+  {
+    skipWhitespace();
+    int quote = _next();
+    if (quote != '"' && quote != '\'')
+    {
+      throw HootException(QString("Error parsing JSON: expected a string (line %1)").arg(_line));
+    }
+
+    QByteArray result;
+    while (true)
+    {
+      int c = _next();
+      if (c == -1)
+      {
+        throw HootException(QString("Error parsing JSON: unterminated string (line %1)")
+                            .arg(_line));
+      }
+      if (c == quote)
+      {
+        break;
+      }
+      if (c == '\\')
+      {
+        int e = _next();
+        switch (e)
+        {
+        case '"':
+        case '\'':
+        case '\\':
+        case '/':
+          result.append((char)e);
+          break;
+        case 'b':
+          result.append('\b');
+          break;
+        case 'f':
+          result.append('\f');
+          break;
+        case 'n':
+          result.append('\n');
+          break;
+        case 'r':
+          result.append('\r');
+          break;
+        case 't':
+          result.append('\t');
+          break;
+        case 'u':
+          {
+            int code = 0;
+            for (int i = 0; i < 4; i++)
+            {
+              int h = _next();
+              if (h >= '0' && h <= '9')
+                code = code * 16 + (h - '0');
+              else if (h >= 'a' && h <= 'f')
+                code = code * 16 + (h - 'a' + 10);
+              else if (h >= 'A' && h <= 'F')
+                code = code * 16 + (h - 'A' + 10);
+              else
+                throw HootException(QString("Error parsing JSON: bad unicode escape (line %1)")
+                                    .arg(_line));
+            }
+            result.append(QString(QChar((ushort)code)).toUtf8());
+          }
+          break;
+        default:
+          throw HootException(QString("Error parsing JSON: bad escape sequence (line %1)")
+                              .arg(_line));
+        }
+      }
+      else
+      {
+        result.append((char)c);
+      }
+    }
+    return QString::fromUtf8(result.constData(), result.size());
+  }
+
+  /**
+   * Parses a number, boolean or null and returns its raw text. Numbers are
+   * returned as text so callers can convert without precision or 32 bit
+   * range issues.
+   */
+  QString parseScalar()
+  {
+    skipWhitespace();
+    QByteArray result;
+    while (true)
+    {
+      int c = _peek();
+      if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          c == '-' || c == '+' || c == '.')
+      {
+        result.append((char)_next());
+      }
+      else
+      {
+        break;
+      }
+    }
+    if (result.isEmpty())
+    {
+      throw HootException(QString("Error parsing JSON: expected a value (line %1)").arg(_line));
+    }
+    return QString::fromUtf8(result.constData(), result.size());
+  }
+
+  /**
+   * Parses either a quoted string or a scalar, returning it as text. Handy for
+   * fields that may legitimately arrive either way (e.g. version numbers).
+   */
+  QString parseStringOrScalar()
+  {
+    skipWhitespace();
+    int c = _peek();
+    if (c == '"' || c == '\'')
+    {
+      return parseString();
+    }
+    return parseScalar();
+  }
+
+  /**
+   * Consumes and discards the next value, whatever its type.
+   */
+  void skipValue()
+  {
+    skipWhitespace();
+    int c = _peek();
+    if (c == '{')
+    {
+      expect('{');
+      if (tryConsume('}'))
+        return;
+      do
+      {
+        parseString();
+        expect(':');
+        skipValue();
+      }
+      while (tryConsume(','));
+      expect('}');
+    }
+    else if (c == '[')
+    {
+      expect('[');
+      if (tryConsume(']'))
+        return;
+      do
+      {
+        skipValue();
+      }
+      while (tryConsume(','));
+      expect(']');
+    }
+    else if (c == '"' || c == '\'')
+    {
+      parseString();
+    }
+    else
+    {
+      parseScalar();
+    }
+  }
+
+  void skipWhitespace()
+  {
+    while (true)
+    {
+      int c = _peek();
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        _next();
+      else
+        break;
+    }
+  }
+
+private:
+
+  QIODevice* _device;
+  QByteArray _buffer;
+  int _pos;
+  int _line;
+
+  bool _fill()
+  {
+    if (_pos < _buffer.size())
+      return true;
+    // read the input one chunk at a time.
+    _buffer = _device->read(64 * 1024);
+    _pos = 0;
+    return _buffer.size() > 0;
+  }
+
+  int _peek()
+  {
+    if (!_fill())
+      return -1;
+    return (unsigned char)_buffer.at(_pos);
+  }
+
+  int _next()
+  {
+    if (!_fill())
+      return -1;
+    char c = _buffer.at(_pos);
+    _pos++;
+    if (c == '\n')
+      _line++;
+    return (unsigned char)c;
+  }
+};
+
 // Default constructor
 OsmJsonReader::OsmJsonReader():
   _defaultStatus(Status::Invalid),
@@ -173,6 +443,14 @@ void OsmJsonReader::read(OsmMapPtr map)
   QString jsonStr;
   if (_isFile)
   {
+    if (ConfigOptions().getJsonReaderUseStreamParser())
+    {
+      // Parse straight off the file, constructing elements as they complete.
+      // Skips both the full document buffer and the property tree.
+      JsonTokenStream tokens(&_file);
+      _parseOverpassJsonStream(tokens);
+      return;
+    }
     QTextStream instream(&_file);
     jsonStr = instream.readAll();
   }
@@ -432,6 +710,238 @@ void OsmJsonReader::_addTags(const boost::property_tree::ptree &item, hoot::Elem
   }
 }
 
+void OsmJsonReader::_parseOverpassJsonStream(JsonTokenStream &tokens)
+{
+  // Same 4 top level items as _parseOverpassJson, but pulled off the token
+  // stream rather than read out of a property tree.
+  tokens.expect('{');
+  if (tokens.tryConsume('}'))
+    return;
+  do
+  {
+    QString key = tokens.parseString();
+    tokens.expect(':');
+    if ("version" == key)
+    {
+      _version = tokens.parseStringOrScalar();
+    }
+    else if ("generator" == key)
+    {
+      _generator = tokens.parseStringOrScalar();
+    }
+    else if ("osm3s" == key)
+    {
+      tokens.expect('{');
+      if (!tokens.tryConsume('}'))
+      {
+        do
+        {
+          QString subKey = tokens.parseString();
+          tokens.expect(':');
+          if ("timestamp_osm_base" == subKey)
+            _timestamp_base = tokens.parseStringOrScalar();
+          else if ("copyright" == subKey)
+            _copyright = tokens.parseStringOrScalar();
+          else
+            tokens.skipValue();
+        }
+        while (tokens.tryConsume(','));
+        tokens.expect('}');
+      }
+    }
+    else if ("elements" == key)
+    {
+      tokens.expect('[');
+      if (!tokens.tryConsume(']'))
+      {
+        do
+        {
+          _parseStreamElement(tokens);
+        }
+        while (tokens.tryConsume(','));
+        tokens.expect(']');
+      }
+    }
+    else
+    {
+      tokens.skipValue();
+    }
+  }
+  while (tokens.tryConsume(','));
+  tokens.expect('}');
+}
+
+void OsmJsonReader::_parseStreamElement(JsonTokenStream &tokens)
+{
+  // Gather up the element's fields first - the "type" key isn't guaranteed to
+  // arrive before the fields that depend on it.
+  QString typeStr;
+  long id = -1;
+  bool hasId = false;
+  double lat = 0.0;
+  double lon = 0.0;
+  std::vector<long> nodeIds;
+  QStringList memberTypes;
+  QStringList memberRoles;
+  std::vector<long> memberRefs;
+  Tags tags;
+
+  tokens.expect('{');
+  if (!tokens.tryConsume('}'))
+  {
+    do
+    {
+      QString key = tokens.parseString();
+      tokens.expect(':');
+      if ("type" == key)
+      {
+        typeStr = tokens.parseString();
+      }
+      else if ("id" == key)
+      {
+        id = tokens.parseStringOrScalar().toLong();
+        hasId = true;
+      }
+      else if ("lat" == key)
+      {
+        lat = tokens.parseStringOrScalar().toDouble();
+      }
+      else if ("lon" == key)
+      {
+        lon = tokens.parseStringOrScalar().toDouble();
+      }
+      else if ("nodes" == key)
+      {
+        tokens.expect('[');
+        if (!tokens.tryConsume(']'))
+        {
+          do
+          {
+            nodeIds.push_back(tokens.parseStringOrScalar().toLong());
+          }
+          while (tokens.tryConsume(','));
+          tokens.expect(']');
+        }
+      }
+      else if ("members" == key)
+      {
+        tokens.expect('[');
+        if (!tokens.tryConsume(']'))
+        {
+          do
+          {
+            QString memberType;
+            QString memberRole;
+            long memberRef = -1;
+            tokens.expect('{');
+            if (!tokens.tryConsume('}'))
+            {
+              do
+              {
+                QString subKey = tokens.parseString();
+                tokens.expect(':');
+                if ("type" == subKey)
+                  memberType = tokens.parseString();
+                else if ("ref" == subKey)
+                  memberRef = tokens.parseStringOrScalar().toLong();
+                else if ("role" == subKey)
+                  memberRole = tokens.parseString();
+                else
+                  tokens.skipValue();
+              }
+              while (tokens.tryConsume(','));
+              tokens.expect('}');
+            }
+            memberTypes.append(memberType);
+            memberRoles.append(memberRole);
+            memberRefs.push_back(memberRef);
+          }
+          while (tokens.tryConsume(','));
+          tokens.expect(']');
+        }
+      }
+      else if ("tags" == key)
+      {
+        tokens.expect('{');
+        if (!tokens.tryConsume('}'))
+        {
+          do
+          {
+            QString k = tokens.parseString();
+            tokens.expect(':');
+            tags.insert(k, tokens.parseStringOrScalar());
+          }
+          while (tokens.tryConsume(','));
+          tokens.expect('}');
+        }
+      }
+      else
+      {
+        tokens.skipValue();
+      }
+    }
+    while (tokens.tryConsume(','));
+    tokens.expect('}');
+  }
+
+  // Now construct the element, mirroring the property tree based parse
+  // functions above.
+  ElementPtr pElement;
+  if ("node" == typeStr)
+  {
+    if (!_useDataSourceIds || !hasId)
+      id = _map->createNextNodeId();
+    pElement.reset(new Node(_defaultStatus, id, lon, lat, _defaultCircErr));
+  }
+  else if ("way" == typeStr)
+  {
+    if (!_useDataSourceIds || !hasId)
+      id = _map->createNextWayId();
+    WayPtr pWay(new Way(_defaultStatus, id, _defaultCircErr));
+    for (size_t i = 0; i < nodeIds.size(); i++)
+    {
+      pWay->addNode(nodeIds[i]);
+    }
+    pElement = pWay;
+  }
+  else if ("relation" == typeStr)
+  {
+    if (!_useDataSourceIds || !hasId)
+      id = _map->createNextRelationId();
+    RelationPtr pRelation(new Relation(_defaultStatus, id, _defaultCircErr));
+    for (size_t i = 0; i < memberRefs.size(); i++)
+    {
+      pRelation->addElement(memberRoles[i], ElementType::fromString(memberTypes[i]),
+                            memberRefs[i]);
+    }
+    pElement = pRelation;
+  }
+  else
+  {
+    if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN("Unknown JSON elment type (" << typeStr << ") when parsing json osm");
+    }
+    else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+    }
+    logWarnCount++;
+    return;
+  }
+
+  // Apply tags with the same error:circular handling as _addTags
+  for (Tags::const_iterator tagIt = tags.begin(); tagIt != tags.end(); ++tagIt)
+  {
+    if (tagIt.key() == MetadataTags::ErrorCircular())
+      pElement->setCircularError(Meters(tagIt.value().toInt()));
+    else
+      pElement->setTag(tagIt.key(), tagIt.value());
+  }
+
+  _map->addElement(pElement);
+}
+
 void OsmJsonReader::scrubQuotes(QString &jsonStr)
 {
   // We allow the use of single quotes, for ease of coding
@@ -46,6 +46,8 @@
 namespace hoot
 {
 
+class JsonTokenStream;
+
 /**
  * This class is intended to create an OsmMap from a given json string. JSON
  * output from the overpass-api was used as the model for development
@@ -284,6 +286,22 @@ protected:
   void _addTags(const boost::property_tree::ptree &item,
                 hoot::ElementPtr pElement);
 
+  /**
+   * @brief _parseOverpassJsonStream Event driven version of _parseOverpassJson.
+   *        Pulls tokens straight off the input device and adds elements to the
+   *        map as they complete, without building the intermediate property
+   *        tree. Enabled with json.reader.use.stream.parser.
+   * @param tokens Token stream over the input device
+   */
+  void _parseOverpassJsonStream(JsonTokenStream &tokens);
+
+  /**
+   * @brief _parseStreamElement Reads one element object off the token stream
+   *        and adds the resulting Node/Way/Relation to the map
+   * @param tokens Token stream positioned at the opening brace of an element
+   */
+  void _parseStreamElement(JsonTokenStream &tokens);
+
 };
 
 } // end namespace hoot
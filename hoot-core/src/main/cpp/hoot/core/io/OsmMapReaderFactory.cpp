@@ -32,6 +32,7 @@
 #include <hoot/core/io/PartialOsmMapReader.h>
 #include <hoot/core/io/ElementInputStream.h>
 #include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Profiler.h>
 #include <hoot/core/util/Validate.h>
 #include <hoot/core/ops/Boundable.h>
 #include <hoot/core/util/Log.h>
@@ -146,6 +147,7 @@ void OsmMapReaderFactory::read(boost::shared_ptr<OsmMap> map, QString url, bool
       ConfigOptions::getConvertBoundingBoxKey() +
       " configuration option used with unsupported reader for data source: " + url);
   }
+  ProfileScope profile("read map");
   reader->open(url);
   reader->read(map);
   VALIDATE(map->validate(true));
@@ -33,6 +33,7 @@
 #include <hoot/core/io/ElementOutputStream.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/util/Profiler.h>
 
 using namespace std;
 
@@ -129,6 +130,7 @@ void OsmMapWriterFactory::write(const boost::shared_ptr<const OsmMap> &map, QStr
 {
   LOG_INFO("Writing map to " << url << "...");
   boost::shared_ptr<OsmMapWriter> writer = getInstance().createWriter(url);
+  ProfileScope profile("write map");
   writer->open(url);
   writer->write(map);
 }
@@ -37,9 +37,11 @@
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/visitors/ReportMissingElementsVisitor.h>
+#include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/elements/Element.h>
 #include "ElementInputStream.h"
+#include "PbfDeltaDecode.h"
 #include <hoot/core/OsmMap.h>
 
 using namespace hoot::pb;
@@ -50,7 +52,13 @@ using namespace hoot::pb;
 // Qt
 #include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 // TGS
 #include <tgs/System/Time.h>
@@ -83,6 +91,71 @@ public:
   PrimitiveBlock primitiveBlock;
 };
 
+/**
+ * Inflates and parses one OSMData blob off the main thread. This is the CPU heavy part of the
+ * read and touches no shared state; the stateful element construction stays on the coordinating
+ * thread. Any failure is recorded in error and rethrown by the coordinator.
+ */
+class PbfBlockDecodeTask : public QRunnable
+{
+public:
+
+  std::string raw;
+  PrimitiveBlock block;
+  QString error;
+
+  PbfBlockDecodeTask() { setAutoDelete(false); }
+
+  virtual void run()
+  {
+    try
+    {
+      Blob blob;
+      if (!blob.ParseFromArray(raw.data(), raw.size()))
+      {
+        throw HootException("Error parsing blob.");
+      }
+
+      size_t rawSize = blob.raw_size();
+      std::string inflated;
+      inflated.resize(rawSize);
+
+      z_stream strm;
+      strm.zalloc = Z_NULL;
+      strm.zfree = Z_NULL;
+      strm.opaque = Z_NULL;
+      if (inflateInit(&strm) != Z_OK)
+      {
+        throw HootException(QString("Error initializing zlib stream."));
+      }
+      strm.next_in = (Bytef*)blob.zlib_data().data();
+      strm.avail_in = blob.zlib_data().size();
+      strm.avail_out = rawSize;
+      strm.next_out = (Bytef*)inflated.data();
+      int result = inflate(&strm, Z_NO_FLUSH);
+      inflateEnd(&strm);
+      if (result < Z_OK)
+      {
+        throw HootException(QString("Error inflating zlib stream. %1").arg(result));
+      }
+
+      block.Clear();
+      if (!block.ParseFromArray(inflated.data(), rawSize))
+      {
+        throw HootException("Error parsing primitive block.");
+      }
+    }
+    catch (const HootException& e)
+    {
+      error = e.getWhat();
+    }
+    catch (const std::exception& e)
+    {
+      error = QString::fromUtf8(e.what());
+    }
+  }
+};
+
 OsmPbfReader::OsmPbfReader()
 {
   _init(false);
@@ -114,6 +187,7 @@ void OsmPbfReader::_init(bool useFileId)
   _in = NULL;
   _needToCloseInput = false;
   _typeThenId = false;
+  _useBounds = false;
 
   initializePartial();
 
@@ -136,6 +210,22 @@ void OsmPbfReader::setConfiguration(const Settings &conf)
   ConfigOptions configOptions(conf);
   setMaxElementsPerMap(configOptions.getMaxElementsPerPartialMap());
   _addSourceDateTime = configOptions.getReaderAddSourceDatetime();
+  _decodeThreads = configOptions.getPbfReaderDecodeThreads();
+  setBoundingBox(configOptions.getPbfReaderBoundingBox());
+}
+
+void OsmPbfReader::setBounds(const geos::geom::Envelope& bounds)
+{
+  _bounds = bounds;
+  _useBounds = true;
+}
+
+void OsmPbfReader::setBoundingBox(const QString bbox)
+{
+  if (!bbox.trimmed().isEmpty())
+  {
+    setBounds(GeometryUtils::envelopeFromConfigString(bbox));
+  }
 }
 
 void OsmPbfReader::_addTag(boost::shared_ptr<Element> e, QString key, QString value)
@@ -385,19 +475,31 @@ void OsmPbfReader::_loadDenseNodes(const DenseNodes& dn)
     _denseNodeTmp.resize(size);
   }
 
-  // the file uses delta encoding
-  long lon = 0;
-  long lat = 0;
-  long id = 0;
+  // the file uses delta encoding. Decode the deltas in bulk over flat arrays rather than one
+  // element at a time; the kernels in PbfDeltaDecode use SSE2 where available.
+  if (size > 0)
+  {
+    _denseIdTmp.resize(size);
+    _denseLatTmp.resize(size);
+    _denseLonTmp.resize(size);
+    _denseXTmp.resize(size);
+    _denseYTmp.resize(size);
+    for (size_t i = 0; i < size; i++)
+    {
+      _denseIdTmp[i] = dn.id().Get(i);
+      _denseLonTmp[i] = dn.lon().Get(i);
+      _denseLatTmp[i] = dn.lat().Get(i);
+    }
+    PbfDeltaDecode::cumulativeSum(&_denseIdTmp[0], size);
+    PbfDeltaDecode::cumulativeSum(&_denseLonTmp[0], size);
+    PbfDeltaDecode::cumulativeSum(&_denseLatTmp[0], size);
+    PbfDeltaDecode::toDegrees(&_denseLonTmp[0], size, _lonOffset, _granularity, &_denseXTmp[0]);
+    PbfDeltaDecode::toDegrees(&_denseLatTmp[0], size, _latOffset, _granularity, &_denseYTmp[0]);
+  }
   for (size_t i = 0; i < size; i++)
   {
-    id += dn.id().Get(i);
-    lon += dn.lon().Get(i);
-    lat += dn.lat().Get(i);
-    long newId = _getNodeId(id);
-    double x = _convertLon(lon);
-    double y = _convertLat(lat);
-    _denseNodeTmp[i] = Node::newSp(_status, newId, x, y, _circularError);
+    long newId = _getNodeId((long)_denseIdTmp[i]);
+    _denseNodeTmp[i] = Node::newSp(_status, newId, _denseXTmp[i], _denseYTmp[i], _circularError);
     //NodePtr n(Node::newSp(_status, newId, x, y, _circularError));
     //nodes[i].reset(new Node(_status, newId, x, y, _circularError));
     if (_map->containsNode(newId))
@@ -645,6 +747,220 @@ vector<OsmPbfReader::BlobLocation> OsmPbfReader::loadOsmDataBlobOffsets(istream&
   return result;
 }
 
+void OsmPbfReader::_computeBlockEnvelope(BlockBounds& bb)
+{
+  const PrimitiveBlock& pb = _d->primitiveBlock;
+  _granularity = pb.granularity();
+  _lonOffset = pb.lon_offset();
+  _latOffset = pb.lat_offset();
+
+  bb.hasNodes = false;
+  bb.envelope.setToNull();
+
+  for (int i = 0; i < pb.primitivegroup().size(); i++)
+  {
+    const PrimitiveGroup& pg = pb.primitivegroup().Get(i);
+
+    for (int j = 0; j < pg.nodes().size(); j++)
+    {
+      const hoot::pb::Node& n = pg.nodes().Get(j);
+      bb.envelope.expandToInclude(_convertLon(n.lon()), _convertLat(n.lat()));
+      bb.hasNodes = true;
+    }
+
+    const DenseNodes& dn = pg.dense();
+    size_t size = std::min(dn.id_size(), std::min(dn.lat_size(), dn.lon_size()));
+    // the file uses delta encoding
+    long lon = 0;
+    long lat = 0;
+    for (size_t j = 0; j < size; j++)
+    {
+      lon += dn.lon().Get(j);
+      lat += dn.lat().Get(j);
+      bb.envelope.expandToInclude(_convertLon(lon), _convertLat(lat));
+      bb.hasNodes = true;
+    }
+  }
+}
+
+vector<OsmPbfReader::BlockBounds> OsmPbfReader::_buildBlockIndex(istream& strm)
+{
+  vector<BlockBounds> result;
+
+  _in = &strm;
+
+  _in->clear();
+  _in->seekg(0, ios::end);
+  long length = _in->tellg();
+  _in->seekg(0, ios::beg);
+
+  while (_in->eof() == false && _in->tellg() < length)
+  {
+    long headerOffset = _in->tellg();
+    _parseBlobHeader();
+    if (_d->blobHeader.type() == PBF_OSM_DATA)
+    {
+      // decode the block so its node envelope can be computed; this is the one time cost that
+      // the cached index amortizes away
+      _parseBlob();
+      size_t size = _d->blob.raw_size();
+      const char* inflated = _inflate(_d->blob.zlib_data(), size);
+      _d->primitiveBlock.Clear();
+      _d->primitiveBlock.ParseFromArray(inflated, size);
+
+      BlockBounds bb;
+      bb.headerOffset = headerOffset;
+      _computeBlockEnvelope(bb);
+      result.push_back(bb);
+    }
+    else
+    {
+      _in->seekg(_d->blobHeader.datasize(), ios_base::cur);
+    }
+  }
+
+  return result;
+}
+
+bool OsmPbfReader::_readBlockIndex(const QString& indexPath, const QString& pbfPath,
+                                   vector<BlockBounds>& blocks)
+{
+  QFile file(indexPath);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    return false;
+  }
+
+  QFileInfo pbfInfo(pbfPath);
+  QTextStream in(&file);
+
+  // the first line ties the index to the file contents it was built from
+  QStringList header = in.readLine().split(" ");
+  if (header.size() != 3 || header[0] != "hoot.pbf.block.index.v1" ||
+      header[1].toLongLong() != pbfInfo.size() ||
+      header[2].toUInt() != pbfInfo.lastModified().toTime_t())
+  {
+    LOG_DEBUG("Block index is stale or unrecognized, rebuilding: " << indexPath);
+    return false;
+  }
+
+  blocks.clear();
+  while (!in.atEnd())
+  {
+    QString line = in.readLine().trimmed();
+    if (line.isEmpty())
+    {
+      continue;
+    }
+    QStringList fields = line.split(" ");
+    if (fields.size() != 6)
+    {
+      LOG_DEBUG("Bad block index record, rebuilding: " << indexPath);
+      return false;
+    }
+    BlockBounds bb;
+    bb.headerOffset = fields[0].toLong();
+    bb.hasNodes = fields[1].toInt() != 0;
+    if (bb.hasNodes)
+    {
+      bb.envelope = geos::geom::Envelope(fields[2].toDouble(), fields[4].toDouble(),
+                                         fields[3].toDouble(), fields[5].toDouble());
+    }
+    blocks.push_back(bb);
+  }
+
+  return true;
+}
+
+void OsmPbfReader::_writeBlockIndex(const QString& indexPath, const QString& pbfPath,
+                                    const vector<BlockBounds>& blocks)
+{
+  QFile file(indexPath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+  {
+    // read only locations are fine; the index just gets rebuilt next time
+    LOG_INFO("Unable to cache block index (" << indexPath << "); it will be rebuilt on the "
+             "next bounded read.");
+    return;
+  }
+
+  QFileInfo pbfInfo(pbfPath);
+  QTextStream out(&file);
+  out << "hoot.pbf.block.index.v1 " << pbfInfo.size() << " "
+      << pbfInfo.lastModified().toTime_t() << "\n";
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    const BlockBounds& bb = blocks[i];
+    out << bb.headerOffset << " " << (bb.hasNodes ? 1 : 0) << " "
+        << QString::number(bb.envelope.getMinX(), 'g', 17) << " "
+        << QString::number(bb.envelope.getMinY(), 'g', 17) << " "
+        << QString::number(bb.envelope.getMaxX(), 'g', 17) << " "
+        << QString::number(bb.envelope.getMaxY(), 'g', 17) << "\n";
+  }
+}
+
+void OsmPbfReader::buildBoundsIndex(const QString& file)
+{
+  _init(false);
+  if (isSupported(file) == false)
+  {
+    throw HootException("An invalid file format was specified: " + file + ".");
+  }
+  open(file);
+  vector<BlockBounds> blocks = _buildBlockIndex(*_in);
+  _writeBlockIndex(file + ".bbidx", file, blocks);
+  close();
+}
+
+vector<OsmPbfReader::BlockBounds> OsmPbfReader::_loadOrBuildBlockIndex(const QString& path,
+                                                                       istream& strm)
+{
+  QString indexPath = path + ".bbidx";
+  vector<BlockBounds> blocks;
+  if (_readBlockIndex(indexPath, path, blocks))
+  {
+    return blocks;
+  }
+  blocks = _buildBlockIndex(strm);
+  _writeBlockIndex(indexPath, path, blocks);
+  return blocks;
+}
+
+bool OsmPbfReader::_blockIntersectsBounds(const BlockBounds& bb) const
+{
+  // blocks without nodes can't be placed spatially, so always read them
+  return bb.hasNodes == false || _bounds.intersects(bb.envelope);
+}
+
+void OsmPbfReader::_parseWithBounds(const QString& path, istream* strm, OsmMapPtr map)
+{
+  _in = strm;
+  _map = map;
+  _firstPartialReadCompleted = false;
+
+  vector<BlockBounds> blocks = _loadOrBuildBlockIndex(path, *strm);
+
+  // consume the OSMHeader
+  strm->clear();
+  strm->seekg(0, ios::beg);
+  _parseBlobHeader();
+  _parseBlob();
+  _parseOsmHeader();
+
+  long blocksRead = 0;
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    if (_blockIntersectsBounds(blocks[i]))
+    {
+      parseBlob(blocks[i].headerOffset, strm, map);
+      blocksRead++;
+    }
+  }
+
+  LOG_INFO("Bounded read loaded " << blocksRead << " of " << blocks.size() <<
+           " blocks from " << path);
+}
+
 void OsmPbfReader::_loadRelation(const hoot::pb::Relation& r)
 {
   long newId = _createRelationId(r.id());
@@ -765,7 +1081,7 @@ void OsmPbfReader::_loadRelation(const hoot::pb::Relation& r)
     }
     logWarnCount++;
   }
-  _map->addRelation(newRelation);
+  _relationTmp.push_back(newRelation);
 
   LOG_TRACE("Loaded relation: " << newRelation->getElementId());
 }
@@ -782,6 +1098,10 @@ void OsmPbfReader::_loadRelations()
       _loadRelation(pg.relations().Get(j));
     }
   }
+
+  // add the whole block's worth of relations in one shot to cut down on per relation bookkeeping.
+  _map->addRelations(_relationTmp);
+  _relationTmp.clear();
 }
 
 void OsmPbfReader::_loadStrings()
@@ -903,7 +1223,7 @@ void OsmPbfReader::_loadWay(const hoot::pb::Way& w)
     }
     logWarnCount++;
   }
-  _map->addWay(newWay);
+  _wayTmp.push_back(newWay);
 
   LOG_TRACE("Loaded way: " << newWay->getElementId());
 }
@@ -920,6 +1240,10 @@ void OsmPbfReader::_loadWays()
       _loadWay(pg.ways().Get(j));
     }
   }
+
+  // add the whole block's worth of ways in one shot to cut down on per way bookkeeping.
+  _map->addWays(_wayTmp);
+  _wayTmp.clear();
 }
 
 void OsmPbfReader::parseBlob(BlobLocation& bl, istream* strm, OsmMapPtr map)
@@ -1093,6 +1417,12 @@ void OsmPbfReader::parse(istream* strm, OsmMapPtr map)
   // read OSMHeader
   _parseOsmHeader();
 
+  if (_decodeThreads != 1)
+  {
+    _parseBlobsParallel();
+    return;
+  }
+
   // read blob header
   _parseBlobHeader();
 
@@ -1118,6 +1448,73 @@ void OsmPbfReader::parse(istream* strm, OsmMapPtr map)
   }
 }
 
+void OsmPbfReader::_parseBlobsParallel()
+{
+  int threads = _decodeThreads;
+  if (threads <= 0)
+  {
+    threads = QThread::idealThreadCount();
+  }
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+
+  // keep enough blocks in flight to cover scheduling gaps without holding too many inflated
+  // blocks in RAM at once.
+  const size_t batchSize = threads * 2;
+  vector< boost::shared_ptr<PbfBlockDecodeTask> > batch;
+  batch.reserve(batchSize);
+
+  _parseBlobHeader();
+  bool done = _in->eof();
+  while (!done)
+  {
+    batch.clear();
+
+    // the header and raw blob reads are sequential file I/O and stay on this thread.
+    while (batch.size() < batchSize && !done)
+    {
+      if (_d->blobHeader.type() == PBF_OSM_DATA)
+      {
+        boost::shared_ptr<PbfBlockDecodeTask> task(new PbfBlockDecodeTask());
+        int size = _d->blobHeader.datasize();
+        task->raw.resize(size);
+        _in->read((char*)task->raw.data(), size);
+        if (_in->gcount() != size)
+        {
+          throw HootException(QString("Did not read the expected number of bytes from blob. "
+                                      "(%1 instead of %2)").
+                              arg(_in->gcount()).arg(size));
+        }
+        batch.push_back(task);
+      }
+      else
+      {
+        _in->seekg(_d->blobHeader.datasize(), ios_base::cur);
+      }
+      _parseBlobHeader();
+      done = _in->eof();
+    }
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+      pool.start(batch[i].get());
+    }
+    pool.waitForDone();
+
+    // element construction mutates the id maps and the map, so it stays serial and in file
+    // order. Id assignment is therefore identical to the serial code path.
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+      if (batch[i]->error.isEmpty() == false)
+      {
+        throw HootException(batch[i]->error);
+      }
+      _d->primitiveBlock.Swap(&batch[i]->block);
+      _loadOsmData();
+    }
+  }
+}
+
 /// @todo this needs to be integrated with the OsmMapReader/PartialOsmMapReader interface somehow
 void OsmPbfReader::read(QString path, OsmMapPtr map)
 {
@@ -1156,7 +1553,14 @@ void OsmPbfReader::_readFile(QString path, OsmMapPtr map)
     throw HootException(QString("Error reading %1").arg(path));
   }
 
-  parse(&input, map);
+  if (_useBounds)
+  {
+    _parseWithBounds(path, &input, map);
+  }
+  else
+  {
+    parse(&input, map);
+  }
 }
 
 void OsmPbfReader::read(OsmMapPtr map)
@@ -1222,6 +1626,7 @@ void OsmPbfReader::open(QString urlStr)
   }
   _in = fp;
   _needToCloseInput = true;
+  _urlStr = urlStr;
 
   // Have to call initial partial to ensure stream functions work
   initializePartial();
@@ -1244,6 +1649,28 @@ void OsmPbfReader::initializePartial()
   if ( _in != NULL )
   {
     _blobs = loadOsmDataBlobOffsets(*_in);
+    if (_useBounds && _urlStr.isEmpty() == false)
+    {
+      // drop the blobs that can't intersect the bounds so the partial read skips them entirely
+      vector<BlockBounds> blocks = _loadOrBuildBlockIndex(_urlStr, *_in);
+      QHash<long, bool> keep;
+      for (size_t i = 0; i < blocks.size(); i++)
+      {
+        keep.insert(blocks[i].headerOffset, _blockIntersectsBounds(blocks[i]));
+      }
+      vector<BlobLocation> filtered;
+      filtered.reserve(_blobs.size());
+      for (size_t i = 0; i < _blobs.size(); i++)
+      {
+        if (keep.value(_blobs[i].headerOffset, true))
+        {
+          filtered.push_back(_blobs[i]);
+        }
+      }
+      LOG_INFO("Bounded partial read will load " << filtered.size() << " of " << _blobs.size() <<
+               " blocks from " << _urlStr);
+      _blobs = filtered;
+    }
     _in->seekg (0, ios::end);    _fileLength = _in->tellg();
     _in->seekg (0, ios::beg);
   }
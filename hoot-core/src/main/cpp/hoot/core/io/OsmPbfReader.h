@@ -34,6 +34,9 @@
 // GDAL
 class OGRSpatialReference;
 
+// geos
+#include <geos/geom/Envelope.h>
+
 // Qt
 #include <QHash>
 #include <QString>
@@ -45,6 +48,7 @@ class OGRSpatialReference;
 
 // hoot
 #include "PartialOsmMapReader.h"
+#include <hoot/core/ops/Boundable.h>
 #include <hoot/core/util/Configurable.h>
 
 // tgs
@@ -66,7 +70,7 @@ class OsmPbfReaderData;
 /**
  * A writer for http://wiki.openstreetmap.org/wiki/PBF_Format
  */
-class OsmPbfReader : public PartialOsmMapReader, public Configurable
+class OsmPbfReader : public PartialOsmMapReader, public Configurable, public Boundable
 {
 public:
   class BlobLocation
@@ -79,6 +83,19 @@ public:
     long getSize() const { return (blobOffset - headerOffset) + blobSize; }
   };
 
+  /**
+   * The location of one OSMData block along with the envelope of the nodes it contains. Blocks
+   * with no nodes (ways/relations only) can't be located spatially, so they're flagged and always
+   * read when filtering by bounds.
+   */
+  class BlockBounds
+  {
+  public:
+    long headerOffset;
+    bool hasNodes;
+    geos::geom::Envelope envelope;
+  };
+
   static QString maxElementsPerMapKey() { return "pbf.reader.max.elements.per.partial.map"; }
 
   static std::string className() { return "hoot::OsmPbfReader"; }
@@ -141,6 +158,20 @@ public:
    */
   void setPermissive(bool permissive) { _permissive = permissive; }
 
+  /**
+   * Restricts reading to the OSMData blocks whose node envelope intersects bounds (WGS84). The
+   * filter operates at block granularity using a side index cached next to the file (see
+   * pbf.reader.bounding.box), so the result is a superset of the features in the box - callers
+   * needing an exact crop should still apply one afterwards.
+   */
+  virtual void setBounds(const geos::geom::Envelope& bounds);
+
+  /**
+   * Convenience overload taking a "minx,miny,maxx,maxy" string. An empty string clears nothing
+   * and is ignored.
+   */
+  void setBoundingBox(const QString bbox);
+
   virtual bool isSupported(QString urlStr);
 
   virtual void open(QString urlStr);
@@ -173,6 +204,14 @@ public:
    */
   bool isSorted(const QString file);
 
+  /**
+   * Builds (or rebuilds) the cached block bounds index for the given .osm.pbf file and writes it
+   * next to the file as file + ".bbidx". Bounded reads (see setBounds) build this lazily on
+   * first use; pre-building it with the pbf-build-index command keeps that cost out of
+   * production reads.
+   */
+  void buildBoundsIndex(const QString& file);
+
 private:
 
   Meters _circularError;
@@ -181,6 +220,15 @@ private:
   bool _needToCloseInput;
 
   std::vector< boost::shared_ptr<hoot::Node> > _denseNodeTmp;
+  std::vector< boost::shared_ptr<hoot::Way> > _wayTmp;
+  std::vector< boost::shared_ptr<hoot::Relation> > _relationTmp;
+
+  // reusable scratch arrays for the bulk dense node decode; see PbfDeltaDecode
+  std::vector<qint64> _denseIdTmp;
+  std::vector<qint64> _denseLatTmp;
+  std::vector<qint64> _denseLonTmp;
+  std::vector<double> _denseXTmp;
+  std::vector<double> _denseYTmp;
 
   /// The last position of the pointer while reading data.
   long _lastPosition;
@@ -212,6 +260,13 @@ private:
   long _lonOffset;
   long _dateGranularity;
 
+  // see pbf.reader.decode.threads; 1 keeps the serial code path.
+  int _decodeThreads;
+
+  // when _useBounds is set, blocks whose envelope misses _bounds are skipped.
+  geos::geom::Envelope _bounds;
+  bool _useBounds;
+
   bool _useFileStatus;
 
   //for partial reading of blobs
@@ -253,6 +308,46 @@ private:
 
   const char* _inflate(const std::string& compressed, size_t rawSize);
 
+  /**
+   * Reads the remaining OSMData blobs, fanning the inflate + protobuf parse out to a worker pool
+   * while the file reads and element construction stay on this thread. Expects the OSM header to
+   * have already been consumed from _in.
+   */
+  void _parseBlobsParallel();
+
+  /**
+   * Returns the per block bounds index for the file at path, reading the cached side index
+   * (path + ".bbidx") when it is present and still matches the file, and building and caching it
+   * otherwise. Leaves the stream position undefined.
+   */
+  std::vector<BlockBounds> _loadOrBuildBlockIndex(const QString& path, std::istream& strm);
+
+  /**
+   * Scans every OSMData block in the stream and computes its node envelope.
+   */
+  std::vector<BlockBounds> _buildBlockIndex(std::istream& strm);
+
+  /**
+   * Computes the node envelope of the primitive block currently decoded in _d.
+   */
+  void _computeBlockEnvelope(BlockBounds& bb);
+
+  bool _readBlockIndex(const QString& indexPath, const QString& pbfPath,
+                       std::vector<BlockBounds>& blocks);
+
+  void _writeBlockIndex(const QString& indexPath, const QString& pbfPath,
+                        const std::vector<BlockBounds>& blocks);
+
+  /**
+   * Like parse(), but consults the block index and skips blocks that can't intersect _bounds.
+   */
+  void _parseWithBounds(const QString& path, std::istream* strm, OsmMapPtr map);
+
+  /**
+   * Returns true if the given block needs to be read when filtering by _bounds.
+   */
+  bool _blockIntersectsBounds(const BlockBounds& bb) const;
+
   void _loadDenseNodes();
 
   void _loadDenseNodes(const hoot::pb::DenseNodes& dn);
@@ -33,6 +33,7 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/proto/FileFormat.pb.h>
 #include <hoot/core/proto/OsmFormat.pb.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
@@ -47,8 +48,15 @@ using namespace hoot::pb;
 
 // Qt
 #include <Qt/qendian.h>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 // Standard Includes
+#include <deque>
 #include <fstream>
 
 // ZLib Includes
@@ -67,6 +75,103 @@ HOOT_FACTORY_REGISTER(OsmMapWriter, OsmPbfWriter)
 const char* const OsmPbfWriter::OSM_DATA = "OSMData";
 const char* const OsmPbfWriter::OSM_HEADER = "OSMHeader";
 
+/**
+ * Serializes and deflates one primitive block off the main thread and holds the finished bytes
+ * until the coordinating thread flushes it. Blocks are flushed strictly in submission order, so
+ * the output is byte-identical to a serial write at the same compression level.
+ */
+class PbfBlobEncodeTask : public QRunnable
+{
+public:
+
+  PrimitiveBlock block;
+  int compressionLevel;
+  std::string out;
+  QString error;
+
+  PbfBlobEncodeTask() : compressionLevel(-1), _done(false) { setAutoDelete(false); }
+
+  bool isDone() { QMutexLocker lock(&_mutex); return _done; }
+
+  void waitForDone()
+  {
+    QMutexLocker lock(&_mutex);
+    while (!_done)
+    {
+      _doneWait.wait(&_mutex);
+    }
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      _encode();
+    }
+    catch (const HootException& e)
+    {
+      error = e.getWhat();
+    }
+    catch (const std::exception& e)
+    {
+      error = QString::fromUtf8(e.what());
+    }
+    QMutexLocker lock(&_mutex);
+    _done = true;
+    _doneWait.wakeAll();
+  }
+
+private:
+
+  bool _done;
+  QMutex _mutex;
+  QWaitCondition _doneWait;
+
+  void _encode()
+  {
+    int rawSize = block.ByteSize();
+    std::string raw;
+    raw.resize(rawSize);
+    block.SerializePartialToArray((char*)raw.data(), rawSize);
+
+    std::string deflated;
+    deflated.resize(rawSize + 1024);
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    deflateInit(&strm, compressionLevel);
+    strm.next_in = (Bytef*)raw.data();
+    strm.avail_in = rawSize;
+    strm.avail_out = deflated.size();
+    strm.next_out = (Bytef*)deflated.data();
+    int result = deflate(&strm, Z_FINISH);
+    if (result < Z_OK)
+    {
+      throw HootException(QString("Error deflating zlib stream. %1").arg(result));
+    }
+    result = deflateEnd(&strm);
+    if (result != Z_OK)
+    {
+      throw HootException(QString("Error freeing deflate stream. %1").arg(result));
+    }
+    size_t deflatedSize = strm.total_out;
+
+    Blob blob;
+    blob.set_raw_size(rawSize);
+    blob.set_zlib_data(deflated.data(), deflatedSize);
+
+    BlobHeader blobHeader;
+    blobHeader.set_type(PBF_OSM_DATA);
+    blobHeader.set_datasize(blob.ByteSize());
+
+    uint32_t blobHeaderSize = htonl(blobHeader.ByteSize());
+    out.append((const char*)&blobHeaderSize, 4);
+    blobHeader.AppendPartialToString(&out);
+    blob.AppendPartialToString(&out);
+  }
+};
+
 class OsmPbfWriterData
 {
 public:
@@ -75,6 +180,10 @@ public:
   HeaderBlock headerBlock;
   HeaderBBox headerBBox;
   PrimitiveBlock primitiveBlock;
+
+  // parallel blob encoding state; see pbf.writer.write.threads.
+  QThreadPool encodePool;
+  std::deque< boost::shared_ptr<PbfBlobEncodeTask> > encodeQueue;
 };
 
 OsmPbfWriter::OsmPbfWriter()
@@ -93,7 +202,8 @@ OsmPbfWriter::OsmPbfWriter()
   _nodeIdDelta = 0;
   _relationIdDelta = 0;
   _wayIdDelta = 0;
-  _compressionLevel = -1;
+  _compressionLevel = ConfigOptions().getPbfWriterCompressionLevel();
+  _writeThreads = ConfigOptions().getPbfWriterWriteThreads();
   _includeVersion = true;
 
   GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -179,6 +289,7 @@ void OsmPbfWriter::finalizePartial()
 {
   // finalize the current blob.
   _writePrimitiveBlock();
+  _flushWriteQueue(true);
 }
 
 void OsmPbfWriter::_initBlob()
@@ -231,11 +342,26 @@ void OsmPbfWriter::open(QString url)
 
 void OsmPbfWriter::close()
 {
+  // drain any blobs still being encoded; errors can't propagate out of the destructor path, so
+  // they're logged instead.
+  if (_d != 0)
+  {
+    try
+    {
+      _flushWriteQueue(true);
+    }
+    catch (const HootException& e)
+    {
+      LOG_ERROR(e.getWhat());
+    }
+  }
+
   if (_openStream.get())
   {
     _openStream->close();
   }
   delete _d;
+  _d = 0;
 }
 
 void OsmPbfWriter::setIdDelta(long nodeIdDelta, long wayIdDelta, long relationIdDelta)
@@ -285,6 +411,7 @@ void OsmPbfWriter::write(ConstOsmMapPtr map, ostream* strm)
 
   // finalize the current blob.
   _writePrimitiveBlock();
+  _flushWriteQueue(true);
 }
 
 void OsmPbfWriter::write(ConstOsmMapPtr map, const QString& path)
@@ -651,10 +778,58 @@ void OsmPbfWriter::_writePrimitiveBlock()
 {
   if (_dirty)
   {
-    int size = _d->primitiveBlock.ByteSize();
-    _d->primitiveBlock.SerializePartialToArray(_getBuffer(size), size);
-    _writeBlob(_buffer.data(), size, PBF_OSM_DATA);
-    _initBlob();
+    if (_writeThreads != 1)
+    {
+      _enqueuePrimitiveBlock();
+      _initBlob();
+    }
+    else
+    {
+      int size = _d->primitiveBlock.ByteSize();
+      _d->primitiveBlock.SerializePartialToArray(_getBuffer(size), size);
+      _writeBlob(_buffer.data(), size, PBF_OSM_DATA);
+      _initBlob();
+    }
+  }
+}
+
+void OsmPbfWriter::_enqueuePrimitiveBlock()
+{
+  int threads = _writeThreads;
+  if (threads <= 0)
+  {
+    threads = QThread::idealThreadCount();
+  }
+  _d->encodePool.setMaxThreadCount(threads);
+
+  boost::shared_ptr<PbfBlobEncodeTask> task(new PbfBlobEncodeTask());
+  task->compressionLevel = _compressionLevel;
+  task->block.Swap(&_d->primitiveBlock);
+  _d->encodeQueue.push_back(task);
+  _d->encodePool.start(task.get());
+
+  // bound the number of blocks in flight; each one holds a serialized and a deflated copy of a
+  // ~15MB primitive block.
+  while (_d->encodeQueue.size() > (size_t)threads * 2)
+  {
+    _d->encodeQueue.front()->waitForDone();
+    _flushWriteQueue(false);
+  }
+  _flushWriteQueue(false);
+}
+
+void OsmPbfWriter::_flushWriteQueue(bool waitForAll)
+{
+  while (_d->encodeQueue.size() > 0 && (waitForAll || _d->encodeQueue.front()->isDone()))
+  {
+    boost::shared_ptr<PbfBlobEncodeTask> task = _d->encodeQueue.front();
+    task->waitForDone();
+    _d->encodeQueue.pop_front();
+    if (task->error.isEmpty() == false)
+    {
+      throw HootException(task->error);
+    }
+    _out->write(task->out.data(), task->out.size());
   }
 }
 
@@ -177,6 +177,8 @@ private:
 
   std::string _buffer;
   int _compressionLevel;
+  // see pbf.writer.write.threads; 1 keeps the serial code path.
+  int _writeThreads;
   std::string _deflateBuffer;
   int _deflateSize;
   bool _dirty;
@@ -245,6 +247,18 @@ private:
 
   void _writePrimitiveBlock();
 
+  /**
+   * Hands the current primitive block to the encode pool for serialization and compression and
+   * flushes any finished blobs to the output in submission order.
+   */
+  void _enqueuePrimitiveBlock();
+
+  /**
+   * Writes finished blobs from the front of the encode queue to the output. When waitForAll is
+   * true this blocks until the queue is empty.
+   */
+  void _flushWriteQueue(bool waitForAll);
+
   void _writeRelation(const boost::shared_ptr<const hoot::Relation>& r);
 
   void _writeWay(const boost::shared_ptr<const hoot::Way>& w);
@@ -141,6 +141,7 @@ void OsmXmlReader::_createNode(const QXmlAttributes &attributes)
 
 void OsmXmlReader::_createRelation(const QXmlAttributes &attributes)
 {
+  _relationMemberBuffer.clear();
   _relationId = _parseLong(attributes.value("id"));
   long newId = _getRelationId(_relationId);
 
@@ -180,6 +181,7 @@ void OsmXmlReader::_createRelation(const QXmlAttributes &attributes)
 
 void OsmXmlReader::_createWay(const QXmlAttributes &attributes)
 {
+  _wayNodeIdBuffer.clear();
   _wayId = _parseLong(attributes.value("id"));
 
   long newId;
@@ -507,9 +509,8 @@ bool OsmXmlReader::startElement(const QString & /* namespaceURI */,
         {
           long newRef = _nodeIdMap.value(ref);
 
-          WayPtr w = boost::dynamic_pointer_cast<Way, Element>(_element);
-
-          w->addNode(newRef);
+          // buffered; handed to the way in one shot when the way element closes.
+          _wayNodeIdBuffer.push_back(newRef);
         }
       }
       else if (qName == "member" && _element)
@@ -518,8 +519,6 @@ bool OsmXmlReader::startElement(const QString & /* namespaceURI */,
         QString type = attributes.value("type");
         QString role = attributes.value("role");
 
-        RelationPtr r = boost::dynamic_pointer_cast<Relation, Element>(_element);
-
         if (type == "node")
         {
           if (_nodeIdMap.contains(ref) == false)
@@ -538,7 +537,7 @@ bool OsmXmlReader::startElement(const QString & /* namespaceURI */,
           else
           {
             long newRef = _nodeIdMap.value(ref);
-            r->addElement(role, ElementType::Node, newRef);
+            _relationMemberBuffer.push_back(RelationData::Entry(role, ElementId::node(newRef)));
           }
         }
         else if (type == "way")
@@ -559,14 +558,14 @@ bool OsmXmlReader::startElement(const QString & /* namespaceURI */,
           else
           {
             long newRef = _wayIdMap.value(ref);
-            r->addElement(role, ElementType::Way, newRef);
+            _relationMemberBuffer.push_back(RelationData::Entry(role, ElementId::way(newRef)));
           }
         }
         else if (type == "relation")
         {
           // relations may be out of order so we don't check for consistency at this stage.
           long newRef = _getRelationId(ref);
-          r->addElement(role, ElementType::Relation, newRef);
+          _relationMemberBuffer.push_back(RelationData::Entry(role, ElementId::relation(newRef)));
         }
         else
         {
@@ -682,11 +681,15 @@ bool OsmXmlReader::endElement(const QString & /* namespaceURI */,
     else if (qName == "way")
     {
         WayPtr w = boost::dynamic_pointer_cast<Way, Element>(_element);
+        w->setNodesViaSwap(_wayNodeIdBuffer);
+        _wayNodeIdBuffer.clear();
         _map->addWay(w);
     }
     else if (qName == "relation")
     {
         RelationPtr r = boost::dynamic_pointer_cast<Relation, Element>(_element);
+        r->setMembersViaSwap(_relationMemberBuffer);
+        _relationMemberBuffer.clear();
         _map->addRelation(r);
     }
   }
@@ -28,6 +28,7 @@
 #define OSMXMLREADER_H
 
 // Local
+#include <hoot/core/elements/RelationData.h>
 #include <hoot/core/elements/Tags.h>
 namespace hoot
 {
@@ -106,6 +107,10 @@ protected:
   std::deque<long> _nodeIds;
   /// Maps from old node ids to new node ids.
   QHash<long, long> _nodeIdMap;
+  // scratch buffers for the element currently being parsed; swapped into the element when its
+  // closing tag is seen so each way/relation pays for one list handoff instead of one per child.
+  std::vector<long> _wayNodeIdBuffer;
+  std::vector<RelationData::Entry> _relationMemberBuffer;
   QHash<long, long> _relationIdMap;
   QHash<long, long> _wayIdMap;
   hoot::Tags _tags;
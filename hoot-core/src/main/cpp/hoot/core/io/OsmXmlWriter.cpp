@@ -47,7 +47,6 @@ using namespace boost;
 #include <QBuffer>
 #include <QDateTime>
 #include <QFile>
-#include <QXmlStreamWriter>
 
 using namespace geos::geom;
 using namespace std;
@@ -185,8 +184,14 @@ QString OsmXmlWriter::_typeName(ElementType e)
 
 void OsmXmlWriter::_initWriter()
 {
-  _writer.reset(new QXmlStreamWriter(_fp.get()));
-  _writer->setCodec("UTF-8");
+  if (ConfigOptions().getOsmMapWriterFastXml())
+  {
+    _writer.reset(new FastXmlWriterStream(_fp.get()));
+  }
+  else
+  {
+    _writer.reset(new QtXmlWriterStream(_fp.get()));
+  }
 
   if (_formatXml)
   {
@@ -470,8 +475,8 @@ void OsmXmlWriter::writePartial(const ConstNodePtr& n)
 
   _writeMetadata(n.get());
 
-  _writer->writeAttribute("lat", QString::number(n->getY(), 'f', _precision));
-  _writer->writeAttribute("lon", QString::number(n->getX(), 'f', _precision));
+  _writer->writeDoubleAttribute("lat", n->getY(), _precision);
+  _writer->writeDoubleAttribute("lon", n->getX(), _precision);
 
   _writeTags(n);
 
@@ -488,16 +493,21 @@ void OsmXmlWriter::_writePartialIncludePoints(const ConstWayPtr& w, ConstOsmMapP
 
   _writeMetadata(w.get());
 
+  // resolve the whole way's coordinates in one call rather than one map lookup per node.
+  std::vector<geos::geom::Coordinate> coords;
+  if (_includePointInWays)
+  {
+    map->getNodeCoordinates(w->getNodeIds(), coords);
+  }
+
   for (size_t j = 0; j < w->getNodeCount(); j++)
   {
     _writer->writeStartElement("nd");
     _writer->writeAttribute("ref", QString::number(w->getNodeId(j)));
-    const long nid = w->getNodeId(j);
     if (_includePointInWays)
     {
-      ConstNodePtr n = map->getNode(nid);
-      _writer->writeAttribute("x", QString::number(n->getX(), 'g', _precision));
-      _writer->writeAttribute("y", QString::number(n->getY(), 'g', _precision));
+      _writer->writeAttribute("x", QString::number(coords[j].x, 'g', _precision));
+      _writer->writeAttribute("y", QString::number(coords[j].y, 'g', _precision));
     }
     _writer->writeEndElement();
   }
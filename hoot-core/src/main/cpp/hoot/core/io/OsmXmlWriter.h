@@ -29,6 +29,7 @@
 
 // hoot
 #include <hoot/core/io/PartialOsmMapWriter.h>
+#include <hoot/core/io/XmlWriterStream.h>
 
 // Boost
 #include <boost/shared_ptr.hpp>
@@ -38,7 +39,6 @@
 #include <QHash>
 #include <QXmlDefaultHandler>
 class QString;
-class QXmlStreamWriter;
 
 // Standard
 #include <deque>
@@ -124,7 +124,9 @@ private:
   int _precision;
   std::auto_ptr<QIODevice> _fp;
   int _encodingErrorCount;
-  boost::shared_ptr<QXmlStreamWriter> _writer;
+  // either the QXmlStreamWriter based default or the buffered raw-output fast path; see
+  // osm.map.writer.fast.xml.
+  boost::shared_ptr<XmlWriterStream> _writer;
   geos::geom::Envelope _bounds;
 
   static QString _typeName(ElementType e);
@@ -0,0 +1,336 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ParallelOgrInputStream.h"
+
+// hoot
+#include <hoot/core/io/OgrReader.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/MapProjector.h>
+
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+// Standard
+#include <deque>
+
+using namespace std;
+
+namespace hoot
+{
+
+namespace // anonymous
+{
+
+// how many elements a worker hands over per queue operation.
+const int BATCH_SIZE = 256;
+
+}
+
+/**
+ * The shared state between the consumer and the worker threads: the list of layers still to be
+ * read and the bounded queue of element batches. Workers pull a layer at a time; the consumer
+ * sees the stream end once every worker has exited and the queue is drained.
+ */
+class ParallelOgrInputStreamImpl
+{
+public:
+
+  typedef vector<ElementPtr> Batch;
+
+  class Worker : public QThread
+  {
+  public:
+
+    Worker(ParallelOgrInputStreamImpl& owner) : _owner(owner) {}
+
+    virtual void run() { _owner.work(); }
+
+  private:
+
+    ParallelOgrInputStreamImpl& _owner;
+  };
+
+  ParallelOgrInputStreamImpl(const vector<ParallelOgrInputStream::Layer>& layers,
+    QString translation, int threadCount) :
+    _layers(layers),
+    _translation(translation),
+    _limit(-1),
+    _nextLayer(0),
+    _activeWorkers(0),
+    _aborted(false),
+    _started(false),
+    _currentIndex(0)
+  {
+    _threadCount = min(threadCount, (int)layers.size());
+    if (_threadCount < 1)
+    {
+      _threadCount = 1;
+    }
+    // enough in-flight batches that workers don't stall on a briefly busy consumer, without
+    // letting a fast layer read run far ahead of the writer.
+    _maxQueued = _threadCount * 2;
+  }
+
+  ~ParallelOgrInputStreamImpl()
+  {
+    close();
+  }
+
+  void setLimit(long limit) { _limit = limit; }
+
+  void work()
+  {
+    try
+    {
+      while (true)
+      {
+        ParallelOgrInputStream::Layer layer;
+        {
+          QMutexLocker lock(&_mutex);
+          if (_aborted || _nextLayer >= _layers.size())
+          {
+            break;
+          }
+          layer = _layers[_nextLayer++];
+        }
+
+        LOG_INFO("Reading: " + layer.path + " " + layer.name);
+
+        // each worker opens its own dataset handle, so no GDAL state is shared across threads.
+        OgrReader reader;
+        reader.setLimit(_limit);
+        reader.setTranslationFile(_translation);
+        reader.open(layer.path, layer.name);
+        reader.initializePartial();
+
+        Batch batch;
+        batch.reserve(BATCH_SIZE);
+        while (reader.hasMoreElements())
+        {
+          ElementPtr e = reader.readNextElement();
+          if (e.get())
+          {
+            batch.push_back(e);
+          }
+          if ((int)batch.size() >= BATCH_SIZE)
+          {
+            if (_push(batch) == false)
+            {
+              break;
+            }
+            batch.reserve(BATCH_SIZE);
+          }
+        }
+        if (!batch.empty())
+        {
+          _push(batch);
+        }
+
+        reader.finalizePartial();
+        reader.close();
+      }
+      _workerDone(QString());
+    }
+    catch (const HootException& e)
+    {
+      _workerDone(e.getWhat());
+    }
+    catch (const std::exception& e)
+    {
+      _workerDone(QString(e.what()));
+    }
+  }
+
+  bool hasMoreElements()
+  {
+    if (!_started)
+    {
+      _start();
+    }
+
+    if (_currentIndex < _currentBatch.size())
+    {
+      return true;
+    }
+    _currentBatch.clear();
+    _currentIndex = 0;
+
+    QMutexLocker lock(&_mutex);
+    while (_queue.empty() && _activeWorkers > 0)
+    {
+      _notEmpty.wait(&_mutex);
+    }
+    if (_error.isEmpty() == false)
+    {
+      QString error = _error;
+      _error.clear();
+      throw HootException(error);
+    }
+    if (_queue.empty())
+    {
+      return false;
+    }
+    _currentBatch.swap(_queue.front());
+    _queue.pop_front();
+    _notFull.wakeAll();
+    return true;
+  }
+
+  ElementPtr readNextElement()
+  {
+    if (hasMoreElements() == false)
+    {
+      throw HootException("No more elements available.");
+    }
+    return _currentBatch[_currentIndex++];
+  }
+
+  void close()
+  {
+    {
+      QMutexLocker lock(&_mutex);
+      _aborted = true;
+      _notFull.wakeAll();
+    }
+    for (size_t i = 0; i < _workers.size(); i++)
+    {
+      _workers[i]->wait();
+      delete _workers[i];
+    }
+    _workers.clear();
+    _currentBatch.clear();
+    _currentIndex = 0;
+  }
+
+private:
+
+  vector<ParallelOgrInputStream::Layer> _layers;
+  QString _translation;
+  long _limit;
+  int _threadCount;
+  int _maxQueued;
+
+  QMutex _mutex;
+  QWaitCondition _notFull;
+  QWaitCondition _notEmpty;
+  deque<Batch> _queue;
+  size_t _nextLayer;
+  int _activeWorkers;
+  bool _aborted;
+  QString _error;
+
+  bool _started;
+  vector<Worker*> _workers;
+  Batch _currentBatch;
+  size_t _currentIndex;
+
+  void _start()
+  {
+    _started = true;
+    _activeWorkers = _threadCount;
+    for (int i = 0; i < _threadCount; i++)
+    {
+      _workers.push_back(new Worker(*this));
+      _workers.back()->start();
+    }
+  }
+
+  /**
+   * Returns false if the consumer has gone away and the worker should stop reading.
+   */
+  bool _push(Batch& batch)
+  {
+    QMutexLocker lock(&_mutex);
+    while ((int)_queue.size() >= _maxQueued && !_aborted)
+    {
+      _notFull.wait(&_mutex);
+    }
+    if (_aborted)
+    {
+      batch.clear();
+      return false;
+    }
+    _queue.push_back(Batch());
+    _queue.back().swap(batch);
+    _notEmpty.wakeAll();
+    return true;
+  }
+
+  void _workerDone(QString error)
+  {
+    QMutexLocker lock(&_mutex);
+    if (error.isEmpty() == false && _error.isEmpty())
+    {
+      _error = error;
+    }
+    _activeWorkers--;
+    _notEmpty.wakeAll();
+  }
+};
+
+ParallelOgrInputStream::ParallelOgrInputStream(const vector<Layer>& layers, QString translation,
+  int threadCount)
+{
+  _d = new ParallelOgrInputStreamImpl(layers, translation, threadCount);
+}
+
+ParallelOgrInputStream::~ParallelOgrInputStream()
+{
+  delete _d;
+}
+
+void ParallelOgrInputStream::setLimit(long limit)
+{
+  _d->setLimit(limit);
+}
+
+boost::shared_ptr<OGRSpatialReference> ParallelOgrInputStream::getProjection() const
+{
+  // OgrReader reprojects everything it reads to WGS84.
+  return MapProjector::createWgs84Projection();
+}
+
+bool ParallelOgrInputStream::hasMoreElements()
+{
+  return _d->hasMoreElements();
+}
+
+ElementPtr ParallelOgrInputStream::readNextElement()
+{
+  return _d->readNextElement();
+}
+
+void ParallelOgrInputStream::close()
+{
+  _d->close();
+}
+
+}
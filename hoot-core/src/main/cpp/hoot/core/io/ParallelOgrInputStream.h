@@ -0,0 +1,102 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PARALLELOGRINPUTSTREAM_H
+#define PARALLELOGRINPUTSTREAM_H
+
+// hoot
+#include <hoot/core/io/ElementInputStream.h>
+
+// Qt
+#include <QString>
+#include <QStringList>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+class ParallelOgrInputStreamImpl;
+
+/**
+ * Reads a list of OGR layers on multiple worker threads, each through its own dataset handle,
+ * and merges the translated elements into a single stream through a bounded queue. The layer is
+ * the unit of work; within a layer features still arrive in source order, but elements from
+ * different layers interleave.
+ *
+ * The workers each construct their own translator, so the translation must report
+ * ScriptTranslator::isThreadSafe(). Callers are responsible for checking this before choosing
+ * this reader over a serial OgrReader.
+ */
+class ParallelOgrInputStream : public ElementInputStream
+{
+public:
+
+  /**
+   * A single layer to read: a path openable by OGR and a layer name within it.
+   */
+  struct Layer
+  {
+    QString path;
+    QString name;
+
+    Layer() {}
+    Layer(QString p, QString n) : path(p), name(n) {}
+  };
+
+  /**
+   * @param layers the layers to read; work is handed to threads a layer at a time.
+   * @param translation passed to each worker's OgrReader.
+   * @param threadCount number of worker threads; capped at the layer count.
+   */
+  ParallelOgrInputStream(const std::vector<Layer>& layers, QString translation, int threadCount);
+
+  virtual ~ParallelOgrInputStream();
+
+  /**
+   * See OgrReader::setLimit. Applied per layer.
+   */
+  void setLimit(long limit);
+
+  virtual boost::shared_ptr<OGRSpatialReference> getProjection() const;
+
+  virtual bool hasMoreElements();
+
+  virtual ElementPtr readNextElement();
+
+  virtual void close();
+
+private:
+
+  // pimpl keeps the queue and thread machinery out of the header, mirroring OgrReader's
+  // internal/external split.
+  ParallelOgrInputStreamImpl* _d;
+};
+
+}
+
+#endif // PARALLELOGRINPUTSTREAM_H
@@ -0,0 +1,101 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "PbfDeltaDecode.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace hoot
+{
+
+void PbfDeltaDecode::cumulativeSum(qint64* values, size_t count)
+{
+#ifdef __SSE2__
+  // process two deltas per iteration: shift-and-add turns [d0, d1] into [d0, d0 + d1], then the
+  // running carry from the previous pair is broadcast and added to both lanes.
+  __m128i carry = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)(values + i));
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, carry);
+    _mm_storeu_si128((__m128i*)(values + i), x);
+    // both lanes become the new high lane (the pair's inclusive sum)
+    carry = _mm_unpackhi_epi64(x, x);
+  }
+  if (i < count)
+  {
+    qint64 c;
+    _mm_storel_epi64((__m128i*)&c, carry);
+    values[i] += c;
+  }
+#else
+  qint64 sum = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    sum += values[i];
+    values[i] = sum;
+  }
+#endif
+}
+
+void PbfDeltaDecode::toDegrees(const qint64* values, size_t count, qint64 offset,
+                               qint64 granularity, double* out)
+{
+  // the integer combine stays exact either way; coordinates are bounded by +/-1.8e11 nanodegrees,
+  // so offset + granularity * v fits comfortably in a qint64 and converts to double exactly.
+#ifdef __SSE2__
+  // int64 -> double via the 2^52 + 2^51 magic number trick: adding the magic constant as an
+  // integer places the value in the mantissa, and subtracting it as a double recovers it. Valid
+  // for |v| < 2^51, which nanodegree coordinates satisfy by a wide margin.
+  const __m128i magicI = _mm_set1_epi64x(0x4338000000000000ll);
+  const __m128d magicD = _mm_set1_pd(6755399441055744.0); // 2^52 + 2^51
+  const __m128d scale = _mm_set1_pd(.000000001);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+  {
+    qint64 n0 = offset + granularity * values[i];
+    qint64 n1 = offset + granularity * values[i + 1];
+    __m128i n = _mm_set_epi64x(n1, n0);
+    __m128d d = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(n, magicI)), magicD);
+    _mm_storeu_pd(out + i, _mm_mul_pd(d, scale));
+  }
+  for (; i < count; i++)
+  {
+    out[i] = .000000001 * (double)(offset + granularity * values[i]);
+  }
+#else
+  for (size_t i = 0; i < count; i++)
+  {
+    out[i] = .000000001 * (double)(offset + granularity * values[i]);
+  }
+#endif
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PBFDELTADECODE_H
+#define PBFDELTADECODE_H
+
+// Qt
+#include <QtGlobal>
+
+// Standard
+#include <cstddef>
+
+namespace hoot
+{
+
+/**
+ * Flat decode kernels for the delta coded dense node arrays in PBF primitive blocks. Dense nodes
+ * are the bulk of the bytes in typical inputs and their decode loop is the hottest function in
+ * ingest profiles, so the per element work is done here over plain arrays where it can use SSE2
+ * on x86 (with a portable scalar fallback) instead of one protobuf accessor call at a time.
+ *
+ * Varint and zigzag decoding already happen inside protobuf's generated parsing code by the time
+ * the repeated fields are visible, so the work left to accelerate is the running delta sum and
+ * the nanodegree to degree conversion.
+ */
+class PbfDeltaDecode
+{
+public:
+
+  /**
+   * In place inclusive prefix sum: values[i] becomes the sum of values[0..i]. This undoes the
+   * delta coding of dense node ids, lats and lons.
+   */
+  static void cumulativeSum(qint64* values, size_t count);
+
+  /**
+   * Converts accumulated coordinate values to degrees using the primitive block's offset and
+   * granularity: out[i] = .000000001 * (offset + granularity * values[i]). Bit for bit identical
+   * to the scalar expression.
+   */
+  static void toDegrees(const qint64* values, size_t count, qint64 offset, qint64 granularity,
+                        double* out);
+};
+
+}
+
+#endif // PBFDELTADECODE_H
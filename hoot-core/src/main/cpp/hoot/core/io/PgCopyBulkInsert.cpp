@@ -0,0 +1,187 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "PgCopyBulkInsert.h"
+
+// hoot
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QSqlDriver>
+#include <QStringBuilder>
+#include <QVariant>
+
+// libpq
+#include <libpq-fe.h>
+
+// tgs
+#include <tgs/System/Time.h>
+
+namespace hoot
+{
+
+PgCopyBulkInsert::PgCopyBulkInsert(QSqlDatabase& db, const QString& tableName,
+                                   const QStringList& columns) :
+  _db(db),
+  _tableName(tableName),
+  _columns(columns),
+  _pendingCount(0),
+  _time(0)
+{
+}
+
+PgCopyBulkInsert::~PgCopyBulkInsert()
+{
+  LOG_DEBUG("(" << _tableName << ") Total time copying: " << _time);
+  if (_pendingCount > 0)
+  {
+    LOG_WARN("(" << _tableName << ") There are pending inserts in PgCopyBulkInsert. You should "
+             "call flush before destruction.");
+  }
+}
+
+QString PgCopyBulkInsert::_escapeCopyText(const QString& s) const
+{
+  QString result = s;
+  result.replace("\\", "\\\\");
+  result.replace("\t", "\\t");
+  result.replace("\n", "\\n");
+  result.replace("\r", "\\r");
+  return result;
+}
+
+QString PgCopyBulkInsert::_hstoreLiteral(const QVariantMap& map) const
+{
+  QStringList pairs;
+  for (QVariantMap::const_iterator it = map.constBegin(); it != map.constEnd(); ++it)
+  {
+    QString k = it.key();
+    QString v = it.value().toString();
+    k.replace("\\", "\\\\").replace("\"", "\\\"");
+    v.replace("\\", "\\\\").replace("\"", "\\\"");
+    pairs.append("\"" % k % "\"=>\"" % v % "\"");
+  }
+  return pairs.join(",");
+}
+
+QString PgCopyBulkInsert::_toCopyField(const QVariant& v) const
+{
+  switch (v.type())
+  {
+  case QVariant::Invalid:
+    return "\\N";
+  case QVariant::Int:
+  case QVariant::UInt:
+  case QVariant::Double:
+  case QVariant::LongLong:
+  case QVariant::ULongLong:
+    return v.toString();
+  case QVariant::Bool:
+    return v.toBool() ? QString("t") : QString("f");
+  case QVariant::String:
+    return _escapeCopyText(v.toString());
+  case QVariant::Map:
+    // the hstore literal is escaped twice: once for the hstore syntax, then for the COPY text
+    // format it travels in
+    return _escapeCopyText(_hstoreLiteral(v.toMap()));
+  default:
+    throw UnsupportedException();
+  }
+}
+
+void PgCopyBulkInsert::insert(const QList<QVariant> l)
+{
+  QString row;
+  for (int i = 0; i < l.size(); i++)
+  {
+    if (i > 0)
+    {
+      row.append('\t');
+    }
+    row.append(_toCopyField(l[i]));
+  }
+  row.append('\n');
+  _buffer.append(row.toUtf8());
+  _pendingCount++;
+}
+
+void PgCopyBulkInsert::flush()
+{
+  LOG_TRACE("Flushing COPY bulk insert...");
+  LOG_VART(_pendingCount);
+
+  if (_pendingCount == 0)
+  {
+    return;
+  }
+
+  double start = Tgs::Time::getTime();
+
+  QVariant handle = _db.driver()->handle();
+  if (qstrcmp(handle.typeName(), "PGconn*") != 0 || handle.data() == 0)
+  {
+    throw HootException("PgCopyBulkInsert requires a PostgreSQL (QPSQL) connection.");
+  }
+  PGconn* conn = *static_cast<PGconn**>(handle.data());
+
+  QString sql = "COPY " + _tableName + " (" + _columns.join(", ") + ") FROM STDIN";
+  PGresult* res = PQexec(conn, sql.toUtf8().constData());
+  if (PQresultStatus(res) != PGRES_COPY_IN)
+  {
+    QString error = QString::fromUtf8(PQerrorMessage(conn));
+    PQclear(res);
+    throw HootException(QString("Error starting COPY to %1: %2").arg(_tableName).arg(error));
+  }
+  PQclear(res);
+
+  if (PQputCopyData(conn, _buffer.constData(), _buffer.size()) != 1 ||
+      PQputCopyEnd(conn, NULL) != 1)
+  {
+    throw HootException(QString("Error sending COPY data to %1: %2").arg(_tableName).
+      arg(QString::fromUtf8(PQerrorMessage(conn))));
+  }
+
+  QString error;
+  while ((res = PQgetResult(conn)) != NULL)
+  {
+    if (PQresultStatus(res) != PGRES_COMMAND_OK && error.isEmpty())
+    {
+      error = QString::fromUtf8(PQresultErrorMessage(res));
+    }
+    PQclear(res);
+  }
+  if (!error.isEmpty())
+  {
+    throw HootException(QString("Error completing COPY to %1: %2").arg(_tableName).arg(error));
+  }
+
+  _buffer.clear();
+  _pendingCount = 0;
+  _time += Tgs::Time::getTime() - start;
+}
+
+}
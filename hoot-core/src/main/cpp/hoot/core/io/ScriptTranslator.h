@@ -80,6 +80,12 @@ public:
    */
   virtual const QString getLayerNameFilter() { return "."; }
 
+  /**
+   * Returns true if independent instances of this translator may run concurrently on different
+   * threads. The script engines share process wide interpreter state, so the default is false.
+   */
+  virtual bool isThreadSafe() { return false; }
+
   /**
    * lower order values make the script engine get evaluated earlier.
    */
@@ -31,6 +31,7 @@
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/core/util/DbUtils.h>
+#include "MappedWordCountIndex.h"
 #include "WordCount.h"
 
 // Qt
@@ -88,6 +89,12 @@ void WordCountWriter::write(QString basePath, QVector<WordCount> words)
   LOG_INFO("Committed");
 }
 
+void WordCountWriter::writeIndex(QString path, const QVector<WordCount>& words)
+{
+  LOG_INFO("Writing word count index...");
+  MappedWordCountIndex::build(path, words);
+}
+
 void WordCountWriter::_writeFile(QString path, long totalCount, QVector<WordCount> words,
   long maxSize)
 {
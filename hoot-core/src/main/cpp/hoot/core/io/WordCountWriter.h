@@ -72,6 +72,13 @@ public:
 
   void write(QString basePath, QVector<WordCount> words);
 
+  /**
+   * Writes a memory mapped word count index (see MappedWordCountIndex) for the given words.
+   * Unlike the sqlite output of write, the index is loaded with no startup cost and its pages
+   * are shared read-only between every process on the host that uses the same file.
+   */
+  void writeIndex(QString path, const QVector<WordCount>& words);
+
 private:
 
   long _maxFrequent;
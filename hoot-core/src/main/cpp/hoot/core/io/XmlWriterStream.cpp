@@ -0,0 +1,265 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "XmlWriterStream.h"
+
+// Qt
+#include <QIODevice>
+#include <QXmlStreamWriter>
+
+// Standard
+#include <stdio.h>
+
+namespace hoot
+{
+
+// flush to the device once this much output has accumulated.
+static const int BUFFER_FLUSH_SIZE = 1024 * 1024;
+
+QtXmlWriterStream::QtXmlWriterStream(QIODevice* device)
+{
+  _writer.reset(new QXmlStreamWriter(device));
+  _writer->setCodec("UTF-8");
+}
+
+void QtXmlWriterStream::setAutoFormatting(bool on)
+{
+  _writer->setAutoFormatting(on);
+}
+
+void QtXmlWriterStream::writeStartDocument()
+{
+  _writer->writeStartDocument();
+}
+
+void QtXmlWriterStream::writeEndDocument()
+{
+  _writer->writeEndDocument();
+}
+
+void QtXmlWriterStream::writeStartElement(const QString& name)
+{
+  _writer->writeStartElement(name);
+}
+
+void QtXmlWriterStream::writeEndElement()
+{
+  _writer->writeEndElement();
+}
+
+void QtXmlWriterStream::writeAttribute(const QString& name, const QString& value)
+{
+  _writer->writeAttribute(name, value);
+}
+
+void QtXmlWriterStream::writeDoubleAttribute(const QString& name, double value, int precision)
+{
+  _writer->writeAttribute(name, QString::number(value, 'f', precision));
+}
+
+FastXmlWriterStream::FastXmlWriterStream(QIODevice* device) :
+  _device(device),
+  _autoFormat(false),
+  _tagOpen(false),
+  _hasContent(false)
+{
+  _buffer.reserve(BUFFER_FLUSH_SIZE + 1024);
+}
+
+FastXmlWriterStream::~FastXmlWriterStream()
+{
+  _flush();
+}
+
+void FastXmlWriterStream::setAutoFormatting(bool on)
+{
+  _autoFormat = on;
+}
+
+void FastXmlWriterStream::writeStartDocument()
+{
+  _buffer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+  // makes the root element land on its own line when auto formatting, like QXmlStreamWriter.
+  _hasContent = true;
+}
+
+void FastXmlWriterStream::writeEndDocument()
+{
+  while (_openTags.size() > 0)
+  {
+    writeEndElement();
+  }
+  _buffer.append('\n');
+  _flush();
+}
+
+void FastXmlWriterStream::writeStartElement(const QString& name)
+{
+  _closeStartTag();
+  if (_autoFormat)
+  {
+    if (_hasContent)
+    {
+      _buffer.append('\n');
+    }
+    _indent(_openTags.size());
+  }
+  QByteArray utf8Name = name.toUtf8();
+  _buffer.append('<');
+  _buffer.append(utf8Name);
+  _openTags.push_back(utf8Name);
+  _tagOpen = true;
+  _hasContent = true;
+}
+
+void FastXmlWriterStream::writeEndElement()
+{
+  if (_openTags.size() == 0)
+  {
+    // tolerated for parity with QXmlStreamWriter; OsmXmlWriter::close() can run twice.
+    return;
+  }
+  QByteArray name = _openTags.back();
+  _openTags.pop_back();
+
+  if (_tagOpen)
+  {
+    _buffer.append("/>");
+    _tagOpen = false;
+  }
+  else
+  {
+    if (_autoFormat)
+    {
+      _buffer.append('\n');
+      _indent(_openTags.size());
+    }
+    _buffer.append("</");
+    _buffer.append(name);
+    _buffer.append('>');
+  }
+  _maybeFlush();
+}
+
+void FastXmlWriterStream::writeAttribute(const QString& name, const QString& value)
+{
+  _buffer.append(' ');
+  _buffer.append(name.toUtf8());
+  _buffer.append("=\"");
+  _appendEscaped(value);
+  _buffer.append('"');
+}
+
+void FastXmlWriterStream::writeDoubleAttribute(const QString& name, double value, int precision)
+{
+  _buffer.append(' ');
+  _buffer.append(name.toUtf8());
+  _buffer.append("=\"");
+  // fixed precision lat/lon formatting without a round trip through QString. The C library
+  // conversion is correctly rounded, matching QString::number(v, 'f', p).
+  char tmp[64];
+  snprintf(tmp, sizeof(tmp), "%.*f", precision, value);
+  _buffer.append(tmp);
+  _buffer.append('"');
+}
+
+void FastXmlWriterStream::_appendEscaped(const QString& s)
+{
+  // the escape set and numeric whitespace references match QXmlStreamWriter's attribute
+  // escaping. All the characters being escaped are single byte, so the scan can run over the
+  // UTF-8 bytes directly.
+  QByteArray utf8 = s.toUtf8();
+  const char* data = utf8.constData();
+  int size = utf8.size();
+  for (int i = 0; i < size; i++)
+  {
+    char c = data[i];
+    switch (c)
+    {
+    case '<':
+      _buffer.append("&lt;");
+      break;
+    case '>':
+      _buffer.append("&gt;");
+      break;
+    case '&':
+      _buffer.append("&amp;");
+      break;
+    case '"':
+      _buffer.append("&quot;");
+      break;
+    case '\n':
+      _buffer.append("&#10;");
+      break;
+    case '\r':
+      _buffer.append("&#13;");
+      break;
+    case '\t':
+      _buffer.append("&#9;");
+      break;
+    default:
+      _buffer.append(c);
+      break;
+    }
+  }
+}
+
+void FastXmlWriterStream::_closeStartTag()
+{
+  if (_tagOpen)
+  {
+    _buffer.append('>');
+    _tagOpen = false;
+  }
+}
+
+void FastXmlWriterStream::_flush()
+{
+  if (_buffer.size() > 0 && _device != 0 && _device->isOpen())
+  {
+    _device->write(_buffer);
+  }
+  _buffer.resize(0);
+}
+
+void FastXmlWriterStream::_indent(int depth)
+{
+  // QXmlStreamWriter's default auto formatting indent.
+  for (int i = 0; i < depth * 4; i++)
+  {
+    _buffer.append(' ');
+  }
+}
+
+void FastXmlWriterStream::_maybeFlush()
+{
+  if (_buffer.size() >= BUFFER_FLUSH_SIZE)
+  {
+    _flush();
+  }
+}
+
+}
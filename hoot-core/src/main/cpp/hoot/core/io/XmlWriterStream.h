@@ -0,0 +1,158 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef XMLWRITERSTREAM_H
+#define XMLWRITERSTREAM_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// Qt
+#include <QByteArray>
+#include <QString>
+class QIODevice;
+class QXmlStreamWriter;
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * The subset of the QXmlStreamWriter API that OsmXmlWriter uses, so the writer can switch
+ * between the Qt implementation and a buffered raw-output fast path without touching every
+ * call site. See osm.map.writer.fast.xml.
+ */
+class XmlWriterStream
+{
+public:
+
+  virtual ~XmlWriterStream() {}
+
+  virtual void setAutoFormatting(bool on) = 0;
+
+  virtual void writeStartDocument() = 0;
+
+  virtual void writeEndDocument() = 0;
+
+  virtual void writeStartElement(const QString& name) = 0;
+
+  virtual void writeEndElement() = 0;
+
+  virtual void writeAttribute(const QString& name, const QString& value) = 0;
+
+  /**
+   * Writes an attribute holding a double formatted with fixed precision (the 'f' format). This
+   * is split out so the fast path can format lat/lon without going through QString.
+   */
+  virtual void writeDoubleAttribute(const QString& name, double value, int precision) = 0;
+};
+
+/**
+ * The compatible default; delegates to QXmlStreamWriter.
+ */
+class QtXmlWriterStream : public XmlWriterStream
+{
+public:
+
+  QtXmlWriterStream(QIODevice* device);
+
+  virtual ~QtXmlWriterStream() {}
+
+  virtual void setAutoFormatting(bool on);
+
+  virtual void writeStartDocument();
+
+  virtual void writeEndDocument();
+
+  virtual void writeStartElement(const QString& name);
+
+  virtual void writeEndElement();
+
+  virtual void writeAttribute(const QString& name, const QString& value);
+
+  virtual void writeDoubleAttribute(const QString& name, double value, int precision);
+
+private:
+
+  boost::shared_ptr<QXmlStreamWriter> _writer;
+};
+
+/**
+ * Formats elements into a reusable byte buffer and writes it out in large blocks, skipping the
+ * QXmlStreamWriter and per-attribute QString machinery. Escaping and auto-formatting follow the
+ * QXmlStreamWriter conventions so the output matches the default implementation.
+ */
+class FastXmlWriterStream : public XmlWriterStream
+{
+public:
+
+  FastXmlWriterStream(QIODevice* device);
+
+  /**
+   * Flushes any buffered output.
+   */
+  virtual ~FastXmlWriterStream();
+
+  virtual void setAutoFormatting(bool on);
+
+  virtual void writeStartDocument();
+
+  virtual void writeEndDocument();
+
+  virtual void writeStartElement(const QString& name);
+
+  virtual void writeEndElement();
+
+  virtual void writeAttribute(const QString& name, const QString& value);
+
+  virtual void writeDoubleAttribute(const QString& name, double value, int precision);
+
+private:
+
+  QIODevice* _device;
+  QByteArray _buffer;
+  std::vector<QByteArray> _openTags;
+  bool _autoFormat;
+  // true when a start tag has been written but not yet closed with '>' or '/>'.
+  bool _tagOpen;
+  bool _hasContent;
+
+  void _appendEscaped(const QString& s);
+
+  void _closeStartTag();
+
+  void _flush();
+
+  void _indent(int depth);
+
+  void _maybeFlush();
+};
+
+}
+
+#endif // XMLWRITERSTREAM_H
@@ -63,6 +63,7 @@ bool reviewLess(const pair<ElementId, int64_t>& p1, const pair<ElementId, int64_
 
 AddHilbertReviewSortOrderOp::AddHilbertReviewSortOrderOp()
 {
+  _maxRange = 0;
 }
 
 void AddHilbertReviewSortOrderOp::apply(OsmMapPtr& map)
@@ -76,6 +77,7 @@ void AddHilbertReviewSortOrderOp::apply(OsmMapPtr& map)
   }
 
   _mapEnvelope.reset();
+  _curve.reset();
   MapProjector::projectToPlanar(map);
 
   const RelationMap& relations = map->getRelations();
@@ -121,47 +123,43 @@ void AddHilbertReviewSortOrderOp::apply(OsmMapPtr& map)
 int64_t AddHilbertReviewSortOrderOp::_calculateHilbertValue(const ConstOsmMapPtr &map,
   const set<ElementId> eids)
 {
-  auto_ptr<Envelope> env;
+  // the review envelope lives on the stack; allocating one per review adds up over millions of
+  // reviews.
+  Envelope env;
   for (set<ElementId>::const_iterator it = eids.begin(); it != eids.end(); ++it)
   {
     Envelope::AutoPtr te(map->getElement(*it)->getEnvelope(map));
-    if (env.get() == 0)
-    {
-      env.reset(new Envelope(*te));
-    }
-    else
-    {
-      env->expandToInclude(te.get());
-    }
+    env.expandToInclude(te.get());
   }
-  LOG_VART(env->toString());
+  LOG_VART(env.toString());
 
+  const Meters cellSize = 10.0;
   if (_mapEnvelope.get() == 0)
   {
     _mapEnvelope.reset(new Envelope(CalculateMapBoundsVisitor::getGeosBounds(map)));
+
+    int xorder = max(1.0, ceil(log(_mapEnvelope->getWidth() / cellSize) / log(2.0)));
+    int yorder = max(1.0, ceil(log(_mapEnvelope->getHeight() / cellSize) / log(2.0)));
+
+    // 31 bits is the most supported for 2 dimensions.
+    int order = min(31, max(xorder, yorder));
+    // always 2 dimensions. The order only depends on the map envelope, so build the curve once
+    // and encode every review's centroid against it.
+    _curve.reset(new Tgs::HilbertCurve(2, order));
+    _maxRange = 1 << order;
   }
 
   Coordinate center;
-  env->centre(center);
+  env.centre(center);
 
-  Meters cellSize = 10.0;
-  int xorder = max(1.0, ceil(log(_mapEnvelope->getWidth() / cellSize) / log(2.0)));
-  int yorder = max(1.0, ceil(log(_mapEnvelope->getHeight() / cellSize) / log(2.0)));
-
-  // 31 bits is the most supported for 2 dimensions.
-  int order = min(31, max(xorder, yorder));
-  // always 2 dimensions.
-  Tgs::HilbertCurve c(2, order);
-  int64_t maxRange = 1 << order;
   int point[2];
-
-  point[0] = max<int64_t>(0, min<int64_t>(maxRange - 1,
+  point[0] = max<int64_t>(0, min<int64_t>(_maxRange - 1,
     round((center.x - _mapEnvelope->getMinX()) / cellSize)));
-  point[1] = max<int64_t>(0, min<int64_t>(maxRange - 1,
+  point[1] = max<int64_t>(0, min<int64_t>(_maxRange - 1,
     round((center.y - _mapEnvelope->getMinY()) / cellSize)));
 
   // pad with zeros to make sorting a little easier.
-  return c.encode(point);
+  return _curve->encode(point);
 }
 
 }
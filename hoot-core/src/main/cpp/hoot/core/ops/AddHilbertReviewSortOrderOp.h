@@ -31,6 +31,11 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 
+namespace Tgs
+{
+  class HilbertCurve;
+}
+
 namespace hoot
 {
 
@@ -55,6 +60,10 @@ private:
   int64_t _calculateHilbertValue(const ConstOsmMapPtr &map, const std::set<ElementId> eids);
 
   geos::geom::Envelope::AutoPtr _mapEnvelope;
+  // built once per apply along with the map envelope; constructing the curve for every review
+  // allocates and rederives the order needlessly.
+  boost::shared_ptr<Tgs::HilbertCurve> _curve;
+  int64_t _maxRange;
 };
 
 }
@@ -28,6 +28,7 @@
 
 // geos
 #include <geos/geom/Polygon.h>
+#include <geos/geom/prep/PreparedGeometry.h>
 #include <geos/util/TopologyException.h>
 
 // Hoot
@@ -46,6 +47,10 @@
 #include <tgs/StreamUtils.h>
 #include <tgs/System/Time.h>
 
+// Qt
+#include <QVector>
+#include <QtConcurrentMap>
+
 using namespace geos::geom;
 using namespace std;
 using namespace Tgs;
@@ -101,18 +106,6 @@ void BuildingPartMergeOp::_addContainedWaysToGroup(const Geometry& g,
   }
 }
 
-void BuildingPartMergeOp::_addNeighborsToGroup(const WayPtr& w)
-{
-  set<long> neighborIds = _calculateNeighbors(w, w->getTags());
-  // go through each of the neighboring ways.
-  for (set<long>::const_iterator it = neighborIds.begin(); it != neighborIds.end(); ++it)
-  {
-    WayPtr neighbor = _map->getWay(*it);
-    // add these two buildings to a set.
-    _ds.joinT(neighbor, w);
-  }
-}
-
 void BuildingPartMergeOp::_addNeighborsToGroup(const RelationPtr& r)
 {
   boost::shared_ptr<Geometry> mp;
@@ -162,7 +155,10 @@ void BuildingPartMergeOp::apply(OsmMapPtr& map)
 
   size_t i;
   i = 0;
-  // go through all the ways
+  // classify the building part ways up front; the schema queries behind isBuilding aren't safe
+  // to run concurrently
+  _buildingPartWayIds.clear();
+  QVector<EdgeTask> tasks;
   const WayMap& ways = map->getWays();
   for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
   {
@@ -172,13 +168,14 @@ void BuildingPartMergeOp::apply(OsmMapPtr& map)
       cout << flush;
     }
     const WayPtr& w = it->second;
-    // add the way to a building group if appropriate
     // if the way is part of a building
     if (_isBuildingPart(w))
     {
-      _addNeighborsToGroup(w);
-      boost::shared_ptr<Geometry> g = ElementConverter(_map).convertToGeometry(w);
-      _addContainedWaysToGroup(*g, w);
+      _buildingPartWayIds.insert(w->getId());
+      EdgeTask task;
+      task.op = this;
+      task.way = w;
+      tasks.append(task);
     }
     i++;
   }
@@ -188,6 +185,36 @@ void BuildingPartMergeOp::apply(OsmMapPtr& map)
     cout << endl << flush;
   }
 
+  // build everything the workers read before fanning out
+  _map->getIndex().getNodeToWayMap();
+  _map->getIndex().prepareForConcurrentReads();
+
+  // the edge discovery (neighbor walks and geometry containment) only reads the map, so it
+  // fans out across the thread pool
+  QtConcurrent::blockingMap(tasks, &BuildingPartMergeOp::_findEdges);
+
+  // apply the discovered edges to the disjoint set serially
+  for (int taskIdx = 0; taskIdx < tasks.size(); taskIdx++)
+  {
+    const WayPtr& w = tasks[taskIdx].way;
+    const set<long>& neighborIds = tasks[taskIdx].neighborIds;
+    for (set<long>::const_iterator it = neighborIds.begin(); it != neighborIds.end(); ++it)
+    {
+      WayPtr neighbor = _map->getWay(*it);
+      // the schema backed tag comparison runs serially over the few surviving candidates
+      if (_compareTags(w->getTags(), neighbor->getTags()))
+      {
+        // add these two buildings to a set.
+        _ds.joinT(neighbor, w);
+      }
+    }
+    const vector<long>& containedWayIds = tasks[taskIdx].containedWayIds;
+    for (size_t j = 0; j < containedWayIds.size(); j++)
+    {
+      _ds.joinT(_map->getWay(containedWayIds[j]), w);
+    }
+  }
+
   i = 0;
   // go through all the relations
   const RelationMap& relations = map->getRelations();
@@ -278,6 +305,85 @@ set<long> BuildingPartMergeOp::_calculateNeighbors(const WayPtr& w, const Tags&
   return neighborIds;
 }
 
+void BuildingPartMergeOp::_findEdges(EdgeTask& task)
+{
+  task.op->_findTopologicalNeighbors(task.way, task.neighborIds);
+  //the index's geometry cache is thread safe and a part's polygon is often re-read as a
+  //containment candidate of another part
+  boost::shared_ptr<const Geometry> g = task.op->_map->getIndex().getGeometry(task.way);
+  task.op->_findContainedWayIds(g, task.containedWayIds);
+}
+
+void BuildingPartMergeOp::_findTopologicalNeighbors(const ConstWayPtr& w, set<long>& neighborIds)
+{
+  const NodeToWayMap& n2w = *_map->getIndex().getNodeToWayMap();
+  // look the ways up through the const way map; unlike OsmMap::getWay this can't trigger a
+  // copy-on-write detach while other workers are reading
+  const WayMap& wayMap = _map->getWays();
+  long lastId = w->getNodeId(0);
+  // go through each of its nodes and look for commonality with other ways.
+  for (size_t i = 1; i < w->getNodeCount(); i++)
+  {
+    // find all other ways that use this node (neighbors).
+    const set<long>& ways = n2w.getWaysByNode(w->getNodeId(i));
+
+    // go through each of the neighboring ways.
+    for (set<long>::const_iterator it = ways.begin(); it != ways.end(); ++it)
+    {
+      // restrict to the precomputed building part ids; the schema isn't consulted here. The
+      // tag comparison runs later, serially.
+      if (*it != w->getId() &&
+          _buildingPartWayIds.find(*it) != _buildingPartWayIds.end())
+      {
+        WayMap::const_iterator wayIt = wayMap.find(*it);
+        // if the neighbor also has the two contiguous nodes we're looking at
+        if (wayIt != wayMap.end() && _hasContiguousNodes(wayIt->second, w->getNodeId(i), lastId))
+        {
+          // add this to the list of neighbors
+          neighborIds.insert(*it);
+        }
+      }
+    }
+    lastId = w->getNodeId(i);
+  }
+}
+
+void BuildingPartMergeOp::_findContainedWayIds(const boost::shared_ptr<const Geometry>& g,
+  vector<long>& containedWayIds)
+{
+  vector<long> intersectIds = _map->getIndex().findWays(*g->getEnvelopeInternal());
+  // the same polygon is probed against every candidate, so prepare it once
+  boost::shared_ptr<const geos::geom::prep::PreparedGeometry> preparedG =
+    GeometryUtils::prepareGeometry(g);
+  const WayMap& wayMap = _map->getWays();
+  for (size_t i = 0; i < intersectIds.size(); i++)
+  {
+    // if this is another building part totally contained by this building
+    if (_buildingPartWayIds.find(intersectIds[i]) != _buildingPartWayIds.end())
+    {
+      const ConstWayPtr& candidate = wayMap.find(intersectIds[i])->second;
+      bool contains = false;
+      try
+      {
+        boost::shared_ptr<const Geometry> cg = _map->getIndex().getGeometry(candidate);
+        contains = preparedG->contains(cg.get());
+      }
+      catch (const geos::util::TopologyException&)
+      {
+        boost::shared_ptr<const Geometry> cg = _map->getIndex().getGeometry(candidate);
+        auto_ptr<Geometry> cleanCandidate(GeometryUtils::validateGeometry(cg.get()));
+        auto_ptr<Geometry> cleanG(GeometryUtils::validateGeometry(g.get()));
+        contains = cleanG->contains(cleanCandidate.get());
+      }
+
+      if (contains)
+      {
+        containedWayIds.push_back(intersectIds[i]);
+      }
+    }
+  }
+}
+
 RelationPtr BuildingPartMergeOp::combineParts(const OsmMapPtr& map,
   const vector< boost::shared_ptr<Element> >& parts)
 {
@@ -382,7 +488,7 @@ bool BuildingPartMergeOp::_compareTags(Tags t1, Tags t2)
   return fabs(1.0 - score) < 0.001;
 }
 
-bool BuildingPartMergeOp::_hasContiguousNodes(const WayPtr& w, long n1, long n2)
+bool BuildingPartMergeOp::_hasContiguousNodes(const ConstWayPtr& w, long n1, long n2)
 {
   const std::vector<long>& nodes = w->getNodeIds();
 
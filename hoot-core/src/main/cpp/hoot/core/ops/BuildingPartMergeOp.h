@@ -105,12 +105,48 @@ private:
   OsmMapPtr _map;
   std::set<QString> _buildingPartTagNames;
 
+  /// ids of the ways classified as building parts; lets the parallel edge discovery skip the
+  /// schema queries
+  HashSet<long> _buildingPartWayIds;
+
+  /**
+   * One edge discovery task per building part way. The discovery only reads the map, so the
+   * tasks fan out across the thread pool; the results are applied to the disjoint set serially
+   * (see apply).
+   */
+  struct EdgeTask
+  {
+    BuildingPartMergeOp* op;
+    WayPtr way;
+    /// neighbors sharing two contiguous nodes with the way; these still need the schema backed
+    /// tag comparison, which isn't safe to run concurrently
+    std::set<long> neighborIds;
+    /// building parts contained by the way's polygon; these are joined without a tag check
+    std::vector<long> containedWayIds;
+  };
+
+  static void _findEdges(EdgeTask& task);
+
   void _addContainedWaysToGroup(const geos::geom::Geometry& g, const boost::shared_ptr<Element>& neighbor);
-  void _addNeighborsToGroup(const WayPtr& w);
   void _addNeighborsToGroup(const RelationPtr& r);
 
   std::set<long> _calculateNeighbors(const WayPtr& w, const Tags& tags);
 
+  /**
+   * The thread safe portion of _calculateNeighbors: finds the building part ways sharing two
+   * contiguous nodes with w without consulting the schema or the map's shared scratch
+   * iterators.
+   */
+  void _findTopologicalNeighbors(const ConstWayPtr& w, std::set<long>& neighborIds);
+
+  /**
+   * The thread safe portion of _addContainedWaysToGroup: finds the building part ways totally
+   * contained by the polygon g. The polygon is prepared (see GeometryUtils::prepareGeometry)
+   * before the candidates are probed.
+   */
+  void _findContainedWayIds(const boost::shared_ptr<const geos::geom::Geometry>& g,
+    std::vector<long>& containedWayIds);
+
   void _combineParts(const std::vector< boost::shared_ptr<Element> >& parts) { combineParts(_map, parts); }
 
   /**
@@ -122,7 +158,7 @@ private:
   /**
    * Returns true if the nodes n1 and n2 appear in w in consecutive order.
    */
-  bool _hasContiguousNodes(const WayPtr& w, long n1, long n2);
+  bool _hasContiguousNodes(const ConstWayPtr& w, long n1, long n2);
 
   /**
    * Returns true if this way is a building, or part of a building through a relation.
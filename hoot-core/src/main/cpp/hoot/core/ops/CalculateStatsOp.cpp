@@ -30,6 +30,7 @@
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/filters/BuildingCriterion.h>
 #include <hoot/core/filters/ChainCriterion.h>
+#include <hoot/core/filters/CompiledCriterion.h>
 #include <hoot/core/filters/ElementTypeCriterion.h>
 #include <hoot/core/filters/HighwayFilter.h>
 #include <hoot/core/filters/LinearFilter.h>
@@ -51,6 +52,7 @@
 #include <hoot/core/visitors/LengthOfWaysVisitor.h>
 #include <hoot/core/visitors/LongestTagVisitor.h>
 #include <hoot/core/visitors/MaxIdVisitor.h>
+#include <hoot/core/visitors/MemoryUsageVisitor.h>
 #include <hoot/core/visitors/MinIdVisitor.h>
 #include <hoot/core/visitors/TranslatedTagCountVisitor.h>
 #include <hoot/core/visitors/UniqueNamesVisitor.h>
@@ -59,13 +61,19 @@
 #include <hoot/core/visitors/TagCountVisitor.h>
 #include <hoot/core/conflate/MatchFactory.h>
 #include <hoot/core/visitors/MatchCandidateCountVisitor.h>
+#include <hoot/core/visitors/MultipleVisitor.h>
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/DataProducer.h>
 #include <hoot/core/io/ScriptTranslator.h>
 #include <hoot/core/visitors/SumNumericTagsVisitor.h>
 #include <hoot/core/conflate/poi-polygon/filters/PoiPolygonPoiCriterion.h>
 #include <hoot/core/conflate/poi-polygon/filters/PoiPolygonPolyCriterion.h>
+#include <hoot/core/ops/stats/StatsDeltaListener.h>
 
+// Tgs
+#include <tgs/Statistics/Random.h>
+
+#include <algorithm>
 #include <math.h>
 
 using namespace boost;
@@ -77,6 +85,7 @@ namespace hoot
 CalculateStatsOp::CalculateStatsOp(QString mapName, bool inputIsConflatedMapOutput) :
   _mapName(mapName),
   _quick(false),
+  _sampleSize(0),
   _inputIsConflatedMapOutput(inputIsConflatedMapOutput)
 {
 }
@@ -86,6 +95,7 @@ CalculateStatsOp::CalculateStatsOp(ElementCriterionPtr criterion, QString mapNam
   _criterion(criterion),
   _mapName(mapName),
   _quick(false),
+  _sampleSize(0),
   _inputIsConflatedMapOutput(inputIsConflatedMapOutput)
 {
   LOG_VART(_inputIsConflatedMapOutput);
@@ -127,76 +137,158 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
   LOG_INFO(logMsg);
   Filter::FilterType keep = Filter::KeepMatches;
 
+  if (_sampleSize > 0)
+  {
+    _applySampled(map);
+    return;
+  }
+
   MapProjector::projectToPlanar(map);
 
   boost::shared_ptr<const OsmMap> constMap = map;
 
-  _stats.append(SingleStat("Node Count",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Node),
-      new ElementCountVisitor()))));
-  _stats.append(SingleStat("Way Count",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Way),
-      new ElementCountVisitor()))));
-  _stats.append(SingleStat("Relation Count",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Relation),
-      new ElementCountVisitor()))));
-  _stats.append(SingleStat("Minimum Node ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Node),
-      new MinIdVisitor()))));
-  _stats.append(SingleStat("Maximum Node ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Node),
-      new MaxIdVisitor()))));
-  _stats.append(SingleStat("Minimum Way ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Way),
-      new MinIdVisitor()))));
-  _stats.append(SingleStat("Maximum Way ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Way),
-      new MaxIdVisitor()))));
-  _stats.append(SingleStat("Minimum Relation ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Relation),
-      new MinIdVisitor()))));
-  _stats.append(SingleStat("Maximum Relation ID",
-    _applyVisitor(constMap, FilteredVisitor(ElementTypeCriterion(ElementType::Relation),
-      new MaxIdVisitor()))));
+  //all of these accumulators are independent, so they're fed from a single map traversal
+  //instead of one traversal per stat.
+  ElementTypeCriterion nodeCrit(ElementType::Node);
+  ElementTypeCriterion wayCrit(ElementType::Way);
+  ElementTypeCriterion relationCrit(ElementType::Relation);
+  ElementCountVisitor nodeCount;
+  ElementCountVisitor wayCount;
+  ElementCountVisitor relationCount;
+  MinIdVisitor minNodeId;
+  MaxIdVisitor maxNodeId;
+  MinIdVisitor minWayId;
+  MaxIdVisitor maxWayId;
+  MinIdVisitor minRelationId;
+  MaxIdVisitor maxRelationId;
+  FilteredVisitor nodeCountF(nodeCrit, nodeCount);
+  FilteredVisitor wayCountF(wayCrit, wayCount);
+  FilteredVisitor relationCountF(relationCrit, relationCount);
+  FilteredVisitor minNodeIdF(nodeCrit, minNodeId);
+  FilteredVisitor maxNodeIdF(nodeCrit, maxNodeId);
+  FilteredVisitor minWayIdF(wayCrit, minWayId);
+  FilteredVisitor maxWayIdF(wayCrit, maxWayId);
+  FilteredVisitor minRelationIdF(relationCrit, minRelationId);
+  FilteredVisitor maxRelationIdF(relationCrit, maxRelationId);
+  // memory accounting; estimates, but good enough for sizing conflation jobs.
+  MemoryUsageVisitor memoryUsageVisitor;
+
+  MultipleVisitor countsPass;
+  countsPass.addVisitor(nodeCountF);
+  countsPass.addVisitor(wayCountF);
+  countsPass.addVisitor(relationCountF);
+  countsPass.addVisitor(minNodeIdF);
+  countsPass.addVisitor(maxNodeIdF);
+  countsPass.addVisitor(minWayIdF);
+  countsPass.addVisitor(maxWayIdF);
+  countsPass.addVisitor(minRelationIdF);
+  countsPass.addVisitor(maxRelationIdF);
+  countsPass.addVisitor(memoryUsageVisitor);
+  _applyVisitor(constMap, &countsPass);
+
+  _stats.append(SingleStat("Node Count", nodeCount.getStat()));
+  _stats.append(SingleStat("Way Count", wayCount.getStat()));
+  _stats.append(SingleStat("Relation Count", relationCount.getStat()));
+  _stats.append(SingleStat("Minimum Node ID", minNodeId.getStat()));
+  _stats.append(SingleStat("Maximum Node ID", maxNodeId.getStat()));
+  _stats.append(SingleStat("Minimum Way ID", minWayId.getStat()));
+  _stats.append(SingleStat("Maximum Way ID", maxWayId.getStat()));
+  _stats.append(SingleStat("Minimum Relation ID", minRelationId.getStat()));
+  _stats.append(SingleStat("Maximum Relation ID", maxRelationId.getStat()));
+
+  const double indexBytes = (double)map->getIndex().getMemoryUsageEstimate();
+  _stats.append(SingleStat("Node Memory (Bytes)", memoryUsageVisitor.getNodeBytes()));
+  _stats.append(SingleStat("Way Memory (Bytes)", memoryUsageVisitor.getWayBytes()));
+  _stats.append(SingleStat("Relation Memory (Bytes)", memoryUsageVisitor.getRelationBytes()));
+  _stats.append(SingleStat("Tag Memory (Bytes)", memoryUsageVisitor.getTagBytes()));
+  _stats.append(SingleStat("Index Memory (Bytes)", indexBytes));
+  _stats.append(SingleStat("Total Map Memory (Bytes)", memoryUsageVisitor.getStat() + indexBytes));
 
   if (!_quick)
   {
+    //as above, all of these accumulators are independent, so one traversal feeds them all.
     TagCountVisitor tagCountVisitor;
-    _applyVisitor(constMap, &tagCountVisitor);
+    UniqueNamesVisitor uniqueNames;
+    LinearFilter linearFilter(keep);
+    StatsAreaFilter statsAreaFilter(keep);
+    HighwayFilter highwayFilter(keep);
+    BuildingCriterion buildingCrit(map);
+    LengthOfWaysVisitor linearLength;
+    CalculateAreaForStatsVisitor areaForStats;
+    LengthOfWaysVisitor highwayLength;
+    UniqueNamesVisitor highwayUniqueNames;
+    CalculateAreaVisitor buildingArea;
+    UniqueNamesVisitor buildingUniqueNames;
+    FilteredVisitor linearLengthF(linearFilter, linearLength);
+    FilteredVisitor areaForStatsF(statsAreaFilter, areaForStats);
+    FilteredVisitor highwayLengthF(highwayFilter, highwayLength);
+    FilteredVisitor highwayUniqueNamesF(highwayFilter, highwayUniqueNames);
+    FilteredVisitor buildingAreaF(buildingCrit, buildingArea);
+    FilteredVisitor buildingUniqueNamesF(buildingCrit, buildingUniqueNames);
+    FeatureCountVisitor featureCountVisitor;
+    StatusCriterion conflatedCrit(Status::Conflated);
+    FeatureCountVisitor conflatedFeatureCounter;
+    FilteredVisitor conflatedFeatureCountF(conflatedCrit, conflatedFeatureCounter);
+    vector< boost::shared_ptr<MatchCreator> > matchCreators =
+      MatchFactory::getInstance().getCreators();
+    LOG_VARD(matchCreators.size());
+    FilteredVisitor matchCandidateCountF(
+      new CompiledCriterion(
+        ElementCriterionPtr(
+          new ChainCriterion(
+            new NotCriterion(new StatusCriterion(Status::Conflated)),
+            new NotCriterion(new NeedsReviewCriterion(constMap))))),
+      new MatchCandidateCountVisitor(matchCreators));
+    MatchCandidateCountVisitor& matchCandidateCounter =
+      dynamic_cast<MatchCandidateCountVisitor&>(matchCandidateCountF.getChildVisitor());
+    NoInformationCriterion noInfoCrit;
+    FeatureCountVisitor untaggedFeatureCounter;
+    FilteredVisitor untaggedFeatureCountF(noInfoCrit, untaggedFeatureCounter);
+    NeedsReviewCriterion needsReviewCrit(constMap);
+    FeatureCountVisitor needsReviewFeatureCounter;
+    FilteredVisitor needsReviewFeatureCountF(needsReviewCrit, needsReviewFeatureCounter);
+    FilteredVisitor unconflatedFeatureCountF(
+      new NotCriterion(new StatusCriterion(Status::Conflated)), new FeatureCountVisitor());
+    FeatureCountVisitor& unconflatedFeatureCounter =
+      dynamic_cast<FeatureCountVisitor&>(unconflatedFeatureCountF.getChildVisitor());
+    LongestTagVisitor v2;
+
+    MultipleVisitor featurePass;
+    featurePass.addVisitor(tagCountVisitor);
+    featurePass.addVisitor(uniqueNames);
+    featurePass.addVisitor(linearLengthF);
+    featurePass.addVisitor(areaForStatsF);
+    featurePass.addVisitor(highwayLengthF);
+    featurePass.addVisitor(highwayUniqueNamesF);
+    featurePass.addVisitor(buildingAreaF);
+    featurePass.addVisitor(buildingUniqueNamesF);
+    featurePass.addVisitor(featureCountVisitor);
+    featurePass.addVisitor(conflatedFeatureCountF);
+    featurePass.addVisitor(matchCandidateCountF);
+    featurePass.addVisitor(untaggedFeatureCountF);
+    featurePass.addVisitor(needsReviewFeatureCountF);
+    featurePass.addVisitor(unconflatedFeatureCountF);
+    featurePass.addVisitor(v2);
+    _applyVisitor(constMap, &featurePass);
+
     const long numTotalTags = (long)tagCountVisitor.getStat();
     _stats.append(SingleStat("Total Feature Tags", numTotalTags));
     const long numInformationTags = tagCountVisitor.getInformationCount();
     _stats.append(SingleStat("Total Feature Information Tags", numInformationTags));
     _stats.append(SingleStat("Total Feature Metadata Tags", numTotalTags - numInformationTags));
 
-    UniqueNamesVisitor v;
-    _applyVisitor(constMap, &v);
-    _stats.append(SingleStat("Unique Names", v.getStat()));
-    _stats.append(SingleStat("Meters of Linear Features",
-      _applyVisitor(constMap, FilteredVisitor(LinearFilter(keep), new LengthOfWaysVisitor()))));
-    _stats.append(SingleStat("Meters Squared of Area Features",
-      _applyVisitor(constMap, FilteredVisitor(StatsAreaFilter(keep), new CalculateAreaForStatsVisitor()))));
-    _stats.append(SingleStat("Meters of Highway",
-      _applyVisitor(constMap, FilteredVisitor(HighwayFilter(keep), new LengthOfWaysVisitor()))));
-    _stats.append(SingleStat("Highway Unique Name Count",
-      _applyVisitor(constMap, FilteredVisitor(HighwayFilter(keep), new UniqueNamesVisitor()))));
-    _stats.append(SingleStat("Meters Squared of Buildings",
-      _applyVisitor(constMap, FilteredVisitor(BuildingCriterion(map), new CalculateAreaVisitor()))));
-    _stats.append(SingleStat("Building Unique Name Count",
-      _applyVisitor(constMap, FilteredVisitor(BuildingCriterion(map), new UniqueNamesVisitor()))));
+    _stats.append(SingleStat("Unique Names", uniqueNames.getStat()));
+    _stats.append(SingleStat("Meters of Linear Features", linearLength.getStat()));
+    _stats.append(SingleStat("Meters Squared of Area Features", areaForStats.getStat()));
+    _stats.append(SingleStat("Meters of Highway", highwayLength.getStat()));
+    _stats.append(SingleStat("Highway Unique Name Count", highwayUniqueNames.getStat()));
+    _stats.append(SingleStat("Meters Squared of Buildings", buildingArea.getStat()));
+    _stats.append(SingleStat("Building Unique Name Count", buildingUniqueNames.getStat()));
 
-    FeatureCountVisitor featureCountVisitor;
-    _applyVisitor(constMap, &featureCountVisitor);
     const long featureCount = featureCountVisitor.getCount();
     LOG_VART(featureCount);
     _stats.append(SingleStat("Total Feature Count", featureCount));
-    vector< boost::shared_ptr<MatchCreator> > matchCreators =
-      MatchFactory::getInstance().getCreators();
-    LOG_VARD(matchCreators.size());
-    double conflatedFeatureCount =
-      _applyVisitor(
-        constMap,
-        FilteredVisitor(StatusCriterion(Status::Conflated), new FeatureCountVisitor()));
+    double conflatedFeatureCount = conflatedFeatureCounter.getStat();
 
     //We're tailoring the stats to whether the map being examined is the input to a conflation job
     //or the output from a conflation job.  When the stats option is called from the conflate
@@ -211,19 +303,17 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
     {
       _inputIsConflatedMapOutput = true;
     }
-    any matchCandidateCountsData;
-    double conflatableFeatureCount =
-      _applyVisitor(
-        constMap,
-        FilteredVisitor(
-          ChainCriterion(
-            new NotCriterion(new StatusCriterion(Status::Conflated)),
-            new NotCriterion(new NeedsReviewCriterion(constMap))),
-          new MatchCandidateCountVisitor(matchCreators)),
-        matchCandidateCountsData);
+    any matchCandidateCountsData = matchCandidateCounter.getData();
+    double conflatableFeatureCount = matchCandidateCounter.getStat();
     LOG_VARD(matchCreators.size());
+    //these two don't honor the op level criterion, so they share their own traversal instead of
+    //joining the filtered pass above.
     SumNumericTagsVisitor tagSumVis(MetadataTags::HootPoiPolygonPoisMerged());
-    constMap->visitRo(tagSumVis);
+    CountUniqueReviewsVisitor curv;
+    MultipleVisitor unfilteredPass;
+    unfilteredPass.addVisitor(tagSumVis);
+    unfilteredPass.addVisitor(curv);
+    constMap->visitRo(unfilteredPass);
     long poisMergedIntoPolys = tagSumVis.getStat();
     //we need to add any pois that may have been merged into polygons by poi/poly into the total
     //conflated feature count
@@ -240,17 +330,10 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
       SingleStat(
         "Percentage of Total Features Conflatable",
         ((double)conflatableFeatureCount / (double)featureCount) * 100.0));
-    const double numFeaturesMarkedForReview =
-      _applyVisitor(
-        constMap,
-        FilteredVisitor(new NeedsReviewCriterion(constMap), new FeatureCountVisitor()));
+    const double numFeaturesMarkedForReview = needsReviewFeatureCounter.getStat();
 
-    CountUniqueReviewsVisitor curv;
-    constMap->visitRo(curv);
     const double numReviewsToBeMade = curv.getStat();
-    const double untaggedFeatureCount =
-      _applyVisitor(
-        constMap, FilteredVisitor(new NoInformationCriterion(),new FeatureCountVisitor()));
+    const double untaggedFeatureCount = untaggedFeatureCounter.getStat();
     _stats.append(SingleStat("Untagged Feature Count", untaggedFeatureCount));
     long unconflatableFeatureCount = -1.0;
     if (!_inputIsConflatedMapOutput)
@@ -352,12 +435,7 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
         ((double)numFeaturesMarkedForReview / (double)featureCount) * 100.0));
     _stats.append(
       SingleStat("Total Number of Reviews to be Made", numReviewsToBeMade));
-    const double unconflatedFeatureCount =
-      _applyVisitor(
-        constMap,
-        FilteredVisitor(
-            new NotCriterion(new StatusCriterion(Status::Conflated)),
-          new FeatureCountVisitor()));
+    const double unconflatedFeatureCount = unconflatedFeatureCounter.getStat();
     _stats.append(SingleStat("Total Unmatched Features", unconflatedFeatureCount));
     _stats.append(
       SingleStat(
@@ -372,8 +450,6 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
                             MatchCreator::getElementCriterion(it.key(), map), poisMergedIntoPolys);
     }
 
-    LongestTagVisitor v2;
-    _applyVisitor(constMap, &v2);
     _stats.append(SingleStat("Longest Tag", v2.getStat()));
 
     //TODO: this should be moved into _generateFeatureStats
@@ -425,6 +501,130 @@ void CalculateStatsOp::apply(const OsmMapPtr& map)
   LOG_DEBUG(logMsg);
 }
 
+namespace
+{
+
+bool findBaselineStat(const QList<SingleStat>& stats, const QString& name, long& value)
+{
+  for (int i = 0; i < stats.size(); i++)
+  {
+    if (stats[i].name == name)
+    {
+      value = (long)stats[i].value;
+      return true;
+    }
+  }
+  return false;
+}
+
+double baselineStatOrZero(const QList<SingleStat>& stats, const QString& name)
+{
+  long value = 0;
+  findBaselineStat(stats, name, value);
+  return (double)value;
+}
+
+}
+
+void CalculateStatsOp::applyIncremental(const OsmMapPtr& map,
+                                        const QList<SingleStat>& baselineStats,
+                                        const StatsDeltaListener& delta)
+{
+  // only the quick subset decomposes: the detailed stats depend on the tags, geometry and match
+  // status of the elements that survived, which the delta doesn't (and can't cheaply) track. A
+  // criterion-filtered op doesn't decompose either since the delta counts aren't broken down by
+  // criterion.
+  bool decomposable = !_criterion && _quick;
+
+  static const char* typeNames[] = { "Node", "Way", "Relation" };
+  long newCount[3];
+  long newMin[3];
+  long newMax[3];
+
+  for (int i = 0; decomposable && i < 3; i++)
+  {
+    const ElementType::Type type = (ElementType::Type)i;
+    const QString typeName = typeNames[i];
+
+    long baseCount, baseMin, baseMax;
+    if (!findBaselineStat(baselineStats, typeName + " Count", baseCount) ||
+        !findBaselineStat(baselineStats, "Minimum " + typeName + " ID", baseMin) ||
+        !findBaselineStat(baselineStats, "Maximum " + typeName + " ID", baseMax))
+    {
+      decomposable = false;
+      break;
+    }
+
+    newCount[i] = baseCount + delta.getAddedCount(type) - delta.getRemovedCount(type);
+    // removing the current extreme means the next extreme is unknown without a traversal, and an
+    // empty element type has no canonical extreme. Recompute in both cases.
+    if (newCount[i] <= 0 ||
+        (baseCount > 0 &&
+         (delta.wasRemoved(type, baseMin) || delta.wasRemoved(type, baseMax))))
+    {
+      decomposable = false;
+      break;
+    }
+
+    if (baseCount == 0)
+    {
+      newMin[i] = delta.getMinAddedId(type);
+      newMax[i] = delta.getMaxAddedId(type);
+    }
+    else if (delta.getAddedCount(type) > 0)
+    {
+      newMin[i] = std::min(baseMin, delta.getMinAddedId(type));
+      newMax[i] = std::max(baseMax, delta.getMaxAddedId(type));
+    }
+    else
+    {
+      newMin[i] = baseMin;
+      newMax[i] = baseMax;
+    }
+  }
+
+  if (!decomposable)
+  {
+    LOG_DEBUG("Stats delta isn't decomposable; falling back to a full stats calculation.");
+    apply(map);
+    return;
+  }
+
+  QString logMsg = "Adjusting map statistics incrementally";
+  if (!_mapName.isEmpty())
+  {
+    logMsg += " for " + _mapName;
+  }
+  logMsg += "...";
+  LOG_INFO(logMsg);
+
+  // same stat names and order as the counts pass in apply().
+  for (int i = 0; i < 3; i++)
+  {
+    _stats.append(SingleStat(QString("%1 Count").arg(typeNames[i]), newCount[i]));
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    _stats.append(SingleStat(QString("Minimum %1 ID").arg(typeNames[i]), newMin[i]));
+    _stats.append(SingleStat(QString("Maximum %1 ID").arg(typeNames[i]), newMax[i]));
+  }
+
+  // the per-element estimates are carried over unadjusted; only the index estimate is cheap to
+  // refresh.
+  const double nodeBytes = baselineStatOrZero(baselineStats, "Node Memory (Bytes)");
+  const double wayBytes = baselineStatOrZero(baselineStats, "Way Memory (Bytes)");
+  const double relationBytes = baselineStatOrZero(baselineStats, "Relation Memory (Bytes)");
+  const double tagBytes = baselineStatOrZero(baselineStats, "Tag Memory (Bytes)");
+  const double indexBytes = (double)map->getIndex().getMemoryUsageEstimate();
+  _stats.append(SingleStat("Node Memory (Bytes)", nodeBytes));
+  _stats.append(SingleStat("Way Memory (Bytes)", wayBytes));
+  _stats.append(SingleStat("Relation Memory (Bytes)", relationBytes));
+  _stats.append(SingleStat("Tag Memory (Bytes)", tagBytes));
+  _stats.append(SingleStat("Index Memory (Bytes)", indexBytes));
+  _stats.append(SingleStat("Total Map Memory (Bytes)",
+    nodeBytes + wayBytes + relationBytes + tagBytes + indexBytes));
+}
+
 bool CalculateStatsOp::_matchDescriptorCompare(const MatchCreator::Description& m1,
                                                const MatchCreator::Description& m2)
 {
@@ -474,6 +674,167 @@ void CalculateStatsOp::_applyVisitor(boost::shared_ptr<const OsmMap>& map, Const
   map->visitRo(*v);
 }
 
+namespace
+{
+  /**
+   * Classic reservoir sampling: after the stream ends every element has ended up in the sample
+   * with probability sampleSize / population, without knowing the population up front.
+   */
+  void offerToReservoir(vector<ConstElementPtr>& sample, long sampleSize,
+                        const ConstElementPtr& e, long seen)
+  {
+    if ((long)sample.size() < sampleSize)
+    {
+      sample.push_back(e);
+    }
+    else
+    {
+      const long j = (long)(Tgs::Random::instance()->generateUniform() * (double)(seen + 1));
+      if (j < sampleSize)
+      {
+        sample[j] = e;
+      }
+    }
+  }
+}
+
+void CalculateStatsOp::_applySampled(const OsmMapPtr& map)
+{
+  MapProjector::projectToPlanar(map);
+  boost::shared_ptr<const OsmMap> constMap = map;
+  Filter::FilterType keep = Filter::KeepMatches;
+
+  // the per type element counts come straight off the containers, so they stay exact.
+  const long nodeCount = (long)map->getNodes().size();
+  const long wayCount = (long)map->getWays().size();
+  const long relationCount = (long)map->getRelations().size();
+  const long population = nodeCount + wayCount + relationCount;
+  _stats.append(SingleStat("Node Count", nodeCount));
+  _stats.append(SingleStat("Way Count", wayCount));
+  _stats.append(SingleStat("Relation Count", relationCount));
+  _stats.append(SingleStat("Stats Sample Size", std::min(population, _sampleSize)));
+
+  if (population == 0)
+  {
+    return;
+  }
+
+  vector<ConstElementPtr> sample;
+  sample.reserve((size_t)std::min(population, _sampleSize));
+  long seen = 0;
+  const NodeMap& allNodes = map->getNodes();
+  for (NodeMap::const_iterator it = allNodes.begin(); it != allNodes.end(); ++it)
+  {
+    offerToReservoir(sample, _sampleSize, it->second, seen++);
+  }
+  const WayMap& allWays = map->getWays();
+  for (WayMap::const_iterator it = allWays.begin(); it != allWays.end(); ++it)
+  {
+    offerToReservoir(sample, _sampleSize, it->second, seen++);
+  }
+  const RelationMap& allRelations = map->getRelations();
+  for (RelationMap::const_iterator it = allRelations.begin(); it != allRelations.end(); ++it)
+  {
+    offerToReservoir(sample, _sampleSize, it->second, seen++);
+  }
+  LOG_INFO(
+    "Computing sampled stats from " << sample.size() << " of " << population << " elements.");
+
+  // the expensive stats: length/area sums and feature counts by criterion. These are all sums of
+  // independent per element contributions, which is exactly what extrapolates cleanly from a
+  // uniform sample.
+  _appendSampledStat(constMap, sample, population, "Total Feature Count", FeatureCountVisitor());
+  _appendSampledStat(
+    constMap, sample, population, "Meters of Linear Features",
+    FilteredVisitor(new LinearFilter(keep), new LengthOfWaysVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Meters Squared of Area Features",
+    FilteredVisitor(new StatsAreaFilter(keep), new CalculateAreaForStatsVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Meters of Highway",
+    FilteredVisitor(new HighwayFilter(keep), new LengthOfWaysVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Highway Count",
+    FilteredVisitor(new HighwayFilter(keep), new FeatureCountVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Meters Squared of Buildings",
+    FilteredVisitor(new BuildingCriterion(map), new CalculateAreaVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Building Count",
+    FilteredVisitor(new BuildingCriterion(map), new FeatureCountVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "POI Count",
+    FilteredVisitor(new PoiCriterion(), new FeatureCountVisitor()));
+  _appendSampledStat(
+    constMap, sample, population, "Waterway Count",
+    FilteredVisitor(new WaterwayCriterion(), new FeatureCountVisitor()));
+}
+
+void CalculateStatsOp::_appendSampledStat(const boost::shared_ptr<const OsmMap>& map,
+  const vector<ConstElementPtr>& sample, long population, const QString& name,
+  const ConstElementVisitor& v)
+{
+  // the same hack _applyVisitor uses to let C++ pass v as a temporary.
+  ConstElementVisitor* visitor = const_cast<ConstElementVisitor*>(&v);
+  auto_ptr<FilteredVisitor> critFv;
+  if (_criterion)
+  {
+    critFv.reset(new FilteredVisitor(*_criterion, *visitor));
+    visitor = critFv.get();
+  }
+
+  // the stat accumulates on the innermost visitor, not on any filtered wrapper around it.
+  SingleStatistic* ss = dynamic_cast<SingleStatistic*>(visitor);
+  if (ss == 0)
+  {
+    FilteredVisitor* fv = dynamic_cast<FilteredVisitor*>(visitor);
+    while (ss == 0 && fv != 0)
+    {
+      ss = dynamic_cast<SingleStatistic*>(&fv->getChildVisitor());
+      fv = dynamic_cast<FilteredVisitor*>(&fv->getChildVisitor());
+    }
+  }
+  assert(ss != 0);
+
+  ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(visitor);
+  if (consumer != 0)
+  {
+    consumer->setOsmMap(map.get());
+  }
+
+  // track the per element contributions so the extrapolation comes with an error bound.
+  const long n = (long)sample.size();
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double previous = 0.0;
+  for (long i = 0; i < n; i++)
+  {
+    visitor->visit(sample[i]);
+    const double current = ss->getStat();
+    const double contribution = current - previous;
+    previous = current;
+    sum += contribution;
+    sumOfSquares += contribution * contribution;
+  }
+
+  const double mean = sum / (double)n;
+  const double total = mean * (double)population;
+  double ci = 0.0;
+  if (n > 1 && n < population)
+  {
+    const double variance =
+      std::max(0.0, (sumOfSquares - (double)n * mean * mean) / (double)(n - 1));
+    // standard error of the extrapolated total with the finite population correction; at
+    // n == population the sample is a census and the interval collapses to zero.
+    const double standardError =
+      sqrt(variance / (double)n * (1.0 - (double)n / (double)population));
+    ci = 1.96 * (double)population * standardError;
+  }
+
+  _stats.append(SingleStat(name, total));
+  _stats.append(SingleStat(name + " 95% Confidence (+/-)", ci));
+}
+
 double CalculateStatsOp::getSingleStat(const QString& n) const
 {
   for (int i = 0; i < _stats.size(); i++)
@@ -41,6 +41,7 @@
 namespace hoot
 {
 class FilteredVisitor;
+class StatsDeltaListener;
 
 class CalculateStatsOp : public ConstOsmMapOperation
 {
@@ -52,6 +53,17 @@ public:
 
   virtual void apply(const OsmMapPtr& map);
 
+  /**
+   * Adjusts a previously calculated set of stats by the element adds/removes recorded by delta
+   * instead of traversing the map again. Only the quick subset (setQuickSubset(true)) without a
+   * criterion decomposes this way; in any other configuration, or when the delta removed a
+   * baseline id extreme (the next extreme can't be known without a traversal), this falls back
+   * to a full apply(). The per-element memory estimates are carried over from the baseline
+   * unadjusted -- they're estimates to begin with and the delta doesn't track element sizes.
+   */
+  void applyIncremental(const OsmMapPtr& map, const QList<SingleStat>& baselineStats,
+                        const StatsDeltaListener& delta);
+
   QList<SingleStat> getStats() const { return _stats; }
 
   void printStats();
@@ -73,12 +85,22 @@ public:
 
   void setQuickSubset(bool quick) { _quick = quick; }
 
+  /**
+   * When set to a positive value, apply() computes a reduced stat set from a reservoir sample
+   * of the given size instead of traversing every element: the per type element counts stay
+   * exact (they're O(1)), while the expensive stats (feature counts by criterion and length/area
+   * sums) are extrapolated from the sample and reported alongside a "... 95% Confidence (+/-)"
+   * stat. Intended for interactive use where a fast approximate answer beats an exact one.
+   */
+  void setSampleSize(long sampleSize) { _sampleSize = sampleSize; }
+
 private:
 
   ElementCriterionPtr _criterion;
   //simple map name string for logging purposes
   QString _mapName;
   bool _quick;
+  long _sampleSize;
   //We differentiate between maps that are the input to a conflation job vs those that are the
   //output of a conflation job.  Another option would be to refactor this class for both maps
   //meant to be input to a conflation job and those that are output from a conflation job.
@@ -103,6 +125,17 @@ private:
 
   void _applyVisitor(boost::shared_ptr<const OsmMap> &map, ConstElementVisitor *v);
 
+  void _applySampled(const OsmMapPtr& map);
+
+  /**
+   * Runs the filtered visitor over the sampled elements only, extrapolates the resulting stat to
+   * the full population and appends it together with a 95% confidence interval derived from the
+   * per element contributions.
+   */
+  void _appendSampledStat(const boost::shared_ptr<const OsmMap>& map,
+                          const std::vector<ConstElementPtr>& sample, long population,
+                          const QString& name, const ConstElementVisitor& v);
+
   static bool _matchDescriptorCompare(const MatchCreator::Description& m1,
                                       const MatchCreator::Description& m2);
 
@@ -0,0 +1,216 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "CompactIdsOp.h"
+
+// hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Factory.h>
+#include <hoot/core/util/Log.h>
+
+// Standard
+#include <algorithm>
+
+using namespace std;
+
+namespace hoot
+{
+
+unsigned int CompactIdsOp::logWarnCount = 0;
+
+HOOT_FACTORY_REGISTER(OsmMapOperation, CompactIdsOp)
+
+CompactIdsOp::CompactIdsOp()
+{
+}
+
+void CompactIdsOp::apply(boost::shared_ptr<OsmMap>& map)
+{
+  _nodeIdMap.clear();
+  _wayIdMap.clear();
+  _relationIdMap.clear();
+
+  // map the old ids in ascending order so the result is deterministic.
+  vector<long> nodeIds;
+  nodeIds.reserve(map->getNodes().size());
+  for (NodeMap::const_iterator it = map->getNodes().begin(); it != map->getNodes().end(); ++it)
+  {
+    nodeIds.push_back(it->first);
+  }
+  sort(nodeIds.begin(), nodeIds.end());
+  for (size_t i = 0; i < nodeIds.size(); ++i)
+  {
+    _nodeIdMap[nodeIds[i]] = -(long)(i + 1);
+  }
+
+  vector<long> wayIds;
+  wayIds.reserve(map->getWays().size());
+  for (WayMap::const_iterator it = map->getWays().begin(); it != map->getWays().end(); ++it)
+  {
+    wayIds.push_back(it->first);
+  }
+  sort(wayIds.begin(), wayIds.end());
+  for (size_t i = 0; i < wayIds.size(); ++i)
+  {
+    _wayIdMap[wayIds[i]] = -(long)(i + 1);
+  }
+
+  vector<long> relationIds;
+  relationIds.reserve(map->getRelations().size());
+  for (RelationMap::const_iterator it = map->getRelations().begin();
+       it != map->getRelations().end(); ++it)
+  {
+    relationIds.push_back(it->first);
+  }
+  sort(relationIds.begin(), relationIds.end());
+  for (size_t i = 0; i < relationIds.size(); ++i)
+  {
+    _relationIdMap[relationIds[i]] = -(long)(i + 1);
+  }
+
+  // build a fresh map so the element hashes are rebuilt at their compact size.
+  OsmMapPtr result(new OsmMap(map->getProjection()));
+
+  vector<NodePtr> newNodes;
+  newNodes.reserve(nodeIds.size());
+  for (size_t i = 0; i < nodeIds.size(); ++i)
+  {
+    NodePtr n(new Node(*map->getNode(nodeIds[i])));
+    n->setId(_nodeIdMap[nodeIds[i]]);
+    newNodes.push_back(n);
+  }
+  result->addNodes(newNodes);
+
+  vector<WayPtr> newWays;
+  newWays.reserve(wayIds.size());
+  for (size_t i = 0; i < wayIds.size(); ++i)
+  {
+    WayPtr w(new Way(*map->getWay(wayIds[i])));
+    w->setId(_wayIdMap[wayIds[i]]);
+
+    const vector<long>& oldNids = w->getNodeIds();
+    vector<long> newNids;
+    newNids.reserve(oldNids.size());
+    for (size_t j = 0; j < oldNids.size(); ++j)
+    {
+      HashMap<long, long>::const_iterator nit = _nodeIdMap.find(oldNids[j]);
+      if (nit != _nodeIdMap.end())
+      {
+        newNids.push_back(nit->second);
+      }
+      else
+      {
+        // dangling reference; keep it as is rather than silently dropping it.
+        newNids.push_back(oldNids[j]);
+        if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN("Way " << wayIds[i] << " references node " << oldNids[j] <<
+                   " which isn't in the map. Keeping the old id.");
+        }
+        else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+        }
+        logWarnCount++;
+      }
+    }
+    w->setNodes(newNids);
+    newWays.push_back(w);
+  }
+  result->addWays(newWays);
+
+  vector<RelationPtr> newRelations;
+  newRelations.reserve(relationIds.size());
+  for (size_t i = 0; i < relationIds.size(); ++i)
+  {
+    RelationPtr r(new Relation(*map->getRelation(relationIds[i])));
+    r->setId(_relationIdMap[relationIds[i]]);
+
+    const vector<RelationData::Entry>& oldMembers = r->getMembers();
+    vector<RelationData::Entry> newMembers;
+    newMembers.reserve(oldMembers.size());
+    for (size_t j = 0; j < oldMembers.size(); ++j)
+    {
+      const ElementId& eid = oldMembers[j].getElementId();
+      const HashMap<long, long>* idMap = 0;
+      switch (eid.getType().getEnum())
+      {
+      case ElementType::Node:
+        idMap = &_nodeIdMap;
+        break;
+      case ElementType::Way:
+        idMap = &_wayIdMap;
+        break;
+      case ElementType::Relation:
+        idMap = &_relationIdMap;
+        break;
+      default:
+        break;
+      }
+
+      bool mapped = false;
+      long newId = eid.getId();
+      if (idMap != 0)
+      {
+        HashMap<long, long>::const_iterator mit = idMap->find(eid.getId());
+        if (mit != idMap->end())
+        {
+          newId = mit->second;
+          mapped = true;
+        }
+      }
+
+      if (mapped)
+      {
+        newMembers.push_back(RelationData::Entry(oldMembers[j].getRole(),
+          ElementId(eid.getType(), newId)));
+      }
+      else
+      {
+        // member isn't in the map; keep the reference untouched.
+        newMembers.push_back(oldMembers[j]);
+        if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN("Relation " << relationIds[i] << " references " << eid <<
+                   " which isn't in the map. Keeping the old id.");
+        }
+        else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+        {
+          LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+        }
+        logWarnCount++;
+      }
+    }
+    r->setMembers(newMembers);
+    newRelations.push_back(r);
+  }
+  result->addRelations(newRelations);
+
+  map = result;
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef COMPACTIDSOP_H
+#define COMPACTIDSOP_H
+
+// hoot
+#include <hoot/core/ops/OsmMapOperation.h>
+
+// Tgs
+#include <tgs/HashMap.h>
+
+namespace hoot
+{
+
+class OsmMap;
+
+/**
+ * Rewrites all element ids into a dense sequential range.
+ *
+ * After conflation and splitting, ids are sparse 64 bit values which bloats every id keyed hash
+ * (NodeToWayMap and friends) and rules out vector indexed storage downstream. This op assigns new
+ * ids of -1..-N per element type (negative, following the convention for locally generated ids),
+ * rewrites all the way-node and relation-member references in one pass and rebuilds the element
+ * hashes at their compact size. The assignment is deterministic: old ids are mapped in ascending
+ * order.
+ *
+ * The old-to-new id mapping for each element type is available after apply() for callers that
+ * need to translate external references.
+ */
+class CompactIdsOp : public OsmMapOperation
+{
+public:
+
+  static std::string className() { return "hoot::CompactIdsOp"; }
+
+  CompactIdsOp();
+
+  virtual void apply(boost::shared_ptr<OsmMap>& map);
+
+  const HashMap<long, long>& getNodeIdMap() const { return _nodeIdMap; }
+  const HashMap<long, long>& getWayIdMap() const { return _wayIdMap; }
+  const HashMap<long, long>& getRelationIdMap() const { return _relationIdMap; }
+
+  virtual QString toString() { return QString::fromStdString(className()); }
+
+private:
+
+  static unsigned int logWarnCount;
+
+  HashMap<long, long> _nodeIdMap;
+  HashMap<long, long> _wayIdMap;
+  HashMap<long, long> _relationIdMap;
+};
+
+}
+
+#endif // COMPACTIDSOP_H
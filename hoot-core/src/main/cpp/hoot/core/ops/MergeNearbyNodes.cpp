@@ -39,13 +39,19 @@
 #include <hoot/core/util/MapProjector.h>
 
 // Qt
+#include <QFuture>
+#include <QThread>
 #include <QTime>
+#include <QtConcurrentRun>
 
 // Standard
+#include <algorithm>
 #include <iostream>
+#include <map>
 
 // TGS
 #include <tgs/StreamUtils.h>
+#include <tgs/DisjointSet/DisjointSetMap.h>
 #include <tgs/RStarTree/HilbertRTree.h>
 
 using namespace std;
@@ -63,6 +69,85 @@ double calcDistance(const NodePtr& n1, const NodePtr& n2)
   return sqrt(dx * dx + dy * dy);
 }
 
+namespace
+{
+
+/// snapshot of the node state a worker thread needs; workers never touch the maps.
+struct MergeCandidateNode
+{
+  long id;
+  double x;
+  double y;
+  /// geographic coordinates for the bounds check; equal to x/y when no bounds are set.
+  double gx;
+  double gy;
+  int status;
+};
+
+/**
+ * Finds the mergeable pairs in the given cells. Pairs may be reported more than once when both
+ * nodes fall in several cells' halos; the union-find on the collecting side absorbs duplicates.
+ */
+vector< pair<long, long> > findMergePairsInCells(
+  const vector< vector<MergeCandidateNode> >* cells, const vector<int>* cellIndexes,
+  double distance, geos::geom::Envelope bounds)
+{
+  vector< pair<long, long> > result;
+
+  for (size_t c = 0; c < cellIndexes->size(); c++)
+  {
+    const vector<MergeCandidateNode>& cn = (*cells)[(*cellIndexes)[c]];
+    if (cn.size() < 2)
+    {
+      continue;
+    }
+
+    ClosePointHash cph(distance);
+    std::map<long, size_t> idToIndex;
+    for (size_t i = 0; i < cn.size(); i++)
+    {
+      cph.addPoint(cn[i].x, cn[i].y, cn[i].id);
+      idToIndex[cn[i].id] = i;
+    }
+
+    cph.resetIterator();
+    while (cph.next())
+    {
+      const vector<long>& v = cph.getMatch();
+      for (size_t i = 0; i < v.size(); i++)
+      {
+        for (size_t j = i + 1; j < v.size(); j++)
+        {
+          const MergeCandidateNode& n1 = cn[idToIndex[v[i]]];
+          const MergeCandidateNode& n2 = cn[idToIndex[v[j]]];
+          if (n1.status != n2.status)
+          {
+            continue;
+          }
+          double dx = n1.x - n2.x;
+          double dy = n1.y - n2.y;
+          if (sqrt(dx * dx + dy * dy) >= distance)
+          {
+            continue;
+          }
+          if (bounds.isNull() == false &&
+              (bounds.contains(n1.gx, n1.gy) == false ||
+               bounds.contains(n2.gx, n2.gy) == false))
+          {
+            continue;
+          }
+          result.push_back(
+            pair<long, long>(std::min(n1.id, n2.id), std::max(n1.id, n2.id)));
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+}
+
 MergeNearbyNodes::MergeNearbyNodes(Meters distance)
 {
   _distance = distance;
@@ -100,6 +185,19 @@ void MergeNearbyNodes::apply(boost::shared_ptr<OsmMap>& map)
     }
   }
 
+  // big maps with several cores available take the cell partitioned parallel path.
+  if (QThread::idealThreadCount() > 1 && _distance > 0.0 &&
+      (long)planar->getNodes().size() >= 20000)
+  {
+    int mergeCount = _applyParallel(map, planar, wgs84);
+    if (Log::getInstance().isInfoEnabled())
+    {
+      cout << "MergeNearbyNodes " << planar->getNodes().size() << " merged: " << mergeCount <<
+        " elapsed: " << time.elapsed() << "ms        \n";
+    }
+    return;
+  }
+
   ClosePointHash cph(_distance);
 
   const NodeMap& nodes = planar->getNodes();
@@ -170,6 +268,107 @@ void MergeNearbyNodes::apply(boost::shared_ptr<OsmMap>& map)
   }
 }
 
+int MergeNearbyNodes::_applyParallel(boost::shared_ptr<OsmMap>& map,
+  const boost::shared_ptr<OsmMap>& planar, const boost::shared_ptr<OsmMap>& wgs84)
+{
+  // cells much wider than the merge distance keep the halo duplication small while still
+  // giving plenty of cells to spread over the workers.
+  const double cellSize = _distance * 16.0;
+
+  // assign each node to its cell plus any neighboring cell within the merge distance. any two
+  // nodes within the merge distance are then guaranteed to share at least one cell.
+  std::map< pair<int, int>, int > cellIds;
+  vector< vector<MergeCandidateNode> > cells;
+  const NodeMap& nodes = planar->getNodes();
+  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  {
+    const NodePtr& n = it->second;
+    MergeCandidateNode rec;
+    rec.id = n->getId();
+    rec.x = n->getX();
+    rec.y = n->getY();
+    rec.gx = rec.x;
+    rec.gy = rec.y;
+    if (_bounds.isNull() == false)
+    {
+      const NodePtr& g = wgs84->getNode(rec.id);
+      rec.gx = g->getX();
+      rec.gy = g->getY();
+    }
+    rec.status = n->getStatus().getEnum();
+
+    const int minCx = (int)floor((rec.x - _distance) / cellSize);
+    const int maxCx = (int)floor((rec.x + _distance) / cellSize);
+    const int minCy = (int)floor((rec.y - _distance) / cellSize);
+    const int maxCy = (int)floor((rec.y + _distance) / cellSize);
+    for (int cx = minCx; cx <= maxCx; cx++)
+    {
+      for (int cy = minCy; cy <= maxCy; cy++)
+      {
+        std::map< pair<int, int>, int >::iterator cit =
+          cellIds.find(pair<int, int>(cx, cy));
+        if (cit == cellIds.end())
+        {
+          cit = cellIds.insert(
+            pair< pair<int, int>, int >(pair<int, int>(cx, cy), (int)cells.size())).first;
+          cells.push_back(vector<MergeCandidateNode>());
+        }
+        cells[cit->second].push_back(rec);
+      }
+    }
+  }
+
+  // deal the cells round robin over the workers and find the pairs concurrently.
+  const int threadCount = QThread::idealThreadCount();
+  vector< vector<int> > workerCells(threadCount);
+  for (size_t i = 0; i < cells.size(); i++)
+  {
+    workerCells[i % threadCount].push_back((int)i);
+  }
+  QList< QFuture< vector< pair<long, long> > > > futures;
+  for (int i = 0; i < threadCount; i++)
+  {
+    futures.append(
+      QtConcurrent::run(findMergePairsInCells, &cells, &workerCells[i], _distance, _bounds));
+  }
+
+  // pairs found in several cells' halos collapse into one merge group here.
+  DisjointSetMap<long> groups;
+  for (int i = 0; i < futures.size(); i++)
+  {
+    const vector< pair<long, long> > pairs = futures[i].result();
+    for (size_t j = 0; j < pairs.size(); j++)
+    {
+      groups.joinT(pairs[j].first, pairs[j].second);
+    }
+  }
+
+  // apply the merges in one pass, keeping the lowest id in each group for determinism.
+  int mergeCount = 0;
+  const DisjointSetMap<long>::AllGroups& allGroups = groups.getAllGroups();
+  for (DisjointSetMap<long>::AllGroups::const_iterator it = allGroups.begin();
+    it != allGroups.end(); ++it)
+  {
+    vector<long> members = it->second;
+    if (members.size() < 2)
+    {
+      continue;
+    }
+    sort(members.begin(), members.end());
+    const long keeperId = members[0];
+    for (size_t i = 1; i < members.size(); i++)
+    {
+      if (map->containsNode(members[i]) && map->containsNode(keeperId))
+      {
+        map->replaceNode(members[i], keeperId);
+        mergeCount++;
+      }
+    }
+  }
+
+  return mergeCount;
+}
+
 void MergeNearbyNodes::mergeNodes(boost::shared_ptr<OsmMap> map, Meters distance)
 {
   MergeNearbyNodes mnn(distance);
@@ -73,6 +73,18 @@ protected:
   boost::shared_ptr<OsmMap> _map;
   Meters _distance;
   geos::geom::Envelope _bounds;
+
+private:
+
+  /**
+   * Partitioned parallel equivalent of the serial scan. The plane is divided into cells a few
+   * times wider than the merge distance, each node is assigned to its cell plus any neighboring
+   * cell within the merge distance (the halo), worker threads find the mergeable pairs in each
+   * cell independently and the pairs are resolved into merge groups with a union-find before
+   * the map is updated in one pass. Returns the number of nodes merged.
+   */
+  int _applyParallel(boost::shared_ptr<OsmMap>& map, const boost::shared_ptr<OsmMap>& planar,
+    const boost::shared_ptr<OsmMap>& wgs84);
 };
 
 }
@@ -29,15 +29,98 @@
 // hoot
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/elements/ConstElementVisitor.h>
+#include <hoot/core/io/HootMapFileWriter.h>
 #include <hoot/core/ops/VisitorOp.h>
 #include <hoot/core/OsmMap.h>
+#include <hoot/core/util/Cancellation.h>
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/util/Profiler.h>
+#include <hoot/core/visitors/FusableVisitor.h>
+#include <hoot/core/visitors/FusedVisitor.h>
+
+// Qt
+#include <QTime>
 
 namespace hoot
 {
 
 HOOT_FACTORY_REGISTER(OsmMapOperation, NamedOp)
 
+namespace
+{
+
+/**
+ * Applies the buffered fusable visitors: a single visitor runs as its own pass like before,
+ * two or more run as one fused traversal with per stage timing.
+ */
+void flushFusableVisitors(boost::shared_ptr<OsmMap>& map,
+  std::vector<ConstElementVisitorPtr>& visitors, QStringList& names)
+{
+  if (visitors.empty())
+  {
+    return;
+  }
+
+  QTime timer;
+  timer.start();
+
+  ProfileScope profile(visitors.size() == 1 ? names[0] : "fused " + names.join(", "));
+  if (visitors.size() == 1)
+  {
+    LOG_INFO("Applying visitor: " << names[0]);
+    VisitorOp(visitors[0]).apply(map);
+    LOG_INFO(names[0] << " took " << timer.elapsed() << "ms");
+  }
+  else
+  {
+    LOG_INFO("Applying fused visitors: " << names.join(", "));
+    boost::shared_ptr<FusedVisitor> fused(new FusedVisitor());
+    for (size_t i = 0; i < visitors.size(); i++)
+    {
+      fused->addVisitor(visitors[i], names[(int)i]);
+    }
+    VisitorOp(fused).apply(map);
+    LOG_INFO("Fused pass took " << timer.elapsed() << "ms (" << fused->getTimingString() <<
+      ")");
+  }
+
+  LOG_VARD(map->getElementCount());
+
+  visitors.clear();
+  names.clear();
+}
+
+/**
+ * Dumps the partially processed map to the configured checkpoint path so a cancelled run leaves
+ * a resumable artifact. Checkpoint failures are logged rather than thrown; the cancellation is
+ * the error the caller needs to see.
+ */
+void checkpointOnCancel(const boost::shared_ptr<OsmMap>& map)
+{
+  const QString output = ConfigOptions().getOperationCheckpointOutput();
+  if (output.isEmpty())
+  {
+    return;
+  }
+
+  try
+  {
+    LOG_WARN("Operation cancelled; writing checkpoint to " << output);
+    HootMapFileWriter writer;
+    writer.open(output);
+    writer.write(map);
+    writer.close();
+  }
+  catch (const HootException& e)
+  {
+    LOG_ERROR("Failed writing cancellation checkpoint to " << output << ": " << e.getWhat());
+  }
+}
+
+}
+
 NamedOp::NamedOp()
 {
   _conf = 0;
@@ -47,54 +130,108 @@ void NamedOp::apply(boost::shared_ptr<OsmMap> &map)
 {
   Factory& f = Factory::getInstance();
 
-  foreach (QString s, _namedOps)
+  // resolve every configured class up front so a typo near the end of the list fails before any
+  // expensive op has run.
+  f.preResolve(_namedOps);
+
+  // arm the configured deadline once at the outermost op chain; nested NamedOps (e.g. the
+  // conflate pre and post op lists) run under the already armed deadline.
+  const double deadlineSeconds = ConfigOptions().getOperationDeadlineSeconds();
+  if (deadlineSeconds > 0.0 && !Cancellation::isDeadlineArmed())
   {
-    if (s.isEmpty())
-    {
-      // pass
-    }
-    else if (f.hasBase<OsmMapOperation>(s.toStdString()))
-    {
-      LOG_INFO("Applying operation: " << s);
-      boost::shared_ptr<OsmMapOperation> t(Factory::getInstance().constructObject<OsmMapOperation>(s));
+    Cancellation::armDeadlineFromNow(deadlineSeconds);
+  }
 
-      Configurable* c = dynamic_cast<Configurable*>(t.get());
-      if (_conf != 0 && c != 0)
+  // consecutive visitors implementing FusableVisitor are buffered here and composed into a
+  // single traversal instead of one full map pass each.
+  std::vector<ConstElementVisitorPtr> fusable;
+  QStringList fusableNames;
+
+  try
+  {
+    foreach (QString s, _namedOps)
+    {
+      if (s.isEmpty())
       {
-        c->setConfiguration(*_conf);
+        continue;
       }
 
-      if (!t->toString().trimmed().isEmpty())
+      // each op is a cancellation point, so a cancelled run stops between ops with the map in a
+      // consistent state.
+      Cancellation::checkIn();
+
+      ObjectCreator& creator = f.getCreator(s);
+      if (creator.getBaseName() == OsmMapOperation::className())
       {
-        LOG_DEBUG("Details: " << t->toString());
-      }
+        flushFusableVisitors(map, fusable, fusableNames);
 
-      t->apply(map);
+        LOG_INFO("Applying operation: " << s);
+        boost::shared_ptr<OsmMapOperation> t(Factory::constructObject<OsmMapOperation>(creator));
 
-      LOG_VARD(map->getElementCount());
-    }
-    else if (f.hasBase<ConstElementVisitor>(s.toStdString()))
-    {
-      LOG_INFO("Applying visitor: " << s);
-      boost::shared_ptr<ConstElementVisitor> t(Factory::getInstance().
-        constructObject<ConstElementVisitor>(s));
+        Configurable* c = dynamic_cast<Configurable*>(t.get());
+        if (_conf != 0 && c != 0)
+        {
+          c->setConfiguration(*_conf);
+        }
 
-      Configurable* c = dynamic_cast<Configurable*>(t.get());
-      if (_conf != 0 && c != 0)
-      {
-        c->setConfiguration(*_conf);
-      }
+        if (!t->toString().trimmed().isEmpty())
+        {
+          LOG_DEBUG("Details: " << t->toString());
+        }
+
+        QTime timer;
+        timer.start();
+        ProfileScope profile(s);
+        t->apply(map);
+        LOG_INFO(s << " took " << timer.elapsed() << "ms");
 
-      if (!t->toString().trimmed().isEmpty())
+        LOG_VARD(map->getElementCount());
+      }
+      else if (creator.getBaseName() == ConstElementVisitor::className())
       {
-        LOG_DEBUG("Details: " << t->toString());
+        boost::shared_ptr<ConstElementVisitor> t(
+          Factory::constructObject<ConstElementVisitor>(creator));
+
+        Configurable* c = dynamic_cast<Configurable*>(t.get());
+        if (_conf != 0 && c != 0)
+        {
+          c->setConfiguration(*_conf);
+        }
+
+        if (!t->toString().trimmed().isEmpty())
+        {
+          LOG_DEBUG("Details: " << t->toString());
+        }
+
+        if (dynamic_cast<FusableVisitor*>(t.get()) != 0)
+        {
+          fusable.push_back(t);
+          fusableNames.append(s);
+        }
+        else
+        {
+          flushFusableVisitors(map, fusable, fusableNames);
+
+          LOG_INFO("Applying visitor: " << s);
+          QTime timer;
+          timer.start();
+          ProfileScope profile(s);
+          boost::shared_ptr<OsmMapOperation> op(new VisitorOp(t));
+          op->apply(map);
+          LOG_INFO(s << " took " << timer.elapsed() << "ms");
+
+          LOG_VARD(map->getElementCount());
+        }
       }
-
-      boost::shared_ptr<OsmMapOperation> op(new VisitorOp(t));
-      op->apply(map);
-
-      LOG_VARD(map->getElementCount());
     }
+
+    flushFusableVisitors(map, fusable, fusableNames);
+  }
+  catch (const OperationCancelledException&)
+  {
+    // checkpoint whatever the completed ops produced, then let the cancellation propagate.
+    checkpointOnCancel(map);
+    throw;
   }
 }
 
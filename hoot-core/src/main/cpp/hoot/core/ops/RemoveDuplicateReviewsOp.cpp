@@ -50,28 +50,22 @@ void RemoveDuplicateReviewsOp::apply(boost::shared_ptr<OsmMap>& map)
 {
   _map = map;
 
-  // go through all the relations to get duplicate reviews
-  const RelationMap& relations = map->getRelations();
-  QMap< set<ElementId>, QList<ReviewMarker::ReviewUid> > membersToReview;
-  for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
-  {
-    ElementId eid = ElementId::relation(it->first);
-    if (ReviewMarker::isReviewUid(map, eid))
-    {
-      membersToReview[ReviewMarker::getReviewElements(map, eid)].append(eid);
-    }
-  }
-  LOG_VART(membersToReview);
+  // Index all the reviews by a hash of their members in one pass over the relations. Reviews
+  // over the same member set land in the same bucket, so finding the duplicates is a hash lookup
+  // rather than an ordered member set comparison per review.
+  QHash<QString, QList<ReviewMarker::ReviewUid> > membersToReview =
+    ReviewMarker::buildReviewTable(map);
+  LOG_VART(membersToReview.size());
 
   //loop through duplicate reviews
-  QMap< set<ElementId>, QList<ReviewMarker::ReviewUid> >::iterator it = membersToReview.begin();
+  QHash<QString, QList<ReviewMarker::ReviewUid> >::iterator it = membersToReview.begin();
   while (it != membersToReview.end())
   {
-    set<ElementId> eids = it.key();
-
     //remove duplicate reviews
     QList<ReviewMarker::ReviewUid> duplicateReviews = it.value();
 
+    set<ElementId> eids = ReviewMarker::getReviewElements(map, duplicateReviews[0]);
+
     LOG_VART(eids.size());
     LOG_VART(duplicateReviews.size());
 
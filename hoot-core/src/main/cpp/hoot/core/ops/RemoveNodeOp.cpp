@@ -54,7 +54,8 @@ RemoveNodeOp::RemoveNodeOp(long nId, bool doCheck, bool removeFully):
 
 void RemoveNodeOp::_removeNodeNoCheck(OsmMapPtr& map, long nId)
 {
-  map->_index->removeNode(map->getNode(_nodeIdToRemove));
+  map->_index->removeNode(map->getNode(nId));
+  map->_notifyElementRemoved(map->getNode(nId));
   map->_nodes.erase(nId);
 }
 
@@ -72,8 +73,7 @@ void RemoveNodeOp::_removeNode(OsmMapPtr& map, long nId)
 void RemoveNodeOp::_removeNodeFully(OsmMapPtr& map, long nId)
 {
   // copy the set because we may modify it later.
-  set<long> rid = map->getIndex().getElementToRelationMap()->
-      getRelationByElement(ElementId::way(nId));
+  set<long> rid = map->getRelationsByElement(ElementId::node(nId));
 
   for (set<long>::const_iterator it = rid.begin(); it != rid.end(); ++it)
   {
@@ -54,8 +54,7 @@ void RemoveRelationOp::apply(OsmMapPtr& map)
   {
     // determine if this relation is a part of any other relations
     // make a copy of the rids in case the index gets changed.
-    const set<long> rids = map->_index->getElementToRelationMap()->
-      getRelationByElement(ElementId::relation(_rIdToRemove));
+    const set<long> rids = map->getRelationsByElement(ElementId::relation(_rIdToRemove));
 
     // remove this relation from all other parent relations.
     for (set<long>::const_iterator it = rids.begin(); it != rids.end(); ++it)
@@ -64,6 +63,7 @@ void RemoveRelationOp::apply(OsmMapPtr& map)
     }
 
     map->_index->removeRelation(map->getRelation(_rIdToRemove));
+    map->_notifyElementRemoved(map->getRelation(_rIdToRemove));
     map->_relations.erase(_rIdToRemove);
     VALIDATE(map->validate());
   }
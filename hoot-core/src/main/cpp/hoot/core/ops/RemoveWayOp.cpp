@@ -55,6 +55,7 @@ void RemoveWayOp::_removeWay(OsmMapPtr &map, long wId)
   if (map->_ways.find(wId) != map->_ways.end())
   {
     map->_index->removeWay(map->getWay(wId));
+    map->_notifyElementRemoved(map->getWay(wId));
     map->_ways.erase(wId);
   }
 }
@@ -62,8 +63,7 @@ void RemoveWayOp::_removeWay(OsmMapPtr &map, long wId)
 void RemoveWayOp::_removeWayFully(OsmMapPtr &map, long wId)
 {
   // copy the set because we may modify it later.
-  set<long> rid = map->_index->getElementToRelationMap()->
-      getRelationByElement(ElementId::way(wId));
+  set<long> rid = map->getRelationsByElement(ElementId::way(wId));
 
   for (set<long>::const_iterator it = rid.begin(); it != rid.end(); ++it)
   {
@@ -0,0 +1,148 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef STATSDELTALISTENER_H
+#define STATSDELTALISTENER_H
+
+// hoot
+#include <hoot/core/OsmMapListener.h>
+#include <hoot/core/elements/ElementType.h>
+
+// tgs
+#include <tgs/HashMap.h>
+
+// Standard
+#include <limits>
+
+namespace hoot
+{
+
+/**
+ * Records the net set of elements added to and removed from a map so stats can be adjusted
+ * incrementally rather than recomputed with a full traversal
+ * (CalculateStatsOp::applyIncremental).
+ *
+ * "Net" means an element that is added and then removed (or vice versa) cancels out, so after an
+ * arbitrary sequence of operations the recorded sets describe exactly the difference between the
+ * map now and the map when the listener was registered (or last cleared). Tag and geometry edits
+ * to elements that stay in the map are intentionally not tracked -- stats that depend on them
+ * aren't decomposable and must be recomputed.
+ */
+class StatsDeltaListener : public OsmMapListener
+{
+public:
+
+  StatsDeltaListener() {}
+
+  virtual boost::shared_ptr<OsmMapListener> clone() const
+  {
+    return boost::shared_ptr<OsmMapListener>(new StatsDeltaListener(*this));
+  }
+
+  virtual void elementAdded(const ConstElementPtr& e)
+  {
+    const int t = e->getElementType().getEnum();
+    const long id = e->getId();
+    if (_removed[t].erase(id) == 0)
+    {
+      _added[t].insert(id);
+    }
+  }
+
+  virtual void elementRemoved(const ConstElementPtr& e)
+  {
+    const int t = e->getElementType().getEnum();
+    const long id = e->getId();
+    if (_added[t].erase(id) == 0)
+    {
+      _removed[t].insert(id);
+    }
+  }
+
+  // replacing a node doesn't change the element population; the add/remove hooks see any
+  // removal that follows.
+  virtual void replaceNodePre(long /*oldId*/, long /*newId*/) {}
+
+  long getAddedCount(ElementType::Type type) const { return (long)_added[type].size(); }
+
+  long getRemovedCount(ElementType::Type type) const { return (long)_removed[type].size(); }
+
+  /**
+   * Returns the smallest/largest id among the net added elements of the given type. Only valid
+   * when getAddedCount(type) > 0.
+   */
+  long getMinAddedId(ElementType::Type type) const
+  {
+    long result = std::numeric_limits<long>::max();
+    for (HashSet<long>::const_iterator it = _added[type].begin(); it != _added[type].end(); ++it)
+    {
+      result = std::min(result, *it);
+    }
+    return result;
+  }
+
+  long getMaxAddedId(ElementType::Type type) const
+  {
+    long result = std::numeric_limits<long>::min();
+    for (HashSet<long>::const_iterator it = _added[type].begin(); it != _added[type].end(); ++it)
+    {
+      result = std::max(result, *it);
+    }
+    return result;
+  }
+
+  /**
+   * Returns true if the given id was (net) removed. Used to decide whether a baseline extreme
+   * (e.g. minimum node id) is still present and can be adjusted without a recompute.
+   */
+  bool wasRemoved(ElementType::Type type, long id) const
+  {
+    return _removed[type].find(id) != _removed[type].end();
+  }
+
+  /**
+   * Forgets all recorded changes; the current map state becomes the new baseline.
+   */
+  void clear()
+  {
+    for (int i = 0; i < ElementType::Unknown; i++)
+    {
+      _added[i].clear();
+      _removed[i].clear();
+    }
+  }
+
+private:
+
+  HashSet<long> _added[ElementType::Unknown];
+  HashSet<long> _removed[ElementType::Unknown];
+};
+
+typedef boost::shared_ptr<StatsDeltaListener> StatsDeltaListenerPtr;
+
+}
+
+#endif // STATSDELTALISTENER_H
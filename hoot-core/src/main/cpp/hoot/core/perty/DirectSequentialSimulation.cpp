@@ -31,6 +31,9 @@
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/variate_generator.hpp>
 
+// Standard
+#include <vector>
+
 // Tgs
 #include <tgs/System/Time.h>
 
@@ -39,6 +42,7 @@
 #include <hoot/core/util/RandomNumberUtils.h>
 
 using namespace cv;
+using namespace std;
 
 namespace hoot
 {
@@ -75,12 +79,15 @@ Mat DirectSequentialSimulation::permute(geos::geom::Envelope env, int& pointRows
   // 9) Join the x-errors and y-errors for the n points in a 2nx1 vector as,
   Mat EX(Ex.rows * Ex.cols * 2, 1, CV_64F);
 
+  double* out = EX.ptr<double>(0);
   for (int i = 0; i < Ex.rows; i++)
   {
+    const double* exRow = Ex.ptr<double>(i);
+    const double* eyRow = Ey.ptr<double>(i);
     for (int j = 0; j < Ex.cols; j++)
     {
-      EX.at<double>((i * Ex.cols + j) * 2, 0) = Ex.at<double>(i, j);
-      EX.at<double>((i * Ex.cols + j) * 2 + 1, 0) = Ey.at<double>(i, j);
+      out[(i * Ex.cols + j) * 2] = exRow[j];
+      out[(i * Ex.cols + j) * 2 + 1] = eyRow[j];
     }
   }
 
@@ -129,13 +136,30 @@ Mat DirectSequentialSimulation::_gm2dPerturb2(geos::geom::Envelope env, Meters s
     Pb.at<double>(0, k) = r * Pb.at<double>(0, k - 1) + N() * sigu;
   }
 
-  // then fill in the rest of the grid
-  for (int k = 2; k < cols; ++k)
+  // draw the interior noise up front in the order the original cell by cell loop consumed it,
+  // so a fixed seed still produces the same grid.
+  int noiseRows = max(0, rows - 2);
+  int noiseCols = max(0, cols - 2);
+  vector<double> noise((size_t)noiseRows * noiseCols);
+  for (int k = 0; k < noiseCols; ++k)
+  {
+    for (int j = 0; j < noiseRows; ++j)
+    {
+      noise[(size_t)j * noiseCols + k] = N() * sigu;
+    }
+  }
+
+  // then fill in the rest of the grid; the recurrence only looks up and left, so filling row by
+  // row streams over contiguous memory instead of striding a column at a time.
+  double rs = r * s;
+  for (int j = 2; j < rows; ++j)
   {
-    for (int j = 2; j < rows; ++j)
+    const double* prevRow = Pb.ptr<double>(j - 1);
+    double* row = Pb.ptr<double>(j);
+    const double* noiseRow = &noise[(size_t)(j - 2) * noiseCols];
+    for (int k = 2; k < cols; ++k)
     {
-      Pb.at<double>(j, k) = r * Pb.at<double>(j - 1, k) + s * Pb.at<double>(j, k - 1) -
-          r * s * Pb.at<double>(j - 1, k - 1) + N() * sigu;
+      row[k] = r * prevRow[k] + s * row[k - 1] - rs * prevRow[k - 1] + noiseRow[k - 2];
     }
   }
 
@@ -55,7 +55,8 @@ namespace hoot
 {
 
 PertyMatchScorer::PertyMatchScorer() :
-  _settings(conf())
+  _settings(conf()),
+  _cachedSearchDistance(-1.0)
 {
   ConfigOptions configOptions;
   setSearchDistance(configOptions.getPertySearchDistance());
@@ -112,15 +113,31 @@ OsmMapPtr PertyMatchScorer::_loadReferenceMap(const QString referenceMapInputPat
   LOG_DEBUG("Loading the reference data with status " << MetadataTags::Unknown1() << " and adding " << MetadataTags::Ref1() <<
             " tags to it; Saving a copy to " << referenceMapOutputPath << "...");
 
-  OsmMapPtr referenceMap(new OsmMap());
-  OsmUtils::loadMap(referenceMap, referenceMapInputPath, false, Status::Unknown1);
-  MapCleaner().apply(referenceMap);
-
-  boost::shared_ptr<AddRef1Visitor> addRef1Visitor(new AddRef1Visitor());
-  referenceMap->visitRw(*addRef1Visitor);
-  boost::shared_ptr<SetTagVisitor> setAccuracyVisitor(
-    new SetTagVisitor(MetadataTags::ErrorCircular(), QString::number(_searchDistance)));
-  referenceMap->visitRw(*setAccuracyVisitor);
+  OsmMapPtr referenceMap;
+  // the prepared reference map is fully deterministic for a given input and search distance, so
+  // repeated simulations can copy the cached map instead of parsing and cleaning it again.
+  if (_cachedReferenceMap && _cachedReferenceMapPath == referenceMapInputPath &&
+      _cachedSearchDistance == _searchDistance)
+  {
+    LOG_DEBUG("Copying the cached reference map...");
+    referenceMap.reset(new OsmMap(_cachedReferenceMap));
+  }
+  else
+  {
+    referenceMap.reset(new OsmMap());
+    OsmUtils::loadMap(referenceMap, referenceMapInputPath, false, Status::Unknown1);
+    MapCleaner().apply(referenceMap);
+
+    boost::shared_ptr<AddRef1Visitor> addRef1Visitor(new AddRef1Visitor());
+    referenceMap->visitRw(*addRef1Visitor);
+    boost::shared_ptr<SetTagVisitor> setAccuracyVisitor(
+      new SetTagVisitor(MetadataTags::ErrorCircular(), QString::number(_searchDistance)));
+    referenceMap->visitRw(*setAccuracyVisitor);
+
+    _cachedReferenceMap.reset(new OsmMap(referenceMap));
+    _cachedReferenceMapPath = referenceMapInputPath;
+    _cachedSearchDistance = _searchDistance;
+  }
   LOG_VARD(referenceMap->getNodes().size());
   LOG_VARD(referenceMap->getWays().size());
   if (Log::getInstance().getLevel() <= Log::Debug)
@@ -123,6 +123,12 @@ private:
   QString _perturbedMapOutput;
   QString _conflatedMapOutput;
 
+  // caches the prepared reference map so repeated simulations over the same input (e.g. a
+  // PertyTestRunner matrix) skip the parse and cleanup and start from a copy instead.
+  OsmMapPtr _cachedReferenceMap;
+  QString _cachedReferenceMapPath;
+  double _cachedSearchDistance;
+
   double _searchDistance;
   bool _applyRubberSheet;
 
@@ -54,7 +54,12 @@ using namespace boost;
 #include <hoot/core/util/ConfigOptions.h>
 
 // Qt
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
 #include <QDomDocument>
+#include <QFile>
+#include <QFileInfo>
 #include <QHash>
 #include <QSet>
 
@@ -223,6 +228,7 @@ class OsmSchemaData
 public:
 
   OsmSchemaData() :
+  _componentEdgeCount(0),
   _logWarnCount(0)
   {
     _isACost = 1.0;
@@ -712,6 +718,13 @@ public:
       VertexId id1 = _name2Vertex[kvpn1];
       VertexId id2 = _name2Vertex[kvpn2];
 
+      // vertices in different components of the schema graph can never score above zero, so
+      // skip the shortest path computation behind _calculateScores for those pairs entirely
+      if (id1 != id2 && _componentOf(id1) != _componentOf(id2))
+      {
+        return 0.0;
+      }
+
       if (_processed.find(id1) == _processed.end())
       {
         _calculateScores(id1);
@@ -882,11 +895,220 @@ public:
     _updateVertex(vid, tv);
   }
 
+  uint64_t getTypeSignature(const Tags& t)
+  {
+    uint64_t result = 0;
+    for (Tags::const_iterator it = t.constBegin(); it != t.constEnd(); ++it)
+    {
+      const QString kvpn = normalizeEnumeratedKvp(OsmSchema::toKvp(it.key(), it.value()));
+      if (kvpn.isEmpty() == false)
+      {
+        result |= uint64_t(1) << (_componentOf(_name2Vertex[kvpn]) % 64);
+      }
+    }
+    return result;
+  }
+
   void update()
   {
     _percolateInheritance();
   }
 
+  /**
+   * Runs the similarity calculation from every vertex so score() never walks the graph again.
+   * The resulting rows ride along in the binary schema cache (writeBinary), which turns match
+   * phase schema scoring into a table lookup. This runs one shortest path pass per vertex and
+   * is intended for offline cache builds.
+   */
+  void precomputeScores()
+  {
+    graph_traits<TagGraph>::vertex_iterator vi, vend;
+    for (boost::tie(vi, vend) = vertices(_graph); vi != vend; ++vi)
+    {
+      if (_processed.find(*vi) == _processed.end())
+      {
+        _calculateScores(*vi);
+        _processed.insert(*vi);
+      }
+    }
+  }
+
+  /**
+   * Serializes the full graph state to ds. Only the state built up during load is written; the
+   * lazily populated score and average caches are rebuilt on demand and always start empty.
+   */
+  void writeBinary(QDataStream& ds) const
+  {
+    ds << _isACost;
+
+    ds << (quint32)num_vertices(_graph);
+    graph_traits<TagGraph>::vertex_iterator vi, vend;
+    for (boost::tie(vi, vend) = vertices(_graph); vi != vend; ++vi)
+    {
+      const SchemaVertex& v = _graph[*vi];
+      ds << (qint32)v.getType();
+      ds << v.name << v.description << v.key << v.value;
+      ds << v.influence << v.childWeight << v.mismatchScore;
+      ds << (qint32)v.valueType;
+      ds << v.aliases << v.categories;
+      ds << v.geometries;
+
+      const SchemaVertex::CompoundRuleList& rules = v.getCompoundRules();
+      ds << (qint32)rules.size();
+      for (int i = 0; i < rules.size(); ++i)
+      {
+        ds << (qint32)rules[i].size();
+        for (int j = 0; j < rules[i].size(); ++j)
+        {
+          ds << rules[i][j]->getName();
+        }
+      }
+    }
+
+    ds << (quint32)num_edges(_graph);
+    graph_traits<TagGraph>::edge_iterator ei, eend;
+    for (boost::tie(ei, eend) = edges(_graph); ei != eend; ++ei)
+    {
+      // the vertex list is a vector so the descriptors are stable indexes into it.
+      ds << (quint32)source(*ei, _graph) << (quint32)target(*ei, _graph);
+      const TagEdge& e = _graph[*ei];
+      ds << (qint32)e.type << e.similarToWeight << e.averageWeight << e.show;
+    }
+
+    // any fully calculated score rows (see precomputeScores) are carried in the cache so the
+    // loading side answers score() queries without a graph traversal. Only the non zero entries
+    // are stored; a missing pair scores 0.0 just as it does in _cachedScores.
+    ds << (quint32)_processed.size();
+    for (HashSet<VertexId>::const_iterator it = _processed.begin(); it != _processed.end(); ++it)
+    {
+      VertexId vid = *it;
+      ds << (quint32)vid;
+      VertexToScoreCache::const_iterator row = _vertexToScoresCache.find(vid);
+      if (row == _vertexToScoresCache.end())
+      {
+        ds << (quint32)0;
+      }
+      else
+      {
+        const vector< pair<VertexId, double> >& scores = row->second;
+        ds << (quint32)scores.size();
+        for (size_t i = 0; i < scores.size(); ++i)
+        {
+          ds << (quint32)scores[i].first << scores[i].second;
+        }
+      }
+    }
+  }
+
+  /**
+   * Rebuilds the graph from a stream written by writeBinary. The name, regex and compound
+   * lookups are reconstructed through _updateVertex just as they are when loading from the
+   * schema files. Throws if the stream is truncated or corrupt.
+   */
+  void readBinary(QDataStream& ds)
+  {
+    ds >> _isACost;
+
+    quint32 vertexCount = 0;
+    ds >> vertexCount;
+    if (ds.status() != QDataStream::Ok)
+    {
+      throw HootException("The schema cache stream is corrupt.");
+    }
+    for (quint32 i = 0; i < vertexCount; ++i)
+    {
+      SchemaVertex v;
+      qint32 type, valueType;
+      ds >> type;
+      ds >> v.name >> v.description >> v.key >> v.value;
+      ds >> v.influence >> v.childWeight >> v.mismatchScore;
+      ds >> valueType;
+      ds >> v.aliases >> v.categories;
+      ds >> v.geometries;
+      v.setType((SchemaVertex::VertexType)type);
+      v.valueType = (TagValueType)valueType;
+
+      qint32 ruleCount = 0;
+      ds >> ruleCount;
+      if (ds.status() != QDataStream::Ok)
+      {
+        throw HootException("The schema cache stream is corrupt.");
+      }
+      for (qint32 j = 0; j < ruleCount; ++j)
+      {
+        qint32 kvpCount = 0;
+        ds >> kvpCount;
+        SchemaVertex::CompoundRule rule;
+        for (qint32 k = 0; k < kvpCount; ++k)
+        {
+          QString kvp;
+          ds >> kvp;
+          rule.append(KeyValuePairPtr(new KeyValuePair(kvp)));
+        }
+        v.addCompoundRule(rule);
+      }
+
+      _addVertex(v);
+    }
+
+    quint32 edgeCount = 0;
+    ds >> edgeCount;
+    if (ds.status() != QDataStream::Ok)
+    {
+      throw HootException("The schema cache stream is corrupt.");
+    }
+    for (quint32 i = 0; i < edgeCount; ++i)
+    {
+      quint32 src = 0, trg = 0;
+      ds >> src >> trg;
+      qint32 type;
+      TagEdge e;
+      ds >> type >> e.similarToWeight >> e.averageWeight >> e.show;
+      e.type = (EdgeType)type;
+      e.w1 = 0.0;
+      e.w2 = 0.0;
+      if (ds.status() != QDataStream::Ok || src >= vertexCount || trg >= vertexCount)
+      {
+        throw HootException("The schema cache stream is corrupt.");
+      }
+      add_edge((VertexId)src, (VertexId)trg, e, _graph);
+      // replaying the edges in order reproduces the parent map that addIsA built up.
+      if (e.type == IsA)
+      {
+        _parents[(VertexId)src] = (VertexId)trg;
+      }
+    }
+
+    quint32 processedCount = 0;
+    ds >> processedCount;
+    if (ds.status() != QDataStream::Ok)
+    {
+      throw HootException("The schema cache stream is corrupt.");
+    }
+    for (quint32 i = 0; i < processedCount; ++i)
+    {
+      quint32 vid = 0, scoreCount = 0;
+      ds >> vid >> scoreCount;
+      if (ds.status() != QDataStream::Ok || vid >= vertexCount)
+      {
+        throw HootException("The schema cache stream is corrupt.");
+      }
+      _processed.insert((VertexId)vid);
+      for (quint32 j = 0; j < scoreCount; ++j)
+      {
+        quint32 other = 0;
+        double s = 0.0;
+        ds >> other >> s;
+        if (ds.status() != QDataStream::Ok || other >= vertexCount)
+        {
+          throw HootException("The schema cache stream is corrupt.");
+        }
+        _cachedScores[pair<VertexId, VertexId>((VertexId)vid, (VertexId)other)] = s;
+        _vertexToScoresCache[(VertexId)vid].push_back(pair<VertexId, double>((VertexId)other, s));
+      }
+    }
+  }
+
 private:
 
   QHash<QString, VertexId> _name2Vertex;
@@ -906,11 +1128,74 @@ private:
   typedef HashMap< VertexId, vector< pair< VertexId, double > > > VertexToScoreCache;
   VertexToScoreCache _vertexToScoresCache;
 
+  // connected component id per vertex; see _ensureComponents
+  vector<size_t> _componentIds;
+  size_t _componentEdgeCount;
+
   TagGraph _graph;
 
   //this should be static, but there's no header file
   unsigned int _logWarnCount;
 
+  /**
+   * Returns the connected component id of the vertex. Edge weights are ignored, which makes
+   * the components a conservative superset of score reachability: a zero weight edge still
+   * joins two vertices into one component, so different components guarantee a zero score
+   * while a shared component only makes a non zero score possible.
+   */
+  size_t _componentOf(VertexId vid)
+  {
+    _ensureComponents();
+    return _componentIds[vid];
+  }
+
+  void _ensureComponents()
+  {
+    // recompute whenever the graph grows; loading the schema or adding edges can merge
+    // components
+    if (_componentIds.size() == num_vertices(_graph) &&
+        _componentEdgeCount == num_edges(_graph))
+    {
+      return;
+    }
+
+    const size_t n = num_vertices(_graph);
+    vector<size_t> parent(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      parent[i] = i;
+    }
+
+    graph_traits<TagGraph>::edge_iterator ei, eend;
+    for (boost::tie(ei, eend) = edges(_graph); ei != eend; ++ei)
+    {
+      size_t a = _findRoot(parent, source(*ei, _graph));
+      size_t b = _findRoot(parent, target(*ei, _graph));
+      if (a != b)
+      {
+        parent[b] = a;
+      }
+    }
+
+    _componentIds.resize(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      _componentIds[i] = _findRoot(parent, i);
+    }
+    _componentEdgeCount = num_edges(_graph);
+  }
+
+  static size_t _findRoot(vector<size_t>& parent, size_t i)
+  {
+    while (parent[i] != i)
+    {
+      // path halving keeps the find nearly constant time
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  }
+
   VertexId _addVertex(const SchemaVertex& v)
   {
     VertexId vid = add_vertex(v, _graph);
@@ -1811,8 +2096,9 @@ bool OsmSchema::isMultiLineString(const Relation& r) const
 bool OsmSchema::isOneWay(const Element& e) const
 {
   bool result = false;
-  QString oneway = e.getTags()["oneway"].toLower();
-  if (e.getTags().isTrue("oneway") || oneway == "-1" || oneway == "reverse")
+  const QString& oneway = e.getTags().getRef("oneway");
+  if (e.getTags().isTrue("oneway") || oneway == "-1" ||
+      oneway.compare("reverse", Qt::CaseInsensitive) == 0)
   {
     result = true;
   }
@@ -1824,7 +2110,7 @@ bool OsmSchema::hasName(const Element& element) const
   const QStringList names = element.getTags().getNames();
   for (int i = 0; i < names.size(); i++)
   {
-    if (!element.getTags().get("name").trimmed().isEmpty())
+    if (!element.getTags().getRef("name").trimmed().isEmpty())
     {
       return true;
     }
@@ -1849,14 +2135,90 @@ bool OsmSchema::isPoi(const Element& e)
 bool OsmSchema::isReversed(const Element& e) const
 {
   bool result = false;
-  QString oneway = e.getTags()["oneway"].toLower();
-  if (oneway == "-1" || oneway == "reverse")
+  const QString& oneway = e.getTags().getRef("oneway");
+  if (oneway == "-1" || oneway.compare("reverse", Qt::CaseInsensitive) == 0)
   {
     result = true;
   }
   return result;
 }
 
+namespace
+{
+  const quint32 SCHEMA_CACHE_MAGIC = 0x48534348; // "HSCH"
+  // bump this when the binary layout of the cache changes so stale caches are rebuilt.
+  const quint32 SCHEMA_CACHE_VERSION = 2;
+
+  QByteArray schemaFileHash(const QString& path)
+  {
+    QFile f(path);
+    if (f.open(QIODevice::ReadOnly) == false)
+    {
+      return QByteArray();
+    }
+    return QCryptographicHash::hash(f.readAll(), QCryptographicHash::Sha1);
+  }
+}
+
+bool OsmSchema::_loadBinaryCache(const QString& path)
+{
+  QFile f(path);
+  if (f.open(QIODevice::ReadOnly) == false)
+  {
+    return false;
+  }
+
+  QDataStream ds(&f);
+  ds.setVersion(QDataStream::Qt_4_0);
+
+  quint32 magic = 0, version = 0;
+  ds >> magic >> version;
+  if (magic != SCHEMA_CACHE_MAGIC || version != SCHEMA_CACHE_VERSION)
+  {
+    return false;
+  }
+
+  // the cache is only usable if every schema file it was built from is unchanged.
+  quint32 dependencyCount = 0;
+  ds >> dependencyCount;
+  if (ds.status() != QDataStream::Ok)
+  {
+    return false;
+  }
+  for (quint32 i = 0; i < dependencyCount; ++i)
+  {
+    QString dependencyPath;
+    QByteArray storedHash;
+    ds >> dependencyPath >> storedHash;
+    if (ds.status() != QDataStream::Ok || schemaFileHash(dependencyPath) != storedHash)
+    {
+      return false;
+    }
+  }
+
+  try
+  {
+    d->readBinary(ds);
+  }
+  catch (const HootException& e)
+  {
+    LOG_WARN("Discarding corrupt schema cache " << path << " (" << e.getWhat() << ")");
+    delete d;
+    d = new OsmSchemaData();
+    return false;
+  }
+
+  if (ds.status() != QDataStream::Ok)
+  {
+    delete d;
+    d = new OsmSchemaData();
+    return false;
+  }
+
+  LOG_DEBUG("Loaded schema from binary cache: " << path);
+  return true;
+}
+
 void OsmSchema::loadDefault()
 {
   QString path = ConfPath::search("schema.json");
@@ -1864,8 +2226,66 @@ void OsmSchema::loadDefault()
   delete d;
   d = new OsmSchemaData();
 
+  const QString cachePath = ConfigOptions().getSchemaCachePath();
+  if (cachePath.isEmpty() == false && _loadBinaryCache(cachePath))
+  {
+    return;
+  }
+
   LOG_INFO("Loading translation files...");
-  OsmSchemaLoaderFactory::getInstance().createLoader(path)->load(path, *this);
+  boost::shared_ptr<OsmSchemaLoader> loader =
+    OsmSchemaLoaderFactory::getInstance().createLoader(path);
+  loader->load(path, *this);
+
+  if (cachePath.isEmpty() == false)
+  {
+    _saveBinaryCache(cachePath, loader->getDependencies());
+  }
+}
+
+void OsmSchema::_saveBinaryCache(const QString& path, const set<QString>& dependencies)
+{
+  QDir().mkpath(QFileInfo(path).path());
+
+  // write to a temporary file and rename it into place so a concurrently starting process never
+  // reads a partial cache. If two processes race here the loser's rename fails harmlessly and
+  // both end up with a complete cache.
+  QFile f(path + ".tmp");
+  if (f.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+  {
+    LOG_WARN("Unable to write schema cache: " << path);
+    return;
+  }
+
+  if (ConfigOptions().getSchemaCachePrecomputeScores())
+  {
+    LOG_INFO("Precomputing schema similarity scores...");
+    d->precomputeScores();
+  }
+
+  QDataStream ds(&f);
+  ds.setVersion(QDataStream::Qt_4_0);
+  ds << SCHEMA_CACHE_MAGIC << SCHEMA_CACHE_VERSION;
+
+  ds << (quint32)dependencies.size();
+  for (set<QString>::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it)
+  {
+    ds << *it << schemaFileHash(*it);
+  }
+
+  d->writeBinary(ds);
+  f.close();
+
+  QFile::remove(path);
+  if (f.rename(path) == false)
+  {
+    LOG_WARN("Unable to write schema cache: " << path);
+  }
+}
+
+void OsmSchema::precomputeScores()
+{
+  d->precomputeScores();
 }
 
 double OsmSchema::score(const QString& kvp1, const QString& kvp2)
@@ -1884,6 +2304,11 @@ double OsmSchema::scoreOneWay(const QString& kvp1, const QString& kvp2)
   return d->score(kvp1, kvp2);
 }
 
+uint64_t OsmSchema::getTypeSignature(const Tags& t)
+{
+  return d->getTypeSignature(t);
+}
+
 void OsmSchema::setIsACost(double cost)
 {
   d->setIsACost(cost);
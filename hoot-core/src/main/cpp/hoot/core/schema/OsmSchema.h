@@ -37,6 +37,7 @@
 #include <QString>
 
 // Standard
+#include <set>
 #include <stdint.h>
 #include <vector>
 
@@ -425,9 +426,21 @@ public:
 
   /**
    * Loads the default configuration. This should only be used by unit tests.
+   *
+   * If schema.cache.path is set, a binary serialization of the built schema graph is kept at
+   * that path and loaded in place of the schema files when it is up to date. See
+   * _loadBinaryCache.
    */
   void loadDefault();
 
+  /**
+   * Calculates the similarity score rows for every vertex up front so subsequent score() calls
+   * are table lookups instead of graph traversals. The precomputed rows are included when the
+   * binary schema cache is written (see schema.cache.precompute.scores). This is expensive and
+   * intended for offline cache builds; score() computes and caches rows on demand otherwise.
+   */
+  void precomputeScores();
+
   double score(const QString& kvp1, const QString& kvp2);
   double score(const SchemaVertex& v1, const SchemaVertex& v2);
 
@@ -437,6 +450,16 @@ public:
    */
   double scoreOneWay(const QString& kvp1, const QString& kvp2);
 
+  /**
+   * Returns a compact signature of the schema graph components the tags' type kvps fall in;
+   * each recognized kvp sets the bit of its connected component. If two signatures share no
+   * bits then no kvp pair between the two tag sets can score above zero, so callers comparing
+   * many elements can reject incompatible pairs with a single bitwise and before walking the
+   * graph. Overlapping signatures only mean a non zero score is possible (components are
+   * hashed into 64 bits), so they must still be scored normally.
+   */
+  uint64_t getTypeSignature(const Tags& t);
+
   /**
    * Sets the cost when traversing up the tree to a parent node. This is useful for strict score
    * checking rather than equivalent tags.
@@ -460,6 +483,20 @@ private:
 
   /// Provide caching for isMetaData
   QHash<QString, bool> _metadataKey;
+
+  /**
+   * Attempts to load the schema graph from the binary cache at path. Returns false if the cache
+   * doesn't exist, was written by a different format version, or any of the schema files it was
+   * built from has changed since it was written (each file's hash is stored in the cache
+   * header). On failure the schema is untouched and the caller falls back to the schema files.
+   */
+  bool _loadBinaryCache(const QString& path);
+
+  /**
+   * Serializes the fully built schema graph to path along with the hashes of the schema files
+   * (dependencies) it was built from.
+   */
+  void _saveBinaryCache(const QString& path, const std::set<QString>& dependencies);
 };
 
 }
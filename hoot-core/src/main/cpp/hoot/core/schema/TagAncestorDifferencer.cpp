@@ -64,6 +64,8 @@ void TagAncestorDifferencer::setConfiguration(const Settings& conf)
   {
     throw IllegalArgumentException("Please specify a valid ancestor tag.");
   }
+  // the new ancestor changes which tags are valid so the memoized results are stale.
+  _resetCache();
 }
 
 }
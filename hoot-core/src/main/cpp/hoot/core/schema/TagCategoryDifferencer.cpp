@@ -63,6 +63,8 @@ void TagCategoryDifferencer::setConfiguration(const Settings& conf)
   {
     throw HootException("The TagCategoryDifferencer can only filter on a single category.");
   }
+  // the new category changes which tags are valid so the memoized results are stale.
+  _resetCache();
 }
 
 }
@@ -713,6 +713,16 @@ Tags TagComparator::overwriteMerge(Tags t1, Tags t2)
 {
   Tags result;
 
+  // Most merged pairs carry no names and no shared text tags, in which case the merge is a
+  // plain overwrite. Taking that path directly leaves the implicitly shared input copies
+  // untouched and skips the scratch sets and lists the general path allocates per call; this
+  // runs once per accepted match so the difference adds up.
+  if (_overwriteMergeIsTrivial(t1, t2))
+  {
+    _overwriteRemainingTags(t1, t2, result);
+    return result;
+  }
+
   // Names are merged using _mergeNames.
   mergeNames(t1, t2, result);
 
@@ -725,6 +735,34 @@ Tags TagComparator::overwriteMerge(Tags t1, Tags t2)
   return result;
 }
 
+bool TagComparator::_overwriteMergeIsTrivial(const Tags& t1, const Tags& t2)
+{
+  OsmSchema& schema = OsmSchema::getInstance();
+
+  for (Tags::const_iterator it = t1.begin(); it != t1.end(); ++it)
+  {
+    if (it.key() == "alt_name" || schema.isAncestor(it.key(), "abstract_name"))
+    {
+      return false;
+    }
+    // a text tag only needs the list concatenation treatment when both sides carry it.
+    if (schema.getTagVertex(it.key()).valueType == Text && t2.contains(it.key()))
+    {
+      return false;
+    }
+  }
+
+  for (Tags::const_iterator it = t2.begin(); it != t2.end(); ++it)
+  {
+    if (it.key() == "alt_name" || schema.isAncestor(it.key(), "abstract_name"))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void TagComparator::_overwriteRemainingTags(Tags& t1, Tags& t2, Tags& result)
 {
   // Add t2 tags
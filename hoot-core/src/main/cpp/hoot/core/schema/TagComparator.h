@@ -132,6 +132,13 @@ private:
    */
   void _mergeUnrecognizedTags(Tags& t1, Tags& t2, Tags& result);
 
+  /**
+   * Returns true if overwriteMerge on t1/t2 reduces to a plain overwrite: neither input carries
+   * a name or alt_name tag and no text type tag appears on both sides. In that case mergeNames
+   * and _mergeText are no-ops and can be skipped along with the scratch containers they build.
+   */
+  bool _overwriteMergeIsTrivial(const Tags& t1, const Tags& t2);
+
   /**
    * Write t2 tags to result, then write t1 tags. If there are conflicts then the t1 tags will
    * overwrite the t2 values. t1 & t2 will be cleared when this is done.
@@ -28,6 +28,10 @@
 
 #include <hoot/core/schema/OsmSchema.h>
 
+// Qt
+#include <QStringList>
+#include <QtAlgorithms>
+
 using namespace std;
 
 namespace hoot
@@ -35,6 +39,8 @@ namespace hoot
 
 TagFilteredDifferencer::TagFilteredDifferencer()
 {
+  _cacheHits = 0;
+  _cacheRequests = 0;
 }
 
 double TagFilteredDifferencer::diff(const ConstOsmMapPtr&, const ConstElementPtr& e1,
@@ -45,23 +51,59 @@ double TagFilteredDifferencer::diff(const ConstOsmMapPtr&, const ConstElementPtr
   vector<SchemaVertex> v1 = schema.getUniqueSchemaVertices(e1->getTags());
   vector<SchemaVertex> v2 = schema.getUniqueSchemaVertices(e2->getTags());
 
-  double result = 1;
-
+  // only the vertices that pass the filter contribute to the result, so two elements with
+  // different irrelevant tags (names, etc.) still share a cache entry.
+  vector<const SchemaVertex*> f1, f2;
+  QStringList n1, n2;
   for (size_t i = 0; i < v1.size(); ++i)
   {
     if (isValidTag(v1[i]))
     {
-      for (size_t j = 0; j < v2.size(); ++j)
-      {
-        if (isValidTag(v2[j]))
-        {
-          result = min(1 - schema.score(v1[i], v2[j]), result);
-        }
-      }
+      f1.push_back(&v1[i]);
+      n1.append(v1[i].name);
+    }
+  }
+  for (size_t j = 0; j < v2.size(); ++j)
+  {
+    if (isValidTag(v2[j]))
+    {
+      f2.push_back(&v2[j]);
+      n2.append(v2[j].name);
+    }
+  }
+
+  qSort(n1);
+  qSort(n2);
+  QString key = n1.join(";") + "\n" + n2.join(";");
+
+  _cacheRequests++;
+  QHash<QString, double>::const_iterator cit = _cache.find(key);
+  if (cit != _cache.end())
+  {
+    _cacheHits++;
+    return cit.value();
+  }
+
+  double result = 1;
+
+  for (size_t i = 0; i < f1.size(); ++i)
+  {
+    for (size_t j = 0; j < f2.size(); ++j)
+    {
+      result = min(1 - schema.score(*f1[i], *f2[j]), result);
     }
   }
 
+  _cache.insert(key, result);
+
   return result;
 }
 
+void TagFilteredDifferencer::_resetCache()
+{
+  _cache.clear();
+  _cacheHits = 0;
+  _cacheRequests = 0;
+}
+
 }
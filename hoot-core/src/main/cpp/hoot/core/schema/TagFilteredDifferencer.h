@@ -29,6 +29,9 @@
 
 #include "TagDifferencer.h"
 
+// Qt
+#include <QHash>
+
 namespace hoot
 {
 
@@ -43,9 +46,32 @@ public:
   virtual double diff(const ConstOsmMapPtr& map, const ConstElementPtr& e1,
     const ConstElementPtr& e2) const;
 
+  /**
+   * Returns the number of diff calls that were answered from the memoized results and the total
+   * number of diff calls. The result of a diff depends only on the filtered schema vertices of
+   * the two elements, so elements with the same tag signature (e.g. thousands of plain
+   * highway=residential ways) resolve to a single cached entry.
+   */
+  long getCacheHits() const { return _cacheHits; }
+  long getCacheRequests() const { return _cacheRequests; }
+
 protected:
 
   virtual bool isValidTag(const SchemaVertex& sv) const = 0;
+
+  /**
+   * Discards all memoized results. Derived classes must call this if the behavior of isValidTag
+   * changes after construction (e.g. reconfiguration).
+   */
+  void _resetCache();
+
+private:
+
+  // memoized results keyed on the pair of filtered vertex name signatures. Mutable so diff can
+  // stay const to callers -- the cache never changes the observable result.
+  mutable QHash<QString, double> _cache;
+  mutable long _cacheHits;
+  mutable long _cacheRequests;
 };
 
 }
@@ -0,0 +1,121 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "TagKeyInterner.h"
+
+// Hoot
+#include <hoot/core/schema/OsmSchema.h>
+
+namespace hoot
+{
+
+TagKeyInterner* TagKeyInterner::_theInstance = 0;
+
+TagKeyInterner& TagKeyInterner::getInstance()
+{
+  if (_theInstance == 0)
+  {
+    _theInstance = new TagKeyInterner();
+  }
+  return *_theInstance;
+}
+
+TagKeyInterner::TagKeyInterner() :
+  _loaded(false),
+  _loading(false)
+{
+}
+
+QString TagKeyInterner::intern(const QString& key)
+{
+  if (!_loaded)
+  {
+    if (_loading)
+    {
+      return key;
+    }
+    _load();
+  }
+
+  QHash<QString, int>::const_iterator it = _keyToId.find(key);
+  if (it == _keyToId.end())
+  {
+    return key;
+  }
+  return _keys[it.value()];
+}
+
+int TagKeyInterner::getKeyId(const QString& key)
+{
+  if (!_loaded)
+  {
+    if (_loading)
+    {
+      return -1;
+    }
+    _load();
+  }
+
+  QHash<QString, int>::const_iterator it = _keyToId.find(key);
+  if (it == _keyToId.end())
+  {
+    return -1;
+  }
+  return it.value();
+}
+
+int TagKeyInterner::getKeyCount()
+{
+  if (!_loaded && !_loading)
+  {
+    _load();
+  }
+  return _keys.size();
+}
+
+void TagKeyInterner::_load()
+{
+  _loading = true;
+
+  QSet<QString> keys = OsmSchema::getInstance().getAllTagKeys();
+  // common metadata keys that aren't part of the schema graph, but show up on most elements.
+  keys.insert("name");
+  keys.insert("uuid");
+  keys.insert("note");
+  keys.insert("source");
+
+  _keys.reserve(keys.size());
+  for (QSet<QString>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+  {
+    _keyToId.insert(*it, _keys.size());
+    _keys.append(*it);
+  }
+
+  _loading = false;
+  _loaded = true;
+}
+
+}
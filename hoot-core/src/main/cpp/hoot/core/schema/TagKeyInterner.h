@@ -0,0 +1,90 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef TAGKEYINTERNER_H
+#define TAGKEYINTERNER_H
+
+// Qt
+#include <QHash>
+#include <QString>
+
+namespace hoot
+{
+
+/**
+ * Interns the tag keys the schema already knows about (e.g. highway, name) so that every Tags
+ * instance holding a common key shares one QString buffer instead of allocating its own copy.
+ *
+ * Tag churn during translation and merging allocates a fresh QString per key even though the vast
+ * majority of keys come from a vocabulary of roughly a thousand strings. Interning turns those
+ * allocations into an implicit-sharing reference count bump, and comparing two interned keys
+ * short-circuits on the shared buffer before any character comparison.
+ *
+ * Keys outside the schema vocabulary are passed through untouched, so the pool can't grow without
+ * bound on dirty data.
+ */
+class TagKeyInterner
+{
+public:
+
+  static TagKeyInterner& getInstance();
+
+  /**
+   * Returns the canonical shared instance of the given key, or the key unchanged if it isn't in
+   * the interned vocabulary.
+   */
+  QString intern(const QString& key);
+
+  /**
+   * Returns a small dense id for an interned key, or -1 if the key isn't in the vocabulary. Ids
+   * are stable for the life of the process, which makes them suitable for building integer keyed
+   * lookup tables over common tag keys.
+   */
+  int getKeyId(const QString& key);
+
+  /**
+   * The number of keys in the interned vocabulary.
+   */
+  int getKeyCount();
+
+private:
+
+  static TagKeyInterner* _theInstance;
+
+  bool _loaded;
+  // guards against reentrant initialization; loading the schema itself manipulates tags.
+  bool _loading;
+  QHash<QString, int> _keyToId;
+  QList<QString> _keys;
+
+  TagKeyInterner();
+
+  void _load();
+};
+
+}
+
+#endif // TAGKEYINTERNER_H
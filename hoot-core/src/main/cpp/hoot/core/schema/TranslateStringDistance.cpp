@@ -31,16 +31,30 @@
 #include <hoot/core/algorithms/Translator.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/visitors/UniqueNamesVisitor.h>
 
 // Qt
+#include <QFuture>
+#include <QList>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+// Standard
+#include <algorithm>
 
 namespace hoot
 {
 
 HOOT_FACTORY_REGISTER(StringDistance, TranslateStringDistance)
 
+QMutex TranslateStringDistance::_cacheMutex;
+// sized for roughly the unique name count of a large city extract; at ~100 bytes a name the
+// cache tops out around 10MB.
+Tgs::LruCache<QString, QStringList> TranslateStringDistance::_translationCache(100000);
+
 TranslateStringDistance::TranslateStringDistance(StringDistance *d)
 {
   _d.reset(d);
@@ -49,20 +63,8 @@ TranslateStringDistance::TranslateStringDistance(StringDistance *d)
 
 double TranslateStringDistance::compare(const QString& s1, const QString& s2) const
 {
-  QStringList t1;
-  QStringList t2;
-  if (_tokenize)
-  {
-    t1 = Translator::getInstance().toEnglishAll(s1);
-    t2 = Translator::getInstance().toEnglishAll(s2);
-  }
-  else
-  {
-    t1.append(s1);
-    t2.append(s2);
-    t1 = Translator::getInstance().toEnglishAll(t1);
-    t2 = Translator::getInstance().toEnglishAll(t2);
-  }
+  QStringList t1 = _toEnglishAllCached(s1, _tokenize);
+  QStringList t2 = _toEnglishAllCached(s2, _tokenize);
 
   double bestScore = -1;
   QString best1, best2;
@@ -86,6 +88,111 @@ double TranslateStringDistance::compare(const QString& s1, const QString& s2) co
   return bestScore;
 }
 
+void TranslateStringDistance::preTranslateNames(const ConstOsmMapPtr& map)
+{
+  const bool tokenize = ConfigOptions().getTranslateStringDistanceTokenize();
+
+  UniqueNamesVisitor v;
+  map->visitRo(v);
+  QStringList names = QStringList::fromSet(v.getUniqueNames());
+  if (names.size() == 0)
+  {
+    return;
+  }
+
+  // deal the names out to one chunk per thread and translate the chunks concurrently. The
+  // workers only touch the shared cache under the lock, so they spend their time in ICU.
+  const int threads = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+  QList<QStringList> chunks;
+  for (int i = 0; i < threads; i++)
+  {
+    chunks.append(QStringList());
+  }
+  for (int i = 0; i < names.size(); i++)
+  {
+    chunks[i % threads].append(names[i]);
+  }
+
+  QList< QFuture<void> > futures;
+  for (int i = 0; i < chunks.size(); i++)
+  {
+    futures.append(QtConcurrent::run(&TranslateStringDistance::_preTranslateWorker, chunks[i],
+      tokenize));
+  }
+  for (int i = 0; i < futures.size(); i++)
+  {
+    futures[i].waitForFinished();
+  }
+}
+
+void TranslateStringDistance::_preTranslateWorker(const QStringList& names, bool tokenize)
+{
+  // each worker owns a translator; the shared singleton isn't thread safe.
+  Translator translator;
+
+  for (int i = 0; i < names.size(); i++)
+  {
+    // skip names another worker or an earlier run already translated.
+    const QString key = QString(tokenize ? "t\x1f" : "w\x1f") + names[i];
+    {
+      QMutexLocker locker(&_cacheMutex);
+      QStringList tmp;
+      if (_translationCache.get(key, tmp))
+      {
+        continue;
+      }
+    }
+
+    QStringList translated;
+    if (tokenize)
+    {
+      translated = translator.toEnglishAll(names[i]);
+    }
+    else
+    {
+      QStringList l;
+      l.append(names[i]);
+      translated = translator.toEnglishAll(l);
+    }
+
+    QMutexLocker locker(&_cacheMutex);
+    QStringList tmp;
+    if (_translationCache.get(key, tmp) == false)
+    {
+      _translationCache.insert(key, translated);
+    }
+  }
+}
+
+QStringList TranslateStringDistance::_toEnglishAllCached(const QString& s, bool tokenize)
+{
+  // the tokenized and whole string translations of a name can differ, so each gets its own
+  // entry. Names won't contain the unit separator, which makes the key unambiguous.
+  const QString key = QString(tokenize ? "t\x1f" : "w\x1f") + s;
+
+  QMutexLocker locker(&_cacheMutex);
+  QStringList result;
+  if (_translationCache.get(key, result))
+  {
+    return result;
+  }
+
+  // the translator singleton isn't thread safe, so the translation happens under the lock too.
+  if (tokenize)
+  {
+    result = Translator::getInstance().toEnglishAll(s);
+  }
+  else
+  {
+    QStringList l;
+    l.append(s);
+    result = Translator::getInstance().toEnglishAll(l);
+  }
+  _translationCache.insert(key, result);
+
+  return result;
+}
+
 void TranslateStringDistance::setConfiguration(const Settings& conf)
 {
   ConfigOptions c(conf);
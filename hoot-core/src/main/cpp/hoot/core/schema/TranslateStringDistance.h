@@ -28,10 +28,16 @@
 #define TRANSLATESTRINGDISTANCE_H
 
 // hoot
+#include <hoot/core/OsmMap.h>
 #include <hoot/core/algorithms/StringDistanceConsumer.h>
 #include <hoot/core/util/Configurable.h>
 
+// Qt
+#include <QMutex>
+#include <QStringList>
+
 // tgs
+#include <tgs/LruCache.h>
 #include <tgs/SharedPtr.h>
 
 namespace hoot
@@ -61,6 +67,13 @@ public:
    */
   virtual double compare(const QString& s1, const QString& s2) const;
 
+  /**
+   * Translates every name in the map into the process wide translation cache using worker
+   * threads, so transliteration is already memoized when matching starts. Each worker owns its
+   * own Translator instance since the shared singleton isn't thread safe.
+   */
+  static void preTranslateNames(const ConstOsmMapPtr& map);
+
   virtual void setConfiguration(const Settings& conf);
 
   virtual QString toString() const { return "Translate " + _d->toString(); }
@@ -68,6 +81,17 @@ public:
 private:
   StringDistancePtr _d;
   bool _tokenize;
+
+  /**
+   * Returns the translation set for s, memoized in _translationCache. A name translates the same
+   * way no matter which matcher asks, so the cache is process wide.
+   */
+  static QStringList _toEnglishAllCached(const QString& s, bool tokenize);
+
+  static void _preTranslateWorker(const QStringList& names, bool tokenize);
+
+  static QMutex _cacheMutex;
+  static Tgs::LruCache<QString, QStringList> _translationCache;
 };
 
 }
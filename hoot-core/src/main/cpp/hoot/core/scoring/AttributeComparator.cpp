@@ -38,6 +38,10 @@
 #include <hoot/core/schema/TagComparator.h>
 #include <hoot/core/util/Log.h>
 
+// Qt
+#include <QStringList>
+#include <QtAlgorithms>
+
 // TGS
 #include <tgs/Statistics/Random.h>
 
@@ -51,6 +55,9 @@ AttributeComparator::AttributeComparator(boost::shared_ptr<OsmMap> map1, boost::
   BaseComparator(map1, map2)
 {
   _iterations = 10;
+  _exact = false;
+  _maxError = -1.0;
+  _seed = -1;
 }
 
 double AttributeComparator::compareMaps()
@@ -63,6 +70,13 @@ double AttributeComparator::compareMaps()
   double oldIsACost = OsmSchema::getInstance().getIsACost();
   OsmSchema::getInstance().setIsACost(0.5);
 
+  if (_exact)
+  {
+    double result = _compareExact();
+    OsmSchema::getInstance().setIsACost(oldIsACost);
+    return result;
+  }
+
   vector<double> scores;
   // sampled standard deviation
   _s = -1;
@@ -75,14 +89,27 @@ double AttributeComparator::compareMaps()
   // do this a bunch of times
   for (int i = 0; i < _iterations * 4 && (int)scores.size() < _iterations; i++)
   {
+    // when seeded, each sample draws from its own stream derived from the seed and the sample
+    // index, so the samples could be scored in any order (or concurrently) without changing the
+    // result.
+    boost::shared_ptr<Random> rng;
+    if (_seed >= 0)
+    {
+      rng = Random::stream(_seed, i);
+    }
+    else
+    {
+      rng = Random::instance();
+    }
+
     // generate a random source point
-    _r.x = Random::instance()->generateUniform() * (_projectedBounds.MaxX - _projectedBounds.MinX) +
+    _r.x = rng->generateUniform() * (_projectedBounds.MaxX - _projectedBounds.MinX) +
           _projectedBounds.MinX;
-    _r.y = Random::instance()->generateUniform() * (_projectedBounds.MaxY - _projectedBounds.MinY) +
+    _r.y = rng->generateUniform() * (_projectedBounds.MaxY - _projectedBounds.MinY) +
           _projectedBounds.MinY;
 
     // pick one map as the reference map
-    if (Random::instance()->coinToss())
+    if (rng->coinToss())
     {
       referenceMap = _mapP1;
       otherMap = _mapP2;
@@ -148,6 +175,12 @@ double AttributeComparator::compareMaps()
       cout << i << " / " << _iterations << " mean: " << _mean << "   \r";
       cout.flush();
     }
+
+    // the mean is known accurately enough; more samples just burn CPU.
+    if (_maxError >= 0.0 && _ci >= 0.0 && _ci <= _maxError)
+    {
+      break;
+    }
   }
 
   //cout << "Score count: " << scores.size() << endl;
@@ -162,4 +195,86 @@ double AttributeComparator::compareMaps()
   return _mean;
 }
 
+double AttributeComparator::_compareExact()
+{
+  double buffer = 10.0;
+  double scoreSum = 0.0;
+  vector<double> scores;
+  QHash<QString, double> cache;
+
+  // visit each way of each map once; sweeping both directions mirrors the coin toss in the
+  // sampling path.
+  _scoreWays(_mapP1, _mapP2, buffer, cache, scores, scoreSum);
+  _scoreWays(_mapP2, _mapP1, buffer, cache, scores, scoreSum);
+
+  _mean = -1;
+  _median = -1;
+  // an exhaustive sweep has no sampling variance.
+  _s = 0;
+  _ci = 0;
+
+  if (scores.size() > 0)
+  {
+    sort(scores.begin(), scores.end());
+    _median = scores[scores.size() / 2];
+    _mean = scoreSum / (double)scores.size();
+  }
+
+  return _mean;
+}
+
+void AttributeComparator::_scoreWays(boost::shared_ptr<OsmMap> referenceMap,
+  boost::shared_ptr<OsmMap> otherMap, double buffer, QHash<QString, double>& cache,
+  vector<double>& scores, double& scoreSum)
+{
+  const WayMap& ways = referenceMap->getWays();
+
+  for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+  {
+    WayPtr w1 = it->second;
+    vector<long> wids = otherMap->getIndex().findWayNeighbors(w1, buffer);
+
+    double bestScore = -1.0;
+    for (size_t k = 0; k < wids.size(); k++)
+    {
+      WayPtr w2 = otherMap->getWay(wids[k]);
+      double score = _scoreTags(w1->getTags(), w2->getTags(), cache);
+      bestScore = max(score, bestScore);
+    }
+
+    if (bestScore >= 0.0)
+    {
+      scoreSum += bestScore;
+      scores.push_back(bestScore);
+    }
+  }
+}
+
+double AttributeComparator::_scoreTags(const Tags& t1, const Tags& t2,
+  QHash<QString, double>& cache)
+{
+  QString key = _toSignature(t1) + "\n" + _toSignature(t2);
+
+  QHash<QString, double>::const_iterator it = cache.find(key);
+  if (it != cache.end())
+  {
+    return it.value();
+  }
+
+  double score = TagComparator::getInstance().compareTags(t1, t2);
+  cache.insert(key, score);
+  return score;
+}
+
+QString AttributeComparator::_toSignature(const Tags& t)
+{
+  QStringList kvps;
+  for (Tags::const_iterator it = t.begin(); it != t.end(); ++it)
+  {
+    kvps.append(it.key() + "=" + it.value());
+  }
+  qSort(kvps);
+  return kvps.join(";");
+}
+
 }
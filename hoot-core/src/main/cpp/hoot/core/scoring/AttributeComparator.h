@@ -30,9 +30,15 @@
 
 #include "BaseComparator.h"
 
+// Qt
+#include <QHash>
+
 namespace hoot
 {
 
+class Tags;
+class Way;
+
 class AttributeComparator : public BaseComparator
 {
 public:
@@ -50,10 +56,35 @@ public:
 
   double getStandardDeviation() { return _s; }
 
+  /**
+   * When enabled every way is scored against its neighbors in the other map exactly once rather
+   * than sampling random points, so the score carries no RNG variance and the confidence
+   * interval is reported as zero. Tag comparisons are memoized by tag signature, so maps full of
+   * identically tagged ways sweep quickly.
+   */
+  void setExactMode(bool exact) { _exact = exact; }
+
   void setIterations(int i) { _iterations = i; }
 
+  /**
+   * In sampling mode, stops iterating early once the 90% confidence interval drops to maxError
+   * or below. Disabled by default; setIterations still caps the number of samples.
+   */
+  void setMaxError(double maxError) { _maxError = maxError; }
+
+  /**
+   * Seeds the sampling run. Each sample then draws from its own stream derived from the seed and
+   * the sample index, so a seeded run returns the same score regardless of what else has pulled
+   * from the shared random stream or what order the samples run in. -1 (the default) keeps the
+   * legacy behavior of drawing from the shared stream.
+   */
+  void setSeed(int seed) { _seed = seed; }
+
 private:
   int _iterations;
+  bool _exact;
+  double _maxError;
+  int _seed;
   geos::geom::Coordinate _r;
   double _median;
   double _mean;
@@ -62,6 +93,15 @@ private:
   // sampled standard deviation
   double _s;
 
+  double _compareExact();
+
+  void _scoreWays(boost::shared_ptr<OsmMap> referenceMap, boost::shared_ptr<OsmMap> otherMap,
+    double buffer, QHash<QString, double>& cache, std::vector<double>& scores, double& scoreSum);
+
+  double _scoreTags(const Tags& t1, const Tags& t2, QHash<QString, double>& cache);
+
+  static QString _toSignature(const Tags& t);
+
 };
 
 }
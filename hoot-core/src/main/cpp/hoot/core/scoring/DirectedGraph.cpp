@@ -100,23 +100,62 @@ void DirectedGraph::deriveEdges(boost::shared_ptr<const OsmMap> map)
 
   for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
   {
-    const boost::shared_ptr<Way>& way = it->second;
-    double cost = determineCost(way);
-    double length = ElementConverter(map).convertToLineString(way)->getLength();
+    deriveWayEdges(it->second, map);
+  }
+}
+
+void DirectedGraph::deriveWayEdges(const boost::shared_ptr<Way>& way,
+  boost::shared_ptr<const OsmMap> map)
+{
+  double cost = determineCost(way);
+  double length = ElementConverter(map).convertToLineString(way)->getLength();
+
+  long nStart = way->getNodeId(0);
+  long nEnd = way->getNodeId(way->getNodeCount() - 1);
+  if (cost >= 0)
+  {
+    if (isOneWay(way))
+    {
+      addEdge(nStart, nEnd, cost * length);
+    }
+    else
+    {
+      addEdge(nStart, nEnd, cost * length);
+      addEdge(nEnd, nStart, cost * length);
+    }
+  }
+}
+
+void DirectedGraph::removeWayEdges(const boost::shared_ptr<Way>& way,
+  boost::shared_ptr<const OsmMap> map)
+{
+  // recompute the same values deriveWayEdges used; the inputs haven't changed so the weight
+  // matches exactly.
+  double cost = determineCost(way);
+  double length = ElementConverter(map).convertToLineString(way)->getLength();
 
-    long nStart = way->getNodeId(0);
-    long nEnd = way->getNodeId(way->getNodeCount() - 1);
-    if (cost >= 0)
+  long nStart = way->getNodeId(0);
+  long nEnd = way->getNodeId(way->getNodeCount() - 1);
+  if (cost >= 0)
+  {
+    _removeEdge(nStart, nEnd, cost * length);
+    if (isOneWay(way) == false)
+    {
+      _removeEdge(nEnd, nStart, cost * length);
+    }
+  }
+}
+
+void DirectedGraph::_removeEdge(long from, long to, double weight)
+{
+  // remove a single instance so parallel edges from duplicate ways are left alone.
+  for (QMultiHash<long, Edge>::iterator it = _edges.find(from);
+    it != _edges.end() && it.key() == from; ++it)
+  {
+    if (it.value().to == to && it.value().weight == weight)
     {
-      if (isOneWay(way))
-      {
-        addEdge(nStart, nEnd, cost * length);
-      }
-      else
-      {
-        addEdge(nStart, nEnd, cost * length);
-        addEdge(nEnd, nStart, cost * length);
-      }
+      _edges.erase(it);
+      return;
     }
   }
 }
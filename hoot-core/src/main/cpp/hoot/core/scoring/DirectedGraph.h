@@ -71,6 +71,19 @@ public:
    */
   void deriveEdges(boost::shared_ptr<const OsmMap> map);
 
+  /**
+   * Adds the edges for a single way. Combined with removeWayEdges this supports applying a small
+   * delta (e.g. one way split at a point) to an already derived graph rather than rederiving
+   * every edge.
+   */
+  void deriveWayEdges(const boost::shared_ptr<Way>& way, boost::shared_ptr<const OsmMap> map);
+
+  /**
+   * Removes the edges that deriveWayEdges added for the given way. The way must still describe
+   * the same nodes it did when the edges were derived.
+   */
+  void removeWayEdges(const boost::shared_ptr<Way>& way, boost::shared_ptr<const OsmMap> map);
+
   const QMultiHash<long, Edge>& getEdges() const { return _edges; }
 
   /**
@@ -85,6 +98,10 @@ protected:
   QMultiHash<long, Edge> _edges;
 
   double _mphToSecondsPerMeter(double mph) { return 2.23694 / mph; }
+
+private:
+
+  void _removeEdge(long from, long to, double weight);
 };
 
 }
@@ -73,7 +73,8 @@ GraphComparator::GraphComparator(OsmMapPtr map1, OsmMapPtr map2) :
   _init();
 }
 
-cv::Mat GraphComparator::_calculateCostDistance(OsmMapPtr map, Coordinate c)
+cv::Mat GraphComparator::_calculateCostDistance(OsmMapPtr map, Coordinate c,
+  const DirectedGraph& baseGraph)
 {
   // make a copy of the map so we can manipulate it.
   map.reset(new OsmMap(map));
@@ -82,6 +83,11 @@ cv::Mat GraphComparator::_calculateCostDistance(OsmMapPtr map, Coordinate c)
   long wId = map->getIndex().findNearestWay(c);
   WayPtr w = map->getWay(wId);
 
+  // start from the base graph and only rederive the edges that the split below invalidates --
+  // rederiving every edge per sample dominated the run time.
+  boost::shared_ptr<DirectedGraph> graph(new DirectedGraph(baseGraph));
+  graph->removeWayEdges(w, map);
+
   // split way at c
   WayLocation wl = LocationOfPoint::locate(map, w, c);
   vector<WayPtr > v = WaySplitter::split(map, w, wl);
@@ -94,9 +100,10 @@ cv::Mat GraphComparator::_calculateCostDistance(OsmMapPtr map, Coordinate c)
   }
   assert(wl.isNode() == true);
 
-  // populate graph
-  boost::shared_ptr<DirectedGraph> graph(new DirectedGraph());
-  graph->deriveEdges(map);
+  for (size_t i = 0; i < v.size(); i++)
+  {
+    graph->deriveWayEdges(v[i], map);
+  }
 
   ShortestPath sp(graph);
   // set cost at c to zero.
@@ -160,6 +167,13 @@ double GraphComparator::compareMaps()
   double zalpha = 1.645;
   _ci = -1;
 
+  // derive each map's graph once up front; each iteration below only applies the delta for the
+  // one way it splits at the sample point.
+  DirectedGraph graph1;
+  graph1.deriveEdges(_mapP1);
+  DirectedGraph graph2;
+  graph2.deriveEdges(_mapP2);
+
   // do this a bunch of times
   for (int i = 0; i < _iterations && same < 4; i++)
   {
@@ -186,8 +200,8 @@ double GraphComparator::compareMaps()
     _r = _findNearestPointOnFeature(referenceMap, _r);
 
     // generate a cost distance raster for each map
-    cv::Mat image1 = _calculateCostDistance(_mapP1, _r);
-    cv::Mat image2 = _calculateCostDistance(_mapP2, _r);
+    cv::Mat image1 = _calculateCostDistance(_mapP1, _r, graph1);
+    cv::Mat image2 = _calculateCostDistance(_mapP2, _r, graph2);
 
     // take the difference of the two rasters and normalize
     double error = _calculateError(image1, image2);
@@ -79,7 +79,8 @@ private:
   double _maxGraphCost;
   bool _debugImages;
 
-  cv::Mat _calculateCostDistance(OsmMapPtr map, geos::geom::Coordinate c);
+  cv::Mat _calculateCostDistance(OsmMapPtr map, geos::geom::Coordinate c,
+    const DirectedGraph& baseGraph);
 
   void _calculateRasterCost(cv::Mat& mat);
 
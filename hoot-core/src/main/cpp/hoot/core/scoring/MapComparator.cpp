@@ -27,13 +27,16 @@
 #include "MapComparator.h"
 
 // hoot
+#include <hoot/core/scoring/RegionHashTree.h>
 #include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/util/Log.h>
+#include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
 #include <hoot/core/visitors/ElementConstOsmMapVisitor.h>
 #include <hoot/core/OsmMap.h>
 
 // Standard
 #include <iomanip>
+#include <set>
 
 namespace hoot
 {
@@ -89,12 +92,31 @@ public:
     _errorCount = 0;
     _ignoreUUID = ignoreUUID;
     _useDateTime = useDateTime;
+    _tree = 0;
   }
 
   bool isMatch() { return _matches; }
 
+  /**
+   * Restricts the detailed comparison to the elements falling in the given regions of the test
+   * map's hash tree. Elements in regions whose hashes match are byte-identical and don't need
+   * another look.
+   */
+  void setChangedRegions(const RegionHashTree* tree, const std::set<int>& changedRegions,
+    boost::shared_ptr<const OsmMap> testMap)
+  {
+    _tree = tree;
+    _changedRegions = changedRegions;
+    _testMap = testMap;
+  }
+
   virtual void visit(const boost::shared_ptr<const Element>& e)
   {
+    if (_tree != 0 && _changedRegions.count(_tree->calculateRegion(_testMap, e)) == 0)
+    {
+      return;
+    }
+
     CHECK_MSG(_ref->containsElement(e->getElementId()), "Did not find element: " <<
               e->getElementId());
     const boost::shared_ptr<const Element>& re = _ref->getElement(e->getElementId());
@@ -224,6 +246,9 @@ private:
   bool _ignoreUUID;
   bool _useDateTime;
   int _errorCount;
+  const RegionHashTree* _tree;
+  std::set<int> _changedRegions;
+  boost::shared_ptr<const OsmMap> _testMap;
 };
 
 MapComparator::MapComparator()
@@ -242,7 +267,25 @@ bool MapComparator::isMatch(boost::shared_ptr<OsmMap> ref, boost::shared_ptr<Osm
     return false;
   }
 
+  // Merkle-style fast path: regions whose hashes match hold byte-identical elements, so the
+  // detailed (and more tolerant) comparison below only needs to walk the regions that changed.
+  geos::geom::Envelope env = CalculateMapBoundsVisitor::getGeosBounds(ref);
+  const geos::geom::Envelope testEnv = CalculateMapBoundsVisitor::getGeosBounds(test);
+  env.expandToInclude(&testEnv);
+  RegionHashTree refTree;
+  RegionHashTree testTree;
+  refTree.build(ref, env);
+  testTree.build(test, env);
+  if (refTree.getRootHash() == testTree.getRootHash())
+  {
+    return true;
+  }
+  const std::vector<int> changed = RegionHashTree::compareTrees(refTree, testTree);
+  LOG_DEBUG("Maps differ in " << changed.size() << " of " << testTree.getRegionCount() <<
+            " regions.");
+
   CompareVisitor v(ref, _ignoreUUID, _useDateTime);
+  v.setChangedRegions(&testTree, std::set<int>(changed.begin(), changed.end()), test);
   test->visitRo(v);
   bool r = v.isMatch();
 
@@ -37,6 +37,7 @@
 #include <hoot/core/schema/OsmSchema.h>
 #include <hoot/core/util/OpenCv.h>
 #include <hoot/core/filters/HighwayFilter.h>
+#include <hoot/core/util/Log.h>
 #include <hoot/core/visitors/FilteredVisitor.h>
 #include <hoot/core/visitors/ExtractWaysVisitor.h>
 
@@ -56,14 +57,78 @@ namespace hoot
 RasterComparator::RasterComparator(boost::shared_ptr<OsmMap> map1, boost::shared_ptr<OsmMap> map2) :
       BaseComparator(map1, map2)
 {
+  // roughly 800MB of transient raster data per strip at the default.
+  _maxPixels = 64l * 1024l * 1024l;
+  _earlyExitThreshold = -1.0;
+  _earlyExitMargin = -1.0;
 }
 
 double RasterComparator::compareMaps()
+{
+  if (_earlyExitMargin >= 0.0)
+  {
+    // coarse first pass; the gaussian blur keeps the score fairly stable across resolutions, so
+    // a coarse score well away from the threshold doesn't need the fine pass.
+    double finePixelSize = _pixelSize;
+    _pixelSize = finePixelSize * 4.0;
+    double coarse = _compareResolution();
+    _pixelSize = finePixelSize;
+
+    if (fabs(coarse - _earlyExitThreshold) > _earlyExitMargin)
+    {
+      LOG_DEBUG("Coarse score " << coarse << " is clearly past " << _earlyExitThreshold <<
+        ", skipping the full resolution comparison.");
+      return coarse;
+    }
+  }
+
+  return _compareResolution();
+}
+
+double RasterComparator::_compareResolution()
 {
   _updateBounds();
 
   _wayLengthSum = 0.0;
 
+  if ((long)_width * (long)_height > _maxPixels)
+  {
+    // process one row strip at a time and accumulate the error as each strip completes.
+    int pad = ceil(_sigma / _pixelSize * 3);
+    int stripRows = (int)std::max(1l, _maxPixels / _width - 2l * pad);
+
+    double errorSum = 0.0;
+    double image1Sum = 0.0;
+    double image2Sum = 0.0;
+
+    for (int y0 = 0; y0 < _height; y0 += stripRows)
+    {
+      int y1 = std::min(y0 + stripRows, _height);
+      // render enough margin that the blur sees the same neighborhood it would in a full
+      // raster; the margin rows are rendered but never accumulated.
+      int top = std::max(y0 - pad, 0);
+      int bottom = std::min(y1 + pad, _height);
+
+      cv::Mat image1, image2;
+      _renderStrip(_mapP1, image1, top, bottom - top);
+      _renderStrip(_mapP2, image2, top, bottom - top);
+
+      for (int y = y0; y < y1; y++)
+      {
+        const float* row1 = image1.ptr<float>(y - top);
+        const float* row2 = image2.ptr<float>(y - top);
+        for (int x = 0; x < _width; x++)
+        {
+          errorSum += fabs(row1[x] - row2[x]);
+          image1Sum += row1[x];
+          image2Sum += row2[x];
+        }
+      }
+    }
+
+    return 1 - errorSum / (image1Sum + image2Sum);
+  }
+
   cv::Mat image1, image2;
 
   _renderImage(_mapP1, image1);
@@ -143,7 +208,13 @@ private:
 
 void RasterComparator::_renderImage(boost::shared_ptr<OsmMap> map, cv::Mat& image)
 {
-  QImage qImage(_width, _height, QImage::Format_ARGB32);
+  _renderStrip(map, image, 0, _height);
+}
+
+void RasterComparator::_renderStrip(boost::shared_ptr<OsmMap> map, cv::Mat& image, int startRow,
+  int rows)
+{
+  QImage qImage(_width, rows, QImage::Format_ARGB32);
   QPainter pt(&qImage);
   pt.setRenderHint(QPainter::Antialiasing, false);
   pt.fillRect(pt.viewport(), Qt::black);
@@ -153,24 +224,25 @@ void RasterComparator::_renderImage(boost::shared_ptr<OsmMap> map, cv::Mat& imag
   pt.setPen(pen);
 
   GeometryPainter gp;
-  QMatrix m = gp.createMatrix(pt.viewport(), _projectedBounds);
+  // the matrix maps onto the full raster; the painter translation drops this strip's rows into
+  // the strip local image.
+  QMatrix m = gp.createMatrix(QRect(0, 0, _width, _height), _projectedBounds);
+  pt.translate(0, -startRow);
 
   PaintVisitor pv(map, gp, pt, m);
   HighwayFilter filter(HighwayFilter::KeepMatches);
   FilteredVisitor v(filter, pv);
   map->visitRo(v);
 
-  cv::Mat in(cvSize(_width, _height), CV_32FC1);
-  image = cv::Mat(cvSize(_width, _height), CV_32FC1);
+  cv::Mat in(cvSize(_width, rows), CV_32FC1);
+  image = cv::Mat(cvSize(_width, rows), CV_32FC1);
 
-  double rawSum = 0.0;
-  for (int y = 0; y < _height; y++)
+  for (int y = 0; y < rows; y++)
   {
     float* row = in.ptr<float>(y);
     for (int x = 0; x < _width; x++)
     {
       row[x] = qRed(qImage.pixel(x, y)) * _pixelSize;
-      rawSum += row[x] * _pixelSize;
     }
   }
 
@@ -53,15 +53,42 @@ public:
 
   double compareMaps();
 
+  /**
+   * Enables a coarse first pass at four times the pixel size. If the coarse score lands more
+   * than margin away from threshold the coarse score is returned and the full resolution
+   * comparison is skipped. Disabled by default.
+   */
+  void setEarlyExit(double threshold, double margin)
+  { _earlyExitThreshold = threshold; _earlyExitMargin = margin; }
+
+  /**
+   * Sets the maximum number of pixels rasterized at once per map. Comparisons bigger than this
+   * are processed one row strip at a time with the error accumulated as each strip completes, so
+   * memory stays bounded no matter how big the maps are. The debug images written by the all at
+   * once path are skipped when processing strips.
+   */
+  void setMaxPixelsInMemory(long maxPixels) { _maxPixels = maxPixels; }
+
 protected:
 
   cv::Mat _render1, _render2;
   Meters _wayLengthSum;
+  long _maxPixels;
+  double _earlyExitThreshold;
+  double _earlyExitMargin;
+
+  double _compareResolution();
 
   void _dumpImage(cv::Mat& image);
 
   void _renderImage(boost::shared_ptr<OsmMap> map, cv::Mat& result);
 
+  /**
+   * Renders and blurs rows [startRow, startRow + rows) of the full raster into a strip local
+   * image. _renderImage is the whole raster special case.
+   */
+  void _renderStrip(boost::shared_ptr<OsmMap> map, cv::Mat& result, int startRow, int rows);
+
 };
 
 }
@@ -0,0 +1,279 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "RegionHashTree.h"
+
+// Hoot
+#include <hoot/core/OsmMap.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/visitors/CalculateHashVisitor.h>
+#include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+
+// Qt
+#include <QCryptographicHash>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+
+// Standard
+#include <algorithm>
+#include <map>
+#include <memory>
+
+// Tgs
+#include <tgs/RStarTree/HilbertCurve.h>
+
+using namespace std;
+
+namespace hoot
+{
+
+RegionHashTree::RegionHashTree(int order)
+{
+  _order = order;
+  _regionCount = 1 << (2 * order);
+}
+
+void RegionHashTree::build(const boost::shared_ptr<const OsmMap>& map)
+{
+  build(map, CalculateMapBoundsVisitor::getGeosBounds(map));
+}
+
+void RegionHashTree::build(const boost::shared_ptr<const OsmMap>& map,
+  const geos::geom::Envelope& envelope)
+{
+  _envelope = envelope;
+
+  // gather the entries per region. Each entry mixes the bits the detailed comparators care
+  // about: the id, the status and the element content hash.
+  typedef std::map<ElementId, QByteArray> EntryMap;
+  vector<EntryMap> entries(_regionCount);
+
+  const NodeMap& nm = map->getNodes();
+  for (NodeMap::const_iterator it = nm.begin(); it != nm.end(); ++it)
+  {
+    ConstElementPtr e = it->second;
+    entries[calculateRegion(map, e)][e->getElementId()] =
+      QString("%1;%2;").arg(e->getId()).arg(e->getStatus().getEnum()).toUtf8() +
+      CalculateHashVisitor::toHash(e);
+  }
+  const WayMap& wm = map->getWays();
+  for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
+  {
+    ConstElementPtr e = it->second;
+    entries[calculateRegion(map, e)][e->getElementId()] =
+      QString("%1;%2;").arg(e->getId()).arg(e->getStatus().getEnum()).toUtf8() +
+      CalculateHashVisitor::toHash(e);
+  }
+  const RelationMap& rm = map->getRelations();
+  for (RelationMap::const_iterator it = rm.begin(); it != rm.end(); ++it)
+  {
+    ConstElementPtr e = it->second;
+    entries[calculateRegion(map, e)][e->getElementId()] =
+      QString("%1;%2;").arg(e->getId()).arg(e->getStatus().getEnum()).toUtf8() +
+      CalculateHashVisitor::toHash(e);
+  }
+
+  // hash each region. The entry map iterates in id order so the hash doesn't depend on the
+  // order the elements were visited in. An empty region keeps an empty hash.
+  vector<QByteArray> regionHashes(_regionCount);
+  for (int i = 0; i < _regionCount; i++)
+  {
+    if (entries[i].empty() == false)
+    {
+      QCryptographicHash hash(QCryptographicHash::Sha1);
+      for (EntryMap::const_iterator it = entries[i].begin(); it != entries[i].end(); ++it)
+      {
+        hash.addData(it->second);
+      }
+      regionHashes[i] = hash.result();
+    }
+  }
+
+  _buildLevels(regionHashes);
+}
+
+void RegionHashTree::_buildLevels(vector<QByteArray>& regionHashes)
+{
+  _levels.clear();
+  _levels.push_back(regionHashes);
+  while (_levels.back().size() > 1)
+  {
+    const vector<QByteArray>& below = _levels.back();
+    vector<QByteArray> level(below.size() / 2);
+    for (size_t i = 0; i < level.size(); i++)
+    {
+      QCryptographicHash hash(QCryptographicHash::Sha1);
+      hash.addData(below[2 * i]);
+      hash.addData(below[2 * i + 1]);
+      level[i] = hash.result();
+    }
+    _levels.push_back(level);
+  }
+}
+
+int RegionHashTree::calculateRegion(const boost::shared_ptr<const OsmMap>& map,
+  const ConstElementPtr& e) const
+{
+  double x, y;
+  if (e->getElementType() == ElementType::Node)
+  {
+    ConstNodePtr n = boost::dynamic_pointer_cast<const Node>(e);
+    x = n->getX();
+    y = n->getY();
+  }
+  else
+  {
+    auto_ptr<geos::geom::Envelope> env(e->getEnvelope(map));
+    if (env->isNull())
+    {
+      return 0;
+    }
+    x = (env->getMinX() + env->getMaxX()) / 2.0;
+    y = (env->getMinY() + env->getMaxY()) / 2.0;
+  }
+
+  const int n = 1 << _order;
+  const double w = std::max(_envelope.getWidth(), 1e-9);
+  const double h = std::max(_envelope.getHeight(), 1e-9);
+  int point[2];
+  point[0] = std::min(n - 1, std::max(0, (int)((x - _envelope.getMinX()) / w * n)));
+  point[1] = std::min(n - 1, std::max(0, (int)((y - _envelope.getMinY()) / h * n)));
+
+  // elements near each other in space stay near each other in region order, which keeps a
+  // localized edit confined to a small contiguous run of regions.
+  Tgs::HilbertCurve curve(2, _order);
+  return (int)curve.encode(point);
+}
+
+vector<int> RegionHashTree::compareTrees(const RegionHashTree& t1, const RegionHashTree& t2)
+{
+  vector<int> changed;
+
+  if (t1._levels.empty() || t2._levels.empty())
+  {
+    throw HootException("Both trees must be built before comparing them.");
+  }
+  if (t1._order != t2._order || t1._envelope.equals(&t2._envelope) == false)
+  {
+    // different grids aren't comparable region by region.
+    for (int i = 0; i < std::max(t1._regionCount, t2._regionCount); i++)
+    {
+      changed.push_back(i);
+    }
+    return changed;
+  }
+
+  _compare(t1, t2, t1._levels.size() - 1, 0, changed);
+  return changed;
+}
+
+void RegionHashTree::_compare(const RegionHashTree& t1, const RegionHashTree& t2, size_t level,
+  size_t i, vector<int>& changed)
+{
+  if (t1._levels[level][i] == t2._levels[level][i])
+  {
+    return;
+  }
+  if (level == 0)
+  {
+    changed.push_back((int)i);
+    return;
+  }
+  _compare(t1, t2, level - 1, 2 * i, changed);
+  _compare(t1, t2, level - 1, 2 * i + 1, changed);
+}
+
+QByteArray RegionHashTree::getRootHash() const
+{
+  if (_levels.empty())
+  {
+    return QByteArray();
+  }
+  return _levels.back()[0];
+}
+
+void RegionHashTree::read(QString path)
+{
+  QFile f(path);
+  if (f.open(QFile::ReadOnly) == false)
+  {
+    throw HootException("Error opening file for reading: " + path);
+  }
+  QTextStream ts(&f);
+
+  if (ts.readLine() != "HOOT_REGION_HASH_TREE 1")
+  {
+    throw HootException("Unexpected header in: " + path);
+  }
+  _order = ts.readLine().toInt();
+  _regionCount = 1 << (2 * _order);
+
+  QStringList env = ts.readLine().split(" ");
+  if (env.size() != 4)
+  {
+    throw HootException("Unexpected envelope line in: " + path);
+  }
+  _envelope = geos::geom::Envelope(env[0].toDouble(), env[2].toDouble(), env[1].toDouble(),
+    env[3].toDouble());
+
+  // only the region hashes are stored; the levels above are derived.
+  vector<QByteArray> regionHashes(_regionCount);
+  for (int i = 0; i < _regionCount; i++)
+  {
+    regionHashes[i] = QByteArray::fromHex(ts.readLine().toAscii());
+  }
+  _buildLevels(regionHashes);
+}
+
+void RegionHashTree::write(QString path) const
+{
+  if (_levels.empty())
+  {
+    throw HootException("The tree must be built before it is written.");
+  }
+
+  QFile f(path);
+  if (f.open(QFile::WriteOnly | QFile::Truncate) == false)
+  {
+    throw HootException("Error opening file for writing: " + path);
+  }
+  QTextStream ts(&f);
+
+  ts << "HOOT_REGION_HASH_TREE 1" << endl;
+  ts << _order << endl;
+  ts << QString::number(_envelope.getMinX(), 'g', 16) << " "
+     << QString::number(_envelope.getMinY(), 'g', 16) << " "
+     << QString::number(_envelope.getMaxX(), 'g', 16) << " "
+     << QString::number(_envelope.getMaxY(), 'g', 16) << endl;
+  for (int i = 0; i < _regionCount; i++)
+  {
+    ts << QString::fromAscii(_levels[0][i].toHex()) << endl;
+  }
+}
+
+}
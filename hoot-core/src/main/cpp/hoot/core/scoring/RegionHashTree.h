@@ -0,0 +1,129 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef REGIONHASHTREE_H
+#define REGIONHASHTREE_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// GEOS
+#include <geos/geom/Envelope.h>
+
+// Hoot
+#include <hoot/core/elements/Element.h>
+
+// Qt
+#include <QByteArray>
+#include <QString>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+class OsmMap;
+
+/**
+ * A Merkle-style hash tree over a spatial partition of a map.
+ *
+ * The map's envelope is divided into a regular grid of regions ordered along a Hilbert curve,
+ * each element is hashed into the region its geometry falls in, and the region hashes are
+ * combined pairwise up to a single root hash. Two maps built over the same grid can then be
+ * compared in time proportional to the number of regions that actually changed: equal subtree
+ * hashes prune whole branches, and the root hash alone is a cheap whole-map fingerprint for
+ * cache validation and golden-file checks.
+ *
+ * The tree can be persisted to a small sidecar file so a later run can diff a fresh map against
+ * a stored fingerprint without re-reading the original data.
+ */
+class RegionHashTree
+{
+public:
+
+  /**
+   * @param order The grid is 2^order by 2^order regions.
+   */
+  RegionHashTree(int order = 4);
+
+  /**
+   * Builds the tree over the map's own envelope.
+   */
+  void build(const boost::shared_ptr<const OsmMap>& map);
+
+  /**
+   * Builds the tree over the given envelope. Two trees are only comparable region by region if
+   * they were built over the same envelope and order.
+   */
+  void build(const boost::shared_ptr<const OsmMap>& map, const geos::geom::Envelope& envelope);
+
+  /**
+   * Returns the region index the element falls in on this tree's grid.
+   */
+  int calculateRegion(const boost::shared_ptr<const OsmMap>& map, const ConstElementPtr& e) const;
+
+  /**
+   * Returns the indexes of the regions whose hashes differ, pruning subtrees whose hashes match.
+   * Trees built over different envelopes or orders aren't comparable region by region, so in
+   * that case all regions are reported as changed.
+   */
+  static std::vector<int> compareTrees(const RegionHashTree& t1, const RegionHashTree& t2);
+
+  const geos::geom::Envelope& getEnvelope() const { return _envelope; }
+
+  int getRegionCount() const { return _regionCount; }
+
+  /**
+   * Returns the root hash, a fingerprint of the whole map. Empty until build() or read() is
+   * called.
+   */
+  QByteArray getRootHash() const;
+
+  /**
+   * Reads a tree previously written with write().
+   */
+  void read(QString path);
+
+  void write(QString path) const;
+
+private:
+
+  int _order;
+  int _regionCount;
+  geos::geom::Envelope _envelope;
+  /// _levels[0] holds the region hashes; each level above combines pairs up to the root.
+  std::vector< std::vector<QByteArray> > _levels;
+
+  void _buildLevels(std::vector<QByteArray>& regionHashes);
+
+  static void _compare(const RegionHashTree& t1, const RegionHashTree& t2, size_t level, size_t i,
+    std::vector<int>& changed);
+};
+
+}
+
+#endif // REGIONHASHTREE_H
@@ -29,6 +29,11 @@
 
 #include "DirectedGraph.h"
 
+// Standard
+#include <vector>
+
+using namespace std;
+
 namespace hoot
 {
 
@@ -41,29 +46,97 @@ void ShortestPath::calculateCost()
 {
   assert(_queue.empty() == true);
 
+  const QMultiHash<long, DirectedGraph::Edge>& edges = _graph->getEdges();
+
+  // index the node ids into a dense range so the inner loop works against flat arrays rather
+  // than paying a hash lookup per edge relaxation.
+  QHash<long, int> nodeToIndex;
+  vector<long> indexToNode;
+  for (QMultiHash<long, DirectedGraph::Edge>::const_iterator it = edges.begin();
+    it != edges.end(); ++it)
+  {
+    if (nodeToIndex.contains(it.value().from) == false)
+    {
+      nodeToIndex.insert(it.value().from, (int)indexToNode.size());
+      indexToNode.push_back(it.value().from);
+    }
+    if (nodeToIndex.contains(it.value().to) == false)
+    {
+      nodeToIndex.insert(it.value().to, (int)indexToNode.size());
+      indexToNode.push_back(it.value().to);
+    }
+  }
   for (QHash<long, double>::const_iterator it = _cost.begin(); it != _cost.end(); ++it)
   {
-    _queue.push(Node(it.key(), it.value()));
+    if (nodeToIndex.contains(it.key()) == false)
+    {
+      nodeToIndex.insert(it.key(), (int)indexToNode.size());
+      indexToNode.push_back(it.key());
+    }
+  }
+  int nodeCount = (int)indexToNode.size();
+
+  // pack the adjacency into compressed sparse row form.
+  vector<int> firstEdge(nodeCount + 1, 0);
+  for (QMultiHash<long, DirectedGraph::Edge>::const_iterator it = edges.begin();
+    it != edges.end(); ++it)
+  {
+    firstEdge[nodeToIndex[it.value().from] + 1]++;
+  }
+  for (int i = 0; i < nodeCount; i++)
+  {
+    firstEdge[i + 1] += firstEdge[i];
+  }
+  vector<int> edgeTo(edges.size());
+  vector<double> edgeWeight(edges.size());
+  vector<int> cursor(firstEdge.begin(), firstEdge.end() - 1);
+  for (QMultiHash<long, DirectedGraph::Edge>::const_iterator it = edges.begin();
+    it != edges.end(); ++it)
+  {
+    int e = cursor[nodeToIndex[it.value().from]]++;
+    edgeTo[e] = nodeToIndex[it.value().to];
+    edgeWeight[e] = it.value().weight;
+  }
+
+  // -1 denotes unreached, consistent w/ getNodeCost.
+  vector<double> cost(nodeCount, -1.0);
+  for (QHash<long, double>::const_iterator it = _cost.begin(); it != _cost.end(); ++it)
+  {
+    int i = nodeToIndex[it.key()];
+    cost[i] = it.value();
+    _queue.push(Node(i, it.value()));
   }
 
-  const QMultiHash<long, DirectedGraph::Edge>& edges = _graph->getEdges();
   while (_queue.empty() == false)
   {
     Node top = _queue.top();
     _queue.pop();
 
-    for (QMultiHash<long, DirectedGraph::Edge>::const_iterator it = edges.find(top.id);
-      it != edges.end() && it.key() == top.id; ++it)
+    // skip stale queue entries for nodes that were relaxed again after this push.
+    if (top.cost > cost[top.id])
     {
-      double c = top.cost + it.value().weight;
-      long nId = it.value().to;
-      if (_cost.contains(nId) == false || _cost[nId] > c)
+      continue;
+    }
+
+    for (int e = firstEdge[top.id]; e < firstEdge[top.id + 1]; e++)
+    {
+      double c = top.cost + edgeWeight[e];
+      int n = edgeTo[e];
+      if (cost[n] < 0 || cost[n] > c)
       {
-        _cost[nId] = c;
-        _queue.push(Node(nId, c));
+        cost[n] = c;
+        _queue.push(Node(n, c));
       }
     }
   }
+
+  for (int i = 0; i < nodeCount; i++)
+  {
+    if (cost[i] >= 0)
+    {
+      _cost[indexToNode[i]] = cost[i];
+    }
+  }
 }
 
 }
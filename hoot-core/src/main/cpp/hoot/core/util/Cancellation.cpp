@@ -0,0 +1,76 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "Cancellation.h"
+
+// hoot
+#include <hoot/core/util/HootException.h>
+
+// tgs
+#include <tgs/System/Time.h>
+
+namespace hoot
+{
+
+volatile sig_atomic_t Cancellation::_cancelRequested = 0;
+double Cancellation::_deadline = -1.0;
+
+void Cancellation::armDeadlineFromNow(double seconds)
+{
+  if (seconds > 0.0)
+  {
+    _deadline = Tgs::Time::getTime() + seconds;
+  }
+}
+
+bool Cancellation::isCancelled()
+{
+  if (_cancelRequested != 0)
+  {
+    return true;
+  }
+  return _deadline >= 0.0 && Tgs::Time::getTime() > _deadline;
+}
+
+void Cancellation::checkIn()
+{
+  if (_cancelRequested != 0)
+  {
+    throw OperationCancelledException("Operation cancelled by request.");
+  }
+  if (_deadline >= 0.0 && Tgs::Time::getTime() > _deadline)
+  {
+    throw OperationCancelledException("Operation exceeded its deadline.");
+  }
+}
+
+void Cancellation::reset()
+{
+  _cancelRequested = 0;
+  _deadline = -1.0;
+}
+
+}
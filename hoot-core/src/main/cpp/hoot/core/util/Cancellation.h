@@ -0,0 +1,94 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+// Standard
+#include <csignal>
+
+namespace hoot
+{
+
+/**
+ * A process wide cooperative cancellation token.
+ *
+ * Long running operations call checkIn() at convenient points (phase boundaries, once per batch
+ * in tight loops). If cancellation has been requested, or an armed deadline has passed, checkIn()
+ * throws OperationCancelledException; the operation's caller can then checkpoint the partial
+ * result instead of losing everything to a SIGKILL.
+ *
+ * requestCancel() only sets a flag and is safe to call from a signal handler (e.g. SIGTERM) or
+ * another thread. The deadline is wall clock based and is typically armed once at the top of an
+ * operation chain from operation.deadline.seconds; nested chains leave an already armed deadline
+ * alone.
+ */
+class Cancellation
+{
+public:
+
+  /**
+   * Requests cooperative cancellation. Async-signal-safe; the request takes effect at the next
+   * checkIn().
+   */
+  static void requestCancel() { _cancelRequested = 1; }
+
+  /**
+   * Arms a wall clock deadline the given number of seconds from now. A non-positive value is
+   * ignored.
+   */
+  static void armDeadlineFromNow(double seconds);
+
+  /**
+   * Returns true if a deadline is currently armed.
+   */
+  static bool isDeadlineArmed() { return _deadline >= 0.0; }
+
+  /**
+   * Returns true if cancellation has been requested or an armed deadline has passed.
+   */
+  static bool isCancelled();
+
+  /**
+   * Throws OperationCancelledException if isCancelled(); otherwise a no-op.
+   */
+  static void checkIn();
+
+  /**
+   * Clears any pending cancellation request and disarms the deadline.
+   */
+  static void reset();
+
+private:
+
+  static volatile sig_atomic_t _cancelRequested;
+  /// seconds since the epoch; negative when disarmed.
+  static double _deadline;
+};
+
+}
+
+#endif // CANCELLATION_H
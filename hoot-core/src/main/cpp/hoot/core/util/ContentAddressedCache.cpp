@@ -0,0 +1,145 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ContentAddressedCache.h"
+
+// Hoot
+#include <hoot/core/Version.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+#include <hoot/core/util/Settings.h>
+
+// Qt
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+namespace hoot
+{
+
+ContentAddressedCache::ContentAddressedCache(QString cacheDir)
+{
+  _cacheDir = cacheDir;
+}
+
+QString ContentAddressedCache::calculateKey(QString stageName, QStringList inputs,
+  QStringList settingsKeys) const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+
+  // a cache built by one hoot version must never serve another; readers/writers and op
+  // implementations change between releases.
+  hash.addData(QByteArray(Version::getFullVersion()));
+  hash.addData(stageName.toUtf8());
+
+  for (int i = 0; i < inputs.size(); i++)
+  {
+    QFileInfo fi(inputs[i]);
+    if (fi.isFile() == false)
+    {
+      LOG_DEBUG("Input isn't a regular file, skipping the cache: " << inputs[i]);
+      return QString();
+    }
+    QFile f(inputs[i]);
+    if (f.open(QFile::ReadOnly) == false)
+    {
+      throw HootException("Error opening file for reading: " + inputs[i]);
+    }
+    // hash the content, not the path/mtime, so renamed or re-downloaded identical inputs still
+    // hit.
+    while (f.atEnd() == false)
+    {
+      hash.addData(f.read(1024 * 1024));
+    }
+  }
+
+  if (settingsKeys.size() == 0)
+  {
+    hash.addData(conf().toString().toUtf8());
+  }
+  else
+  {
+    settingsKeys.sort();
+    for (int i = 0; i < settingsKeys.size(); i++)
+    {
+      hash.addData(settingsKeys[i].toUtf8());
+      hash.addData(conf().getString(settingsKeys[i], "").toUtf8());
+    }
+  }
+
+  return QString::fromUtf8(hash.result().toHex());
+}
+
+bool ContentAddressedCache::fetch(QString key, QString outputPath) const
+{
+  const QString entry = _entryPath(key, outputPath);
+  if (QFile::exists(entry) == false)
+  {
+    return false;
+  }
+
+  if (QFile::exists(outputPath))
+  {
+    QFile::remove(outputPath);
+  }
+  if (QFile::copy(entry, outputPath) == false)
+  {
+    throw HootException("Error copying cache entry " + entry + " to " + outputPath);
+  }
+  LOG_INFO("Copied cached result to " << outputPath << " (" << entry << ")");
+  return true;
+}
+
+void ContentAddressedCache::store(QString key, QString outputPath) const
+{
+  const QString entry = _entryPath(key, outputPath);
+  if (QFile::exists(entry))
+  {
+    // a concurrent job got there first; entries for the same key are identical by construction.
+    return;
+  }
+
+  QDir().mkpath(_cacheDir);
+  if (QFile::copy(outputPath, entry) == false)
+  {
+    throw HootException("Error copying " + outputPath + " to cache entry " + entry);
+  }
+  LOG_INFO("Stored result in cache: " << entry);
+}
+
+QString ContentAddressedCache::_entryPath(QString key, QString outputPath) const
+{
+  const QString suffix = QFileInfo(outputPath).completeSuffix();
+  QString result = _cacheDir + "/" + key;
+  if (suffix.isEmpty() == false)
+  {
+    result += "." + suffix;
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef CONTENTADDRESSEDCACHE_H
+#define CONTENTADDRESSEDCACHE_H
+
+// Qt
+#include <QString>
+#include <QStringList>
+
+namespace hoot
+{
+
+/**
+ * A simple content-addressed store for intermediate command results.
+ *
+ * Entries are keyed by a hash of the stage name, the content of the input files, the relevant
+ * configuration and the hoot version, so a hit guarantees the cached file was produced by an
+ * identical run. This makes it safe to share one cache directory across many multi-stage jobs;
+ * stages whose inputs and configuration didn't change are served from the cache. Entries are
+ * never evicted, so point the cache directory at scratch space.
+ *
+ * See MapCleaner for an in-process variation on the same idea.
+ */
+class ContentAddressedCache
+{
+public:
+
+  /**
+   * @param cacheDir Directory the entries live in. An empty string disables the cache.
+   */
+  ContentAddressedCache(QString cacheDir);
+
+  /**
+   * Calculates the cache key for one stage of a job.
+   *
+   * Returns an empty string if any input isn't a regular file (e.g. a database URL) since its
+   * content can't be cheaply fingerprinted; callers should skip caching in that case.
+   *
+   * @param stageName Name of the stage (typically the command name).
+   * @param inputs Paths to the input files whose content feeds the stage.
+   * @param settingsKeys The configuration keys the stage's output depends on. If empty, the
+   *  entire configuration is hashed, which is always correct but invalidates entries on any
+   *  configuration change.
+   */
+  QString calculateKey(QString stageName, QStringList inputs, QStringList settingsKeys) const;
+
+  /**
+   * If an entry exists for the given key, copies it to outputPath and returns true.
+   */
+  bool fetch(QString key, QString outputPath) const;
+
+  bool isEnabled() const { return _cacheDir.isEmpty() == false; }
+
+  /**
+   * Copies outputPath into the cache under the given key.
+   */
+  void store(QString key, QString outputPath) const;
+
+private:
+
+  QString _cacheDir;
+
+  /**
+   * The entry keeps the output's file extension so format is determined by extension on the way
+   * back out, same as any other file.
+   */
+  QString _entryPath(QString key, QString outputPath) const;
+};
+
+}
+
+#endif // CONTENTADDRESSEDCACHE_H
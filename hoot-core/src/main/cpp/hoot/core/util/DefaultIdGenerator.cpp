@@ -44,15 +44,98 @@ IdGeneratorPtr DefaultIdGenerator::clone() const
   copy->_nodeId = _nodeId;
   copy->_wayId = _wayId;
   copy->_relationId = _relationId;
+  copy->_blockSize = _blockSize;
 
   return result;
 }
 
+long DefaultIdGenerator::createNodeId()
+{
+  if (_blockSize <= 1)
+  {
+    QMutexLocker lock(&_mutex);
+    return --_nodeId;
+  }
+  ThreadBlocks& b = _blocks();
+  if (b.nodeRemaining == 0)
+  {
+    b.nodeNext = _leaseBlock(_nodeId);
+    b.nodeRemaining = _blockSize;
+  }
+  b.nodeRemaining--;
+  return --b.nodeNext;
+}
+
+long DefaultIdGenerator::createRelationId()
+{
+  if (_blockSize <= 1)
+  {
+    QMutexLocker lock(&_mutex);
+    return --_relationId;
+  }
+  ThreadBlocks& b = _blocks();
+  if (b.relationRemaining == 0)
+  {
+    b.relationNext = _leaseBlock(_relationId);
+    b.relationRemaining = _blockSize;
+  }
+  b.relationRemaining--;
+  return --b.relationNext;
+}
+
+long DefaultIdGenerator::createWayId()
+{
+  if (_blockSize <= 1)
+  {
+    QMutexLocker lock(&_mutex);
+    return --_wayId;
+  }
+  ThreadBlocks& b = _blocks();
+  if (b.wayRemaining == 0)
+  {
+    b.wayNext = _leaseBlock(_wayId);
+    b.wayRemaining = _blockSize;
+  }
+  b.wayRemaining--;
+  return --b.wayNext;
+}
+
 void DefaultIdGenerator::reset()
 {
+  QMutexLocker lock(&_mutex);
   _wayId = ConfigOptions().getIdGeneratorWayStart();
   _nodeId = ConfigOptions().getIdGeneratorNodeStart();
   _relationId = ConfigOptions().getIdGeneratorRelationStart();
+  _blockSize = std::max(1, ConfigOptions().getIdGeneratorBlockSize());
+  // invalidates every thread's outstanding block.
+  _generation++;
+}
+
+DefaultIdGenerator::ThreadBlocks& DefaultIdGenerator::_blocks()
+{
+  ThreadBlocks* b = _threadBlocks.localData();
+  if (b == 0 || b->generation != _generation)
+  {
+    b = new ThreadBlocks();
+    b->generation = _generation;
+    b->nodeNext = 0;
+    b->nodeRemaining = 0;
+    b->wayNext = 0;
+    b->wayRemaining = 0;
+    b->relationNext = 0;
+    b->relationRemaining = 0;
+    // QThreadStorage deletes any data the thread previously stored.
+    _threadBlocks.setLocalData(b);
+  }
+  return *b;
+}
+
+long DefaultIdGenerator::_leaseBlock(long& sharedId)
+{
+  QMutexLocker lock(&_mutex);
+  const long start = sharedId;
+  sharedId -= _blockSize;
+  return start;
 }
 
 }
@@ -30,6 +30,11 @@
 
 #include "IdGenerator.h"
 
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
+
 namespace hoot
 {
 
@@ -38,30 +43,67 @@ class DefaultIdGenerator : public IdGenerator
 public:
   static std::string className() { return "hoot::DefaultIdGenerator"; }
 
-  DefaultIdGenerator() { reset(); }
+  DefaultIdGenerator() { _generation = 0; reset(); }
 
   virtual ~DefaultIdGenerator() {}
 
   virtual IdGeneratorPtr clone() const;
 
-  virtual long createNodeId() { return --_nodeId; }
+  // The process wide instance is shared by every OsmMap, including maps owned by concurrent
+  // reader threads (see ParallelOgrInputStream), so handing out an id must be atomic. With
+  // id.generator.block.size above one, each thread leases a block of ids and takes the shared
+  // lock once per block rather than once per id.
+  virtual long createNodeId();
 
-  virtual long createRelationId() { return --_relationId; }
+  virtual long createRelationId();
 
-  virtual long createWayId() { return --_wayId; }
+  virtual long createWayId();
 
-  void ensureNodeBounds(long nid) { _nodeId = std::min(nid, _nodeId); }
+  // Bounds apply to future block leases only; blocks already leased to threads are not recalled,
+  // so establish bounds (i.e. load the input maps) before parallel creation begins.
+  void ensureNodeBounds(long nid) { QMutexLocker lock(&_mutex); _nodeId = std::min(nid, _nodeId); }
 
-  void ensureRelationBounds(long rid) { _relationId = std::min(rid, _relationId); }
+  void ensureRelationBounds(long rid)
+  { QMutexLocker lock(&_mutex); _relationId = std::min(rid, _relationId); }
 
-  void ensureWayBounds(long wid) { _wayId = std::min(wid, _wayId); }
+  void ensureWayBounds(long wid) { QMutexLocker lock(&_mutex); _wayId = std::min(wid, _wayId); }
 
   void reset();
 
 private:
+  /**
+   * Ids a thread has leased but not yet handed out. A generation mismatch means reset() has run
+   * since the lease was taken and the block is stale.
+   */
+  struct ThreadBlocks
+  {
+    int generation;
+    long nodeNext;
+    int nodeRemaining;
+    long wayNext;
+    int wayRemaining;
+    long relationNext;
+    int relationRemaining;
+  };
+
   long _nodeId;
   long _relationId;
   long _wayId;
+  int _blockSize;
+  int _generation;
+  mutable QMutex _mutex;
+  mutable QThreadStorage<ThreadBlocks*> _threadBlocks;
+
+  /**
+   * Returns the calling thread's block state, replacing it if it predates the last reset().
+   */
+  ThreadBlocks& _blocks();
+
+  /**
+   * Takes _blockSize ids off the given shared counter and returns the value the first decrement
+   * should start from.
+   */
+  long _leaseBlock(long& sharedId);
 };
 
 }
@@ -187,17 +187,18 @@ boost::shared_ptr<LineString> ElementConverter::convertToLineString(const ConstW
   CoordinateSequence* cs = GeometryFactory::getDefaultInstance()->getCoordinateSequenceFactory()->
                            create(size, 2);
 
-  for (size_t i = 0; i < ids.size(); i++)
+  // gather all the coordinates in one call against the provider's node store.
+  vector<Coordinate> coords;
+  _constProvider->getNodeCoordinates(ids, coords);
+  for (size_t i = 0; i < coords.size(); i++)
   {
-    ConstNodePtr n = _constProvider->getNode(ids[i]);
-    cs->setAt(n->toCoordinate(), i);
+    cs->setAt(coords[i], i);
   }
 
   // a linestring cannot contain 1 point. Do this to keep it valid.
   if (ids.size() == 1)
   {
-    ConstNodePtr n = _constProvider->getNode(ids[0]);
-    cs->setAt(n->toCoordinate(), 1);
+    cs->setAt(coords[0], 1);
   }
 
   boost::shared_ptr<LineString> result(GeometryFactory::getDefaultInstance()->createLineString(cs));
@@ -228,19 +229,19 @@ boost::shared_ptr<Polygon> ElementConverter::convertToPolygon(const ConstWayPtr&
   CoordinateSequence* cs = GeometryFactory::getDefaultInstance()->getCoordinateSequenceFactory()->
                            create(size, 2);
 
+  vector<Coordinate> coords;
+  _constProvider->getNodeCoordinates(ids, coords);
   size_t i;
-  for (i = 0; i < ids.size(); i++)
+  for (i = 0; i < coords.size(); i++)
   {
-    ConstNodePtr n = _constProvider->getNode(ids[i]);
-    cs->setAt(n->toCoordinate(), i);
+    cs->setAt(coords[i], i);
   }
 
   // if there are fewer than two points, or the last point does not equal the first
   while (i < size)
   {
     // add the first point onto the end.
-    ConstNodePtr n = _constProvider->getNode(ids[0]);
-    cs->setAt(n->toCoordinate(), i);
+    cs->setAt(coords[0], i);
     i++;
   }
 
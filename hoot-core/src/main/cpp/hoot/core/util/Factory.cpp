@@ -71,6 +71,31 @@ any Factory::constructObject(const std::string& name)
   return c->create();
 }
 
+ObjectCreator& Factory::getCreator(const std::string& name)
+{
+  QMutexLocker locker(&_mutex);
+  std::map<std::string, ObjectCreator*>::const_iterator it = _creators.find(name);
+  if (it == _creators.end())
+  {
+    throw HootException("Could not find object to construct. (" + name + ")");
+  }
+  return *it->second;
+}
+
+vector<ObjectCreator*> Factory::preResolve(const QStringList& names)
+{
+  vector<ObjectCreator*> result;
+  result.reserve(names.size());
+  for (int i = 0; i < names.size(); i++)
+  {
+    if (names[i].isEmpty() == false)
+    {
+      result.push_back(&getCreator(names[i].toStdString()));
+    }
+  }
+  return result;
+}
+
 Factory& Factory::getInstance()
 {
   if (_theInstance == NULL)
@@ -36,6 +36,7 @@
 
 // Qt
 #include <QMutex>
+#include <QStringList>
 
 // Standard
 #include <map>
@@ -152,6 +153,47 @@ public:
     return boost::any_cast<T*>(constructObject(name));
   }
 
+  /**
+   * Constructs an object through a previously resolved creator without touching the registry,
+   * so no mutex is taken and no string lookup is done.
+   */
+  template<class T>
+  static T* constructObject(ObjectCreator& creator)
+  {
+    return boost::any_cast<T*>(creator.create());
+  }
+
+  /**
+   * Resolves a class name to its registered creator. The lookup takes the registry mutex once;
+   * constructing through the returned creator afterwards is lock free, which makes a resolved
+   * creator suitable for use inside per element loops. Creators are never unregistered, so the
+   * reference stays valid for the life of the process.
+   */
+  ObjectCreator& getCreator(const std::string& name);
+
+  ObjectCreator& getCreator(const QString& name) { return getCreator(name.toStdString()); }
+
+  /**
+   * Resolves a class name and verifies its base class with a single registry lookup.
+   */
+  template<class ExpectedBase>
+  ObjectCreator& resolveCreator(const std::string& name)
+  {
+    ObjectCreator& result = getCreator(name);
+    if (result.getBaseName() != ExpectedBase::className())
+    {
+      throw HootException("Class (" + name + ") does not have a base class of " +
+        ExpectedBase::className());
+    }
+    return result;
+  }
+
+  /**
+   * Resolves every class name in names so a misconfigured pipeline fails before any work starts.
+   * Empty names are ignored. Returns the resolved creators in input order.
+   */
+  std::vector<ObjectCreator*> preResolve(const QStringList& names);
+
   std::vector<std::string> getObjectNamesByBase(const std::string& baseName);
 
   bool hasClass(const QString& name) { return hasClass(name.toStdString()); }
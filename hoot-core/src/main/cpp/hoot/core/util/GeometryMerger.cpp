@@ -0,0 +1,293 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "GeometryMerger.h"
+
+// Hoot
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/GeometryUtils.h>
+#include <hoot/core/util/HootException.h>
+#include <hoot/core/util/Log.h>
+
+// GEOS
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/util/GEOSException.h>
+
+// Qt
+#include <QString>
+#include <QThread>
+
+// Standard
+#include <algorithm>
+#include <cmath>
+
+// TGS
+#include <tgs/RStarTree/HilbertCurve.h>
+
+using namespace geos::geom;
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+
+/**
+ * Orders geometries by the hilbert value of their envelope centroid so spatially adjacent
+ * geometries land next to each other, the same packing an R-tree bulk load uses.
+ */
+class ComparePolygon
+{
+public:
+
+  ComparePolygon(Envelope e)
+  {
+    _curve.reset(new Tgs::HilbertCurve(2, 8));
+    _e = e;
+    _size = (1 << 8) - 1;
+  }
+
+  ComparePolygon(const ComparePolygon& other)
+  {
+    _curve = other._curve;
+    _e = other._e;
+    _size = other._size;
+  }
+
+  bool operator()(const boost::shared_ptr<Geometry>& p1, const boost::shared_ptr<Geometry>& p2)
+  {
+    const Envelope* e1 = p1->getEnvelopeInternal();
+    const Envelope* e2 = p2->getEnvelopeInternal();
+    double x1 = (e1->getMinX() + e1->getMaxX()) / 2.0;
+    double x2 = (e2->getMinX() + e2->getMaxX()) / 2.0;
+    double y1 = (e1->getMinY() + e1->getMaxY()) / 2.0;
+    double y2 = (e2->getMinY() + e2->getMaxY()) / 2.0;
+
+    int i1[2], i2[2];
+    i1[0] = (int)((x1 - _e.getMinX()) / (_e.getWidth()) * _size);
+    i1[1] = (int)((y1 - _e.getMinY()) / (_e.getHeight()) * _size);
+    i2[0] = (int)((x2 - _e.getMinX()) / (_e.getWidth()) * _size);
+    i2[1] = (int)((y2 - _e.getMinY()) / (_e.getHeight()) * _size);
+
+    bool result;
+    int h1 = _curve->encode(i1);
+    int h2 = _curve->encode(i2);
+    if (h1 == h2)
+    {
+      result = p1 < p2;
+    }
+    else
+    {
+      result = h1 < h2;
+    }
+
+    return result;
+  }
+
+private:
+
+  ComparePolygon();
+  ComparePolygon& operator=(ComparePolygon& other);
+
+  Envelope _e;
+  boost::shared_ptr<Tgs::HilbertCurve> _curve;
+  double _size;
+};
+
+/**
+ * Unions two geometries, cleaning and retrying when GEOS returns an inconsistent or failed
+ * result.
+ */
+boost::shared_ptr<Geometry> _unionPair(boost::shared_ptr<Geometry>& g1,
+  boost::shared_ptr<Geometry>& g2)
+{
+  boost::shared_ptr<Geometry> g;
+  // sometimes GEOS gives results that are incorrect. In those cases we try cleaning the
+  // geometries and attempting it again.
+  bool cleanAndRetry = false;
+  try
+  {
+    double area = g1->getArea() + g2->getArea();
+    g.reset(g1->Union(g2.get()));
+    if (g->isEmpty() || fabs(g->getArea() - area) > 0.1)
+    {
+      cleanAndRetry = true;
+    }
+  }
+  catch (const geos::util::GEOSException& e)
+  {
+    LOG_TRACE("Topology error. Attempting to fix it: " << e.what());
+    cleanAndRetry = true;
+  }
+
+  if (cleanAndRetry)
+  {
+    g1.reset(GeometryUtils::validateGeometry(g1.get()));
+    g2.reset(GeometryUtils::validateGeometry(g2.get()));
+    try
+    {
+      g.reset(g1->Union(g2.get()));
+    }
+    // if the cleaning didn't fix the problem.
+    catch (const geos::util::GEOSException& e)
+    {
+      // report an error.
+      QString error = "Error unioning two geometries. " + QString(e.what()) + "\n" +
+          "geom1: " + QString::fromStdString(g1->toString()) + "\n" +
+          "geom2: " + QString::fromStdString(g2->toString());
+      throw HootException(error);
+    }
+  }
+
+  return g;
+}
+
+/**
+ * Unions a contiguous shard of the pairs in one merge round. The workers touch disjoint
+ * geometries and disjoint output slots, so no locking is needed. Exceptions are recorded rather
+ * than thrown so they can be rethrown on the spawning thread.
+ */
+class UnionShardWorker : public QThread
+{
+public:
+
+  UnionShardWorker(vector< boost::shared_ptr<Geometry> >& in,
+    vector< boost::shared_ptr<Geometry> >& out, size_t beginPair, size_t endPair) :
+    _in(in),
+    _out(out),
+    _beginPair(beginPair),
+    _endPair(endPair)
+  {
+  }
+
+  virtual void run()
+  {
+    try
+    {
+      for (size_t i = _beginPair; i < _endPair; i++)
+      {
+        _out[i] = _unionPair(_in[i * 2], _in[i * 2 + 1]);
+      }
+    }
+    catch (const HootException& e)
+    {
+      _error = e.getWhat();
+    }
+  }
+
+  bool hasError() const { return _error.isEmpty() == false; }
+  QString getError() const { return _error; }
+
+private:
+
+  vector< boost::shared_ptr<Geometry> >& _in;
+  vector< boost::shared_ptr<Geometry> >& _out;
+  size_t _beginPair;
+  size_t _endPair;
+  QString _error;
+};
+
+}
+
+GeometryMerger::GeometryMerger()
+{
+}
+
+boost::shared_ptr<Geometry> GeometryMerger::mergeGeometries(
+  vector< boost::shared_ptr<Geometry> > geometries, const Envelope& envelope) const
+{
+  if (geometries.empty())
+  {
+    return
+      boost::shared_ptr<Geometry>(GeometryFactory::getDefaultInstance()->createEmptyGeometry());
+  }
+
+  const int threadCount = ConfigOptions().getGeometryMergerThreads();
+  vector< boost::shared_ptr<Geometry> > next;
+  // while there is more than one geometry.
+  while (geometries.size() > 1)
+  {
+    LOG_TRACE("Remaining pieces: " << geometries.size());
+    // sort polygons using the hilbert value. This increases the chances that nearby polygons
+    // will be merged early and speed up the union process.
+    ComparePolygon compare(envelope);
+    sort(geometries.begin(), geometries.end(), compare);
+
+    // merge pairs at a time. This makes the join faster.
+    const size_t pairCount = geometries.size() / 2;
+    next.assign(pairCount, boost::shared_ptr<Geometry>());
+    const int roundThreads = max(1, min(threadCount, (int)pairCount));
+    if (roundThreads == 1)
+    {
+      for (size_t i = 0; i < pairCount; i++)
+      {
+        next[i] = _unionPair(geometries[i * 2], geometries[i * 2 + 1]);
+      }
+    }
+    else
+    {
+      // shard this round's pairs across the workers. The pairing itself is fixed by the sort,
+      // so the result is identical to the serial path.
+      const size_t shardSize = (pairCount + roundThreads - 1) / roundThreads;
+      vector<UnionShardWorker*> workers;
+      for (int t = 0; t < roundThreads; t++)
+      {
+        const size_t beginPair = t * shardSize;
+        const size_t endPair = min(pairCount, beginPair + shardSize);
+        workers.push_back(new UnionShardWorker(geometries, next, beginPair, endPair));
+        workers.back()->start();
+      }
+      QString error;
+      for (size_t t = 0; t < workers.size(); t++)
+      {
+        workers[t]->wait();
+        if (error.isEmpty() && workers[t]->hasError())
+        {
+          error = workers[t]->getError();
+        }
+        delete workers[t];
+      }
+      if (error.isEmpty() == false)
+      {
+        throw HootException(error);
+      }
+    }
+    // if there are an odd number of entries, just add the last one
+    if (geometries.size() % 2 == 1)
+    {
+      next.push_back(geometries[geometries.size() - 1]);
+    }
+
+    geometries = next;
+  }
+
+  return geometries[0];
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef GEOMETRYMERGER_H
+#define GEOMETRYMERGER_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// Standard
+#include <vector>
+
+namespace geos
+{
+  namespace geom
+  {
+    class Envelope;
+    class Geometry;
+  }
+}
+
+namespace hoot
+{
+
+/**
+ * Unions a set of geometries into one with a balanced merge tree rather than a sequential
+ * pairwise union, which is quadratic in practice. Each round sorts the remaining pieces along a
+ * hilbert curve so spatially adjacent geometries merge early (the same packing an R-tree bulk
+ * load uses), then unions consecutive pairs; the rounds of a pairing are split into contiguous
+ * shards and run concurrently on geometry.merger.threads worker threads. The pairing is fixed by
+ * the sort, so the result doesn't depend on the thread count.
+ *
+ * Used by AlphaShape and the union-polygons command; anything that unions many small polygons
+ * into one coverage can use it.
+ */
+class GeometryMerger
+{
+public:
+
+  GeometryMerger();
+
+  /**
+   * Unions all the given geometries into a single geometry. The envelope must contain every
+   * input geometry; it anchors the hilbert curve. The input vector is consumed (geometries may
+   * be cleaned in place when GEOS returns an inconsistent result). Returns an empty geometry when
+   * the input is empty.
+   */
+  boost::shared_ptr<geos::geom::Geometry> mergeGeometries(
+    std::vector<boost::shared_ptr<geos::geom::Geometry> > geometries,
+    const geos::geom::Envelope& envelope) const;
+};
+
+}
+
+#endif // GEOMETRYMERGER_H
@@ -34,6 +34,8 @@
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/Point.h>
 #include <geos/geom/Polygon.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
 
 // hoot
 #include <hoot/core/util/Units.h>
@@ -177,6 +179,35 @@ QString GeometryUtils::toString(const Envelope& e)
       arg(e.getMaxY(), 0, 'g', 15);
 }
 
+namespace
+{
+  // keeps the source geometry alive for as long as the prepared geometry that references it
+  struct PreparedGeometryDeleter
+  {
+    boost::shared_ptr<const Geometry> base;
+    void operator()(const geos::geom::prep::PreparedGeometry* pg) { delete pg; }
+  };
+}
+
+boost::shared_ptr<const geos::geom::prep::PreparedGeometry> GeometryUtils::prepareGeometry(
+  const boost::shared_ptr<const Geometry>& g)
+{
+  PreparedGeometryDeleter deleter;
+  deleter.base = g;
+  return boost::shared_ptr<const geos::geom::prep::PreparedGeometry>(
+    geos::geom::prep::PreparedGeometryFactory::prepare(g.get()), deleter);
+}
+
+void GeometryUtils::containsAll(const geos::geom::prep::PreparedGeometry& poly,
+  const vector<boost::shared_ptr<const Geometry> >& probes, vector<bool>& contained)
+{
+  contained.resize(probes.size());
+  for (size_t i = 0; i < probes.size(); i++)
+  {
+    contained[i] = probes[i].get() != 0 && poly.contains(probes[i].get());
+  }
+}
+
 Geometry* GeometryUtils::validateGeometry(const Geometry* g)
 {
   switch (g->getGeometryTypeId())
@@ -42,6 +42,10 @@ namespace geos
     class MultiLineString;
     class MultiPolygon;
     class Polygon;
+    namespace prep
+    {
+      class PreparedGeometry;
+    }
   }
 }
 
@@ -95,6 +99,25 @@ public:
 
   static QString toString(const geos::geom::Envelope& e);
 
+  /**
+   * Wraps the geometry in a GEOS PreparedGeometry for repeated predicate evaluation. Prepared
+   * predicates index the polygon's edges once, so probing the same polygon many times (e.g.
+   * contains checks against every nearby POI) costs a point location rather than a full
+   * intersection matrix each time. The returned prepared geometry keeps g alive for its own
+   * lifetime.
+   */
+  static boost::shared_ptr<const geos::geom::prep::PreparedGeometry> prepareGeometry(
+    const boost::shared_ptr<const geos::geom::Geometry>& g);
+
+  /**
+   * Batched containment test: sets contained[i] to poly.contains(probes[i]). Null probes are
+   * reported as not contained. Prepare the polygon once (see prepareGeometry) and test all the
+   * probes against it rather than evaluating each pair from scratch.
+   */
+  static void containsAll(const geos::geom::prep::PreparedGeometry& poly,
+    const std::vector<boost::shared_ptr<const geos::geom::Geometry> >& probes,
+    std::vector<bool>& contained);
+
   static geos::geom::Geometry* validateGeometry(const geos::geom::Geometry *g);
 
   static geos::geom::Geometry* validateGeometryCollection(const geos::geom::GeometryCollection* gc);
@@ -179,6 +179,7 @@ HOOT_DEFINE_EXCEPTION(IllegalArgumentException)
 HOOT_DEFINE_EXCEPTION(InternalErrorException)
 HOOT_DEFINE_EXCEPTION(IoException)
 HOOT_DEFINE_EXCEPTION(NeedsReviewException)
+HOOT_DEFINE_EXCEPTION_STR(OperationCancelledException, "Operation cancelled")
 HOOT_DEFINE_EXCEPTION(UnsupportedException)
 HOOT_DEFINE_EXCEPTION_STR(NotImplementedException, "Not Implemented")
 
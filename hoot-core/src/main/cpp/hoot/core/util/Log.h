@@ -124,6 +124,20 @@ public:
   void progress(WarningLevel level, const std::string& str, const std::string& filename,
     const std::string& functionName, int lineNumber);
 
+  /**
+   * When enabled, formatted log lines are handed to a background writer thread through a bounded
+   * queue instead of being written to stdout inline. Lines still appear in the order they were
+   * logged. Only the generic logger supports this; the log4cxx logger ignores it. See the
+   * log.async configuration option.
+   */
+  void setAsync(bool async);
+
+  /**
+   * Blocks until the background writer has written all the queued lines. A no-op when async
+   * logging is off.
+   */
+  void flush();
+
   void setLevel(WarningLevel l);
 
 #if HOOT_HAVE_LIBLOG4CXX
@@ -27,20 +27,159 @@
 
 #include "Log.h"
 
+// Hoot
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Settings.h>
+
 // Qt
 #include <QDateTime>
 #include <QDebug>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
 
 // Standard
+#include <cstdlib>
+#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 using namespace std;
 
 namespace hoot
 {
 
+namespace
+{
+
+const int MAX_QUEUED_LINES = 4096;
+
+/**
+ * Background writer used when async logging is enabled. Lines are formatted on the logging
+ * thread and handed over through a bounded queue, so writing a log line on a timed run costs the
+ * caller a queue append instead of a terminal write.
+ */
+class AsyncLogWriter : public QThread
+{
+public:
+
+  AsyncLogWriter() :
+    _done(false),
+    _writing(false)
+  {
+    start();
+  }
+
+  void enqueue(const string& line)
+  {
+    QMutexLocker locker(&_mutex);
+    while ((int)_lines.size() >= MAX_QUEUED_LINES && _done == false)
+    {
+      _notFull.wait(&_mutex);
+    }
+    _lines.push_back(line);
+    _notEmpty.wakeOne();
+  }
+
+  void flush()
+  {
+    QMutexLocker locker(&_mutex);
+    while (_lines.empty() == false || _writing)
+    {
+      _notFull.wait(&_mutex);
+    }
+  }
+
+  void stop()
+  {
+    {
+      QMutexLocker locker(&_mutex);
+      _done = true;
+      _notEmpty.wakeOne();
+    }
+    wait();
+  }
+
+  virtual void run()
+  {
+    QMutexLocker locker(&_mutex);
+    while (true)
+    {
+      while (_lines.empty() && _done == false)
+      {
+        _notEmpty.wait(&_mutex);
+      }
+      if (_lines.empty() && _done)
+      {
+        break;
+      }
+
+      deque<string> batch;
+      batch.swap(_lines);
+      _writing = true;
+      locker.unlock();
+
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+        cout << batch[i];
+      }
+      cout.flush();
+
+      locker.relock();
+      _writing = false;
+      _notFull.wakeAll();
+    }
+    cout.flush();
+  }
+
+private:
+
+  QMutex _mutex;
+  QWaitCondition _notEmpty;
+  QWaitCondition _notFull;
+  deque<string> _lines;
+  bool _done;
+  bool _writing;
+};
+
+AsyncLogWriter* _asyncWriter = 0;
+
+// drains and stops the writer at process exit so the tail of the log isn't lost.
+void _stopAsyncWriterAtExit()
+{
+  Log::getInstance().setAsync(false);
+}
+
+}
+
 void Log::init()
 {
+  // init may run again after the config settings are finalized, which is when this picks the
+  // option up.
+  setAsync(conf().getBool(ConfigOptions::getLogAsyncKey(), false));
+}
+
+void Log::setAsync(bool async)
+{
+  if (async && _asyncWriter == 0)
+  {
+    _asyncWriter = new AsyncLogWriter();
+    atexit(_stopAsyncWriterAtExit);
+  }
+  else if (async == false && _asyncWriter != 0)
+  {
+    _asyncWriter->stop();
+    delete _asyncWriter;
+    _asyncWriter = 0;
+  }
+}
+
+void Log::flush()
+{
+  if (_asyncWriter != 0)
+  {
+    _asyncWriter->flush();
+  }
 }
 
 void Log::log(WarningLevel level, const string& str)
@@ -57,8 +196,19 @@ void Log::log(WarningLevel level, const string& str, const string& filename,
     QDateTime dt = QDateTime::currentDateTime();
 
     // takes the form: "09:34:21.635 WARN  <filename>(<lineNumber>) <str>"
-    cout << dt.toString("hh:mm:ss.zzz") << " " << setw(5) << left << getLevelString(level) << " " <<
-            ellipsisStr(filename) << "(" << setw(4) << right << lineNumber << ")" << " " << str << endl;
+    ostringstream ss;
+    ss << dt.toString("hh:mm:ss.zzz") << " " << setw(5) << left << getLevelString(level) << " " <<
+          ellipsisStr(filename) << "(" << setw(4) << right << lineNumber << ")" << " " << str <<
+          "\n";
+
+    if (_asyncWriter != 0)
+    {
+      _asyncWriter->enqueue(ss.str());
+    }
+    else
+    {
+      cout << ss.str() << std::flush;
+    }
   }
 }
 
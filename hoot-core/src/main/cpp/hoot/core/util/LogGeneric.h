@@ -40,10 +40,35 @@
     hoot::Log::getInstance().log((level), ss_.str(), __FILE__, "", __LINE__); \
   }}
 
+// Log statements below this level compile to nothing, so per element TRACE/DEBUG instrumentation
+// in the matchers costs nothing when a release build raises the floor, e.g.
+// DEFINES += HOOT_LOG_MIN_LEVEL=1000 in qmake elides LOG_TRACE. The values match
+// Log::WarningLevel. The runtime level check still applies to everything that is compiled in, and
+// WARN and above are always compiled in.
+#ifndef HOOT_LOG_MIN_LEVEL
+#define HOOT_LOG_MIN_LEVEL 0
+#endif
+
+#if HOOT_LOG_MIN_LEVEL <= 500
 #define LOG_TRACE(str) { LOG_LEVEL(hoot::Log::Trace, str) }
+#else
+#define LOG_TRACE(str) { }
+#endif
+#if HOOT_LOG_MIN_LEVEL <= 1000
 #define LOG_DEBUG(str) { LOG_LEVEL(hoot::Log::Debug, str) }
+#else
+#define LOG_DEBUG(str) { }
+#endif
+#if HOOT_LOG_MIN_LEVEL <= 1500
 #define LOG_VERBOSE(str) { LOG_LEVEL(hoot::Log::Verbose, str) }
+#else
+#define LOG_VERBOSE(str) { }
+#endif
+#if HOOT_LOG_MIN_LEVEL <= 2000
 #define LOG_INFO(str) { LOG_LEVEL(hoot::Log::Info, str) }
+#else
+#define LOG_INFO(str) { }
+#endif
 #define LOG_WARN(str) { LOG_LEVEL(hoot::Log::Warn, str) }
 #define LOG_ERROR(str) { LOG_LEVEL(hoot::Log::Error, str) }
 #define LOG_FATAL(str) { LOG_LEVEL(hoot::Log::Fatal, str) }
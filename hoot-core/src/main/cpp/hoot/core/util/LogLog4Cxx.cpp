@@ -132,6 +132,15 @@ void Log::progress(WarningLevel level, const string& str, const string& filename
   }
 }
 
+void Log::setAsync(bool /*async*/)
+{
+  // log4cxx has its own appender infrastructure; async output would be configured there.
+}
+
+void Log::flush()
+{
+}
+
 void Log::setLevel(WarningLevel l)
 {
   _logger->setLevel(toLog4CxxLevel(l));
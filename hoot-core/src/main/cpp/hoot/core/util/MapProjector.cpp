@@ -35,6 +35,7 @@ using namespace boost;
 #include <hoot/core/OsmMap.h>
 #include <hoot/core/algorithms/WayHeading.h>
 #include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/PackedNodeCoordinates.h>
 #include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/HootException.h>
 #include <hoot/core/util/Log.h>
@@ -44,6 +45,11 @@ using namespace boost;
 // GEOS
 #include <geos/geom/CoordinateFilter.h>
 
+// Qt
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+
 // Standard
 #include <iomanip>
 #include <iostream>
@@ -77,6 +83,71 @@ public:
   static void emptyErrorHandler(CPLErr, int, const char *) { }
 };
 
+namespace
+{
+
+QMutex _transformationCacheMutex;
+QHash<QString, OGRCoordinateTransformation*> _transformationCache;
+
+/**
+ * Transforms a contiguous shard of the packed coordinate arrays through its own transformation
+ * object (a transformation is not thread safe). Failures are recorded rather than thrown so the
+ * spawning thread can report them with the map still intact.
+ */
+class ReprojectShardWorker : public QThread
+{
+public:
+
+  ReprojectShardWorker(OGRCoordinateTransformation* t, double* x, double* y, size_t begin,
+                       size_t end) :
+    _t(t),
+    _x(x),
+    _y(y),
+    _begin(begin),
+    _end(end),
+    _failed(false),
+    _failedIndex(0)
+  {
+  }
+
+  bool hasFailure() const { return _failed; }
+
+  size_t getFailedIndex() const { return _failedIndex; }
+
+  virtual void run()
+  {
+    const size_t batchSize = 16384;
+    vector<int> success(std::min(batchSize, _end - _begin));
+    for (size_t offset = _begin; offset < _end; offset += batchSize)
+    {
+      const size_t n = std::min(batchSize, _end - offset);
+      _t->TransformEx(n, _x + offset, _y + offset, 0, &success[0]);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (success[i] == FALSE)
+        {
+          _failed = true;
+          _failedIndex = offset + i;
+          return;
+        }
+      }
+    }
+  }
+
+private:
+
+  OGRCoordinateTransformation* _t;
+  double* _x;
+  double* _y;
+  size_t _begin;
+  size_t _end;
+  bool _failed;
+  size_t _failedIndex;
+};
+
+}
+
 ReprojectCoordinateFilter::ReprojectCoordinateFilter(OGRCoordinateTransformation* t)
 {
   _transform = t;
@@ -113,6 +184,31 @@ void ReprojectCoordinateFilter::project(Coordinate* c) const
 }
 
 
+OGRCoordinateTransformation* MapProjector::getCachedTransformation(
+  const boost::shared_ptr<OGRSpatialReference>& srs1,
+  const boost::shared_ptr<OGRSpatialReference>& srs2)
+{
+  QString key = toWkt(srs1.get()) + ";" + toWkt(srs2.get());
+
+  QMutexLocker locker(&_transformationCacheMutex);
+  QHash<QString, OGRCoordinateTransformation*>::const_iterator it = _transformationCache.find(key);
+  if (it != _transformationCache.end())
+  {
+    return it.value();
+  }
+
+  OGRCoordinateTransformation* t(OGRCreateCoordinateTransformation(srs1.get(), srs2.get()));
+  if (t == 0)
+  {
+    throw HootException(QString("Error creating transformation object: ") + CPLGetLastErrorMsg());
+  }
+
+  // cached transformations are never destroyed; like factory registrations the cache lives for
+  // the life of the process.
+  _transformationCache.insert(key, t);
+  return t;
+}
+
 MapProjector& MapProjector::getInstance()
 {
   if (!_theInstance.get())
@@ -529,12 +625,9 @@ bool MapProjector::isGeographic(const ConstElementProviderPtr& provider)
 Coordinate MapProjector::project(const Coordinate& c, boost::shared_ptr<OGRSpatialReference> srs1,
                                  boost::shared_ptr<OGRSpatialReference> srs2)
 {
-  OGRCoordinateTransformation* t(OGRCreateCoordinateTransformation(srs1.get(), srs2.get()));
-
-  if (t == 0)
-  {
-    throw HootException(QString("Error creating transformation object: ") + CPLGetLastErrorMsg());
-  }
+  // reuse the cached transformation; creating one per call dwarfs the cost of the transform
+  // itself when this is called per coordinate in a loop.
+  OGRCoordinateTransformation* t = getCachedTransformation(srs1, srs2);
 
   Coordinate result;
 
@@ -542,8 +635,6 @@ Coordinate MapProjector::project(const Coordinate& c, boost::shared_ptr<OGRSpati
   result.y = c.y;
   ReprojectCoordinateFilter(t).project(&result);
 
-  OGRCoordinateTransformation::DestroyCT(t);
-
   return result;
 }
 
@@ -558,46 +649,108 @@ void MapProjector::project(boost::shared_ptr<OsmMap> map, boost::shared_ptr<OGRS
     throw HootException(QString("Error creating transformation object: ") + CPLGetLastErrorMsg());
   }
 
-  ReprojectCoordinateFilter rcf(t);
+  // Gather all the node coordinates into flat parallel arrays and hand them to GDAL in large
+  // batches. This avoids a virtual Transform call (and the projection setup cost behind it) per
+  // node and is dramatically faster than projecting one coordinate at a time on large maps.
+  PackedNodeCoordinates coords(*map);
+  double* x = coords.getX().empty() ? 0 : &coords.getX()[0];
+  double* y = coords.getY().empty() ? 0 : &coords.getY()[0];
+  const size_t total = coords.size();
+  const size_t batchSize = 16384;
 
-  int count = 0;
-  const NodeMap& nodes = map->getNodes();
-  for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+  const int threadCount = max(1, min(ConfigOptions().getMapProjectorThreads(), (int)total));
+
+  bool failed = false;
+  size_t failedIndex = 0;
+
+  if (threadCount > 1)
   {
-    Node* n = it->second.get();
-    Coordinate c = n->toCoordinate();
-    try
+    // each worker owns its transformation since a transformation is not thread safe; create them
+    // all up front on this thread.
+    vector<OGRCoordinateTransformation*> transforms(threadCount, (OGRCoordinateTransformation*)0);
+    transforms[0] = t;
+    for (int i = 1; i < threadCount; i++)
     {
-      rcf.project(&c);
-    }
-    catch(const IllegalArgumentException&)
-    {
-      if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+      transforms[i] = OGRCreateCoordinateTransformation(sourceSrs.get(), ref.get());
+      if (transforms[i] == 0)
       {
-        LOG_WARN("Failure projecting node: " << n->toString());
+        for (int j = 1; j < i; j++)
+        {
+          OGRCoordinateTransformation::DestroyCT(transforms[j]);
+        }
+        OGRCoordinateTransformation::DestroyCT(t);
+        throw HootException(QString("Error creating transformation object: ") +
+                            CPLGetLastErrorMsg());
       }
-      else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+    }
+
+    const size_t shardSize = (total + threadCount - 1) / threadCount;
+    vector<boost::shared_ptr<ReprojectShardWorker> > workers;
+    for (int i = 0; i < threadCount; i++)
+    {
+      const size_t begin = min(total, i * shardSize);
+      const size_t end = min(total, begin + shardSize);
+      workers.push_back(boost::shared_ptr<ReprojectShardWorker>(
+        new ReprojectShardWorker(transforms[i], x, y, begin, end)));
+      workers.back()->start();
+    }
+
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i]->wait();
+      if (workers[i]->hasFailure() && (failed == false || workers[i]->getFailedIndex() < failedIndex))
       {
-        LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+        failed = true;
+        failedIndex = workers[i]->getFailedIndex();
       }
-      logWarnCount++;
-      throw;
     }
 
-    n->setX(c.x);
-    n->setY(c.y);
-
-    if (count % 1000 == 0 && Log::getInstance().isInfoEnabled())
+    for (int i = 1; i < threadCount; i++)
     {
-      PROGRESS_DEBUG("Reprojecting " << count << " / " << nodes.size());
+      OGRCoordinateTransformation::DestroyCT(transforms[i]);
     }
-    count++;
   }
-  if (Log::getInstance().isInfoEnabled())
+  else
   {
-    cout << endl;
+    vector<int> success(std::min(total, batchSize));
+    for (size_t offset = 0; offset < total && failed == false; offset += batchSize)
+    {
+      const size_t n = std::min(batchSize, total - offset);
+      t->TransformEx(n, x + offset, y + offset, 0, &success[0]);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (success[i] == FALSE)
+        {
+          failed = true;
+          failedIndex = offset + i;
+          break;
+        }
+      }
+
+      PROGRESS_DEBUG("Reprojecting " << offset + n << " / " << total);
+    }
   }
 
+  if (failed)
+  {
+    if (logWarnCount < ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN("Failure projecting node: " <<
+               map->getNode(coords.getNodeIds()[failedIndex])->toString());
+    }
+    else if (logWarnCount == ConfigOptions().getLogWarnMessageLimit())
+    {
+      LOG_WARN(className() << ": " << Log::LOG_WARN_LIMIT_REACHED_MESSAGE);
+    }
+    logWarnCount++;
+    OGRCoordinateTransformation::DestroyCT(t);
+    throw IllegalArgumentException("Error projecting point. Is the point outside of the "
+                                   "projection's bounds?");
+  }
+
+  coords.applyToMap(*map);
+
   map->setProjection(ref);
 
   OGRCoordinateTransformation::DestroyCT(t);
@@ -606,17 +759,10 @@ void MapProjector::project(boost::shared_ptr<OsmMap> map, boost::shared_ptr<OGRS
 void MapProjector::project(const boost::shared_ptr<Geometry>& g,
   const boost::shared_ptr<OGRSpatialReference>& srs1, const boost::shared_ptr<OGRSpatialReference>& srs2)
 {
-  OGRCoordinateTransformation* t(OGRCreateCoordinateTransformation(srs1.get(), srs2.get()));
-
-  if (t == 0)
-  {
-    throw HootException(QString("Error creating transformation object: ") + CPLGetLastErrorMsg());
-  }
+  OGRCoordinateTransformation* t = getCachedTransformation(srs1, srs2);
 
   ReprojectCoordinateFilter filter(t);
   g->apply_rw(&filter);
-
-  OGRCoordinateTransformation::DestroyCT(t);
 }
 
 void MapProjector::projectToAeac(boost::shared_ptr<OsmMap> map)
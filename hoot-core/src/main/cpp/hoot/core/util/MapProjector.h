@@ -104,6 +104,18 @@ public:
     Radians maxAngleError = toRadians(2.0), Meters maxDistanceError = 10.0,
     Meters testDistance = 1000.0, bool warnOnFail = true);
 
+  /**
+   * Returns a shared transformation for the given source/target projection pair, creating and
+   * caching it on first use. Creating a transformation is expensive, so the single coordinate
+   * convenience functions reuse these rather than building one per call. The cache owns the
+   * returned object and keeps it for the life of the process; callers must not destroy it.
+   * Transformations are not thread safe, so callers that share one across threads must serialize
+   * access themselves.
+   */
+  static OGRCoordinateTransformation* getCachedTransformation(
+    const boost::shared_ptr<OGRSpatialReference>& srs1,
+    const boost::shared_ptr<OGRSpatialReference>& srs2);
+
   static MapProjector& getInstance();
 
   static bool isGeographic(const ConstElementProviderPtr& provider );
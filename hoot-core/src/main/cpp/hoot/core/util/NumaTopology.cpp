@@ -0,0 +1,167 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "NumaTopology.h"
+
+// hoot
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace hoot
+{
+
+namespace
+{
+
+/**
+ * Parses the sysfs cpulist format, e.g. "0-7,16-23".
+ */
+vector<int> parseCpuList(const QString& s)
+{
+  vector<int> result;
+  QStringList ranges = s.trimmed().split(",", QString::SkipEmptyParts);
+  for (int i = 0; i < ranges.size(); i++)
+  {
+    QStringList bounds = ranges[i].split("-");
+    bool ok1 = false;
+    bool ok2 = false;
+    if (bounds.size() == 1)
+    {
+      int cpu = bounds[0].toInt(&ok1);
+      if (ok1)
+      {
+        result.push_back(cpu);
+      }
+    }
+    else if (bounds.size() == 2)
+    {
+      int first = bounds[0].toInt(&ok1);
+      int last = bounds[1].toInt(&ok2);
+      if (ok1 && ok2)
+      {
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+          result.push_back(cpu);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+}
+
+NumaTopology& NumaTopology::getInstance()
+{
+  // the topology doesn't change while the process runs, so read it once.
+  static NumaTopology instance;
+  return instance;
+}
+
+NumaTopology::NumaTopology()
+{
+#ifdef __linux__
+  for (int node = 0; ; node++)
+  {
+    QFile file(QString("/sys/devices/system/node/node%1/cpulist").arg(node));
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+      break;
+    }
+    vector<int> cpus = parseCpuList(QString::fromUtf8(file.readAll()));
+    if (cpus.empty() == false)
+    {
+      _nodeCpus.push_back(cpus);
+    }
+  }
+#endif
+
+  if (_nodeCpus.empty())
+  {
+    // unknown topology; treat the host as one node so pinning degrades to a no-op.
+    _nodeCpus.resize(1);
+  }
+  else if (_nodeCpus.size() > 1)
+  {
+    LOG_DEBUG("Found " << _nodeCpus.size() << " NUMA nodes.");
+  }
+}
+
+const vector<int>& NumaTopology::getCpusForNode(int node) const
+{
+  return _nodeCpus[node % _nodeCpus.size()];
+}
+
+void NumaTopology::pinCurrentThreadToNode(int node) const
+{
+#ifdef __linux__
+  const vector<int>& cpus = getCpusForNode(node);
+  if (cpus.empty())
+  {
+    return;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (size_t i = 0; i < cpus.size(); i++)
+  {
+    CPU_SET(cpus[i], &mask);
+  }
+  // with a zero pid this applies to the calling thread only.
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0)
+  {
+    LOG_DEBUG("Failed setting the thread affinity for NUMA node " << node << ".");
+  }
+#else
+  (void)node;
+#endif
+}
+
+void NumaTopology::unpinCurrentThread() const
+{
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+  for (long i = 0; i < cpuCount; i++)
+  {
+    CPU_SET((int)i, &mask);
+  }
+  sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+}
+
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef NUMATOPOLOGY_H
+#define NUMATOPOLOGY_H
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Reads the host's NUMA node topology (from Linux sysfs) and pins threads to nodes. On single
+ * node hosts, or on platforms where the topology can't be read, everything degrades to one node
+ * covering all CPUs and pinning becomes a no-op, so callers don't need platform checks of their
+ * own.
+ *
+ * Pinning a worker to the node that owns its shard keeps the shard's working set (and anything
+ * the worker allocates - Linux places pages on the allocating thread's node by default) local
+ * to one socket instead of bouncing across the interconnect.
+ */
+class NumaTopology
+{
+public:
+
+  static NumaTopology& getInstance();
+
+  /**
+   * Returns the number of NUMA nodes, or 1 when the topology can't be read.
+   */
+  int getNodeCount() const { return (int)_nodeCpus.size(); }
+
+  /**
+   * Returns the CPU ids belonging to the given node.
+   */
+  const std::vector<int>& getCpusForNode(int node) const;
+
+  /**
+   * Restricts the calling thread to the CPUs of the given node. A no-op when the topology is
+   * unknown or the platform doesn't support thread affinity.
+   */
+  void pinCurrentThreadToNode(int node) const;
+
+  /**
+   * Removes any CPU restriction placed by pinCurrentThreadToNode.
+   */
+  void unpinCurrentThread() const;
+
+private:
+
+  NumaTopology();
+
+  // CPU ids per node; always has at least one entry.
+  std::vector< std::vector<int> > _nodeCpus;
+};
+
+}
+
+#endif // NUMATOPOLOGY_H
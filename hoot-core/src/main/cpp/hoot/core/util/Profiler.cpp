@@ -0,0 +1,204 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "Profiler.h"
+
+// Hoot
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Log.h>
+
+// Qt
+#include <QMutexLocker>
+
+// Standard
+#include <iostream>
+
+// Tgs
+#include <tgs/System/SystemInfo.h>
+#include <tgs/System/Time.h>
+
+using namespace std;
+
+namespace hoot
+{
+
+Profiler* Profiler::_theInstance = 0;
+
+Profiler::Profiler()
+{
+  _enabled = false;
+  _enabledSet = false;
+}
+
+Profiler& Profiler::getInstance()
+{
+  if (_theInstance == 0)
+  {
+    _theInstance = new Profiler();
+  }
+  return *_theInstance;
+}
+
+bool Profiler::isEnabled()
+{
+  if (_enabledSet == false)
+  {
+    // the first scope runs well after the command line configuration has been parsed, so the
+    // cached value reflects the job's settings.
+    _enabled = ConfigOptions().getProfilerEnabled();
+    _enabledSet = true;
+  }
+  return _enabled;
+}
+
+Profiler::ThreadState* Profiler::_getThreadState()
+{
+  if (_threadState.hasLocalData() == false)
+  {
+    ThreadState* s = new ThreadState();
+    s->root.reset(new Node());
+    s->current = s->root.get();
+    {
+      QMutexLocker locker(&_mutex);
+      _roots.push_back(s->root);
+    }
+    _threadState.setLocalData(s);
+  }
+  return _threadState.localData();
+}
+
+void Profiler::startScope(const QString& name)
+{
+  ThreadState* s = _getThreadState();
+  boost::shared_ptr<Node>& child = s->current->children[name];
+  if (child.get() == 0)
+  {
+    child.reset(new Node());
+    child->name = name;
+    child->parent = s->current;
+  }
+  child->calls++;
+  child->start = Tgs::Time::getTime();
+  s->current = child.get();
+}
+
+void Profiler::endScope()
+{
+  ThreadState* s = _getThreadState();
+  if (s->current->parent == 0)
+  {
+    // unbalanced; an exception may have skipped the start. Don't make it worse.
+    return;
+  }
+  s->current->total += Tgs::Time::getTime() - s->current->start;
+  s->current = s->current->parent;
+}
+
+QString Profiler::getReport()
+{
+  // merge the per thread trees by label so worker threads running the same phase show up as one
+  // line.
+  Node merged;
+  {
+    QMutexLocker locker(&_mutex);
+    for (size_t i = 0; i < _roots.size(); i++)
+    {
+      _mergeInto(merged, *_roots[i]);
+    }
+  }
+  if (merged.children.empty())
+  {
+    return QString();
+  }
+
+  double reportTotal = 0.0;
+  for (map<QString, boost::shared_ptr<Node> >::const_iterator it = merged.children.begin();
+       it != merged.children.end(); ++it)
+  {
+    reportTotal += it->second->total;
+  }
+
+  QString result = "Profiling report (wall time):\n";
+  for (map<QString, boost::shared_ptr<Node> >::const_iterator it = merged.children.begin();
+       it != merged.children.end(); ++it)
+  {
+    _writeNode(result, *it->second, reportTotal, 1);
+  }
+  result += QString("  %1\n").arg(
+    QString::fromStdString(Tgs::SystemInfo::getMemoryUsageString()));
+  return result;
+}
+
+void Profiler::report()
+{
+  if (isEnabled() == false)
+  {
+    return;
+  }
+  QString r = getReport();
+  if (r.isEmpty() == false)
+  {
+    cout << r.toStdString();
+  }
+}
+
+void Profiler::_mergeInto(Node& dest, const Node& src)
+{
+  dest.calls += src.calls;
+  dest.total += src.total;
+  for (map<QString, boost::shared_ptr<Node> >::const_iterator it = src.children.begin();
+       it != src.children.end(); ++it)
+  {
+    boost::shared_ptr<Node>& child = dest.children[it->first];
+    if (child.get() == 0)
+    {
+      child.reset(new Node());
+      child->name = it->second->name;
+      child->parent = &dest;
+    }
+    _mergeInto(*child, *it->second);
+  }
+}
+
+void Profiler::_writeNode(QString& result, const Node& n, double reportTotal, int depth)
+{
+  const double percent = reportTotal > 0.0 ? n.total / reportTotal * 100.0 : 0.0;
+  QString label = QString(depth * 2, ' ') + n.name;
+  result += QString("%1 %2s %3% %4 %5\n")
+      .arg(label, -42)
+      .arg(n.total, 9, 'f', 2)
+      .arg(percent, 5, 'f', 1)
+      .arg(n.calls, 8)
+      .arg(n.calls == 1 ? "call" : "calls");
+
+  for (map<QString, boost::shared_ptr<Node> >::const_iterator it = n.children.begin();
+       it != n.children.end(); ++it)
+  {
+    _writeNode(result, *it->second, reportTotal, depth + 1);
+  }
+}
+
+}
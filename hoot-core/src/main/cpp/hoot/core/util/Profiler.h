@@ -0,0 +1,154 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+// Qt
+#include <QMutex>
+#include <QString>
+#include <QThreadStorage>
+
+// Standard
+#include <map>
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Aggregates wall times from the ProfileScope instrumentation in the major phases of conflation
+ * and I/O and renders them as a hierarchical report at the end of a job.
+ *
+ * The scopes are always compiled in; whether they record anything is controlled by
+ * profiler.enabled. A disabled scope costs a single boolean check, so the instrumentation can
+ * stay on production code paths where perf/valgrind aren't an option.
+ *
+ * Scopes nest: a scope started while another is active on the same thread becomes its child in
+ * the report, and repeated entries into the same label aggregate their call count and total
+ * time. Each thread gets its own scope stack; the report merges the per thread trees by label,
+ * so worker threads running the same phase show up as one line with many calls.
+ */
+class Profiler
+{
+public:
+
+  static Profiler& getInstance();
+
+  /**
+   * Lazily reads profiler.enabled on first use and caches it, so the check a disabled scope
+   * pays afterwards is a single boolean.
+   */
+  bool isEnabled();
+
+  void startScope(const QString& name);
+
+  void endScope();
+
+  /**
+   * Returns the hierarchical report as text. Empty if nothing was recorded.
+   */
+  QString getReport();
+
+  /**
+   * Prints the report to standard out if profiling is enabled and anything was recorded. Called
+   * at the end of a job.
+   */
+  void report();
+
+private:
+
+  struct Node
+  {
+    QString name;
+    long calls;
+    double total;
+    double start;
+    Node* parent;
+    std::map<QString, boost::shared_ptr<Node> > children;
+
+    Node() : calls(0), total(0.0), start(0.0), parent(0) {}
+  };
+
+  struct ThreadState
+  {
+    boost::shared_ptr<Node> root;
+    Node* current;
+  };
+
+  static Profiler* _theInstance;
+
+  bool _enabled;
+  bool _enabledSet;
+  QMutex _mutex;
+  /// keeps every thread's tree alive past thread exit; QThreadStorage deletes only the state.
+  std::vector< boost::shared_ptr<Node> > _roots;
+  QThreadStorage<ThreadState*> _threadState;
+
+  Profiler();
+
+  ThreadState* _getThreadState();
+
+  static void _mergeInto(Node& dest, const Node& src);
+  static void _writeNode(QString& result, const Node& n, double reportTotal, int depth);
+};
+
+/**
+ * Times the enclosing block into the Profiler under the given label. See Profiler for the
+ * nesting and threading semantics.
+ */
+class ProfileScope
+{
+public:
+
+  ProfileScope(const QString& name)
+  {
+    _active = Profiler::getInstance().isEnabled();
+    if (_active)
+    {
+      Profiler::getInstance().startScope(name);
+    }
+  }
+
+  ~ProfileScope()
+  {
+    if (_active)
+    {
+      Profiler::getInstance().endScope();
+    }
+  }
+
+private:
+
+  bool _active;
+};
+
+}
+
+#endif // PROFILER_H
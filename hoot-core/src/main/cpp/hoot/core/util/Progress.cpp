@@ -34,11 +34,33 @@ using namespace std;
 
 // Hoot includes
 #include "Progress.h"
+#include <hoot/core/util/ConfigOptions.h>
+#include <hoot/core/util/Log.h>
+
+// Tgs includes
+#include <tgs/System/SystemInfo.h>
 
 
 namespace hoot
 {
 
+long Progress::_memoryHighWater = 0;
+
+void Progress::_checkMemoryHighWater()
+{
+  if (ConfigOptions().getProgressLogMemoryHighWater() == false)
+  {
+    return;
+  }
+  long rss = Tgs::SystemInfo::getPhysicalMemoryUsage();
+  if (rss > _memoryHighWater)
+  {
+    _memoryHighWater = rss;
+    LOG_INFO("Memory high-water mark: " << Tgs::SystemInfo::humanReadable(rss) << " (" <<
+             _source << ")");
+  }
+}
+
 // constructor
 Progress::Progress(QString source = "")
 {
@@ -99,6 +121,7 @@ void Progress::set(float percentComplete, QString state, bool jobFinished, QStri
       cout << getMessage().toStdString() << endl;
     }
   }
+  _checkMemoryHighWater();
 }
 
 // set from relative values updates the absolute values automatically
@@ -119,6 +142,7 @@ void Progress::setFromRelative(float relativePercentComplete, QString state, boo
       cout << getMessage().toStdString() << endl;
     }
   }
+  _checkMemoryHighWater();
 }
 
 /////////////////////////////////
@@ -94,6 +94,11 @@ protected:
 
   // processing for getMessage() to send messages when a metric met (for now every 0.1 units)
   bool _readyToSend();
+
+  // logs the process resident set size whenever a new session high is reached; enabled with
+  // progress.log.memory.high.water. The mark is process wide so all Progress instances share it.
+  void _checkMemoryHighWater();
+  static long _memoryHighWater;
 };
 
 } // end namespace hoot
@@ -161,6 +161,7 @@ void Settings::clear()
     LOG_DEBUG("Clearing global settings.");
   }
   _settings.clear();
+  _notifyChangeListeners(QString());
 }
 
 QVariant Settings::get(const QString& key) const
@@ -663,6 +664,45 @@ void Settings::set(const QString& key, const QStringList &value)
 void Settings::set(const QString& key, const QString& value)
 {
   _settings[key] = _replaceStaticVariables(value);
+  _notifyChangeListeners(key);
+}
+
+void Settings::set(const QString& key, double value)
+{
+  _settings[key] = QVariant(value);
+  _notifyChangeListeners(key);
+}
+
+void Settings::set(const QString& key, int value)
+{
+  _settings[key] = QVariant(value);
+  _notifyChangeListeners(key);
+}
+
+void Settings::registerChangeListener(SettingsChangeListener* listener)
+{
+  _changeListeners.push_back(listener);
+}
+
+void Settings::removeChangeListener(SettingsChangeListener* listener)
+{
+  for (vector<SettingsChangeListener*>::iterator it = _changeListeners.begin();
+       it != _changeListeners.end(); ++it)
+  {
+    if (*it == listener)
+    {
+      _changeListeners.erase(it);
+      break;
+    }
+  }
+}
+
+void Settings::_notifyChangeListeners(const QString& key)
+{
+  for (size_t i = 0; i < _changeListeners.size(); i++)
+  {
+    _changeListeners[i]->settingsChanged(key);
+  }
 }
 
 void Settings::storeJson(const QString& path) const
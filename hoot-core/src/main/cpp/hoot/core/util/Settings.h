@@ -38,10 +38,31 @@
 // Standard
 #include <set>
 #include <string>
+#include <vector>
 
 namespace hoot
 {
 
+/**
+ * Implementers are notified when a settings value changes. Long lived objects that copy their
+ * options into plain members at construction (the usual pattern for per element code paths, since
+ * a string keyed lookup is too slow to sit inside a loop) can re-copy when notified instead of
+ * going back to Settings on every use. Notification happens on the thread that mutates the
+ * settings; settings should not be mutated while worker threads are reading them.
+ */
+class SettingsChangeListener
+{
+public:
+
+  virtual ~SettingsChangeListener() {}
+
+  /**
+   * Called after one or more settings values change. key is the changed key, or an empty string
+   * when many values may have changed at once (e.g. clear()).
+   */
+  virtual void settingsChanged(const QString& key) = 0;
+};
+
 /**
  * @defgroup properties Configuration Properties
  * @page Configuration Properties
@@ -145,15 +166,23 @@ public:
    */
   static void parseCommonArguments(QStringList &args);
 
+  /**
+   * Registers a listener that gets called back whenever a settings value changes. The caller
+   * retains ownership and must call removeChangeListener before the listener is destroyed.
+   */
+  void registerChangeListener(SettingsChangeListener* listener);
+
+  void removeChangeListener(SettingsChangeListener* listener);
+
   void set(const QString& key, const char* value) { set(key, QString(value)); }
 
   void set(const QString& key, const std::string& value) { set(key, QString::fromStdString(value)); }
 
   void set(const QString& key, const QString& value);
 
-  void set(const QString& key, double value) { _settings[key] = QVariant(value); }
+  void set(const QString& key, double value);
 
-  void set(const QString& key, int value) { _settings[key] = QVariant(value); }
+  void set(const QString& key, int value);
 
   void set(const QString& key, bool value) { set(key, value ? "true" : "false"); }
 
@@ -166,6 +195,7 @@ public:
 private:
   static Settings* _theInstance;
   SettingsMap _settings;
+  std::vector<SettingsChangeListener*> _changeListeners;
   /// matches variables in the form ${My_Var_1}
   QRegExp _dynamicRegex;
   /// matches variables in the form $(My_Var_1)
@@ -182,6 +212,8 @@ private:
 
   void _checkConvert(const QString& key, const QVariant& value, QVariant::Type type) const;
 
+  void _notifyChangeListeners(const QString& key);
+
   QString _replaceStaticVariables(QString value) const;
 
   QString _replaceVariables(const QString& key, std::set<QString> used) const;
@@ -32,6 +32,7 @@
 #include <boost/pool/pool_alloc.hpp>
 
 // Hoot
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Log.h>
 
 // Standard
@@ -41,36 +42,132 @@ namespace hoot
 {
 
 /**
- * A super simple wrapper around boost's object pool and shared pointers. This should provide
- * more efficient allocation/deleting when dealing with large numbers of elements. E.g. nodes.
+ * A pool for allocating large numbers of shared objects. E.g. nodes.
+ *
+ * Two allocation strategies are supported:
+ *
+ *  - The default free list strategy wraps boost's pool allocator. Objects are allocated
+ *    individually and each gets its own shared pointer control block, but allocations avoid most
+ *    of the heap fragmentation and bookkeeping overhead of plain new/delete.
+ *  - The arena strategy (element.pool.arena.enabled) carves objects out of large contiguous
+ *    blocks. All the objects in a block share a single control block, which makes traversals over
+ *    large maps cache-linear and drops the allocation count by the block size (see
+ *    element.pool.arena.block.size). The cost is that a block's memory isn't reclaimed until the
+ *    last object allocated from it is released, so this is best suited to mostly read-only
+ *    workloads such as loading and traversing large extracts.
+ *
+ * The strategy is read from the configuration on first allocation and is fixed for the life of
+ * the process.
  */
 template <class T>
 class SharedPtrPool
 {
 public:
 
-  SharedPtrPool() {}
+  SharedPtrPool() : _strategyResolved(false), _useArenas(false), _arenaBlockSize(0) {}
 
   boost::shared_ptr<T> allocate()
   {
-    T* v = new (_pool.allocate()) T();
+    if (_strategyResolved == false)
+    {
+      _resolveStrategy();
+    }
+
+    if (_useArenas)
+    {
+      if (!_arena || _arena->isFull())
+      {
+        _arena.reset(new _Arena(_arenaBlockSize));
+      }
+      // The aliasing constructor shares the arena's control block, keeping the whole block alive
+      // until the last object allocated from it is released.
+      return boost::shared_ptr<T>(_arena, _arena->construct());
+    }
+    else
+    {
+      T* v = new (_pool.allocate()) T();
 
-    return boost::shared_ptr<T>(v,
-      boost::bind(&SharedPtrPool<T>::_destroy, this, _1));
+      return boost::shared_ptr<T>(v,
+        boost::bind(&SharedPtrPool<T>::_destroy, this, _1));
+    }
   }
 
   static SharedPtrPool<T>& getInstance() { return _theInstance; }
 
 private:
 
+  /**
+   * A fixed size block of contiguous, uninitialized storage. Objects are constructed in place,
+   * front to back, and are all destroyed when the arena is destroyed.
+   */
+  class _Arena
+  {
+  public:
+
+    _Arena(size_t size) :
+      _storage(static_cast<T*>(::operator new(sizeof(T) * size))),
+      _constructed(0),
+      _size(size)
+    {
+    }
+
+    ~_Arena()
+    {
+      for (size_t i = 0; i < _constructed; ++i)
+      {
+        _storage[i].~T();
+      }
+      ::operator delete(_storage);
+    }
+
+    T* construct()
+    {
+      assert(_constructed < _size);
+      T* v = new (_storage + _constructed) T();
+      ++_constructed;
+      return v;
+    }
+
+    bool isFull() const { return _constructed >= _size; }
+
+  private:
+
+    T* _storage;
+    size_t _constructed;
+    size_t _size;
+  };
+
   static SharedPtrPool<T> _theInstance;
   boost::fast_pool_allocator<T> _pool;
+  boost::shared_ptr<_Arena> _arena;
+  bool _strategyResolved;
+  bool _useArenas;
+  size_t _arenaBlockSize;
 
   void _destroy(T* v)
   {
     _pool.destroy(v);
     _pool.deallocate(v);
   }
+
+  void _resolveStrategy()
+  {
+    ConfigOptions opts;
+    _useArenas = opts.getElementPoolArenaEnabled();
+    // validate before assigning; a negative value would wrap when stored in the size_t member
+    const int configuredBlockSize = opts.getElementPoolArenaBlockSize();
+    if (configuredBlockSize < 1)
+    {
+      LOG_WARN("Invalid " << ConfigOptions::getElementPoolArenaBlockSizeKey() << " value: " <<
+               configuredBlockSize << ". Using the default.");
+      _arenaBlockSize = ConfigOptions::getElementPoolArenaBlockSizeDefaultValue();
+    }
+    else
+    {
+      _arenaBlockSize = configuredBlockSize;
+    }
+    _strategyResolved = true;
+  }
 };
 
 }
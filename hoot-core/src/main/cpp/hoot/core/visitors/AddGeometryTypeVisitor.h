@@ -28,11 +28,12 @@
 #define ADDGEOMETRYTYPEVISITOR_H
 
 #include "ElementOsmMapVisitor.h"
+#include "FusableVisitor.h"
 
 namespace hoot
 {
 
-class AddGeometryTypeVisitor : public ElementOsmMapVisitor
+class AddGeometryTypeVisitor : public ElementOsmMapVisitor, public FusableVisitor
 {
 public:
   static std::string className() { return "hoot::AddGeometryTypeVisitor"; }
@@ -30,6 +30,7 @@
 // hoot
 #include <hoot/core/ConstOsmMapConsumer.h>
 #include <hoot/core/elements/ConstElementVisitor.h>
+#include <hoot/core/visitors/FusableVisitor.h>
 
 namespace hoot
 {
@@ -38,7 +39,8 @@ namespace hoot
  * Adds a UUID with a specific key. If you want to limit the features that will be tagged then look
  * into FilteredVisitor.
  */
-class AddUuidVisitor : public ConstElementVisitor, public ConstOsmMapConsumer
+class AddUuidVisitor : public ConstElementVisitor, public ConstOsmMapConsumer,
+  public FusableVisitor
 {
 public:
 
@@ -32,6 +32,7 @@
 #include <hoot/core/ConstOsmMapConsumer.h>
 #include <hoot/core/elements/ConstElementVisitor.h>
 
+#include "ParallelVisitor.h"
 #include "SingleStatistic.h"
 
 namespace hoot
@@ -41,7 +42,8 @@ namespace hoot
  * Sums the length of all the ways. The map projection is used so to get meters the map must be
  * first reprojected into meters.
  */
-class CalculateAreaVisitor : public ConstElementVisitor, public ConstOsmMapConsumer, public SingleStatistic
+class CalculateAreaVisitor : public ConstElementVisitor, public ConstOsmMapConsumer,
+  public SingleStatistic, public ParallelVisitor
 {
 public:
 
@@ -51,6 +53,12 @@ public:
 
   virtual ~CalculateAreaVisitor() {}
 
+  virtual ConstElementVisitorPtr cloneForThread() const
+  { return ConstElementVisitorPtr(new CalculateAreaVisitor()); }
+
+  virtual void merge(const ConstElementVisitor& workerVisitor)
+  { _total += dynamic_cast<const CalculateAreaVisitor&>(workerVisitor)._total; }
+
   /**
    * Returns the area in meters squared.
    */
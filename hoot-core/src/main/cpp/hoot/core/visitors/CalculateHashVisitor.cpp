@@ -29,34 +29,74 @@
 // hoot
 #include <hoot/core/conflate/ReviewMarker.h>
 #include <hoot/core/schema/OsmSchema.h>
+#include <hoot/core/util/ConfigOptions.h>
 #include <hoot/core/util/Factory.h>
 #include <hoot/core/util/Log.h>
 
 // Qt
 #include <QCryptographicHash>
+#include <QThread>
+
+// Standard
+#include <algorithm>
+#include <cstring>
+#include <map>
 
 namespace hoot
 {
 
-HOOT_FACTORY_REGISTER(ConstElementVisitor, CalculateHashVisitor)
-
-CalculateHashVisitor::~CalculateHashVisitor()
+namespace
 {
-}
 
-QString CalculateHashVisitor::toJsonString(const ConstElementPtr& e)
+/**
+ * Bound snapshot of the comparison sensitivity options. toJsonString runs once per element, so
+ * the options are copied out of Settings once and refreshed on change rather than looked up by
+ * string key for every node.
+ */
+class ComparisonSensitivityOptions : public SettingsChangeListener
 {
-  if (e->getElementType() != ElementType::Node)
+public:
+
+  int circularErrorSensitivity;
+  int coordinateSensitivity;
+  // bumped whenever the sensitivity values change; element hash caches computed under an older
+  // epoch are treated as stale.
+  int epoch;
+
+  ComparisonSensitivityOptions()
   {
-    throw NotImplementedException("Only nodes are supported at this time.");
+    epoch = 0;
+    settingsChanged(QString());
+    conf().registerChangeListener(this);
   }
 
-  ConstNodePtr n = boost::dynamic_pointer_cast<const Node>(e);
+  virtual void settingsChanged(const QString& key)
+  {
+    if (key.isEmpty() ||
+        key == ConfigOptions::getNodeComparisonCircularErrorSensitivityKey() ||
+        key == ConfigOptions::getNodeComparisonCoordinateSensitivityKey())
+    {
+      ConfigOptions opts;
+      circularErrorSensitivity = opts.getNodeComparisonCircularErrorSensitivity();
+      coordinateSensitivity = opts.getNodeComparisonCoordinateSensitivity();
+      epoch++;
+    }
+  }
+};
 
-  QString result = "{\"type\":\"Feature\",\"properties\":{\"type\":\"node\",\"tags\":{";
+const ComparisonSensitivityOptions& _comparisonSensitivityOptions()
+{
+  static ComparisonSensitivityOptions opts;
+  return opts;
+}
 
-  // put the tags into an ordered map that only contains the non-metadata (info) tags. As
-  // implemented this is likely quite slow.
+/**
+ * The non-metadata tags that take part in the hash, ordered, with the rounded circular error
+ * folded in. One definition shared by the JSON and packed representations so their equivalence
+ * classes can't drift apart.
+ */
+QMap<QString, QString> collectInfoTags(const ConstElementPtr& e)
+{
   QMap<QString, QString> infoTags;
   foreach (QString key, e->getTags().keys())
   {
@@ -67,13 +107,174 @@ QString CalculateHashVisitor::toJsonString(const ConstElementPtr& e)
     }
   }
 
-  if (n->getRawCircularError() >= 0)
+  if (e->getRawCircularError() >= 0)
   {
     infoTags["error:circular"] =
       QString::number(
-        n->getRawCircularError(), 'g', ConfigOptions().getNodeComparisonCircularErrorSensitivity());
+        e->getRawCircularError(), 'g',
+        _comparisonSensitivityOptions().circularErrorSensitivity);
+  }
+
+  return infoTags;
+}
+
+quint64 rotl64(quint64 x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+quint64 fmix64(quint64 k)
+{
+  k ^= k >> 33;
+  k *= Q_UINT64_C(0xff51afd7ed558ccd);
+  k ^= k >> 33;
+  k *= Q_UINT64_C(0xc4ceb9fe1a85ec53);
+  k ^= k >> 33;
+  return k;
+}
+
+/**
+ * MurmurHash3 x64 128 (Austin Appleby, public domain). Fixed here rather than borrowed so the
+ * dedup path has no external dependency; the result is only ever compared in-process.
+ */
+void murmurHash3_x64_128(const char* data, int len, quint64& h1Out, quint64& h2Out)
+{
+  const int nblocks = len / 16;
+  quint64 h1 = 0;
+  quint64 h2 = 0;
+  const quint64 c1 = Q_UINT64_C(0x87c37b91114253d5);
+  const quint64 c2 = Q_UINT64_C(0x4cf5ad432745937f);
+
+  for (int i = 0; i < nblocks; i++)
+  {
+    quint64 k1;
+    quint64 k2;
+    memcpy(&k1, data + i * 16, 8);
+    memcpy(&k2, data + i * 16 + 8, 8);
+
+    k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+    k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+    h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  const unsigned char* tail = (const unsigned char*)(data + nblocks * 16);
+  quint64 k1 = 0;
+  quint64 k2 = 0;
+  switch (len & 15)
+  {
+  case 15: k2 ^= (quint64)tail[14] << 48;
+  case 14: k2 ^= (quint64)tail[13] << 40;
+  case 13: k2 ^= (quint64)tail[12] << 32;
+  case 12: k2 ^= (quint64)tail[11] << 24;
+  case 11: k2 ^= (quint64)tail[10] << 16;
+  case 10: k2 ^= (quint64)tail[9] << 8;
+  case 9: k2 ^= (quint64)tail[8];
+    k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+  case 8: k1 ^= (quint64)tail[7] << 56;
+  case 7: k1 ^= (quint64)tail[6] << 48;
+  case 6: k1 ^= (quint64)tail[5] << 40;
+  case 5: k1 ^= (quint64)tail[4] << 32;
+  case 4: k1 ^= (quint64)tail[3] << 24;
+  case 3: k1 ^= (quint64)tail[2] << 16;
+  case 2: k1 ^= (quint64)tail[1] << 8;
+  case 1: k1 ^= (quint64)tail[0];
+    k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
   }
 
+  h1 ^= (quint64)len;
+  h2 ^= (quint64)len;
+  h1 += h2;
+  h2 += h1;
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+  h1 += h2;
+  h2 += h1;
+
+  h1Out = h1;
+  h2Out = h2;
+}
+
+/**
+ * Hashes a contiguous shard of the element list, populating each element's hash cache.
+ */
+class HashShardWorker : public QThread
+{
+public:
+
+  HashShardWorker(const std::vector<ConstElementPtr>& elements, size_t begin, size_t end) :
+    _elements(elements),
+    _begin(begin),
+    _end(end)
+  {
+  }
+
+  virtual void run()
+  {
+    for (size_t i = _begin; i < _end; i++)
+    {
+      CalculateHashVisitor::toHash(_elements[i]);
+    }
+  }
+
+private:
+
+  const std::vector<ConstElementPtr>& _elements;
+  size_t _begin;
+  size_t _end;
+};
+
+/**
+ * Fast hashes a contiguous shard of the element list into the shared result vector. The shards
+ * are disjoint, so no locking is needed.
+ */
+class FastHashShardWorker : public QThread
+{
+public:
+
+  FastHashShardWorker(const std::vector<ConstElementPtr>& elements,
+    std::vector< std::pair<quint64, quint64> >& hashes, size_t begin, size_t end) :
+    _elements(elements),
+    _hashes(hashes),
+    _begin(begin),
+    _end(end)
+  {
+  }
+
+  virtual void run()
+  {
+    for (size_t i = _begin; i < _end; i++)
+    {
+      _hashes[i] = CalculateHashVisitor::toFastHash(_elements[i]);
+    }
+  }
+
+private:
+
+  const std::vector<ConstElementPtr>& _elements;
+  std::vector< std::pair<quint64, quint64> >& _hashes;
+  size_t _begin;
+  size_t _end;
+};
+
+}
+
+HOOT_FACTORY_REGISTER(ConstElementVisitor, CalculateHashVisitor)
+
+CalculateHashVisitor::~CalculateHashVisitor()
+{
+}
+
+QString CalculateHashVisitor::toJsonString(const ConstElementPtr& e)
+{
+  QString result =
+    "{\"type\":\"Feature\",\"properties\":{\"type\":\"" +
+    e->getElementType().toString().toLower() + "\",\"tags\":{";
+
+  // put the tags into an ordered map that only contains the non-metadata (info) tags. As
+  // implemented this is likely quite slow.
+  QMap<QString, QString> infoTags = collectInfoTags(e);
+
   bool first = true;
   foreach (QString key, infoTags.keys())
   {
@@ -85,24 +286,296 @@ QString CalculateHashVisitor::toJsonString(const ConstElementPtr& e)
     first = false;
   }
 
-  result += "}},\"geometry\":{\"type\":\"Point\",\"coordinates\":[";
-  result +=
-    QString::number(n->getX(), 'f', ConfigOptions().getNodeComparisonCoordinateSensitivity());
-  result += ",";
-  result +=
-    QString::number(n->getY(), 'f', ConfigOptions().getNodeComparisonCoordinateSensitivity());
-  result += "]}}";
+  switch (e->getElementType().getEnum())
+  {
+  case ElementType::Node:
+    {
+      ConstNodePtr n = boost::dynamic_pointer_cast<const Node>(e);
+      result += "}},\"geometry\":{\"type\":\"Point\",\"coordinates\":[";
+      result +=
+        QString::number(n->getX(), 'f', _comparisonSensitivityOptions().coordinateSensitivity);
+      result += ",";
+      result +=
+        QString::number(n->getY(), 'f', _comparisonSensitivityOptions().coordinateSensitivity);
+      result += "]}}";
+      break;
+    }
+  case ElementType::Way:
+    {
+      // ways hash the IDs of the nodes they reference rather than resolved coordinates, so a
+      // way's hash changes exactly when the way's own content does and moving a member node only
+      // changes that node's hash
+      ConstWayPtr w = boost::dynamic_pointer_cast<const Way>(e);
+      result += "}},\"nodes\":[";
+      const std::vector<long>& nodeIds = w->getNodeIds();
+      for (size_t i = 0; i < nodeIds.size(); i++)
+      {
+        if (i > 0)
+        {
+          result += ",";
+        }
+        result += QString::number(nodeIds[i]);
+      }
+      result += "]}";
+      break;
+    }
+  case ElementType::Relation:
+    {
+      ConstRelationPtr r = boost::dynamic_pointer_cast<const Relation>(e);
+      result += "},\"relation:type\":\"" + r->getType() + "\"},\"members\":[";
+      const std::vector<RelationData::Entry>& members = r->getMembers();
+      for (size_t i = 0; i < members.size(); i++)
+      {
+        if (i > 0)
+        {
+          result += ",";
+        }
+        result +=
+          QString("{\"type\":\"%1\",\"id\":%2,\"role\":\"%3\"}")
+            .arg(members[i].getElementId().getType().toString().toLower())
+            .arg(members[i].getElementId().getId())
+            .arg(members[i].getRole());
+      }
+      result += "]}";
+      break;
+    }
+  default:
+    throw IllegalArgumentException("Unexpected element type.");
+  }
 
   return result;
 }
 
 QByteArray CalculateHashVisitor::toHash(const ConstElementPtr& e)
 {
+  const ComparisonSensitivityOptions& opts = _comparisonSensitivityOptions();
+  if (e->getCachedHash().isEmpty() == false && e->getCachedHashEpoch() == opts.epoch)
+  {
+    return e->getCachedHash();
+  }
+
   QCryptographicHash hash(QCryptographicHash::Sha1);
 
   hash.addData(toJsonString(e).toAscii().constData());
 
-  return hash.result();
+  const QByteArray result = hash.result();
+  e->setCachedHash(result, opts.epoch);
+  return result;
+}
+
+void CalculateHashVisitor::calculateHashes(const boost::shared_ptr<OsmMap>& map)
+{
+  std::vector<ConstElementPtr> elements;
+  elements.reserve(map->getNodes().size() + map->getWays().size() + map->getRelations().size());
+  for (NodeMap::const_iterator it = map->getNodes().begin(); it != map->getNodes().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+  for (WayMap::const_iterator it = map->getWays().begin(); it != map->getWays().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+  for (RelationMap::const_iterator it = map->getRelations().begin();
+       it != map->getRelations().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+
+  const int threadCount =
+    std::max(1, std::min(ConfigOptions().getElementHashThreads(), (int)elements.size()));
+  if (threadCount == 1)
+  {
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      toHash(elements[i]);
+    }
+    return;
+  }
+
+  // force the lazily initialized singletons the workers share to initialize on this thread
+  // before sharding.
+  OsmSchema::getInstance();
+  _comparisonSensitivityOptions();
+
+  const size_t shardSize = (elements.size() + threadCount - 1) / threadCount;
+  std::vector<HashShardWorker*> workers;
+  for (int i = 0; i < threadCount; i++)
+  {
+    const size_t begin = i * shardSize;
+    const size_t end = std::min(elements.size(), begin + shardSize);
+    workers.push_back(new HashShardWorker(elements, begin, end));
+    workers.back()->start();
+  }
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i]->wait();
+    delete workers[i];
+  }
+}
+
+QByteArray CalculateHashVisitor::toPackedString(const ConstElementPtr& e)
+{
+  const ComparisonSensitivityOptions& opts = _comparisonSensitivityOptions();
+  const QMap<QString, QString> infoTags = collectInfoTags(e);
+
+  QByteArray result;
+  result.append((char)e->getElementType().getEnum());
+  foreach (QString key, infoTags.keys())
+  {
+    result.append(key.toUtf8());
+    result.append('\0');
+    result.append(infoTags[key].toUtf8());
+    result.append('\0');
+  }
+
+  switch (e->getElementType().getEnum())
+  {
+  case ElementType::Node:
+    {
+      ConstNodePtr n = boost::dynamic_pointer_cast<const Node>(e);
+      // the rounded textual form, not the raw doubles, so the coordinate equivalence matches
+      // toJsonString.
+      result.append(QString::number(n->getX(), 'f', opts.coordinateSensitivity).toAscii());
+      result.append(',');
+      result.append(QString::number(n->getY(), 'f', opts.coordinateSensitivity).toAscii());
+      break;
+    }
+  case ElementType::Way:
+    {
+      ConstWayPtr w = boost::dynamic_pointer_cast<const Way>(e);
+      const std::vector<long>& nodeIds = w->getNodeIds();
+      for (size_t i = 0; i < nodeIds.size(); i++)
+      {
+        const qint64 id = nodeIds[i];
+        result.append((const char*)&id, sizeof(id));
+      }
+      break;
+    }
+  case ElementType::Relation:
+    {
+      ConstRelationPtr r = boost::dynamic_pointer_cast<const Relation>(e);
+      result.append(r->getType().toUtf8());
+      result.append('\0');
+      const std::vector<RelationData::Entry>& members = r->getMembers();
+      for (size_t i = 0; i < members.size(); i++)
+      {
+        result.append((char)members[i].getElementId().getType().getEnum());
+        const qint64 id = members[i].getElementId().getId();
+        result.append((const char*)&id, sizeof(id));
+        result.append(members[i].getRole().toUtf8());
+        result.append('\0');
+      }
+      break;
+    }
+  default:
+    throw IllegalArgumentException("Unexpected element type.");
+  }
+
+  return result;
+}
+
+std::pair<quint64, quint64> CalculateHashVisitor::toFastHash(const ConstElementPtr& e)
+{
+  const QByteArray packed = toPackedString(e);
+  std::pair<quint64, quint64> result;
+  murmurHash3_x64_128(packed.constData(), packed.size(), result.first, result.second);
+  return result;
+}
+
+std::vector< std::vector<ElementId> > CalculateHashVisitor::findDuplicates(
+  const boost::shared_ptr<const OsmMap>& map)
+{
+  std::vector<ConstElementPtr> elements;
+  elements.reserve(map->getNodes().size() + map->getWays().size() + map->getRelations().size());
+  for (NodeMap::const_iterator it = map->getNodes().begin(); it != map->getNodes().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+  for (WayMap::const_iterator it = map->getWays().begin(); it != map->getWays().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+  for (RelationMap::const_iterator it = map->getRelations().begin();
+       it != map->getRelations().end(); ++it)
+  {
+    elements.push_back(it->second);
+  }
+
+  std::vector< std::pair<quint64, quint64> > hashes(elements.size());
+  const int threadCount =
+    std::max(1, std::min(ConfigOptions().getElementHashThreads(), (int)elements.size()));
+  if (threadCount == 1)
+  {
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      hashes[i] = toFastHash(elements[i]);
+    }
+  }
+  else
+  {
+    // force the lazily initialized singletons the workers share to initialize on this thread
+    // before sharding.
+    OsmSchema::getInstance();
+    _comparisonSensitivityOptions();
+
+    const size_t shardSize = (elements.size() + threadCount - 1) / threadCount;
+    std::vector<FastHashShardWorker*> workers;
+    for (int i = 0; i < threadCount; i++)
+    {
+      const size_t begin = i * shardSize;
+      const size_t end = std::min(elements.size(), begin + shardSize);
+      workers.push_back(new FastHashShardWorker(elements, hashes, begin, end));
+      workers.back()->start();
+    }
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i]->wait();
+      delete workers[i];
+    }
+  }
+
+  std::map<std::pair<quint64, quint64>, std::vector<size_t> > byHash;
+  for (size_t i = 0; i < hashes.size(); i++)
+  {
+    byHash[hashes[i]].push_back(i);
+  }
+
+  std::vector< std::vector<ElementId> > result;
+  for (std::map<std::pair<quint64, quint64>, std::vector<size_t> >::const_iterator it =
+       byHash.begin(); it != byHash.end(); ++it)
+  {
+    const std::vector<size_t>& group = it->second;
+    if (group.size() < 2)
+    {
+      continue;
+    }
+    // verify hash-equal candidates against their packed content so a 128 bit collision can't
+    // produce a false duplicate.
+    std::map<QByteArray, std::vector<ElementId> > byContent;
+    for (size_t i = 0; i < group.size(); i++)
+    {
+      byContent[toPackedString(elements[group[i]])].push_back(
+        elements[group[i]]->getElementId());
+    }
+    for (std::map<QByteArray, std::vector<ElementId> >::iterator cit = byContent.begin();
+         cit != byContent.end(); ++cit)
+    {
+      if (cit->second.size() >= 2)
+      {
+        std::sort(cit->second.begin(), cit->second.end());
+        result.push_back(cit->second);
+      }
+    }
+  }
+
+  // the hash keyed grouping order isn't meaningful; report groups in element id order.
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void CalculateHashVisitor::restoreCachedHash(const ConstElementPtr& e, const QByteArray& hash)
+{
+  e->setCachedHash(hash, _comparisonSensitivityOptions().epoch);
 }
 
 void CalculateHashVisitor::visit(const ConstElementPtr& e)
@@ -114,6 +587,9 @@ void CalculateHashVisitor::visit(const ConstElementPtr& e)
 
     ElementPtr we = _map->getElement(e->getElementId());
     we->getTags()[MetadataTags::HootHash()] = "sha1sum:" + QString::fromUtf8(hash.toHex());
+    // the tag write dropped the cached hash, but the hash tag is metadata and not part of the
+    // hashed content.
+    restoreCachedHash(we, hash);
   }
 }
 
@@ -41,8 +41,12 @@ namespace hoot
  *
  * See this for details: https://github.com/ngageoint/hootenanny/issues/1663
  *
- * @todo This implementation only works for nodes and uses some hacked together string creation
- * code rather than re-using the GeoJson code in: https://github.com/ngageoint/hootenanny/pull/1658
+ * Nodes hash their info tags and coordinates; ways and relations hash their info tags and the
+ * IDs of the elements they reference, so a hash changes exactly when the element's own content
+ * does.
+ *
+ * @todo This implementation uses some hacked together string creation code rather than re-using
+ * the GeoJson code in: https://github.com/ngageoint/hootenanny/pull/1658
  * When #1658 is merged it probably makes sense to refactor this to use the GeoJSON writer.
  */
 class CalculateHashVisitor : public ConstElementVisitor, public OsmMapConsumer
@@ -59,8 +63,52 @@ public:
 
   static QString toJsonString(const ConstElementPtr& e);
 
+  /**
+   * Returns the element's content hash, reusing the element's cached hash when it is still
+   * current and computing and caching it otherwise.
+   */
   static QByteArray toHash(const ConstElementPtr& e);
 
+  /**
+   * Computes and caches content hashes for every element in the map, sharding the work across
+   * element.hash.threads worker threads. Only the per element hash caches are populated; no hash
+   * tags are written. Intended as a bulk pass right after initial load so later hash consumers
+   * hit the cache.
+   */
+  static void calculateHashes(const boost::shared_ptr<OsmMap>& map);
+
+  /**
+   * Returns a packed binary representation of the element's hashed content: the info tags plus
+   * rounded coordinates for nodes and referenced IDs for ways and relations. Two elements have
+   * equal packed representations exactly when toJsonString considers them equal; the packed form
+   * just skips the JSON formatting, making it much cheaper to build.
+   */
+  static QByteArray toPackedString(const ConstElementPtr& e);
+
+  /**
+   * Returns a fast non-cryptographic 128-bit hash of the element's packed representation. Unlike
+   * toHash this is not stable across processes and carries no collision resistance guarantee, so
+   * it must not be persisted or compared without a content check; it exists for in-process bulk
+   * dedup where SHA1 is the bottleneck.
+   */
+  static std::pair<quint64, quint64> toFastHash(const ConstElementPtr& e);
+
+  /**
+   * Finds groups of elements with identical hashed content, sharding the fast hashing across
+   * element.hash.threads worker threads. Hash-equal candidates are verified against their packed
+   * representations, so a fast hash collision can't produce a false duplicate. Each returned
+   * group holds two or more element IDs in ascending order; consumers (duplicate node/way
+   * removal, changeset skip) decide which member survives.
+   */
+  static std::vector< std::vector<ElementId> > findDuplicates(
+    const boost::shared_ptr<const OsmMap>& map);
+
+  /**
+   * Re-caches a hash that a mutation is known not to have changed, e.g. after writing the hash
+   * tag itself, which is metadata and not covered by the hash.
+   */
+  static void restoreCachedHash(const ConstElementPtr& e, const QByteArray& hash);
+
 private:
   OsmMap* _map;
 };
@@ -37,18 +37,38 @@ namespace hoot
 
 HOOT_FACTORY_REGISTER(ElementVisitor, CalculateHashVisitor2)
 
+CalculateHashVisitor2::CalculateHashVisitor2()
+{
+  _removeUuid = true;
+}
+
 CalculateHashVisitor2::~CalculateHashVisitor2()
 {
 }
 
+bool CalculateHashVisitor2::isUnchanged(const ConstElementPtr& e)
+{
+  const QString hash = e->getTags().get(MetadataTags::HootHash());
+  return hash.isEmpty() == false && hash == toHashString(e);
+}
+
+QString CalculateHashVisitor2::toHashString(const ConstElementPtr& e)
+{
+  return "sha1sum:" + QString::fromUtf8(CalculateHashVisitor::toHash(e).toHex());
+}
+
 void CalculateHashVisitor2::visit(const ElementPtr& e)
 {
-  if (e->getElementType() == ElementType::Node)
+  if (_removeUuid)
   {
     e->getTags().remove(Tags::uuidKey());
-    e->getTags()[MetadataTags::HootHash()] =
-      "sha1sum:" + QString::fromUtf8(CalculateHashVisitor::toHash(e).toHex());
   }
+  const QByteArray hash = CalculateHashVisitor::toHash(e);
+  e->getTags()[MetadataTags::HootHash()] =
+    "sha1sum:" + QString::fromUtf8(hash.toHex());
+  // the tag write dropped the cached hash, but the hash tag is metadata and not part of the
+  // hashed content.
+  CalculateHashVisitor::restoreCachedHash(e, hash);
 }
 
 }
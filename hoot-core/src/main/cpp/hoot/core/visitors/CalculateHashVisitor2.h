@@ -43,11 +43,35 @@ public:
 
   static std::string className() { return "hoot::CalculateHashVisitor2"; }
 
+  CalculateHashVisitor2();
+
   virtual ~CalculateHashVisitor2();
 
+  /**
+   * Returns true if the element carries a hash tag that still matches its current content. Tile
+   * workflows use this to recognize buffer zone geometry that an earlier tile already conflated
+   * and this tile left untouched.
+   */
+  static bool isUnchanged(const ConstElementPtr& e);
+
+  /**
+   * Returns the hash tag value for the element's current content.
+   */
+  static QString toHashString(const ConstElementPtr& e);
+
+  /**
+   * The multiary ingest workflow drops uuids before hashing; tile workflows keep them since
+   * review relations still reference them. Defaults to true.
+   */
+  void setRemoveUuid(bool remove) { _removeUuid = remove; }
+
   virtual void visit(const ElementPtr& e);
 
   virtual QString toString() { return "hoot::CalculateHashVisitor2"; }
+
+private:
+
+  bool _removeUuid;
 };
 
 }
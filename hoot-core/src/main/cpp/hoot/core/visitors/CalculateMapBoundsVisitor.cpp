@@ -26,6 +26,7 @@
  */
 
 #include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+#include <hoot/core/elements/PackedNodeCoordinates.h>
 #include <hoot/core/util/GeometryUtils.h>
 #include <hoot/core/visitors/SingleStatistic.h>
 
@@ -56,16 +57,14 @@ void CalculateMapBoundsVisitor::visit(const boost::shared_ptr<const Element>& e)
 // Convenient way to get bounds
 OGREnvelope CalculateMapBoundsVisitor::getBounds(const OsmMapPtr& map)
 {
-  CalculateMapBoundsVisitor v;
-  map->visitNodesRo(v);
-  return v.getBounds();
+  return getBounds(ConstOsmMapPtr(map));
 }
 
 OGREnvelope CalculateMapBoundsVisitor::getBounds(const ConstOsmMapPtr& map)
 {
-  CalculateMapBoundsVisitor v;
-  map->visitNodesRo(v);
-  return v.getBounds();
+  // Gathering the coordinates into flat arrays and taking the min/max in a single vectorizable
+  // pass is much faster than visiting each node through a shared pointer.
+  return PackedNodeCoordinates(*map).calculateBounds();
 }
 
 geos::geom::Envelope CalculateMapBoundsVisitor::getGeosBounds(const OsmMapPtr& map)
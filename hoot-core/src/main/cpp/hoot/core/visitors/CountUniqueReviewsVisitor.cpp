@@ -39,10 +39,14 @@ HOOT_FACTORY_REGISTER(ConstElementVisitor, CountUniqueReviewsVisitor)
 
 void CountUniqueReviewsVisitor::visit(const ConstElementPtr& e)
 {
-  set<ReviewMarker::ReviewUid> reviews =
-    ReviewMarker().getReviewUids(_map->shared_from_this(), e);
-
-  _reviews.insert(reviews.begin(), reviews.end());
+  // Each review is a single relation tagged as needing review, so it is enough to recognize the
+  // review relations as they stream by rather than resolving every element's parent relations.
+  // On review heavy outputs the parent lookups dominated this visitor's runtime.
+  if (e->getElementType() == ElementType::Relation &&
+      ReviewMarker::isReviewUid(_map->shared_from_this(), e->getElementId()))
+  {
+    _reviews.insert(e->getElementId());
+  }
 }
 
 }
@@ -29,7 +29,11 @@
 
 // hoot
 #include <hoot/core/elements/ConstElementVisitor.h>
+#include <hoot/core/elements/Node.h>
+#include <hoot/core/elements/Relation.h>
+#include <hoot/core/elements/Way.h>
 
+#include "ParallelVisitor.h"
 #include "SingleStatistic.h"
 
 namespace hoot
@@ -38,7 +42,8 @@ namespace hoot
 /**
  * Counts the number of elements.
  */
-class ElementCountVisitor : public ConstElementVisitor, public SingleStatistic
+class ElementCountVisitor : public ConstElementVisitor, public SingleStatistic,
+  public ParallelVisitor
 {
 public:
 
@@ -46,12 +51,24 @@ public:
 
   virtual ~ElementCountVisitor() {}
 
+  virtual ConstElementVisitorPtr cloneForThread() const
+  { return ConstElementVisitorPtr(new ElementCountVisitor()); }
+
   int getCount() const { return _count; }
 
   double getStat() const { return _count; }
 
+  virtual void merge(const ConstElementVisitor& workerVisitor)
+  { _count += dynamic_cast<const ElementCountVisitor&>(workerVisitor)._count; }
+
   virtual void visit(const ConstElementPtr& e);
 
+  //typed overloads for the templated OsmMap traversals; these are resolved at compile time, so
+  //the traversal loop counts with no virtual dispatch
+  void visit(const ConstNodePtr&) { _count++; }
+  void visit(const ConstWayPtr&) { _count++; }
+  void visit(const ConstRelationPtr&) { _count++; }
+
 private:
 
   int _count;
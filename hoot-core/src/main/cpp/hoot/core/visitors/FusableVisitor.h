@@ -0,0 +1,53 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef FUSABLEVISITOR_H
+#define FUSABLEVISITOR_H
+
+namespace hoot
+{
+
+/**
+ * Marker interface for visitors whose visit() decisions and mutations depend only on the
+ * element being visited. NamedOp composes consecutive configured visitors that implement this
+ * into a single map traversal rather than one full pass per visitor, which cuts the memory
+ * traffic of long cleaning chains.
+ *
+ * Do not implement this on a visitor that reads other elements to decide what to do with the
+ * current one (e.g. duplicate detection against neighbors) or that mutates elements other than
+ * the one being visited -- interleaving such a visitor with its neighbors per element can
+ * change its results.
+ */
+class FusableVisitor
+{
+public:
+
+  virtual ~FusableVisitor() {}
+};
+
+}
+
+#endif // FUSABLEVISITOR_H
@@ -0,0 +1,124 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef FUSEDVISITOR_H
+#define FUSEDVISITOR_H
+
+// hoot
+#include <hoot/core/ConstOsmMapConsumer.h>
+#include <hoot/core/elements/ConstElementVisitor.h>
+
+// Qt
+#include <QStringList>
+
+// Standard
+#include <time.h>
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Runs several visitors over each element in one traversal and records how much time each child
+ * visitor spends, so a fused chain still shows which stage dominates. The children are applied
+ * to each element in the order they were added, which only matches running them as separate
+ * passes when every child is a FusableVisitor -- NamedOp enforces that.
+ */
+class FusedVisitor : public ConstElementVisitor, public ConstOsmMapConsumer
+{
+public:
+
+  static std::string className() { return "hoot::FusedVisitor"; }
+
+  FusedVisitor() {}
+
+  virtual ~FusedVisitor() {}
+
+  void addVisitor(const ConstElementVisitorPtr& v, QString name)
+  {
+    _visitors.push_back(v);
+    _names.append(name);
+    _elapsed.push_back(0);
+  }
+
+  /**
+   * Returns one "name: elapsed" entry per child visitor for logging.
+   */
+  QString getTimingString() const
+  {
+    QStringList result;
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      result.append(QString("%1: %2ms").arg(_names[(int)i]).
+        arg((long)(_elapsed[i] * 1000 / CLOCKS_PER_SEC)));
+    }
+    return result.join(", ");
+  }
+
+  virtual void setOsmMap(OsmMap* map)
+  {
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      OsmMapConsumer* consumer = dynamic_cast<OsmMapConsumer*>(_visitors[i].get());
+      if (consumer != 0)
+      {
+        consumer->setOsmMap(map);
+      }
+    }
+  }
+
+  virtual void setOsmMap(const OsmMap* map)
+  {
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(_visitors[i].get());
+      if (consumer != 0)
+      {
+        consumer->setOsmMap(map);
+      }
+    }
+  }
+
+  virtual void visit(const ConstElementPtr& e)
+  {
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      const clock_t start = clock();
+      _visitors[i]->visit(e);
+      _elapsed[i] += clock() - start;
+    }
+  }
+
+private:
+
+  std::vector<ConstElementVisitorPtr> _visitors;
+  QStringList _names;
+  std::vector<clock_t> _elapsed;
+};
+
+}
+
+#endif // FUSEDVISITOR_H
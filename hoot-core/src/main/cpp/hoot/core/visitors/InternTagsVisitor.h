@@ -0,0 +1,56 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef INTERNTAGSVISITOR_H
+#define INTERNTAGSVISITOR_H
+
+#include "ElementOsmMapVisitor.h"
+
+namespace hoot
+{
+
+/**
+ * Replaces every element's tag strings with the TagDictionary's canonical instances.
+ *
+ * On tag heavy maps (POI data especially) most of the tag text is repeated, and interning makes
+ * each distinct string resident once instead of once per element. Readers see ordinary tags;
+ * copy on write preserves correctness if anything mutates them later. Intended to run right
+ * after load on read-mostly maps, e.g. ahead of multiary POI conflation.
+ */
+class InternTagsVisitor : public ElementOsmMapVisitor
+{
+public:
+
+  static std::string className() { return "hoot::InternTagsVisitor"; }
+
+  InternTagsVisitor();
+
+  virtual void visit(const boost::shared_ptr<Element>& e);
+};
+
+}
+
+#endif // INTERNTAGSVISITOR_H
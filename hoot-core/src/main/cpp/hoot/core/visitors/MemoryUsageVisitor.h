@@ -0,0 +1,84 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef MEMORYUSAGEVISITOR_H
+#define MEMORYUSAGEVISITOR_H
+
+// hoot
+#include <hoot/core/elements/ConstElementVisitor.h>
+
+#include "SingleStatistic.h"
+
+namespace hoot
+{
+
+/**
+ * Estimates the number of bytes of RAM the visited elements occupy, broken out by element type
+ * with the tag storage accounted separately.
+ *
+ * The numbers are estimates, not measurements. Container overheads are charged at typical
+ * glibc/Qt4 sizes and implicit sharing of QStrings is ignored (each reference is charged the
+ * full string), so the result errs a bit high. It is intended for capacity planning -- e.g.
+ * deciding whether a tile will fit in a worker -- not for leak hunting.
+ */
+class MemoryUsageVisitor : public ConstElementVisitor, public SingleStatistic
+{
+public:
+
+  static std::string className() { return "hoot::MemoryUsageVisitor"; }
+
+  MemoryUsageVisitor();
+
+  virtual ~MemoryUsageVisitor() {}
+
+  double getNodeBytes() const { return _nodeBytes; }
+
+  double getWayBytes() const { return _wayBytes; }
+
+  double getRelationBytes() const { return _relationBytes; }
+
+  double getTagBytes() const { return _tagBytes; }
+
+  /**
+   * Returns the total estimated bytes over all visited elements, including tags.
+   */
+  double getStat() const { return _nodeBytes + _wayBytes + _relationBytes + _tagBytes; }
+
+  virtual void visit(const ConstElementPtr& e);
+
+private:
+
+  double _nodeBytes;
+  double _wayBytes;
+  double _relationBytes;
+  double _tagBytes;
+
+  size_t _estimateQString(const QString& s) const;
+};
+
+}
+
+#endif // MEMORYUSAGEVISITOR_H
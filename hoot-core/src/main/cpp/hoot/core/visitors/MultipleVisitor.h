@@ -0,0 +1,84 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef MULTIPLEVISITOR_H
+#define MULTIPLEVISITOR_H
+
+// hoot
+#include <hoot/core/ConstOsmMapConsumer.h>
+#include <hoot/core/elements/ConstElementVisitor.h>
+
+// Standard
+#include <vector>
+
+namespace hoot
+{
+
+/**
+ * Forwards each visited element to every added visitor, so several independent statistics can be
+ * collected in a single map traversal instead of one traversal per visitor. The added visitors
+ * are not owned and must outlive the traversal.
+ */
+class MultipleVisitor : public ConstElementVisitor, public ConstOsmMapConsumer
+{
+public:
+
+  static std::string className() { return "hoot::MultipleVisitor"; }
+
+  MultipleVisitor() {}
+
+  virtual ~MultipleVisitor() {}
+
+  void addVisitor(ConstElementVisitor& v) { _visitors.push_back(&v); }
+
+  virtual void setOsmMap(const OsmMap* map)
+  {
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      ConstOsmMapConsumer* consumer = dynamic_cast<ConstOsmMapConsumer*>(_visitors[i]);
+      if (consumer != 0)
+      {
+        consumer->setOsmMap(map);
+      }
+    }
+  }
+
+  virtual void visit(const ConstElementPtr& e)
+  {
+    for (size_t i = 0; i < _visitors.size(); i++)
+    {
+      _visitors[i]->visit(e);
+    }
+  }
+
+private:
+
+  std::vector<ConstElementVisitor*> _visitors;
+};
+
+}
+
+#endif // MULTIPLEVISITOR_H
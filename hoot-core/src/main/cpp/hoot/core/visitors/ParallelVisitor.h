@@ -0,0 +1,64 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PARALLELVISITOR_H
+#define PARALLELVISITOR_H
+
+// hoot
+#include <hoot/core/elements/ConstElementVisitor.h>
+
+namespace hoot
+{
+
+/**
+ * Interface for read-only visitors that are side effect free and therefore safe to run over
+ * element shards on several threads at once. OsmMap::visitRoParallel gives each worker thread
+ * its own instance created by cloneForThread() and folds the per worker results back into the
+ * original visitor with merge() once all the workers finish.
+ *
+ * Implementations must not modify the map or any other shared state from visit().
+ */
+class ParallelVisitor
+{
+public:
+
+  virtual ~ParallelVisitor() {}
+
+  /**
+   * Creates a fresh visitor of the same type for one worker thread to accumulate into.
+   */
+  virtual ConstElementVisitorPtr cloneForThread() const = 0;
+
+  /**
+   * Folds the results accumulated by one worker's clone into this visitor. The workers are
+   * merged in shard order, so order sensitive results stay deterministic.
+   */
+  virtual void merge(const ConstElementVisitor& workerVisitor) = 0;
+};
+
+}
+
+#endif // PARALLELVISITOR_H
@@ -40,6 +40,7 @@ namespace hoot
 HOOT_FACTORY_REGISTER(ConstElementVisitor, RemoveElementsVisitor)
 
 RemoveElementsVisitor::RemoveElementsVisitor():
+  _batch(false),
   _count(0)
 {
   setConfiguration(conf());
@@ -48,6 +49,7 @@ RemoveElementsVisitor::RemoveElementsVisitor():
 RemoveElementsVisitor::RemoveElementsVisitor(const boost::shared_ptr<ElementCriterion>& filter) :
   _filter(filter),
   _recursive(false),
+  _batch(false),
   _count(0)
 {
 }
@@ -78,6 +80,10 @@ void RemoveElementsVisitor::visit(const ConstElementPtr& e)
     {
       RecursiveElementRemover(ee->getElementId()).apply(_map->shared_from_this());
     }
+    else if (_batch)
+    {
+      _map->scheduleRemoval(ElementId(type, id));
+    }
     else
     {
       RemoveElementOp::removeElement(_map->shared_from_this(), ElementId(type, id));
@@ -72,6 +72,14 @@ public:
 
   void setRecursive(bool recursive) { _recursive = recursive; }
 
+  /**
+   * When enabled, matching elements are scheduled on the map with OsmMap::scheduleRemoval
+   * rather than removed immediately; the caller must run OsmMap::commitRemovals() after the
+   * visit finishes. This pays the reference fix up and index maintenance cost once for the
+   * whole batch. Only honored for non-recursive removal.
+   */
+  void setBatchRemoval(bool batch) { _batch = batch; }
+
   static void removeWays(boost::shared_ptr<OsmMap> pMap,
                          const boost::shared_ptr<ElementCriterion>& pCrit);
 
@@ -82,6 +90,7 @@ private:
   OsmMap* _map;
   boost::shared_ptr<ElementCriterion> _filter;
   bool _recursive;
+  bool _batch;
   int _count;
 };
 
@@ -31,6 +31,7 @@
 #include <memory>
 
 #include "ElementOsmMapVisitor.h"
+#include "FusableVisitor.h"
 
 namespace hoot
 {
@@ -39,7 +40,7 @@ class ElementConverter;
 /**
  * Removes all "area" elements that have an area of zero.
  */
-class RemoveEmptyAreasVisitor : public ElementOsmMapVisitor
+class RemoveEmptyAreasVisitor : public ElementOsmMapVisitor, public FusableVisitor
 {
 public:
 
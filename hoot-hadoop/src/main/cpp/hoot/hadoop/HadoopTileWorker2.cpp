@@ -17,6 +17,7 @@
 #include "HadoopTileWorker2.h"
 
 // Hoot
+#include <hoot/core/conflate/NodeReplacements.h>
 #include <hoot/core/ops/OpList.h>
 #include <hoot/core/util/Log.h>
 #include <hoot/hadoop/conflate/ConflateDriver.h>
@@ -30,6 +31,9 @@
 #include <pp/Hdfs.h>
 #include <pp/mapreduce/Job.h>
 
+// Standard
+#include <memory>
+
 using namespace geos::geom;
 using namespace std;
 
@@ -44,6 +48,7 @@ HadoopTileWorker2::HadoopTileWorker2()
   pp::Hdfs fs;
   _workDir = QString::fromStdString(fs.getAbsolutePath(_workDir.toStdString()));
 
+  _finalPass = false;
   _initialized = false;
 //#warning to speed debugging
 //  pp::Job::setDefaultJobTracker("local");
@@ -54,6 +59,7 @@ void HadoopTileWorker2::applyOp(boost::shared_ptr<OsmMapOperation> op, const vec
 {
   TileOpDriver tod;
   tod.setOperation(op);
+  tod.setFinalPass(_finalPass);
   tod.apply(mapIn, tiles, _buffer, mapOut);
 }
 
@@ -144,6 +150,30 @@ MapStats HadoopTileWorker2::_calculateStats(QString in)
 
 void HadoopTileWorker2::cleanup(QString mapIn, QString mapOut)
 {
+  // The only work the no-op pass below does is remap way node references recorded in the
+  // replacement files. The tile passes already write disjoint id ranges (HadoopIdGenerator
+  // interleaves ids by task), so when no replacements are pending the tile outputs are directly
+  // concatenable and rewriting the whole dataset again would be wasted I/O.
+  if (_hasPendingReplacements(mapIn) == false)
+  {
+    LOG_INFO("No pending node replacements; publishing " << mapIn.toStdString() <<
+             " without a cleanup pass.");
+    pp::Hdfs fs;
+    fs.mkdirs(mapOut.toStdString());
+    vector<pp::FileStatus> s = fs.listStatus(mapIn.toStdString());
+    for (size_t i = 0; i < s.size(); i++)
+    {
+      QString fn = QString::fromStdString(s[i].getPath());
+      if (fn.endsWith(".pbf") || fn.endsWith(".stats"))
+      {
+        QString base = fn;
+        base.remove(QRegExp(".*/"));
+        fs.rename(fn.toStdString(), (mapOut + "/" + base).toStdString());
+      }
+    }
+    return;
+  }
+
   // By performing a no-op we effectively make sure all the final node replacements are executed.
   vector<Envelope> tiles;
   TileOpDriver tod;
@@ -153,6 +183,27 @@ void HadoopTileWorker2::cleanup(QString mapIn, QString mapOut)
   tod.apply(mapIn, tiles, _buffer, mapOut);
 }
 
+bool HadoopTileWorker2::_hasPendingReplacements(QString dir)
+{
+  pp::Hdfs fs;
+  vector<pp::FileStatus> s = fs.listStatus(dir.toStdString());
+  for (size_t i = 0; i < s.size(); i++)
+  {
+    QString fn = QString::fromStdString(s[i].getPath());
+    if (fn.endsWith(".replacement"))
+    {
+      NodeReplacements nr;
+      auto_ptr<istream> is(fs.open(s[i].getPath()));
+      nr.read(*is);
+      if (nr.getReplacements().size() > 0)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool HadoopTileWorker2::exists(QString dir)
 {
   pp::Hdfs fs;
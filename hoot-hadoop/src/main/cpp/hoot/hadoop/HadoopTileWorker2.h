@@ -57,9 +57,12 @@ public:
 
   virtual void rmdir(QString dir);
 
+  virtual void setFinalPass(bool finalPass) { _finalPass = finalPass; }
+
 private:
   QString _workDir;
   QString _in1, _in2;
+  bool _finalPass;
   bool _initialized;
   double _maxWaySize;
   double _pixelSize;
@@ -70,6 +73,12 @@ private:
   cv::Mat _r1, _r2;
 
   MapStats _calculateStats(QString in);
+
+  /**
+   * Returns true if any of the replacement files written by the last pass in dir still hold
+   * node replacements that haven't been applied to the data.
+   */
+  bool _hasPendingReplacements(QString dir);
 };
 
 }
@@ -76,6 +76,36 @@ void OsmMapMapper::emitRecord(HadoopPipes::MapContext& context, const std::strin
   context.emit(k, ss.str());
 }
 
+void OsmMapMapper::emitRecord(HadoopPipes::MapContext& context, const std::string& k,
+  const std::vector<ConstWayPtr>& ways)
+{
+  if (ways.size() == 0)
+  {
+    return;
+  }
+  std::stringstream ss(std::stringstream::out);
+  for (size_t i = 0; i < ways.size(); i++)
+  {
+    _OsmPbfWriter.writePb(ways[i], &ss);
+  }
+  context.emit(k, ss.str());
+}
+
+void OsmMapMapper::emitRecord(HadoopPipes::MapContext& context, const std::string& k,
+  const std::vector<ConstNodePtr>& nodes)
+{
+  if (nodes.size() == 0)
+  {
+    return;
+  }
+  std::stringstream ss(std::stringstream::out);
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    _OsmPbfWriter.writePb(nodes[i], &ss);
+  }
+  context.emit(k, ss.str());
+}
+
 void OsmMapMapper::_loadMap(OsmMapPtr& m)
 {
   OsmPbfReader reader(true);
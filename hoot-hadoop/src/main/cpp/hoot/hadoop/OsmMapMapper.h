@@ -47,6 +47,17 @@ public:
   void emitRecord(HadoopPipes::MapContext& context, const std::string& k,
     const ConstNodePtr& n);
 
+  /**
+   * Emits all the elements as a single shuffle record of concatenated length-prefixed pb blocks.
+   * When many elements share a key this is much cheaper than one record per element; the
+   * OsmMapReducer iterator parses batched records transparently.
+   */
+  void emitRecord(HadoopPipes::MapContext& context, const std::string& k,
+    const std::vector<ConstWayPtr>& ways);
+
+  void emitRecord(HadoopPipes::MapContext& context, const std::string& k,
+    const std::vector<ConstNodePtr>& nodes);
+
 protected:
   std::string _path;
   long _start;
@@ -54,6 +54,11 @@ public:
     stringstream ss(v, stringstream::in);
     _map->clear();
     _reader.parseElements(&ss, _map);
+    // batched records hold several concatenated length-prefixed blocks; consume them all.
+    while (ss.peek() != stringstream::traits_type::eof())
+    {
+      _reader.parseElements(&ss, _map);
+    }
     _hasNext = _context->nextValue();
     return _map;
   }
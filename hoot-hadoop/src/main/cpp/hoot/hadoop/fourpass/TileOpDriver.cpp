@@ -47,6 +47,7 @@ namespace hoot
 
 TileOpDriver::TileOpDriver()
 {
+  _finalPass = false;
 }
 
 void TileOpDriver::apply(QString in, vector<Envelope> envelopes, double buffer,
@@ -84,6 +85,7 @@ void TileOpDriver::apply(QString in, vector<Envelope> envelopes, double buffer,
     fs.getAbsolutePath(in.toStdString()));
   job.getConfiguration().setDouble(TileOpMapper::maxWaySizeKey(), buffer);
   job.getConfiguration().setDouble(TileOpMapper::bufferKey(), buffer);
+  job.getConfiguration().setInt(TileOpReducer::finalPassKey(), _finalPass ? 1 : 0);
 
   // read the max ids from in and write them to the configuration
   MapStats stats;
@@ -60,6 +60,13 @@ public:
    */
   void apply(QString in, std::vector<geos::geom::Envelope> envelopes, double buffer, QString out);
 
+  /**
+   * If set, the reducers won't fingerprint their output and will strip any fingerprints left by
+   * earlier passes. Set this on the last pass over the data; nothing reads the fingerprints
+   * after it.
+   */
+  void setFinalPass(bool finalPass) { _finalPass = finalPass; }
+
   /**
    * Sets the operation that will be applied to the map. This operation must also implement
    * serialiazable.
@@ -70,6 +77,7 @@ private:
 
   std::string _toString(const std::vector<geos::geom::Envelope>& e);
 
+  bool _finalPass;
   boost::shared_ptr<OsmMapOperation> _op;
 };
 
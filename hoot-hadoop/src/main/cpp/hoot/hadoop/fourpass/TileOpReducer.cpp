@@ -26,8 +26,11 @@
 #include <hoot/core/ops/Boundable.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 #include <hoot/core/util/GeometryUtils.h>
+#include <hoot/core/util/MetadataTags.h>
 #include <hoot/core/util/Settings.h>
+#include <hoot/core/visitors/CalculateHashVisitor2.h>
 #include <hoot/core/visitors/CalculateMapBoundsVisitor.h>
+#include <hoot/core/visitors/RemoveTagVisitor.h>
 #include <hoot/hadoop/Debug.h>
 #include <hoot/core/ops/OsmMapOperation.h>
 #include <hoot/hadoop/HadoopIdGenerator.h>
@@ -73,6 +76,7 @@ protected:
 
 TileOpReducer::TileOpReducer()
 {
+  _finalPass = false;
   _initialized = false;
 }
 
@@ -190,9 +194,30 @@ void TileOpReducer::_conflate(int key, HadoopPipes::ReduceContext& context)
   for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
   {
     const boost::shared_ptr<Way>& w = map->getWay(it->first);
+    // a way whose fingerprint still matches its content was already split to size by the tile
+    // that conflated it and this tile's op left it alone; don't redo that work.
+    if (CalculateHashVisitor2::isUnchanged(w))
+    {
+      continue;
+    }
     WaySplitter::split(map, w, _maxWaySize);
   }
 
+  if (_finalPass)
+  {
+    // no later pass reads the fingerprints; strip them rather than shipping scratch state.
+    RemoveTagVisitor removeHashVisitor(MetadataTags::HootHash());
+    map->visitRw(removeHashVisitor);
+  }
+  else
+  {
+    // fingerprint the conflated result so the tiles whose buffer zones overlap this one can
+    // recognize the geometry they've left untouched.
+    CalculateHashVisitor2 hashVisitor;
+    hashVisitor.setRemoveUuid(false);
+    map->visitRw(hashVisitor);
+  }
+
 # ifdef DEBUG
     LOG_INFO("Performing debug check to make sure ways are the right size.");
     // check to make sure all the ways are the right size. Using a copy of the map so we can split
@@ -277,6 +302,7 @@ void TileOpReducer::_init(HadoopPipes::ReduceContext& context)
     _stats.getMaxNodeId()));
   _maxWaySize = c->getDouble(TileOpMapper::maxWaySizeKey());
   _buffer = c->getDouble(TileOpMapper::bufferKey());
+  _finalPass = c->getInt(finalPassKey()) != 0;
 
   stringstream ss(c->getBytes(opKey()));
   _op.reset(ObjectInputStream(ss).readObject<OsmMapOperation>());
@@ -326,6 +352,14 @@ void TileOpReducer::reduce(HadoopPipes::ReduceContext& context)
       boost::shared_ptr<OsmMap> map = _readMap(context.getInputValue());
       LOG_INFO("Passing dregs. Node Count: " << map->getNodes().size() << " Way Count: " <<
                map->getWays().size());
+      // no envelopes means this is the final cleanup pass and everything flows through here;
+      // the fingerprints are scratch state for the tile passes, so don't ship them. The same
+      // holds for dregs in the last tile pass since its output may be published directly.
+      if (_envelopes.size() == 0 || _finalPass)
+      {
+        RemoveTagVisitor removeHashVisitor(MetadataTags::HootHash());
+        map->visitRw(removeHashVisitor);
+      }
       _emitMap(map);
     }
   }
@@ -38,6 +38,8 @@ class TileOpReducer : public pp::Reducer
 public:
   static std::string className() { return "hoot::TileOpReducer"; }
 
+  static std::string finalPassKey() { return "hoot.final.pass"; }
+
   static std::string opKey() { return "hoot.op.key"; }
 
   static unsigned int logWarnCount;
@@ -54,6 +56,8 @@ private:
 
   bool _initialized;
 
+  bool _finalPass;
+
   /// Maximum way size in degrees.
   double _maxWaySize;
   double _buffer;
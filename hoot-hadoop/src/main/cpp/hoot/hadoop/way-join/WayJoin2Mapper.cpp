@@ -153,15 +153,18 @@ void WayJoin2Mapper::mapOsmMap(boost::shared_ptr<OsmMap> m)
   }
 
   _key->elementType = WayType;
-  // Go through all the ways
+  // Go through all the ways. The stream objects are reused across ways; constructing them per
+  // record showed up in the shuffle profile.
+  stringstream ss(stringstream::out);
+  pp::DataOutputStream dos(ss);
   const WayMap& wm = m->getWays();
   for (WayMap::const_iterator it = wm.begin(); it != wm.end(); ++it)
   {
     const ConstWayPtr& w = it->second;
 
     _key->id = w->getId();
-    stringstream ss(stringstream::out);
-    pp::DataOutputStream dos(ss);
+    ss.str(string());
+    ss.clear();
 
     LOG_TRACE("Writing way: " << _key->id);
 
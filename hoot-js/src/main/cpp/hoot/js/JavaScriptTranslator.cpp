@@ -203,6 +203,17 @@ void JavaScriptTranslator::_finalize()
     }
   }
 
+  if (_toOsmFunction.IsEmpty() == false)
+  {
+    _toOsmFunction.Dispose();
+    _toOsmFunction.Clear();
+  }
+  if (_toOgrFunction.IsEmpty() == false)
+  {
+    _toOgrFunction.Dispose();
+    _toOgrFunction.Clear();
+  }
+
   _initialized = false;
 }
 
@@ -279,6 +290,16 @@ void JavaScriptTranslator::_init()
     throw HootException("A 'translateToOsm' function must be defined.");
   }
 
+  // cache the translation functions now; looking them up through the global object costs a
+  // symbol allocation and a property walk for every feature translated.
+  _toOsmFunction = Persistent<v8::Function>::New(
+    Handle<v8::Function>::Cast(tObj->Get(toV8(_toOsmFunctionName))));
+  if (tObj->Has(String::NewSymbol("translateToOgr")))
+  {
+    _toOgrFunction = Persistent<v8::Function>::New(
+      Handle<v8::Function>::Cast(tObj->Get(String::NewSymbol("translateToOgr"))));
+  }
+
   // Debug Stuff - Dump the object properties
 //  Handle<Object> hoot = tObj->Get(toV8("hoot"))->ToObject();
 
@@ -858,20 +879,21 @@ QVariantList JavaScriptTranslator::_translateToOgrVariants(Tags& tags,
 
   switch (geometryType)
   {
+  // NewSymbol interns the constant strings rather than allocating new ones per feature.
   case GEOS_POINT:
   case GEOS_MULTIPOINT:
-    args[2] = String::New("Point");
+    args[2] = String::NewSymbol("Point");
     break;
   case GEOS_LINESTRING:
   case GEOS_MULTILINESTRING:
-    args[2] = String::New("Line");
+    args[2] = String::NewSymbol("Line");
     break;
   case GEOS_POLYGON:
   case GEOS_MULTIPOLYGON:
-    args[2] = String::New("Area");
+    args[2] = String::NewSymbol("Area");
     break;
   case GEOS_GEOMETRYCOLLECTION:
-    args[2] = String::New("Collection");
+    args[2] = String::NewSymbol("Collection");
     break;
   default:
     throw InternalErrorException("Unexpected geometry type.");
@@ -883,14 +905,10 @@ QVariantList JavaScriptTranslator::_translateToOgrVariants(Tags& tags,
     start = Tgs::Time::getTime();
   }
 
-//  QScriptValue translated = _translateToOgrFunction->call(QScriptValue(), args);
   Handle<Object> tObj = _gContext->getContext()->Global();
 
-  // We assume this exists. we checked during Init.
-  Handle<v8::Function> tFunc = Handle<v8::Function>::Cast(tObj->Get(String::NewSymbol("translateToOgr")));
-
-  // Make sure we have a translation function. No easy way to do this earlier than now
-  if (tFunc->IsUndefined())
+  // the function handle was cached by _init; an empty handle means the script never defined it.
+  if (_toOgrFunction.IsEmpty())
   {
     throw HootException("This translation file does not support converting to OGR. "
                         "(Missing translateToOgr)");
@@ -898,7 +916,7 @@ QVariantList JavaScriptTranslator::_translateToOgrVariants(Tags& tags,
 
   TryCatch trycatch;
   // Hardcoded to 3 arguments
-  Handle<Value> translated = tFunc->Call(tObj, 3, args);
+  Handle<Value> translated = _toOgrFunction->Call(tObj, 3, args);
   HootExceptionJs::checkV8Exception(translated, trycatch);
 
   if (Log::getInstance().getLevel() <= Log::Debug)
@@ -952,20 +970,19 @@ void JavaScriptTranslator::_translateToOsm(Tags& t, const char *layerName, const
 
   Handle<Object> tObj = _gContext->getContext()->Global();
 
-  // This has a variable since we don't know if it will be "translateToOsm" or "translateAttributes"
-  Handle<v8::Function> tFunc = Handle<v8::Function>::Cast(tObj->Get(toV8(_toOsmFunctionName)));
   TryCatch trycatch;
 
-  // NOTE: the "3" here is the number of arguments
-  Handle<Value> newTags = tFunc->Call(tObj, 3, args);
-  HootExceptionJs::checkV8Exception(newTags, trycatch);
-
   double start = 0.00; // to stop warnings
   if (Log::getInstance().getLevel() <= Log::Debug)
   {
     start = Tgs::Time::getTime();
   }
 
+  // the cached handle points at "translateToOsm" or "translateAttributes"; see _init.
+  // NOTE: the "3" here is the number of arguments
+  Handle<Value> newTags = _toOsmFunction->Call(tObj, 3, args);
+  HootExceptionJs::checkV8Exception(newTags, trycatch);
+
   if (Log::getInstance().getLevel() <= Log::Debug)
   {
     _timing.push_back((Tgs::Time::getTime() - start) * 1000.0);
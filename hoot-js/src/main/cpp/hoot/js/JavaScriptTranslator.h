@@ -110,6 +110,10 @@ public:
 protected:
   boost::shared_ptr<PluginContext> _gContext;
   QString _toOsmFunctionName;
+  /// cached by _init so the per-feature hot paths don't look the functions up through the
+  /// global object on every call. Empty when the script doesn't define the function.
+  v8::Persistent<v8::Function> _toOsmFunction;
+  v8::Persistent<v8::Function> _toOgrFunction;
 
   bool _error;
   boost::shared_ptr<Schema> _schema;
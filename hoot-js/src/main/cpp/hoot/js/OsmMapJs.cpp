@@ -41,6 +41,7 @@
 #include <hoot/core/ops/RemoveElementOp.h>
 #include "JsRegistrar.h"
 
+using namespace std;
 using namespace v8;
 
 namespace hoot
@@ -83,6 +84,8 @@ void OsmMapJs::Init(Handle<Object> target) {
       FunctionTemplate::New(removeElement)->GetFunction());
   tpl->PrototypeTemplate()->Set(String::NewSymbol("visit"),
       FunctionTemplate::New(visit)->GetFunction());
+  tpl->PrototypeTemplate()->Set(String::NewSymbol("visitBatch"),
+      FunctionTemplate::New(visitBatch)->GetFunction());
   tpl->PrototypeTemplate()->Set(String::NewSymbol("setIdGenerator"),
       FunctionTemplate::New(setIdGenerator)->GetFunction());
   tpl->PrototypeTemplate()->Set(PopulateConsumersJs::baseClass(),
@@ -228,6 +231,127 @@ Handle<Value> OsmMapJs::removeElement(const Arguments& args) {
   return scope.Close(Undefined());
 }
 
+Handle<Value> OsmMapJs::visitBatch(const Arguments& args)
+{
+  HandleScope scope;
+
+  try
+  {
+    OsmMapJs* map = ObjectWrap::Unwrap<OsmMapJs>(args.This());
+
+    if (args[0]->IsFunction() == false)
+    {
+      throw IllegalArgumentException("Expected the first argument to visitBatch to be a "
+        "function.");
+    }
+    Handle<Function> func = Handle<Function>::Cast(args[0]);
+    int batchSize = 1000;
+    if (args.Length() >= 2)
+    {
+      batchSize = args[1]->Int32Value();
+      if (batchSize < 1)
+      {
+        throw IllegalArgumentException("Expected the batch size to be >= 1.");
+      }
+    }
+
+    OsmMapPtr m = map->getMap();
+
+    // Gather the ids up front so the callback is free to mutate the map while we iterate.
+    vector<ElementId> eids;
+    eids.reserve(m->getElementCount());
+    const NodeMap& nodes = m->getNodes();
+    for (NodeMap::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+      eids.push_back(ElementId::node(it->first));
+    }
+    const WayMap& ways = m->getWays();
+    for (WayMap::const_iterator it = ways.begin(); it != ways.end(); ++it)
+    {
+      eids.push_back(ElementId::way(it->first));
+    }
+    const RelationMap& relations = m->getRelations();
+    for (RelationMap::const_iterator it = relations.begin(); it != relations.end(); ++it)
+    {
+      eids.push_back(ElementId::relation(it->first));
+    }
+
+    for (size_t offset = 0; offset < eids.size(); offset += batchSize)
+    {
+      HandleScope batchScope;
+
+      // Marshal the whole batch into parallel arrays so there is one C++/JS crossing per batch
+      // rather than one per element.
+      Local<Array> idArr = Array::New();
+      Local<Array> tagArr = Array::New();
+      vector<ElementId> batchEids;
+      uint32_t n = 0;
+      for (size_t i = offset; i < eids.size() && i < offset + (size_t)batchSize; i++)
+      {
+        // the callback may have removed elements in an earlier batch.
+        if (m->containsElement(eids[i]) == false)
+        {
+          continue;
+        }
+        ConstElementPtr e = m->getElement(eids[i]);
+        Local<Object> tagObj = Object::New();
+        const Tags& tags = e->getTags();
+        for (Tags::const_iterator tt = tags.begin(); tt != tags.end(); ++tt)
+        {
+          tagObj->Set(toV8(tt.key()), toV8(tt.value()));
+        }
+        idArr->Set(n, toV8(eids[i]));
+        tagArr->Set(n, tagObj);
+        batchEids.push_back(eids[i]);
+        n++;
+      }
+      if (n == 0)
+      {
+        continue;
+      }
+
+      TryCatch trycatch;
+      Handle<Value> callArgs[2] = { idArr, tagArr };
+      Handle<Value> result = func->Call(v8::Context::GetCurrent()->Global(), 2, callArgs);
+      HootExceptionJs::checkV8Exception(result, trycatch);
+
+      // The callback may return an array of replacement tag objects. A null/undefined entry
+      // leaves that element's tags alone.
+      if (result->IsArray())
+      {
+        Handle<Array> newTagArr = Handle<Array>::Cast(result);
+        for (uint32_t i = 0; i < n && i < newTagArr->Length(); i++)
+        {
+          Handle<Value> v = newTagArr->Get(i);
+          if (v->IsObject() == false)
+          {
+            continue;
+          }
+          Handle<Object> tagObj = Handle<Object>::Cast(v);
+          Tags newTags;
+          Handle<Array> keys = tagObj->GetPropertyNames();
+          for (uint32_t j = 0; j < keys->Length(); j++)
+          {
+            Handle<Value> key = keys->Get(j);
+            newTags.set(toCpp<QString>(key), toCpp<QString>(tagObj->Get(key)));
+          }
+          if (m->containsElement(batchEids[i]))
+          {
+            m->getElement(batchEids[i])->setTags(newTags);
+          }
+        }
+      }
+    }
+  }
+  catch (const HootException& err)
+  {
+    LOG_VAR(err.getWhat());
+    return v8::ThrowException(HootExceptionJs::create(err));
+  }
+
+  return scope.Close(Undefined());
+}
+
 Handle<Value> OsmMapJs::visit(const Arguments& args)
 {
   HandleScope scope;
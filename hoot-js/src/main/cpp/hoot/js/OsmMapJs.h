@@ -63,6 +63,7 @@ private:
   static v8::Handle<v8::Value> removeElement(const v8::Arguments& args);
   static v8::Handle<v8::Value> setIdGenerator(const v8::Arguments& args);
   static v8::Handle<v8::Value> visit(const v8::Arguments& args);
+  static v8::Handle<v8::Value> visitBatch(const v8::Arguments& args);
 
   OsmMapPtr _map;
   ConstOsmMapPtr _constMap;
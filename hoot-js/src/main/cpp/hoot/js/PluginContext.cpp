@@ -35,7 +35,12 @@
 #include <hoot/js/util/HootExceptionJs.h>
 
 // Qt
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 using namespace std;
 using namespace v8;
@@ -43,6 +48,27 @@ using namespace v8;
 namespace hoot
 {
 
+namespace
+{
+
+/**
+ * Process wide cache of script sources and their precompiled parser data. Every PluginContext
+ * loads the same system includes in its constructor, so without this each new context pays the
+ * disk read and the full parse again. The parser data is context independent, so one
+ * PreCompile serves every context in the process.
+ */
+struct CachedScript
+{
+  QDateTime lastModified;
+  QString source;
+  boost::shared_ptr<ScriptData> preData;
+};
+
+QHash<QString, CachedScript> _scriptCache;
+QMutex _scriptCacheMutex;
+
+}
+
 const double PluginContext::UNSPECIFIED_DEFAULT = -999999e9;
 
 PluginContext::PluginContext()
@@ -126,22 +152,41 @@ Local<Object> PluginContext::loadScript(QString filename, QString loadInto)
   // running the hello world script.
   Context::Scope context_scope(_context);
 
-  QFile fp(filename);
   LOG_TRACE("Loading script " << filename << "...");
-  if (fp.open(QFile::ReadOnly) == false)
+
+  QFileInfo info(filename);
+  const QString key = info.absoluteFilePath();
+
+  CachedScript entry;
   {
-    throw HootException("Error opening script: " + filename);
+    QMutexLocker locker(&_scriptCacheMutex);
+    entry = _scriptCache.value(key);
   }
+  if (entry.source.isNull() || entry.lastModified != info.lastModified())
+  {
+    QFile fp(filename);
+    if (fp.open(QFile::ReadOnly) == false)
+    {
+      throw HootException("Error opening script: " + filename);
+    }
+    entry.source = QString::fromUtf8(fp.readAll());
+    entry.lastModified = info.lastModified();
+
+    QByteArray utf8 = entry.source.toUtf8();
+    entry.preData.reset(ScriptData::PreCompile(utf8.data(), utf8.size()));
 
-  QString text = QString::fromUtf8(fp.readAll());
+    QMutexLocker locker(&_scriptCacheMutex);
+    _scriptCache[key] = entry;
+  }
 
-  Handle<Object> result = loadText(text, loadInto, filename);
+  Handle<Object> result = loadText(entry.source, loadInto, filename, entry.preData.get());
 
   return handleScope.Close(result);
 }
 
 // This is a duplicate of loadScript. Will refactor later once the rest is working
-Local<Object> PluginContext::loadText(QString text, QString loadInto, QString scriptName)
+Local<Object> PluginContext::loadText(QString text, QString loadInto, QString scriptName,
+  ScriptData* preData)
 {
   HandleScope handleScope;
   Context::Scope context_scope(_context);
@@ -153,9 +198,10 @@ Local<Object> PluginContext::loadText(QString text, QString loadInto, QString sc
 
   TryCatch try_catch;
 
-  // Compile the source code.
+  // Compile the source code. When precompiled parser data is available the compile skips the
+  // parse step.
   v8::ScriptOrigin origin(toV8(scriptName));
-  script = Script::Compile(String::New(text.toUtf8().data()), &origin);
+  script = Script::Compile(String::New(text.toUtf8().data()), &origin, preData);
 
   if (script.IsEmpty())
   {
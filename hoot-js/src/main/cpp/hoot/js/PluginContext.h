@@ -74,10 +74,16 @@ public:
    */
   bool hasKey(v8::Handle<v8::Value> v, QString key);
 
+  /**
+   * Loads the script into this context. The script source and its precompiled parser data are
+   * cached process wide keyed on path and modification time, so contexts after the first skip
+   * the disk read and the parse of the shared system includes.
+   */
   v8::Local<v8::Object> loadScript(QString filename, QString loadInto = "");
 
   // Will refacter this later to get rid of duplication
-  v8::Local<v8::Object> loadText(QString text, QString loadInto = "", QString scriptName = "<Unknown>");
+  v8::Local<v8::Object> loadText(QString text, QString loadInto = "", QString scriptName = "<Unknown>",
+    v8::ScriptData* preData = 0);
 
   /**
    * Returns the specified key. If defaultValue is not UNSPECIFIED_DEFAULT then it will be used if
@@ -57,12 +57,17 @@ using namespace hoot;
 
 // Qt
 #include <QtGui/QApplication>
+#include <QDir>
+#include <QFile>
 #include <QString>
 #include <QStringList>
 #include <QDateTime>
 
 // Standard
 #include <iostream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 using namespace std;
 
 // Tgs
@@ -109,6 +114,19 @@ public:
     {
       cout << test->getName() << " - " << elapsed << endl;
     }
+    if (_timingFile.isEmpty() == false)
+    {
+      // opened per line in append mode so parallel shards can share one file; each line is a
+      // single small write.
+      QFile f(_timingFile);
+      if (f.open(QIODevice::Append | QIODevice::Text))
+      {
+        QString line = QString("%1\t%2\n").arg(QString::fromStdString(test->getName()))
+          .arg(elapsed, 0, 'f', 3);
+        f.write(line.toUtf8());
+        f.close();
+      }
+    }
     if (elapsed > _slowTest && _slowTest >= 0.0)
     {
       cout << "Test " << test->getName().data() << " ran longer than expected -- " << elapsed <<
@@ -121,6 +139,11 @@ public:
 
   void showTestNames(bool show) { _showTestName = show; }
 
+  /**
+   * Appends a "name<tab>seconds" line to the given file after each test.
+   */
+  void setTimingFile(QString path) { _timingFile = path; }
+
   virtual void startSuite(CppUnit::Test* suite)
   {
     if (_showTestName)
@@ -138,12 +161,30 @@ public:
 private:
   bool _success;
   bool _showTestName;
+  QString _timingFile;
 
   double _start;
   double _allStart;
   double _slowTest;
 };
 
+void collectTests(CppUnit::Test* t, vector<CppUnit::Test*>& leaves)
+{
+  CppUnit::TestSuite* suite = dynamic_cast<CppUnit::TestSuite*>(t);
+  if (suite != 0)
+  {
+    vector<CppUnit::Test*> children = suite->getTests();
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+      collectTests(children[i], leaves);
+    }
+  }
+  else
+  {
+    leaves.push_back(t);
+  }
+}
+
 void filterPattern(CppUnit::Test* from, CppUnit::TestSuite* to, QString pattern,
   bool includeOnMatch)
 {
@@ -327,6 +368,8 @@ int main(int argc, char *argv[])
             "--diff - Print diff when a script test fails.\n"
             "--include=[regex] - Include only tests that match the specified regex.\n"
             "--exclude=[regex] - Exclude tests that match the specified regex.\n"
+            "--parallel=[n] - Shard the tests across n processes.\n"
+            "--timing - Append per-test timings to test-output/test-timing.tsv.\n"
             "\n"
             "See the Hootenanny Developer Guide for more information.\n"
             ;
@@ -431,6 +474,83 @@ int main(int argc, char *argv[])
         }
       }
 
+      int parallelJobs = 1;
+      for (int i = 0; i < args.size(); i++)
+      {
+        if (args[i].startsWith("--parallel="))
+        {
+          parallelJobs = args[i].mid(args[i].indexOf('=') + 1).toInt();
+        }
+      }
+
+      if (parallelJobs > 1)
+      {
+        vector<CppUnit::Test*> leaves;
+        collectTests(rootSuite, leaves);
+        cout << "Running core tests in " << parallelJobs << " processes.  Test count: " <<
+          leaves.size() << endl;
+
+        if (args.contains("--names"))
+        {
+          listener->showTestNames(true);
+        }
+        if (args.contains("--timing"))
+        {
+          QDir().mkpath("test-output");
+          QFile::remove("test-output/test-timing.tsv");
+          listener->setTimingFile("test-output/test-timing.tsv");
+        }
+
+        const double allStart = Tgs::Time::getTime();
+        vector<pid_t> children;
+        for (int shard = 0; shard < parallelJobs; shard++)
+        {
+          pid_t pid = fork();
+          if (pid == 0)
+          {
+            // round robin assignment spreads each registry's slow suites across the shards.
+            CppUnit::TestSuite* shardSuite = new CppUnit::TestSuite("Shard");
+            for (size_t i = shard; i < leaves.size(); i += parallelJobs)
+            {
+              shardSuite->addTest(leaves[i]);
+            }
+
+            // the same per run setup the serial path does below.
+            conf().clear();
+            ConfigOptions::populateDefaults(conf());
+            conf().set("HOOT_HOME", getenv("HOOT_HOME"));
+            Settings::parseCommonArguments(args);
+
+            CppUnit::TextTestResult shardResult;
+            shardResult.addListener(listener);
+            runner.addTest(shardSuite);
+            runner.run(shardResult);
+            // don't run the parent's exit handlers.
+            _exit(shardResult.failures().size() > 0 ? 1 : 0);
+          }
+          else if (pid < 0)
+          {
+            throw HootException("Error forking test shard.");
+          }
+          children.push_back(pid);
+        }
+
+        bool failed = false;
+        for (size_t i = 0; i < children.size(); i++)
+        {
+          int status = 0;
+          waitpid(children[i], &status, 0);
+          if (WIFEXITED(status) == false || WEXITSTATUS(status) != 0)
+          {
+            failed = true;
+          }
+        }
+        cout << endl << "Total elapsed: " << Tgs::Time::getTime() - allStart << endl;
+        delete searchSuite;
+        delete listener;
+        return failed ? -1 : 0;
+      }
+
       runner.addTest(rootSuite);
       cout << "Running core tests.  Test count: " << rootSuite->countTestCases() << endl;
     }
@@ -441,6 +561,12 @@ int main(int argc, char *argv[])
     {
       listener->showTestNames(true);
     }
+    if (args.contains("--timing"))
+    {
+      QDir().mkpath("test-output");
+      QFile::remove("test-output/test-timing.tsv");
+      listener->setTimingFile("test-output/test-timing.tsv");
+    }
 
     // clear all user configuration so we have consistent tests.
     conf().clear();
@@ -34,14 +34,27 @@
 
 // Standard
 #include <stdlib.h>
+#include <list>
 #include <map>
+#include <sstream>
+#include <string>
 
 namespace Tgs
 {
 
 /**
- * Uses a STL map while the data size is small. When it gets above a threshold it switches over
- * entirely to a BigMapStxxl.
+ * Uses a STL map while the data size is small. When it gets above the memory budget the map
+ * spills to a BigMapStxxl, but keeps a hot tier of the most recently used entries in memory
+ * with LRU demotion (write back) to the STXXL tier. Previously the spill moved everything to
+ * disk at once, so id-mapping workloads with skewed access patterns (e.g. way joining) fell
+ * off a cliff the moment the threshold was crossed even though most lookups only touched a
+ * small working set.
+ *
+ * Hit/miss/promotion/demotion counters are kept and can be scraped via getStatsString().
+ *
+ * References returned by operator[] are only valid until the next non-const call, since the
+ * referenced entry may be demoted to the STXXL tier (the previous implementation already
+ * invalidated all references when it spilled).
  */
 template <typename K, typename V>
 class BigMap
@@ -53,18 +66,29 @@ public:
   {
     _inMemory = true;
     _maxEntriesInRam = maxEntriesInRam;
+    _totalEntries = 0;
+    _hotHits = 0;
+    _coldHits = 0;
+    _promotions = 0;
+    _demotions = 0;
   }
 
   const V& at(const K& k) const
   {
     if (_inMemory)
     {
+      _hotHits++;
       return _smallMap.at(k);
     }
-    else
+    typename HotMap::const_iterator it = _hot.find(k);
+    if (it != _hot.end())
     {
-      return _bigMap->at(k);
+      _hotHits++;
+      _lru.splice(_lru.end(), _lru, it->second.lruIt);
+      return it->second.value;
     }
+    _coldHits++;
+    return _bigMap->at(k);
   }
 
   bool contains(const K& k) const { return count(k) > 0; }
@@ -75,10 +99,11 @@ public:
     {
       return _smallMap.count(k);
     }
-    else
+    if (_hot.find(k) != _hot.end())
     {
-      return _bigMap->count(k);
+      return 1;
     }
+    return _bigMap->count(k);
   }
 
   void insert(const K& k, const V& v) { operator[](k) = v; }
@@ -88,32 +113,98 @@ public:
     _checkSize();
     if (_inMemory)
     {
+      _hotHits++;
       return _smallMap[k];
     }
+
+    typename HotMap::iterator it = _hot.find(k);
+    if (it != _hot.end())
+    {
+      _hotHits++;
+      _lru.splice(_lru.end(), _lru, it->second.lruIt);
+      return it->second.value;
+    }
+
+    // make room before inserting so the entry being returned is never the one demoted
+    _enforceBudget();
+
+    typename LruList::iterator lruIt = _lru.insert(_lru.end(), k);
+    HotEntry& e = _hot[k];
+    e.lruIt = lruIt;
+    if (_bigMap->count(k) > 0)
+    {
+      _coldHits++;
+      _promotions++;
+      e.value = _bigMap->at(k);
+    }
     else
     {
-      return (*_bigMap)[k];
+      _totalEntries++;
     }
+    return e.value;
   }
 
   void clear()
   {
-    if (_inMemory)
-    {
-      return _smallMap.clear();
-    }
-    else
+    _smallMap.clear();
+    _hot.clear();
+    _lru.clear();
+    if (_bigMap.get() != 0)
     {
-      return _bigMap->clear();
+      _bigMap->clear();
     }
+    _totalEntries = 0;
+  }
+
+  /**
+   * Returns the number of logical entries in the map (both tiers).
+   */
+  size_t getEntryCount() const { return _inMemory ? _smallMap.size() : _totalEntries; }
+
+  /**
+   * Returns a one line summary of the tier sizes and the cumulative hit/miss counters,
+   * suitable for scraping out of a log. Hot hits were served from memory, cold hits had to
+   * touch the STXXL tier.
+   */
+  std::string getStatsString() const
+  {
+    std::stringstream ss;
+    ss << "entries: " << getEntryCount() <<
+      " hot: " << (_inMemory ? _smallMap.size() : _hot.size()) <<
+      " spilled: " << (_inMemory ? "false" : "true") <<
+      " hot hits: " << _hotHits <<
+      " cold hits: " << _coldHits <<
+      " promotions: " << _promotions <<
+      " demotions: " << _demotions;
+    return ss.str();
   }
 
 private:
 
+  typedef std::list<K> LruList;
+
+  struct HotEntry
+  {
+    V value;
+    typename LruList::iterator lruIt;
+  };
+
+  typedef std::map<K, HotEntry> HotMap;
+
   bool _inMemory;
   std::map<K,V> _smallMap;
   std::auto_ptr< BigMapStxxl<K,V> > _bigMap;
   size_t _maxEntriesInRam;
+  size_t _totalEntries;
+
+  // the hot tier in front of the STXXL map; back of the LRU list is the most recently used.
+  // mutable so const lookups can still refresh recency and the counters.
+  HotMap _hot;
+  mutable LruList _lru;
+  mutable long _hotHits;
+  mutable long _coldHits;
+  long _promotions;
+  long _demotions;
 
   void _checkSize()
   {
@@ -127,10 +218,25 @@ private:
         _bigMap->insert(it->first, it->second);
       }
       //std::cerr << "Created stxxl" << std::endl;
+      _totalEntries = _smallMap.size();
       _smallMap.clear();
       _inMemory = false;
     }
   }
+
+  void _enforceBudget()
+  {
+    while (_hot.size() >= _maxEntriesInRam && !_hot.empty())
+    {
+      const K& oldKey = _lru.front();
+      typename HotMap::iterator oldIt = _hot.find(oldKey);
+      // always write back; the value may have been modified through operator[]
+      (*_bigMap)[oldKey] = oldIt->second.value;
+      _demotions++;
+      _hot.erase(oldIt);
+      _lru.pop_front();
+    }
+  }
 };
 
 }
@@ -30,6 +30,8 @@
 // Standard
 #include <stdlib.h>
 #include <map>
+#include <sstream>
+#include <string>
 
 namespace Tgs
 {
@@ -57,6 +59,23 @@ public:
 
   void clear() { _map.clear(); }
 
+  /**
+   * Returns the number of entries in the map.
+   */
+  size_t getEntryCount() const { return _map.size(); }
+
+  /**
+   * Returns a one line summary matching the hybrid implementation's format. Everything is in
+   * memory in this implementation, so the spill related counters are always zero.
+   */
+  std::string getStatsString() const
+  {
+    std::stringstream ss;
+    ss << "entries: " << _map.size() << " hot: " << _map.size() << " spilled: false" <<
+      " hot hits: 0 cold hits: 0 promotions: 0 demotions: 0";
+    return ss.str();
+  }
+
 private:
   std::map<K,V> _map;
 };
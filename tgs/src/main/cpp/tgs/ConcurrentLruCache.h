@@ -0,0 +1,159 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef CONCURRENTLRUCACHE_H
+#define CONCURRENTLRUCACHE_H
+
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+
+// standard
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "HashMap.h"
+#include "LruCache.h"
+
+namespace Tgs
+{
+
+/**
+ * A thread safe version of LruCache with the same get/insert interface. The key space is
+ * sharded over a number of independent LruCache instances, each guarded by its own mutex, so
+ * threads working on different keys rarely contend for the same lock. Each shard keeps its own
+ * hit/miss/insert counts which can be dumped with getStatsString().
+ *
+ * The maximum size is split evenly across the shards, so as with any sharded cache the
+ * least recently used item overall isn't necessarily the one evicted -- each shard evicts its
+ * own least recently used item. In practice this approximation costs very little hit rate.
+ */
+template<typename K, typename V>
+class ConcurrentLruCache
+{
+public:
+
+  /**
+   * @param maxSize the maximum number of entries summed over all the shards
+   * @param shards the number of independent shards; a small power of two around the expected
+   *  thread count works well
+   */
+  ConcurrentLruCache(long maxSize = 1000, int shards = 8)
+  {
+    _shards.resize(std::max(1, shards));
+    for (size_t i = 0; i < _shards.size(); i++)
+    {
+      _shards[i] = new Shard(std::max((long)1, maxSize / (long)_shards.size()));
+    }
+  }
+
+  ~ConcurrentLruCache()
+  {
+    for (size_t i = 0; i < _shards.size(); i++)
+    {
+      delete _shards[i];
+    }
+  }
+
+  /**
+   * Get a cached item.
+   * @param k User specified key to search for.
+   * @param v The value is only populated if the key is found and the function returns true.
+   * @return True if the specified key was found, false otherwise.
+   */
+  bool get(const K& k, V& v)
+  {
+    Shard& s = _shard(k);
+    QMutexLocker locker(&s.mutex);
+    bool result = s.cache.get(k, v);
+    if (result)
+    {
+      s.hits++;
+    }
+    else
+    {
+      s.misses++;
+    }
+    return result;
+  }
+
+  /**
+   * Insert a new item. This becomes the most recently used item in its shard. Unlike LruCache,
+   * inserting a key that is already present is a no-op rather than an error, since with
+   * concurrent users two threads may decide to compute and insert the same missing value.
+   */
+  void insert(const K& k, const V& v)
+  {
+    Shard& s = _shard(k);
+    QMutexLocker locker(&s.mutex);
+    V existing;
+    if (s.cache.get(k, existing) == false)
+    {
+      s.cache.insert(k, v);
+      s.inserts++;
+    }
+  }
+
+  /**
+   * Returns one line of statistics per shard. Intended for debug logging.
+   */
+  std::string getStatsString() const
+  {
+    std::stringstream ss;
+    for (size_t i = 0; i < _shards.size(); i++)
+    {
+      Shard& s = *_shards[i];
+      QMutexLocker locker(&s.mutex);
+      ss << "shard " << i << " size: " << s.cache.size() << " hits: " << s.hits <<
+        " misses: " << s.misses << " inserts: " << s.inserts << std::endl;
+    }
+    return ss.str();
+  }
+
+private:
+
+  struct Shard
+  {
+    Shard(long maxSize) : cache(maxSize), hits(0), misses(0), inserts(0) {}
+
+    mutable QMutex mutex;
+    LruCache<K, V> cache;
+    long hits;
+    long misses;
+    long inserts;
+  };
+
+  friend class ConcurrentLruCacheTest;
+  std::vector<Shard*> _shards;
+  HashCompare<K> _hash;
+
+  Shard& _shard(const K& k) { return *_shards[_hash(k) % _shards.size()]; }
+};
+
+}
+
+#endif // CONCURRENTLRUCACHE_H
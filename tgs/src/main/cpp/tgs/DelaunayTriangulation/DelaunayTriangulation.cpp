@@ -34,6 +34,7 @@ using namespace std;
 
 // Tgs
 #include <tgs/HashMap.h>
+#include <tgs/Statistics/Random.h>
 #include <tgs/TgsException.h>
 
 namespace Tgs
@@ -932,4 +933,17 @@ void DelaunayTriangulation::insert(double x, double y)
   _pointCount++;
 }
 
+void DelaunayTriangulation::insert(const vector< pair<double, double> >& points)
+{
+  // randomize the insertion order. By randomizing we take the complexity from O(n^2) to
+  // O(n lg(n)) when the input arrives sorted.
+  vector< pair<double, double> > randomized = points;
+  Random::randomizeVector(randomized);
+
+  for (size_t i = 0; i < randomized.size(); i++)
+  {
+    insert(randomized[i].first, randomized[i].second);
+  }
+}
+
 }
@@ -268,6 +268,14 @@ public:
    */
   void insert(double x, double y);
 
+  /**
+   * Inserts all the given points into the triangulation in a randomized order. The incremental
+   * algorithm is O(n lg(n)) when points arrive in random order, but degrades toward O(n^2) when
+   * they arrive sorted (e.g. straight out of a data frame or an ordered map), so bulk inserts
+   * should prefer this method over inserting the points one at a time in their natural order.
+   */
+  void insert(const std::vector< std::pair<double, double> >& points);
+
 private:
   Subdivision* _subdivision;
   double _x[3], _y[3];
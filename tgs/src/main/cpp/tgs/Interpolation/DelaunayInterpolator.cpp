@@ -112,12 +112,17 @@ void DelaunayInterpolator::_buildModel()
     _dt->insert(b.x, b.y);
     _dt->insert(c.x, c.y);
 
+    // insert the data points in bulk so the triangulation can randomize the order. Data frames
+    // frequently arrive sorted on one of the columns, which is the incremental algorithm's
+    // O(n^2) worst case.
+    vector< pair<double, double> > points;
+    points.reserve(df.getNumDataVectors());
     for (size_t i = 0; i < df.getNumDataVectors(); i++)
     {
       const vector<double>& v = df.getDataVector(i);
-      Point2d p(v[_indColumns[0]], v[_indColumns[1]]);
-      _dt->insert(p.x, p.y);
+      points.push_back(pair<double, double>(v[_indColumns[0]], v[_indColumns[1]]));
     }
+    _dt->insert(points);
   }
 }
 
@@ -49,6 +49,7 @@ KernelEstimationInterpolator::KernelEstimationInterpolator(double sigma)
 {
   _sigma = sigma;
   _stopDelta = 1.0;
+  _cacheCellSize = -1;
 }
 
 KernelEstimationInterpolator::~KernelEstimationInterpolator()
@@ -81,6 +82,8 @@ void KernelEstimationInterpolator::_buildModel()
   const DataFrame& df = *_df;
 
   _index.reset();
+  // any change to the model or sigma invalidates previously cached results
+  _cache.clear();
 
   if (_sigma < 0)
   {
@@ -144,6 +147,11 @@ double KernelEstimationInterpolator::_estimateError(unsigned int index) const
 
 
   double n0 = Normal::normal(0, _sigma);
+  // the gaussian weight normalized by the weight at zero distance reduces to
+  // exp(-d^2 / (2 sigma^2)), so the weights can be computed straight from the squared
+  // distances without a sqrt or a normal evaluation per neighbor.
+  double negHalfInvSigma2 = -1.0 / (2.0 * _sigma * _sigma);
+  double maxD2 = (_sigma * 3.0) * (_sigma * 3.0);
 
   KnnIteratorNd it(_getIndex(), simplePoint);
   double wSum = 0.0;
@@ -156,22 +164,19 @@ double KernelEstimationInterpolator::_estimateError(unsigned int index) const
     }
     const vector<double>& record = df.getDataVector(i);
 
-    // figure out the distance between point and this data vector
-    double d = 0;
+    // figure out the squared distance between point and this data vector
+    double d2 = 0;
     for (size_t j = 0; j < _indColumns.size(); j++)
     {
       double v = uut[_indColumns[j]] - record[_indColumns[j]];
-      d += v * v;
+      d2 += v * v;
     }
-    d = sqrt(d);
-    if (d / _sigma < 3.0)
+    if (d2 < maxD2)
     {
       // calculate the weight of this sample.
-      double w = Normal::normal(d, _sigma) / n0;
+      double w = exp(d2 * negHalfInvSigma2);
       wSum += w;
 
-      assert(w <= 1.000001);
-
       // calculate the contribution to the predicted value.
       for (size_t j = 0; j < predicted.size(); j++)
       {
@@ -201,6 +206,20 @@ const vector<double>& KernelEstimationInterpolator::interpolate(const vector<dou
 {
   const DataFrame& df = *_df;
 
+  bool useCache = _cacheCellSize > 0.0 && _indColumns.size() == 2;
+  pair<long long, long long> cellKey;
+  if (useCache)
+  {
+    cellKey.first = (long long)floor(point[_indColumns[0]] / _cacheCellSize);
+    cellKey.second = (long long)floor(point[_indColumns[1]] / _cacheCellSize);
+    map<pair<long long, long long>, vector<double> >::const_iterator cit = _cache.find(cellKey);
+    if (cit != _cache.end())
+    {
+      _result = cit->second;
+      return _result;
+    }
+  }
+
   _result.resize(_depColumns.size());
   for (size_t i = 0; i < _result.size(); i++)
   {
@@ -214,37 +233,54 @@ const vector<double>& KernelEstimationInterpolator::interpolate(const vector<dou
   }
 
   double n0 = Normal::normal(0, _sigma);
-
+  // see the note in _estimateError on the exponential form of the weights
+  double negHalfInvSigma2 = -1.0 / (2.0 * _sigma * _sigma);
+  double maxD2 = (_sigma * 3.0) * (_sigma * 3.0);
+
+  // gather the squared distance to each contributing neighbor into a flat array so the
+  // weighting below runs as a tight arithmetic loop rather than being interleaved with the
+  // index traversal.
+  _neighborD2.resize(0);
+  _neighborIds.resize(0);
   KnnIteratorNd it(_getIndex(), simplePoint);
-  double wSum = 0.0;
   while (it.next() && it.getDistance() < _sigma * 3.0)
   {
     size_t i = it.getId();
     const vector<double>& record = df.getDataVector(i);
 
-    // figure out the distance between point and this data vector
-    double d = 0;
+    // figure out the squared distance between point and this data vector
+    double d2 = 0;
     for (size_t j = 0; j < _indColumns.size(); j++)
     {
       double v = point[_indColumns[j]] - record[_indColumns[j]];
-      d += v * v;
+      d2 += v * v;
     }
-    d = sqrt(d);
-    if (d / _sigma < 3.0)
+    if (d2 < maxD2)
     {
-      // calculate the weight of this sample.
-      double w = Normal::normal(d, _sigma) / n0;
-      wSum += w;
+      _neighborD2.push_back(d2);
+      _neighborIds.push_back(i);
+    }
+  }
 
-      assert(w <= 1.000001);
+  // calculate all the weights in place
+  double wSum = 0.0;
+  for (size_t k = 0; k < _neighborD2.size(); k++)
+  {
+    double w = exp(_neighborD2[k] * negHalfInvSigma2);
+    _neighborD2[k] = w;
+    wSum += w;
+  }
 
-      // calculate the contribution to the predicted value.
-      for (size_t j = 0; j < _result.size(); j++)
-      {
-        _result[j] += (record[_depColumns[j]] * w);
-      }
+  // calculate the contribution of each neighbor to the predicted value.
+  for (size_t k = 0; k < _neighborD2.size(); k++)
+  {
+    const vector<double>& record = df.getDataVector(_neighborIds[k]);
+    for (size_t j = 0; j < _result.size(); j++)
+    {
+      _result[j] += (record[_depColumns[j]] * _neighborD2[k]);
     }
   }
+
   // do less rubber sheeting as we get far away from tie points.
   wSum = std::max(wSum, n0);
 
@@ -253,6 +289,11 @@ const vector<double>& KernelEstimationInterpolator::interpolate(const vector<dou
     _result[j] /= wSum;
   }
 
+  if (useCache)
+  {
+    _cache[cellKey] = _result;
+  }
+
   return _result;
 }
 
@@ -30,6 +30,10 @@
 // Qt
 #include <QIODevice>
 
+// Standard
+#include <map>
+#include <utility>
+
 #include "BaseInterpolator.h"
 
 namespace Tgs
@@ -62,6 +66,16 @@ public:
 
   virtual const std::vector<double>& interpolate(const std::vector<double>& point) const;
 
+  /**
+   * Enables an approximate grid cache of interpolated results. Queries that fall in the same
+   * grid cell reuse the first result computed in that cell rather than re-evaluating the
+   * kernel, which helps callers such as rubber sheeting that issue millions of near identical
+   * queries. The cell size should be small relative to sigma (e.g. sigma / 10) so the
+   * approximation error stays well below the kernel bandwidth. A cell size <= 0 (the default)
+   * disables the cache. Only applies when there are exactly two independent columns.
+   */
+  void setCacheCellSize(double cellSize) { _cacheCellSize = cellSize; _cache.clear(); }
+
   void setSigma(double sigma) { _sigma = sigma; _checkRebuild(); }
 
   /**
@@ -74,6 +88,12 @@ public:
 protected:
   double _sigma;
   double _stopDelta;
+  double _cacheCellSize;
+  /// Caches one interpolated result per grid cell, see setCacheCellSize
+  mutable std::map<std::pair<long long, long long>, std::vector<double> > _cache;
+  /// Temp variables used to gather the neighbors of a query before weighting them
+  mutable std::vector<double> _neighborD2;
+  mutable std::vector<size_t> _neighborIds;
 
   virtual void _buildModel();
 
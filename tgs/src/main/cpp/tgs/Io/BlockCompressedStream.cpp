@@ -0,0 +1,408 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "BlockCompressedStream.h"
+
+#include <tgs/TgsException.h>
+
+// Qt
+#include <QByteArray>
+
+// Standard
+#include <cstring>
+
+using namespace std;
+
+namespace Tgs
+{
+
+namespace
+{
+
+// the header marks the format, the trailer makes truncation detectable.
+const char HEADER_MAGIC[8] = { 'T', 'G', 'S', 'B', 'C', 'S', '1', '\n' };
+const char TRAILER_MAGIC[8] = { 'T', 'G', 'S', 'B', 'C', 'I', 'X', '\n' };
+const int TRAILER_SIZE = 8 + 8 + 8;
+
+// fixed little endian encoding so the files are portable between hosts.
+void encodeU32(unsigned int v, char* out)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = (char)((v >> (i * 8)) & 0xff);
+  }
+}
+
+void encodeU64(unsigned long long v, char* out)
+{
+  for (int i = 0; i < 8; i++)
+  {
+    out[i] = (char)((v >> (i * 8)) & 0xff);
+  }
+}
+
+unsigned int decodeU32(const char* in)
+{
+  unsigned int result = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    result |= (unsigned int)(unsigned char)in[i] << (i * 8);
+  }
+  return result;
+}
+
+unsigned long long decodeU64(const char* in)
+{
+  unsigned long long result = 0;
+  for (int i = 0; i < 8; i++)
+  {
+    result |= (unsigned long long)(unsigned char)in[i] << (i * 8);
+  }
+  return result;
+}
+
+struct FrameEntry
+{
+  // offset of the frame from the start of the compressed stream.
+  long long fileOffset;
+  // uncompressed offset of the frame's first byte.
+  long long uncompressedStart;
+};
+
+}
+
+class BlockCompressedOstream::Buffer : public streambuf
+{
+public:
+
+  Buffer(ostream& sink, int blockSize) :
+    _sink(sink),
+    _closed(false),
+    _uncompressed(0)
+  {
+    _startPos = (long long)_sink.tellp();
+    _block.resize(blockSize);
+    setp(&_block[0], &_block[0] + _block.size());
+    _sink.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+  }
+
+  virtual ~Buffer()
+  {
+    close();
+  }
+
+  void close()
+  {
+    if (_closed)
+    {
+      return;
+    }
+    _flushBlock();
+    _writeIndex();
+    _closed = true;
+    _sink.flush();
+  }
+
+protected:
+
+  virtual int_type overflow(int_type c)
+  {
+    _flushBlock();
+    if (c != traits_type::eof())
+    {
+      *pptr() = (char)c;
+      pbump(1);
+    }
+    return c;
+  }
+
+  virtual int sync()
+  {
+    // flushing mid-stream just cuts a shorter frame; the format doesn't care.
+    _flushBlock();
+    _sink.flush();
+    return _sink.good() ? 0 : -1;
+  }
+
+private:
+
+  void _flushBlock()
+  {
+    const int n = (int)(pptr() - pbase());
+    if (n == 0)
+    {
+      return;
+    }
+
+    const QByteArray compressed = qCompress(QByteArray::fromRawData(pbase(), n));
+
+    FrameEntry entry;
+    entry.fileOffset = (long long)_sink.tellp() - _startPos;
+    entry.uncompressedStart = _uncompressed;
+    _index.push_back(entry);
+
+    char sizes[8];
+    encodeU32((unsigned int)compressed.size(), sizes);
+    encodeU32((unsigned int)n, sizes + 4);
+    _sink.write(sizes, sizeof(sizes));
+    _sink.write(compressed.constData(), compressed.size());
+
+    _uncompressed += n;
+    setp(&_block[0], &_block[0] + _block.size());
+  }
+
+  void _writeIndex()
+  {
+    char buffer[16];
+    for (size_t i = 0; i < _index.size(); i++)
+    {
+      encodeU64((unsigned long long)_index[i].fileOffset, buffer);
+      encodeU64((unsigned long long)_index[i].uncompressedStart, buffer + 8);
+      _sink.write(buffer, sizeof(buffer));
+    }
+    encodeU64((unsigned long long)_index.size(), buffer);
+    encodeU64((unsigned long long)_uncompressed, buffer + 8);
+    _sink.write(buffer, sizeof(buffer));
+    _sink.write(TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+  }
+
+  ostream& _sink;
+  bool _closed;
+  long long _startPos;
+  long long _uncompressed;
+  vector<char> _block;
+  vector<FrameEntry> _index;
+};
+
+BlockCompressedOstream::BlockCompressedOstream(ostream& sink, int blockSize) :
+  ostream(0)
+{
+  if (blockSize < 1)
+  {
+    throw Exception("The block size must be positive.");
+  }
+  _buffer = new Buffer(sink, blockSize);
+  rdbuf(_buffer);
+}
+
+BlockCompressedOstream::~BlockCompressedOstream()
+{
+  delete _buffer;
+}
+
+void BlockCompressedOstream::close()
+{
+  _buffer->close();
+}
+
+class BlockCompressedIstream::Buffer : public streambuf
+{
+public:
+
+  Buffer(istream& source) :
+    _source(source),
+    _currentFrame(-1)
+  {
+    _startPos = (long long)_source.tellg();
+
+    char magic[8];
+    _read(magic, sizeof(magic));
+    if (memcmp(magic, HEADER_MAGIC, sizeof(magic)) != 0)
+    {
+      throw Exception("The source is not a block compressed stream.");
+    }
+
+    // the index lives at the end; the source must extend no further than the trailer.
+    _source.seekg(0, ios::end);
+    const long long endPos = (long long)_source.tellg();
+    if (endPos - _startPos < (long long)(sizeof(magic) + TRAILER_SIZE))
+    {
+      throw Exception("The block compressed stream is truncated.");
+    }
+    _source.seekg(endPos - TRAILER_SIZE);
+    char trailer[TRAILER_SIZE];
+    _read(trailer, sizeof(trailer));
+    if (memcmp(trailer + 16, TRAILER_MAGIC, 8) != 0)
+    {
+      throw Exception("The block compressed stream is truncated.");
+    }
+    const long long frameCount = (long long)decodeU64(trailer);
+    _totalUncompressed = (long long)decodeU64(trailer + 8);
+
+    _source.seekg(endPos - TRAILER_SIZE - frameCount * 16);
+    _index.resize(frameCount);
+    for (long long i = 0; i < frameCount; i++)
+    {
+      char buffer[16];
+      _read(buffer, sizeof(buffer));
+      _index[i].fileOffset = (long long)decodeU64(buffer);
+      _index[i].uncompressedStart = (long long)decodeU64(buffer + 8);
+    }
+
+    setg(0, 0, 0);
+  }
+
+  long long uncompressedSize() const { return _totalUncompressed; }
+
+protected:
+
+  virtual int_type underflow()
+  {
+    if (_currentFrame + 1 >= (long long)_index.size())
+    {
+      return traits_type::eof();
+    }
+    _loadFrame(_currentFrame + 1);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  virtual pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode mode)
+  {
+    long long target;
+    switch (dir)
+    {
+    case ios_base::beg:
+      target = off;
+      break;
+    case ios_base::cur:
+      target = _position() + off;
+      break;
+    case ios_base::end:
+      target = _totalUncompressed + off;
+      break;
+    default:
+      return pos_type(off_type(-1));
+    }
+    return seekpos(pos_type(target), mode);
+  }
+
+  virtual pos_type seekpos(pos_type pos, ios_base::openmode)
+  {
+    const long long target = (long long)pos;
+    if (target < 0 || target > _totalUncompressed)
+    {
+      return pos_type(off_type(-1));
+    }
+    if (target == _totalUncompressed)
+    {
+      // position at EOF without decompressing anything.
+      _currentFrame = (long long)_index.size();
+      setg(0, 0, 0);
+      return pos;
+    }
+
+    // binary search for the frame containing the target offset.
+    long long lo = 0;
+    long long hi = (long long)_index.size() - 1;
+    while (lo < hi)
+    {
+      const long long mid = (lo + hi + 1) / 2;
+      if (_index[mid].uncompressedStart <= target)
+      {
+        lo = mid;
+      }
+      else
+      {
+        hi = mid - 1;
+      }
+    }
+
+    if (lo != _currentFrame)
+    {
+      _loadFrame(lo);
+    }
+    setg(eback(), eback() + (target - _index[lo].uncompressedStart), egptr());
+    return pos;
+  }
+
+private:
+
+  long long _position()
+  {
+    if (_currentFrame < 0 || _currentFrame >= (long long)_index.size())
+    {
+      return _currentFrame < 0 ? 0 : _totalUncompressed;
+    }
+    return _index[_currentFrame].uncompressedStart + (long long)(gptr() - eback());
+  }
+
+  void _read(char* buffer, int n)
+  {
+    _source.read(buffer, n);
+    if (_source.gcount() != n)
+    {
+      throw Exception("Error reading the block compressed stream.");
+    }
+  }
+
+  void _loadFrame(long long i)
+  {
+    _source.clear();
+    _source.seekg(_startPos + _index[i].fileOffset);
+    char sizes[8];
+    _read(sizes, sizeof(sizes));
+    const unsigned int compressedLen = decodeU32(sizes);
+    const unsigned int uncompressedLen = decodeU32(sizes + 4);
+
+    QByteArray compressed;
+    compressed.resize(compressedLen);
+    _read(compressed.data(), compressedLen);
+    _frame = qUncompress(compressed);
+    if ((unsigned int)_frame.size() != uncompressedLen)
+    {
+      throw Exception("Error decompressing a block; the stream is corrupt.");
+    }
+
+    _currentFrame = i;
+    setg(_frame.data(), _frame.data(), _frame.data() + _frame.size());
+  }
+
+  istream& _source;
+  long long _startPos;
+  long long _totalUncompressed;
+  long long _currentFrame;
+  vector<FrameEntry> _index;
+  QByteArray _frame;
+};
+
+BlockCompressedIstream::BlockCompressedIstream(istream& source) :
+  istream(0)
+{
+  _buffer = new Buffer(source);
+  rdbuf(_buffer);
+}
+
+BlockCompressedIstream::~BlockCompressedIstream()
+{
+  delete _buffer;
+}
+
+long long BlockCompressedIstream::uncompressedSize() const
+{
+  return _buffer->uncompressedSize();
+}
+
+}
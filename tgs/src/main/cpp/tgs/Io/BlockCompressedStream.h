@@ -0,0 +1,102 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef BLOCKCOMPRESSEDSTREAM_H
+#define BLOCKCOMPRESSEDSTREAM_H
+
+#include "../TgsExport.h"
+
+// Standard
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace Tgs
+{
+
+/**
+ * Writes a block compressed stream with a frame index: the payload is cut into fixed size
+ * blocks, each block is compressed independently (zlib via Qt) and an index mapping uncompressed
+ * offsets to file offsets is appended at the end. Because blocks are independent, a reader can
+ * seek to any uncompressed offset by decompressing only the block containing it, so consumers
+ * that cache serialized maps (e.g. the four-pass intermediates read through ObjectInputStream)
+ * can restore one section of a cached file without decompressing everything before it.
+ *
+ * This is an ordinary std::ostream; close() (or destruction) flushes the last block and writes
+ * the index. The underlying sink must outlive this stream and be positioned where the
+ * compressed data should start.
+ */
+class TGS_EXPORT BlockCompressedOstream : public std::ostream
+{
+public:
+
+  /**
+   * Larger blocks compress better, smaller blocks seek with less wasted decompression. The
+   * default suits maps with sections in the tens of megabytes.
+   */
+  BlockCompressedOstream(std::ostream& sink, int blockSize = 1024 * 1024);
+
+  virtual ~BlockCompressedOstream();
+
+  /**
+   * Flushes the last partial block and writes the frame index. The stream must not be written
+   * after closing.
+   */
+  void close();
+
+private:
+
+  class Buffer;
+  Buffer* _buffer;
+};
+
+/**
+ * Reads a stream written by BlockCompressedOstream. Supports the full istream interface
+ * including seekg/tellg over uncompressed offsets; a seek decompresses only the target block.
+ * The underlying source must be seekable and must outlive this stream.
+ */
+class TGS_EXPORT BlockCompressedIstream : public std::istream
+{
+public:
+
+  BlockCompressedIstream(std::istream& source);
+
+  virtual ~BlockCompressedIstream();
+
+  /**
+   * Returns the total uncompressed payload size in bytes.
+   */
+  long long uncompressedSize() const;
+
+private:
+
+  class Buffer;
+  Buffer* _buffer;
+};
+
+}
+
+#endif // BLOCKCOMPRESSEDSTREAM_H
@@ -90,6 +90,10 @@ public:
     return result;
   }
 
+  /**
+   * Returns the number of items currently in the cache.
+   */
+  size_t size() const { return _cacheList.size(); }
 
 private:
 
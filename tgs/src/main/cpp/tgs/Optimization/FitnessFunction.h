@@ -46,6 +46,21 @@ public:
 typedef boost::shared_ptr<FitnessFunction> FitnessFunctionPtr;
 typedef boost::shared_ptr<const FitnessFunction> ConstFitnessFunctionPtr;
 
+/**
+ * Creates fitness function instances. Parallel optimizers use this to give each worker its own
+ * evaluator, so a single evaluation (e.g. a mini conflation) is free to keep whatever internal
+ * state or concurrency it likes without synchronizing with its siblings.
+ */
+class FitnessFunctionFactory
+{
+public:
+  virtual ~FitnessFunctionFactory() {}
+
+  virtual FitnessFunctionPtr create() = 0;
+};
+
+typedef boost::shared_ptr<FitnessFunctionFactory> FitnessFunctionFactoryPtr;
+
 }
 
 #endif // FITNESSFUNCTION_H
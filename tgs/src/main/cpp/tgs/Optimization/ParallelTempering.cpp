@@ -0,0 +1,225 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "ParallelTempering.h"
+
+// Standard
+#include <math.h>
+#include <iostream>
+#include <limits>
+
+// Qt
+#include <QDataStream>
+#include <QFile>
+#include <QFuture>
+#include <QtConcurrentRun>
+
+// Tgs
+#include <tgs/TgsException.h>
+
+namespace Tgs
+{
+using namespace std;
+
+ParallelTempering::ParallelTempering(ConstStateDescriptionPtr sd,
+  FitnessFunctionFactoryPtr fitness, int chains) : _rand(0), _verbose(false)
+{
+  _stateDescription = sd;
+  _fitnessFactory = fitness;
+  _chainCount = std::max(1, chains);
+  _exchangePeriod = 10;
+  _kCompleted = 0;
+  _minTemperature = 0.05;
+  _bestScore = numeric_limits<double>::max();
+}
+
+void ParallelTempering::_exchange()
+{
+  for (int i = 0; i + 1 < _chains.size(); i++)
+  {
+    ConstStatePtr a = _chains[i]->getCurrentState();
+    ConstStatePtr b = _chains[i + 1]->getCurrentState();
+    if (a.get() == 0 || b.get() == 0)
+    {
+      continue;
+    }
+
+    // the usual replica exchange acceptance. If the hotter chain (i) holds a better state than
+    // its colder neighbor the swap is always accepted, otherwise it is accepted with a
+    // probability that shrinks with the score gap and the temperature gap.
+    double p = exp((1.0 / _temperatures[i] - 1.0 / _temperatures[i + 1]) *
+      (a->getScore() - b->getScore()));
+    if (p >= _rand.generateUniform())
+    {
+      _chains[i]->setCurrentState(b);
+      _chains[i + 1]->setCurrentState(a);
+    }
+  }
+}
+
+void ParallelTempering::_initChains()
+{
+  if (_chains.size() > 0)
+  {
+    return;
+  }
+
+  for (int i = 0; i < _chainCount; i++)
+  {
+    boost::shared_ptr<SimulatedAnnealing> chain(
+      new SimulatedAnnealing(_stateDescription, _fitnessFactory->create()));
+    // give each chain its own random stream.
+    chain->setSeed(i + 1);
+    _chains.append(chain);
+
+    // space the temperatures geometrically from 1.0 (hottest) down to the minimum (coldest).
+    double t = _chainCount == 1 ? _minTemperature :
+      pow(_minTemperature, (double)i / (double)(_chainCount - 1));
+    _temperatures.append(t);
+  }
+}
+
+double ParallelTempering::iterate(int kmax)
+{
+  _initChains();
+
+  while (_kCompleted < kmax)
+  {
+    int steps = std::min(_exchangePeriod, kmax - _kCompleted);
+
+    if (_verbose)
+    {
+      cout << "Running parallel tempering steps: " << _kCompleted + steps << "/" << kmax <<
+        " ..." << endl;
+    }
+
+    QList< QFuture<double> > futures;
+    for (int i = 0; i < _chains.size(); i++)
+    {
+      futures.append(QtConcurrent::run(_chains[i].get(), &SimulatedAnnealing::runSegment,
+        steps, _temperatures[i]));
+    }
+    for (int i = 0; i < futures.size(); i++)
+    {
+      futures[i].waitForFinished();
+    }
+    _kCompleted += steps;
+
+    _exchange();
+    _mergeBestStates();
+
+    if (_checkpointPath.isEmpty() == false)
+    {
+      _writeCheckpoint();
+    }
+  }
+
+  return _bestScore;
+}
+
+void ParallelTempering::_mergeBestStates()
+{
+  for (int i = 0; i < _chains.size(); i++)
+  {
+    if (_chains[i]->getBestScore() < _bestScore)
+    {
+      _bestScore = _chains[i]->getBestScore();
+      _bestStates = _chains[i]->getBestStates();
+    }
+    else if (_chains[i]->getBestScore() == _bestScore)
+    {
+      _bestStates.unite(_chains[i]->getBestStates());
+    }
+  }
+}
+
+bool ParallelTempering::resume()
+{
+  QFile f(_checkpointPath);
+  if (f.exists() == false)
+  {
+    return false;
+  }
+  if (f.open(QIODevice::ReadOnly) == false)
+  {
+    throw Exception("Error opening checkpoint file for reading.");
+  }
+  QDataStream ds(&f);
+
+  quint32 version;
+  ds >> version;
+  if (version != 0x0)
+  {
+    throw Exception("Unexpected version.");
+  }
+
+  qint32 chainCount;
+  ds >> chainCount;
+  if (chainCount != _chainCount)
+  {
+    throw Exception("The checkpoint was written with a different chain count.");
+  }
+
+  qint32 kCompleted;
+  ds >> kCompleted;
+  _kCompleted = kCompleted;
+
+  quint32 seed;
+  ds >> seed;
+  _rand.seed(seed);
+
+  _initChains();
+  for (int i = 0; i < _chains.size(); i++)
+  {
+    _chains[i]->loadState(ds);
+  }
+
+  _mergeBestStates();
+
+  return true;
+}
+
+void ParallelTempering::_writeCheckpoint() const
+{
+  QFile f(_checkpointPath);
+  if (f.open(QIODevice::WriteOnly) == false)
+  {
+    throw Exception("Error opening checkpoint file for writing.");
+  }
+  QDataStream ds(&f);
+
+  // write a version.
+  ds << (quint32)0x0;
+  ds << (qint32)_chainCount;
+  ds << (qint32)_kCompleted;
+  ds << (quint32)_rand.getSeed();
+  for (int i = 0; i < _chains.size(); i++)
+  {
+    _chains[i]->saveState(ds);
+  }
+}
+
+}
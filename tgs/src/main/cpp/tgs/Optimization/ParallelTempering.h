@@ -0,0 +1,137 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef PARALLELTEMPERING_H
+#define PARALLELTEMPERING_H
+
+// Qt
+#include <QList>
+#include <QSet>
+#include <QString>
+
+// Tgs
+#include <tgs/Statistics/Random.h>
+
+#include "FitnessFunction.h"
+#include "SimulatedAnnealing.h"
+
+namespace Tgs
+{
+
+/**
+ * Runs several simulated annealing chains concurrently at fixed temperatures and periodically
+ * proposes state exchanges between neighboring rungs of the temperature ladder (parallel
+ * tempering, aka replica exchange). The hot chains explore broadly while the cold chains
+ * refine, and the exchanges let a good state found by a hot chain migrate down the ladder.
+ *
+ * Each chain runs on its own thread with its own fitness function instance created by the
+ * supplied factory, so fitness functions don't need to be thread safe and are free to use
+ * whatever internal concurrency they like. The full optimizer state can optionally be
+ * checkpointed to a file after every exchange round and resumed later, which matters when a
+ * single fitness evaluation is a mini conflation and a run takes days.
+ */
+class ParallelTempering
+{
+public:
+
+  ParallelTempering(ConstStateDescriptionPtr sd, FitnessFunctionFactoryPtr fitness,
+    int chains = 4);
+
+  double getBestScore() const { return _bestScore; }
+
+  QSet<ConstStatePtr> getBestStates() const { return _bestStates; }
+
+  /**
+   * Runs until every chain has performed kmax steps, attempting exchanges after every exchange
+   * period. May be called after resume() to continue a previous run, in which case only the
+   * remaining steps are run. Returns the best score found.
+   */
+  double iterate(int kmax);
+
+  /**
+   * Loads the state written to the checkpoint file by a previous run. Returns false if the
+   * checkpoint file doesn't exist. The state description and chain count must match the run
+   * that wrote the checkpoint.
+   */
+  bool resume();
+
+  /**
+   * The file the optimizer state is written to after every exchange round. No checkpoints are
+   * written if empty (the default).
+   */
+  void setCheckpointPath(QString path) { _checkpointPath = path; }
+
+  /**
+   * The number of steps each chain runs between exchange attempts. Defaults to 10.
+   */
+  void setExchangePeriod(int steps) { _exchangePeriod = steps; }
+
+  /**
+   * The temperature of the coldest chain. The chain temperatures are spaced geometrically from
+   * 1.0 down to this value. Defaults to 0.05.
+   */
+  void setMinTemperature(double t) { _minTemperature = t; }
+
+  void setVerbose(bool verbose) { _verbose = verbose; }
+
+private:
+
+  double _bestScore;
+  QSet<ConstStatePtr> _bestStates;
+  QList< boost::shared_ptr<SimulatedAnnealing> > _chains;
+  int _chainCount;
+  QString _checkpointPath;
+  int _exchangePeriod;
+  FitnessFunctionFactoryPtr _fitnessFactory;
+  int _kCompleted;
+  double _minTemperature;
+  mutable Random _rand;
+  ConstStateDescriptionPtr _stateDescription;
+  QList<double> _temperatures;
+  bool _verbose;
+
+  /**
+   * Proposes a state exchange between each pair of neighboring chains on the ladder.
+   */
+  void _exchange();
+
+  /**
+   * Creates the chains and the temperature ladder if they don't exist yet.
+   */
+  void _initChains();
+
+  /**
+   * Folds each chain's best states into the global best.
+   */
+  void _mergeBestStates();
+
+  void _writeCheckpoint() const;
+
+};
+
+}
+
+#endif // PARALLELTEMPERING_H
@@ -104,7 +104,7 @@ StatePtr SimulatedAnnealing::_generateRandomState() const
   return result;
 }
 
-double SimulatedAnnealing::iterate(int kmax)
+void SimulatedAnnealing::_initializeState()
 {
   if (_verbose)
   {
@@ -113,10 +113,18 @@ double SimulatedAnnealing::iterate(int kmax)
 
   StatePtr s1 = _generateRandomState();
   s1->setScore(_fitness->f(s1));
-  ConstStatePtr s = s1;
-  _bestScore = s->getScore();
-  _bestStates.insert(s);
-  //std::cout << "s: " << s->toString().toUtf8().data() << std::endl;
+  _current = s1;
+  _bestScore = _current->getScore();
+  _bestStates.insert(_current);
+  //std::cout << "s: " << _current->toString().toUtf8().data() << std::endl;
+}
+
+double SimulatedAnnealing::iterate(int kmax)
+{
+  if (_current.get() == 0)
+  {
+    _initializeState();
+  }
 
   for (int k = 0; k < kmax; ++k)
   {
@@ -126,37 +134,130 @@ double SimulatedAnnealing::iterate(int kmax)
     }
 
     double T = 1.0 - (double)k / (double)kmax;
-    StatePtr sNew = _generateNeighbor(s, T);
-//    std::cout << "s: " << s->toString().toUtf8().data() << std::endl;
-//    std::cout << "sNew: " << sNew->toString().toUtf8().data() << std::endl;
-    sNew->setScore(_fitness->f(sNew));
-//    cout << "sNew score: " << sNew->getScore() << endl;
+    _step(T);
+  }
 
-    if (sNew->getScore() < _bestScore)
-    {
-      _bestScore = sNew->getScore();
-      _bestStates.clear();
-      _bestStates.insert(sNew);
-    }
-    else if (sNew->getScore() == _bestScore)
-    {
-      _bestStates.insert(sNew);
-    }
-//    cout << "_bestScore: " << _bestScore << endl;
+  return _bestScore;
+}
 
-    if (_pickFromBestScores)
-    {
-      s = _bestStates.toList()[_rand.generateInt() % _bestStates.size()];
-    }
-    else if (_P(s->getScore(), sNew->getScore(), T) >= _rand.generateUniform())
-    {
-      s = sNew;
-    }
+double SimulatedAnnealing::runSegment(int steps, double T)
+{
+  if (_current.get() == 0)
+  {
+    _initializeState();
+  }
+
+  for (int k = 0; k < steps; ++k)
+  {
+    _step(T);
   }
 
   return _bestScore;
 }
 
+void SimulatedAnnealing::_step(double T)
+{
+  StatePtr sNew = _generateNeighbor(_current, T);
+//  std::cout << "s: " << _current->toString().toUtf8().data() << std::endl;
+//  std::cout << "sNew: " << sNew->toString().toUtf8().data() << std::endl;
+  sNew->setScore(_fitness->f(sNew));
+//  cout << "sNew score: " << sNew->getScore() << endl;
+
+  if (sNew->getScore() < _bestScore)
+  {
+    _bestScore = sNew->getScore();
+    _bestStates.clear();
+    _bestStates.insert(sNew);
+  }
+  else if (sNew->getScore() == _bestScore)
+  {
+    _bestStates.insert(sNew);
+  }
+//  cout << "_bestScore: " << _bestScore << endl;
+
+  if (_pickFromBestScores)
+  {
+    _current = _bestStates.toList()[_rand.generateInt() % _bestStates.size()];
+  }
+  else if (_P(_current->getScore(), sNew->getScore(), T) >= _rand.generateUniform())
+  {
+    _current = sNew;
+  }
+}
+
+void SimulatedAnnealing::loadState(QDataStream& ds)
+{
+  quint32 version;
+  ds >> version;
+
+  if (version != 0x0)
+  {
+    throw Exception("Unexpected version.");
+  }
+
+  quint32 seed;
+  ds >> seed;
+  _rand.seed(seed);
+  ds >> _bestScore;
+  _current = _readState(ds);
+
+  qint32 stateCount;
+  ds >> stateCount;
+  _bestStates.clear();
+  for (int i = 0; i < stateCount; i++)
+  {
+    _bestStates.insert(_readState(ds));
+  }
+}
+
+void SimulatedAnnealing::saveState(QDataStream& ds) const
+{
+  // write a version.
+  ds << (quint32)0x0;
+  ds << (quint32)_rand.getSeed();
+  ds << _bestScore;
+  _writeState(ds, _current);
+
+  ds << (qint32)_bestStates.size();
+  foreach (ConstStatePtr s, _bestStates)
+  {
+    _writeState(ds, s);
+  }
+}
+
+StatePtr SimulatedAnnealing::_readState(QDataStream& ds) const
+{
+  bool present;
+  ds >> present;
+  if (!present)
+  {
+    return StatePtr();
+  }
+
+  QMap<QString, double> values;
+  double score;
+  ds >> values;
+  ds >> score;
+
+  StatePtr s(new State());
+  foreach (QString k, values.keys())
+  {
+    s->set(k, values[k]);
+  }
+  s->setScore(score);
+  return s;
+}
+
+void SimulatedAnnealing::_writeState(QDataStream& ds, ConstStatePtr s) const
+{
+  ds << (s.get() != 0);
+  if (s.get() != 0)
+  {
+    ds << s->getAllValues();
+    ds << s->getScore();
+  }
+}
+
 double SimulatedAnnealing::_P(double e, double eNew, double T) const
 {
   // Taken from https://en.wikipedia.org/wiki/Simulated_annealing#Acceptance_probabilities_2
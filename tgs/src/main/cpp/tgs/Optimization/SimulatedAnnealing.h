@@ -28,6 +28,7 @@
 #define SIMULATEDANNEALING_H
 
 // Qt
+#include <QDataStream>
 #include <QSet>
 
 // Tgs
@@ -47,8 +48,41 @@ public:
 
   QSet<ConstStatePtr> getBestStates() const { return _bestStates; }
 
+  double getBestScore() const { return _bestScore; }
+
+  /**
+   * Returns the state the chain is currently at, or null if no iterations have run yet.
+   */
+  ConstStatePtr getCurrentState() const { return _current; }
+
   double iterate(int kmax);
 
+  /**
+   * Reads the chain state written by saveState, resuming the random stream, current state and
+   * best states exactly where they left off.
+   */
+  void loadState(QDataStream& ds);
+
+  /**
+   * Runs the chain for the given number of steps at a fixed temperature, initializing with a
+   * random state first if no iterations have run yet. Used by parallel tempering where each
+   * chain holds one rung of the temperature ladder. Returns the best score found so far.
+   */
+  double runSegment(int steps, double T);
+
+  /**
+   * Writes the chain state to the stream so a later run can pick up where this one stopped.
+   */
+  void saveState(QDataStream& ds) const;
+
+  /**
+   * Replaces the chain's current state, e.g. with a state exchanged from another chain. The
+   * state's score must already be set.
+   */
+  void setCurrentState(ConstStatePtr s) { _current = s; }
+
+  void setSeed(unsigned int s) { _rand.seed(s); }
+
   /**
    * If set to true then the next neighbor will always be generated from a state in the set of
    * best states found so far.
@@ -62,6 +96,7 @@ private:
   mutable Random _rand;
   double _bestScore;
   QSet<ConstStatePtr> _bestStates;
+  ConstStatePtr _current;
   FitnessFunctionPtr _fitness;
   bool _pickFromBestScores;
   ConstStateDescriptionPtr _stateDescription;
@@ -70,8 +105,22 @@ private:
   StatePtr _generateNeighbor(ConstStatePtr from, double T) const;
   StatePtr _generateRandomState() const;
 
+  /**
+   * Generates and scores the initial random state.
+   */
+  void _initializeState();
+
   double _P(double e, double eNew, double T) const;
 
+  StatePtr _readState(QDataStream& ds) const;
+
+  /**
+   * Runs a single annealing step at temperature T.
+   */
+  void _step(double T);
+
+  void _writeState(QDataStream& ds, ConstStatePtr s) const;
+
 };
 
 }
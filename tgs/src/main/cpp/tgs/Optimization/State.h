@@ -51,6 +51,8 @@ public:
 
   void set(ConstVariableDescriptionPtr k, double v) { _values[k->getName()] = v; }
 
+  void set(QString name, double v) { _values[name] = v; }
+
   void setScore(double s) { _score = s; }
 
   QString toString() const;
@@ -0,0 +1,209 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#ifndef __TGS__ORDERED_HASH_MAP_H__
+#define __TGS__ORDERED_HASH_MAP_H__
+
+#include "HashMap.h"
+
+// Standard
+#include <utility>
+#include <vector>
+
+namespace Tgs
+{
+
+/**
+ * A HashMap with deterministic, insertion ordered iteration. HashMap's iteration order depends on
+ * the hash layout, which forces code that needs reproducible output to collect and sort the keys
+ * before every pass -- O(n log n) per op in a multi-op pipeline. This container keeps entries in a
+ * dense slot vector in insertion order alongside a hash index, so iteration is both deterministic
+ * and cache friendly. Lookups stay O(1); erase leaves a tombstone and the slot vector is compacted
+ * once tombstones outnumber live entries, so erase is O(1) amortized.
+ *
+ * The iterator surface mimics HashMap (it->first / it->second) so id keyed containers like
+ * NodeMap/WayMap can adopt it without touching call sites. Iterators are invalidated by any
+ * insert or erase. The key in a dereferenced entry must not be modified.
+ */
+template <class K, class V>
+class OrderedHashMap
+{
+public:
+
+  typedef std::pair<K, V> value_type;
+
+private:
+
+  struct Slot
+  {
+    value_type kv;
+    bool live;
+
+    Slot(const value_type& akv) : kv(akv), live(true) {}
+  };
+
+  typedef std::vector<Slot> SlotVector;
+
+public:
+
+  template <class SlotVectorT, class ValueT>
+  class Iterator
+  {
+  public:
+
+    Iterator(SlotVectorT* slots, size_t pos) : _slots(slots), _pos(pos) { _skipDead(); }
+
+    // lets an iterator convert to a const_iterator.
+    template <class SV2, class V2>
+    Iterator(const Iterator<SV2, V2>& other) : _slots(other._slots), _pos(other._pos) {}
+
+    ValueT& operator*() const { return (*_slots)[_pos].kv; }
+    ValueT* operator->() const { return &(*_slots)[_pos].kv; }
+
+    Iterator& operator++()
+    {
+      ++_pos;
+      _skipDead();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const { return _pos == other._pos; }
+    bool operator!=(const Iterator& other) const { return _pos != other._pos; }
+
+  private:
+
+    template <class SV2, class V2> friend class Iterator;
+
+    SlotVectorT* _slots;
+    size_t _pos;
+
+    void _skipDead()
+    {
+      while (_pos < _slots->size() && (*_slots)[_pos].live == false)
+      {
+        ++_pos;
+      }
+    }
+  };
+
+  typedef Iterator<SlotVector, value_type> iterator;
+  typedef Iterator<const SlotVector, const value_type> const_iterator;
+
+  OrderedHashMap() : _deadCount(0) {}
+
+  iterator begin() { return iterator(&_slots, 0); }
+  iterator end() { return iterator(&_slots, _slots.size()); }
+  const_iterator begin() const { return const_iterator(&_slots, 0); }
+  const_iterator end() const { return const_iterator(&_slots, _slots.size()); }
+
+  void clear()
+  {
+    _slots.clear();
+    _index.clear();
+    _deadCount = 0;
+  }
+
+  size_t count(const K& k) const { return _index.find(k) != _index.end() ? 1 : 0; }
+
+  bool empty() const { return _index.empty(); }
+
+  iterator find(const K& k)
+  {
+    typename HashMap<K, size_t>::const_iterator it = _index.find(k);
+    return it == _index.end() ? end() : iterator(&_slots, it->second);
+  }
+
+  const_iterator find(const K& k) const
+  {
+    typename HashMap<K, size_t>::const_iterator it = _index.find(k);
+    return it == _index.end() ? end() : const_iterator(&_slots, it->second);
+  }
+
+  size_t size() const { return _index.size(); }
+
+  V& operator[](const K& k)
+  {
+    typename HashMap<K, size_t>::iterator it = _index.find(k);
+    if (it != _index.end())
+    {
+      return _slots[it->second].kv.second;
+    }
+    _slots.push_back(Slot(value_type(k, V())));
+    _index[k] = _slots.size() - 1;
+    return _slots.back().kv.second;
+  }
+
+  size_t erase(const K& k)
+  {
+    typename HashMap<K, size_t>::iterator it = _index.find(k);
+    if (it == _index.end())
+    {
+      return 0;
+    }
+    Slot& s = _slots[it->second];
+    s.live = false;
+    // release whatever the value holds now rather than when the slot is compacted away.
+    s.kv.second = V();
+    _index.erase(it);
+    _deadCount++;
+    if (_deadCount > _index.size())
+    {
+      _compact();
+    }
+    return 1;
+  }
+
+private:
+
+  SlotVector _slots;
+  HashMap<K, size_t> _index;
+  size_t _deadCount;
+
+  /**
+   * Packs the live slots down in order, dropping the tombstones. Each entry is moved at most
+   * once per time it is erased, so the amortized cost per erase stays constant.
+   */
+  void _compact()
+  {
+    SlotVector packed;
+    packed.reserve(_index.size());
+    for (size_t i = 0; i < _slots.size(); i++)
+    {
+      if (_slots[i].live)
+      {
+        _index[_slots[i].kv.first] = packed.size();
+        packed.push_back(_slots[i]);
+      }
+    }
+    _slots.swap(packed);
+    _deadCount = 0;
+  }
+};
+
+}
+
+#endif
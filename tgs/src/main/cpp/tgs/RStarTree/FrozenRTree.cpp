@@ -0,0 +1,152 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#include "FrozenRTree.h"
+
+// Standard Includes
+#include <assert.h>
+#include <deque>
+
+#include "RStarTree.h"
+#include "RTreeNode.h"
+
+namespace Tgs
+{
+  FrozenRTree::FrozenRTree(const RStarTree& tree)
+  {
+    const RTreeNode* root = tree.getRoot();
+    _dimensions = root->getDimensions();
+
+    std::deque<int> pending;
+    pending.push_back(root->getId());
+
+    while (pending.size() > 0)
+    {
+      const RTreeNode* node = tree.getNode(pending.front());
+      pending.pop_front();
+
+      const bool leaf = node->isLeafNode();
+      _firstChild.push_back((int)_target.size());
+      _childCount.push_back(node->getChildCount());
+      _leaf.push_back(leaf);
+
+      for (int i = 0; i < node->getChildCount(); i++)
+      {
+        const BoxInternalData b = node->getChildEnvelope(i);
+        for (int d = 0; d < _dimensions; d++)
+        {
+          _lower[d].push_back(b.getLowerBoundRaw(d));
+          _upper[d].push_back(b.getUpperBoundRaw(d));
+        }
+        if (leaf)
+        {
+          _target.push_back(node->getChildUserId(i));
+        }
+        else
+        {
+          // breadth first order makes the child's frozen index the number of nodes already
+          // emitted plus the number still waiting in the queue.
+          _target.push_back((int)(_firstChild.size() + pending.size()));
+          pending.push_back(node->getChildNodeId(i));
+        }
+      }
+    }
+  }
+
+  void FrozenRTree::findIntersections(const std::vector<double>& minBounds,
+    const std::vector<double>& maxBounds, std::vector<int>& results) const
+  {
+    assert((int)minBounds.size() == _dimensions && (int)maxBounds.size() == _dimensions);
+
+    std::vector<int> pendingNodes;
+    pendingNodes.reserve(64);
+    pendingNodes.push_back(0);
+
+    std::vector<char> hits;
+
+    while (pendingNodes.size() > 0)
+    {
+      const int n = pendingNodes.back();
+      pendingNodes.pop_back();
+
+      const int start = _firstChild[n];
+      const int count = _childCount[n];
+      if (count == 0)
+      {
+        continue;
+      }
+
+      // test all the children in one pass per dimension; these loops are branch-free over
+      // sequential memory so the compiler can vectorize them.
+      hits.assign(count, 1);
+      for (int d = 0; d < _dimensions; d++)
+      {
+        const double* lower = &_lower[d][0] + start;
+        const double* upper = &_upper[d][0] + start;
+        const double queryLower = minBounds[d];
+        const double queryUpper = maxBounds[d];
+        for (int j = 0; j < count; j++)
+        {
+          hits[j] = hits[j] & (char)((lower[j] <= queryUpper) & (queryLower <= upper[j]));
+        }
+      }
+
+      if (_leaf[n])
+      {
+        for (int j = 0; j < count; j++)
+        {
+          if (hits[j])
+          {
+            results.push_back(_target[start + j]);
+          }
+        }
+      }
+      else
+      {
+        for (int j = 0; j < count; j++)
+        {
+          if (hits[j])
+          {
+            pendingNodes.push_back(_target[start + j]);
+          }
+        }
+      }
+    }
+  }
+
+  size_t FrozenRTree::getMemoryUsageEstimate() const
+  {
+    size_t result = sizeof(*this);
+    result += (_firstChild.size() + _childCount.size() + _target.size()) * sizeof(int);
+    result += _leaf.size() / 8;
+    for (int d = 0; d < _dimensions; d++)
+    {
+      result += (_lower[d].size() + _upper[d].size()) * sizeof(double);
+    }
+    return result;
+  }
+}
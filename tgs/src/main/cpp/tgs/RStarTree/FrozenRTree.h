@@ -0,0 +1,91 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+
+#ifndef __TGS__FROZEN_R_TREE_H__
+#define __TGS__FROZEN_R_TREE_H__
+
+// Standard Includes
+#include <vector>
+
+#include "Box.h"
+
+#include "../TgsExport.h"
+
+namespace Tgs
+{
+  class RStarTree;
+
+  /**
+   * A read-only, query-optimized copy of an RStarTree. The nodes are laid out in breadth first
+   * order in flat arrays so a traversal walks contiguous memory rather than chasing pages, and
+   * the child boxes are stored one dimension per array so the overlap tests over a node's
+   * children become simple branch-free loops the compiler can vectorize.
+   *
+   * Freezing copies the tree; the frozen copy does not reflect later modifications to the
+   * source. Intended for read-mostly phases where the same index is queried many times, e.g.
+   * neighbor searches during matching.
+   */
+  class TGS_EXPORT FrozenRTree
+  {
+  public:
+
+    FrozenRTree(const RStarTree& tree);
+
+    /**
+     * Appends the user IDs of all entries whose boxes intersect the given bounds to results.
+     * The results are not cleared first and come back in no particular order.
+     */
+    void findIntersections(const std::vector<double>& minBounds,
+      const std::vector<double>& maxBounds, std::vector<int>& results) const;
+
+    int getDimensions() const { return _dimensions; }
+
+    /**
+     * Returns a rough estimate of the bytes of RAM this structure occupies.
+     */
+    size_t getMemoryUsageEstimate() const;
+
+  private:
+
+    // one entry per node, in breadth first order; the root is node 0.
+    std::vector<int> _firstChild;
+    std::vector<int> _childCount;
+    std::vector<bool> _leaf;
+
+    // one entry per child, one array per dimension, so scanning a node's children touches
+    // sequential doubles.
+    std::vector<double> _lower[Box::MAX_DIMENSIONS];
+    std::vector<double> _upper[Box::MAX_DIMENSIONS];
+    // the frozen node index for internal children or the user ID for leaf children.
+    std::vector<int> _target;
+
+    int _dimensions;
+  };
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "HilbertRTree.h"
 
 // Standard Includes
+#include <algorithm>
 #include <exception>
 #include <float.h>
 #include <math.h>
@@ -80,7 +81,6 @@ void HilbertRTree::_calculateHilbertValues(const std::vector<Box>& boxes,
   const std::vector<int>& fids, std::vector<UserBoxHolder>& hilbertBoxes)
 {
   assert(hilbertBoxes.size() == 0);
-  HilbertCurve hilbertCurve(_dimensions, 16);
 
   hilbertBoxes.reserve(boxes.size());
   Box bounds(_dimensions);
@@ -305,7 +305,7 @@ public:
     hilbertValue = hv;
   }
 
-  bool operator<(const BoxHolder& b)
+  bool operator<(const BoxHolder& b) const
   {
     return hilbertValue < b.hilbertValue;
   }
@@ -353,22 +353,9 @@ int HilbertRTree::_splitBoxes(BoxVector& boxes)
 
     hilbertBoxes.push_back(BoxHolder(boxes[i], _hilbertCurve->encode(point)));
   }
-  //sort(hilbertBoxes.begin(), hilbertBoxes.end());
-  bool swap = false;
-  do
-  {
-    swap = false;
-    for (unsigned int i = 0; i < hilbertBoxes.size() - 1; i++)
-    {
-      if (hilbertBoxes[i + 1] < hilbertBoxes[i])
-      {
-        BoxHolder tmp = hilbertBoxes[i];
-        hilbertBoxes[i] = hilbertBoxes[i + 1];
-        hilbertBoxes[i + 1] = tmp;
-        swap = true;
-      }
-    }
-  } while (swap);
+  // a stable sort keeps equal hilbert values in insertion order, matching what the old
+  // bubble sort produced
+  stable_sort(hilbertBoxes.begin(), hilbertBoxes.end());
 
   for (unsigned int i = 0; i < boxes.size(); i++)
   {
@@ -112,6 +112,7 @@ namespace Tgs
         const RTreeNode* node = _tree->getNode(_pendingNodes.front());
         nodeHits++;
         _pendingNodes.pop_front(); //Remove node from future consideration
+        std::vector<int> childNodeIds;
         for (int i = 0; i < node->getChildCount(); i++)
         {
 
@@ -126,9 +127,16 @@ namespace Tgs
             else
             {
               _pendingNodes.push_front(node->getChildNodeId(i));
+              childNodeIds.push_back(node->getChildNodeId(i));
             }
           }
         }
+        //hint the page store so the children we just queued are read in the background before
+        //they're popped
+        if (childNodeIds.size() > 0)
+        {
+          _tree->prefetchNodes(childNodeIds);
+        }
       }
     }
   }
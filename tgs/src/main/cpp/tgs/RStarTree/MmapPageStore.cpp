@@ -0,0 +1,287 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#include "MmapPageStore.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../TgsException.h"
+#include "Page.h"
+
+using namespace std;
+
+namespace Tgs
+{
+  // grow the file in chunks to keep the remap count low while pages are being created
+  const int GROWTH_PAGES = 1024;
+
+  MmapPageStore::MmapPageStore(int pageSize, const char * fileName, bool readOnly)
+    : _pageSize(pageSize),
+      _readOnly(readOnly),
+      _pageCount(0),
+      _capacityPages(0),
+      _bDestructing(false),
+      _fd(-1),
+      _map(NULL),
+      _fileName(fileName)
+  {
+    if (readOnly == true)
+    {
+      _fd = open(fileName, O_RDONLY);
+    }
+    else
+    {
+      _fd = open(fileName, O_RDWR | O_CREAT, 0644);
+    }
+    if (_fd < 0)
+    {
+      throw Tgs::Exception(_getError("Error opening file."));
+    }
+
+    struct stat sb;
+    if (fstat(_fd, &sb) != 0)
+    {
+      close(_fd);
+      throw Tgs::Exception(_getError("Error in determining page count"));
+    }
+    assert(sb.st_size % (off_t)_pageSize == 0);
+    _pageCount = (int)(sb.st_size / (off_t)_pageSize);
+
+    if (readOnly == true)
+    {
+      if (_pageCount > 0)
+      {
+        _map = (char*)mmap(NULL, (size_t)_pageCount * _pageSize, PROT_READ, MAP_SHARED, _fd, 0);
+        if (_map == MAP_FAILED)
+        {
+          _map = NULL;
+          close(_fd);
+          throw Tgs::Exception(_getError("Error mapping file."));
+        }
+        _capacityPages = _pageCount;
+        // tree traversals jump around the file; prefetch() drives the useful readahead
+        madvise(_map, (size_t)_capacityPages * _pageSize, MADV_RANDOM);
+      }
+    }
+    else
+    {
+      _remap(std::max(_pageCount, GROWTH_PAGES));
+    }
+  }
+
+  MmapPageStore::~MmapPageStore()
+  {
+    _bDestructing = true;
+    if (_map != NULL)
+    {
+      munmap(_map, (size_t)_capacityPages * _pageSize);
+    }
+    if (!_readOnly)
+    {
+      // shrink the file back from the growth chunk to the pages actually created
+      if (ftruncate(_fd, (off_t)_pageCount * (off_t)_pageSize) != 0)
+      {
+        // destructors can't throw; the extra zero pages are benign
+      }
+    }
+    close(_fd);
+  }
+
+  boost::shared_ptr<Page> MmapPageStore::createPage()
+  {
+    if (_readOnly == true)
+    {
+      throw Tgs::Exception("Error creating page -- index is read only.");
+    }
+    if (_pageCount >= _capacityPages)
+    {
+      _remap(_capacityPages + GROWTH_PAGES);
+    }
+    char * pData = Page::allocateAligned(_pageSize);
+    _writePage(_pageCount, pData);
+    boost::shared_ptr<Page> newPage(_createPage(this, _pageCount, pData,
+      _pageSize));
+
+    _pagesMap[_pageCount] = newPage;
+    _pageCount++;
+
+    return newPage;
+  }
+
+  boost::shared_ptr<Page> MmapPageStore::getPage(int id)
+  {
+    // If the page does not reside in memory then copy it out of the mapping
+
+    if (_pagesMap.find(id) != _pagesMap.end())
+    {
+      if(_pagesMap[id].expired() != true)
+      {
+        return _pagesMap[id].lock();
+      }
+    }
+
+    if (id < 0 || id >= _pageCount)
+    {
+      throw Tgs::Exception("Error reading page -- invalid page id.");
+    }
+
+    char * pData = Page::allocateAligned(_pageSize);
+    memcpy(pData, _map + (size_t)id * _pageSize, _pageSize);
+    boost::shared_ptr<Page> newPage(_createPage(this, id, pData, _pageSize));
+    _pagesMap[id] = newPage;
+    return newPage;
+  }
+
+  int MmapPageStore::getPageCount() const
+  {
+    return _pageCount;
+  }
+
+  int MmapPageStore::getPageSize() const
+  {
+    return _pageSize;
+  }
+
+  void MmapPageStore::prefetch(const std::vector<int>& ids)
+  {
+    if (_map == NULL)
+    {
+      return;
+    }
+    const size_t systemPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      const int id = ids[i];
+      if (id < 0 || id >= _pageCount)
+      {
+        continue;
+      }
+      // madvise wants a system page aligned address, so round the start down
+      const size_t offset = (size_t)id * _pageSize;
+      const size_t alignedOffset = offset & ~(systemPageSize - 1);
+      madvise(_map + alignedOffset, _pageSize + (offset - alignedOffset), MADV_WILLNEED);
+    }
+  }
+
+  void MmapPageStore::flush()
+  {
+    _pagesMap.clear();
+    if (!_readOnly && _map != NULL)
+    {
+      msync(_map, (size_t)_pageCount * _pageSize, MS_ASYNC);
+    }
+  }
+
+  void MmapPageStore::save()
+  {
+    if (!_readOnly)
+    {
+      PageMap::const_iterator it;
+      for (it = _pagesMap.begin(); it != _pagesMap.end(); ++it)
+      {
+        if(!(*it).second.expired())
+        {
+          if ((*it).second.lock()->isDirty())
+          {
+            _writePage((*it).second.lock()->getId(), (*it).second.lock()->getDataRaw());
+            _setPageClean((*it).second.lock().get());
+          }
+        }
+      }
+      if (_map != NULL)
+      {
+        msync(_map, (size_t)_pageCount * _pageSize, MS_ASYNC);
+      }
+    }
+  }
+
+  void MmapPageStore::_remap(int minPages)
+  {
+    if (minPages <= _capacityPages)
+    {
+      return;
+    }
+    if (_map != NULL)
+    {
+      munmap(_map, (size_t)_capacityPages * _pageSize);
+      _map = NULL;
+    }
+    if (ftruncate(_fd, (off_t)minPages * (off_t)_pageSize) != 0)
+    {
+      throw Tgs::Exception(_getError("Error growing file."));
+    }
+    _map = (char*)mmap(NULL, (size_t)minPages * _pageSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+      _fd, 0);
+    if (_map == MAP_FAILED)
+    {
+      _map = NULL;
+      throw Tgs::Exception(_getError("Error mapping file."));
+    }
+    _capacityPages = minPages;
+  }
+
+  void MmapPageStore::_savePage(int id, char * pData)
+  {
+    // Just write out to the mapping
+    if(!_bDestructing)
+    {
+      _writePage(id, pData);
+      _pagesMap.erase(_pagesMap.find(id));
+    }
+  }
+
+  void MmapPageStore::_writePage(const int id, char * data)
+  {
+    if (_readOnly == true)
+    {
+      throw Tgs::Exception("Error writing page -- index is read only.");
+    }
+    if (id < 0 || id >= _capacityPages)
+    {
+      throw Tgs::Exception("Error writing page -- invalid page id.");
+    }
+
+    memcpy(_map + (size_t)id * _pageSize, data, _pageSize);
+  }
+
+  std::string MmapPageStore::_getError(const std::string& error)
+  {
+    std::string errStr = error;
+    errStr += _fileName;
+    errStr += " - ";
+    errStr += strerror(errno);
+
+    return errStr;
+  }
+}
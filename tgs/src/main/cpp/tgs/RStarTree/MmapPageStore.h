@@ -0,0 +1,95 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+
+#ifndef __TGS__MMAP_PAGE_STORE_H__
+#define __TGS__MMAP_PAGE_STORE_H__
+
+// Standard Includes
+#include <string>
+#include <vector>
+
+#include "../HashMap.h"
+#include "PageStore.h"
+
+namespace Tgs
+{
+
+  /**
+   * A PageStore backed by a memory mapped file (POSIX only). Page reads are serviced straight
+   * out of the mapping rather than with a seek and read system call per page, and prefetch()
+   * turns into madvise hints so the kernel reads upcoming pages in the background while the
+   * tree is being traversed. Useful for indexes too big for MemoryPageStore.
+   */
+  class TGS_EXPORT MmapPageStore : public PageStore
+  {
+  public:
+    MmapPageStore(int pageSize, const char* fileName, bool readOnly = false);
+
+    virtual ~MmapPageStore();
+
+    virtual boost::shared_ptr<Page> createPage();
+
+    virtual void flush();
+
+    virtual boost::shared_ptr<Page> getPage(int id);
+
+    virtual int getPageCount() const;
+
+    virtual int getPageSize() const;
+
+    virtual void prefetch(const std::vector<int>& ids);
+
+    virtual void save();
+
+  private:
+
+    void _remap(int minPages);
+    void _writePage(const int, char *);
+
+    int _pageSize;
+
+    typedef HashMap<int, boost::weak_ptr<Page> > PageMap;
+    PageMap _pagesMap;
+    bool _readOnly;
+    int _pageCount;
+    // pages covered by the current mapping; may be larger than _pageCount while the file grows
+    int _capacityPages;
+
+    virtual void _savePage(int, char *);
+    std::string _getError(const std::string& error);
+
+    bool _bDestructing;
+
+    int _fd;
+    char* _map;
+
+    std::string _fileName;
+  };
+}
+
+#endif
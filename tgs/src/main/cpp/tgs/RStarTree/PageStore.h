@@ -28,6 +28,9 @@
 #ifndef __TGS__PAGE_STORE_H__
 #define __TGS__PAGE_STORE_H__
 
+// Standard Includes
+#include <vector>
+
 #include "Page.h"
 #include "../SharedPtr.h"
 
@@ -75,6 +78,13 @@ namespace Tgs
      */
     virtual int getPageSize() const = 0;
 
+    /**
+     * Hints that the given pages are about to be requested so the store can start reading them
+     * in the background. This is purely an optimization hint; the default implementation does
+     * nothing.
+     */
+    virtual void prefetch(const std::vector<int>& /*ids*/) {}
+
     /**
      * Saves all dirty pages, but doesn't necessarily free the associated memory.
      */
@@ -28,6 +28,7 @@
 #include "RStarTree.h"
 
 // Standard Includes
+#include <deque>
 #include <exception>
 #include <float.h>
 #include <iostream>
@@ -435,6 +436,133 @@ void RStarTree::_reinsert(RTreeNode* node, int level)
   // cout << "  " << *node << endl;
 }
 
+static bool _boxesIntersect(const BoxInternalData& a, const Box& b)
+{
+  for (int i = 0; i < b.getDimensions(); i++)
+  {
+    if (a.getLowerBound(i) > b.getUpperBound(i) || b.getLowerBound(i) > a.getUpperBound(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RStarTree::remove(const Box& b, int userId)
+{
+  if (userId < 0 || b.isValid() == false)
+  {
+    throw Exception("Internal Error: Box or id are not valid.");
+  }
+
+  // D1 find the leaf that contains the entry.
+  int leafId = _findLeaf(b, userId);
+  if (leafId < 0)
+  {
+    return false;
+  }
+
+  // D2 remove the entry from the leaf.
+  RTreeNode* leaf = _getNode(leafId);
+  int childIndex = -1;
+  for (int i = 0; i < leaf->getChildCount(); i++)
+  {
+    if (leaf->getChildUserId(i) == userId)
+    {
+      childIndex = i;
+      break;
+    }
+  }
+  assert(childIndex >= 0);
+  leaf->removeChild(childIndex);
+
+  // D3 remove under full nodes on the way up and reinsert their orphaned entries.
+  _condenseTree(leaf);
+
+  // D4 if the root isn't a leaf and has a single child, make the child the new root.
+  RTreeNode* root = _getRoot();
+  while (root->isLeafNode() == false && root->getChildCount() == 1)
+  {
+    RTreeNode* child = _getNode(root->getChildNodeId(0));
+    child->setParentId(-1);
+    _setRootId(child->getId());
+    _setHeight(_getHeight() - 1);
+    root = child;
+  }
+
+  return true;
+}
+
+void RStarTree::_condenseTree(RTreeNode* node)
+{
+  // the entries of removed nodes along with the level they should be reinserted at. The level
+  // convention matches _reinsert; the entries of a node at level l are reinserted at level l.
+  std::vector<Child> orphans;
+  std::vector<int> orphanLevels;
+
+  int level = 0;
+  while (node->getParentId() >= 0)
+  {
+    RTreeNode* parent = _getNode(node->getParentId());
+    if (node->getChildCount() < _m)
+    {
+      for (int i = 0; i < node->getChildCount(); i++)
+      {
+        orphans.push_back(Child(node->getChildId(i), node->getChildEnvelope(i)));
+        orphanLevels.push_back(level);
+      }
+      parent->removeChild(parent->convertChildIdToIndex(node->getId()));
+    }
+    else
+    {
+      // the node is full enough; just tighten the covering rectangles up the path and stop.
+      // Nodes farther up can't have underflowed since their child counts didn't change.
+      _updateBounds(node);
+      break;
+    }
+    node = parent;
+    level++;
+  }
+
+  for (unsigned int i = 0; i < orphans.size(); i++)
+  {
+    _overflowedLevels.clear();
+    _insert(orphans[i].b, orphans[i].id, orphanLevels[i]);
+  }
+}
+
+int RStarTree::_findLeaf(const Box& b, int userId)
+{
+  std::deque<int> pendingNodes;
+  pendingNodes.push_back(_getRootId());
+  while (pendingNodes.size() > 0)
+  {
+    const RTreeNode* node = _store.getNode(pendingNodes.front());
+    pendingNodes.pop_front();
+    if (node->isLeafNode())
+    {
+      for (int i = 0; i < node->getChildCount(); i++)
+      {
+        if (node->getChildUserId(i) == userId)
+        {
+          return node->getId();
+        }
+      }
+    }
+    else
+    {
+      for (int i = 0; i < node->getChildCount(); i++)
+      {
+        if (_boxesIntersect(node->getChildEnvelope(i), b))
+        {
+          pendingNodes.push_back(node->getChildNodeId(i));
+        }
+      }
+    }
+  }
+  return -1;
+}
+
 void RStarTree::_setHeight(int height)
 {
   _height = height;
@@ -88,7 +88,21 @@ namespace Tgs
     const RTreeNode* getNode(int nodeId) const;
 
     /**
-     * Returns the root of the tree. This can then be used for any number of traversals. It is 
+     * Hints to the underlying page store that the given nodes will be visited soon so it can
+     * start reading them in the background. A no-op for stores that don't support prefetching.
+     */
+    void prefetchNodes(const std::vector<int>& nodeIds) const;
+
+    /**
+     * While concurrent read mode is on, getNode/getRoot and the iterators built on them may be
+     * called from multiple threads. The node cache stops evicting so the pointers handed out
+     * stay valid, which means all touched nodes stay resident until the mode is turned off. The
+     * tree must not be modified while readers are active.
+     */
+    void setConcurrentReadMode(bool on);
+
+    /**
+     * Returns the root of the tree. This can then be used for any number of traversals. It is
      * best not to cache this value between inserts as the root can change from time to time.
      */
     const RTreeNode* getRoot() const;
@@ -100,6 +114,15 @@ namespace Tgs
      */
     void insert(const Box& b, int userId);
 
+    /**
+     * Remove the item with the specified user ID. The box only needs to intersect the box the
+     * item was inserted with; it is used to prune the search for the item's leaf. Under full
+     * nodes on the way back up are condensed by reinserting their entries so the tree stays
+     * balanced. Returns false if no matching item was found. The pages of removed nodes are not
+     * reclaimed.
+     */
+    bool remove(const Box& b, int userId);
+
     void cleanTree();
 
     /**
@@ -180,6 +203,17 @@ namespace Tgs
      */
     RTreeNode* _chooseSubTree(const Box& b, int level);
 
+    /**
+     * Removes under full nodes on the path from node to the root and reinserts their entries.
+     */
+    void _condenseTree(RTreeNode* node);
+
+    /**
+     * Returns the ID of a leaf that contains an entry with the given user ID and whose covering
+     * boxes intersect b, or -1 if there is no such leaf.
+     */
+    int _findLeaf(const Box& b, int userId);
+
     /**
      * Find the child with the least enlargement. This is consistent w/ [GUT 84]'s implementation
      */
@@ -256,6 +290,16 @@ namespace Tgs
     return _store.getNode(nodeId);
   }
 
+  inline void RStarTree::prefetchNodes(const std::vector<int>& nodeIds) const
+  {
+    _store.prefetch(nodeIds);
+  }
+
+  inline void RStarTree::setConcurrentReadMode(bool on)
+  {
+    _store.setConcurrentReadMode(on);
+  }
+
   inline const RTreeNode* RStarTree::getRoot() const
   {
     return _store.getNode(_rootId);
@@ -30,6 +30,9 @@
 // Standard Includes
 #include <iostream>
 
+// Qt Includes
+#include <QMutexLocker>
+
 namespace Tgs
 {
   const int MAX_NODE_COUNT = 100000;
@@ -39,6 +42,7 @@ namespace Tgs
     _dimensions = dimensions;
     _storeSp = ps;
     _store = ps.get();
+    _concurrentReadMode = false;
   }
 
   RTreeNodeStore::~RTreeNodeStore()
@@ -60,6 +64,7 @@ namespace Tgs
 
   RTreeNode* RTreeNodeStore::createNode()
   {
+    QMutexLocker locker(&_mutex);
     boost::shared_ptr<Page> page = _store->createPage();
     page->setDirty();
     RTreeNode* node = new RTreeNode(_dimensions, page);
@@ -76,6 +81,7 @@ namespace Tgs
 
   const RTreeNode* RTreeNodeStore::getNode(int id) const
   {
+    QMutexLocker locker(&_mutex);
     RTreeNode * node;
 
     // if exists
@@ -101,8 +107,9 @@ namespace Tgs
     return node;
   }
 
-  RTreeNode * RTreeNodeStore::getNode( int id ) 
+  RTreeNode * RTreeNodeStore::getNode( int id )
   {
+    QMutexLocker locker(&_mutex);
     RTreeNode * node;
 
     // if exists
@@ -127,8 +134,29 @@ namespace Tgs
     return node;
   }
 
+  void RTreeNodeStore::prefetch(const std::vector<int>& ids) const
+  {
+    _store->prefetch(ids);
+  }
+
+  void RTreeNodeStore::setConcurrentReadMode(bool on)
+  {
+    QMutexLocker locker(&_mutex);
+    _concurrentReadMode = on;
+    if (!on)
+    {
+      // trim anything that accumulated past the limit while eviction was off.
+      _flushNodes();
+    }
+  }
+
   void RTreeNodeStore::_flushNodes()
   {
+    // while readers may be holding node pointers nothing can be evicted.
+    if (_concurrentReadMode)
+    {
+      return;
+    }
     while((int)_nodesList.size() > MAX_NODE_COUNT)
     {
       int keyVal = _nodesList.back();
@@ -31,6 +31,9 @@
 // Standard Includes
 #include <list>
 
+// Qt Includes
+#include <QMutex>
+
 #include "../HashMap.h"
 #include "RTreeNode.h"
 #include "PageStore.h"
@@ -38,7 +41,7 @@
 namespace Tgs
 {
   /**
-   * The NodeStore provides a way of persistently storing and efficiently accessing nodes in a 
+   * The NodeStore provides a way of persistently storing and efficiently accessing nodes in a
    * tree.
    *
    * @todo At some point an intelligent caching mechanism should be added.
@@ -59,14 +62,27 @@ namespace Tgs
 
     /**
      * The returned node is only guaranteed to be valid until another RTreeNodeStore method is
-     * called.
-     * 
+     * called, unless concurrent read mode is on.
+     *
      * This method is thread safe. It is the only thread safe method in RTreeNodeStore.
      */
     const RTreeNode* getNode(int id) const;
 
     RTreeNode* getNode(int id);
 
+    /**
+     * Hints to the underlying page store that the given nodes will be requested soon. A no-op
+     * for stores that don't support prefetching.
+     */
+    void prefetch(const std::vector<int>& ids) const;
+
+    /**
+     * While concurrent read mode is on the cache stops evicting, so node pointers handed out to
+     * concurrent readers stay valid. All touched nodes stay resident until the mode is turned
+     * off again. The store must not be modified while readers are active.
+     */
+    void setConcurrentReadMode(bool on);
+
   protected:
 
     void _flushNodes();
@@ -95,6 +111,10 @@ namespace Tgs
    //  void _addNode(RTreeNode* node) const;
     void _addNode(RecItem * item, int key);
     mutable std::list<int>_nodesList;
+
+    /// guards the mutable cache above so const reads are safe from multiple threads.
+    mutable QMutex _mutex;
+    bool _concurrentReadMode;
   };
 }
 
@@ -52,6 +52,7 @@ namespace Tgs
     try
     {
       _forest.clear();
+      _flatForest.clear();
     }
     catch(const Exception & e)
     {
@@ -64,6 +65,14 @@ namespace Tgs
   {
     try
     {
+      //the flattened form is built at the end of training or import; fall back to walking the
+      //pointer linked trees if it is not available
+      if(_flatForest.isBuilt())
+      {
+        _flatForest.classifyVector(dataVector, scores);
+        return;
+      }
+
       double itrVal = 1.0/(double)_forest.size();
 
       for(unsigned int i = 0; i < _forest.size(); i++)
@@ -79,6 +88,68 @@ namespace Tgs
     }
   }
 
+  void BaseRandomForest::classifyVectors(const std::vector<std::vector<double> > & dataVectors,
+    std::vector<std::map<std::string, double> > & scores) const
+  {
+    try
+    {
+      if(_flatForest.isBuilt())
+      {
+        _flatForest.classifyVectors(dataVectors, scores);
+        return;
+      }
+
+      scores.clear();
+      scores.resize(dataVectors.size());
+
+      double itrVal = 1.0/(double)_forest.size();
+
+      for(unsigned int i = 0; i < _forest.size(); i++)
+      {
+        for(unsigned int j = 0; j < dataVectors.size(); j++)
+        {
+          std::string result;
+          _forest[i]->classifyDataVector(dataVectors[j], result);
+          scores[j][result] += itrVal;
+        }
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void BaseRandomForest::exportBinaryModel(const std::string & filename) const
+  {
+    try
+    {
+      if(!_flatForest.isBuilt())
+      {
+        throw Exception(__LINE__, "The forest must be trained or imported before exporting");
+      }
+      _flatForest.exportBinary(filename);
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void BaseRandomForest::importBinaryModel(const std::string & filename)
+  {
+    try
+    {
+      clear();
+      _flatForest.importBinary(filename);
+      _forestCreated = true;
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
   void BaseRandomForest::exportModel(std::ostream& filestream)
   {
     if (filestream.good())
@@ -328,6 +399,8 @@ namespace Tgs
           }
         }
       }
+
+      _buildFlattenedForest();
     }
     catch(const Exception & e)
     {
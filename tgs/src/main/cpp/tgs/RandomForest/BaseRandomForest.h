@@ -34,6 +34,7 @@
 #include <QFile>
 
 #include "DataFrame.h"
+#include "FlattenedForest.h"
 #include "RandomTree.h"
 
 namespace Tgs
@@ -98,6 +99,27 @@ namespace Tgs
     void classifyVector(std::vector<double> & dataVector, std::map<std::string, double> & scores)
       const;
 
+    /**
+    * Classifies a batch of data vectors against the forest in one pass.  Evaluation runs
+    * against the flattened form of the forest (see FlattenedForest) with the trees in the
+    * outer loop, so the node arrays stay hot in cache while the vectors stream through them.
+    *
+    * @param dataVectors the data vectors to classify, each of size N where N is the number of
+    * factors
+    * @param scores one score map per input vector, as in classifyVector
+    */
+    void classifyVectors(const std::vector<std::vector<double> > & dataVectors,
+      std::vector<std::map<std::string, double> > & scores) const;
+
+    /**
+    * Writes the flattened evaluation form of the forest to a binary model file that
+    * importBinaryModel can map back in microseconds (see FlattenedForest).  Together with
+    * importModel this converts an existing XML model to the binary format.
+    *
+    * @param filename the path of the file to write
+    */
+    void exportBinaryModel(const std::string & filename) const;
+
     /**
     *  Exports the random forest to a file
     *
@@ -169,6 +191,16 @@ namespace Tgs
      */
     void importModel(QFile& file);
 
+    /**
+    * Maps a binary model file written by exportBinaryModel.  Only the flattened evaluation
+    * form is loaded - classification works but operations that need the training trees (export,
+    * error rates, factor importance) do not, so this is intended for worker processes that only
+    * classify.
+    *
+    * @param filename the path of the file to read
+    */
+    void importBinaryModel(const std::string & filename);
+
     /**
     *  @return true if the forest has been trained
     */
@@ -240,6 +272,15 @@ namespace Tgs
 
     bool _forestCreated;  /// A flag to indicate if the forest was created successfully
 
+    /**
+    * Rebuilds the flattened evaluation form of the forest.  Called once at the end of training
+    * or import; classification then walks the flattened arrays instead of the pointer linked
+    * TreeNodes.
+    */
+    void _buildFlattenedForest() { _flatForest.build(_forest); }
+
+    FlattenedForest _flatForest;  /// The packed evaluation form of the forest
+
   };
 }
 
@@ -90,6 +90,7 @@ namespace Tgs
     try
     {
       _data.push_back(dataItem);         //Append a new training vector
+      _invalidateColumnCache();
       _weights.push_back(eventWeight);        //Append the event weight
       _trainingLabels.push_back(label);  //Store its training class label
       _classSet.insert(label);           //Keep a set of unique class names
@@ -133,6 +134,7 @@ namespace Tgs
       _trainingLabelEnum.clear();
       _nullTreatment.clear();
       _medianMaps.clear();
+      _invalidateColumnCache();
       _trainingEnumCnt = 1;
 
     }
@@ -764,8 +766,14 @@ namespace Tgs
     }
   }
 
-  void DataFrame::makeBalancedBoostrapAndOobSets(std::vector<unsigned int> & bootstrap, 
+  void DataFrame::makeBalancedBoostrapAndOobSets(std::vector<unsigned int> & bootstrap,
     std::vector<unsigned int> & oob)
+  {
+    makeBalancedBoostrapAndOobSets(*Tgs::Random::instance(), bootstrap, oob);
+  }
+
+  void DataFrame::makeBalancedBoostrapAndOobSets(Random & random,
+    std::vector<unsigned int> & bootstrap, std::vector<unsigned int> & oob)
   {
     try
     {
@@ -813,7 +821,7 @@ namespace Tgs
         {
           for(itr = idxSortedByClass.begin(); itr != idxSortedByClass.end(); ++itr)
           {
-            r = ((double)Tgs::Random::instance()->generateInt() / ((double)(RAND_MAX)+(double)(1)));
+            r = ((double)random.generateInt() / ((double)(RAND_MAX)+(double)(1)));
 
             unsigned int rndIdx = (unsigned int)(r * (double)itr->second.size());
             bootstrap[pickCtr] = itr->second[rndIdx];
@@ -842,8 +850,16 @@ namespace Tgs
     }
   }
 
-  void DataFrame::makeBalancedRoundRobinBootstrapAndOobSets(std::string className1, 
+  void DataFrame::makeBalancedRoundRobinBootstrapAndOobSets(std::string className1,
     std::string className2, std::vector<unsigned int> & bootstrap, std::vector<unsigned int> & oob)
+  {
+    makeBalancedRoundRobinBootstrapAndOobSets(*Tgs::Random::instance(), className1, className2,
+      bootstrap, oob);
+  }
+
+  void DataFrame::makeBalancedRoundRobinBootstrapAndOobSets(Random & random,
+    std::string className1, std::string className2, std::vector<unsigned int> & bootstrap,
+    std::vector<unsigned int> & oob)
   {
     try
     {
@@ -887,7 +903,7 @@ namespace Tgs
         while(pickCtr < bootstrap.size())
         {
           //Pick a positive training example
-          double r = ((double)Tgs::Random::instance()->generateInt() / ((double)(RAND_MAX)+(double)(1)));
+          double r = ((double)random.generateInt() / ((double)(RAND_MAX)+(double)(1)));
           unsigned int rndIdx = (unsigned int)(r * (double)posIndices.size());
           bootstrap[pickCtr] = posIndices[rndIdx];
           selectedPos[rndIdx] = true;
@@ -895,7 +911,7 @@ namespace Tgs
           pickCtr++;
 
           //Pick a negative training example
-          r = ((double)Tgs::Random::instance()->generateInt() / ((double)(RAND_MAX)+(double)(1)));
+          r = ((double)random.generateInt() / ((double)(RAND_MAX)+(double)(1)));
           rndIdx = (unsigned int)(r * (double)negIndices.size());
           bootstrap[pickCtr] = negIndices[rndIdx];
           selectedNeg[rndIdx] = true;
@@ -932,7 +948,13 @@ namespace Tgs
   }
 
 
-  void DataFrame::makeBoostrapAndOobSets(std::vector<unsigned int> & bootstrap, 
+  void DataFrame::makeBoostrapAndOobSets(std::vector<unsigned int> & bootstrap,
+    std::vector<unsigned int> & oob)
+  {
+    makeBoostrapAndOobSets(*Tgs::Random::instance(), bootstrap, oob);
+  }
+
+  void DataFrame::makeBoostrapAndOobSets(Random & random, std::vector<unsigned int> & bootstrap,
     std::vector<unsigned int> & oob)
   {
     try
@@ -955,7 +977,7 @@ namespace Tgs
 
         for(unsigned int j = 0; j < bootstrap.size(); j++)
         {
-          double r = ((double)Tgs::Random::instance()->generateInt() / ((double)(RAND_MAX)+(double)(1)));
+          double r = ((double)random.generateInt() / ((double)(RAND_MAX)+(double)(1)));
 
           unsigned int rndIdx = (unsigned int)(r * (double)_data.size());
           bootstrap[j] = rndIdx;
@@ -983,6 +1005,68 @@ namespace Tgs
     }
   }
 
+  const std::vector<double> & DataFrame::getFactorColumn(unsigned int fIdx) const
+  {
+    try
+    {
+      if(_data.empty() || fIdx >= _data[0].size())
+      {
+        std::stringstream ss;
+        ss << "Index " << fIdx << " is outside of data vector bounds";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      if(_factorColumns.size() != _data[0].size())
+      {
+        _factorColumns.resize(_data[0].size());
+      }
+
+      std::vector<double> & column = _factorColumns[fIdx];
+      if(column.size() != _data.size())
+      {
+        column.resize(_data.size());
+        for(unsigned int i = 0; i < (unsigned int)_data.size(); i++)
+        {
+          column[i] = _data[i][fIdx];
+        }
+      }
+      return column;
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  const std::vector<unsigned int> & DataFrame::getSortedIndicesByFactor(unsigned int fIdx) const
+  {
+    try
+    {
+      const std::vector<double> & column = getFactorColumn(fIdx);
+
+      if(_sortedFactorIndices.size() != _data[0].size())
+      {
+        _sortedFactorIndices.resize(_data[0].size());
+      }
+
+      std::vector<unsigned int> & sorted = _sortedFactorIndices[fIdx];
+      if(sorted.size() != _data.size())
+      {
+        sorted.resize(_data.size());
+        for(unsigned int i = 0; i < (unsigned int)sorted.size(); i++)
+        {
+          sorted[i] = i;
+        }
+        _qSortIndicesOnFactorValue(sorted, 0, sorted.size() - 1, column);
+      }
+      return sorted;
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
   DataFrame& DataFrame::operator=(const DataFrame& from)
   {
     try
@@ -998,6 +1082,7 @@ namespace Tgs
       _nullTreatment = from._nullTreatment;
       _trainingEnumCnt = from._trainingEnumCnt;
       _randSeedCtr = from._randSeedCtr;
+      _invalidateColumnCache();
     }
     catch(const Exception & e)
     {
@@ -1010,6 +1095,8 @@ namespace Tgs
   {
     try
     {
+      //the caller gets a mutable reference to the row, so any cached columns may go stale
+      _invalidateColumnCache();
       return _data[vIdx];
     }
     catch(const std::out_of_range& oor)
@@ -1026,6 +1113,21 @@ namespace Tgs
 
 
 
+  void DataFrame::prepareForConcurrentTraining() const
+  {
+    try
+    {
+      for(unsigned int i = 0; i < _activeFactorIndices.size(); i++)
+      {
+        getSortedIndicesByFactor(_activeFactorIndices[i]);
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
   void DataFrame::remapClassLabels(std::map<std::string, std::string> & labelMap)
   {
     try
@@ -1073,6 +1175,12 @@ namespace Tgs
 
   void DataFrame::selectRandomFactors(unsigned int numFactors,
     std::vector<unsigned int> & fIndices)
+  {
+    selectRandomFactors(*Tgs::Random::instance(), numFactors, fIndices);
+  }
+
+  void DataFrame::selectRandomFactors(Random & random, unsigned int numFactors,
+    std::vector<unsigned int> & fIndices)
   {
     try
     {
@@ -1090,7 +1198,7 @@ namespace Tgs
 
         for(unsigned int k = 0; k < numFactors; k++)
         {
-          double rr = (double)Tgs::Random::instance()->generateInt();
+          double rr = (double)random.generateInt();
           double r = (rr / ((double)(RAND_MAX)+(double)(1)));
 
           unsigned int rndIdx = (unsigned int)(r * (double)candidateFactors.size());
@@ -1245,7 +1353,8 @@ namespace Tgs
       //Set the index to use as the sort source
       if(!_data.empty() && fIdx < _data[0].size())
       {
-        _qSortIndicesOnFactorValue(indices, 0, indices.size() - 1, fIdx);
+        //sort against the contiguous column rather than striding across the rows
+        _qSortIndicesOnFactorValue(indices, 0, indices.size() - 1, getFactorColumn(fIdx));
       }
       else
       {
@@ -1367,6 +1476,7 @@ namespace Tgs
             }
 
             _data.push_back(dataVector);
+            _invalidateColumnCache();
           }
         }
       }
@@ -1378,15 +1488,15 @@ namespace Tgs
   }
 
   void DataFrame::_qSortIndicesOnFactorValue(std::vector<unsigned int> & indices, unsigned int posP,
-    unsigned int posR, unsigned int fIdx) const
+    unsigned int posR, const std::vector<double> & column) const
   {
     try
     {
       if(posP < posR)
       {
-        unsigned int q = _qSortPartition(indices, posP, posR, fIdx);
-        _qSortIndicesOnFactorValue(indices, posP, q, fIdx);
-        _qSortIndicesOnFactorValue(indices, q + 1, posR, fIdx);
+        unsigned int q = _qSortPartition(indices, posP, posR, column);
+        _qSortIndicesOnFactorValue(indices, posP, q, column);
+        _qSortIndicesOnFactorValue(indices, q + 1, posR, column);
       }
     }
     catch(const Exception & e)
@@ -1396,12 +1506,12 @@ namespace Tgs
   }
 
   unsigned int DataFrame::_qSortPartition(std::vector<unsigned int> & indices, unsigned int posP,
-    unsigned int posR, unsigned int fIdx) const
+    unsigned int posR, const std::vector<double> & column) const
   {
     try
     {
       const unsigned int loopLimit = 100000;
-      double x = _data[indices[posP]][fIdx];
+      double x = column[indices[posP]];
       unsigned int i = posP - 1;
       unsigned int j = posR + 1;
 
@@ -1411,12 +1521,12 @@ namespace Tgs
         do
         {
           j = j - 1;
-        } while(_data[indices[j]][fIdx] > x);
+        } while(column[indices[j]] > x);
 
         do
         {
           i = i + 1;
-        } while(_data[indices[i]][fIdx] < x);
+        } while(column[indices[i]] < x);
 
         if(i < j)
         {
@@ -44,6 +44,7 @@
 
 namespace Tgs
 {
+  class Random;
 
   /**
   * The DataFrame is a vector of data vectors.  Each data vector contains 
@@ -199,6 +200,28 @@ namespace Tgs
     */
     const std::vector<double> & getDataVector(unsigned int vIdx) const;
 
+    /**
+    * Gets a column major copy of a single factor's values across all data vectors.  The column
+    * is built lazily and cached so that repeated scans of one factor (such as the per node
+    * sorts performed during random forest training) read contiguous memory instead of striding
+    * across the row major data storage.  Any mutation of the data vectors drops the cache.
+    *
+    * @param fIdx the factor index
+    * @return a reference to the cached column of factor values
+    */
+    const std::vector<double> & getFactorColumn(unsigned int fIdx) const;
+
+    /**
+    * Gets the indices of all data vectors sorted ascending on the requested factor's value.
+    * The permutation is computed once per factor and cached so each tree node trained against
+    * this frame can derive its sorted subset from it rather than re-sorting from scratch.  Any
+    * mutation of the data vectors drops the cache.
+    *
+    * @param fIdx the factor index
+    * @return a reference to the cached sorted permutation
+    */
+    const std::vector<unsigned int> & getSortedIndicesByFactor(unsigned int fIdx) const;
+
     /**
     * Returns the weight for the row
     * @param vIdx the vector index
@@ -319,7 +342,14 @@ namespace Tgs
     * @param bootstrap the output container to hold indices to data vectors for the bootstrap set
     * @param oob  the output container to hold indices to data vectors for the out of bag set
     */
-    void makeBalancedBoostrapAndOobSets(std::vector<unsigned int> & bootstrap, 
+    void makeBalancedBoostrapAndOobSets(std::vector<unsigned int> & bootstrap,
+      std::vector<unsigned int> & oob);
+
+    /**
+    * As above, but draws from the caller's random stream instead of the shared global stream so
+    * concurrent callers neither contend on nor perturb each other's draws.
+    */
+    void makeBalancedBoostrapAndOobSets(Random & random, std::vector<unsigned int> & bootstrap,
       std::vector<unsigned int> & oob);
 
     /**
@@ -334,16 +364,29 @@ namespace Tgs
     * @param bootstrap the output container to hold indices to data vectors for the bootstrap set
     * @param oob  the output container to hold indices to data vectors for the out of bag set
     */
-    void makeBalancedRoundRobinBootstrapAndOobSets(std::string className1, std::string className2, 
+    void makeBalancedRoundRobinBootstrapAndOobSets(std::string className1, std::string className2,
       std::vector<unsigned int> & bootstrap, std::vector<unsigned int> & oob);
 
+    /**
+    * As above, but draws from the caller's random stream.
+    */
+    void makeBalancedRoundRobinBootstrapAndOobSets(Random & random, std::string className1,
+      std::string className2, std::vector<unsigned int> & bootstrap,
+      std::vector<unsigned int> & oob);
+
     /**
     *  Creates bootstrap and out of bag sets with replacement
     *
     * @param bootstrap the output container to hold indices to data vectors for the bootstrap set
     * @param oob  the output container to hold indices to data vectors for the out of bag set
     */
-    void makeBoostrapAndOobSets(std::vector<unsigned int> & bootstrap, 
+    void makeBoostrapAndOobSets(std::vector<unsigned int> & bootstrap,
+      std::vector<unsigned int> & oob);
+
+    /**
+    * As above, but draws from the caller's random stream.
+    */
+    void makeBoostrapAndOobSets(Random & random, std::vector<unsigned int> & bootstrap,
       std::vector<unsigned int> & oob);
 
     /**
@@ -366,6 +409,14 @@ namespace Tgs
      */
     std::vector<double> & operator[](unsigned int vIdx);
 
+    /**
+    * Builds the cached factor columns and sorted permutations (see getFactorColumn and
+    * getSortedIndicesByFactor) for every active factor up front.  The lazy builds mutate the
+    * cache, so a frame shared read-only across training threads must be prepared on the main
+    * thread before the pool starts.
+    */
+    void prepareForConcurrentTraining() const;
+
     /**
     *  Remaps all the classes to different labels.  The original class
     * labels can be restored using restoreClassLabels;
@@ -399,6 +450,12 @@ namespace Tgs
     */
     void selectRandomFactors(unsigned int numFactors, std::vector<unsigned int> & fIndices);
 
+    /**
+    * As above, but draws from the caller's random stream.
+    */
+    void selectRandomFactors(Random & random, unsigned int numFactors,
+      std::vector<unsigned int> & fIndices);
+
     /**
     * Adds all factors to the active factor list.
     */
@@ -417,7 +474,11 @@ namespace Tgs
     /**
      * Sets the value of a single data element.
      */
-    void setDataElement(int vIdx, int fIdx, double v) { _data[vIdx][fIdx] = v; }
+    void setDataElement(int vIdx, int fIdx, double v)
+    {
+      _data[vIdx][fIdx] = v;
+      _invalidateColumnCache();
+    }
     
     /**
     *  Copies the factor names into an internal vector (not strictly needed inside the data set)
@@ -464,15 +525,25 @@ namespace Tgs
     */
     void _importDataVector(QDomElement & e);
 
+    /**
+    * Drops the cached factor columns and sorted permutations.  Called by anything that mutates
+    * (or exposes for mutation) the data vectors.
+    */
+    void _invalidateColumnCache() const
+    {
+      _factorColumns.clear();
+      _sortedFactorIndices.clear();
+    }
+
     /**
     * Sorts a vector of indices to data vectors by the selected factor
     * value.  
     *
     * @param indices the input/output containing the data vector indices
-    * @param fIdx the factor index on the data vector
+    * @param column the column of factor values to sort against (see getFactorColumn)
     */
     void _qSortIndicesOnFactorValue(std::vector<unsigned int> & indices, unsigned int posP, 
-      unsigned int posR, unsigned int fIdx) const;
+      unsigned int posR, const std::vector<double> & column) const;
 
     /**
     * This is the quicksort partition procedure as shown in:
@@ -481,12 +552,12 @@ namespace Tgs
     * @param indices the vector of indices to data vectors
     * @param posP the beginning partition position
     * @param posR the ending partition position
-    * @param fIdx the index of the factor to use as the basis for sorting the indices
+    * @param column the column of factor values to sort against (see getFactorColumn)
     * @return the new split position 
     * 
     */
     unsigned int _qSortPartition(std::vector<unsigned int> & indices, unsigned int posP, 
-      unsigned int posR, unsigned int fIdx) const;
+      unsigned int posR, const std::vector<double> & column) const;
 
     std::vector< std::string > _trainingLabels;  ///The class labels corresponding to the training data vectors
     std::vector< std::string > _trainingLabelsBak;  ///The class labels backup corresponding to the training data vectors
@@ -494,6 +565,10 @@ namespace Tgs
     std::vector< std::string > _factorLabels;  ///The factor labels corresponding to the data vectors
     std::vector< unsigned int > _activeFactorIndices;  ///The indices corresponding to the currently active factors
     std::vector< std::vector< double > > _data; ///The set of data vectors
+    ///Lazily built column major mirror of _data; an empty column has not been built yet
+    mutable std::vector< std::vector< double > > _factorColumns;
+    ///Lazily built per factor permutations of all row indices sorted on the factor value
+    mutable std::vector< std::vector< unsigned int > > _sortedFactorIndices;
     std::vector< int > _factorType; ///< Numeric or Nominal
     std::map<std::string, int> _trainingLabelEnum;
     std::vector<std::map<std::string, double> > _medianMaps;  //For each factor a map of each class to its median value
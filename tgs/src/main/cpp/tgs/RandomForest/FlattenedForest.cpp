@@ -0,0 +1,484 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "FlattenedForest.h"
+
+//STL Includes
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#ifndef _WIN32
+//Unix Includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../TgsException.h"
+
+namespace
+{
+  //The fixed size leading portion of the binary model format.  The node arrays follow the
+  //header (split values first so they stay 8 byte aligned), then the tree roots and finally
+  //the length prefixed class label strings.  Native byte order throughout.
+  struct FlatForestHeader
+  {
+    char magic[8];
+    unsigned int version;
+    unsigned int numTrees;
+    unsigned int numClasses;
+    unsigned int pad;
+    unsigned long long numNodes;
+  };
+
+  const char FLAT_FOREST_MAGIC[8] = { 'T', 'g', 's', 'F', 'l', 'a', 't', 'F' };
+  const unsigned int FLAT_FOREST_VERSION = 1;
+}
+
+namespace Tgs
+{
+  FlattenedForest::FlattenedForest()
+  {
+    _factorIndexP = 0;
+    _splitValueP = 0;
+    _leftChildP = 0;
+    _treeRootsP = 0;
+    _numTrees = 0;
+    _numNodes = 0;
+    _mappedData = 0;
+    _mappedLength = 0;
+    _ownsMappedData = false;
+  }
+
+  FlattenedForest::~FlattenedForest()
+  {
+    clear();
+  }
+
+  void FlattenedForest::build(const std::vector<boost::shared_ptr<RandomTree> > & forest)
+  {
+    try
+    {
+      clear();
+
+      for(unsigned int i = 0; i < forest.size(); i++)
+      {
+        boost::shared_ptr<TreeNode> root = forest[i]->getRootNode();
+        if(root.get() != 0)
+        {
+          _flattenTree(root);
+        }
+      }
+
+      _setPointersToVectors();
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void FlattenedForest::classifyVector(const std::vector<double> & dataVector,
+    std::map<std::string, double> & scores) const
+  {
+    try
+    {
+      double itrVal = 1.0 / (double)_numTrees;
+
+      for(unsigned int i = 0; i < _numTrees; i++)
+      {
+        scores[_classLabels[_classifyOne(dataVector, _treeRootsP[i])]] += itrVal;
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void FlattenedForest::classifyVectors(const std::vector<std::vector<double> > & dataVectors,
+    std::vector<std::map<std::string, double> > & scores) const
+  {
+    try
+    {
+      double itrVal = 1.0 / (double)_numTrees;
+
+      scores.clear();
+      scores.resize(dataVectors.size());
+
+      std::vector<std::vector<unsigned int> > votes(dataVectors.size(),
+        std::vector<unsigned int>(_classLabels.size(), 0));
+
+      //Walk the trees in the outer loop so each tree's node array stays hot in cache while
+      //every vector streams through it
+      for(unsigned int i = 0; i < _numTrees; i++)
+      {
+        for(unsigned int j = 0; j < dataVectors.size(); j++)
+        {
+          votes[j][_classifyOne(dataVectors[j], _treeRootsP[i])]++;
+        }
+      }
+
+      for(unsigned int j = 0; j < dataVectors.size(); j++)
+      {
+        for(unsigned int c = 0; c < _classLabels.size(); c++)
+        {
+          if(votes[j][c] > 0)
+          {
+            scores[j][_classLabels[c]] = (double)votes[j][c] * itrVal;
+          }
+        }
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void FlattenedForest::clear()
+  {
+    _factorIndex.clear();
+    _splitValue.clear();
+    _leftChild.clear();
+    _treeRoots.clear();
+    _classLabels.clear();
+
+    _factorIndexP = 0;
+    _splitValueP = 0;
+    _leftChildP = 0;
+    _treeRootsP = 0;
+    _numTrees = 0;
+    _numNodes = 0;
+
+    if(_mappedData != 0)
+    {
+      if(_ownsMappedData)
+      {
+        delete [] _mappedData;
+      }
+#ifndef _WIN32
+      else
+      {
+        munmap(_mappedData, _mappedLength);
+      }
+#endif
+      _mappedData = 0;
+      _mappedLength = 0;
+      _ownsMappedData = false;
+    }
+  }
+
+  void FlattenedForest::exportBinary(const std::string & filename) const
+  {
+    try
+    {
+      if(!isBuilt())
+      {
+        throw Exception(__LINE__, "No forest has been flattened for export");
+      }
+
+      std::ofstream fileStream(filename.c_str(), std::ios::out | std::ios::binary);
+      if(!fileStream.good())
+      {
+        std::stringstream ss;
+        ss << "Unable to open the file " << filename << " for writing the binary model.";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      FlatForestHeader header;
+      memcpy(header.magic, FLAT_FOREST_MAGIC, sizeof(header.magic));
+      header.version = FLAT_FOREST_VERSION;
+      header.numTrees = _numTrees;
+      header.numClasses = _classLabels.size();
+      header.pad = 0;
+      header.numNodes = _numNodes;
+
+      unsigned long long numNodes = header.numNodes;
+
+      fileStream.write((const char*)&header, sizeof(header));
+      fileStream.write((const char*)_splitValueP, numNodes * sizeof(double));
+      fileStream.write((const char*)_factorIndexP, numNodes * sizeof(unsigned int));
+      fileStream.write((const char*)_leftChildP, numNodes * sizeof(unsigned int));
+      fileStream.write((const char*)_treeRootsP, _numTrees * sizeof(unsigned int));
+
+      for(unsigned int i = 0; i < _classLabels.size(); i++)
+      {
+        unsigned int length = _classLabels[i].size();
+        fileStream.write((const char*)&length, sizeof(length));
+        fileStream.write(_classLabels[i].data(), length);
+      }
+
+      if(!fileStream.good())
+      {
+        std::stringstream ss;
+        ss << "Error writing the binary model to " << filename << ".";
+        throw Exception(__LINE__, ss.str());
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void FlattenedForest::importBinary(const std::string & filename)
+  {
+    try
+    {
+      clear();
+
+      char * data = 0;
+      size_t length = 0;
+      bool ownsData = false;
+
+#ifndef _WIN32
+      int fd = open(filename.c_str(), O_RDONLY);
+      if(fd < 0)
+      {
+        std::stringstream ss;
+        ss << "Error opening binary model file " << filename << ".  Check the file path.";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      struct stat fileInfo;
+      if(fstat(fd, &fileInfo) != 0)
+      {
+        close(fd);
+        std::stringstream ss;
+        ss << "Error determining the size of binary model file " << filename << ".";
+        throw Exception(__LINE__, ss.str());
+      }
+      length = fileInfo.st_size;
+
+      void * mapping = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if(mapping == MAP_FAILED)
+      {
+        std::stringstream ss;
+        ss << "Error mapping binary model file " << filename << ".";
+        throw Exception(__LINE__, ss.str());
+      }
+      data = (char*)mapping;
+#else
+      //No mmap on win32; read the whole file into memory instead
+      std::ifstream fileStream(filename.c_str(), std::ios::in | std::ios::binary);
+      if(!fileStream.good())
+      {
+        std::stringstream ss;
+        ss << "Error opening binary model file " << filename << ".  Check the file path.";
+        throw Exception(__LINE__, ss.str());
+      }
+      fileStream.seekg(0, std::ios::end);
+      length = fileStream.tellg();
+      fileStream.seekg(0, std::ios::beg);
+      data = new char[length];
+      ownsData = true;
+      fileStream.read(data, length);
+#endif
+
+      _mappedData = data;
+      _mappedLength = length;
+      _ownsMappedData = ownsData;
+
+      if(length < sizeof(FlatForestHeader))
+      {
+        std::stringstream ss;
+        ss << "The binary model file " << filename << " is truncated.";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      const FlatForestHeader * header = (const FlatForestHeader*)data;
+      if(memcmp(header->magic, FLAT_FOREST_MAGIC, sizeof(header->magic)) != 0)
+      {
+        std::stringstream ss;
+        ss << "The file " << filename << " is not a binary random forest model.";
+        throw Exception(__LINE__, ss.str());
+      }
+      if(header->version != FLAT_FOREST_VERSION)
+      {
+        std::stringstream ss;
+        ss << "This version of Random Forest can not read version " << header->version <<
+          " binary model files.";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      unsigned long long numNodes = header->numNodes;
+      size_t arrayBytes = (size_t)(numNodes * (sizeof(double) + 2 * sizeof(unsigned int)) +
+        header->numTrees * sizeof(unsigned int));
+      if(length < sizeof(FlatForestHeader) + arrayBytes)
+      {
+        std::stringstream ss;
+        ss << "The binary model file " << filename << " is truncated.";
+        throw Exception(__LINE__, ss.str());
+      }
+
+      //The node arrays are evaluated directly out of the mapping
+      const char * pos = data + sizeof(FlatForestHeader);
+      _splitValueP = (const double*)pos;
+      pos += numNodes * sizeof(double);
+      _factorIndexP = (const unsigned int*)pos;
+      pos += numNodes * sizeof(unsigned int);
+      _leftChildP = (const unsigned int*)pos;
+      pos += numNodes * sizeof(unsigned int);
+      _treeRootsP = (const unsigned int*)pos;
+      pos += header->numTrees * sizeof(unsigned int);
+
+      //The class labels are small and materialized as strings
+      _classLabels.reserve(header->numClasses);
+      for(unsigned int i = 0; i < header->numClasses; i++)
+      {
+        if(pos + sizeof(unsigned int) > data + length)
+        {
+          std::stringstream ss;
+          ss << "The binary model file " << filename << " is truncated.";
+          throw Exception(__LINE__, ss.str());
+        }
+        unsigned int labelLength;
+        memcpy(&labelLength, pos, sizeof(labelLength));
+        pos += sizeof(labelLength);
+        if(pos + labelLength > data + length)
+        {
+          std::stringstream ss;
+          ss << "The binary model file " << filename << " is truncated.";
+          throw Exception(__LINE__, ss.str());
+        }
+        _classLabels.push_back(std::string(pos, labelLength));
+        pos += labelLength;
+      }
+
+      _numTrees = header->numTrees;
+      _numNodes = (size_t)numNodes;
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  unsigned int FlattenedForest::_classifyOne(const std::vector<double> & dataVector,
+    unsigned int nodeIdx) const
+  {
+    while(_leftChildP[nodeIdx] != 0)
+    {
+      if(dataVector[_factorIndexP[nodeIdx]] < _splitValueP[nodeIdx])
+      {
+        nodeIdx = _leftChildP[nodeIdx];
+      }
+      else
+      {
+        nodeIdx = _leftChildP[nodeIdx] + 1;
+      }
+    }
+    return _factorIndexP[nodeIdx];
+  }
+
+  void FlattenedForest::_flattenTree(const boost::shared_ptr<TreeNode> & root)
+  {
+    try
+    {
+      //Build a class label to class id map from what has been seen so far so the ids stay
+      //consistent across the trees
+      std::map<std::string, unsigned int> classIds;
+      for(unsigned int i = 0; i < _classLabels.size(); i++)
+      {
+        classIds[_classLabels[i]] = i;
+      }
+
+      unsigned int rootIdx = _factorIndex.size();
+      _treeRoots.push_back(rootIdx);
+      _factorIndex.push_back(0);
+      _splitValue.push_back(0.0);
+      _leftChild.push_back(0);
+
+      //Pack the nodes breadth first; a split node's children are allocated adjacently so the
+      //right child is always the left child's index plus one
+      std::deque<std::pair<boost::shared_ptr<TreeNode>, unsigned int> > queue;
+      queue.push_back(std::make_pair(root, rootIdx));
+
+      while(!queue.empty())
+      {
+        boost::shared_ptr<TreeNode> node = queue.front().first;
+        unsigned int nodeIdx = queue.front().second;
+        queue.pop_front();
+
+        if(node->isPure)
+        {
+          std::map<std::string, unsigned int>::iterator itr = classIds.find(node->classLabel);
+          unsigned int classId;
+          if(itr == classIds.end())
+          {
+            classId = _classLabels.size();
+            classIds[node->classLabel] = classId;
+            _classLabels.push_back(node->classLabel);
+          }
+          else
+          {
+            classId = itr->second;
+          }
+          _factorIndex[nodeIdx] = classId;
+          _leftChild[nodeIdx] = 0;
+        }
+        else
+        {
+          unsigned int leftIdx = _factorIndex.size();
+
+          _factorIndex.push_back(0);
+          _splitValue.push_back(0.0);
+          _leftChild.push_back(0);
+          _factorIndex.push_back(0);
+          _splitValue.push_back(0.0);
+          _leftChild.push_back(0);
+
+          _factorIndex[nodeIdx] = node->factorIndex;
+          _splitValue[nodeIdx] = node->splitValue;
+          _leftChild[nodeIdx] = leftIdx;
+
+          queue.push_back(std::make_pair(node->leftChild, leftIdx));
+          queue.push_back(std::make_pair(node->rightChild, leftIdx + 1));
+        }
+      }
+    }
+    catch(const Exception & e)
+    {
+      throw Exception(typeid(this).name(), __FUNCTION__, __LINE__, e);
+    }
+  }
+
+  void FlattenedForest::_setPointersToVectors()
+  {
+    _factorIndexP = _factorIndex.empty() ? 0 : &_factorIndex[0];
+    _splitValueP = _splitValue.empty() ? 0 : &_splitValue[0];
+    _leftChildP = _leftChild.empty() ? 0 : &_leftChild[0];
+    _treeRootsP = _treeRoots.empty() ? 0 : &_treeRoots[0];
+    _numTrees = _treeRoots.size();
+    _numNodes = _factorIndex.size();
+  }
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#ifndef __FLATTENED_FOREST_H__
+#define __FLATTENED_FOREST_H__
+
+//Boost Includes
+#include <boost/shared_ptr.hpp>
+
+//STL Includes
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../TgsExport.h"
+#include "RandomTree.h"
+
+namespace Tgs
+{
+  /**
+  *  A read-only evaluation form of a trained random forest.  The pointer linked TreeNodes built
+  * during training are packed into contiguous structure of arrays storage (factor index, split
+  * value, child index) with each tree laid out breadth first, so classifying a vector walks a
+  * small dense array instead of chasing heap pointers and copying class label strings at every
+  * leaf.  Classification is on the conflation critical path, so this matters well beyond
+  * training time.
+  *
+  *  The flattened form is built from a forest after training or import and is never mutated
+  * afterward, so it may be shared read-only between threads.
+  *
+  *  The flattened form can also be written to and read from a compact binary file.  Reading
+  * maps the file into memory and evaluates directly out of the mapping, so a worker process
+  * loads a model in microseconds instead of re-parsing the XML format at every start.  The
+  * format uses the native byte order and is intended as a cache local to one machine, not an
+  * interchange format.
+  */
+  class TGS_EXPORT FlattenedForest
+  {
+  public:
+    /**
+    *  Constructor
+    */
+    FlattenedForest();
+
+    /**
+    *  Destructor
+    */
+    ~FlattenedForest();
+
+    /**
+    *  Packs the trees of the provided forest into the flattened representation, replacing any
+    * previously built content
+    *
+    * @param forest the trained trees to flatten
+    */
+    void build(const std::vector<boost::shared_ptr<RandomTree> > & forest);
+
+    /**
+    * Classifies a data vector against every tree and accumulates the majority vote
+    *
+    * @param dataVector a single data vector of size N where N is the number of factors
+    * @param scores a map to hold the classification results as class name mapped to probability
+    */
+    void classifyVector(const std::vector<double> & dataVector,
+      std::map<std::string, double> & scores) const;
+
+    /**
+    * Classifies a batch of data vectors against every tree.  The trees are walked in the outer
+    * loop so each tree's nodes stay hot in cache while all the vectors stream through it.
+    *
+    * @param dataVectors the data vectors to classify
+    * @param scores one score map per input vector, as in classifyVector
+    */
+    void classifyVectors(const std::vector<std::vector<double> > & dataVectors,
+      std::vector<std::map<std::string, double> > & scores) const;
+
+    /**
+    *  Drops the flattened representation and releases any mapped model file
+    */
+    void clear();
+
+    /**
+    *  Writes the flattened forest to a binary model file (see the class notes)
+    *
+    * @param filename the path of the file to write
+    */
+    void exportBinary(const std::string & filename) const;
+
+    /**
+    *  Maps a binary model file written by exportBinary and evaluates directly out of the
+    * mapping, replacing any previously built content
+    *
+    * @param filename the path of the file to read
+    */
+    void importBinary(const std::string & filename);
+
+    /**
+    *  @return true if a forest has been flattened into this object
+    */
+    bool isBuilt() const { return _numTrees > 0; }
+
+  private:
+    /**
+    *  Walks one flattened tree for one data vector
+    *
+    * @param dataVector the data vector to classify
+    * @param nodeIdx the index of the tree's root node
+    * @return the class id of the leaf the vector lands in
+    */
+    unsigned int _classifyOne(const std::vector<double> & dataVector, unsigned int nodeIdx) const;
+
+    /**
+    *  Appends one tree's nodes to the arrays in breadth first order
+    *
+    * @param root the root node of the trained tree
+    */
+    void _flattenTree(const boost::shared_ptr<TreeNode> & root);
+
+    //The mapping owns system resources, so copying is not supported
+    FlattenedForest(const FlattenedForest &);
+    FlattenedForest & operator=(const FlattenedForest &);
+
+    /**
+    *  Points the evaluation pointers at the vectors populated by build
+    */
+    void _setPointersToVectors();
+
+    //Structure of arrays node storage for all the trees.  The two children of a split node are
+    //allocated adjacently, so only the left child's index is stored and the right child is found
+    //at _leftChild[i] + 1.  A left child index of 0 marks a leaf (index 0 is always the first
+    //tree's root, which can never be a child).
+    std::vector<unsigned int> _factorIndex;  ///Split: the factor to test, Leaf: the class id
+    std::vector<double> _splitValue;         ///Split: the split threshold, Leaf: unused
+    std::vector<unsigned int> _leftChild;    ///Split: index of the left child, Leaf: 0
+
+    std::vector<unsigned int> _treeRoots;    ///The index of each tree's root node
+    std::vector<std::string> _classLabels;   ///Class id to class label
+
+    //Evaluation reads through these pointers, which reference either the vectors above
+    //(after build) or a read-only mapped model file (after importBinary)
+    const unsigned int * _factorIndexP;
+    const double * _splitValueP;
+    const unsigned int * _leftChildP;
+    const unsigned int * _treeRootsP;
+    unsigned int _numTrees;
+    size_t _numNodes;
+
+    char * _mappedData;      ///The mapped (or, on win32, heap read) model file, else NULL
+    size_t _mappedLength;    ///The length of the mapped model file
+    bool _ownsMappedData;    ///True if _mappedData was heap allocated rather than mapped
+  };
+}
+#endif
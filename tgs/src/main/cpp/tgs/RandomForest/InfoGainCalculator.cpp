@@ -115,6 +115,22 @@ namespace Tgs
       std::vector<std::vector<unsigned int> > sortedIndices;
       sortedIndices.resize(fIndices.size());
 
+      //When the node still covers most of the frame (the upper levels of the tree, which is
+      //where the sorting cost concentrates) derive each factor's sorted subset from the frame's
+      //cached whole data set permutation instead of re-sorting from scratch.  The subset may
+      //contain duplicate indices (bootstrap sampling is with replacement), so occurrences are
+      //counted rather than flagged.
+      const bool usePresorted = indices.size() * 4 >= df.getNumDataVectors();
+      std::vector<unsigned int> indexCounts;
+      if(usePresorted)
+      {
+        indexCounts.resize(df.getNumDataVectors(), 0);
+        for(unsigned int i = 0; i < indices.size(); i++)
+        {
+          indexCounts[indices[i]]++;
+        }
+      }
+
       //Sort each indices set based on the factor values
       //This maintains a list of indices for each factor
       //being considered.  Trade off is memory vs. cost
@@ -123,8 +139,23 @@ namespace Tgs
       //Note fIndices is the list of factor indices to consider
       for(unsigned int i = 0; i < fIndices.size(); i++)
       {
-        sortedIndices[i] = indices;                                  //Load up all the data vectors of interest
-        df.sortIndicesOnFactorValue( sortedIndices[i], fIndices[i]); //Sort the data vectors by the factor values
+        if(usePresorted)
+        {
+          const std::vector<unsigned int> & presorted = df.getSortedIndicesByFactor(fIndices[i]);
+          sortedIndices[i].reserve(indices.size());
+          for(unsigned int j = 0; j < presorted.size(); j++)
+          {
+            for(unsigned int k = 0; k < indexCounts[presorted[j]]; k++)
+            {
+              sortedIndices[i].push_back(presorted[j]);
+            }
+          }
+        }
+        else
+        {
+          sortedIndices[i] = indices;                                  //Load up all the data vectors of interest
+          df.sortIndicesOnFactorValue( sortedIndices[i], fIndices[i]); //Sort the data vectors by the factor values
+        }
         infoGain[i] = getMaxInfoGainByFactor(df, sortedIndices[i], fIndices[i], classEntropy, splitIndices[i]);
       }
 
@@ -31,7 +31,6 @@
 
 //Qt Includes
 #include <QtConcurrentMap>
-#include <QThreadPool>
 
 
 #include "../TgsException.h"
@@ -87,10 +86,14 @@ namespace Tgs
   {
     try
     {
-      std::cerr << "DEBUG MTRF TRAINMULTI" << std::endl;
-
       data->validateData();
 
+      //The frame is shared read-only by every worker in the pool, so build the per factor
+      //columns and sorted permutations up front rather than letting the workers race on the
+      //lazy builds.  Sharing one prepared frame keeps training memory flat as the thread
+      //count grows.
+      data->prepareForConcurrentTraining();
+
       _trainInputs.data = data;
       _trainInputs.numFactors = numFactors;
       _trainInputs.nodeSize = nodeSize;
@@ -105,10 +108,8 @@ namespace Tgs
       {
         _forest.reserve(numTrees);
 
-        //Initialize the thread pool
-        QThreadPool pool;
-        pool.setExpiryTimeout(-1);
-
+        //QtConcurrent queues one task per tree on the global thread pool and hands the tasks
+        //out as workers free up, so an expensive tree doesn't leave the other cores idle
         QList<boost::shared_ptr<RandomTree> > mapTrees;
         for(unsigned int i = 0; i < numTrees; i++)
         {
@@ -188,6 +189,7 @@ namespace Tgs
         }
 
         _forestCreated = true;
+        _buildFlattenedForest();
       }
       else
       {
@@ -136,6 +136,7 @@ namespace Tgs
         }
 
         _forestCreated = true;
+        _buildFlattenedForest();
         data->restoreClassLabels();  //Restore the original class labels
       }
       else
@@ -233,6 +234,7 @@ namespace Tgs
         }
 
         _forestCreated = true;
+        _buildFlattenedForest();
       }
       else
       {
@@ -326,6 +328,7 @@ namespace Tgs
         }
 
         _forestCreated = true;
+        _buildFlattenedForest();
       }
       else
       {
@@ -55,6 +55,7 @@ namespace Tgs
       _factPerNode = 0;
       _treeId = _idCtr;
       _idCtr++;
+      _random = Random::stream(0, _treeId);
       _root.reset();
     }
     catch(const Tgs::Exception & e)
@@ -387,11 +388,11 @@ namespace Tgs
 
       if(balanced)
       {
-        data->makeBalancedBoostrapAndOobSets(bootstrapSet, _oobSet);
+        data->makeBalancedBoostrapAndOobSets(*_random, bootstrapSet, _oobSet);
       }
       else
       {
-        data->makeBoostrapAndOobSets(bootstrapSet, _oobSet);
+        data->makeBoostrapAndOobSets(*_random, bootstrapSet, _oobSet);
       }
 
       _root = boost::shared_ptr<TreeNode>(new TreeNode());
@@ -413,7 +414,9 @@ namespace Tgs
   {
     try
     {
-      Tgs::Random::instance()->seed((unsigned int)_treeId);
+      //Restart this tree's private stream rather than reseeding the shared global stream, so a
+      //tree trains identically no matter what order or thread the forest schedules it on.
+      _random = Tgs::Random::stream(0, (unsigned int)_treeId);
 
       //std::cout << "Train Tree" << std::endl;
       _factPerNode = numFactors;
@@ -423,11 +426,11 @@ namespace Tgs
 
       if(balanced)
       {
-        data->makeBalancedBoostrapAndOobSets(bootstrapSet, _oobSet);
+        data->makeBalancedBoostrapAndOobSets(*_random, bootstrapSet, _oobSet);
       }
       else
       {
-        data->makeBoostrapAndOobSets(bootstrapSet, _oobSet);
+        data->makeBoostrapAndOobSets(*_random, bootstrapSet, _oobSet);
       }
 
       _root = boost::shared_ptr<TreeNode>(new TreeNode());
@@ -455,7 +458,8 @@ namespace Tgs
       //Build bootstrap and oob sets (on data vector indices)
       std::vector<unsigned int> bootstrapSet;
 
-      data->makeBalancedRoundRobinBootstrapAndOobSets(posClass, negClass, bootstrapSet, _oobSet);
+      data->makeBalancedRoundRobinBootstrapAndOobSets(*_random, posClass, negClass, bootstrapSet,
+        _oobSet);
 
       _root = boost::shared_ptr<TreeNode>(new TreeNode());
       _root->leftChild.reset();
@@ -503,7 +507,7 @@ namespace Tgs
         double splitVal = 0.0;
         double purityDelta = 0.0;
 
-        data->selectRandomFactors(_factPerNode, factors);
+        data->selectRandomFactors(*_random, _factPerNode, factors);
 
         bool splitPossible = _igc.findDataSplit(*data, factors, dataSet, splitIdx, fIdx, splitVal,
           purityDelta);
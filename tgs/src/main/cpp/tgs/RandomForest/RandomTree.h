@@ -104,6 +104,11 @@ namespace Tgs
     */
     void findProximity(boost::shared_ptr<DataFrame> data, std::vector<unsigned int> & proximity);
 
+    /**
+    *  @return the root node of the trained tree (null if the tree has not been built)
+    */
+    boost::shared_ptr<TreeNode> getRootNode() const { return _root; }
+
     /**
     * Finds the factor importance as the sum of the info gain at each tree node per factor
     *
@@ -273,6 +278,8 @@ namespace Tgs
 
     unsigned int _treeId;  ///A unique id for this tree and used to set the random seed
 
+    boost::shared_ptr<Random> _random; ///This tree's private random stream, derived from the tree id
+
     boost::shared_ptr<TreeNode> _root; /// The root node for the tree
 
     static unsigned int _idCtr;  //Each new tree is assigned a unique id
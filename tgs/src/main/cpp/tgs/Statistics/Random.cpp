@@ -86,6 +86,25 @@ namespace Tgs
       return rand_r(&_seed);
   }
 
+  unsigned int Random::mixSeeds(unsigned int seed, unsigned int taskId)
+  {
+    // combine the two inputs, then run an avalanche over the result so that near identical
+    // inputs still land on unrelated seeds.
+    unsigned int h = seed;
+    h ^= taskId + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+  }
+
+  boost::shared_ptr<Random> Random::stream(unsigned int seed, unsigned int taskId)
+  {
+    return boost::shared_ptr<Random>(new Random(mixSeeds(seed, taskId)));
+  }
+
   void Random::seed(unsigned int s)
   {
     if (_is_single)
@@ -59,6 +59,27 @@ namespace Tgs
     int generateInt();
     int generateInt(int max);
 
+    /**
+     * Returns the current seed state. Saving this and later passing it to seed() resumes the
+     * random stream exactly where it left off.
+     */
+    unsigned int getSeed() const { return _seed; }
+
+    /**
+     * Mixes a run seed and a stable task id into a well distributed seed. Consecutive task ids
+     * (0, 1, 2, ...) map to unrelated seeds, so a loop can derive one seed per task straight
+     * from its index.
+     */
+    static unsigned int mixSeeds(unsigned int seed, unsigned int taskId);
+
+    /**
+     * Returns a new random stream derived from a run seed and a stable task id. Each stream
+     * carries its own state, so tasks that own their stream neither contend on nor perturb the
+     * shared instance() stream and produce the same numbers no matter what order or thread the
+     * tasks run on.
+     */
+    static boost::shared_ptr<Random> stream(unsigned int seed, unsigned int taskId);
+
     void seed();
     void seed(unsigned int s);
 
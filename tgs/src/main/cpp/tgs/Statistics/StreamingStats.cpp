@@ -0,0 +1,229 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#include "StreamingStats.h"
+
+// Standard Includes
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <sstream>
+
+#include "../TgsException.h"
+
+namespace Tgs
+{
+  StreamingStats::StreamingStats(int compression)
+  {
+    _compression = std::max(20, compression);
+    _count = 0;
+    _min = std::numeric_limits<double>::max();
+    _max = -_min;
+    _mean = 0.0;
+    _m2 = 0.0;
+  }
+
+  void StreamingStats::addValue(double v)
+  {
+    _count++;
+    _min = std::min(_min, v);
+    _max = std::max(_max, v);
+
+    // Welford's online mean/variance update.
+    double delta = v - _mean;
+    _mean += delta / (double)_count;
+    _m2 += delta * (v - _mean);
+
+    _buffer.push_back(v);
+    if ((int)_buffer.size() >= _compression * 4)
+    {
+      _compress();
+    }
+  }
+
+  void StreamingStats::_compress() const
+  {
+    if (_buffer.empty() && _centroids.size() <= (size_t)(_compression * 2))
+    {
+      return;
+    }
+
+    for (size_t i = 0; i < _buffer.size(); i++)
+    {
+      _centroids.push_back(Centroid(_buffer[i], 1));
+    }
+    _buffer.clear();
+    std::sort(_centroids.begin(), _centroids.end());
+
+    double total = 0.0;
+    for (size_t i = 0; i < _centroids.size(); i++)
+    {
+      total += (double)_centroids[i].weight;
+    }
+
+    std::vector<Centroid> merged;
+    merged.reserve(_compression * 2);
+    double wSoFar = 0.0;
+    Centroid current = _centroids[0];
+    for (size_t i = 1; i < _centroids.size(); i++)
+    {
+      const Centroid& next = _centroids[i];
+      // the t-digest bound: centroids may hold more weight in the middle of the distribution
+      // than at the tails, which keeps the extreme quantiles accurate.
+      double q = (wSoFar + ((double)current.weight + (double)next.weight) / 2.0) / total;
+      double limit = 4.0 * total * q * (1.0 - q) / (double)_compression;
+      if ((double)current.weight + (double)next.weight <= limit)
+      {
+        current.mean = (current.mean * (double)current.weight + next.mean * (double)next.weight) /
+          ((double)current.weight + (double)next.weight);
+        current.weight += next.weight;
+      }
+      else
+      {
+        merged.push_back(current);
+        wSoFar += (double)current.weight;
+        current = next;
+      }
+    }
+    merged.push_back(current);
+    _centroids.swap(merged);
+  }
+
+  double StreamingStats::getMax() const
+  {
+    if (_count == 0)
+    {
+      throw Exception("No values have been added to this StreamingStats.");
+    }
+    return _max;
+  }
+
+  double StreamingStats::getMean() const
+  {
+    if (_count == 0)
+    {
+      throw Exception("No values have been added to this StreamingStats.");
+    }
+    return _mean;
+  }
+
+  double StreamingStats::getMin() const
+  {
+    if (_count == 0)
+    {
+      throw Exception("No values have been added to this StreamingStats.");
+    }
+    return _min;
+  }
+
+  double StreamingStats::getQuantile(double q) const
+  {
+    if (_count == 0)
+    {
+      throw Exception("No values have been added to this StreamingStats.");
+    }
+    if (q < 0.0 || q > 1.0)
+    {
+      throw Exception("The quantile must be in [0, 1].");
+    }
+
+    _compress();
+
+    double target = q * (double)_count;
+    double wSoFar = 0.0;
+    for (size_t i = 0; i < _centroids.size(); i++)
+    {
+      double center = wSoFar + (double)_centroids[i].weight / 2.0;
+      if (target <= center || i == _centroids.size() - 1)
+      {
+        if (i == 0 && target <= center)
+        {
+          // interpolate between the minimum and the first centroid.
+          double t = center <= 0.0 ? 0.0 : target / center;
+          return _min + t * (_centroids[i].mean - _min);
+        }
+        double prevCenter = wSoFar - (double)_centroids[i - 1].weight / 2.0;
+        double t = (target - prevCenter) / (center - prevCenter);
+        t = std::max(0.0, std::min(1.0, t));
+        return _centroids[i - 1].mean + t * (_centroids[i].mean - _centroids[i - 1].mean);
+      }
+      wSoFar += (double)_centroids[i].weight;
+    }
+
+    return _max;
+  }
+
+  double StreamingStats::getStandardDeviation() const
+  {
+    if (_count < 2)
+    {
+      return 0.0;
+    }
+    return sqrt(_m2 / (double)(_count - 1));
+  }
+
+  void StreamingStats::merge(const StreamingStats& other)
+  {
+    if (other._count == 0)
+    {
+      return;
+    }
+    if (_count == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    // parallel variance combination (Chan et al.).
+    double delta = other._mean - _mean;
+    long combined = _count + other._count;
+    _mean += delta * (double)other._count / (double)combined;
+    _m2 += other._m2 + delta * delta * (double)_count * (double)other._count / (double)combined;
+    _count = combined;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+
+    other._compress();
+    _centroids.insert(_centroids.end(), other._centroids.begin(), other._centroids.end());
+    _buffer.insert(_buffer.end(), other._buffer.begin(), other._buffer.end());
+    _compress();
+  }
+
+  std::string StreamingStats::toString() const
+  {
+    std::stringstream ss;
+    if (_count == 0)
+    {
+      ss << "count: 0";
+    }
+    else
+    {
+      ss << "count: " << _count << " min: " << _min << " max: " << _max << " mean: " << _mean <<
+        " stddev: " << getStandardDeviation() << " median: " << getQuantile(0.5);
+    }
+    return ss.str();
+  }
+}
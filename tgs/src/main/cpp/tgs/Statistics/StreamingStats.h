@@ -0,0 +1,121 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+#ifndef __TGS__STREAMING_STATS_H__
+#define __TGS__STREAMING_STATS_H__
+
+// Standard Includes
+#include <string>
+#include <vector>
+
+#include "../TgsExport.h"
+
+namespace Tgs
+{
+  /**
+   * Accumulates summary statistics over a stream of values in a single pass and constant
+   * memory: count, min, max, mean and standard deviation are exact, and quantiles are
+   * approximated with a t-digest style structure of bounded size.  The digest keeps many small
+   * centroids near the tails and fewer, larger ones in the middle, so extreme quantiles stay
+   * accurate where summaries usually need them.
+   *
+   * Two accumulators can be merged, so independent workers can each summarize a shard of the
+   * data and the results can be combined at the end.
+   */
+  class TGS_EXPORT StreamingStats
+  {
+  public:
+    /**
+     * @param compression controls the size/accuracy trade off of the quantile digest. The
+     *  digest holds roughly 2 * compression centroids. 100 gives about three significant
+     *  digits on middle quantiles and better on the tails.
+     */
+    StreamingStats(int compression = 100);
+
+    /**
+     * Adds a single value to the summary.
+     */
+    void addValue(double v);
+
+    long getCount() const { return _count; }
+
+    double getMax() const;
+
+    double getMean() const;
+
+    double getMin() const;
+
+    /**
+     * Returns an approximation of the q quantile (0 <= q <= 1) of the values seen so far.
+     */
+    double getQuantile(double q) const;
+
+    /**
+     * Returns the sample standard deviation of the values seen so far.
+     */
+    double getStandardDeviation() const;
+
+    /**
+     * Folds another summary into this one as if all its values had been added here.
+     */
+    void merge(const StreamingStats& other);
+
+    std::string toString() const;
+
+  private:
+    struct Centroid
+    {
+      double mean;
+      long weight;
+
+      Centroid() : mean(0.0), weight(0) {}
+      Centroid(double m, long w) : mean(m), weight(w) {}
+
+      bool operator<(const Centroid& other) const { return mean < other.mean; }
+    };
+
+    int _compression;
+    long _count;
+    double _min;
+    double _max;
+    double _mean;
+    /// sum of squared differences from the mean (Welford)
+    double _m2;
+
+    /// values waiting to be folded into the digest
+    mutable std::vector<double> _buffer;
+    /// sorted by mean once _compress has run
+    mutable std::vector<Centroid> _centroids;
+
+    /**
+     * Folds the buffered values into the centroid list and merges neighboring centroids that
+     * fit under the t-digest size bound.
+     */
+    void _compress() const;
+  };
+}
+
+#endif
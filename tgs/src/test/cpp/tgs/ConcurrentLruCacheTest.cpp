@@ -0,0 +1,118 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt
+#include <QFuture>
+#include <QtConcurrentRun>
+
+// Standard
+#include <iostream>
+using namespace std;
+
+#include <tgs/ConcurrentLruCache.h>
+
+namespace Tgs
+{
+  class ConcurrentLruCacheTest : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(ConcurrentLruCacheTest);
+    CPPUNIT_TEST(basicTest);
+    CPPUNIT_TEST(concurrentTest);
+    CPPUNIT_TEST_SUITE_END();
+  public:
+
+    void basicTest()
+    {
+      ConcurrentLruCache<int, int> uut(100, 4);
+
+      int v;
+      CPPUNIT_ASSERT_EQUAL(uut.get(1, v), false);
+      uut.insert(1, 11);
+      CPPUNIT_ASSERT_EQUAL(uut.get(1, v), true);
+      CPPUNIT_ASSERT_EQUAL(v, 11);
+      // re-inserting an existing key is a no-op rather than an error.
+      uut.insert(1, 99);
+      CPPUNIT_ASSERT_EQUAL(uut.get(1, v), true);
+      CPPUNIT_ASSERT_EQUAL(v, 11);
+
+      // each shard evicts independently once its share of the budget is full.
+      ConcurrentLruCache<int, int> small(4, 4);
+      for (int i = 0; i < 100; i++)
+      {
+        small.insert(i, i * 10);
+      }
+      int found = 0;
+      for (int i = 0; i < 100; i++)
+      {
+        if (small.get(i, v))
+        {
+          CPPUNIT_ASSERT_EQUAL(v, i * 10);
+          found++;
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(found, 4);
+    }
+
+    static void insertRange(ConcurrentLruCache<int, int>* cache, int start, int end)
+    {
+      for (int i = start; i < end; i++)
+      {
+        cache->insert(i, i * 10);
+      }
+    }
+
+    void concurrentTest()
+    {
+      ConcurrentLruCache<int, int> uut(10000, 8);
+
+      QList< QFuture<void> > futures;
+      for (int t = 0; t < 4; t++)
+      {
+        futures.append(QtConcurrent::run(&insertRange, &uut, t * 1000, (t + 1) * 1000));
+      }
+      for (int t = 0; t < futures.size(); t++)
+      {
+        futures[t].waitForFinished();
+      }
+
+      int v;
+      for (int i = 0; i < 4000; i++)
+      {
+        CPPUNIT_ASSERT_EQUAL(uut.get(i, v), true);
+        CPPUNIT_ASSERT_EQUAL(v, i * 10);
+      }
+    }
+  };
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(Tgs::ConcurrentLruCacheTest, "quick");
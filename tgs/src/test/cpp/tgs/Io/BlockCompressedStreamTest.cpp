@@ -0,0 +1,118 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Standard Includes
+#include <sstream>
+#include <string>
+using namespace std;
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+#include <tgs/Io/BlockCompressedStream.h>
+
+#include "../PluginFactory.h"
+
+using namespace Tgs;
+namespace Tgs
+{
+  class BlockCompressedStreamTest : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(BlockCompressedStreamTest);
+    CPPUNIT_TEST(testRoundTrip);
+    CPPUNIT_TEST(testSeek);
+    CPPUNIT_TEST_SUITE_END();
+  public:
+
+    string makePayload(int size)
+    {
+      string payload;
+      payload.reserve(size);
+      for (int i = 0; i < size; i++)
+      {
+        payload += (char)('a' + (i * 7) % 26);
+      }
+      return payload;
+    }
+
+    void testRoundTrip()
+    {
+      // a small block size forces multiple frames.
+      const string payload = makePayload(1000);
+      stringstream file;
+      BlockCompressedOstream out(file, 64);
+      out.write(payload.data(), payload.size());
+      out.close();
+
+      file.seekg(0);
+      BlockCompressedIstream in(file);
+      CPPUNIT_ASSERT_EQUAL((long long)payload.size(), in.uncompressedSize());
+
+      string result(payload.size(), '\0');
+      in.read(&result[0], result.size());
+      CPPUNIT_ASSERT_EQUAL((streamsize)payload.size(), in.gcount());
+      CPPUNIT_ASSERT_EQUAL(payload, result);
+      // the payload ends here.
+      char c;
+      CPPUNIT_ASSERT(in.get(c).eof());
+    }
+
+    void testSeek()
+    {
+      const string payload = makePayload(1000);
+      stringstream file;
+      BlockCompressedOstream out(file, 64);
+      out.write(payload.data(), payload.size());
+      out.close();
+
+      file.seekg(0);
+      BlockCompressedIstream in(file);
+
+      // seek into the middle of a late frame without reading anything first.
+      in.seekg(707);
+      CPPUNIT_ASSERT_EQUAL((streampos)707, in.tellg());
+      string result(100, '\0');
+      in.read(&result[0], result.size());
+      CPPUNIT_ASSERT_EQUAL(payload.substr(707, 100), result);
+
+      // seek backwards.
+      in.seekg(3);
+      in.read(&result[0], result.size());
+      CPPUNIT_ASSERT_EQUAL(payload.substr(3, 100), result);
+
+      // seek relative to the end.
+      in.seekg(-10, ios::end);
+      in.read(&result[0], 10);
+      CPPUNIT_ASSERT_EQUAL(payload.substr(payload.size() - 10), result.substr(0, 10));
+    }
+  };
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(Tgs::BlockCompressedStreamTest, PluginFactory::testName());
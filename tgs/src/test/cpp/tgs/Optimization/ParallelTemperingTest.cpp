@@ -0,0 +1,126 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Standard Includes
+#include <math.h>
+
+// Qt
+#include <QBuffer>
+
+// TGS Includes
+#include <tgs/Optimization/ParallelTempering.h>
+
+namespace Tgs
+{
+using namespace std;
+
+class ParallelTemperingTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ParallelTemperingTest);
+  CPPUNIT_TEST(simpleTest);
+  CPPUNIT_TEST(stateRoundTripTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  class TestFitnessFunction : public FitnessFunction
+  {
+    virtual double f(const ConstStatePtr& s)
+    {
+      double w = s->get("w");
+      double x = s->get("x");
+      double y = s->get("y");
+      double z = s->get("z");
+
+      // same surface as SimulatedAnnealingTest
+      double v = sin(x * .4 + 1.23) * sin(y * .2 + .4) * sin(z * .5 + .8) *
+        (w == 3 ? 1.0 : 0.5);
+
+      return 5.0 / std::max(1e-9, v);
+    }
+  };
+
+  class TestFitnessFunctionFactory : public FitnessFunctionFactory
+  {
+    virtual FitnessFunctionPtr create()
+    {
+      return FitnessFunctionPtr(new TestFitnessFunction());
+    }
+  };
+
+  StateDescriptionPtr createDescription()
+  {
+    StateDescriptionPtr sd(new StateDescription());
+    sd->addVariable(new VariableDescription("w", VariableDescription::Integer, 0, 4));
+    sd->addVariable(new VariableDescription("x", VariableDescription::Real, 0, 1));
+    sd->addVariable(new VariableDescription("y", VariableDescription::Real, 0, 7));
+    sd->addVariable(new VariableDescription("z", VariableDescription::Real, 0, 3));
+    return sd;
+  }
+
+  void simpleTest()
+  {
+    ParallelTempering uut(createDescription(),
+      FitnessFunctionFactoryPtr(new TestFitnessFunctionFactory()), 4);
+    CPPUNIT_ASSERT(uut.iterate(100) < 5.5);
+    CPPUNIT_ASSERT(uut.getBestStates().size() >= 1);
+    ConstStatePtr state = *uut.getBestStates().begin();
+    CPPUNIT_ASSERT_EQUAL(state->getInt("w"), 3);
+  }
+
+  void stateRoundTripTest()
+  {
+    StateDescriptionPtr sd = createDescription();
+    SimulatedAnnealing chain(sd, FitnessFunctionPtr(new TestFitnessFunction()));
+    chain.runSegment(10, 0.5);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    QDataStream ds(&buffer);
+    chain.saveState(ds);
+    buffer.seek(0);
+
+    SimulatedAnnealing copy(sd, FitnessFunctionPtr(new TestFitnessFunction()));
+    copy.loadState(ds);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(chain.getBestScore(), copy.getBestScore(), 1e-9);
+    CPPUNIT_ASSERT(copy.getCurrentState().get() != 0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(chain.getCurrentState()->getScore(),
+      copy.getCurrentState()->getScore(), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(chain.getBestStates().size(), copy.getBestStates().size());
+
+    // both copies should continue identically since the random stream was checkpointed too.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(chain.runSegment(10, 0.5), copy.runSegment(10, 0.5), 1e-9);
+  }
+};
+
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(Tgs::ParallelTemperingTest, "quick");
@@ -0,0 +1,126 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Standard
+#include <vector>
+using namespace std;
+
+#include <tgs/OrderedHashMap.h>
+
+namespace Tgs
+{
+  class OrderedHashMapTest : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(OrderedHashMapTest);
+    CPPUNIT_TEST(basicTest);
+    CPPUNIT_TEST(eraseTest);
+    CPPUNIT_TEST_SUITE_END();
+  public:
+
+    void basicTest()
+    {
+      OrderedHashMap<long, int> uut;
+      // insert in an order no comparison sort would produce.
+      long keys[] = { 42, -7, 0, 13, -100 };
+      for (int i = 0; i < 5; i++)
+      {
+        uut[keys[i]] = i;
+      }
+      CPPUNIT_ASSERT_EQUAL((size_t)5, uut.size());
+
+      // iteration reproduces insertion order.
+      int i = 0;
+      for (OrderedHashMap<long, int>::const_iterator it = uut.begin(); it != uut.end(); ++it)
+      {
+        CPPUNIT_ASSERT_EQUAL(keys[i], it->first);
+        CPPUNIT_ASSERT_EQUAL(i, it->second);
+        i++;
+      }
+      CPPUNIT_ASSERT_EQUAL(5, i);
+
+      // updating an existing key doesn't change its position.
+      uut[42] = 50;
+      CPPUNIT_ASSERT_EQUAL((size_t)5, uut.size());
+      CPPUNIT_ASSERT_EQUAL(42l, uut.begin()->first);
+      CPPUNIT_ASSERT_EQUAL(50, uut.begin()->second);
+
+      CPPUNIT_ASSERT_EQUAL((size_t)1, uut.count(13));
+      CPPUNIT_ASSERT_EQUAL((size_t)0, uut.count(99));
+      CPPUNIT_ASSERT(uut.find(99) == uut.end());
+      CPPUNIT_ASSERT_EQUAL(3, uut.find(13)->second);
+    }
+
+    void eraseTest()
+    {
+      OrderedHashMap<long, int> uut;
+      for (long i = 0; i < 100; i++)
+      {
+        uut[i] = (int)i * 10;
+      }
+      // erase enough entries to push the tombstone count past the live count and trigger
+      // compaction.
+      for (long i = 0; i < 75; i++)
+      {
+        CPPUNIT_ASSERT_EQUAL((size_t)1, uut.erase(i));
+      }
+      CPPUNIT_ASSERT_EQUAL((size_t)0, uut.erase(2));
+      CPPUNIT_ASSERT_EQUAL((size_t)25, uut.size());
+
+      // the survivors keep their relative insertion order and their values.
+      long expected = 75;
+      for (OrderedHashMap<long, int>::const_iterator it = uut.begin(); it != uut.end(); ++it)
+      {
+        CPPUNIT_ASSERT_EQUAL(expected, it->first);
+        CPPUNIT_ASSERT_EQUAL((int)expected * 10, it->second);
+        expected++;
+      }
+      CPPUNIT_ASSERT_EQUAL(100l, expected);
+
+      uut.clear();
+      CPPUNIT_ASSERT(uut.empty());
+      CPPUNIT_ASSERT(uut.begin() == uut.end());
+
+      // insertion after erase and clear still appends at the end.
+      uut[7] = 70;
+      uut[3] = 30;
+      uut.erase(7);
+      uut[7] = 71;
+      OrderedHashMap<long, int>::const_iterator it = uut.begin();
+      CPPUNIT_ASSERT_EQUAL(3l, it->first);
+      ++it;
+      CPPUNIT_ASSERT_EQUAL(71, it->second);
+    }
+  };
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(Tgs::OrderedHashMapTest, "quick");
@@ -0,0 +1,138 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// Standard Includes
+#include <algorithm>
+#include <vector>
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Tgs
+#include "../PluginFactory.h"
+#include <tgs/RStarTree/FrozenRTree.h>
+#include <tgs/RStarTree/HilbertRTree.h>
+#include <tgs/RStarTree/IntersectionIterator.h>
+#include <tgs/RStarTree/MemoryPageStore.h>
+#include <tgs/Statistics/Random.h>
+
+namespace Tgs
+{
+
+class FrozenRTreeTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FrozenRTreeTest);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testRandom);
+  CPPUNIT_TEST_SUITE_END();
+public:
+
+  void testEmpty()
+  {
+    boost::shared_ptr<MemoryPageStore> mps(new MemoryPageStore(256));
+    HilbertRTree uut(mps, 2);
+
+    FrozenRTree frozen(uut);
+
+    std::vector<double> minBounds(2), maxBounds(2);
+    minBounds[0] = minBounds[1] = -1e6;
+    maxBounds[0] = maxBounds[1] = 1e6;
+    std::vector<int> results;
+    frozen.findIntersections(minBounds, maxBounds, results);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, results.size());
+  }
+
+  void testRandom()
+  {
+    int testSize = 1000;
+
+    boost::shared_ptr<MemoryPageStore> mps(new MemoryPageStore(256));
+    HilbertRTree uut(mps, 2);
+
+    std::vector<Box> boxes;
+    std::vector<int> fids;
+    boxes.reserve(testSize);
+    fids.reserve(testSize);
+    Box b(2);
+    Tgs::Random::instance()->seed(0);
+    for (int i = 0; i < testSize; i++)
+    {
+      double l1 = Tgs::Random::instance()->generateInt(10000);
+      double u1 = l1 + Tgs::Random::instance()->generateInt(100);
+      double l2 = Tgs::Random::instance()->generateInt(10000);
+      double u2 = l2 + Tgs::Random::instance()->generateInt(100);
+      b.setBounds(0, l1, u1);
+      b.setBounds(1, l2, u2);
+      boxes.push_back(b);
+      fids.push_back(i);
+    }
+
+    // a mixed bulk/incremental load so internal structure isn't trivial
+    std::vector<Box> firstBoxes = boxes;
+    std::vector<int> firstFids = fids;
+    firstBoxes.resize(testSize / 2);
+    firstFids.resize(testSize / 2);
+    uut.bulkInsert(firstBoxes, firstFids);
+    for (int i = testSize / 2; i < testSize; i++)
+    {
+      uut.insert(boxes[i], fids[i]);
+    }
+
+    FrozenRTree frozen(uut);
+
+    // the frozen tree must answer every query exactly like the source tree.
+    for (int i = 0; i < 50; i++)
+    {
+      std::vector<double> minBounds(2), maxBounds(2);
+      minBounds[0] = Tgs::Random::instance()->generateInt(10000);
+      maxBounds[0] = minBounds[0] + Tgs::Random::instance()->generateInt(500);
+      minBounds[1] = Tgs::Random::instance()->generateInt(10000);
+      maxBounds[1] = minBounds[1] + Tgs::Random::instance()->generateInt(500);
+
+      std::vector<int> expected;
+      IntersectionIterator it(&uut, minBounds, maxBounds);
+      while (it.next())
+      {
+        expected.push_back(it.getId());
+      }
+
+      std::vector<int> actual;
+      frozen.findIntersections(minBounds, maxBounds, actual);
+
+      sort(expected.begin(), expected.end());
+      sort(actual.begin(), actual.end());
+      CPPUNIT_ASSERT(expected == actual);
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FrozenRTreeTest, PluginFactory::testName());
+
+}
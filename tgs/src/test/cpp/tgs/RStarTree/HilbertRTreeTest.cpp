@@ -28,6 +28,7 @@
 // Standard Includes
 #include <stdlib.h>
 #include <iostream>
+#include <set>
 using namespace std;
 
 // CPP Unit Includes
@@ -36,10 +37,15 @@ using namespace std;
 #include <cppunit/TestAssert.h>
 #include <cppunit/TestFixture.h>
 
+// Qt
+#include <QtConcurrentMap>
+#include <QVector>
+
 // Tgs
 #include "../PluginFactory.h"
 #include <tgs/RStarTree/MemoryPageStore.h>
 #include <tgs/RStarTree/HilbertRTree.h>
+#include <tgs/RStarTree/IntersectionIterator.h>
 #include <tgs/RStarTree/KnnIterator.h>
 #include <tgs/Statistics/Random.h>
 
@@ -66,6 +72,45 @@ public:
   }
 };
 
+/**
+ * Runs one intersection query against a shared tree. Used by testConcurrentRead to exercise the
+ * concurrent read path from multiple threads via QtConcurrent.
+ */
+class ConcurrentQueryRunner
+{
+public:
+  typedef std::vector<int> result_type;
+
+  ConcurrentQueryRunner(const RStarTree* tree, const std::vector<Box>* queries)
+  {
+    _tree = tree;
+    _queries = queries;
+  }
+
+  std::vector<int> operator()(int queryIndex) const
+  {
+    const Box& b = (*_queries)[queryIndex];
+    std::vector<double> minBounds(2), maxBounds(2);
+    for (int d = 0; d < 2; d++)
+    {
+      minBounds[d] = b.getLowerBoundRaw(d);
+      maxBounds[d] = b.getUpperBoundRaw(d);
+    }
+    std::vector<int> result;
+    IntersectionIterator it(_tree, minBounds, maxBounds);
+    while (it.next())
+    {
+      result.push_back(it.getId());
+    }
+    sort(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  const RStarTree* _tree;
+  const std::vector<Box>* _queries;
+};
+
 class HilbertRTreeTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(HilbertRTreeTest);
@@ -73,6 +118,8 @@ class HilbertRTreeTest : public CppUnit::TestFixture
   CPPUNIT_TEST(test2);
   CPPUNIT_TEST(test3);
   CPPUNIT_TEST(test4);
+  CPPUNIT_TEST(testRemove);
+  CPPUNIT_TEST(testConcurrentRead);
   CPPUNIT_TEST(testBulkLoadDistance);
   CPPUNIT_TEST(testStandardLoadDistance);
   CPPUNIT_TEST(testRStarDistance);
@@ -232,6 +279,107 @@ public:
     validateTreeBounds(uut);
   }
 
+  void testRemove()
+  {
+    int testSize = 1000;
+
+    boost::shared_ptr<MemoryPageStore> mps(new MemoryPageStore(256));
+    HilbertRTree uut(mps, 2);
+
+    std::vector<Box> boxes;
+    std::vector<int> fids;
+    _createOrderedTestData(testSize, boxes, fids);
+    uut.bulkInsert(boxes, fids);
+
+    std::set<int> removed;
+    for (int i = 0; i < testSize; i += 3)
+    {
+      CPPUNIT_ASSERT_EQUAL(true, uut.remove(boxes[i], fids[i]));
+      removed.insert(fids[i]);
+      if (i % 99 == 0)
+      {
+        validateTreeBounds(uut);
+        uut.sanityCheck();
+      }
+    }
+    validateTreeBounds(uut);
+
+    // removing an entry that is already gone reports a miss.
+    CPPUNIT_ASSERT_EQUAL(false, uut.remove(boxes[0], fids[0]));
+
+    // make sure exactly the entries that weren't removed are still in the tree.
+    std::set<int> found;
+    std::list<int> nodes;
+    nodes.push_back(uut.getRoot()->getId());
+    while (nodes.size() > 0)
+    {
+      const RTreeNode* n = uut.getNode(nodes.front());
+      nodes.pop_front();
+      if (n->isLeafNode())
+      {
+        for (int i = 0; i < n->getChildCount(); i++)
+        {
+          int id = n->getChildUserId(i);
+          CPPUNIT_ASSERT(found.find(id) == found.end());
+          CPPUNIT_ASSERT(removed.find(id) == removed.end());
+          found.insert(id);
+        }
+      }
+      else
+      {
+        for (int i = 0; i < n->getChildCount(); i++)
+        {
+          nodes.push_back(n->getChildNodeId(i));
+        }
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(testSize - (int)removed.size(), (int)found.size());
+  }
+
+  void testConcurrentRead()
+  {
+    int testSize = 1000;
+    int queryCount = 200;
+
+    // use a small page size so the tree is deep enough to make the node cache work.
+    boost::shared_ptr<MemoryPageStore> mps(new MemoryPageStore(128));
+    HilbertRTree uut(mps, 2);
+
+    std::vector<Box> boxes;
+    std::vector<int> fids;
+    _createRandomTestData(testSize, boxes, fids);
+    uut.bulkInsert(boxes, fids);
+
+    std::vector<Box> queries;
+    std::vector<int> dummy;
+    _createRandomTestData(queryCount, queries, dummy);
+
+    ConcurrentQueryRunner runner(&uut, &queries);
+
+    // calculate the expected results serially.
+    std::vector< std::vector<int> > expected;
+    for (int i = 0; i < queryCount; i++)
+    {
+      expected.push_back(runner(i));
+    }
+
+    uut.setConcurrentReadMode(true);
+
+    QVector<int> queryIndexes;
+    for (int i = 0; i < queryCount; i++)
+    {
+      queryIndexes.append(i);
+    }
+    QVector< std::vector<int> > results = QtConcurrent::blockingMapped(queryIndexes, runner);
+
+    uut.setConcurrentReadMode(false);
+
+    for (int i = 0; i < queryCount; i++)
+    {
+      CPPUNIT_ASSERT(expected[i] == results[i]);
+    }
+  }
+
   void testStandardLoadDistance()
   {
     int testSize = 300;
@@ -0,0 +1,148 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+#include <tgs/RStarTree/MmapPageStore.h>
+#include <tgs/RStarTree/Page.h>
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Qt Includes
+#include <QFile>
+
+#include "../PluginFactory.h"
+
+namespace Tgs
+{
+
+class MmapPageStoreTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MmapPageStoreTest);
+  CPPUNIT_TEST(mmapTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+
+  std::vector<int> _ids;
+
+  void mmapTest()
+  {
+    if (QFile::exists("dumMmap.dat"))
+    {
+      QFile::remove("dumMmap.dat");
+    }
+    {
+      MmapPageStore uut(100, "dumMmap.dat");
+
+      CPPUNIT_ASSERT_EQUAL(100, uut.getPageSize());
+
+      testPageStore(uut);
+    }
+    {
+      MmapPageStore uut(100, "dumMmap.dat", true);
+
+      // just a hint, but make sure it doesn't break subsequent reads
+      uut.prefetch(_ids);
+
+      for (int i = 0; i < 100; i++)
+      {
+        boost::shared_ptr<Page> p = uut.getPage(_ids[i]);
+        verifyPage(p);
+      }
+    }
+  }
+
+  void populatePage(boost::shared_ptr<Page> p)
+  {
+    char* data = p->getData();
+    for (int i = 0; i < p->getDataSize(); i++)
+    {
+      data[i] = i ^ p->getId();
+    }
+    p->setDirty();
+  }
+
+  void testPageStore(PageStore& uut)
+  {
+    CPPUNIT_ASSERT_EQUAL(0, uut.getPageCount());
+    int pageSize = uut.getPageSize();
+
+    boost::shared_ptr<Page> p = uut.createPage();
+    CPPUNIT_ASSERT_EQUAL(pageSize, p->getDataSize());
+
+    populatePage(p);
+    verifyPage(p);
+
+    _ids.push_back(p->getId());
+
+    for (int i = 1; i < 100; i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(i, uut.getPageCount());
+      p = uut.createPage();
+      populatePage(p);
+      _ids.push_back(i);
+    }
+    CPPUNIT_ASSERT_EQUAL(100, uut.getPageCount());
+
+    for (int i = 0; i < 100; i++)
+    {
+      p = uut.getPage(_ids[i]);
+      verifyPage(p);
+    }
+
+    uut.save();
+
+    for (int i = 0; i < 100; i++)
+    {
+      p = uut.getPage(_ids[i]);
+      verifyPage(p);
+    }
+
+    uut.flush();
+
+    for (int i = 0; i < 100; i++)
+    {
+      p = uut.getPage(_ids[i]);
+      verifyPage(p);
+    }
+  }
+
+  void verifyPage(boost::shared_ptr<Page> p)
+  {
+    char* data = p->getData();
+    for (int i = 0; i < p->getDataSize(); i++)
+    {
+      CPPUNIT_ASSERT_EQUAL((char)(i ^ p->getId()), data[i]);
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MmapPageStoreTest, PluginFactory::testName());
+
+}
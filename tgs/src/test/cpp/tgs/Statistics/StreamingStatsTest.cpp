@@ -0,0 +1,110 @@
+/*
+ * This file is part of Hootenanny.
+ *
+ * Hootenanny is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * --------------------------------------------------------------------
+ *
+ * The following copyright notices are generated automatically. If you
+ * have a new notice to add, please use the format:
+ * " * @copyright Copyright ..."
+ * This will properly maintain the copyright information. DigitalGlobe
+ * copyrights will be updated automatically.
+ *
+ * @copyright Copyright (C) 2017 DigitalGlobe (http://www.digitalglobe.com/)
+ */
+
+// CPP Unit Includes
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+// Standard Includes
+#include <math.h>
+
+// TGS Includes
+#include <tgs/Statistics/Random.h>
+#include <tgs/Statistics/StreamingStats.h>
+
+namespace Tgs
+{
+  class StreamingStatsTest : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(StreamingStatsTest);
+    CPPUNIT_TEST(momentsTest);
+    CPPUNIT_TEST(quantileTest);
+    CPPUNIT_TEST(mergeTest);
+    CPPUNIT_TEST_SUITE_END();
+  public:
+
+    void momentsTest()
+    {
+      StreamingStats uut;
+      for (int i = 1; i <= 100; i++)
+      {
+        uut.addValue(i);
+      }
+      CPPUNIT_ASSERT_EQUAL(100L, uut.getCount());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, uut.getMin(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0, uut.getMax(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(50.5, uut.getMean(), 1e-9);
+      // exact sample stddev of 1..100
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(29.0115, uut.getStandardDeviation(), 1e-3);
+    }
+
+    void quantileTest()
+    {
+      StreamingStats uut;
+      Random rand(0);
+      for (int i = 0; i < 100000; i++)
+      {
+        uut.addValue(rand.generateUniform());
+      }
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, uut.getQuantile(0.5), 0.01);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, uut.getQuantile(0.1), 0.01);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.9, uut.getQuantile(0.9), 0.01);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.99, uut.getQuantile(0.99), 0.005);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, uut.getQuantile(0.0), 0.001);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, uut.getQuantile(1.0), 0.001);
+    }
+
+    void mergeTest()
+    {
+      // summarizing two shards and merging should match summarizing the whole stream.
+      StreamingStats whole;
+      StreamingStats a;
+      StreamingStats b;
+      Random rand(0);
+      for (int i = 0; i < 50000; i++)
+      {
+        double v1 = rand.generateUniform();
+        double v2 = rand.generateUniform() * 2.0;
+        whole.addValue(v1);
+        whole.addValue(v2);
+        a.addValue(v1);
+        b.addValue(v2);
+      }
+      a.merge(b);
+      CPPUNIT_ASSERT_EQUAL(whole.getCount(), a.getCount());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(whole.getMin(), a.getMin(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(whole.getMax(), a.getMax(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(whole.getMean(), a.getMean(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(whole.getStandardDeviation(), a.getStandardDeviation(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(whole.getQuantile(0.5), a.getQuantile(0.5), 0.02);
+    }
+  };
+}
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(Tgs::StreamingStatsTest, "quick");
@@ -98,6 +98,7 @@ HEADERS += src/main/cpp/tgs/HashMap.h \
     src/main/cpp/tgs/Heap/JHeap.h \
     src/main/cpp/tgs/ProbablePath/ProbablePathCalculator.h \
     src/main/cpp/tgs/RandomForest/DataFrame.h \
+    src/main/cpp/tgs/RandomForest/FlattenedForest.h \
     src/main/cpp/tgs/RandomForest/InfoGainCalculator.h \
     src/main/cpp/tgs/RandomForest/BaseRandomForest.h \
     src/main/cpp/tgs/RandomForest/RandomForest.h \
@@ -114,6 +115,7 @@ HEADERS += src/main/cpp/tgs/HashMap.h \
     src/main/cpp/tgs/RasterOps/MaxChannelCombiner.h \
     src/main/cpp/tgs/RStarTree/Box.h \
     src/main/cpp/tgs/RStarTree/DistanceIterator.h \
+    src/main/cpp/tgs/RStarTree/FrozenRTree.h \
     src/main/cpp/tgs/RStarTree/HilbertCurve.h \
     src/main/cpp/tgs/RStarTree/HilbertRTree.h \
     src/main/cpp/tgs/RStarTree/InternalRStarTreeWrapper.h \
@@ -133,6 +135,7 @@ HEADERS += src/main/cpp/tgs/HashMap.h \
     src/main/cpp/tgs/System/Time.h \
     src/main/cpp/tgs/Xml/XmlHelper.h \
     src/main/cpp/tgs/Statistics/Normal.h \
+    src/main/cpp/tgs/Statistics/StreamingStats.h \
     src/main/cpp/tgs/RStarTree/RStarTreePrinter.h \
     src/main/cpp/tgs/StreamUtils.hh \
     src/main/cpp/tgs/DelaunayTriangulation/geom2d.h \
@@ -153,13 +156,17 @@ HEADERS += src/main/cpp/tgs/HashMap.h \
     src/main/cpp/tgs/System/Timer.h \
     src/main/cpp/tgs/BigContainers/BigMapHybrid.h \
     src/main/cpp/tgs/System/DisableCerr.h \
+    src/main/cpp/tgs/ConcurrentLruCache.h \
     src/main/cpp/tgs/LruCache.h \
+    src/main/cpp/tgs/Optimization/ParallelTempering.h \
     src/main/cpp/tgs/Optimization/SimulatedAnnealing.h \
     src/main/cpp/tgs/Optimization/StateDescription.h \
     src/main/cpp/tgs/Optimization/VariableDescription.h \
     src/main/cpp/tgs/Optimization/State.h \
     src/main/cpp/tgs/Optimization/FitnessFunction.h
 
+unix:HEADERS += src/main/cpp/tgs/RStarTree/MmapPageStore.h
+
 win32:HEADERS += src/main/cpp/tgs/RStarTree/FilePageStore.h \
     src/main/cpp/tgs/SpinImage/GroundPlaneRemover.h \
     src/main/cpp/tgs/SpinImage/NormalEstimator.h \
@@ -196,6 +203,7 @@ SOURCES += src/main/cpp/tgs/StreamUtils.cpp \
     src/main/cpp/tgs/FeatureSelection/SymmetricUncertaintyCalculator.cpp \
     src/main/cpp/tgs/ProbablePath/ProbablePathCalculator.cpp \
     src/main/cpp/tgs/RandomForest/DataFrame.cpp \
+    src/main/cpp/tgs/RandomForest/FlattenedForest.cpp \
     src/main/cpp/tgs/RandomForest/InfoGainCalculator.cpp \
     src/main/cpp/tgs/RandomForest/BaseRandomForest.cpp \
     src/main/cpp/tgs/RandomForest/RandomForest.cpp \
@@ -210,6 +218,7 @@ SOURCES += src/main/cpp/tgs/StreamUtils.cpp \
     src/main/cpp/tgs/RasterOps/MaxChannelCombiner.cpp \
     src/main/cpp/tgs/RStarTree/Box.cpp \
     src/main/cpp/tgs/RStarTree/DistanceIterator.cpp \
+    src/main/cpp/tgs/RStarTree/FrozenRTree.cpp \
     src/main/cpp/tgs/RStarTree/HilbertRTree.cpp \
     src/main/cpp/tgs/RStarTree/InternalRStarTreeWrapper.cpp \
     src/main/cpp/tgs/RStarTree/IntersectionIterator.cpp \
@@ -226,6 +235,7 @@ SOURCES += src/main/cpp/tgs/StreamUtils.cpp \
     src/main/cpp/tgs/System/Time.cpp \
     src/main/cpp/tgs/Xml/XmlHelper.cpp \
     src/main/cpp/tgs/Statistics/Normal.cpp \
+    src/main/cpp/tgs/Statistics/StreamingStats.cpp \
     src/main/cpp/tgs/RStarTree/RStarTreePrinter.cpp \
     src/main/cpp/tgs/DelaunayTriangulation/DelaunayTriangulation.cpp \
     src/main/cpp/tgs/DisjointSet/DisjointSet.cpp \
@@ -239,6 +249,7 @@ SOURCES += src/main/cpp/tgs/StreamUtils.cpp \
     src/main/cpp/tgs/BigContainers/BasicBloomFilter.cpp \
     src/main/cpp/tgs/System/DisableCout.cpp \
     src/main/cpp/tgs/System/DisableCerr.cpp \
+    src/main/cpp/tgs/Optimization/ParallelTempering.cpp \
     src/main/cpp/tgs/Optimization/SimulatedAnnealing.cpp \
     src/main/cpp/tgs/Optimization/StateDescription.cpp \
     src/main/cpp/tgs/Optimization/VariableDescription.cpp \
@@ -251,6 +262,7 @@ cppunit:SOURCES += \
     src/test/cpp/tgs/FeatureExtraction/CalculatorGenomeTest.cpp \
     src/test/cpp/tgs/FeatureExtraction/GeneticAlgorithmTest.cpp \
     src/test/cpp/tgs/Xml/XmlHelperTest.cpp \
+    src/test/cpp/tgs/RStarTree/FrozenRTreeTest.cpp \
     src/test/cpp/tgs/RStarTree/HilbertRTreeTest.cpp \
     src/test/cpp/tgs/RStarTree/RTreeNodeStoreTest.cpp \
     src/test/cpp/tgs/RStarTree/DistanceIteratorTest.cpp \
@@ -279,9 +291,15 @@ cppunit:SOURCES += \
     src/test/cpp/tgs/Io/StdIoDeviceTest.cpp \
     src/test/cpp/tgs/BigContainers/BigMapTest.cpp \
     src/test/cpp/tgs/BigContainers/BasicBloomFilterTest.cpp \
+    src/test/cpp/tgs/ConcurrentLruCacheTest.cpp \
     src/test/cpp/tgs/LruCacheTest.cpp \
+    src/test/cpp/tgs/Optimization/ParallelTemperingTest.cpp \
+    src/test/cpp/tgs/Statistics/StreamingStatsTest.cpp \
     src/test/cpp/tgs/Optimization/SimulatedAnnealingTest.cpp
 
+unix:SOURCES += src/main/cpp/tgs/RStarTree/MmapPageStore.cpp \
+    src/test/cpp/tgs/RStarTree/MmapPageStoreTest.cpp
+
 win32:SOURCES += src/main/cpp/tgs/RStarTree/FilePageStore.cpp \
     src/main/cpp/tgs/SpinImage/GroundPlaneRemover.cpp \
     src/main/cpp/tgs/SpinImage/NormalEstimator.cpp \